@@ -2,6 +2,20 @@
 // Benefits of this approach: fewer shader files to wrangle, less shader code duplication.
 // Downsides to this approach: can be harder to maintain interleaving shader features!
 
+// Built-in uniforms that are the same for everything drawn with the current camera.
+// These are shared by all shaders via a uniform buffer, so the layout must match "FrameUniforms" in Material.cpp.
+layout(std140) uniform FrameUniforms
+{
+    // Matrices converting from world space to view/projection space.
+    mat4 gViewMatrix;
+    mat4 gProjMatrix;
+    mat4 gWorldToProjMatrix;
+
+    // Texels with alpha below this value will be discarded.
+    // Typically, 0 => "alpha test disabled", greater than 0 => "alpha test enabled".
+    float gAlphaTest;
+};
+
 #ifdef VERTEX_SHADER
     // INPUT VERTEX DATA
     // If a mesh doesn't include certain vertex data, defaults are used.
@@ -32,10 +46,9 @@
     #endif
 
     // UNIFORMS
-    // Matrices converting from object space to projection space.
+    // Matrix converting from object space to world space (world to projection space is in FrameUniforms).
     // Absolutely vital for the vertex shader to function.
     uniform mat4 gObjectToWorldMatrix;
-    uniform mat4 gWorldToProjMatrix;
 
     #ifdef FEATURE_LIGHTING
     // The position of the light source, in world space.
@@ -119,10 +132,6 @@
     // A (tint) color. Multiplied in right after sampling.
     uniform vec4 uColor = vec4(1.0f, 1.0f, 1.0f, 1.0f);
 
-    // Texels with alpha below this value will be discarded.
-    // Typically, 0 => "alpha test disabled", greater than 0 => "alpha test enabled".
-    uniform float gAlphaTest;
-
     // Acts like a "chroma key" to discard a certain texel color (typically magenta).
     // The tolerance allows some error tolerance for close-but-not-exact colors.
     uniform vec4 gDiscardColor = vec4(1.0f, 0.0f, 1.0f, 1.0f);
@@ -176,6 +185,11 @@
         vec4 texel = fColor * uColor;
         #endif
 
+        #ifdef FEATURE_VERTEX_COLOR
+        // When many things are drawn together in one batch (e.g. UI), each one's tint color is stored per-vertex instead of in uColor.
+        texel *= fColor;
+        #endif
+
         // Check for discard due to alpha test or discard color.
         if(texel.a < gAlphaTest || distance(texel.rgb, gDiscardColor.rgb) < gDiscardColorTolerance) { discard; }
 
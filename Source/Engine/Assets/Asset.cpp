@@ -1,7 +1,11 @@
 #include "Asset.h"
 
+#include <cstring>
+
 #include "FileSystem.h"
 
+std::atomic<uint32_t> Asset::sUseTick { 0 };
+
 TYPEINFO_INIT(Asset, NoBaseClass, 100)
 {
     TYPEINFO_VAR(Asset, VariableType::String, mName);
@@ -18,3 +22,29 @@ std::string Asset::GetNameNoExtension() const
 {
     return Path::RemoveExtension(mName);
 }
+
+
+void AssetData::SetBytes(uint8_t* buffer, uint32_t bufferLength)
+{
+    bytes = std::unique_ptr<uint8_t, AssetDataDeleter>(buffer, AssetDataDeleter { true });
+    length = buffer != nullptr ? bufferLength : 0;
+}
+
+void AssetData::SetView(const uint8_t* view, uint32_t viewLength)
+{
+    // Views are never written through or deleted, so casting away const is safe here.
+    bytes = std::unique_ptr<uint8_t, AssetDataDeleter>(const_cast<uint8_t*>(view), AssetDataDeleter { false });
+    length = view != nullptr ? viewLength : 0;
+}
+
+uint8_t* AssetData::TakeBytes()
+{
+    if(IsView())
+    {
+        uint8_t* copy = new uint8_t[length];
+        memcpy(copy, bytes.get(), length);
+        bytes.reset();
+        return copy;
+    }
+    return bytes.release();
+}
\ No newline at end of file
@@ -7,6 +7,7 @@
 // Usually loaded from the disk, but could be created at runtime as well.
 //
 #pragma once
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -21,13 +22,33 @@ enum class AssetScope
     Manual      // An asset with manual scope is not tracked by the system, so the creator of the asset is responsible for its lifetime.
 };
 
+// Deleter for asset byte buffers.
+// Usually, asset bytes are a heap-allocated buffer owned by the AssetData. But they can also be a view into memory owned by someone else (e.g. a memory-mapped archive).
+struct AssetDataDeleter
+{
+    bool owned = true;
+    void operator()(uint8_t* bytes) const { if(owned) { delete[] bytes; } }
+};
+
 // Holds raw asset data to be passed to an Asset::Load function.
 struct AssetData
 {
     // A unique_ptr allows the Load function to take ownership of the byte data, if desired.
     // A few assets want to keep the byte buffer in memory, while others just parse it and then want to delete it.
-    std::unique_ptr<uint8_t> bytes = nullptr;
+    std::unique_ptr<uint8_t, AssetDataDeleter> bytes = nullptr;
     uint32_t length = 0;
+
+    // Sets bytes to a buffer that this AssetData owns and will delete.
+    void SetBytes(uint8_t* buffer, uint32_t bufferLength);
+
+    // Sets bytes to a view of memory owned elsewhere. The memory must outlive this AssetData (and anything parsed from it).
+    // Views may be read-only memory, so an asset that modifies its data must use TakeBytes to get its own copy first.
+    void SetView(const uint8_t* view, uint32_t viewLength);
+    bool IsView() const { return bytes != nullptr && !bytes.get_deleter().owned; }
+
+    // Takes ownership of the byte buffer; caller must delete[] it.
+    // If the bytes are only a view, a copy is made, since the caller can't own memory that belongs to someone else.
+    uint8_t* TakeBytes();
 };
 
 class Asset
@@ -42,6 +63,34 @@ public:
     void SetScope(AssetScope scope) { mScope = scope; }
     AssetScope GetScope() const { return mScope; }
 
+    // Assets handed out as raw pointers are "pinned." Raw pointers aren't tracked, so a pinned asset is never evicted to stay within a memory budget.
+    // Assets that are only ever held through asset handles (see AssetCache.h) can be evicted once no handle refers to them.
+    void Pin() { mPinned.store(true, std::memory_order_relaxed); }
+    bool IsPinned() const { return mPinned.load(std::memory_order_relaxed); }
+
+    // Approximate memory used by this asset, in bytes. Used to enforce cache memory budgets.
+    void SetMemorySize(size_t memorySize) { mMemorySize = memorySize; }
+    size_t GetMemorySize() const { return mMemorySize; }
+
+    // Calculates how much memory this asset holds, after it was loaded from data of the given length.
+    // By default, that's the data length. Assets that expand or convert their data when loading should override this.
+    virtual size_t CalculateMemorySize(uint32_t loadedDataLength) const { return loadedDataLength; }
+
+    // Records that the asset was used "now," so least recently used assets can be evicted first.
+    // The current tick is advanced once per frame by the asset manager.
+    static void AdvanceUseTick() { sUseTick.fetch_add(1, std::memory_order_relaxed); }
+    static uint32_t GetUseTick() { return sUseTick.load(std::memory_order_relaxed); }
+    void MarkUsed()
+    {
+        // Only write if the tick changed, so assets used many times per frame don't write to the same memory over and over.
+        uint32_t useTick = GetUseTick();
+        if(mLastUsedTick.load(std::memory_order_relaxed) != useTick)
+        {
+            mLastUsedTick.store(useTick, std::memory_order_relaxed);
+        }
+    }
+    uint32_t GetLastUsedTick() const { return mLastUsedTick.load(std::memory_order_relaxed); }
+
 protected:
     // Asset's name, typically including an extension.
     std::string mName;
@@ -49,6 +98,16 @@ protected:
     // Asset's scope.
     AssetScope mScope = AssetScope::Global;
 
+    // If true, this asset has been handed out as a raw pointer, so it can't be evicted.
+    std::atomic<bool> mPinned { false };
+
+    // Approximate size of the asset in memory.
+    size_t mMemorySize = 0;
+
+    // Tick at which this asset was last used.
+    std::atomic<uint32_t> mLastUsedTick { 0 };
+    static std::atomic<uint32_t> sUseTick;
+
     // You should not be able to create an instance of this class - only subclasses are allowed.
     explicit Asset(const std::string& name, AssetScope scope);
 };
\ No newline at end of file
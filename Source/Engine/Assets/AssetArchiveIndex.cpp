@@ -0,0 +1,103 @@
+#include "AssetArchiveIndex.h"
+
+#include <algorithm>
+
+#include "IAssetArchive.h"
+#include "StringUtil.h"
+
+namespace
+{
+    bool EntryLess(const AssetArchiveIndex::Entry& a, const AssetArchiveIndex::Entry& b)
+    {
+        // Within the same hash, higher priority archives come first. So the first entry with a name is always the one to keep.
+        return a.nameHash < b.nameHash || (a.nameHash == b.nameHash && a.archiveIndex < b.archiveIndex);
+    }
+}
+
+void AssetArchiveIndex::InsertArchive(uint32_t archiveIndex, const IAssetArchive* archive)
+{
+    if(archive == nullptr) { return; }
+    archiveIndex = std::min(archiveIndex, static_cast<uint32_t>(mArchives.size()));
+    mArchives.insert(mArchives.begin() + archiveIndex, archive);
+
+    // Archives after the new one moved down by one.
+    // This doesn't change the order of existing entries, since it affects all of them the same way.
+    for(Entry& entry : mEntries)
+    {
+        if(entry.archiveIndex >= archiveIndex)
+        {
+            ++entry.archiveIndex;
+        }
+    }
+
+    // Gather and sort the new archive's assets.
+    uint32_t assetCount = archive->GetAssetCount();
+    std::vector<Entry> newEntries(assetCount);
+    for(uint32_t i = 0; i < assetCount; ++i)
+    {
+        newEntries[i].nameHash = archive->GetAssetNameHash(i);
+        newEntries[i].archiveIndex = archiveIndex;
+        newEntries[i].assetIndex = i;
+    }
+    std::stable_sort(newEntries.begin(), newEntries.end(), EntryLess);
+
+    // Merge them into the existing (already sorted) entries.
+    size_t oldCount = mEntries.size();
+    mEntries.insert(mEntries.end(), newEntries.begin(), newEntries.end());
+    std::inplace_merge(mEntries.begin(), mEntries.begin() + oldCount, mEntries.end(), EntryLess);
+
+    // If an asset is now in several archives, only keep the one from the highest priority archive.
+    // Different names can have the same hash, so compare names with each kept entry that has the same hash.
+    size_t keepCount = 0;
+    for(size_t i = 0; i < mEntries.size(); ++i)
+    {
+        const Entry& entry = mEntries[i];
+        const char* assetName = GetAssetName(entry);
+
+        bool isDuplicate = false;
+        for(size_t j = keepCount; j > 0 && mEntries[j - 1].nameHash == entry.nameHash; --j)
+        {
+            if(StringUtil::EqualsIgnoreCase(assetName, GetAssetName(mEntries[j - 1])))
+            {
+                isDuplicate = true;
+                break;
+            }
+        }
+        if(!isDuplicate)
+        {
+            mEntries[keepCount] = entry;
+            ++keepCount;
+        }
+    }
+    mEntries.resize(keepCount);
+}
+
+void AssetArchiveIndex::Clear()
+{
+    mArchives.clear();
+    mEntries.clear();
+}
+
+const AssetArchiveIndex::Entry* AssetArchiveIndex::Find(const std::string& assetName) const
+{
+    // Binary search for the first asset with a matching hash.
+    uint32_t nameHash = static_cast<uint32_t>(StringUtil::HashCaseInsensitive(assetName));
+    auto it = std::lower_bound(mEntries.begin(), mEntries.end(), nameHash, [](const Entry& entry, uint32_t hash) {
+        return entry.nameHash < hash;
+    });
+
+    // Different names can have the same hash, so check names until the hash no longer matches.
+    for(; it != mEntries.end() && it->nameHash == nameHash; ++it)
+    {
+        if(StringUtil::EqualsIgnoreCase(assetName, GetAssetName(*it)))
+        {
+            return &(*it);
+        }
+    }
+    return nullptr;
+}
+
+const char* AssetArchiveIndex::GetAssetName(const Entry& entry) const
+{
+    return mArchives[entry.archiveIndex]->GetAssetName(entry.assetIndex);
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+//
+// Clark Kromenaker
+//
+// An index of the assets in several asset archives, so an asset can be found with one lookup (rather than searching each archive in turn).
+//
+// Archives are kept in priority order. If several archives contain the same asset, only the one in the highest priority archive is indexed.
+// Each archive's assets are merged into the index as the archive is added, so adding many archives doesn't re-sort the whole index each time.
+//
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class IAssetArchive;
+
+class AssetArchiveIndex
+{
+public:
+    struct Entry
+    {
+        uint32_t nameHash = 0;
+        uint32_t archiveIndex = 0;
+        uint32_t assetIndex = 0;
+    };
+
+    // Adds an archive at the given priority (0 is the highest priority). Archives at or after this index move down by one.
+    void InsertArchive(uint32_t archiveIndex, const IAssetArchive* archive);
+    void Clear();
+
+    // Finds an asset by name (case-insensitive). The entry's archive index is the archive's current priority.
+    const Entry* Find(const std::string& assetName) const;
+
+    size_t GetAssetCount() const { return mEntries.size(); }
+
+private:
+    // Archives, in priority order.
+    std::vector<const IAssetArchive*> mArchives;
+
+    // Indexed assets, sorted by name hash (and by archive index for the same hash).
+    std::vector<Entry> mEntries;
+
+    const char* GetAssetName(const Entry& entry) const;
+};
\ No newline at end of file
@@ -4,12 +4,20 @@
 // An asset cache tracks assets already loaded into memory. We can reuse them instead of loading multiple copies.
 // It also provides a list of loaded assets by type, which can be useful for profiling, optimizing, and debugging.
 //
+// Most asset loads are cache hits, and assets are loaded on many threads. So, looking up a cache or a cached asset never takes a lock.
+// Only adding or removing assets does.
+//
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
 
 #include "Asset.h"      // AssetScope
+#include "ConcurrentStringMap.h"
 #include "StringUtil.h" // string_map_ci
 #include "TypeId.h"
 
@@ -27,7 +35,89 @@ public:
 
     virtual ~IAssetCache() = default;
     virtual const std::string& GetId() = 0;
-    virtual void UnloadAssets(AssetScope scope) = 0;
+
+    // Unloads assets with the given scope (or all assets, for global scope), except those that asset handles still refer to.
+    // Returns the number of assets unloaded.
+    virtual size_t UnloadAssets(AssetScope scope) = 0;
+
+    // Memory budget, in bytes. If the cache's assets use more memory than this, unreferenced assets are evicted (least recently used first).
+    // A budget of zero means no limit.
+    void SetMemoryBudget(size_t budget) { mMemoryBudget = budget; }
+    size_t GetMemoryBudget() const { return mMemoryBudget; }
+    size_t GetMemoryUsage() const { return mMemoryUsage; }
+    virtual void EvictAssets() = 0;
+
+protected:
+    std::atomic<size_t> mMemoryBudget { 0 };
+    std::atomic<size_t> mMemoryUsage { 0 };
+};
+
+template<typename T> class AssetCache;
+
+// An entry in an asset cache, for one asset name. Entries are never deleted, so asset handles can refer to them directly.
+template<typename T>
+struct AssetCacheEntry
+{
+    explicit AssetCacheEntry(const std::string& name) : name(StringUtil::ToUpperCopy(name)) { }
+
+    // The asset's name (upper-case).
+    const std::string name;
+
+    // The asset, or null if it isn't loaded.
+    std::atomic<T*> asset { nullptr };
+
+    // Number of asset handles referring to this entry.
+    // While the asset is being evicted, this is set to kEvicting, and no references can be added until eviction is done.
+    static const int kEvicting = -1;
+    std::atomic<int> referenceCount { 0 };
+
+    bool TryAddReference()
+    {
+        int count = referenceCount.load(std::memory_order_relaxed);
+        do
+        {
+            if(count == kEvicting) { return false; }
+        } while(!referenceCount.compare_exchange_weak(count, count + 1, std::memory_order_acquire, std::memory_order_relaxed));
+        return true;
+    }
+};
+
+// A handle to a cached asset. Getting the asset from a handle requires no name lookup, so it's a good idea to keep one for assets used often.
+// A handle also holds a reference to its cache entry. While any handle refers to an entry, the entry's asset is never evicted.
+// If the asset is unloaded anyway (e.g. its scope is unloaded), the handle returns null (and starts returning the asset again if it is reloaded into the same cache).
+template<typename T>
+class AssetHandle
+{
+public:
+    AssetHandle() = default;
+    AssetHandle(const AssetHandle& other);
+    AssetHandle(AssetHandle&& other) noexcept : mEntry(other.mEntry) { other.mEntry = nullptr; }
+    ~AssetHandle() { Reset(); }
+
+    // Takes the other handle's reference (if moved) or a new reference (if copied), and releases this handle's old reference.
+    AssetHandle& operator=(AssetHandle other) noexcept;
+
+    // Releases the reference. Afterwards, the handle is invalid.
+    void Reset();
+
+    // Don't hold on to the returned pointer - only the handle keeps the asset from being evicted.
+    T* Get() const { return mEntry != nullptr ? mEntry->asset.load(std::memory_order_acquire) : nullptr; }
+    bool IsValid() const { return mEntry != nullptr; }
+    const std::string& GetName() const
+    {
+        // An invalid handle has no name.
+        static const std::string kNoName;
+        return mEntry != nullptr ? mEntry->name : kNoName;
+    }
+
+private:
+    friend class AssetCache<T>;
+
+    // Only the cache creates handles, after adding a reference for the handle to take over.
+    explicit AssetHandle(AssetCacheEntry<T>* entry) : mEntry(entry) { }
+
+    // Entries are never deleted by the cache, so this pointer remains valid.
+    AssetCacheEntry<T>* mEntry = nullptr;
 };
 
 template<typename T>
@@ -36,6 +126,13 @@ class AssetCache : public IAssetCache
 public:
     static AssetCache<T>* Get(const std::string& id = "")
     {
+        // Usually, the cache already exists - this can be found without locking.
+        AssetCache<T>* existingCache = GetCachesById().Get(id);
+        if(existingCache != nullptr)
+        {
+            return existingCache;
+        }
+
         // This code could run on multiple threads, so we should guard reads/writes to the static collection.
         std::lock_guard<std::mutex> lock(sAssetCachesMutex);
 
@@ -47,6 +144,7 @@ public:
         if(assetCachesForType.empty())
         {
             assetCachesForType.push_back(new AssetCache<T>());
+            GetCachesById().Set("", static_cast<AssetCache<T>*>(assetCachesForType.back()));
         }
 
         // Find the asset cache that matches the passed in ID.
@@ -61,6 +159,7 @@ public:
         // If none matches, we should create a new one with the desired ID.
         AssetCache<T>* newCache = new AssetCache<T>(id);
         assetCachesForType.push_back(newCache);
+        GetCachesById().Set(id, newCache);
         return newCache;
     }
 
@@ -72,46 +171,146 @@ public:
 
     const std::string& GetId() override { return mId; }
 
-    T* GetAsset(const std::string& name)
+    // Gets a cached asset by name, or null if it isn't loaded.
+    // The asset could be evicted at any time after this returns, unless it's pinned. Use GetHandle to keep it loaded.
+    T* GetAsset(const std::string& name) const
+    {
+        AssetCacheEntry<T>* entry = mEntryLookup.Get(name);
+        return entry != nullptr ? entry->asset.load(std::memory_order_acquire) : nullptr;
+    }
+
+    // Gets a handle to the asset with the given name. The handle is invalid if no asset with this name was ever in the cache.
+    // The handle references the asset as part of the lookup, so the asset can't be evicted between finding it and getting the handle.
+    // If the asset is being evicted at that moment, an invalid handle is returned, since the asset won't be loaded by the time the caller uses it.
+    AssetHandle<T> GetHandle(const std::string& name) const
+    {
+        AssetCacheEntry<T>* entry = mEntryLookup.Get(name);
+        return entry != nullptr && entry->TryAddReference() ? AssetHandle<T>(entry) : AssetHandle<T>();
+    }
+
+    int GetReferenceCount(const std::string& name) const
+    {
+        AssetCacheEntry<T>* entry = mEntryLookup.Get(name);
+        return entry != nullptr ? std::max(entry->referenceCount.load(std::memory_order_relaxed), 0) : 0;
+    }
+
+    // Adds an asset to the cache, unless an asset with this name is already cached (e.g. another thread loaded the same asset at the same time).
+    // Returns a handle to the asset that ends up in the cache. If that isn't the passed in asset, the passed in asset is deleted.
+    AssetHandle<T> AddAsset(const std::string& name, T* asset)
     {
         std::lock_guard<std::mutex> lock(mAssetsMutex);
-        auto it = mAssets.find(name);
-        return it != mAssets.end() ? it->second : nullptr;
+        T*& cachedAsset = mAssets[name];
+        if(cachedAsset != nullptr)
+        {
+            delete asset;
+        }
+        else
+        {
+            cachedAsset = asset;
+            mMemoryUsage += asset->GetMemorySize();
+        }
+
+        // Nothing can be evicting while we hold the lock, so adding a reference always succeeds.
+        AssetCacheEntry<T>* entry = GetOrCreateEntry(name);
+        entry->asset.store(cachedAsset, std::memory_order_release);
+        entry->referenceCount.fetch_add(1, std::memory_order_relaxed);
+        return AssetHandle<T>(entry);
     }
 
-    void SetAsset(const std::string& name, T* asset)
+    // Claims the right to load the asset with the given name. If another thread is already loading it, this waits until that load is done.
+    // Once this returns, check the cache again - the other thread may have added the asset. Either way, call EndLoad when done.
+    void BeginLoad(const std::string& name)
+    {
+        std::unique_lock<std::mutex> lock(mAssetsMutex);
+        mLoadFinished.wait(lock, [this, &name]() { return mLoadingNames.find(name) == mLoadingNames.end(); });
+        mLoadingNames.insert(name);
+    }
+
+    void EndLoad(const std::string& name)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mAssetsMutex);
+            mLoadingNames.erase(name);
+        }
+        mLoadFinished.notify_all();
+    }
+
+    size_t UnloadAssets(AssetScope scope) override
     {
         std::lock_guard<std::mutex> lock(mAssetsMutex);
-        mAssets[name] = asset;
+
+        // When unloading at global scope, we're really unloading everything. Otherwise, we are picking and choosing what we want to get rid of.
+        size_t unloadedCount = 0;
+        for(auto it = mAssets.begin(); it != mAssets.end();)
+        {
+            if(scope != AssetScope::Global && it->second->GetScope() != scope)
+            {
+                ++it;
+                continue;
+            }
+
+            // Same as eviction: marking the entry as evicting only works if no handle refers to it, and stops anything from referencing it until we're done.
+            // Assets that are still referenced stay loaded. Once their handles are released, they are unloaded with their scope again, or evicted.
+            AssetCacheEntry<T>* entry = mEntryLookup.Get(it->first);
+            int expectedCount = 0;
+            if(!entry->referenceCount.compare_exchange_strong(expectedCount, AssetCacheEntry<T>::kEvicting, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                ++it;
+                continue;
+            }
+
+            entry->asset.store(nullptr, std::memory_order_release);
+            mMemoryUsage -= it->second->GetMemorySize();
+            delete it->second;
+            it = mAssets.erase(it);
+            entry->referenceCount.store(0, std::memory_order_release);
+            ++unloadedCount;
+        }
+        return unloadedCount;
     }
 
-    void UnloadAssets(AssetScope scope) override
+    void EvictAssets() override
     {
+        if(mMemoryBudget == 0 || mMemoryUsage <= mMemoryBudget) { return; }
         std::lock_guard<std::mutex> lock(mAssetsMutex);
-        if(scope == AssetScope::Global)
+
+        // Find all assets that might be evictable: not pinned, and no handles referring to them.
+        // Skip any used this tick. For example, assets loaded by an AssetLoadBatch aren't referenced until they are loaded again by whoever needs them.
+        uint32_t useTick = Asset::GetUseTick();
+        std::vector<std::pair<uint32_t, typename std::string_map_ci<T*>::iterator>> candidates;
+        for(auto it = mAssets.begin(); it != mAssets.end(); ++it)
         {
-            // When unloading at global scope, we're really deleting everything and clearing the entire cache.
-            for(auto& entry : mAssets)
+            if(!it->second->IsPinned() && it->second->GetLastUsedTick() != useTick && GetReferenceCount(it->first) == 0)
             {
-                delete entry.second;
+                candidates.emplace_back(it->second->GetLastUsedTick(), it);
             }
-            mAssets.clear();
         }
-        else
+
+        // Evict least recently used assets first, until we're back within budget.
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        for(auto& candidate : candidates)
         {
-            // Otherwise, we are picking and choosing what we want to get rid of.
-            for(auto it = mAssets.begin(); it != mAssets.end();)
+            if(mMemoryUsage <= mMemoryBudget) { break; }
+
+            // Other threads may be looking up this asset right now, without the lock.
+            // Marking the entry as evicting only works if nothing has referenced it since we checked, and stops anything from referencing it until we're done.
+            AssetCacheEntry<T>* entry = mEntryLookup.Get(candidate.second->first);
+            int expectedCount = 0;
+            if(!entry->referenceCount.compare_exchange_strong(expectedCount, AssetCacheEntry<T>::kEvicting, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                continue;
+            }
+
+            // A reference may have been taken and released since we checked, in order to pin the asset.
+            T* asset = candidate.second->second;
+            if(!asset->IsPinned())
             {
-                if((*it).second->GetScope() == scope)
-                {
-                    delete (*it).second;
-                    it = mAssets.erase(it);
-                }
-                else
-                {
-                    ++it;
-                }
+                entry->asset.store(nullptr, std::memory_order_release);
+                mMemoryUsage -= asset->GetMemorySize();
+                mAssets.erase(candidate.second);
+                delete asset;
             }
+            entry->referenceCount.store(0, std::memory_order_release);
         }
     }
 
@@ -125,7 +324,65 @@ private:
     // The assets themselves, keyed by name.
     std::string_map_ci<T*> mAssets;
 
+    // An entry for every asset name ever added, in a map that can be read without locking. Used for all lookups by name.
+    // (The map above is still used for iterating all assets, which the lock-free map doesn't support.)
+    ConcurrentStringMap<AssetCacheEntry<T>> mEntryLookup;
+    std::vector<std::unique_ptr<AssetCacheEntry<T>>> mEntries;
+
     // A mutex is required when modifying the cache, since we allow loading assets on any thread.
     // We don't want multiple threads modifying the cache at the same time.
     std::mutex mAssetsMutex;
-};
\ No newline at end of file
+
+    // Names of assets currently being loaded by some thread, so other threads wanting the same asset wait for it instead of loading a second copy.
+    std::string_set_ci mLoadingNames;
+    std::condition_variable mLoadFinished;
+
+    AssetCacheEntry<T>* GetOrCreateEntry(const std::string& name)
+    {
+        // Only called with the lock held, so no other thread can add the same entry at the same time.
+        AssetCacheEntry<T>* entry = mEntryLookup.Get(name);
+        if(entry == nullptr)
+        {
+            mEntries.emplace_back(new AssetCacheEntry<T>(name));
+            entry = mEntries.back().get();
+            mEntryLookup.Set(name, entry);
+        }
+        return entry;
+    }
+
+    static ConcurrentStringMap<AssetCache<T>>& GetCachesById()
+    {
+        // All caches for this asset type, keyed by ID, for lock-free lookup.
+        static ConcurrentStringMap<AssetCache<T>> cachesById;
+        return cachesById;
+    }
+};
+
+template<typename T>
+AssetHandle<T>::AssetHandle(const AssetHandle& other) :
+    mEntry(other.mEntry)
+{
+    // The other handle already holds a reference, so the asset can't be evicting - just add another.
+    if(mEntry != nullptr)
+    {
+        mEntry->referenceCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+AssetHandle<T>& AssetHandle<T>::operator=(AssetHandle other) noexcept
+{
+    std::swap(mEntry, other.mEntry);
+    return *this;
+}
+
+template<typename T>
+void AssetHandle<T>::Reset()
+{
+    // Release, so anything done with the asset while holding the reference (such as pinning it) is visible to eviction.
+    if(mEntry != nullptr)
+    {
+        mEntry->referenceCount.fetch_sub(1, std::memory_order_release);
+    }
+    mEntry = nullptr;
+}
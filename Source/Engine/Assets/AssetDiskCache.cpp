@@ -0,0 +1,232 @@
+#include "AssetDiskCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
+#include "FileSystem.h"
+
+std::string AssetDiskCache::GetCacheFilePathNoExtension(const std::string& cacheDirectory, const std::string& archiveFilePath)
+{
+    char pathHash[32];
+    snprintf(pathHash, sizeof(pathHash), "%08lx", StringUtil::Hash(archiveFilePath));
+    return Path::Combine({ cacheDirectory, Path::GetFileNameNoExtension(archiveFilePath) + "-" + pathHash });
+}
+
+AssetDiskCache::AssetDiskCache(const std::string& cacheFilePath, const std::string& archiveFilePath, uint64_t maxCacheFileSize) :
+    mCacheFilePath(cacheFilePath),
+    mArchiveFilePath(archiveFilePath),
+    mMaxCacheFileSize(maxCacheFileSize)
+{
+    // The cache is only valid for the exact archive it was created from.
+    mArchiveSize = File::Size(archiveFilePath);
+    mArchiveWriteTime = File::LastWriteTime(archiveFilePath);
+
+    // Use the existing cache file if it's valid. If not, start a fresh one.
+    if(!ReadCacheFile())
+    {
+        CreateCacheFile();
+    }
+}
+
+bool AssetDiskCache::LoadAssetData(const std::string& assetName, AssetData& outAssetData) const
+{
+    auto it = mEntries.find(assetName);
+    if(it == mEntries.end())
+    {
+        return false;
+    }
+
+    // The mapping lives as long as this cache, so a view can be handed out with no copying.
+    outAssetData.SetView(mMappedFile.GetData() + it->second.offset, it->second.size);
+    return true;
+}
+
+void AssetDiskCache::Store(const std::string& assetName, const AssetData& assetData)
+{
+    if(assetData.bytes == nullptr) { return; }
+
+    // Already in the cache file? Nothing to do.
+    if(mEntries.find(assetName) != mEntries.end()) { return; }
+
+    std::lock_guard<std::mutex> lock(mWriteMutex);
+    if(!mWriteStream.is_open()) { return; }
+
+    // If the asset doesn't fit, don't add it. Older assets are evicted the next time the cache is opened.
+    uint64_t recordSize = kRecordHeaderSize + assetName.size() + assetData.length;
+    if(mCacheFileSize + recordSize > mMaxCacheFileSize) { return; }
+    if(!mStoredAssets.insert(assetName).second) { return; }
+
+    // Append a record: name length, data length, name, data.
+    BinaryWriter writer(&mWriteStream);
+    writer.WriteUInt(static_cast<uint32_t>(assetName.size()));
+    writer.WriteUInt(assetData.length);
+    writer.WriteString(assetName);
+    writer.Write(assetData.bytes.get(), assetData.length);
+    writer.Flush();
+    mCacheFileSize += recordSize;
+
+    // If writing fails (e.g. disk full), stop trying to add to the cache.
+    if(!writer.CanWrite())
+    {
+        printf("Failed to write to asset cache %s - no longer caching assets.\n", mCacheFilePath.c_str());
+        mWriteStream.close();
+    }
+}
+
+bool AssetDiskCache::ReadCacheFile()
+{
+    // Map the cache file, if it exists.
+    if(!mMappedFile.Open(mCacheFilePath))
+    {
+        return false;
+    }
+
+    // Records store 32-bit offsets, so a cache this large can't be valid.
+    uint64_t fileSize = mMappedFile.GetSize();
+    if(fileSize > UINT32_MAX || fileSize < kHeaderSize)
+    {
+        mMappedFile.Close();
+        return false;
+    }
+
+    // Make sure the header matches the expected archive.
+    // The archive path is checked too, in case two archive paths produce the same cache file name.
+    BinaryReader reader(mMappedFile.GetData(), static_cast<uint32_t>(fileSize));
+    if(reader.ReadUInt() != kIdentifier || reader.ReadUInt() != kVersion ||
+       reader.ReadULong() != mArchiveSize || reader.ReadULong() != mArchiveWriteTime)
+    {
+        mMappedFile.Close();
+        return false;
+    }
+    uint32_t archivePathLength = reader.ReadUInt();
+    if(kHeaderSize + archivePathLength > fileSize || reader.ReadString(archivePathLength) != mArchiveFilePath)
+    {
+        mMappedFile.Close();
+        return false;
+    }
+
+    // Read each record, which is an asset name and that asset's data.
+    std::string assetName;
+    uint64_t position = kHeaderSize + archivePathLength;
+    while(position < fileSize)
+    {
+        // If a record is cut short (e.g. the game crashed while writing it), the cache file is corrupt.
+        if(position + kRecordHeaderSize > fileSize)
+        {
+            mEntries.clear();
+            mMappedFile.Close();
+            return false;
+        }
+        uint32_t nameLength = reader.ReadUInt();
+        uint32_t dataLength = reader.ReadUInt();
+        uint64_t dataOffset = position + kRecordHeaderSize + nameLength;
+        if(dataOffset + dataLength > fileSize)
+        {
+            mEntries.clear();
+            mMappedFile.Close();
+            return false;
+        }
+
+        // Save asset name and location of its data. Then skip past the data to the next record.
+        reader.ReadString(nameLength, assetName);
+        Entry& entry = mEntries[assetName];
+        entry.offset = dataOffset;
+        entry.size = dataLength;
+        reader.Skip(dataLength);
+        position = dataOffset + dataLength;
+    }
+    mCacheFileSize = fileSize;
+
+    // If the cache grew too big (or the maximum size was lowered), evict the oldest assets to make room.
+    if(mCacheFileSize > mMaxCacheFileSize && !mEntries.empty())
+    {
+        return EvictOldestAssets() && ReadCacheFile();
+    }
+
+    // The cache is valid. New assets will be appended to it.
+    mWriteStream.open(mCacheFilePath, std::ios::out | std::ios::binary | std::ios::app);
+    return true;
+}
+
+bool AssetDiskCache::EvictOldestAssets()
+{
+    // Records are appended in the order assets were first loaded, so the oldest records come first.
+    std::vector<std::pair<std::string, Entry>> records(mEntries.begin(), mEntries.end());
+    std::sort(records.begin(), records.end(), [](const std::pair<std::string, Entry>& a, const std::pair<std::string, Entry>& b){
+        return a.second.offset < b.second.offset;
+    });
+
+    // Keep the newest records that fit in half the maximum size. This leaves room for new assets before the cache is full again.
+    uint64_t keptSize = kHeaderSize + mArchiveFilePath.size();
+    size_t firstKeptIndex = records.size();
+    while(firstKeptIndex > 0)
+    {
+        const std::pair<std::string, Entry>& record = records[firstKeptIndex - 1];
+        uint64_t recordSize = kRecordHeaderSize + record.first.size() + record.second.size;
+        if(keptSize + recordSize > mMaxCacheFileSize / 2)
+        {
+            break;
+        }
+        keptSize += recordSize;
+        --firstKeptIndex;
+    }
+
+    // Write the kept records to a new cache file.
+    std::string tempFilePath = mCacheFilePath + ".tmp";
+    {
+        std::ofstream stream(tempFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+        WriteHeader(stream);
+
+        BinaryWriter writer(&stream);
+        for(size_t i = firstKeptIndex; i < records.size(); ++i)
+        {
+            writer.WriteUInt(static_cast<uint32_t>(records[i].first.size()));
+            writer.WriteUInt(records[i].second.size);
+            writer.WriteString(records[i].first);
+            writer.Write(mMappedFile.GetData() + records[i].second.offset, records[i].second.size);
+        }
+        writer.Flush();
+        if(!writer.CanWrite())
+        {
+            printf("Failed to evict assets from asset cache %s.\n", mCacheFilePath.c_str());
+            mEntries.clear();
+            mMappedFile.Close();
+            std::remove(tempFilePath.c_str());
+            return false;
+        }
+    }
+
+    // Replace the old cache file with the new one. The old file must be unmapped first.
+    mEntries.clear();
+    mMappedFile.Close();
+    std::remove(mCacheFilePath.c_str());
+    return std::rename(tempFilePath.c_str(), mCacheFilePath.c_str()) == 0;
+}
+
+void AssetDiskCache::CreateCacheFile()
+{
+    // Create a new (empty) cache file, replacing any existing one.
+    mWriteStream.open(mCacheFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!mWriteStream.good())
+    {
+        printf("Failed to create asset cache at %s.\n", mCacheFilePath.c_str());
+        mWriteStream.close();
+        return;
+    }
+    WriteHeader(mWriteStream);
+    mCacheFileSize = kHeaderSize + mArchiveFilePath.size();
+}
+
+void AssetDiskCache::WriteHeader(std::ofstream& stream) const
+{
+    BinaryWriter writer(&stream);
+    writer.WriteUInt(kIdentifier);
+    writer.WriteUInt(kVersion);
+    writer.WriteULong(mArchiveSize);
+    writer.WriteULong(mArchiveWriteTime);
+    writer.WriteString32(mArchiveFilePath);
+    writer.Flush();
+}
@@ -0,0 +1,92 @@
+//
+// Clark Kromenaker
+//
+// A persistent, on-disk cache of decompressed asset data for a single asset archive.
+//
+// Many archived assets are compressed, so every launch of the game would otherwise decompress the same data again.
+// Instead, the first time a compressed asset is loaded, its decompressed bytes are appended to a cache file.
+// On subsequent launches, the cache file is memory mapped, and cached assets are handed out as views of the mapping.
+//
+// The cache is keyed on the archive's full path, size, and last write time - if the archive changes, the cache is thrown out and rebuilt.
+//
+// The cache file has a maximum size. Once full, no more assets are appended during that run (cached data may be in use, so it can't be removed).
+// On the next launch, the oldest assets are evicted until the cache is back to half its maximum size, leaving room for new assets.
+//
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#include "Asset.h"
+#include "MemoryMappedFile.h"
+#include "StringUtil.h"
+
+class AssetDiskCache
+{
+public:
+    // Returns the path (minus extension) at which to store cache files for an archive.
+    // Archives in different directories can have the same file name, so the name includes a hash of the archive's full path.
+    static std::string GetCacheFilePathNoExtension(const std::string& cacheDirectory, const std::string& archiveFilePath);
+
+    AssetDiskCache(const std::string& cacheFilePath, const std::string& archiveFilePath, uint64_t maxCacheFileSize);
+
+    bool LoadAssetData(const std::string& assetName, AssetData& outAssetData) const;
+    void Store(const std::string& assetName, const AssetData& assetData);
+
+    size_t GetCachedAssetCount() const { return mEntries.size(); }
+    uint64_t GetCacheFileSize() const { return mCacheFileSize; }
+
+private:
+    // Identifies the file as a GEngine asset cache ("GKDC").
+    const uint32_t kIdentifier = 0x43444B47;
+
+    // Increment if the cache file format changes - older cache files are then discarded.
+    const uint32_t kVersion = 2;
+
+    // Header: identifier, version, archive size, archive write time, archive path length (followed by the archive path itself).
+    const uint32_t kHeaderSize = 28;
+
+    // Each asset record starts with the asset name length and data length.
+    const uint32_t kRecordHeaderSize = 8;
+
+    // The cache file on disk.
+    std::string mCacheFilePath;
+
+    // The archive this cache was created for. Stored in the cache header, so a cache file is never used for the wrong archive.
+    std::string mArchiveFilePath;
+    uint64_t mArchiveSize = 0;
+    uint64_t mArchiveWriteTime = 0;
+
+    // The cache file is never allowed to grow past this size.
+    uint64_t mMaxCacheFileSize = 0;
+
+    // Current size of the cache file, including any assets appended during this run.
+    uint64_t mCacheFileSize = 0;
+
+    // The cache file as it was at startup, mapped into memory.
+    // Assets loaded from the cache are views into this mapping.
+    MemoryMappedFile mMappedFile;
+
+    // Location of each asset's data in the mapped file.
+    // This is only written during construction, so it can be read on any thread without locking.
+    struct Entry
+    {
+        uint64_t offset = 0;
+        uint32_t size = 0;
+    };
+    std::string_map_ci<Entry> mEntries;
+
+    // Newly loaded assets are appended to the cache file via this stream.
+    // Assets are loaded on many threads, so a mutex guards writes.
+    std::ofstream mWriteStream;
+    std::mutex mWriteMutex;
+
+    // Assets appended to the cache file during this run, to avoid writing the same asset more than once.
+    std::string_set_ci mStoredAssets;
+
+    bool ReadCacheFile();
+    bool EvictOldestAssets();
+    void CreateCacheFile();
+    void WriteHeader(std::ofstream& stream) const;
+};
@@ -3,25 +3,36 @@
 #include <algorithm> // std::sort
 #include <cstring>
 #include <fstream>
+#include <mutex>
 #include <string>
 
 #include "BarnFile.h"
 #include "FileSystem.h"
 #include "StringUtil.h"
+#include "ThreadPool.h"
 
 AssetManager gAssetManager;
 
+void AssetLoadBatch::Clear()
+{
+    mLoadFuncs.clear();
+    mKeys.clear();
+}
+
 void AssetManager::Shutdown()
 {
     // Unload all assets.
+    // Anything still referenced by a handle is left loaded, since its owner may still use it.
     UnloadAssets(AssetScope::Global);
 
     // Clear all loaded asset archives.
     for(AssetArchive& archive : mArchives)
     {
         delete archive.archive;
+        delete archive.diskCache;
     }
     mArchives.clear();
+    mArchiveIndex.Clear();
 }
 
 void AssetManager::AddSearchPath(const std::string& searchPath)
@@ -106,15 +117,34 @@ bool AssetManager::LoadAssetArchive(const std::string& archiveName, int searchOr
         return false;
     }
 
-    // Add to list of archives.
-    mArchives.emplace_back();
-    mArchives.back().archive = new BarnFile(archivePath);
-    mArchives.back().searchOrder = searchOrder;
+    // If disk caching is enabled, the archive's index and decompressed assets are cached alongside each other.
+    std::string cachePathNoExtension;
+    if(!mDiskCacheDirectory.empty() && Directory::CreateAll(mDiskCacheDirectory))
+    {
+        cachePathNoExtension = AssetDiskCache::GetCacheFilePathNoExtension(mDiskCacheDirectory, archivePath);
+    }
+
+    // Create the archive entry.
+    AssetArchive archive;
+    archive.archive = new BarnFile(archivePath, mMemoryMapArchives, cachePathNoExtension.empty() ? "" : cachePathNoExtension + ".index");
+    archive.searchOrder = searchOrder;
 
-    // Sort archive list based on search order.
-    std::sort(mArchives.begin(), mArchives.end(), [](const AssetArchive& a, const AssetArchive& b){
-        return a.searchOrder < b.searchOrder;
+    // Create disk cache for this archive, if enabled.
+    if(!cachePathNoExtension.empty())
+    {
+        archive.diskCache = new AssetDiskCache(cachePathNoExtension + ".cache", archivePath, mDiskCacheMaxSizePerArchive);
+    }
+
+    // Insert into the archive list based on search order.
+    // Archives with the same search order stay in the order they were loaded.
+    auto it = std::upper_bound(mArchives.begin(), mArchives.end(), searchOrder, [](int order, const AssetArchive& other){
+        return order < other.searchOrder;
     });
+    uint32_t archiveIndex = static_cast<uint32_t>(it - mArchives.begin());
+    mArchives.insert(it, archive);
+
+    // Merge the archive's assets into the index at the same position.
+    mArchiveIndex.InsertArchive(archiveIndex, archive.archive);
     return true;
 }
 
@@ -173,14 +203,56 @@ void AssetManager::ExtractAssets(const std::string& search, const std::string& o
     printf("Extracted %u assets matching search string %s.\n", extractCount, search.c_str());
 }
 
+void AssetManager::LoadAssets(const AssetLoadBatch& batch)
+{
+    // Nothing to do for an empty batch. And a single asset isn't worth handing off to another thread.
+    size_t loadCount = batch.mLoadFuncs.size();
+    if(loadCount == 0) { return; }
+    if(loadCount == 1)
+    {
+        batch.mLoadFuncs.front()();
+        return;
+    }
+
+    // Spread the loads across the thread pool. This thread also works on the batch while it waits.
+    // This guarantees progress even if the pool is busy (or if this is a thread pool thread itself).
+    const std::vector<std::function<void()>>& loadFuncs = batch.mLoadFuncs;
+    ThreadPool::ParallelFor(0, loadCount, 1, [&loadFuncs](size_t index) {
+        loadFuncs[index]();
+    });
+}
+
 void AssetManager::UnloadAssets(AssetScope scope)
 {
     // Iterate all asset caches and tell them to unload assets at the given scope.
+    // Unloading an asset releases its handles to other assets (e.g. a BSP's textures), which can then be unloaded too. So go again until nothing more is unloaded.
+    std::lock_guard<std::mutex> lock(IAssetCache::sAssetCachesMutex);
+    size_t unloadedCount = 0;
+    do
+    {
+        unloadedCount = 0;
+        for(auto& entry : IAssetCache::sAssetCachesByType)
+        {
+            for(IAssetCache* assetCache : entry.second)
+            {
+                unloadedCount += assetCache->UnloadAssets(scope);
+            }
+        }
+    } while(unloadedCount > 0);
+}
+
+void AssetManager::EvictAssets()
+{
+    // Assets used after this point count as more recently used than anything used before.
+    Asset::AdvanceUseTick();
+
+    // Give all caches a chance to get back within their memory budgets.
+    std::lock_guard<std::mutex> lock(IAssetCache::sAssetCachesMutex);
     for(auto& entry : IAssetCache::sAssetCachesByType)
     {
         for(IAssetCache* assetCache : entry.second)
         {
-            assetCache->UnloadAssets(scope);
+            assetCache->EvictAssets();
         }
     }
 }
@@ -195,8 +267,7 @@ bool AssetManager::ExtractAsset(IAssetArchive* archive, const std::string& asset
     extractData.assetName = assetName;
 
     // Get the raw bytes for the asset to be extracted.
-    extractData.assetData.bytes.reset(archive->CreateAssetBuffer(assetName, extractData.assetData.length));
-    if(extractData.assetData.bytes == nullptr)
+    if(!archive->LoadAssetData(assetName, extractData.assetData))
     {
         return false;
     }
@@ -234,26 +305,45 @@ bool AssetManager::ExtractAsset(IAssetArchive* archive, const std::string& asset
     return extractSucceeded;
 }
 
-uint8_t* AssetManager::CreateAssetBuffer(const std::string& assetName, uint32_t& outBufferSize) const
+bool AssetManager::LoadAssetData(const std::string& assetName, AssetData& outAssetData) const
 {
     // First, see if the asset exists at any search path. If so, we load the asset directly from file.
     // Loose files take precedence over archived assets.
     std::string assetPath = FindLooseFilePath(assetName);
     if(!assetPath.empty())
     {
-        return File::ReadIntoBuffer(assetPath, outBufferSize);
+        uint32_t bufferSize = 0;
+        uint8_t* buffer = File::ReadIntoBuffer(assetPath, bufferSize);
+        outAssetData.SetBytes(buffer, bufferSize);
+        return outAssetData.bytes != nullptr;
     }
 
     // If no loose file to load, we'll get the asset from an asset archive.
-    for(auto& entry : mArchives)
+    const AssetArchiveIndex::Entry* archivedAsset = mArchiveIndex.Find(assetName);
+    if(archivedAsset != nullptr)
     {
-        uint8_t* buffer = entry.archive->CreateAssetBuffer(assetName, outBufferSize);
-        if(buffer != nullptr)
+        const AssetArchive& entry = mArchives[archivedAsset->archiveIndex];
+
+        // Only compressed assets use the disk cache. Uncompressed assets are about as fast to read from the archive as from the cache.
+        bool useDiskCache = entry.diskCache != nullptr && entry.archive->IsAssetCompressed(archivedAsset->assetIndex);
+
+        // A disk cached copy of the asset avoids reading and decompressing from the archive.
+        if(useDiskCache && entry.diskCache->LoadAssetData(assetName, outAssetData))
         {
-            return buffer;
+            return true;
+        }
+
+        if(entry.archive->LoadAssetData(archivedAsset->assetIndex, outAssetData))
+        {
+            // The asset was just decompressed, so cache the decompressed data for next time.
+            if(useDiskCache)
+            {
+                entry.diskCache->Store(assetName, outAssetData);
+            }
+            return true;
         }
     }
 
     // Couldn't find this asset!
-    return nullptr;
+    return false;
 }
\ No newline at end of file
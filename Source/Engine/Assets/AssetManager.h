@@ -24,13 +24,25 @@
 //
 // 7) Asset unloading via scope: each asset stores a scope (Global, Scene, etc). Assets can be unloaded by scope at any time.
 //
+// 8) Disk caching: decompressed archive assets can be cached on disk, so later runs of the game don't need to decompress them again.
+//
+// 9) Batch loading: a set of assets (of any types) can be loaded together. The read, decompress, and parse work is spread across the thread pool.
+//
+// 10) Memory budgets: each asset cache tracks the memory its assets use. If a budget is set, unreferenced assets are evicted (least recently used first).
+//     Assets returned by LoadAsset are raw pointers that can't be tracked, so they are never evicted.
+//     Assets loaded via LoadAssetHandle or an AssetLoadBatch are only kept in memory while an AssetHandle refers to them.
+//     So, anything that holds assets for less than the whole game (animations, mesh renderers, playing sounds, etc) should hold handles.
+//
 #pragma once
+#include <functional>
 #include <initializer_list>
 #include <string>
 #include <vector>
 
 #include "Asset.h"
+#include "AssetArchiveIndex.h"
 #include "AssetCache.h"
+#include "AssetDiskCache.h"
 #include "AssetNameResolver.h"
 #include "IAssetArchive.h"
 #include "StringUtil.h"
@@ -48,6 +60,27 @@ struct AssetExtractData
     std::string outputPath;
 };
 
+// A set of assets to load together via AssetManager::LoadAssets.
+// Once loaded, the assets are in their caches, so subsequent LoadAsset calls for them are just cache hits.
+class AssetLoadBatch
+{
+public:
+    template<typename T> void Add(const std::string& name, AssetScope scope = AssetScope::Global, const std::string& assetCacheId = "");
+
+    size_t GetCount() const { return mLoadFuncs.size(); }
+    bool IsEmpty() const { return mLoadFuncs.empty(); }
+    void Clear();
+
+private:
+    friend class AssetManager;
+
+    // Each entry loads one asset.
+    std::vector<std::function<void()>> mLoadFuncs;
+
+    // Keys of assets already in the batch, so each asset only gets one job.
+    std::string_set_ci mKeys;
+};
+
 class AssetManager
 {
 public:
@@ -64,6 +97,14 @@ public:
     std::string FindLooseFilePath(const std::string& fileName, std::initializer_list<std::string> extensions) const;
 
     // Asset Archives
+    // If memory mapping is enabled, archives loaded afterwards are mapped into memory, allowing lock-free (and sometimes zero-copy) asset loads.
+    void SetMemoryMapArchives(bool memoryMap) { mMemoryMapArchives = memoryMap; }
+    // If a disk cache directory is set, archives loaded afterwards cache decompressed assets there (up to a maximum size per archive).
+    void SetDiskCacheDirectory(const std::string& directory, uint64_t maxCacheSizePerArchive)
+    {
+        mDiskCacheDirectory = directory;
+        mDiskCacheMaxSizePerArchive = maxCacheSizePerArchive;
+    }
     bool LoadAssetArchive(const std::string& archiveName, int searchOrder = 0);
 
     // Asset Extraction
@@ -75,9 +116,17 @@ public:
     void SetAssetNameResolver(const AssetNameResolver& resolver) { mAssetNameResolver = resolver; }
     template<typename T> T* LoadAsset(const std::string& name, AssetScope scope = AssetScope::Global, const std::string& assetCacheId = "");
     template<typename T> T* LoadAsset(const std::string& name, AssetScope scope, AssetCache<T>* cache);
+    template<typename T> AssetHandle<T> LoadAssetHandle(const std::string& name, AssetScope scope = AssetScope::Global, const std::string& assetCacheId = "");
     template<typename T> const std::string_map_ci<T*>& GetAssets(const std::string& assetCacheId = "");
+    void LoadAssets(const AssetLoadBatch& batch);
     void UnloadAssets(AssetScope scope);
 
+    // Memory Budgets
+    // If a budget is set for an asset type, unreferenced assets of that type are evicted (least recently used first) to stay within the budget.
+    template<typename T> void SetMemoryBudget(size_t bytes, const std::string& assetCacheId = "");
+    template<typename T> size_t GetMemoryUsage(const std::string& assetCacheId = "");
+    void EvictAssets();
+
 private:
     // Search paths for loading assets from the disk. Used for loading loose files and asset archives.
     // Expected to be in priority order - an asset is loaded from the first place it is found.
@@ -89,9 +138,23 @@ private:
     {
         int searchOrder = 0;
         IAssetArchive* archive = nullptr;
+
+        // Disk cache of decompressed assets from this archive (if disk caching is enabled).
+        AssetDiskCache* diskCache = nullptr;
     };
     std::vector<AssetArchive> mArchives;
 
+    // An index of the assets in all archives, so an asset can be found with one lookup (rather than searching each archive in turn).
+    // Archives are in the same order as the archive list, so an entry's archive index is also its index in the archive list.
+    AssetArchiveIndex mArchiveIndex;
+
+    // If true, asset archives are memory mapped when loaded.
+    bool mMemoryMapArchives = true;
+
+    // Directory in which to store disk caches of decompressed assets (and archive indexes). If empty, disk caching is disabled.
+    std::string mDiskCacheDirectory;
+    uint64_t mDiskCacheMaxSizePerArchive = 0;
+
     // Used to determine whether asset names have valid extensions, and to map certain asset types to particular extensions.
     // This is mostly important because assets are often provided without extensions - we need to figure out the full asset name to load from disk or archive!
     AssetNameResolver mAssetNameResolver;
@@ -101,12 +164,35 @@ private:
     std::unordered_map<std::string, std::function<bool(AssetExtractData&)>> mAssetExtractorsByExtension;
 
     bool ExtractAsset(IAssetArchive* archive, const std::string& assetName, const std::string& outputDirectory) const;
-    uint8_t* CreateAssetBuffer(const std::string& assetName, uint32_t& outBufferSize) const;
-    template<typename T> T* LoadAssetInternal(const std::string& name, AssetScope scope, AssetCache<T>* cache);
+    bool LoadAssetData(const std::string& assetName, AssetData& outAssetData) const;
+    template<typename T> T* FindOrLoadAsset(const std::string& name, AssetScope scope, AssetCache<T>* cache, AssetHandle<T>& outHandle);
+    template<typename T> T* LoadAssetInternal(const std::string& name, AssetScope scope, AssetCache<T>* cache, AssetHandle<T>& outHandle);
+    template<typename T> T* UseCachedAsset(T* cachedAsset, AssetScope scope);
+
+    // Batches load assets without pinning them.
+    friend class AssetLoadBatch;
 };
 
 extern AssetManager gAssetManager;
 
+template<typename T>
+void AssetLoadBatch::Add(const std::string& name, AssetScope scope, const std::string& assetCacheId)
+{
+    // Manually scoped assets aren't cached, so loading them in a batch would just leak them.
+    if(name.empty() || scope == AssetScope::Manual) { return; }
+
+    // Ignore duplicates - a second job for the same asset would only wait for the first one to load it.
+    std::string key = std::to_string(T::StaticTypeId()) + "/" + assetCacheId + "/" + name;
+    if(!mKeys.insert(key).second) { return; }
+
+    // Use the unpinned load path, so batch loaded assets can still be evicted if nobody ends up using them.
+    mLoadFuncs.emplace_back([name, scope, assetCacheId]() {
+        AssetCache<T>* assetCache = AssetCache<T>::Get(assetCacheId);
+        AssetHandle<T> handle;
+        gAssetManager.FindOrLoadAsset<T>(name, scope, assetCache, handle);
+    });
+}
+
 template<typename T>
 T* AssetManager::LoadAsset(const std::string& name, AssetScope scope, const std::string& assetCacheId)
 {
@@ -123,12 +209,26 @@ T* AssetManager::LoadAsset(const std::string& name, AssetScope scope, const std:
 
 template<typename T>
 T* AssetManager::LoadAsset(const std::string& name, AssetScope scope, AssetCache<T>* cache)
+{
+    // The caller gets a raw pointer, which can't be tracked. So the asset must never be evicted.
+    // The handle keeps the asset from being evicted until it is pinned.
+    AssetHandle<T> handle;
+    T* asset = FindOrLoadAsset<T>(name, scope, cache, handle);
+    if(asset != nullptr)
+    {
+        asset->Pin();
+    }
+    return asset;
+}
+
+template<typename T>
+T* AssetManager::FindOrLoadAsset(const std::string& name, AssetScope scope, AssetCache<T>* cache, AssetHandle<T>& outHandle)
 {
     // If the asset name already has a valid extension, assume the caller knows what they're doing.
     // Just load the asset with that name, as-is.
     if(mAssetNameResolver.HasValidExtension(name))
     {
-        return LoadAssetInternal<T>(name, scope, cache);
+        return LoadAssetInternal<T>(name, scope, cache, outHandle);
     }
     else
     {
@@ -137,7 +237,7 @@ T* AssetManager::LoadAsset(const std::string& name, AssetScope scope, AssetCache
         for(const std::string& extension : mAssetNameResolver.GetTypeExtensions<T>(cache != nullptr ? cache->GetId() : ""))
         {
             // Attempt to load the asset using this extension. If it works, the result will be non-null.
-            T* asset = LoadAssetInternal<T>(name + extension, scope, cache);
+            T* asset = LoadAssetInternal<T>(name + extension, scope, cache, outHandle);
             if(asset != nullptr)
             {
                 return asset;
@@ -146,10 +246,22 @@ T* AssetManager::LoadAsset(const std::string& name, AssetScope scope, AssetCache
 
         // Worst case, this could be an asset with a non-standard extension or no extension at all.
         // Try to load just using the passed in name as-is.
-        return LoadAssetInternal<T>(name, scope, cache);
+        return LoadAssetInternal<T>(name, scope, cache, outHandle);
     }
 }
 
+template<typename T>
+AssetHandle<T> AssetManager::LoadAssetHandle(const std::string& name, AssetScope scope, const std::string& assetCacheId)
+{
+    // Manually scoped assets aren't cached, so there's nothing for a handle to refer to.
+    if(scope == AssetScope::Manual) { return AssetHandle<T>(); }
+
+    // Load the asset without pinning it - the handle keeps it in memory instead.
+    AssetHandle<T> handle;
+    T* asset = FindOrLoadAsset<T>(name, scope, AssetCache<T>::Get(assetCacheId), handle);
+    return asset != nullptr ? handle : AssetHandle<T>();
+}
+
 template<typename T>
 const std::string_map_ci<T*>& AssetManager::GetAssets(const std::string& assetCacheId)
 {
@@ -157,41 +269,91 @@ const std::string_map_ci<T*>& AssetManager::GetAssets(const std::string& assetCa
 }
 
 template<typename T>
-inline T* AssetManager::LoadAssetInternal(const std::string& name, AssetScope scope, AssetCache<T>* cache)
+void AssetManager::SetMemoryBudget(size_t bytes, const std::string& assetCacheId)
+{
+    AssetCache<T>::Get(assetCacheId)->SetMemoryBudget(bytes);
+}
+
+template<typename T>
+size_t AssetManager::GetMemoryUsage(const std::string& assetCacheId)
+{
+    return AssetCache<T>::Get(assetCacheId)->GetMemoryUsage();
+}
+
+template<typename T>
+inline T* AssetManager::LoadAssetInternal(const std::string& name, AssetScope scope, AssetCache<T>* cache, AssetHandle<T>& outHandle)
 {
     // If already present in cache, return existing asset right away.
+    // Cached assets are returned with a handle, which keeps them from being evicted until the caller has pinned them or kept the handle.
     if(cache != nullptr && scope != AssetScope::Manual)
     {
-        T* cachedAsset = cache->GetAsset(name);
+        outHandle = cache->GetHandle(name);
+        T* cachedAsset = outHandle.Get();
         if(cachedAsset != nullptr)
         {
-            // One caveat: if the cached asset has a narrower scope than what's being requested, we must PROMOTE the scope.
-            // For example, a cached asset with SCENE scope being requested at GLOBAL scope must convert to GLOBAL scope.
-            if(cachedAsset->GetScope() == AssetScope::Scene && scope == AssetScope::Global)
-            {
-                cachedAsset->SetScope(AssetScope::Global);
-            }
-            return cachedAsset;
+            return UseCachedAsset(cachedAsset, scope);
+        }
+
+        // If another thread is loading this asset right now, wait for it and use its asset, rather than parsing the asset again.
+        cache->BeginLoad(name);
+        outHandle = cache->GetHandle(name);
+        cachedAsset = outHandle.Get();
+        if(cachedAsset != nullptr)
+        {
+            cache->EndLoad(name);
+            return UseCachedAsset(cachedAsset, scope);
         }
     }
+    bool claimedLoad = cache != nullptr && scope != AssetScope::Manual;
 
-    // Create buffer containing this asset's data. If this fails, the asset doesn't exist, so we can't load it.
+    // Get this asset's data. If this fails, the asset doesn't exist, so we can't load it.
     AssetData assetData;
-    assetData.bytes.reset(CreateAssetBuffer(name, assetData.length));
-    if(assetData.bytes == nullptr) { return nullptr; }
+    if(!LoadAssetData(name, assetData))
+    {
+        if(claimedLoad) { cache->EndLoad(name); }
+        return nullptr;
+    }
     //printf("Loading asset %s\n", assetName.c_str());
 
     // Create asset from asset buffer.
     std::string upperName = StringUtil::ToUpperCopy(name);
     T* asset = new T(upperName, scope);
+    asset->MarkUsed();
+
+    // Load the asset.
+    // Load may take the data's bytes, so remember the data length first.
+    uint32_t assetDataLength = assetData.length;
+    asset->Load(assetData);
+
+    // Size the asset from what it holds after loading, which can be quite different from the size of the data it was loaded from.
+    asset->SetMemorySize(asset->CalculateMemorySize(assetDataLength));
 
     // Add entry in cache, if we have a cache.
-    if(asset != nullptr && cache != nullptr && scope != AssetScope::Manual)
+    // This happens only after loading, so other threads never get a partially loaded asset from the cache.
+    // If the same asset was cached in the meantime anyway (e.g. added directly with AddAsset), that one is used, and this one is deleted.
+    if(claimedLoad)
     {
-        cache->SetAsset(name, asset);
+        outHandle = cache->AddAsset(name, asset);
+        cache->EndLoad(name);
+        T* cachedAsset = outHandle.Get();
+        if(cachedAsset != asset)
+        {
+            return UseCachedAsset(cachedAsset, scope);
+        }
     }
-
-    // Load the asset.
-    asset->Load(assetData);
     return asset;
 }
+
+template<typename T>
+T* AssetManager::UseCachedAsset(T* cachedAsset, AssetScope scope)
+{
+    cachedAsset->MarkUsed();
+
+    // One caveat: if the cached asset has a narrower scope than what's being requested, we must PROMOTE the scope.
+    // For example, a cached asset with SCENE scope being requested at GLOBAL scope must convert to GLOBAL scope.
+    if(cachedAsset->GetScope() == AssetScope::Scene && scope == AssetScope::Global)
+    {
+        cachedAsset->SetScope(AssetScope::Global);
+    }
+    return cachedAsset;
+}
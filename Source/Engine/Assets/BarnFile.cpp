@@ -1,94 +1,190 @@
 #include "BarnFile.h"
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <vector>
 
+#include "BinaryWriter.h"
+#include "FileSystem.h"
 #include "minilzo.h"
 #include "zlib.h"
 
-BarnFile::BarnFile(const std::string& filePath) :
-    mName(filePath),
-    mReader(filePath.c_str())
+namespace
 {
+    // Assets can be extracted on many threads at once (e.g. batch loads on the thread pool).
+    // Rather than initializing zlib and allocating a read buffer for every asset, each thread keeps a reusable context.
+    struct DecompressionContext
+    {
+        // A zlib inflate stream. Once initialized, it can be reset and reused for each zlib-compressed asset.
+        z_stream zlibStream {};
+        bool zlibInitialized = false;
+
+        // Scratch buffer to read compressed bytes into (only needed when the Barn isn't memory mapped).
+        std::vector<uint8_t> compressedBuffer;
+
+        ~DecompressionContext()
+        {
+            if(zlibInitialized)
+            {
+                inflateEnd(&zlibStream);
+            }
+        }
+
+        z_stream* GetZlibStream()
+        {
+            int result = Z_OK;
+            if(!zlibInitialized)
+            {
+                zlibStream.zalloc = Z_NULL;
+                zlibStream.zfree = Z_NULL;
+                zlibStream.opaque = Z_NULL;
+                result = inflateInit(&zlibStream);
+                zlibInitialized = (result == Z_OK);
+            }
+            else
+            {
+                result = inflateReset(&zlibStream);
+            }
+
+            if(result != Z_OK)
+            {
+                std::cout << "Error when initializing inflate: " << result << "\n";
+                return nullptr;
+            }
+            return &zlibStream;
+        }
+    };
+    thread_local DecompressionContext tDecompressionContext;
+}
+
+BarnFile::BarnFile(const std::string& filePath, bool memoryMap, const std::string& indexFilePath) :
+    mName(filePath)
+{
+    // If desired, map the entire Barn file into memory. Asset extraction then reads directly from memory.
+    // Asset offsets are 32-bit, so a Barn larger than that can't be read this way (it'd be invalid anyway).
+    if(memoryMap && mMappedFile.Open(filePath) && mMappedFile.GetSize() > UINT32_MAX)
+    {
+        mMappedFile.Close();
+    }
+
+    // Header/table of contents are parsed via a binary reader - either from the mapped memory or straight from the file.
+    if(mMappedFile.IsOpen())
+    {
+        mReader = std::make_unique<BinaryReader>(mMappedFile.GetData(), static_cast<uint32_t>(mMappedFile.GetSize()));
+    }
+    else
+    {
+        mReader = std::make_unique<BinaryReader>(filePath.c_str());
+    }
+
     // Make sure we can actually read this file.
-    if(!mReader.CanRead())
+    if(!mReader->CanRead())
     {
         std::cout << "Can't read barn file at " << filePath << "\n";
         return;
     }
 
+    // Parsing the table of contents means reading thousands of asset entries scattered throughout the file.
+    // If we saved an index for this exact Barn previously, loading that is much faster.
+    if(!indexFilePath.empty())
+    {
+        uint64_t barnSize = File::Size(filePath);
+        uint64_t barnWriteTime = File::LastWriteTime(filePath);
+        if(!ReadIndexFile(indexFilePath, barnSize, barnWriteTime) && ReadTableOfContents())
+        {
+            WriteIndexFile(indexFilePath, barnSize, barnWriteTime);
+        }
+    }
+    else
+    {
+        ReadTableOfContents();
+    }
+
+    // When memory mapped, the reader was only needed for parsing the table of contents.
+    if(mMappedFile.IsOpen())
+    {
+        mReader.reset();
+    }
+}
+
+BarnFile::~BarnFile() = default;
+
+bool BarnFile::ReadTableOfContents()
+{
     // 8 bytes: two specific 4-byte ints must appear at the beginning of the file.
     // In text form, this is a string "GK3!Barn".
-    uint32_t gameIdentifier = mReader.ReadUInt();
-    uint32_t barnIdentifier = mReader.ReadUInt();
+    uint32_t gameIdentifier = mReader->ReadUInt();
+    uint32_t barnIdentifier = mReader->ReadUInt();
     if(gameIdentifier != kGameIdentifier && barnIdentifier != kBarnIdentifier)
     {
         std::cout << "Invalid file type!\n";
-        return;
+        return false;
     }
 
     // 4-bytes: unknown constant value (65536)
     // 4-bytes: unknown constant value (65536)
     // 4-bytes: appears to be file size, or size of assets in BRN bundle.
-    mReader.Skip(12);
+    mReader->Skip(12);
 
     // This value indicates the offset past the file header data to what I'd
     // call the "table of contents" or "toc".
-    uint32_t tocOffset = mReader.ReadUInt();
+    uint32_t tocOffset = mReader->ReadUInt();
 
     // This additional header data can be read in if desired, but it
     // isn't really relevant to the file functionality.
     /*
     {
         // 4-bytes: EXE/Content build # (119 in both cases)
-        mReader.ReadUInt();
-        mReader.ReadUInt();
+        mReader->ReadUInt();
+        mReader->ReadUInt();
 
         // 4-bytes: unknown value
-        mReader.ReadUInt();
+        mReader->ReadUInt();
 
         // Two dates, 2-bytes per element.
         // The dates are both on the same day, just a few minutes apart.
         // Maybe like a build start/end time for the bundles?
         short year, month, day, hour, minute, second;
-        year = mReader.ReadShort();
-        month = mReader.ReadShort();
-        mReader.ReadShort(); // unknown value
-        day = mReader.ReadShort();
-        hour = mReader.ReadShort();
-        minute = mReader.ReadShort();
-        second = mReader.ReadShort();
+        year = mReader->ReadShort();
+        month = mReader->ReadShort();
+        mReader->ReadShort(); // unknown value
+        day = mReader->ReadShort();
+        hour = mReader->ReadShort();
+        minute = mReader->ReadShort();
+        second = mReader->ReadShort();
         cout << year << "/" << month << "/" << day << ", " << hour << ":" << minute << ":" << second << endl;
 
         // 2-bytes: unknown variable value.
-        mReader.ReadShort();
-
-        year = mReader.ReadShort();
-        month = mReader.ReadShort();
-        mReader.ReadShort(); // unknown value
-        day = mReader.ReadShort();
-        hour = mReader.ReadShort();
-        minute = mReader.ReadShort();
-        second = mReader.ReadShort();
+        mReader->ReadShort();
+
+        year = mReader->ReadShort();
+        month = mReader->ReadShort();
+        mReader->ReadShort(); // unknown value
+        day = mReader->ReadShort();
+        hour = mReader->ReadShort();
+        minute = mReader->ReadShort();
+        second = mReader->ReadShort();
         cout << year << "/" << month << "/" << day << ", " << hour << ":" << minute << ":" << second << endl;
 
         // 2-bytes: unknown variable value.
-        mReader.ReadShort();
+        mReader->ReadShort();
 
         // Copyright notice
         char copyright[65];
-        mReader.Read(copyright, 64);
+        mReader->Read(copyright, 64);
         copyright[64] = '\0';
         cout << copyright << endl;
     }
     */
 
     // Seek to table of contents offset.
-    mReader.Seek(tocOffset);
+    mReader->Seek(tocOffset);
 
     // First value in TOC is number of TOC entries.
-    uint32_t tocEntryCount = mReader.ReadUInt();
+    uint32_t tocEntryCount = mReader->ReadUInt();
 
     // Each toc entry will specify a header offset and a data offset.
     std::vector<uint32_t> headerOffsets;
@@ -103,14 +199,14 @@ BarnFile::BarnFile(const std::string& filePath) :
         // The type is either "DDir" or "Data".
         // DDir specifies a directory of assets.
         // Data specifies file offset to start reading actual data.
-        uint32_t type = mReader.ReadUInt();
+        uint32_t type = mReader->ReadUInt();
 
         // Some unknown values.
-        mReader.Skip(16);
+        mReader->Skip(16);
 
         // Read header and data offsets.
-        uint32_t headerOffset = mReader.ReadUInt();
-        uint32_t dataOffset = mReader.ReadUInt();
+        uint32_t headerOffset = mReader->ReadUInt();
+        uint32_t dataOffset = mReader->ReadUInt();
 
         // For DDir, we'll save the offsets so we can iterate over them below.
         // For Data, we'll just save the data offset value.
@@ -127,48 +223,42 @@ BarnFile::BarnFile(const std::string& filePath) :
 
     // Now we need to iterate over each header/data offset pair in turn.
     // The header specifies data that is common to all assets in the data section.
-    mReferencedBarns.resize(tocEntryCount);
+    std::string referencedBarn;
     for(size_t i = 0; i < headerOffsets.size(); ++i)
     {
-        mReader.Seek(headerOffsets[i]);
+        mReader->Seek(headerOffsets[i]);
 
         // The name of the Barn file for these assets. NOTE that it appears
         // a Barn file can contain "pointers" to assets in other Barn files.
         // If this name is empty, it means the asset is contained within THIS Barn file.
         // However, if the name isn't empty, it means the asset is in another Barn file.
-        mReader.ReadString(32, mReferencedBarns[i]);
-        bool isPointer = !mReferencedBarns[i].empty();
+        mReader->ReadString(32, referencedBarn);
+        bool isPointer = !referencedBarn.empty();
 
         // 4 bytes - unknown value
         // 40 bytes - a human-readable description for this Barn file
         // 4 bytes - unknown value
-        mReader.Skip(48);
+        mReader->Skip(48);
 
-        uint32_t numAssets = mReader.ReadUInt();
-        mReader.Seek(dataOffsets[i]);
+        uint32_t numAssets = mReader->ReadUInt();
+        mReader->Seek(dataOffsets[i]);
+        mAssets.reserve(mAssets.size() + numAssets);
         for(uint32_t j = 0; j < numAssets; ++j)
         {
             BarnAsset asset;
 
-            // The asset should save which Barn file it is in.
-            // This will help later when trying to load assets.
-            if(isPointer)
-            {
-                asset.barnFileName = &mReferencedBarns[i];
-            }
-
             // Asset size, in bytes.
             // But we need to read compression type before we know whether this is compressed or uncompressed size.
-            asset.size = mReader.ReadUInt();
+            asset.size = mReader->ReadUInt();
 
             // Read in the asset offset. This is the offset from the start of the data section.
-            asset.offset = mReader.ReadUInt();
+            asset.offset = mReader->ReadUInt();
 
             // Unknown values.
-            mReader.Skip(5);
+            mReader->Skip(5);
 
             // Read in compression type.
-            asset.compressionType = static_cast<CompressionType>(mReader.ReadByte());
+            asset.compressionType = static_cast<CompressionType>(mReader->ReadByte());
 
             // Compression type 3 should just be treated as type none.
             // Not sure if type 3 is actually different in some way?
@@ -177,14 +267,156 @@ BarnFile::BarnFile(const std::string& filePath) :
                 asset.compressionType = CompressionType::None;
             }
 
-            // Read in asset name.
-            mReader.ReadString8(asset.name);
-            mReader.Skip(1); // null terminator is also present - skip it
-            //std::cout << asset.name << ", " << (int)asset.compressionType << ", " << asset.compressedSize << ", " << asset.uncompressedSize << std::endl;
+            // Asset name is an 8-bit length, followed by the characters, followed by a null terminator.
+            uint8_t nameLength = mReader->ReadByte();
+
+            // Pointers to assets in other Barns can't be loaded from this Barn, so there's no point keeping them around.
+            if(isPointer)
+            {
+                mReader->Skip(nameLength + 1);
+                continue;
+            }
+
+            // Read the name straight into the name buffer (resize also adds the null terminator).
+            asset.nameOffset = static_cast<uint32_t>(mAssetNames.size());
+            mAssetNames.resize(mAssetNames.size() + nameLength + 1);
+            mReader->Read(reinterpret_cast<uint8_t*>(&mAssetNames[asset.nameOffset]), nameLength);
+            mReader->Skip(1);
+            asset.nameHash = static_cast<uint32_t>(StringUtil::HashCaseInsensitive(GetAssetName(asset)));
+            //std::cout << GetAssetName(asset) << ", " << (int)asset.compressionType << ", " << asset.size << std::endl;
+
+            mAssets.push_back(asset);
+        }
+    }
+
+    // Sort by name hash, so assets can be found with a binary search.
+    // A stable sort keeps assets with the same hash in the order they appear in the Barn.
+    std::stable_sort(mAssets.begin(), mAssets.end(), [](const BarnAsset& a, const BarnAsset& b) {
+        return a.nameHash < b.nameHash;
+    });
+
+    // If an asset name appears more than once, the last one wins - remove any earlier ones.
+    // Since assets with the same name have the same hash, only assets right after each asset need to be checked.
+    size_t keepCount = 0;
+    for(size_t i = 0; i < mAssets.size(); ++i)
+    {
+        bool isDuplicate = false;
+        for(size_t j = i + 1; j < mAssets.size() && mAssets[j].nameHash == mAssets[i].nameHash; ++j)
+        {
+            if(StringUtil::EqualsIgnoreCase(GetAssetName(mAssets[i]), GetAssetName(mAssets[j])))
+            {
+                isDuplicate = true;
+                break;
+            }
+        }
+        if(!isDuplicate)
+        {
+            mAssets[keepCount] = mAssets[i];
+            ++keepCount;
+        }
+    }
+    mAssets.resize(keepCount);
+    return true;
+}
+
+bool BarnFile::ReadIndexFile(const std::string& indexFilePath, uint64_t barnSize, uint64_t barnWriteTime)
+{
+    // The entire index is read with a single read.
+    uint32_t bufferSize = 0;
+    std::unique_ptr<uint8_t[]> buffer(File::ReadIntoBuffer(indexFilePath, bufferSize));
+    const uint32_t kHeaderSize = 36;
+    if(buffer == nullptr || bufferSize < kHeaderSize)
+    {
+        return false;
+    }
+
+    // Make sure the index is for this exact Barn.
+    BinaryReader reader(buffer.get(), bufferSize);
+    if(reader.ReadUInt() != kIndexIdentifier || reader.ReadUInt() != kIndexVersion ||
+       reader.ReadULong() != barnSize || reader.ReadULong() != barnWriteTime)
+    {
+        return false;
+    }
+    uint32_t dataOffset = reader.ReadUInt();
+    uint32_t assetCount = reader.ReadUInt();
+    uint32_t namesSize = reader.ReadUInt();
+
+    // Make sure the index isn't truncated. Each asset is 17 bytes.
+    const uint32_t kAssetSize = 17;
+    if(static_cast<uint64_t>(kHeaderSize) + static_cast<uint64_t>(assetCount) * kAssetSize + namesSize != bufferSize)
+    {
+        return false;
+    }
 
-            // Map asset name to asset for fast lookup later.
-            mAssetMap[asset.name] = asset;
+    // Read assets and names.
+    std::vector<BarnAsset> assets(assetCount);
+    for(BarnAsset& asset : assets)
+    {
+        asset.nameHash = reader.ReadUInt();
+        asset.nameOffset = reader.ReadUInt();
+        asset.offset = reader.ReadUInt();
+        asset.size = reader.ReadUInt();
+
+        // Compression type 3 is already converted to none when reading the table of contents, so only known types are ever written.
+        // Anything else means the index is corrupt (or from an incompatible build), and must not be trusted.
+        uint8_t compressionType = reader.ReadByte();
+        if(compressionType > static_cast<uint8_t>(CompressionType::Lzo))
+        {
+            return false;
         }
+        asset.compressionType = static_cast<CompressionType>(compressionType);
+        if(asset.nameOffset >= namesSize)
+        {
+            return false;
+        }
+    }
+    std::vector<char> assetNames(namesSize);
+    if(namesSize > 0)
+    {
+        reader.Read(reinterpret_cast<uint8_t*>(assetNames.data()), namesSize);
+        if(assetNames.back() != '\0')
+        {
+            return false;
+        }
+    }
+
+    // The index is valid - use it.
+    mDataOffset = dataOffset;
+    mAssets = std::move(assets);
+    mAssetNames = std::move(assetNames);
+    return true;
+}
+
+void BarnFile::WriteIndexFile(const std::string& indexFilePath, uint64_t barnSize, uint64_t barnWriteTime) const
+{
+    BinaryWriter writer(indexFilePath.c_str());
+    if(!writer.CanWrite())
+    {
+        std::cout << "Failed to write barn index to " << indexFilePath << "\n";
+        return;
+    }
+
+    // Header: identifies the index, and the Barn it was created from.
+    writer.WriteUInt(kIndexIdentifier);
+    writer.WriteUInt(kIndexVersion);
+    writer.WriteULong(barnSize);
+    writer.WriteULong(barnWriteTime);
+    writer.WriteUInt(mDataOffset);
+    writer.WriteUInt(static_cast<uint32_t>(mAssets.size()));
+    writer.WriteUInt(static_cast<uint32_t>(mAssetNames.size()));
+
+    // Assets, then all names.
+    for(const BarnAsset& asset : mAssets)
+    {
+        writer.WriteUInt(asset.nameHash);
+        writer.WriteUInt(asset.nameOffset);
+        writer.WriteUInt(asset.offset);
+        writer.WriteUInt(asset.size);
+        writer.WriteByte(static_cast<uint8_t>(asset.compressionType));
+    }
+    if(!mAssetNames.empty())
+    {
+        writer.Write(reinterpret_cast<const uint8_t*>(mAssetNames.data()), static_cast<uint32_t>(mAssetNames.size()));
     }
 }
 
@@ -194,19 +426,97 @@ uint8_t* BarnFile::CreateAssetBuffer(const std::string& assetName, uint32_t& out
     outBufferSize = 0;
 
     // Get the asset handle associated with this asset name.
-    auto it = mAssetMap.find(assetName);
-    if(it == mAssetMap.end())
+    const BarnAsset* asset = GetAsset(assetName);
+    if(asset == nullptr)
     {
         return nullptr;
     }
-    const BarnAsset& asset = it->second;
+    return CreateAssetBuffer(*asset, outBufferSize);
+}
 
-    // Make sure this asset actually exists within this barn file, and it isn't a pointer to another barn file.
-    if(asset.IsPointer())
+bool BarnFile::LoadAssetData(const std::string& assetName, AssetData& outAssetData) const
+{
+    const BarnAsset* asset = GetAsset(assetName);
+    return asset != nullptr && LoadAssetData(*asset, outAssetData);
+}
+
+bool BarnFile::LoadAssetData(uint32_t index, AssetData& outAssetData) const
+{
+    return index < mAssets.size() && LoadAssetData(mAssets[index], outAssetData);
+}
+
+bool BarnFile::LoadAssetData(const BarnAsset& asset, AssetData& outAssetData) const
+{
+    // If memory mapped, uncompressed assets don't need to be copied at all - just hand out a view of the mapped bytes.
+    if(IsMemoryMapped() && asset.compressionType == CompressionType::None)
     {
+        uint32_t availableSize = 0;
+        const uint8_t* assetBytes = GetMappedAssetBytes(asset, 0, availableSize);
+        if(assetBytes == nullptr || availableSize != asset.size)
+        {
+            std::cout << "Asset " << GetAssetName(asset) << " extends past end of barn file.\n";
+            return false;
+        }
+        outAssetData.SetView(assetBytes, asset.size);
+        return true;
+    }
+
+    // Otherwise, we need to create a buffer containing the (decompressed) asset data.
+    uint32_t bufferSize = 0;
+    uint8_t* buffer = CreateAssetBuffer(asset, bufferSize);
+    // Note: buffer size is only set once the buffer is created - so create the buffer BEFORE passing the size to SetBytes.
+    outAssetData.SetBytes(buffer, bufferSize);
+    return outAssetData.bytes != nullptr;
+}
+
+void BarnFile::ForEachAsset(const std::function<void(const std::string&)>& callback) const
+{
+    // Iterate all assets and execute the callback on each one.
+    std::string assetName;
+    for(const BarnAsset& asset : mAssets)
+    {
+        assetName = GetAssetName(asset);
+        callback(assetName);
+    }
+}
+
+const BarnAsset* BarnFile::GetAsset(const std::string& assetName) const
+{
+    // Binary search for the first asset with a matching hash.
+    uint32_t nameHash = static_cast<uint32_t>(StringUtil::HashCaseInsensitive(assetName));
+    auto it = std::lower_bound(mAssets.begin(), mAssets.end(), nameHash, [](const BarnAsset& asset, uint32_t hash) {
+        return asset.nameHash < hash;
+    });
+
+    // Different names can have the same hash, so check names until the hash no longer matches.
+    for(; it != mAssets.end() && it->nameHash == nameHash; ++it)
+    {
+        if(StringUtil::EqualsIgnoreCase(assetName, GetAssetName(*it)))
+        {
+            return &(*it);
+        }
+    }
+    return nullptr;
+}
+
+const uint8_t* BarnFile::GetMappedAssetBytes(const BarnAsset& asset, uint32_t headerSize, uint32_t& outAvailableSize) const
+{
+    // Asset data starts "headerSize" bytes after the asset's offset in the data section.
+    uint64_t start = static_cast<uint64_t>(mDataOffset) + asset.offset + headerSize;
+    if(start > mMappedFile.GetSize())
+    {
+        outAvailableSize = 0;
         return nullptr;
     }
 
+    // The asset may be cut short by the end of the file - let the caller decide whether that's acceptable.
+    uint64_t available = mMappedFile.GetSize() - start;
+    outAvailableSize = available < asset.size ? static_cast<uint32_t>(available) : asset.size;
+    return mMappedFile.GetData() + start;
+}
+
+uint8_t* BarnFile::CreateAssetBuffer(const BarnAsset& asset, uint32_t& outBufferSize) const
+{
     // If this is an uncompressed asset, we can simply read the bytes and be done with it - easy.
     if(asset.compressionType == CompressionType::None)
     {
@@ -214,25 +524,73 @@ uint8_t* BarnFile::CreateAssetBuffer(const std::string& assetName, uint32_t& out
         uint8_t* buffer = new uint8_t[asset.size];
         outBufferSize = asset.size;
 
+        // If memory mapped, just copy the bytes out of the mapping - no lock required.
+        if(IsMemoryMapped())
+        {
+            uint32_t availableSize = 0;
+            const uint8_t* assetBytes = GetMappedAssetBytes(asset, 0, availableSize);
+            if(assetBytes == nullptr || availableSize != asset.size)
+            {
+                std::cout << "Asset " << GetAssetName(asset) << " extends past end of barn file.\n";
+                delete[] buffer;
+                outBufferSize = 0;
+                return nullptr;
+            }
+            memcpy(buffer, assetBytes, asset.size);
+            return buffer;
+        }
+
         // Seek to the data and read into the buffer. Since it's already uncompressed, we're done!
         mReaderMutex.lock();
-        mReader.Seek(mDataOffset + asset.offset);
-        mReader.Read(buffer, asset.size);
+        mReader->Seek(mDataOffset + asset.offset);
+        mReader->Read(buffer, asset.size);
         mReaderMutex.unlock();
         return buffer;
     }
 
-    // Otherwise, data is compressed - we need to read in compressed data, and then use an appropriate decompressor.
-    // Create buffer to hold compressed data.
-    uint8_t* compressedBuffer = new uint8_t[asset.size];
+    // Otherwise, data is compressed - we need to get at the compressed data, and then use an appropriate decompressor.
+    // Compressed data is preceded by an 8-byte header: the decompressed size, followed by an unknown value.
+    const uint32_t kCompressedHeaderSize = 8;
+    if(IsMemoryMapped())
+    {
+        // Get the decompressed asset size from the header.
+        uint32_t headerAvailableSize = 0;
+        const uint8_t* headerBytes = GetMappedAssetBytes(asset, 0, headerAvailableSize);
+        if(headerBytes == nullptr || headerAvailableSize < kCompressedHeaderSize)
+        {
+            std::cout << "Didn't read desired number of bytes.\n";
+            return nullptr;
+        }
+        memcpy(&outBufferSize, headerBytes, sizeof(uint32_t));
+
+        // Decompress straight from the mapped memory.
+        // The "-1" case can happen when reading the last file in the barn, but asset is still valid.
+        uint32_t compressedSize = 0;
+        const uint8_t* compressedBytes = GetMappedAssetBytes(asset, kCompressedHeaderSize, compressedSize);
+        if(compressedBytes == nullptr || (compressedSize != asset.size && compressedSize != asset.size - 1))
+        {
+            std::cout << "Didn't read desired number of bytes.\n";
+            outBufferSize = 0;
+            return nullptr;
+        }
+        return Decompress(asset, compressedBytes, compressedSize, outBufferSize);
+    }
+
+    // Use this thread's scratch buffer to hold compressed data.
+    std::vector<uint8_t>& compressedBufferVec = tDecompressionContext.compressedBuffer;
+    if(compressedBufferVec.size() < asset.size)
+    {
+        compressedBufferVec.resize(asset.size);
+    }
+    uint8_t* compressedBuffer = compressedBufferVec.data();
 
     // Read compressed data into a buffer.
     // Also grab the decompressed asset size while we're there.
     mReaderMutex.lock();
-    mReader.Seek(mDataOffset + asset.offset);
-    outBufferSize = mReader.ReadUInt();
-    mReader.Skip(4);
-    uint32_t readCount = mReader.Read(compressedBuffer, asset.size);
+    mReader->Seek(mDataOffset + asset.offset);
+    outBufferSize = mReader->ReadUInt();
+    mReader->Skip(4);
+    uint32_t readCount = mReader->Read(compressedBuffer, asset.size);
     mReaderMutex.unlock();
 
     // Make sure we read what we were expecting.
@@ -240,52 +598,38 @@ uint8_t* BarnFile::CreateAssetBuffer(const std::string& assetName, uint32_t& out
     if(readCount != asset.size && readCount != asset.size - 1)
     {
         std::cout << "Didn't read desired number of bytes.\n";
-        delete[] compressedBuffer;
         return nullptr;
     }
+    return Decompress(asset, compressedBuffer, asset.size, outBufferSize);
+}
 
+uint8_t* BarnFile::Decompress(const BarnAsset& asset, const uint8_t* compressedBytes, uint32_t compressedSize, uint32_t& inOutBufferSize) const
+{
     // Create buffer for uncompressed data.
-    uint8_t* buffer = new uint8_t[outBufferSize];
+    uint8_t* buffer = new uint8_t[inOutBufferSize];
 
     // How we decompress the data depends on the compression type...
     if(asset.compressionType == CompressionType::Zlib)
     {
-        // Create params object.
-        z_stream strm {};
-        strm.next_in = compressedBuffer;
-        strm.avail_in = asset.size;
-        strm.next_out = buffer;
-        strm.avail_out = outBufferSize;
-        strm.zalloc = Z_NULL;
-        strm.zfree = Z_NULL;
-        strm.opaque = Z_NULL;
-
-        // Make sure zlib is initialized for "inflation".
-        int result = inflateInit(&strm);
-        if(result != Z_OK)
+        // Get this thread's inflate stream, ready for "inflation".
+        z_stream* strm = tDecompressionContext.GetZlibStream();
+        if(strm == nullptr)
         {
-            std::cout << "Error when calling inflateInit: " << result << "\n";
-            delete[] compressedBuffer;
             delete[] buffer;
             return nullptr;
         }
 
+        // Set params. zlib never writes to the input, it just isn't declared const.
+        strm->next_in = const_cast<uint8_t*>(compressedBytes);
+        strm->avail_in = compressedSize;
+        strm->next_out = buffer;
+        strm->avail_out = inOutBufferSize;
+
         // Inflate the data!
-        result = inflate(&strm, Z_FINISH);
+        int result = inflate(strm, Z_FINISH);
         if(result != Z_STREAM_END)
         {
             std::cout << "Inflate didn't inflate entire stream, or an error occurred: " << result << "\n";
-            delete[] compressedBuffer;
-            delete[] buffer;
-            return nullptr;
-        }
-
-        // Uninit zlib.
-        result = inflateEnd(&strm);
-        if(result != Z_OK)
-        {
-            std::cout << "Error while ending inflate: " << result << "\n";
-            delete[] compressedBuffer;
             delete[] buffer;
             return nullptr;
         }
@@ -293,29 +637,22 @@ uint8_t* BarnFile::CreateAssetBuffer(const std::string& assetName, uint32_t& out
     else if(asset.compressionType == CompressionType::Lzo)
     {
         // Make sure LZO library is initialized.
-        static bool initLzo = false;
+        // A function-local static is initialized exactly once, even if multiple threads get here at the same time.
+        static const bool initLzo = (lzo_init() == LZO_E_OK);
         if(!initLzo)
         {
-            int initResult = lzo_init();
-            if(initResult == LZO_E_OK)
-            {
-                initLzo = true;
-            }
-            else
-            {
-                std::cout << "Failed to init LZO!\n";
-                delete[] compressedBuffer;
-                delete[] buffer;
-                return nullptr;
-            }
+            std::cout << "Failed to init LZO!\n";
+            delete[] buffer;
+            return nullptr;
         }
 
         // Decompress using LZO library. GK3 data appears to be compressed with lzo1x.
         //std::cout << asset->name << ": decompressing " << asset->compressedSize << " bytes to a buffer of size " << bufferSize << std::endl;
-        lzo_bytep compressedPtr = static_cast<lzo_bytep>(compressedBuffer);
+        // Like zlib, LZO doesn't write to the input, even though the parameter isn't declared as pointer-to-const.
+        lzo_bytep compressedPtr = const_cast<lzo_bytep>(compressedBytes);
         lzo_bytep bufferPtr = static_cast<lzo_bytep>(buffer);
         lzo_uint bufferSize = 0;
-        int result = lzo1x_decompress(compressedPtr, asset.size, bufferPtr, &bufferSize, nullptr);
+        int result = lzo1x_decompress(compressedPtr, compressedSize, bufferPtr, &bufferSize, nullptr);
 
         // For some reason *most* GK3 data decompresses with result of LZO_E_INPUT_NOT_CONSUMED.
         // This still works OK. It may indicate that "compressedSize" passed is larger than the compressed data.
@@ -323,38 +660,20 @@ uint8_t* BarnFile::CreateAssetBuffer(const std::string& assetName, uint32_t& out
         if(result != LZO_E_OK && result != LZO_E_INPUT_NOT_CONSUMED)
         {
             std::cout << "Error during LZO decompress: " << result << "\n";
-            delete[] compressedBuffer;
             delete[] buffer;
             return nullptr;
         }
 
         // Set buffer size for caller to use.
-        outBufferSize = static_cast<uint32_t>(bufferSize);
+        inOutBufferSize = static_cast<uint32_t>(bufferSize);
     }
     else
     {
-        std::cout << "Asset " << asset.name << " has invalid compression type " << static_cast<int>(asset.compressionType) << "\n";
-        delete[] compressedBuffer;
+        std::cout << "Asset " << GetAssetName(asset) << " has invalid compression type " << static_cast<int>(asset.compressionType) << "\n";
         delete[] buffer;
         return nullptr;
     }
 
-    // Delete compressed data buffer.
-    delete[] compressedBuffer;
-
     // Return decompressed buffer.
     return buffer;
-}
-
-void BarnFile::ForEachAsset(const std::function<void(const std::string&)>& callback) const
-{
-    // Iterate all assets and execute the callback on each one.
-    for(auto& entry : mAssetMap)
-    {
-        // Pointers aren't actually in this barn, so ignore them.
-        if(!entry.second.IsPointer())
-        {
-            callback(entry.first);
-        }
-    }
 }
\ No newline at end of file
@@ -8,12 +8,14 @@
 //
 #pragma once
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
 #include "BinaryReader.h"
 #include "IAssetArchive.h"
+#include "MemoryMappedFile.h"
 #include "StringUtil.h"
 
 enum class CompressionType
@@ -23,14 +25,14 @@ enum class CompressionType
     Lzo = 2
 };
 
+// An asset in a Barn. Kept small and flat, since a Barn can contain thousands of assets.
 struct BarnAsset
 {
-    // Name of barn file containing this asset.
-    // This is ONLY non-null if the asset is contained in some other Barn (e.g. it's a "pointer" to another Barn file).
-    std::string* barnFileName = nullptr;
+    // Case-insensitive hash of the asset's name. Assets are sorted by this value for fast lookup.
+    uint32_t nameHash = 0;
 
-    // The name of the asset.
-    std::string name;
+    // Offset of the asset's name in the Barn's name buffer.
+    uint32_t nameOffset = 0;
 
     // Offset of this asset within the Barn file data blob.
     uint32_t offset = 0;
@@ -41,20 +43,28 @@ struct BarnAsset
     // Compression type for this asset.
     // If set, the asset needs to be decompressed to be usable.
     CompressionType compressionType = CompressionType::None;
-
-    // True if this BarnAsset is just a pointer to another barn file.
-    bool IsPointer() const { return barnFileName != nullptr; }
 };
 
 class BarnFile : public IAssetArchive
 {
 public:
-    explicit BarnFile(const std::string& filePath);
+    // If an index path is provided, the Barn's asset index is loaded from that file (if valid), or saved there after it is built.
+    explicit BarnFile(const std::string& filePath, bool memoryMap = true, const std::string& indexFilePath = "");
+    ~BarnFile() override;
 
     const std::string& GetName() const override { return mName; }
     uint8_t* CreateAssetBuffer(const std::string& assetName, uint32_t& outBufferSize) const override;
+    bool LoadAssetData(const std::string& assetName, AssetData& outAssetData) const override;
     void ForEachAsset(const std::function<void(const std::string&)>& callback) const override;
 
+    uint32_t GetAssetCount() const override { return static_cast<uint32_t>(mAssets.size()); }
+    const char* GetAssetName(uint32_t index) const override { return &mAssetNames[mAssets[index].nameOffset]; }
+    uint32_t GetAssetNameHash(uint32_t index) const override { return mAssets[index].nameHash; }
+    bool LoadAssetData(uint32_t index, AssetData& outAssetData) const override;
+    bool IsAssetCompressed(uint32_t index) const override { return mAssets[index].compressionType != CompressionType::None; }
+
+    bool IsMemoryMapped() const { return mMappedFile.IsOpen(); }
+
 private:
     // Identifiers required to verify file type.
     const uint32_t kGameIdentifier = 0x21334B47; // GK3!
@@ -64,22 +74,40 @@ private:
     const uint32_t kDDirIdentifier = 0x44446972; // DDir
     const uint32_t kDataIdentifier = 0x44617461; // Data
 
+    // Identifies a saved Barn index file ("GKBI"). Increment the version if the index format changes.
+    const uint32_t kIndexIdentifier = 0x49424B47;
+    const uint32_t kIndexVersion = 1;
+
     // The name of the barn file.
     std::string mName;
 
     // Offset within the file to where the data is located.
     uint32_t mDataOffset = 0;
 
-    // Binary reader for extracting data.
+    // If memory mapped, the entire Barn file is mapped into memory.
+    // Any number of threads can then extract assets at the same time, with no locking required.
+    MemoryMappedFile mMappedFile;
+
+    // If NOT memory mapped, a binary reader is used for extracting data.
     // Extraction may occur on multiple threads at once, so a mutex is required to guard access.
-    mutable BinaryReader mReader;
+    mutable std::unique_ptr<BinaryReader> mReader;
     mutable std::mutex mReaderMutex;
 
-    // If *this* Barn contains pointers to *other* Barns, this contains the names of those other Barns.
-    // Individual assets that are pointers will point to these elements.
-    std::vector<std::string> mReferencedBarns;
+    // All assets in this Barn, sorted by name hash. Assets must be extracted before being used.
+    // Some Barns also contain "pointers" to assets in other Barns - those aren't included, since they can't be loaded from this Barn.
+    std::vector<BarnAsset> mAssets;
+
+    // All asset names, null-terminated, one after another. Each asset stores an offset into this buffer.
+    std::vector<char> mAssetNames;
+
+    bool ReadTableOfContents();
+    bool ReadIndexFile(const std::string& indexFilePath, uint64_t barnSize, uint64_t barnWriteTime);
+    void WriteIndexFile(const std::string& indexFilePath, uint64_t barnSize, uint64_t barnWriteTime) const;
 
-    // Map of asset name to an asset handle. Assets must be extracted before being used.
-    // Asset names are case-insensitive.
-    std::string_map_ci<BarnAsset> mAssetMap;
+    const BarnAsset* GetAsset(const std::string& assetName) const;
+    const char* GetAssetName(const BarnAsset& asset) const { return &mAssetNames[asset.nameOffset]; }
+    bool LoadAssetData(const BarnAsset& asset, AssetData& outAssetData) const;
+    const uint8_t* GetMappedAssetBytes(const BarnAsset& asset, uint32_t headerSize, uint32_t& outAvailableSize) const;
+    uint8_t* CreateAssetBuffer(const BarnAsset& asset, uint32_t& outBufferSize) const;
+    uint8_t* Decompress(const BarnAsset& asset, const uint8_t* compressedBytes, uint32_t compressedSize, uint32_t& inOutBufferSize) const;
 };
\ No newline at end of file
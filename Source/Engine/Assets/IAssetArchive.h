@@ -9,6 +9,8 @@
 #include <functional>
 #include <string>
 
+#include "Asset.h" // AssetData
+
 class IAssetArchive
 {
 public:
@@ -16,4 +18,23 @@ public:
     virtual const std::string& GetName() const = 0;
     virtual uint8_t* CreateAssetBuffer(const std::string& assetName, uint32_t& outBufferSize) const = 0;
     virtual void ForEachAsset(const std::function<void(const std::string&)>& callback) const = 0;
+
+    // Populates asset data for an asset. Unlike CreateAssetBuffer, archives may provide a view of memory they own, rather than a copy.
+    virtual bool LoadAssetData(const std::string& assetName, AssetData& outAssetData) const
+    {
+        uint32_t bufferSize = 0;
+        uint8_t* buffer = CreateAssetBuffer(assetName, bufferSize);
+        outAssetData.SetBytes(buffer, bufferSize);
+        return outAssetData.bytes != nullptr;
+    }
+
+    // Assets can also be accessed by index (0 to count - 1), which allows building an index of assets across many archives.
+    // Name hashes must match StringUtil::HashCaseInsensitive (truncated to 32 bits).
+    virtual uint32_t GetAssetCount() const = 0;
+    virtual const char* GetAssetName(uint32_t index) const = 0;
+    virtual uint32_t GetAssetNameHash(uint32_t index) const = 0;
+    virtual bool LoadAssetData(uint32_t index, AssetData& outAssetData) const = 0;
+
+    // Whether an asset is stored compressed in the archive (so loading it means decompressing it).
+    virtual bool IsAssetCompressed(uint32_t index) const = 0;
 };
\ No newline at end of file
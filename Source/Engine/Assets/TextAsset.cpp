@@ -13,6 +13,6 @@ TextAsset::~TextAsset()
 void TextAsset::Load(AssetData& data)
 {
     // Take ownership of the byte buffer.
-    mText = data.bytes.release();
+    mText = data.TakeBytes();
     mTextLength = data.length;
 }
\ No newline at end of file
@@ -12,8 +12,6 @@ TYPEINFO_INIT(Audio, Asset, GENERATE_TYPE_ID)
 
 Audio::~Audio()
 {
-    delete[] mDataBuffer;
-
     // FMOD allocates memory internally when playing an Audio file. Let it know it can get free of that memory.
     gAudioManager.ReleaseAudioData(this);
 }
@@ -21,12 +19,13 @@ Audio::~Audio()
 void Audio::Load(AssetData& data)
 {
     // Take ownership of the data buffer.
-    mDataBuffer = data.bytes.release();
+    // If the data is a view into a memory-mapped archive, keep the view - the archive stays mapped until all assets are unloaded.
+    mDataBuffer = std::move(data.bytes);
     mDataBufferLength = data.length;
 
     // The audio manager can read this data as-is (it's just WAV data).
     // But parsing it can be helpful to retrieve some info, like duration, for later use.
-    BinaryReader reader(mDataBuffer, mDataBufferLength);
+    BinaryReader reader(mDataBuffer.get(), mDataBufferLength);
 
     // First 4 bytes: chunk ID "RIFF".
     std::string identifier = reader.ReadString(4);
@@ -117,4 +116,14 @@ void Audio::Load(AssetData& data)
     //std::cout << "Data chunk size is " << dataChunkSize << std::endl;
 
     mDuration = static_cast<float>(dataChunkSize) / static_cast<float>(byteRate);
+}
+
+size_t Audio::CalculateMemorySize(uint32_t loadedDataLength) const
+{
+    // A view into a memory-mapped archive isn't memory this asset holds; evicting the asset wouldn't free it.
+    if(mDataBuffer == nullptr || !mDataBuffer.get_deleter().owned)
+    {
+        return 0;
+    }
+    return mDataBufferLength;
 }
\ No newline at end of file
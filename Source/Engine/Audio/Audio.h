@@ -16,8 +16,9 @@ public:
     ~Audio() override;
 
     void Load(AssetData& data);
+    size_t CalculateMemorySize(uint32_t loadedDataLength) const override;
 
-    uint8_t* GetDataBuffer() const { return mDataBuffer; }
+    uint8_t* GetDataBuffer() const { return mDataBuffer.get(); }
     uint32_t GetDataBufferLength() const { return mDataBufferLength; }
 
     float GetDuration() const { return mDuration; }
@@ -27,7 +28,8 @@ private:
     //const unsigned short kMp3Format = 0x0055;
 
     // Audio data buffer - the contents of WAV file in memory.
-    uint8_t* mDataBuffer = nullptr;
+    // Audio is only ever read from this buffer, so it may be a view into a memory-mapped archive rather than a copy.
+    std::unique_ptr<uint8_t, AssetDataDeleter> mDataBuffer;
     uint32_t mDataBufferLength = 0;
 
     // The length of the audio file, calculated from taking (data size / samples per second).
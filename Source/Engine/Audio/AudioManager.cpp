@@ -478,6 +478,13 @@ PlayingSoundHandle AudioManager::Play(const PlayAudioParams& params)
     // Store finish callback.
     mPlayingSounds.back().mFinishCallback = params.finishCallback;
 
+    // Reference the audio while it plays, so it isn't evicted. Audio that isn't cached can't be referenced, but also can't be evicted.
+    AssetHandle<Audio> audioHandle = AssetCache<Audio>::Get()->GetHandle(params.audio->GetName());
+    if(audioHandle.Get() == params.audio)
+    {
+        mPlayingSounds.back().mAudio = std::move(audioHandle);
+    }
+
     // If 3D, set positional and distance parameters.
     if(params.is3d)
     {
@@ -532,7 +539,10 @@ PlayingSoundHandle AudioManager::Play(const PlayAudioParams& params)
     channel->setPaused(false);
 
     // Return handle to caller.
-    return mPlayingSounds.back();
+    // Callers may hold on to their handle long after the sound is done, so their copy doesn't reference the audio.
+    PlayingSoundHandle soundHandle = mPlayingSounds.back();
+    soundHandle.mAudio.Reset();
+    return soundHandle;
 }
 
 void AudioManager::Stop(Audio* audio)
@@ -11,6 +11,7 @@
 
 #include <fmod.hpp>
 
+#include "AssetCache.h"
 #include "Vector3.h"
 
 class Audio;
@@ -48,6 +49,10 @@ private:
 
     // The frame this sound started on.
     uint32_t mStartFrame = 0;
+
+    // Keeps the audio asset loaded while the sound plays, so it can still be stopped by its Audio pointer.
+    // Only the audio manager's own copy of the handle holds this.
+    AssetHandle<Audio> mAudio;
 };
 
 struct AudioSaveState
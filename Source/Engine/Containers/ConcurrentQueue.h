@@ -0,0 +1,126 @@
+//
+// Clark Kromenaker
+//
+// A queue container (first in, first out) that many threads can add to, while one thread removes from it.
+// Adding and removing never take a lock.
+//
+// Characteristics:
+// - Fixed size: max container size must be known at compile time, and must be a power of two.
+// - Multiple producers, single consumer: any thread can push, but only one thread (at a time) may pop.
+// - Bounded: if the queue is full, a push fails - it's up to the caller to decide what to do in that case.
+//
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <new>     // for placement "new"
+#include <utility> // std::move
+
+template<typename T, uint32_t TCapacity>
+class ConcurrentQueue
+{
+public:
+    static_assert(TCapacity > 0 && (TCapacity & (TCapacity - 1)) == 0, "ConcurrentQueue capacity must be a power of two.");
+
+    ConcurrentQueue()
+    {
+        // Each cell's sequence number says which push (or pop) the cell is ready for.
+        for(uint32_t i = 0; i < TCapacity; ++i)
+        {
+            mCells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~ConcurrentQueue()
+    {
+        // Destroy any elements that were never popped.
+        T value;
+        while(Pop(value)) { }
+    }
+
+    // Not copyable - other threads may be using the queue.
+    ConcurrentQueue(const ConcurrentQueue&) = delete;
+    ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+
+    // Adds a value to the back of the queue. Safe to call from any thread.
+    // Returns false if the queue is full - in that case, the value is NOT moved from.
+    bool Push(T&& value)
+    {
+        // Claim a cell by advancing the tail. Another producer may beat us to it, in which case we try the next cell.
+        Cell* cell = nullptr;
+        uint32_t position = mTail.load(std::memory_order_relaxed);
+        while(true)
+        {
+            cell = &mCells[position & (TCapacity - 1)];
+            uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+            int32_t diff = static_cast<int32_t>(sequence - position);
+            if(diff == 0)
+            {
+                // Cell is free - try to claim it.
+                if(mTail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if(diff < 0)
+            {
+                // Cell hasn't been popped since the last time around the buffer - so the queue is full.
+                return false;
+            }
+            else
+            {
+                // Another producer claimed this cell - reload the tail and try again.
+                position = mTail.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Fill the cell, then publish it to the consumer.
+        new(cell->storage) T(std::move(value));
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Removes the value at the front of the queue. Must only be called from one thread at a time.
+    // Returns false if the queue is empty.
+    bool Pop(T& outValue)
+    {
+        uint32_t position = mHead.load(std::memory_order_relaxed);
+        Cell& cell = mCells[position & (TCapacity - 1)];
+
+        // If the cell hasn't been published yet, the queue is empty (or the push is still in progress).
+        uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if(static_cast<int32_t>(sequence - (position + 1)) < 0)
+        {
+            return false;
+        }
+
+        // Move the value out, then mark the cell as free for the push one time around the buffer from now.
+        T* value = reinterpret_cast<T*>(cell.storage);
+        outValue = std::move(*value);
+        value->~T();
+        cell.sequence.store(position + TCapacity, std::memory_order_release);
+        mHead.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Number of elements in the queue. Only approximate if other threads are pushing or popping at the same time.
+    uint32_t GetSize() const
+    {
+        uint32_t head = mHead.load(std::memory_order_relaxed);
+        uint32_t tail = mTail.load(std::memory_order_relaxed);
+        return static_cast<int32_t>(tail - head) > 0 ? tail - head : 0;
+    }
+    static constexpr uint32_t GetCapacity() { return TCapacity; }
+
+private:
+    struct Cell
+    {
+        std::atomic<uint32_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    Cell mCells[TCapacity];
+
+    // Positions of the next push and the next pop. These keep counting up, and wrap around at 2^32 (which is fine, since the capacity is a power of two).
+    // They are on separate cache lines, so producers and the consumer don't slow each other down.
+    alignas(64) std::atomic<uint32_t> mTail { 0 };
+    alignas(64) std::atomic<uint32_t> mHead { 0 };
+};
\ No newline at end of file
@@ -0,0 +1,183 @@
+//
+// Clark Kromenaker
+//
+// A map from case-insensitive string keys to pointers, optimized for data that is read often and written rarely.
+//
+// Reads (Find/Get) never take a lock, so any number of threads can read while another thread writes.
+// Writes (Set) are serialized with a mutex.
+//
+// Characteristics:
+// - Open addressing: keys are hashed (case-folded) and stored in a power-of-two table, which is kept at most half full.
+// - Stable entries: once a key is added, its entry is never moved or deleted (setting a null value "removes" the key).
+//   This allows callers to hold onto an entry and skip the key lookup entirely in the future.
+// - Grow only: when the table grows, the old table is kept around, since another thread may still be reading it.
+//   Since the table doubles in size each time, this at most doubles the memory used by the tables.
+//
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "StringUtil.h"
+
+template<typename T>
+class ConcurrentStringMap
+{
+public:
+    struct Entry
+    {
+        Entry(const std::string& key, uint32_t hash) : key(StringUtil::ToUpperCopy(key)), hash(hash) { }
+
+        // The key (upper-case) and its hash.
+        const std::string key;
+        const uint32_t hash;
+
+        // The value for this key. Null if the key has been removed.
+        std::atomic<T*> value { nullptr };
+    };
+
+    static uint32_t Hash(const std::string& key) { return static_cast<uint32_t>(StringUtil::HashCaseInsensitive(key)); }
+
+    ConcurrentStringMap()
+    {
+        mTables.emplace_back(new Table(kInitialCapacity));
+        mTable.store(mTables.back().get(), std::memory_order_release);
+    }
+
+    // Not copyable - readers may be holding pointers to entries.
+    ConcurrentStringMap(const ConcurrentStringMap&) = delete;
+    ConcurrentStringMap& operator=(const ConcurrentStringMap&) = delete;
+
+    const Entry* Find(const std::string& key) const { return Find(key, Hash(key)); }
+    const Entry* Find(const std::string& key, uint32_t hash) const
+    {
+        return FindInTable(mTable.load(std::memory_order_acquire), key, hash);
+    }
+
+    T* Get(const std::string& key) const
+    {
+        const Entry* entry = Find(key);
+        return entry != nullptr ? entry->value.load(std::memory_order_acquire) : nullptr;
+    }
+
+    const Entry* Set(const std::string& key, T* value)
+    {
+        std::lock_guard<std::mutex> lock(mWriteMutex);
+
+        // If the key already exists, just update the value.
+        uint32_t hash = Hash(key);
+        Entry* entry = FindInTable(mTables.back().get(), key, hash);
+        if(entry != nullptr)
+        {
+            entry->value.store(value, std::memory_order_release);
+            return entry;
+        }
+
+        // Make sure there's room for one more entry.
+        if((mEntries.size() + 1) * 2 > mTables.back()->capacity)
+        {
+            Grow();
+        }
+
+        // Fully initialize the entry BEFORE it's added to the table, so readers never see a partially set up entry.
+        mEntries.emplace_back(new Entry(key, hash));
+        entry = mEntries.back().get();
+        entry->value.store(value, std::memory_order_relaxed);
+        Insert(mTables.back().get(), entry);
+        return entry;
+    }
+
+    // Number of keys ever added (including ones whose value has since been set to null).
+    size_t GetEntryCount() const
+    {
+        std::lock_guard<std::mutex> lock(mWriteMutex);
+        return mEntries.size();
+    }
+
+private:
+    static const uint32_t kInitialCapacity = 64;
+
+    struct Table
+    {
+        explicit Table(uint32_t capacity) : capacity(capacity), slots(new std::atomic<Entry*>[capacity])
+        {
+            for(uint32_t i = 0; i < capacity; ++i)
+            {
+                slots[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        const uint32_t capacity;
+        std::unique_ptr<std::atomic<Entry*>[]> slots;
+    };
+
+    // The table readers should use. Always the last table in the tables list.
+    std::atomic<Table*> mTable { nullptr };
+
+    // All tables ever created. Older ones are kept alive, since readers may still be using them.
+    std::vector<std::unique_ptr<Table>> mTables;
+
+    // All entries ever created, owned by the map.
+    std::vector<std::unique_ptr<Entry>> mEntries;
+
+    // Guards all writes.
+    mutable std::mutex mWriteMutex;
+
+    static uint32_t GetStartSlot(uint32_t hash, uint32_t capacity)
+    {
+        // The low bits of the string hash aren't well distributed, so mix them up a bit before using them as an index.
+        hash ^= hash >> 16;
+        hash *= 0x45D9F3B;
+        hash ^= hash >> 16;
+        return hash & (capacity - 1);
+    }
+
+    static Entry* FindInTable(const Table* table, const std::string& key, uint32_t hash)
+    {
+        // Linear probe until we find the key, or an empty slot (meaning the key isn't present).
+        // Since the table is never more than half full, there's always an empty slot to stop at.
+        uint32_t mask = table->capacity - 1;
+        for(uint32_t i = GetStartSlot(hash, table->capacity); ; i = (i + 1) & mask)
+        {
+            Entry* entry = table->slots[i].load(std::memory_order_acquire);
+            if(entry == nullptr)
+            {
+                return nullptr;
+            }
+            if(entry->hash == hash && StringUtil::EqualsIgnoreCase(entry->key, key))
+            {
+                return entry;
+            }
+        }
+    }
+
+    static void Insert(Table* table, Entry* entry)
+    {
+        uint32_t mask = table->capacity - 1;
+        uint32_t i = GetStartSlot(entry->hash, table->capacity);
+        while(table->slots[i].load(std::memory_order_relaxed) != nullptr)
+        {
+            i = (i + 1) & mask;
+        }
+
+        // Release, so a reader that sees this entry also sees its key and value.
+        table->slots[i].store(entry, std::memory_order_release);
+    }
+
+    void Grow()
+    {
+        // Create a table twice the size and add all existing entries to it.
+        Table* newTable = new Table(mTables.back()->capacity * 2);
+        for(auto& entry : mEntries)
+        {
+            Insert(newTable, entry.get());
+        }
+
+        // Switch readers over to the new table. The old table stays valid for any readers still using it.
+        mTables.emplace_back(newTable);
+        mTable.store(newTable, std::memory_order_release);
+    }
+};
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "GEngine.h"
 
+#include <algorithm>
 #include <cassert>
 
 #include <SDL.h>
@@ -197,6 +198,9 @@ void GEngine::Shutdown()
     // Shutdown scene manager (unloads scene and deletes all actors).
     gSceneManager.Shutdown();
 
+    // UI atlas and batching resources hold on to textures and GPU buffers, so free them before the asset manager and renderer go away.
+    UICanvas::Shutdown();
+
     // Even though asset manager is initialized first...
     // We want to shut it down earlier b/c its assets may need to destroy data in the rendering/audio systems.
     gAssetManager.Shutdown();
@@ -319,6 +323,29 @@ bool GEngine::InitAssetManager()
                 gAssetManager.AddSearchPath(path);
             }
         }
+
+        // Barns are memory mapped by default, which allows assets to be loaded on many threads at once without contention.
+        // A 32-bit process may not have enough address space to map every Barn, so default to off in that case.
+        #if defined(ENV32)
+        gAssetManager.SetMemoryMapArchives(config->GetBool("Memory Map Barns", false));
+        #else
+        gAssetManager.SetMemoryMapArchives(config->GetBool("Memory Map Barns", true));
+        #endif
+
+        // Optionally, decompressed assets are cached in the user data directory, so they only need to be decompressed the first time the game runs.
+        // This trades disk space for load time, so it is off by default.
+        if(config->GetBool("Asset Disk Cache", false))
+        {
+            const uint64_t kBytesPerMegabyte = 1024 * 1024;
+            uint64_t maxCacheSize = static_cast<uint64_t>(std::max(config->GetInt("Asset Disk Cache Size", 256), 0)) * kBytesPerMegabyte;
+            gAssetManager.SetDiskCacheDirectory(Paths::GetUserDataPath("Cache"), maxCacheSize);
+        }
+
+        // Optional memory budgets for the asset types that use the most memory.
+        const size_t kBytesPerMegabyte = 1024 * 1024;
+        gAssetManager.SetMemoryBudget<Texture>(std::max(config->GetInt("Texture Memory Budget", 0), 0) * kBytesPerMegabyte);
+        gAssetManager.SetMemoryBudget<Audio>(std::max(config->GetInt("Audio Memory Budget", 0), 0) * kBytesPerMegabyte);
+        gAssetManager.SetMemoryBudget<VertexAnimation>(std::max(config->GetInt("Vertex Animation Memory Budget", 0), 0) * kBytesPerMegabyte);
     }
 
     // Add hard-coded default paths *after* any custom paths specified in .INI file.
@@ -793,7 +820,23 @@ void GEngine::Update()
     Tools::Update();
 
     // Run any waiting functions on the main thread.
-    ThreadUtil::RunFunctionsOnMainThread();
+    // These are time-sliced, so a burst of callbacks (e.g. during a big load) is spread over several frames, rather than causing a hitch.
+    // High priority functions (such as load completions) aren't time-sliced.
+    const float kMainThreadFunctionMilliseconds = 4.0f;
+    ThreadUtil::RunFunctionsOnMainThread(kMainThreadFunctionMilliseconds);
+    ThreadUtil::MainThreadQueueStats mainThreadQueueStats = ThreadUtil::GetMainThreadQueueStats();
+    PROFILER_COUNTER("Main Thread Functions Queued", static_cast<int>(mainThreadQueueStats.queuedCount));
+    PROFILER_COUNTER("Main Thread Functions Queued (Peak)", static_cast<int>(mainThreadQueueStats.peakQueuedCount));
+    PROFILER_COUNTER("Main Thread Functions Run", static_cast<int>(mainThreadQueueStats.lastRunCount));
+    PROFILER_COUNTER("Main Thread Functions Run (us)", static_cast<int>(mainThreadQueueStats.lastRunMilliseconds * 1000.0f));
+    PROFILER_COUNTER("Main Thread Functions Overflowed", static_cast<int>(mainThreadQueueStats.overflowCount));
+
+    // Evict assets from any caches that are over budget.
+    // Not while loading, since assets loaded on the loading thread may not have been referenced yet.
+    if(!Loader::IsLoading())
+    {
+        gAssetManager.EvictAssets();
+    }
 }
 
 void GEngine::UpdateGameWorld(float deltaTime)
@@ -2,7 +2,9 @@
 
 #include <fstream>
 
-#include "mstream.h"
+// Vectors are read directly from binary data, so they must be tightly packed floats.
+static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 must be tightly packed to read from binary data");
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be tightly packed to read from binary data");
 
 BinaryReader::BinaryReader(const char* filePath) :
     StreamReader(new std::ifstream(filePath, std::ios::in | std::ios::binary), true)
@@ -11,9 +13,12 @@ BinaryReader::BinaryReader(const char* filePath) :
 }
 
 BinaryReader::BinaryReader(const uint8_t* memory, uint32_t memoryLength) :
-    StreamReader(new imstream(reinterpret_cast<const char*>(memory), memoryLength), true)
+    StreamReader(nullptr),
+    mMemory(memory != nullptr ? memory : reinterpret_cast<const uint8_t*>("")),
+    mMemoryLength(memory != nullptr ? memoryLength : 0)
 {
-    //mStream = new imstream(reinterpret_cast<const char*>(memory), memoryLength);
+    // No stream needed - all reads go straight to memory.
+    // If given null memory, we still read from (empty) memory, so all reads just fail.
 }
 
 BinaryReader::BinaryReader(const char* memory, uint32_t memoryLength) :
@@ -27,80 +32,101 @@ BinaryReader::BinaryReader(std::istream* stream) : StreamReader(stream)
 
 }
 
-uint32_t BinaryReader::Read(uint8_t* buffer, uint32_t size)
-{
-    mStream->read(reinterpret_cast<char*>(buffer), size);
-    return static_cast<uint32_t>(mStream->gcount());
-}
-
-uint8_t BinaryReader::ReadByte()
-{
-    uint8_t val;
-    mStream->read(reinterpret_cast<char*>(&val), 1);
-    return val;
-}
-
-int8_t BinaryReader::ReadSByte()
-{
-    int8_t val;
-    mStream->read(reinterpret_cast<char*>(&val), 1);
-    return val;
-}
-
-uint16_t BinaryReader::ReadUShort()
+bool BinaryReader::CanRead() const
 {
-    uint16_t val;
-    mStream->read(reinterpret_cast<char*>(&val), 2);
-    return val;
+    if(mMemory != nullptr)
+    {
+        return !mMemoryFail && !mMemoryEof;
+    }
+    return StreamReader::CanRead();
 }
 
-int16_t BinaryReader::ReadShort()
+bool BinaryReader::EndOfFile() const
 {
-    int16_t val;
-    mStream->read(reinterpret_cast<char*>(&val), 2);
-    return val;
+    if(mMemory != nullptr)
+    {
+        return mMemoryEof;
+    }
+    return StreamReader::EndOfFile();
 }
 
-uint32_t BinaryReader::ReadUInt()
+void BinaryReader::Seek(uint32_t position)
 {
-    uint32_t val;
-    mStream->read(reinterpret_cast<char*>(&val), 4);
-    return val;
+    if(mMemory != nullptr)
+    {
+        // Same as with an imstream: seeking clears EOF, and seeking past the end just moves to the end (without failing).
+        if(mMemoryEof)
+        {
+            mMemoryFail = false;
+            mMemoryEof = false;
+        }
+        if(!mMemoryFail)
+        {
+            mMemoryPosition = position < mMemoryLength ? position : mMemoryLength;
+        }
+        return;
+    }
+    StreamReader::Seek(position);
 }
 
-int32_t BinaryReader::ReadInt()
+void BinaryReader::Skip(uint32_t count)
 {
-    int32_t val;
-    mStream->read(reinterpret_cast<char*>(&val), 4);
-    return val;
+    if(mMemory != nullptr)
+    {
+        // Like an imstream, skipping clears EOF, but does nothing if a previous read failed.
+        // Skipping past the end moves to the end without failing - the next read fails instead.
+        mMemoryEof = false;
+        if(!mMemoryFail)
+        {
+            mMemoryPosition += count < mMemoryLength - mMemoryPosition ? count : mMemoryLength - mMemoryPosition;
+        }
+        return;
+    }
+    StreamReader::Skip(count);
 }
 
-uint64_t BinaryReader::ReadULong()
+uint32_t BinaryReader::GetPosition() const
 {
-    uint64_t val;
-    mStream->read(reinterpret_cast<char*>(&val), 8);
-    return val;
+    if(mMemory != nullptr)
+    {
+        // Streams can't report a position after a failed read; returns 0 in that case, same as StreamReader.
+        return mMemoryFail ? 0 : mMemoryPosition;
+    }
+    return StreamReader::GetPosition();
 }
 
-int64_t BinaryReader::ReadLong()
+uint64_t BinaryReader::Read(char* buffer, uint64_t bufferSize)
 {
-    int64_t val;
-    mStream->read(reinterpret_cast<char*>(&val), 8);
-    return val;
+    if(mMemory != nullptr)
+    {
+        uint32_t size = bufferSize < UINT32_MAX ? static_cast<uint32_t>(bufferSize) : UINT32_MAX;
+        return Read(reinterpret_cast<uint8_t*>(buffer), size);
+    }
+    return StreamReader::Read(buffer, bufferSize);
 }
 
-float BinaryReader::ReadFloat()
+uint32_t BinaryReader::Read(uint8_t* buffer, uint32_t size)
 {
-    float val;
-    mStream->read(reinterpret_cast<char*>(&val), 4);
-    return val;
-}
+    if(mMemory != nullptr)
+    {
+        // Nothing can be read after a failed read.
+        if(mMemoryFail) { return 0; }
+
+        // Copy as much as we can. If that's not everything asked for, we've hit the end - same as a stream, that sets both EOF and fail.
+        uint32_t available = mMemoryLength - mMemoryPosition;
+        uint32_t readSize = size < available ? size : available;
+        memcpy(buffer, mMemory + mMemoryPosition, readSize);
+        mMemoryPosition += readSize;
+        if(readSize < size)
+        {
+            mMemoryFail = true;
+            mMemoryEof = true;
+        }
+        return readSize;
+    }
 
-double BinaryReader::ReadDouble()
-{
-    double val;
-    mStream->read(reinterpret_cast<char*>(&val), 8);
-    return val;
+    mStream->read(reinterpret_cast<char*>(buffer), size);
+    return static_cast<uint32_t>(mStream->gcount());
 }
 
 std::string BinaryReader::ReadString(uint32_t length)
@@ -118,7 +144,7 @@ void BinaryReader::ReadString(uint32_t size, std::string& str)
     str.resize(size);
 
     // Directly modify the string data; a little dangerous!
-    mStream->read(const_cast<char*>(str.data()), size);
+    Read(const_cast<char*>(str.data()), size);
 
     // Reduce string size if null terminator exists before end of string.
     for(size_t i = 0; i < str.size(); ++i)
@@ -164,18 +190,4 @@ void BinaryReader::ReadString32(std::string& str)
 {
     uint32_t size = ReadUInt();
     ReadString(size, str);
-}
-
-Vector2 BinaryReader::ReadVector2()
-{
-    Vector3 vector;
-    mStream->read(reinterpret_cast<char*>(&vector), 8);
-    return vector;
-}
-
-Vector3 BinaryReader::ReadVector3()
-{
-    Vector3 vector;
-    mStream->read(reinterpret_cast<char*>(&vector), 12);
-    return vector;
-}
+}
\ No newline at end of file
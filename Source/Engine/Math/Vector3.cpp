@@ -2,8 +2,19 @@
 
 #include <iomanip> // std::setprecision
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define VECTOR3_SSE
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define VECTOR3_NEON
+#endif
+
 #include "Vector2.h"
 
+// Array functions treat vectors as tightly packed floats.
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be three tightly packed floats");
+
 Vector3 Vector3::Zero(0.0f, 0.0f, 0.0f);
 Vector3 Vector3::One(1.0f, 1.0f, 1.0f);
 Vector3 Vector3::UnitX(1.0f, 0.0f, 0.0f);
@@ -165,6 +176,42 @@ Vector3& Vector3::Normalize()
     return ((1.0f - t) * from) + (t * to);
 }
 
+/*static*/ void Vector3::Lerp(const Vector3* from, const Vector3* to, float t, Vector3* out, size_t count)
+{
+    // Vector components don't matter for a lerp, so just treat the arrays as big arrays of floats.
+    const float* fromFloats = &from->x;
+    const float* toFloats = &to->x;
+    float* outFloats = &out->x;
+    size_t floatCount = count * 3;
+
+    // Same formula as single vector lerp, so the results match exactly.
+    float fromWeight = 1.0f - t;
+    size_t i = 0;
+    #if defined(VECTOR3_SSE)
+    __m128 fromWeights = _mm_set1_ps(fromWeight);
+    __m128 toWeights = _mm_set1_ps(t);
+    for(; i + 4 <= floatCount; i += 4)
+    {
+        __m128 fromValues = _mm_mul_ps(_mm_loadu_ps(fromFloats + i), fromWeights);
+        __m128 toValues = _mm_mul_ps(_mm_loadu_ps(toFloats + i), toWeights);
+        _mm_storeu_ps(outFloats + i, _mm_add_ps(fromValues, toValues));
+    }
+    #elif defined(VECTOR3_NEON)
+    for(; i + 4 <= floatCount; i += 4)
+    {
+        float32x4_t fromValues = vmulq_n_f32(vld1q_f32(fromFloats + i), fromWeight);
+        float32x4_t toValues = vmulq_n_f32(vld1q_f32(toFloats + i), t);
+        vst1q_f32(outFloats + i, vaddq_f32(fromValues, toValues));
+    }
+    #endif
+
+    // Any remaining floats (or all of them, without SIMD support).
+    for(; i < floatCount; ++i)
+    {
+        outFloats[i] = (fromWeight * fromFloats[i]) + (t * toFloats[i]);
+    }
+}
+
 /*static*/ Vector3 Vector3::Project(const Vector3& a, const Vector3& b)
 {
     // Calculates projection of vector a onto vector b. Requires that b is unit length.
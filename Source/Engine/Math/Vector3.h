@@ -68,6 +68,9 @@ public:
     // Interpolation
     static Vector3 Lerp(const Vector3& from, const Vector3& to, float t);
 
+    // Interpolates whole arrays of vectors at once (using SIMD where available). Output may be the same array as either input.
+    static void Lerp(const Vector3* from, const Vector3* to, float t, Vector3* out, size_t count);
+
     // Projection and rejection
     static Vector3 Project(const Vector3& a, const Vector3& b);
     static Vector3 Reject(const Vector3& a, const Vector3& b);
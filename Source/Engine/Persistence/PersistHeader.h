@@ -20,7 +20,8 @@ struct SaveHeader
     char saveId[4] = { 'S', 'A', 'V', 'E' };
 
     // Save file version.
-    int32_t saveVersion = 4;
+    // Version 5 stores topic and noun/verb counts with separate actor/noun/verb names.
+    int32_t saveVersion = 5;
 
     // Size of this header (after this point); always 232.
     int32_t saveHeaderSize = 232;
@@ -5,6 +5,8 @@
 
 #include "Circle.h"
 #include "LineSegment.h"
+#include "Matrix4.h"
+#include "Quaternion.h"
 #include "Rect.h"
 #include "UIGrids.h"
 #include "UIHexagrams.h"
@@ -464,6 +464,36 @@ uint64_t File::Size(const std::string& filePath)
     return 0;
 }
 
+uint64_t File::LastWriteTime(const std::string& filePath)
+{
+    #if defined(PLATFORM_WINDOWS)
+    {
+        WIN32_FILE_ATTRIBUTE_DATA file_attr_data;
+        if(GetFileAttributesEx(filePath.c_str(), GetFileExInfoStandard, &file_attr_data))
+        {
+            ULARGE_INTEGER writeTime = { { 0 } };
+            writeTime.LowPart = file_attr_data.ftLastWriteTime.dwLowDateTime;
+            writeTime.HighPart = file_attr_data.ftLastWriteTime.dwHighDateTime;
+            return writeTime.QuadPart;
+        }
+    }
+    #elif defined(HAVE_STAT_H)
+    {
+        struct stat stat_buf { };
+        int rc = stat(filePath.c_str(), &stat_buf);
+        if(rc == 0)
+        {
+            return static_cast<uint64_t>(stat_buf.st_mtime);
+        }
+    }
+    #else
+        #error "No implementation for File::LastWriteTime!"
+    #endif
+
+    // Failed to get time, so just return 0.
+    return 0;
+}
+
 uint8_t* File::ReadIntoBuffer(const std::string& filePath, uint32_t& outBufferSize)
 {
     // Open the file, or error if failed.
@@ -137,6 +137,12 @@ namespace File
      */
     uint64_t Size(const std::string& filePath);
 
+    /**
+     * Returns an opaque value representing when the file was last modified, or 0 on failure.
+     * Only useful for comparing against other values returned by this function (e.g. to detect a file has changed).
+     */
+    uint64_t LastWriteTime(const std::string& filePath);
+
     /**
      * Reads file contents into a buffer.
      */
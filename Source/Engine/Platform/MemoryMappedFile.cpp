@@ -0,0 +1,131 @@
+#include "MemoryMappedFile.h"
+
+#include <cstdio>
+
+#if defined(PLATFORM_WINDOWS)
+#include <Windows.h>
+#elif defined(HAVE_UNISTD_H)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    Close();
+}
+
+bool MemoryMappedFile::Open(const std::string& filePath)
+{
+    // If something is already mapped, get rid of it.
+    Close();
+
+    #if defined(PLATFORM_WINDOWS)
+    {
+        HANDLE fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if(fileHandle == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        // Get the file size. An empty file can't be mapped.
+        LARGE_INTEGER fileSize = { { 0 } };
+        if(!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        // Create a read-only mapping, then map a read-only view of the whole file.
+        HANDLE mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if(mappingHandle == NULL)
+        {
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if(view == NULL)
+        {
+            printf("Failed to map view of file %s (error %lu).\n", filePath.c_str(), GetLastError());
+            CloseHandle(mappingHandle);
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        mFileHandle = fileHandle;
+        mMappingHandle = mappingHandle;
+        mData = static_cast<uint8_t*>(view);
+        mSize = static_cast<uint64_t>(fileSize.QuadPart);
+        return true;
+    }
+    #elif defined(HAVE_UNISTD_H)
+    {
+        int fd = open(filePath.c_str(), O_RDONLY);
+        if(fd < 0)
+        {
+            return false;
+        }
+
+        // Get the file size. An empty file can't be mapped.
+        struct stat statBuf { };
+        if(fstat(fd, &statBuf) != 0 || statBuf.st_size <= 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        // Map the whole file read-only.
+        void* view = mmap(nullptr, static_cast<size_t>(statBuf.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // Once mapped, the file descriptor is no longer needed - the mapping keeps its own reference to the file.
+        close(fd);
+        if(view == MAP_FAILED)
+        {
+            printf("Failed to memory map file %s.\n", filePath.c_str());
+            return false;
+        }
+
+        mData = static_cast<uint8_t*>(view);
+        mSize = static_cast<uint64_t>(statBuf.st_size);
+        return true;
+    }
+    #else
+    {
+        // No memory mapping support on this platform - callers must fall back on ordinary file reads.
+        return false;
+    }
+    #endif
+}
+
+void MemoryMappedFile::Close()
+{
+    #if defined(PLATFORM_WINDOWS)
+    {
+        if(mData != nullptr)
+        {
+            UnmapViewOfFile(mData);
+        }
+        if(mMappingHandle != nullptr)
+        {
+            CloseHandle(mMappingHandle);
+            mMappingHandle = nullptr;
+        }
+        if(mFileHandle != nullptr)
+        {
+            CloseHandle(mFileHandle);
+            mFileHandle = nullptr;
+        }
+    }
+    #elif defined(HAVE_UNISTD_H)
+    {
+        if(mData != nullptr)
+        {
+            munmap(mData, static_cast<size_t>(mSize));
+        }
+    }
+    #endif
+    mData = nullptr;
+    mSize = 0;
+}
\ No newline at end of file
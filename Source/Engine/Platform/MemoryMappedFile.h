@@ -0,0 +1,44 @@
+//
+// Clark Kromenaker
+//
+// Maps a file on disk into the process's address space for read access.
+//
+// Once mapped, the file's contents can be read directly from memory - no seeking, no stream state, and no locking.
+// This makes it safe for many threads to read from the same file at the same time.
+//
+// The mapping is copy-on-write, so a stray write to mapped memory only modifies a private copy of that page (never the file).
+//
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "Platform.h"
+
+class MemoryMappedFile
+{
+public:
+    MemoryMappedFile() = default;
+    ~MemoryMappedFile();
+
+    // Not copyable - the mapping is owned by this object.
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    bool Open(const std::string& filePath);
+    void Close();
+
+    bool IsOpen() const { return mData != nullptr; }
+    const uint8_t* GetData() const { return mData; }
+    uint64_t GetSize() const { return mSize; }
+
+private:
+    // Pointer to the start of the mapped file, and the size of the mapping.
+    uint8_t* mData = nullptr;
+    uint64_t mSize = 0;
+
+    #if defined(PLATFORM_WINDOWS)
+    // On Windows, the file and mapping handles must stay open while the view is mapped.
+    void* mFileHandle = nullptr;
+    void* mMappingHandle = nullptr;
+    #endif
+};
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "AABB.h"
 
+#include "Matrix4.h"
+
 /*static*/ AABB AABB::FromMinMax(const Vector3& min, const Vector3& max)
 {
     return AABB(min, max);
@@ -27,6 +29,22 @@
     return FromCenterAndExtents(center, size * 0.5f);
 }
 
+/*static*/ AABB AABB::FromTransformedAABB(const AABB& aabb, const Matrix4& matrix)
+{
+    // Rather than transforming all 8 corners, transform the center, and then calculate how far the rotated/scaled extents reach along each axis.
+    // Each world axis extent is the sum of the absolute contributions from each local axis extent (Arvo's method).
+    Vector3 center = matrix.TransformPoint(aabb.GetCenter());
+    Vector3 extents = aabb.GetExtents();
+    Vector3 worldExtents;
+    for(int row = 0; row < 3; ++row)
+    {
+        worldExtents[row] = Math::Abs(matrix(row, 0)) * extents.x +
+                            Math::Abs(matrix(row, 1)) * extents.y +
+                            Math::Abs(matrix(row, 2)) * extents.z;
+    }
+    return FromCenterAndExtents(center, worldExtents);
+}
+
 AABB::AABB(const Vector3& min, const Vector3& max) :
     mMin(min),
     mMax(max)
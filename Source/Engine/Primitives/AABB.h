@@ -7,6 +7,8 @@
 #pragma once
 #include "Vector3.h"
 
+class Matrix4;
+
 class AABB
 {
 public:
@@ -15,6 +17,10 @@ public:
     static AABB FromCenterAndExtents(const Vector3& center, const Vector3& extents);
     static AABB FromCenterAndSize(const Vector3& center, const Vector3& size);
 
+    // Creates an AABB that contains another AABB after it has been transformed (e.g. from local to world space).
+    // If the transform includes a rotation, the result is larger than the original box, since it must stay axis-aligned.
+    static AABB FromTransformedAABB(const AABB& aabb, const Matrix4& matrix);
+
     AABB() = default;
     AABB(const Vector3& min, const Vector3& max);
 
@@ -0,0 +1,124 @@
+#include "BVH.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "GMath.h"
+
+namespace
+{
+    // Leaves hold up to this many items. Any more, and the node is split.
+    const uint32_t kMaxLeafItems = 4;
+}
+
+void BVH::Build(const std::vector<AABB>& itemBounds)
+{
+    Clear();
+    if(itemBounds.empty()) { return; }
+
+    // Items are split by their centers.
+    std::vector<Vector3> itemCenters;
+    itemCenters.reserve(itemBounds.size());
+    mItemIndexes.reserve(itemBounds.size());
+    for(uint32_t i = 0; i < itemBounds.size(); ++i)
+    {
+        itemCenters.push_back(itemBounds[i].GetCenter());
+        mItemIndexes.push_back(i);
+    }
+
+    // A binary tree with leaves of at least one item has fewer than 2N nodes.
+    mNodes.reserve(itemBounds.size() * 2);
+    mNodes.emplace_back();
+    BuildNode(0, 0, static_cast<uint32_t>(itemBounds.size()), itemBounds, itemCenters, 0);
+}
+
+void BVH::Clear()
+{
+    mNodes.clear();
+    mItemIndexes.clear();
+}
+
+/*static*/ bool BVH::TestRayBounds(const RayInfo& ray, const Vector3& min, const Vector3& max, float maxT)
+{
+    // Standard "slab" test: calculate the t-values where the ray enters/exits the box on each axis.
+    // The ray hits the box if it's inside all three slabs at once.
+    float tMin = -FLT_MAX;
+    float tMax = FLT_MAX;
+    for(int i = 0; i < 3; ++i)
+    {
+        if(ray.invDirection[i] == 0.0f)
+        {
+            // The ray is parallel to this slab - it's either always inside the slab or never inside it.
+            // This is common (ex: floor checks use straight down rays), and the regular math gives bad results if the ray is exactly on a box face.
+            if(ray.origin[i] < min[i] || ray.origin[i] > max[i])
+            {
+                return false;
+            }
+        }
+        else
+        {
+            float t1 = (min[i] - ray.origin[i]) * ray.invDirection[i];
+            float t2 = (max[i] - ray.origin[i]) * ray.invDirection[i];
+            tMin = Math::Max(tMin, Math::Min(t1, t2));
+            tMax = Math::Min(tMax, Math::Max(t1, t2));
+        }
+    }
+
+    // Hit if the slabs overlap, the box isn't behind the ray, and the box isn't further than the max distance.
+    return tMin <= tMax && tMax >= 0.0f && tMin <= maxT;
+}
+
+BVH::RayInfo::RayInfo(const Ray& ray) :
+    origin(ray.origin)
+{
+    // Zero means the ray is parallel to that axis (see TestRayBounds).
+    for(int i = 0; i < 3; ++i)
+    {
+        invDirection[i] = ray.direction[i] == 0.0f ? 0.0f : 1.0f / ray.direction[i];
+    }
+}
+
+void BVH::BuildNode(uint32_t nodeIndex, uint32_t first, uint32_t count, const std::vector<AABB>& itemBounds, const std::vector<Vector3>& itemCenters, int depth)
+{
+    // Calculate bounds of all items in this node, and bounds of their centers (used to decide how to split).
+    AABB bounds = itemBounds[mItemIndexes[first]];
+    AABB centerBounds(itemCenters[mItemIndexes[first]], itemCenters[mItemIndexes[first]]);
+    for(uint32_t i = first + 1; i < first + count; ++i)
+    {
+        bounds.GrowToContain(itemBounds[mItemIndexes[i]].GetMin());
+        bounds.GrowToContain(itemBounds[mItemIndexes[i]].GetMax());
+        centerBounds.GrowToContain(itemCenters[mItemIndexes[i]]);
+    }
+    mNodes[nodeIndex].min = bounds.GetMin();
+    mNodes[nodeIndex].max = bounds.GetMax();
+
+    // Split along the axis where the item centers are most spread out.
+    Vector3 centerSize = centerBounds.GetSize();
+    int axis = 0;
+    if(centerSize.y > centerSize.x) { axis = 1; }
+    if(centerSize.z > centerSize[axis]) { axis = 2; }
+
+    // Make a leaf if there are few enough items, the items can't be split (all centers in one spot), or the tree is too deep.
+    // Traversal pushes two nodes per level, so leave some room in the traversal stack.
+    if(count <= kMaxLeafItems || centerSize[axis] <= 0.0f || depth >= kMaxDepth / 2 - 1)
+    {
+        mNodes[nodeIndex].firstIndex = first;
+        mNodes[nodeIndex].itemCount = count;
+        return;
+    }
+
+    // Split at the median item on that axis. This always gives a balanced tree.
+    uint32_t half = count / 2;
+    std::nth_element(mItemIndexes.begin() + first, mItemIndexes.begin() + first + half, mItemIndexes.begin() + first + count, [&itemCenters, axis](uint32_t a, uint32_t b){
+        return itemCenters[a][axis] < itemCenters[b][axis];
+    });
+
+    // Create the two children next to each other, then build each one.
+    uint32_t childIndex = static_cast<uint32_t>(mNodes.size());
+    mNodes[nodeIndex].firstIndex = childIndex;
+    mNodes[nodeIndex].itemCount = 0;
+    mNodes.emplace_back();
+    mNodes.emplace_back();
+    BuildNode(childIndex, first, half, itemBounds, itemCenters, depth + 1);
+    BuildNode(childIndex + 1, first + half, count - half, itemBounds, itemCenters, depth + 1);
+}
\ No newline at end of file
@@ -0,0 +1,209 @@
+//
+// Clark Kromenaker
+//
+// A "bounding volume hierarchy" - a tree of AABBs built around a set of items (triangles, polygons, etc).
+// Used to quickly find which items a ray (or a box) might hit, without testing every item.
+//
+// The BVH only knows about item bounds - it's up to the caller to do the actual ray/item test.
+// Items are referred to by their index in the list of bounds passed to Build.
+//
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "AABB.h"
+#include "Ray.h"
+
+class BVH
+{
+public:
+    void Build(const std::vector<AABB>& itemBounds);
+    void Clear();
+
+    bool IsEmpty() const { return mNodes.empty(); }
+
+    // Calls "testItem(itemIndex, inOutNearestT)" for each item whose bounds the ray hits at or before "inOutNearestT".
+    // If the item is hit nearer than the current nearest, the callback should update "inOutNearestT".
+    template<typename TestItemFunc>
+    void Raycast(const Ray& ray, float& inOutNearestT, TestItemFunc testItem) const;
+
+    // Like Raycast, but for many rays at once. Each node is visited once for all rays, which is a lot cheaper than one traversal per ray.
+    // Calls "testItem(itemIndex, rayIndex, inOutNearestT)" for each item/ray pair that may hit.
+    // The rays/nearest t arrays must both have "rayCount" elements.
+    template<typename TestItemFunc>
+    void RaycastPacket(const Ray* rays, float* inOutNearestTs, int rayCount, TestItemFunc testItem) const;
+
+    // Calls "testItem(itemIndex)" for each item whose bounds overlap the given bounds.
+    template<typename TestItemFunc>
+    void Query(const AABB& bounds, TestItemFunc testItem) const;
+
+private:
+    struct Node
+    {
+        Vector3 min;
+
+        // For a leaf node, the index of the first item (in the item indexes list).
+        // For other nodes, the index of the first child node - the second child directly follows it.
+        uint32_t firstIndex = 0;
+
+        Vector3 max;
+
+        // Number of items in a leaf node. Zero means this isn't a leaf node.
+        uint32_t itemCount = 0;
+    };
+    std::vector<Node> mNodes;
+
+    // Item indexes, sorted so that each leaf's items are together in the list.
+    std::vector<uint32_t> mItemIndexes;
+
+    // The tree is built recursively, but should never get this deep. Traversal uses a fixed size stack of this size.
+    static const int kMaxDepth = 64;
+
+    // A ray with some values precalculated for fast bounds checks.
+    // The inverse direction is zero on any axis the ray is parallel to.
+    struct RayInfo
+    {
+        Vector3 origin;
+        Vector3 invDirection;
+        RayInfo(const Ray& ray);
+    };
+    static bool TestRayBounds(const RayInfo& ray, const Vector3& min, const Vector3& max, float maxT);
+
+    void BuildNode(uint32_t nodeIndex, uint32_t first, uint32_t count, const std::vector<AABB>& itemBounds, const std::vector<Vector3>& itemCenters, int depth);
+};
+
+template<typename TestItemFunc>
+void BVH::Raycast(const Ray& ray, float& inOutNearestT, TestItemFunc testItem) const
+{
+    if(mNodes.empty()) { return; }
+    RayInfo rayInfo(ray);
+
+    uint32_t stack[kMaxDepth];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize > 0)
+    {
+        // Skip this node if the ray doesn't hit it (or hits it further away than the nearest hit so far).
+        const Node& node = mNodes[stack[--stackSize]];
+        if(!TestRayBounds(rayInfo, node.min, node.max, inOutNearestT)) { continue; }
+
+        // For a leaf, test the items. Otherwise, visit the children.
+        if(node.itemCount > 0)
+        {
+            for(uint32_t i = node.firstIndex; i < node.firstIndex + node.itemCount; ++i)
+            {
+                testItem(mItemIndexes[i], inOutNearestT);
+            }
+        }
+        else
+        {
+            stack[stackSize++] = node.firstIndex + 1;
+            stack[stackSize++] = node.firstIndex;
+        }
+    }
+}
+
+template<typename TestItemFunc>
+void BVH::Query(const AABB& bounds, TestItemFunc testItem) const
+{
+    if(mNodes.empty()) { return; }
+    Vector3 min = bounds.GetMin();
+    Vector3 max = bounds.GetMax();
+
+    uint32_t stack[kMaxDepth];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize > 0)
+    {
+        // Skip this node if it doesn't overlap the bounds.
+        const Node& node = mNodes[stack[--stackSize]];
+        if(node.max.x < min.x || node.min.x > max.x ||
+           node.max.y < min.y || node.min.y > max.y ||
+           node.max.z < min.z || node.min.z > max.z)
+        {
+            continue;
+        }
+
+        // For a leaf, report the items. Otherwise, visit the children.
+        if(node.itemCount > 0)
+        {
+            for(uint32_t i = node.firstIndex; i < node.firstIndex + node.itemCount; ++i)
+            {
+                testItem(mItemIndexes[i]);
+            }
+        }
+        else
+        {
+            stack[stackSize++] = node.firstIndex + 1;
+            stack[stackSize++] = node.firstIndex;
+        }
+    }
+}
+
+template<typename TestItemFunc>
+void BVH::RaycastPacket(const Ray* rays, float* inOutNearestTs, int rayCount, TestItemFunc testItem) const
+{
+    if(mNodes.empty()) { return; }
+
+    // Rays are traversed in groups of 64, so a bitmask can track which rays are still "active" at each node.
+    std::vector<RayInfo> rayInfos;
+    rayInfos.reserve(rayCount);
+    for(int i = 0; i < rayCount; ++i)
+    {
+        rayInfos.emplace_back(rays[i]);
+    }
+    for(int packetStart = 0; packetStart < rayCount; packetStart += 64)
+    {
+        int packetSize = rayCount - packetStart < 64 ? rayCount - packetStart : 64;
+        uint64_t allRaysMask = packetSize == 64 ? UINT64_MAX : ((1ULL << packetSize) - 1);
+
+        uint32_t stack[kMaxDepth];
+        uint64_t stackMasks[kMaxDepth];
+        int stackSize = 0;
+        stack[stackSize] = 0;
+        stackMasks[stackSize] = allRaysMask;
+        ++stackSize;
+        while(stackSize > 0)
+        {
+            --stackSize;
+            const Node& node = mNodes[stack[stackSize]];
+
+            // Figure out which of the incoming rays hit this node.
+            uint64_t incomingMask = stackMasks[stackSize];
+            uint64_t mask = 0;
+            for(int i = 0; i < packetSize; ++i)
+            {
+                uint64_t rayBit = 1ULL << i;
+                if((incomingMask & rayBit) != 0 && TestRayBounds(rayInfos[packetStart + i], node.min, node.max, inOutNearestTs[packetStart + i]))
+                {
+                    mask |= rayBit;
+                }
+            }
+            if(mask == 0) { continue; }
+
+            // For a leaf, test the items against each ray that hit the node. Otherwise, visit the children.
+            if(node.itemCount > 0)
+            {
+                for(uint32_t i = node.firstIndex; i < node.firstIndex + node.itemCount; ++i)
+                {
+                    for(int j = 0; j < packetSize; ++j)
+                    {
+                        if((mask & (1ULL << j)) != 0)
+                        {
+                            testItem(mItemIndexes[i], packetStart + j, inOutNearestTs[packetStart + j]);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                stack[stackSize] = node.firstIndex + 1;
+                stackMasks[stackSize] = mask;
+                ++stackSize;
+                stack[stackSize] = node.firstIndex;
+                stackMasks[stackSize] = mask;
+                ++stackSize;
+            }
+        }
+    }
+}
\ No newline at end of file
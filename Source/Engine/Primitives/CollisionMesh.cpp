@@ -0,0 +1,76 @@
+#include "CollisionMesh.h"
+
+#include "Plane.h"
+#include "Sphere.h"
+
+void CollisionMesh::Clear()
+{
+    mTriangles.clear();
+    mNormalX.clear();
+    mNormalY.clear();
+    mNormalZ.clear();
+    mDistance.clear();
+    mBVH.Clear();
+}
+
+void CollisionMesh::AddTriangle(const Vector3& p0, const Vector3& p1, const Vector3& p2)
+{
+    mTriangles.emplace_back(p0, p1, p2);
+
+    // Calculate the plane the same way SphereTriangle does, so batch rejection agrees with the full test.
+    Plane plane(mTriangles.back().GetNormal(), p0);
+    mNormalX.push_back(plane.normal.x);
+    mNormalY.push_back(plane.normal.y);
+    mNormalZ.push_back(plane.normal.z);
+    mDistance.push_back(plane.distance);
+}
+
+void CollisionMesh::Build()
+{
+    std::vector<AABB> triangleBounds;
+    triangleBounds.reserve(mTriangles.size());
+    for(const Triangle& triangle : mTriangles)
+    {
+        AABB bounds(triangle.p0, triangle.p0);
+        bounds.GrowToContain(triangle.p1);
+        bounds.GrowToContain(triangle.p2);
+        triangleBounds.push_back(bounds);
+    }
+    mBVH.Build(triangleBounds);
+}
+
+int CollisionMesh::SphereCast(const Sphere& sphere, const Vector3& sphereMoveOffset, float& inOutSphereT, Vector3& outCollisionNormal) const
+{
+    // Only triangles that overlap the area the sphere sweeps through this move can be hit.
+    Vector3 radius(sphere.radius, sphere.radius, sphere.radius);
+    AABB sweepBounds = AABB::FromPoints(sphere.center, sphere.center + sphereMoveOffset);
+    sweepBounds.GrowToContain(sweepBounds.GetMin() - radius);
+    sweepBounds.GrowToContain(sweepBounds.GetMax() + radius);
+
+    // Gather those triangles into contiguous arrays.
+    mCandidateTriangles.clear();
+    mCandidateNormalX.clear();
+    mCandidateNormalY.clear();
+    mCandidateNormalZ.clear();
+    mCandidateDistance.clear();
+    mCandidateIndexes.clear();
+    mBVH.Query(sweepBounds, [this](uint32_t index){
+        mCandidateTriangles.push_back(mTriangles[index]);
+        mCandidateNormalX.push_back(mNormalX[index]);
+        mCandidateNormalY.push_back(mNormalY[index]);
+        mCandidateNormalZ.push_back(mNormalZ[index]);
+        mCandidateDistance.push_back(mDistance[index]);
+        mCandidateIndexes.push_back(index);
+    });
+    if(mCandidateTriangles.empty()) { return -1; }
+
+    // Test them all in one batch.
+    Collide::TrianglePlanes planes;
+    planes.normalX = mCandidateNormalX.data();
+    planes.normalY = mCandidateNormalY.data();
+    planes.normalZ = mCandidateNormalZ.data();
+    planes.distance = mCandidateDistance.data();
+    int candidateIndex = Collide::SphereTriangles(sphere, mCandidateTriangles.data(), planes, static_cast<int>(mCandidateTriangles.size()),
+                                                  sphereMoveOffset, inOutSphereT, outCollisionNormal);
+    return candidateIndex >= 0 ? static_cast<int>(mCandidateIndexes[candidateIndex]) : -1;
+}
\ No newline at end of file
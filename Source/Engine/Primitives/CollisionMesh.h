@@ -0,0 +1,57 @@
+//
+// Clark Kromenaker
+//
+// A static set of triangles to collide against (e.g. the camera bounds of a scene).
+//
+// Triangles are stored in world space, so nothing needs to be transformed when testing collisions.
+// A BVH is built around the triangles, so a moving object only tests the triangles near its path.
+// Triangle planes are also stored as "structure of arrays", so nearby triangles can be rejected in batches.
+//
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "BVH.h"
+#include "Collisions.h"
+#include "Triangle.h"
+
+class Sphere;
+
+class CollisionMesh
+{
+public:
+    void Clear();
+
+    // Adds a triangle. After adding triangles, Build must be called before testing collisions.
+    void AddTriangle(const Vector3& p0, const Vector3& p1, const Vector3& p2);
+    void Build();
+
+    bool IsEmpty() const { return mTriangles.empty(); }
+    uint32_t GetTriangleCount() const { return static_cast<uint32_t>(mTriangles.size()); }
+    const Triangle& GetTriangle(uint32_t index) const { return mTriangles[index]; }
+
+    // Finds the earliest collision of a sphere moving by "sphereMoveOffset" with any triangle (see Collide::SphereTriangles).
+    // Only collisions earlier than "inOutSphereT" count. Returns the index of the triangle collided with, or -1 if no collision.
+    int SphereCast(const Sphere& sphere, const Vector3& sphereMoveOffset, float& inOutSphereT, Vector3& outCollisionNormal) const;
+
+private:
+    std::vector<Triangle> mTriangles;
+
+    // Plane of each triangle, split into one array per component.
+    std::vector<float> mNormalX;
+    std::vector<float> mNormalY;
+    std::vector<float> mNormalZ;
+    std::vector<float> mDistance;
+
+    // Bounding volume hierarchy of the triangles.
+    BVH mBVH;
+
+    // Triangles found near a move are copied here before being tested, so they can be tested in batches.
+    // Reused between casts to avoid allocating every frame.
+    mutable std::vector<Triangle> mCandidateTriangles;
+    mutable std::vector<float> mCandidateNormalX;
+    mutable std::vector<float> mCandidateNormalY;
+    mutable std::vector<float> mCandidateNormalZ;
+    mutable std::vector<float> mCandidateDistance;
+    mutable std::vector<uint32_t> mCandidateIndexes;
+};
\ No newline at end of file
@@ -14,6 +14,14 @@
 #include "Vector2.h"
 #include "Vector3.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define COLLISIONS_SSE
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define COLLISIONS_NEON
+#endif
+
 bool Intersect::TestSphereSphere(const Sphere& s1, const Sphere& s2)
 {
     // Get squared distance between centers of spheres.
@@ -380,6 +388,29 @@ bool Intersect::TestFrustumLineSegment(const Frustum& f, const LineSegment& ls)
     return false;
 }
 
+bool Intersect::TestFrustumAABB(const Frustum& f, const AABB& aabb)
+{
+    // The AABB is outside the frustum if it's entirely behind any one plane.
+    // For each plane, find how far the box extends along the plane normal ("radius"), and compare to the signed distance of the box center.
+    //
+    // Note this test is conservative: a box near a corner of the frustum can be outside of it, yet not fully behind any single plane.
+    // That's fine for culling - the worst case is drawing something that turns out to be offscreen.
+    Vector3 center = aabb.GetCenter();
+    Vector3 extents = aabb.GetExtents();
+    const Plane* planes[6] = { &f.near, &f.far, &f.left, &f.right, &f.bottom, &f.top };
+    for(const Plane* plane : planes)
+    {
+        float radius = extents.x * Math::Abs(plane->normal.x) +
+                       extents.y * Math::Abs(plane->normal.y) +
+                       extents.z * Math::Abs(plane->normal.z);
+        if(plane->GetSignedDistance(center) < -radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool Collide::SphereTriangle(const Sphere& sphere, const Triangle& triangle, const Vector3& sphereMoveOffset, float& outSphereT, Vector3& outCollisionNormal)
 {
     // Adapted (after A LOT of head scratching and experimenting) from flipcode.com/archives/Moving_Sphere_VS_Triangle_Collision.shtml
@@ -621,4 +652,117 @@ bool Collide::SphereTriangle(const Sphere& sphere, const Triangle& triangle, con
 
     // Return whether a collision occurred.
     return collided;
+}
+
+int Collide::SphereTriangles(const Sphere& sphere, const Triangle* triangles, const TrianglePlanes& planes, int count, const Vector3& sphereMoveOffset, float& inOutSphereT, Vector3& outCollisionNormal)
+{
+    // These checks mirror the early outs at the start of SphereTriangle, but run on several triangles at once.
+    // A small tolerance keeps them conservative - a triangle is only rejected here if SphereTriangle would definitely reject it too.
+    const float kTolerance = 0.001f;
+    const float kScaleTolerance = 1.001f;
+
+    // Tests one triangle's plane. Returns false if the sphere can't collide with the triangle this move.
+    auto mayCollide = [&](int i) {
+        float offsetDotNormal = planes.normalX[i] * sphereMoveOffset.x + planes.normalY[i] * sphereMoveOffset.y + planes.normalZ[i] * sphereMoveOffset.z;
+        float signedDistToPlane = planes.normalX[i] * sphere.center.x + planes.normalY[i] * sphere.center.y + planes.normalZ[i] * sphere.center.z + planes.distance[i];
+
+        // Moving away from the triangle, or entirely behind it.
+        if(offsetDotNormal >= kTolerance || signedDistToPlane < -sphere.radius - kTolerance) { return false; }
+
+        // In front of the triangle, but the plane is further away than the sphere moves.
+        return !(signedDistToPlane >= kTolerance && signedDistToPlane - sphere.radius > -offsetDotNormal * kScaleTolerance + kTolerance);
+    };
+
+    // Does the full test on one triangle, keeping it if it's the earliest collision so far.
+    int collideIndex = -1;
+    auto testTriangle = [&](int i) {
+        float sphereT = 0.0f;
+        Vector3 normal;
+        if(!SphereTriangle(sphere, triangles[i], sphereMoveOffset, sphereT, normal)) { return; }
+
+        // If a triangle reports a negative-t collision, it means we are already intersecting it.
+        // We better be actively intersecting in this case.
+        Vector3 intersectPoint;
+        if(sphereT < 0.0f && !Intersect::TestSphereTriangle(sphere, triangles[i], intersectPoint)) { return; }
+
+        if(sphereT < inOutSphereT)
+        {
+            inOutSphereT = sphereT;
+            outCollisionNormal = normal;
+            collideIndex = i;
+        }
+    };
+
+    int i = 0;
+    #if defined(COLLISIONS_SSE)
+    const __m128 offsetX = _mm_set1_ps(sphereMoveOffset.x);
+    const __m128 offsetY = _mm_set1_ps(sphereMoveOffset.y);
+    const __m128 offsetZ = _mm_set1_ps(sphereMoveOffset.z);
+    const __m128 centerX = _mm_set1_ps(sphere.center.x);
+    const __m128 centerY = _mm_set1_ps(sphere.center.y);
+    const __m128 centerZ = _mm_set1_ps(sphere.center.z);
+    const __m128 radius = _mm_set1_ps(sphere.radius);
+    const __m128 tolerance = _mm_set1_ps(kTolerance);
+    const __m128 minDist = _mm_set1_ps(-sphere.radius - kTolerance);
+    const __m128 scaleTolerance = _mm_set1_ps(-kScaleTolerance);
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 nx = _mm_loadu_ps(planes.normalX + i);
+        __m128 ny = _mm_loadu_ps(planes.normalY + i);
+        __m128 nz = _mm_loadu_ps(planes.normalZ + i);
+        __m128 offsetDotNormal = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, offsetX), _mm_mul_ps(ny, offsetY)), _mm_mul_ps(nz, offsetZ));
+        __m128 signedDistToPlane = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, centerX), _mm_mul_ps(ny, centerY)), _mm_mul_ps(nz, centerZ)), _mm_loadu_ps(planes.distance + i));
+
+        __m128 reject = _mm_or_ps(_mm_cmpge_ps(offsetDotNormal, tolerance), _mm_cmplt_ps(signedDistToPlane, minDist));
+        __m128 tooFar = _mm_and_ps(_mm_cmpge_ps(signedDistToPlane, tolerance),
+                                   _mm_cmpgt_ps(_mm_sub_ps(signedDistToPlane, radius), _mm_add_ps(_mm_mul_ps(offsetDotNormal, scaleTolerance), tolerance)));
+        int rejectMask = _mm_movemask_ps(_mm_or_ps(reject, tooFar));
+
+        // Most triangles are rejected, so usually this loop body doesn't run at all.
+        for(int j = 0; j < 4; ++j)
+        {
+            if((rejectMask & (1 << j)) == 0)
+            {
+                testTriangle(i + j);
+            }
+        }
+    }
+    #elif defined(COLLISIONS_NEON)
+    const float32x4_t tolerance = vdupq_n_f32(kTolerance);
+    const float32x4_t minDist = vdupq_n_f32(-sphere.radius - kTolerance);
+    const float32x4_t radius = vdupq_n_f32(sphere.radius);
+    for(; i + 4 <= count; i += 4)
+    {
+        float32x4_t nx = vld1q_f32(planes.normalX + i);
+        float32x4_t ny = vld1q_f32(planes.normalY + i);
+        float32x4_t nz = vld1q_f32(planes.normalZ + i);
+        float32x4_t offsetDotNormal = vaddq_f32(vaddq_f32(vmulq_n_f32(nx, sphereMoveOffset.x), vmulq_n_f32(ny, sphereMoveOffset.y)), vmulq_n_f32(nz, sphereMoveOffset.z));
+        float32x4_t signedDistToPlane = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(nx, sphere.center.x), vmulq_n_f32(ny, sphere.center.y)), vmulq_n_f32(nz, sphere.center.z)), vld1q_f32(planes.distance + i));
+
+        uint32x4_t reject = vorrq_u32(vcgeq_f32(offsetDotNormal, tolerance), vcltq_f32(signedDistToPlane, minDist));
+        uint32x4_t tooFar = vandq_u32(vcgeq_f32(signedDistToPlane, tolerance),
+                                      vcgtq_f32(vsubq_f32(signedDistToPlane, radius), vaddq_f32(vmulq_n_f32(offsetDotNormal, -kScaleTolerance), tolerance)));
+        uint32_t rejectLanes[4];
+        vst1q_u32(rejectLanes, vorrq_u32(reject, tooFar));
+
+        // Most triangles are rejected, so usually this loop body doesn't run at all.
+        for(int j = 0; j < 4; ++j)
+        {
+            if(rejectLanes[j] == 0)
+            {
+                testTriangle(i + j);
+            }
+        }
+    }
+    #endif
+
+    // Any remaining triangles (or all of them, without SIMD support).
+    for(; i < count; ++i)
+    {
+        if(mayCollide(i))
+        {
+            testTriangle(i);
+        }
+    }
+    return collideIndex;
 }
\ No newline at end of file
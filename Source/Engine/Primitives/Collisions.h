@@ -77,6 +77,7 @@ namespace Intersect
 
     // Frustum
     bool TestFrustumLineSegment(const Frustum& f, const LineSegment& ls);
+    bool TestFrustumAABB(const Frustum& f, const AABB& aabb);
 }
 
 //
@@ -89,4 +90,20 @@ namespace Intersect
 namespace Collide
 {
     bool SphereTriangle(const Sphere& sphere, const Triangle& triangle, const Vector3& sphereVelocity, float& outSphereT, Vector3& outCollisionNormal);
+
+    // Planes for many triangles, stored as "structure of arrays" (a separate array per component) so they can be tested with SIMD.
+    struct TrianglePlanes
+    {
+        const float* normalX = nullptr;
+        const float* normalY = nullptr;
+        const float* normalZ = nullptr;
+        const float* distance = nullptr;
+    };
+
+    // Batch version of SphereTriangle: finds the earliest collision of a moving sphere with any of the triangles.
+    // Triangles the sphere can't reach (moving away, behind, or too far) are rejected several at a time using their planes; the rest get the full test.
+    //
+    // Only collisions earlier than "inOutSphereT" count. A collision with negative t (sphere already overlapping) only counts if the sphere actually intersects the triangle.
+    // Returns the index of the triangle collided with, or -1 if no collision.
+    int SphereTriangles(const Sphere& sphere, const Triangle* triangles, const TrianglePlanes& planes, int count, const Vector3& sphereVelocity, float& inOutSphereT, Vector3& outCollisionNormal);
 }
\ No newline at end of file
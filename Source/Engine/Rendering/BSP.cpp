@@ -3,6 +3,7 @@
 #include <bitset>
 #include <iostream>
 
+#include "AssetManager.h"
 #include "BinaryReader.h"
 #include "BSPActor.h"
 #include "BSPLightmap.h"
@@ -18,36 +19,64 @@
 #include "Vector2.h"
 #include "Vector3.h"
 
-void BSPSurface::Activate(const Material& material)
+namespace
 {
-    // Activate texture to use for diffuse color.
-    if(texture != nullptr)
-    {
-        texture->Activate(0);
-    }
-    else
+    // Uniform names used for every BSP surface. Kept as strings so looking up cached uniform locations doesn't allocate.
+    const std::string kLightmapMultiplierUniform = "uLightmapMultiplier";
+    const std::string kLightmapScaleOffsetUniform = "uLightmapScaleOffset";
+}
+
+void BSPSurface::Activate(const Material& material, const BSPSurface* prevSurface)
+{
+    // If the previous surface rendered had the same texture, it's still active - no need to activate it again.
+    if(prevSurface == nullptr || prevSurface->texture != texture)
     {
-        Texture::Deactivate(0);
+        // Activate texture to use for diffuse color.
+        if(texture != nullptr)
+        {
+            texture->Activate(0);
+        }
+        else
+        {
+            Texture::Deactivate(0);
+        }
     }
 
     // Activate lightmap texture and multiplier.
-    if((flags & BSPSurface::kIgnoreLightmapFlag) != 0 ||
-       (flags & BSPSurface::kShadowTextureFlag)  != 0)
+    if(IgnoresLightmap())
     {
         // Some surfaces ignore lightmaps.
         // Just use "plain white" and multiplier of 1 to effectively "do nothing" in lightmap calcs.
-        Texture::White.Activate(1);
-        material.GetShader()->SetUniformFloat("uLightmapMultiplier", 1.0f);
+        if(prevSurface == nullptr || !prevSurface->IgnoresLightmap())
+        {
+            Texture::White.Activate(1);
+            Shader* shader = material.GetShader();
+            shader->SetUniformFloat(shader->GetUniformLocation(kLightmapMultiplierUniform), 1.0f);
+        }
+
+        // Lightmap UVs don't matter when sampling plain white.
+        if(prevSurface != nullptr)
+        {
+            return;
+        }
     }
     else
     {
         // This surface DOES use lightmaps, so activate it!
         // GK3 also implements a feature called "2x Lighting" - basically, just double lightmap colors to make the scene look brighter!
-        if(lightmapTexture != nullptr)
+        // Lightmaps are in an atlas, so it's likely the previous surface used the same lightmap texture.
+        if(prevSurface == nullptr || prevSurface->IgnoresLightmap() || prevSurface->lightmapTexture != lightmapTexture)
+        {
+            if(lightmapTexture != nullptr)
+            {
+                lightmapTexture->Activate(1);
+            }
+        }
+        if(prevSurface == nullptr || prevSurface->IgnoresLightmap())
         {
-            lightmapTexture->Activate(1);
+            Shader* shader = material.GetShader();
+            shader->SetUniformFloat(shader->GetUniformLocation(kLightmapMultiplierUniform), 2.0f);
         }
-        material.GetShader()->SetUniformFloat("uLightmapMultiplier", 2.0f);
     }
 
     // Lightmap scale/offsets are used in shaders to calculate proper lightmap UVs.
@@ -55,7 +84,8 @@ void BSPSurface::Activate(const Material& material)
                                   lightmapUvScale.y,
                                   lightmapUvOffset.x,
                                   lightmapUvOffset.y);
-    material.GetShader()->SetUniformVector4("uLightmapScaleOffset", lightmapUvScaleOffset);
+    Shader* shader = material.GetShader();
+    shader->SetUniformVector4(shader->GetUniformLocation(kLightmapScaleOffsetUniform), lightmapUvScaleOffset);
 }
 
 TYPEINFO_INIT(BSP, Asset, GENERATE_TYPE_ID)
@@ -67,6 +97,18 @@ void BSP::Load(AssetData& data)
 {
     ParseFromData(data.bytes.get(), data.length);
 
+    // Build BVH for raycasts.
+    std::vector<AABB> polygonBounds;
+    polygonBounds.reserve(mPolygons.size());
+    for(const BSPPolygon& polygon : mPolygons)
+    {
+        polygonBounds.push_back(GetPolygonBounds(polygon));
+    }
+    mPolygonBVH.Build(polygonBounds);
+
+    // Sort ambient lights into a grid for ambient color queries.
+    mLightGrid.Build(mLights);
+
     // Use lightmap shader for BSP rendering.
     mMaterial.SetShader(ShaderCache::GetShader("LightmapTexture"));
 }
@@ -151,44 +193,47 @@ bool BSP::RaycastNearest(const Ray& ray, RaycastHit& outHitInfo, bool forWalk)
 {
     // Values for tracking closest found hit.
     outHitInfo.t = FLT_MAX;
-    std::string* closest = nullptr;
-
-    // Iterate polygons and check each one for intersection with the ray.
-    // We must iterate ALL polygons (can't stop at first hit) in case a subsequent polygon is nearer to the start of the ray.
-    for(BSPPolygon& polygon : mPolygons)
-    {
-        // Ignore polygons that are part of non-interactive surfaces.
-        BSPSurface& surface = mSurfaces[polygon.surfaceIndex];
-        if(surface.interactive || (forWalk && surface.walkHitTest))
-        {
-            // Do the raycast against the polygon.
-            RaycastHit hitInfo;
-            if(RaycastPolygon(ray, &polygon, hitInfo))
-            {
-                hitInfo.name = mObjectNames[surface.objectIndex];
-                RaycastTool::LogRaycastHit(hitInfo);
-
-                // Is it closer than any other polygon so far? Then it's our nearest hit.
-                if(hitInfo.t < outHitInfo.t)
-                {
-                    // Save closest distance.
-                    outHitInfo.t = hitInfo.t;
+    uint32_t closestPolygonIndex = UINT32_MAX;
 
-                    // Track name of closest object hit.
-                    closest = &mObjectNames[surface.objectIndex];
-                }
-            }
-        }
-    }
+    // Check the ray against all polygons that it might hit.
+    // We can't stop at the first hit, in case a subsequent polygon is nearer to the start of the ray. But the BVH skips polygons further than the nearest hit so far.
+    mPolygonBVH.Raycast(ray, outHitInfo.t, [this, &ray, forWalk, &closestPolygonIndex](uint32_t polygonIndex, float& nearestT){
+        RaycastNearestPolygon(ray, polygonIndex, forWalk, nearestT, closestPolygonIndex);
+    });
 
     // If no closest object was found, no hits occurred. Early out.
-    if(closest == nullptr) { return false; }
+    if(closestPolygonIndex == UINT32_MAX) { return false; }
 
     // Otherwise, fill in out hit info and return.
-    outHitInfo.name = *closest;
+    outHitInfo.name = mObjectNames[mSurfaces[mPolygons[closestPolygonIndex].surfaceIndex].objectIndex];
     return true;
 }
 
+int BSP::RaycastNearest(const std::vector<Ray>& rays, std::vector<RaycastHit>& outHitInfos, bool forWalk)
+{
+    // Same as a single raycast, but all rays go through the BVH together.
+    // Rays that don't hit anything have an empty name and a "t" of FLT_MAX.
+    std::vector<float> nearestTs(rays.size(), FLT_MAX);
+    std::vector<uint32_t> closestPolygonIndexes(rays.size(), UINT32_MAX);
+    mPolygonBVH.RaycastPacket(rays.data(), nearestTs.data(), static_cast<int>(rays.size()), [this, &rays, forWalk, &closestPolygonIndexes](uint32_t polygonIndex, int rayIndex, float& nearestT){
+        RaycastNearestPolygon(rays[rayIndex], polygonIndex, forWalk, nearestT, closestPolygonIndexes[rayIndex]);
+    });
+
+    int hitCount = 0;
+    outHitInfos.clear();
+    outHitInfos.resize(rays.size());
+    for(size_t i = 0; i < rays.size(); ++i)
+    {
+        if(closestPolygonIndexes[i] != UINT32_MAX)
+        {
+            outHitInfos[i].t = nearestTs[i];
+            outHitInfos[i].name = mObjectNames[mSurfaces[mPolygons[closestPolygonIndexes[i]].surfaceIndex].objectIndex];
+            ++hitCount;
+        }
+    }
+    return hitCount;
+}
+
 bool BSP::RaycastPolygon(const Ray& ray, const BSPPolygon* polygon, RaycastHit& outHitInfo)
 {
     // BSP polygons are made up of "triangle fans", so the first vertex is shared by all triangles in the polygon.
@@ -261,6 +306,22 @@ void BSP::SetFloorObjectName(const std::string& floorObjectName)
             surface.walkHitTest = true;
         }
     }
+
+    // Build BVH of floor polygons for floor height checks.
+    mFloorPolygonIndexes.clear();
+    std::vector<AABB> floorPolygonBounds;
+    if(mFloorObjectIndex != UINT32_MAX)
+    {
+        for(uint32_t i = 0; i < mPolygons.size(); ++i)
+        {
+            if(mSurfaces[mPolygons[i].surfaceIndex].objectIndex == mFloorObjectIndex)
+            {
+                mFloorPolygonIndexes.push_back(i);
+                floorPolygonBounds.push_back(GetPolygonBounds(mPolygons[i]));
+            }
+        }
+    }
+    mFloorBVH.Build(floorPolygonBounds);
 }
 
 bool BSP::GetFloorInfo(const Vector3& position, float& outHeight, Texture*& outTexture)
@@ -279,29 +340,29 @@ bool BSP::GetFloorInfo(const Vector3& position, float& outHeight, Texture*& outT
     // Create ray with origin high in the sky and pointing straight down.
     Ray ray(rayOrigin, -Vector3::UnitY);
 
-    // Iterate polygons.
+    // Check floor polygons that the ray might hit.
     float nearestT = FLT_MAX;
-    for(auto& polygon : mPolygons)
-    {
-        // Only consider polygons that are part of the floor object.
-        BSPSurface& surface = mSurfaces[polygon.surfaceIndex];
-        if(surface.objectIndex != mFloorObjectIndex) { continue; }
-
+    uint32_t nearestFloorIndex = UINT32_MAX;
+    mFloorBVH.Raycast(ray, nearestT, [this, &ray, &outHeight, &outTexture, &nearestFloorIndex](uint32_t floorIndex, float& inOutNearestT){
         // See if ray intersects any triangles in this polygon.
+        const BSPPolygon& polygon = mPolygons[mFloorPolygonIndexes[floorIndex]];
         Vector3 p0 = mVertices[mVertexIndices[polygon.vertexIndexOffset]];
         for(int i = 1; i < polygon.vertexIndexCount - 1; i++)
         {
             Vector3 p1 = mVertices[mVertexIndices[polygon.vertexIndexOffset + i]];
             Vector3 p2 = mVertices[mVertexIndices[polygon.vertexIndexOffset + i + 1]];
+
+            // Polygons are visited out of order, so ties go to the earlier polygon - same result as checking each polygon in order.
             float t = 0.0f;
-            if(Intersect::TestRayTriangle(ray, p0, p1, p2, t) && t < nearestT)
+            if(Intersect::TestRayTriangle(ray, p0, p1, p2, t) && (t < inOutNearestT || (t == inOutNearestT && floorIndex < nearestFloorIndex)))
             {
-                nearestT = t;
+                inOutNearestT = t;
+                nearestFloorIndex = floorIndex;
                 outHeight = ray.GetPoint(t).y;
-                outTexture = surface.texture;
+                outTexture = mSurfaces[polygon.surfaceIndex].texture;
             }
         }
-    }
+    });
 
     // Return whether we hit anything.
     return nearestT != FLT_MAX;
@@ -418,22 +479,47 @@ Vector3 BSP::GetPosition(const std::string& objectName) const
 void BSP::ApplyLightmap(const BSPLightmap& lightmap)
 {
     // Apply lightmap textures to each surface.
-    const std::vector<Texture*>& lightmapTextures = lightmap.GetLightmapTextures();
+    // Lightmaps are packed in an atlas, so each surface's lightmap UV scale/offset must be updated to map to its spot in the atlas.
+    //
+    // The shader calculates lightmap UVs as "(uv + offset) * scale". The atlas then maps that to "atlasOffset + lightmapUV * atlasScale".
+    // Combining those: "(uv + offset + atlasOffset / (scale * atlasScale)) * (scale * atlasScale)".
+    const std::vector<TextureAtlas::Entry>& atlasEntries = lightmap.GetAtlas().GetEntries();
     for(size_t i = 0; i < mSurfaces.size(); ++i)
     {
-        mSurfaces[i].lightmapTexture = lightmapTextures[i];
+        BSPSurface& surface = mSurfaces[i];
+        if(i >= atlasEntries.size())
+        {
+            surface.lightmapTexture = nullptr;
+            surface.lightmapUvOffset = surface.fileLightmapUvOffset;
+            surface.lightmapUvScale = surface.fileLightmapUvScale;
+            continue;
+        }
+
+        const TextureAtlas::Entry& entry = atlasEntries[i];
+        surface.lightmapTexture = entry.page;
+        for(int j = 0; j < 2; ++j)
+        {
+            float scale = surface.fileLightmapUvScale[j] * entry.uvScale[j];
+            surface.lightmapUvScale[j] = scale;
+            surface.lightmapUvOffset[j] = surface.fileLightmapUvOffset[j] + (!Math::IsZero(scale) ? entry.uvOffset[j] / scale : 0.0f);
+        }
     }
 
     // Update light colors now that lightmap textures are populated.
+    // Each light's lightmap is read from its spot in the atlas.
     for(auto& light : mLights)
     {
-        if(mSurfaces[light.surfaceIndex].lightmapTexture != nullptr)
+        const TextureAtlas::Entry* entry = light.surfaceIndex < atlasEntries.size() ? &atlasEntries[light.surfaceIndex] : nullptr;
+        if(entry != nullptr && entry->page != nullptr)
         {
-            int width = mSurfaces[light.surfaceIndex].lightmapTexture->GetWidth();
-            int height = mSurfaces[light.surfaceIndex].lightmapTexture->GetHeight();
+            Texture* page = entry->page;
+            int x = static_cast<int>(entry->uvOffset.x * page->GetWidth() + 0.5f);
+            int y = static_cast<int>(entry->uvOffset.y * page->GetHeight() + 0.5f);
+            int width = static_cast<int>(entry->uvScale.x * page->GetWidth() + 0.5f);
+            int height = static_cast<int>(entry->uvScale.y * page->GetHeight() + 0.5f);
 
             // Use a single center point to calculate the color?
-            //light.color = mSurfaces[light.surfaceIndex].lightmapTexture->GetPixelColor(width / 2, height / 2);
+            //light.color = page->GetPixelColor(x + width / 2, y + height / 2);
 
             // Or sum and average all pixels in the lightmap?
             Vector3 sums;
@@ -441,7 +527,7 @@ void BSP::ApplyLightmap(const BSPLightmap& lightmap)
             {
                 for(int j = 0; j < height; ++j)
                 {
-                    Color32 color = mSurfaces[light.surfaceIndex].lightmapTexture->GetPixelColor(i, j);
+                    Color32 color = page->GetPixelColor(x + i, y + j);
                     sums.x += color.r;
                     sums.y += color.g;
                     sums.z += color.b;
@@ -451,13 +537,18 @@ void BSP::ApplyLightmap(const BSPLightmap& lightmap)
             light.color = Color32(static_cast<int>(sums.x), static_cast<int>(sums.y), static_cast<int>(sums.z));
         }
     }
+    ++mAmbientLightVersion;
 }
 
 void BSP::DebugDrawAmbientLights(const Vector3& position)
 {
     // Visualized what BSP ambient lights affect an object at a given position.
-    for(auto& light : mLights)
+    const uint32_t* begin = nullptr;
+    const uint32_t* end = nullptr;
+    if(!mLightGrid.GetLightIndexes(position, begin, end)) { return; }
+    for(const uint32_t* it = begin; it != end; ++it)
     {
+        const BSPAmbientLight& light = mLights[*it];
         float distSq = (position - light.position).GetLengthSq();
         float radiusSq = light.radius * light.radius;
         if(distSq <= radiusSq)
@@ -469,20 +560,7 @@ void BSP::DebugDrawAmbientLights(const Vector3& position)
 
 Color32 BSP::CalculateAmbientLightColor(const Vector3& position)
 {
-    //TODO: Unclear if this logic is right - may need more work.
-    // For each ambient light, see if the position lands inside the light's "sphere of influence."
-    Color32 color = Color32::Black;
-    for(auto& light : mLights)
-    {
-        float distSq = (position - light.position).GetLengthSq();
-        float radiusSq = light.radius * light.radius;
-        if(distSq <= radiusSq)
-        {
-            // If so, this ambient color contributes to the result, based on how close to center of sphere we are.
-            color += Color32::Lerp(light.color, Color32::Black, distSq / radiusSq);
-        }
-    }
-    return color;
+    return mLightGrid.CalculateColor(mLights, position);
 
     /*
     Vector3 sum;
@@ -533,13 +611,16 @@ void BSP::RenderOpaque(const Vector3& cameraPosition, const Vector3& cameraDirec
     // ALTERNATIVE BSP RENDERING
     // Just render every surface lol.
     // Surprisingly more efficient than "correct" BSP rendering, since it's fewer draw calls.
+    // Consecutive surfaces often share textures (lightmaps especially, due to the atlas), so only changed state is activated.
+    const BSPSurface* prevSurface = nullptr;
     for(BSPSurface& surface : mSurfaces)
     {
         if(!surface.visible) { continue; }
         if(surface.IsTranslucent()) { continue; }
 
         // Activate
-        surface.Activate(mMaterial);
+        surface.Activate(mMaterial, prevSurface);
+        prevSurface = &surface;
 
         // Draw
         for(auto& polygon : surface.polygons)
@@ -567,13 +648,16 @@ void BSP::RenderTranslucent()
     }
     mAlphaPolygons = nullptr;
     #else
+    // Translucent surfaces don't use lightmaps, so only the diffuse texture changes between surfaces - and only when it's different from the previous one.
+    const BSPSurface* prevSurface = nullptr;
     for(auto& surface : mSurfaces)
     {
         if(!surface.visible) { continue; }
         if(!surface.IsTranslucent()) { continue; }
 
         // Activate
-        surface.Activate(mMaterial);
+        surface.Activate(mMaterial, prevSurface);
+        prevSurface = &surface;
 
         // Draw
         for(auto& polygon : surface.polygons)
@@ -590,6 +674,43 @@ void BSP::OnPersist(PersistState& ps)
     ps.Xfer(PERSIST_VAR(mSurfaces), true);
 }
 
+AABB BSP::GetPolygonBounds(const BSPPolygon& polygon) const
+{
+    AABB bounds(mVertices[mVertexIndices[polygon.vertexIndexOffset]], mVertices[mVertexIndices[polygon.vertexIndexOffset]]);
+    for(int i = 1; i < polygon.vertexIndexCount; ++i)
+    {
+        bounds.GrowToContain(mVertices[mVertexIndices[polygon.vertexIndexOffset + i]]);
+    }
+
+    // Pad the bounds a bit, so floating-point error in ray/bounds checks never causes a polygon to be skipped.
+    const Vector3 kPadding(0.01f, 0.01f, 0.01f);
+    return AABB(bounds.GetMin() - kPadding, bounds.GetMax() + kPadding);
+}
+
+void BSP::RaycastNearestPolygon(const Ray& ray, uint32_t polygonIndex, bool forWalk, float& inOutNearestT, uint32_t& inOutNearestPolygonIndex)
+{
+    // Ignore polygons that are part of non-interactive surfaces.
+    BSPPolygon& polygon = mPolygons[polygonIndex];
+    BSPSurface& surface = mSurfaces[polygon.surfaceIndex];
+    if(!surface.interactive && !(forWalk && surface.walkHitTest)) { return; }
+
+    // Do the raycast against the polygon.
+    RaycastHit hitInfo;
+    if(RaycastPolygon(ray, &polygon, hitInfo))
+    {
+        hitInfo.name = mObjectNames[surface.objectIndex];
+        RaycastTool::LogRaycastHit(hitInfo);
+
+        // Is it closer than any other polygon so far? Then it's our nearest hit.
+        // Polygons are visited out of order, so ties go to the earlier polygon - same result as checking each polygon in order.
+        if(hitInfo.t < inOutNearestT || (hitInfo.t == inOutNearestT && polygonIndex < inOutNearestPolygonIndex))
+        {
+            inOutNearestT = hitInfo.t;
+            inOutNearestPolygonIndex = polygonIndex;
+        }
+    }
+}
+
 uint32_t BSP::GetObjectIndex(const std::string& objectName) const
 {
     // Even though there could be "size_t" elements in an array, the BSP file format only supports "uint32_t" elements.
@@ -645,16 +766,22 @@ void BSP::ParseFromData(uint8_t* data, uint32_t dataLength)
     std::vector<Texture*> processedShadowTextures;
 
     // Iterate and read surfaces.
+    // A BSP can reference hundreds of textures. Rather than load them one at a time, collect the names and load them all in parallel afterwards.
+    std::vector<std::string> surfaceTextureNames(surfaceCount);
+    AssetLoadBatch surfaceTextureBatch;
     mSurfaces.resize(surfaceCount);
     for(uint32_t i = 0; i < surfaceCount; ++i)
     {
         BSPSurface& surface = mSurfaces[i];
         surface.objectIndex = reader.ReadUInt();
 
-        surface.texture = gRenderer.LoadSceneTexture(reader.ReadString(32), GetScope());
+        reader.ReadString(32, surfaceTextureNames[i]);
+        surfaceTextureBatch.Add<Texture>(surfaceTextureNames[i], GetScope());
 
-        surface.lightmapUvOffset = reader.ReadVector2();
-        surface.lightmapUvScale = reader.ReadVector2();
+        surface.fileLightmapUvOffset = reader.ReadVector2();
+        surface.fileLightmapUvScale = reader.ReadVector2();
+        surface.lightmapUvOffset = surface.fileLightmapUvOffset;
+        surface.lightmapUvScale = surface.fileLightmapUvScale;
 
         reader.ReadFloat(); // Unknown - I had assumed this was a scale earlier, but I'm not sure.
 
@@ -669,6 +796,15 @@ void BSP::ParseFromData(uint8_t* data, uint32_t dataLength)
         */
     }
 
+    // Load all surface textures. Once loaded, getting each surface's texture is just a cache lookup.
+    gAssetManager.LoadAssets(surfaceTextureBatch);
+    mSurfaceTextureHandles.resize(surfaceCount);
+    for(uint32_t i = 0; i < surfaceCount; ++i)
+    {
+        mSurfaceTextureHandles[i] = gRenderer.LoadSceneTextureHandle(surfaceTextureNames[i], GetScope());
+        mSurfaces[i].texture = mSurfaceTextureHandles[i].Get();
+    }
+
     // Iterate and read nodes.
     mNodes.resize(nodeCount);
     for(uint32_t i = 0; i < nodeCount; ++i)
@@ -722,26 +858,15 @@ void BSP::ParseFromData(uint8_t* data, uint32_t dataLength)
         mPlanes.emplace_back(normalX, normalY, normalZ, distance);
     }
 
-    // Iterate and read vertices.
+    // Read vertices, UVs, and vertex indexes. These are tightly packed, so they can be read in bulk.
     mVertices.resize(vertexCount);
-    for(uint32_t i = 0; i < vertexCount; ++i)
-    {
-        mVertices[i] = reader.ReadVector3();
-    }
+    reader.ReadVector3Array(mVertices.data(), vertexCount);
 
-    // Iterate and read UVs.
     mUVs.resize(uvCount);
-    for(uint32_t i = 0; i < uvCount; ++i)
-    {
-        mUVs[i] = reader.ReadVector2();
-    }
+    reader.ReadVector2Array(mUVs.data(), uvCount);
 
-    // Iterate and read vertex indexes.
     mVertexIndices.resize(vertexIndexCount);
-    for(uint32_t i = 0; i < vertexIndexCount; ++i)
-    {
-        mVertexIndices[i] = reader.ReadUShort();
-    }
+    reader.ReadArray(mVertexIndices.data(), vertexIndexCount);
 
     // Iterate and read other indexes.
     // After reviewing all BSP files, these always exactly match the vertex indexes? Why bother?
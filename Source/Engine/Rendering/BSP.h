@@ -10,6 +10,9 @@
 #include <unordered_map>
 #include <vector>
 
+#include "AssetCache.h"
+#include "BSPAmbientLights.h"
+#include "BVH.h"
 #include "Material.h"
 #include "Mesh.h"
 #include "PersistState.h"
@@ -79,13 +82,16 @@ struct BSPSurface
     Texture* texture = nullptr;
 
     // An optional lightmap texture - applied from a lightmap asset.
-    //TODO: this works OK, but it'd be more efficient to use a lightmap atlas instead of many individual textures.
+    // This is a lightmap atlas page, shared with other surfaces.
     Texture* lightmapTexture = nullptr;
 
     // UVs used for the lightmap are often different from the UVs used for diffuse textures.
     // The surface defines offset/scale to apply to each UV to properly render a lightmap on that surface.
+    // The BSP file's values map to the surface's own lightmap. When a lightmap is applied, the offset/scale are recalculated to map to the surface's spot in the atlas.
     Vector2 lightmapUvOffset;
     Vector2 lightmapUvScale;
+    Vector2 fileLightmapUvOffset;
+    Vector2 fileLightmapUvScale;
 
     // Flags defining surface properties.
     uint32_t flags = 0;
@@ -115,13 +121,18 @@ struct BSPSurface
     std::vector<BSPPolygon> polygons;
     #endif
 
-    void Activate(const Material& material);
+    void Activate(const Material& material, const BSPSurface* prevSurface = nullptr);
 
     bool IsTranslucent() const
     {
         return (flags & kShadowTextureFlag) != 0;
     }
 
+    bool IgnoresLightmap() const
+    {
+        return (flags & kIgnoreLightmapFlag) != 0 || (flags & kShadowTextureFlag) != 0;
+    }
+
     void OnPersist(PersistState& ps)
     {
         // Persist any data that might change mid-scene.
@@ -134,21 +145,6 @@ struct BSPSurface
     }
 };
 
-// Represents an amount of ambient light emitted from a BSP surface.
-// As dynamic models navigate the scene, they can query the BSP to calculate an approximate "ambient color" at the current position.
-struct BSPAmbientLight
-{
-    // The surface this ambient light corresponds to.
-    uint32_t surfaceIndex = 0;
-
-    // The position/radius, which defines a "sphere of influence" for the ambient light.
-    Vector3 position;
-    float radius = 1.0f;
-
-    // The color of the ambient light in this sphere, derived/divined from lightmap data.
-    Color32 color;
-};
-
 class BSP : public Asset
 {
     TYPEINFO_SUB(BSP, Asset);
@@ -158,6 +154,7 @@ public:
 
     // Raycasting
     bool RaycastNearest(const Ray& ray, RaycastHit& outHitInfo, bool forWalk = false);
+    int RaycastNearest(const std::vector<Ray>& rays, std::vector<RaycastHit>& outHitInfos, bool forWalk = false);
     bool RaycastPolygon(const Ray& ray, const BSPPolygon* polygon, RaycastHit& outHitInfo);
 
     // Floors
@@ -179,6 +176,7 @@ public:
     void ApplyLightmap(const BSPLightmap& lightmap);
     void DebugDrawAmbientLights(const Vector3& position);
     Color32 CalculateAmbientLightColor(const Vector3& position);
+    uint32_t GetAmbientLightVersion() const { return mAmbientLightVersion; }
 
     // Rendering
     void RenderOpaque(const Vector3& cameraPosition, const Vector3& cameraDirection);
@@ -211,6 +209,9 @@ private:
     // Surfaces are referenced by polygons, define surface properties like texture and lighting.
     std::vector<BSPSurface> mSurfaces;
 
+    // Surfaces refer to textures by pointer. These handles keep the surface textures loaded for as long as this BSP is.
+    std::vector<AssetHandle<Texture>> mSurfaceTextureHandles;
+
     // Each BSP map is logically divided into objects.
     std::vector<std::string> mObjectNames;
 
@@ -231,11 +232,30 @@ private:
     // Kind of like light probes, but way simpler/jankier.
     std::vector<BSPAmbientLight> mLights;
 
+    // Ambient lights are sorted into a grid, so a query only needs to check lights near the position.
+    BSPAmbientLightGrid mLightGrid;
+
+    // Incremented when ambient light colors change, so callers caching ambient colors know to recalculate.
+    uint32_t mAmbientLightVersion = 0;
+
     // Index of the object used for the floor in the BSP.
     uint32_t mFloorObjectIndex = UINT32_MAX;
 
+    // Raycasts happen a lot (mouse hover, walking, floor height checks), so a BVH is used to only test polygons near the ray.
+    // All polygons are in the BVH - visible/interactive/hit test flags are checked per surface during the raycast, so changing them doesn't require a rebuild.
+    BVH mPolygonBVH;
+
+    // Floor height checks only care about floor polygons, so they get their own (much smaller) BVH.
+    // Items in this BVH are indexes into the floor polygon indexes list.
+    BVH mFloorBVH;
+    std::vector<uint32_t> mFloorPolygonIndexes;
+
     uint32_t GetObjectIndex(const std::string& objectName) const;
 
+    AABB GetPolygonBounds(const BSPPolygon& polygon) const;
+
+    void RaycastNearestPolygon(const Ray& ray, uint32_t polygonIndex, bool forWalk, float& inOutNearestT, uint32_t& inOutNearestPolygonIndex);
+
     void ParseFromData(uint8_t* data, uint32_t dataLength);
 
     #if defined(USE_TRUE_BSP_RENDERING)
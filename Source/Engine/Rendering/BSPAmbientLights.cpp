@@ -0,0 +1,110 @@
+#include "BSPAmbientLights.h"
+
+#include "AABB.h"
+#include "GMath.h"
+
+void BSPAmbientLightGrid::Build(const std::vector<BSPAmbientLight>& lights)
+{
+    mCellStarts.clear();
+    mLightIndexes.clear();
+    mSize[0] = mSize[1] = mSize[2] = 0;
+    if(lights.empty()) { return; }
+
+    // The grid covers the bounds of all light spheres.
+    AABB bounds = AABB::FromCenterAndExtents(lights[0].position, Vector3::One * lights[0].radius);
+    float radiusSum = 0.0f;
+    for(const BSPAmbientLight& light : lights)
+    {
+        bounds.GrowToContain(light.position - Vector3::One * light.radius);
+        bounds.GrowToContain(light.position + Vector3::One * light.radius);
+        radiusSum += light.radius;
+    }
+
+    // Cells around the size of an average light work well - but limit how many cells there are on each axis.
+    const int kMaxCellsPerAxis = 32;
+    Vector3 boundsSize = bounds.GetSize();
+    float maxSize = Math::Max(boundsSize.x, Math::Max(boundsSize.y, boundsSize.z));
+    mCellSize = Math::Max(radiusSum / lights.size(), maxSize / kMaxCellsPerAxis);
+    mCellSize = Math::Max(mCellSize, 1.0f);
+    mMin = bounds.GetMin();
+    for(int i = 0; i < 3; ++i)
+    {
+        mSize[i] = Math::Clamp(Math::CeilToInt(boundsSize[i] / mCellSize), 1, kMaxCellsPerAxis);
+    }
+
+    // Figure out which cells each light overlaps.
+    // Lights are added in order, so each cell's lights stay in the same order as the light list.
+    int cellCount = mSize[0] * mSize[1] * mSize[2];
+    std::vector<std::vector<uint32_t>> cellLights(cellCount);
+    for(uint32_t lightIndex = 0; lightIndex < lights.size(); ++lightIndex)
+    {
+        const BSPAmbientLight& light = lights[lightIndex];
+        int minCell[3];
+        int maxCell[3];
+        for(int i = 0; i < 3; ++i)
+        {
+            minCell[i] = Math::Clamp(Math::FloorToInt((light.position[i] - light.radius - mMin[i]) / mCellSize), 0, mSize[i] - 1);
+            maxCell[i] = Math::Clamp(Math::FloorToInt((light.position[i] + light.radius - mMin[i]) / mCellSize), 0, mSize[i] - 1);
+        }
+        for(int z = minCell[2]; z <= maxCell[2]; ++z)
+        {
+            for(int y = minCell[1]; y <= maxCell[1]; ++y)
+            {
+                for(int x = minCell[0]; x <= maxCell[0]; ++x)
+                {
+                    cellLights[(z * mSize[1] + y) * mSize[0] + x].push_back(lightIndex);
+                }
+            }
+        }
+    }
+
+    // Flatten into one list, with an offset for each cell.
+    mCellStarts.reserve(cellCount + 1);
+    for(const std::vector<uint32_t>& cell : cellLights)
+    {
+        mCellStarts.push_back(static_cast<uint32_t>(mLightIndexes.size()));
+        mLightIndexes.insert(mLightIndexes.end(), cell.begin(), cell.end());
+    }
+    mCellStarts.push_back(static_cast<uint32_t>(mLightIndexes.size()));
+}
+
+bool BSPAmbientLightGrid::GetLightIndexes(const Vector3& position, const uint32_t*& outBegin, const uint32_t*& outEnd) const
+{
+    if(mCellStarts.empty()) { return false; }
+
+    // Outside the grid means outside all light spheres.
+    int cell[3];
+    for(int i = 0; i < 3; ++i)
+    {
+        float cellPos = (position[i] - mMin[i]) / mCellSize;
+        if(cellPos < 0.0f || cellPos > static_cast<float>(mSize[i])) { return false; }
+        cell[i] = Math::Min(static_cast<int>(cellPos), mSize[i] - 1);
+    }
+    int cellIndex = (cell[2] * mSize[1] + cell[1]) * mSize[0] + cell[0];
+    outBegin = mLightIndexes.data() + mCellStarts[cellIndex];
+    outEnd = mLightIndexes.data() + mCellStarts[cellIndex + 1];
+    return true;
+}
+
+Color32 BSPAmbientLightGrid::CalculateColor(const std::vector<BSPAmbientLight>& lights, const Vector3& position) const
+{
+    //TODO: Unclear if this logic is right - may need more work.
+    // For each ambient light, see if the position lands inside the light's "sphere of influence."
+    // Only lights in the position's grid cell could possibly contain it.
+    Color32 color = Color32::Black;
+    const uint32_t* begin = nullptr;
+    const uint32_t* end = nullptr;
+    if(!GetLightIndexes(position, begin, end)) { return color; }
+    for(const uint32_t* it = begin; it != end; ++it)
+    {
+        const BSPAmbientLight& light = lights[*it];
+        float distSq = (position - light.position).GetLengthSq();
+        float radiusSq = light.radius * light.radius;
+        if(distSq <= radiusSq)
+        {
+            // If so, this ambient color contributes to the result, based on how close to center of sphere we are.
+            color += Color32::Lerp(light.color, Color32::Black, distSq / radiusSq);
+        }
+    }
+    return color;
+}
@@ -0,0 +1,49 @@
+//
+// Clark Kromenaker
+//
+// Ambient lights emitted from BSP surfaces, and a grid for quickly finding the lights that affect a position.
+//
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Color32.h"
+#include "Vector3.h"
+
+// Represents an amount of ambient light emitted from a BSP surface.
+// As dynamic models navigate the scene, they can query the BSP to calculate an approximate "ambient color" at the current position.
+struct BSPAmbientLight
+{
+    // The surface this ambient light corresponds to.
+    uint32_t surfaceIndex = 0;
+
+    // The position/radius, which defines a "sphere of influence" for the ambient light.
+    Vector3 position;
+    float radius = 1.0f;
+
+    // The color of the ambient light in this sphere, derived/divined from lightmap data.
+    Color32 color;
+};
+
+// Ambient lights sorted into a uniform grid, so a query only needs to check lights whose spheres overlap the position's grid cell.
+// The grid only stores light indexes - the lights themselves (and their colors) can change without rebuilding it, as long as they don't move.
+class BSPAmbientLightGrid
+{
+public:
+    void Build(const std::vector<BSPAmbientLight>& lights);
+
+    // Gets the lights whose spheres could contain a position, as indexes into the lights list (in list order).
+    // Returns false if the position is outside all light spheres.
+    bool GetLightIndexes(const Vector3& position, const uint32_t*& outBegin, const uint32_t*& outEnd) const;
+
+    // Calculates the ambient color at a position. Each light whose sphere contains the position contributes, based on how close to its center the position is.
+    Color32 CalculateColor(const std::vector<BSPAmbientLight>& lights, const Vector3& position) const;
+
+private:
+    // Each cell is an offset into the light indexes list. There's an extra offset at the end, so a cell's lights are [start[i], start[i + 1]).
+    Vector3 mMin;
+    float mCellSize = 1.0f;
+    int mSize[3] = { 0, 0, 0 };
+    std::vector<uint32_t> mCellStarts;
+    std::vector<uint32_t> mLightIndexes;
+};
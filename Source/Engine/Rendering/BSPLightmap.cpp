@@ -8,15 +8,6 @@ TYPEINFO_INIT(BSPLightmap, Asset, GENERATE_TYPE_ID)
 
 }
 
-BSPLightmap::~BSPLightmap()
-{
-    // This class owns the textures created in the constructor, so we must delete them.
-    for(auto& texture : mLightmapTextures)
-    {
-        delete texture;
-    }
-}
-
 void BSPLightmap::Load(AssetData& data)
 {
     BinaryReader reader(data.bytes.get(), data.length);
@@ -34,6 +25,7 @@ void BSPLightmap::Load(AssetData& data)
     unsigned int bitmapCount = reader.ReadUInt();
 
     // Iterate and read in each bitmap in turn.
+    std::vector<Texture*> lightmapTextures;
     for(unsigned int i = 0; i < bitmapCount; i++)
     {
         // The texture will be read in using the same reader object.
@@ -41,14 +33,34 @@ void BSPLightmap::Load(AssetData& data)
         Texture* texture = new Texture(reader);
         texture->SetFilterMode(Texture::FilterMode::Bilinear);
         texture->SetWrapMode(Texture::WrapMode::Clamp);
-        mLightmapTextures.push_back(texture);
+        lightmapTextures.push_back(texture);
     }
 
+    // Pack lightmaps into an atlas, so BSP rendering doesn't need to switch lightmap textures for every surface.
+    mAtlas.Build(lightmapTextures);
+
     /*
     // Write out for debugging...
-    for(int i = 0; i < mLightmapTextures.size(); i++)
+    for(int i = 0; i < mAtlas.GetPages().size(); i++)
     {
-        mLightmapTextures[i]->WriteToFile(GetNameNoExtension() + "_lm_" + std::to_string(i) + ".bmp");
+        mAtlas.GetPages()[i]->WriteToFile(GetNameNoExtension() + "_lm_" + std::to_string(i) + ".bmp");
     }
     */
+
+    // The atlas has copies of all the lightmap pixels, so the individual lightmap textures are no longer needed.
+    for(Texture* texture : lightmapTextures)
+    {
+        delete texture;
+    }
+}
+
+size_t BSPLightmap::CalculateMemorySize(uint32_t loadedDataLength) const
+{
+    // Only the atlas pages are kept after loading.
+    size_t memorySize = 0;
+    for(Texture* page : mAtlas.GetPages())
+    {
+        memorySize += page->CalculateMemorySize(0);
+    }
+    return memorySize;
 }
\ No newline at end of file
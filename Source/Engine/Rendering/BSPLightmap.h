@@ -16,22 +16,22 @@
 #include <string>
 #include <vector>
 
-class Texture;
+#include "TextureAtlas.h"
 
 class BSPLightmap : public Asset
 {
     TYPEINFO_SUB(BSPLightmap, Asset);
 public:
     BSPLightmap(const std::string& name, AssetScope scope) : Asset(name, scope) { }
-    ~BSPLightmap();
 
     void Load(AssetData& data);
+    size_t CalculateMemorySize(uint32_t loadedDataLength) const override;
 
-    const std::vector<Texture*>& GetLightmapTextures() const { return mLightmapTextures; }
+    const TextureAtlas& GetAtlas() const { return mAtlas; }
 
 private:
-    // Textures loaded from the MUL file.
-    // Order is important, and aligns with order of surfaces in BSP file.
-    // Unlike most Textures, this asset owns these Textures, and is responsible for cleanup!
-    std::vector<Texture*> mLightmapTextures;
+    // Textures loaded from the MUL file are small and numerous, so they're packed into an atlas for rendering.
+    // Entry order is important, and aligns with order of surfaces in BSP file.
+    // Only the atlas pages are kept - the loaded textures are deleted once packed.
+    TextureAtlas mAtlas;
 };
\ No newline at end of file
@@ -155,6 +155,12 @@ public:
     virtual void DestroyIndexBuffer(BufferHandle handle) = 0;
     virtual void SetIndexBufferData(BufferHandle handle, uint32_t indexCount, uint16_t* indexData) = 0;
 
+    // Uniform Buffers
+    // A uniform buffer provides the values for a named uniform block. Any shader that declares a block with that name uses the buffer.
+    virtual BufferHandle CreateUniformBuffer(const char* blockName, uint32_t size) = 0;
+    virtual void DestroyUniformBuffer(BufferHandle handle) = 0;
+    virtual void SetUniformBufferData(BufferHandle handle, uint32_t offset, uint32_t size, void* data) = 0;
+
     // Shaders
     struct ShaderParams
     {
@@ -179,6 +185,16 @@ public:
     virtual void SetShaderUniformMatrix4(ShaderHandle handle, const char* name, const Matrix4& mat) = 0;
     virtual void SetShaderUniformColor(ShaderHandle handle, const char* name, const Color32& color) = 0;
 
+    // Looking up a uniform by name can be slow, so it's better to look up the location once and set the uniform by location after that.
+    // A location of -1 means the uniform doesn't exist in the shader. Setting a uniform at location -1 does nothing.
+    virtual int GetShaderUniformLocation(ShaderHandle handle, const char* name) = 0;
+    virtual void SetShaderUniformInt(ShaderHandle handle, int location, int value) = 0;
+    virtual void SetShaderUniformFloat(ShaderHandle handle, int location, float value) = 0;
+    virtual void SetShaderUniformVector3(ShaderHandle handle, int location, const Vector3& value) = 0;
+    virtual void SetShaderUniformVector4(ShaderHandle handle, int location, const Vector4& value) = 0;
+    virtual void SetShaderUniformMatrix4(ShaderHandle handle, int location, const Matrix4& mat) = 0;
+    virtual void SetShaderUniformColor(ShaderHandle handle, int location, const Color32& color) = 0;
+
     // Drawing
     enum class Primitive
     {
@@ -63,6 +63,55 @@ namespace GLState
             activeVertexArrayId = vertexArrayId;
         }
     }
+
+    GLuint activeProgramId = GL_NONE;
+    void UseProgram(GLuint programId)
+    {
+        if(activeProgramId != programId)
+        {
+            glUseProgram(programId);
+            activeProgramId = programId;
+        }
+    }
+
+    // Enable/disable state for various OpenGL capabilities, and a few other fixed function settings.
+    // These start as -1 ("unknown") so that the first set always goes through to OpenGL.
+    int depthWriteEnabled = -1;
+    int depthTestEnabled = -1;
+    int blendEnabled = -1;
+    int blendMode = -1;
+    int cullMode = -1;
+    void SetCapabilityEnabled(GLenum capability, int& state, bool enabled)
+    {
+        if(state != static_cast<int>(enabled))
+        {
+            if(enabled)
+            {
+                glEnable(capability);
+            }
+            else
+            {
+                glDisable(capability);
+            }
+            state = static_cast<int>(enabled);
+        }
+    }
+
+    // Names of uniform blocks that uniform buffers have been created for (or that shaders have used).
+    // The index of a name in this list is the binding point used for that block.
+    std::vector<std::string> uniformBlockNames;
+    GLuint GetUniformBlockBinding(const char* blockName)
+    {
+        for(size_t i = 0; i < uniformBlockNames.size(); ++i)
+        {
+            if(uniformBlockNames[i] == blockName)
+            {
+                return static_cast<GLuint>(i);
+            }
+        }
+        uniformBlockNames.push_back(blockName);
+        return static_cast<GLuint>(uniformBlockNames.size() - 1);
+    }
 }
 
 namespace
@@ -89,6 +138,15 @@ namespace
         uint32_t count = 0;
     };
 
+    struct UniformBuffer
+    {
+        // The UBO (uniform buffer object) holds values for all uniforms in a uniform block.
+        GLuint ubo = GL_NONE;
+
+        // The binding point this buffer is attached to. Shaders are set up to read the block from this binding point.
+        GLuint binding = 0;
+    };
+
     GLenum TextureFormatToOGLFormat(Texture::Format format)
     {
         switch(format)
@@ -275,6 +333,10 @@ void GAPI_OpenGL::Present()
 
 void GAPI_OpenGL::SetPolygonCullMode(CullMode cullMode)
 {
+    // The renderer sets this a lot (often to the same value), so skip it if nothing changed.
+    if(GLState::cullMode == static_cast<int>(cullMode)) { return; }
+    GLState::cullMode = static_cast<int>(cullMode);
+
     switch(cullMode)
     {
     case CullMode::None:
@@ -371,35 +433,28 @@ void GAPI_OpenGL::GetScreenPixels(uint32_t width, uint32_t height, uint8_t* pixe
 
 void GAPI_OpenGL::SetDepthWriteEnabled(bool enabled)
 {
-    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    if(GLState::depthWriteEnabled != static_cast<int>(enabled))
+    {
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+        GLState::depthWriteEnabled = static_cast<int>(enabled);
+    }
 }
 
 void GAPI_OpenGL::SetDepthTestEnabled(bool enabled)
 {
-    if(enabled)
-    {
-        glEnable(GL_DEPTH_TEST);
-    }
-    else
-    {
-        glDisable(GL_DEPTH_TEST);
-    }
+    GLState::SetCapabilityEnabled(GL_DEPTH_TEST, GLState::depthTestEnabled, enabled);
 }
 
 void GAPI_OpenGL::SetBlendEnabled(bool enabled)
 {
-    if(enabled)
-    {
-        glEnable(GL_BLEND);
-    }
-    else
-    {
-        glDisable(GL_BLEND);
-    }
+    GLState::SetCapabilityEnabled(GL_BLEND, GLState::blendEnabled, enabled);
 }
 
 void GAPI_OpenGL::SetBlendMode(BlendMode blendMode)
 {
+    if(GLState::blendMode == static_cast<int>(blendMode)) { return; }
+    GLState::blendMode = static_cast<int>(blendMode);
+
     switch(blendMode)
     {
     case BlendMode::AlphaBlend:
@@ -664,6 +719,44 @@ void GAPI_OpenGL::SetIndexBufferData(BufferHandle handle, uint32_t indexCount, u
     glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexCount * sizeof(GLushort), indexData);
 }
 
+BufferHandle GAPI_OpenGL::CreateUniformBuffer(const char* blockName, uint32_t size)
+{
+    // Generate the buffer id.
+    GLuint uniformBufferId = GL_NONE;
+    glGenBuffers(1, &uniformBufferId);
+
+    // Create the buffer. The contents are expected to change often (e.g. every frame).
+    glBindBuffer(GL_UNIFORM_BUFFER, uniformBufferId);
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+
+    // Attach the buffer to the block's binding point. Shaders with this block read from that binding point (see CreateShader).
+    GLuint binding = GLState::GetUniformBlockBinding(blockName);
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, uniformBufferId);
+
+    // Return handle.
+    UniformBuffer* uniformBuffer = new UniformBuffer();
+    uniformBuffer->ubo = uniformBufferId;
+    uniformBuffer->binding = binding;
+    return uniformBuffer;
+}
+
+void GAPI_OpenGL::DestroyUniformBuffer(BufferHandle handle)
+{
+    // It's valid to destroy a null handle.
+    if(handle != nullptr)
+    {
+        UniformBuffer* uniformBuffer = static_cast<UniformBuffer*>(handle);
+        glDeleteBuffers(1, &uniformBuffer->ubo);
+        delete uniformBuffer;
+    }
+}
+
+void GAPI_OpenGL::SetUniformBufferData(BufferHandle handle, uint32_t offset, uint32_t size, void* data)
+{
+    glBindBuffer(GL_UNIFORM_BUFFER, static_cast<UniformBuffer*>(handle)->ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+}
+
 namespace
 {
     GLuint CompileShader(const char* source, const char* defines, GLuint shaderType)
@@ -782,7 +875,7 @@ ShaderHandle GAPI_OpenGL::CreateShader(const ShaderParams& shaderParams)
     // To do that, we can use reflection on the shader data to see which texture uniforms exist.
     {
         // We must activate the program, since we may modify uniforms below.
-        glUseProgram(program);
+        GLState::UseProgram(program);
 
         // Info obtained about each uniform.
         const GLsizei kMaxUniformNameLength = 32;
@@ -814,6 +907,16 @@ ShaderHandle GAPI_OpenGL::CreateShader(const ShaderParams& shaderParams)
                 ++textureUnitCounter;
             }
         }
+
+        // Similarly, each uniform block must be told which binding point to read its uniform buffer from.
+        GLint uniformBlockCount = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &uniformBlockCount);
+        for(GLint i = 0; i < uniformBlockCount; ++i)
+        {
+            glGetActiveUniformBlockName(program, i, kMaxUniformNameLength, &uniformNameLength, uniformNameBuffer);
+            if(uniformNameLength <= 0) { continue; }
+            glUniformBlockBinding(program, i, GLState::GetUniformBlockBinding(uniformNameBuffer));
+        }
     }
 
     // Finally return the shader handle.
@@ -822,12 +925,18 @@ ShaderHandle GAPI_OpenGL::CreateShader(const ShaderParams& shaderParams)
 
 void GAPI_OpenGL::DestroyShader(ShaderHandle handle)
 {
-    glDeleteProgram(reinterpret_cast<uintptr_t>(handle));
+    // If this program is active, forget about it. Otherwise, a new program that reuses this ID would never be activated.
+    GLuint program = reinterpret_cast<uintptr_t>(handle);
+    if(GLState::activeProgramId == program)
+    {
+        GLState::UseProgram(GL_NONE);
+    }
+    glDeleteProgram(program);
 }
 
 void GAPI_OpenGL::ActivateShader(ShaderHandle handle)
 {
-    glUseProgram(reinterpret_cast<uintptr_t>(handle));
+    GLState::UseProgram(reinterpret_cast<uintptr_t>(handle));
 }
 
 void GAPI_OpenGL::SetShaderUniformInt(ShaderHandle handle, const char* name, int value)
@@ -908,6 +1017,65 @@ void GAPI_OpenGL::SetShaderUniformColor(ShaderHandle handle, const char* name, c
     }
 }
 
+int GAPI_OpenGL::GetShaderUniformLocation(ShaderHandle handle, const char* name)
+{
+    GLuint program = reinterpret_cast<uintptr_t>(handle);
+    if(program != GL_NONE)
+    {
+        return glGetUniformLocation(program, name);
+    }
+    return -1;
+}
+
+void GAPI_OpenGL::SetShaderUniformInt(ShaderHandle, int location, int value)
+{
+    // In OpenGL, uniforms are always set on the active program, so the handle isn't needed when the location is already known.
+    if(location >= 0)
+    {
+        glUniform1i(location, value);
+    }
+}
+
+void GAPI_OpenGL::SetShaderUniformFloat(ShaderHandle, int location, float value)
+{
+    if(location >= 0)
+    {
+        glUniform1f(location, value);
+    }
+}
+
+void GAPI_OpenGL::SetShaderUniformVector3(ShaderHandle, int location, const Vector3& value)
+{
+    if(location >= 0)
+    {
+        glUniform3f(location, value.x, value.y, value.z);
+    }
+}
+
+void GAPI_OpenGL::SetShaderUniformVector4(ShaderHandle, int location, const Vector4& value)
+{
+    if(location >= 0)
+    {
+        glUniform4f(location, value.x, value.y, value.z, value.w);
+    }
+}
+
+void GAPI_OpenGL::SetShaderUniformMatrix4(ShaderHandle, int location, const Matrix4& mat)
+{
+    if(location >= 0)
+    {
+        glUniformMatrix4fv(location, 1, GL_FALSE, mat);
+    }
+}
+
+void GAPI_OpenGL::SetShaderUniformColor(ShaderHandle, int location, const Color32& color)
+{
+    if(location >= 0)
+    {
+        glUniform4f(location, color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f);
+    }
+}
+
 void GAPI_OpenGL::Draw(Primitive primitive, BufferHandle vertexBuffer)
 {
     // Draw all vertices in the vertex buffer.
@@ -53,6 +53,10 @@ public:
     void DestroyIndexBuffer(BufferHandle handle) override;
     void SetIndexBufferData(BufferHandle handle, uint32_t indexCount, uint16_t* indexData) override;
 
+    BufferHandle CreateUniformBuffer(const char* blockName, uint32_t size) override;
+    void DestroyUniformBuffer(BufferHandle handle) override;
+    void SetUniformBufferData(BufferHandle handle, uint32_t offset, uint32_t size, void* data) override;
+
     const char* GetShaderFileExtension() const override { return "glsl"; }
     ShaderHandle CreateShader(const ShaderParams& shaderParams) override;
     void DestroyShader(ShaderHandle handle) override;
@@ -65,6 +69,14 @@ public:
     void SetShaderUniformMatrix4(ShaderHandle handle, const char* name, const Matrix4& mat) override;
     void SetShaderUniformColor(ShaderHandle handle, const char* name, const Color32& color) override;
 
+    int GetShaderUniformLocation(ShaderHandle handle, const char* name) override;
+    void SetShaderUniformInt(ShaderHandle handle, int location, int value) override;
+    void SetShaderUniformFloat(ShaderHandle handle, int location, float value) override;
+    void SetShaderUniformVector3(ShaderHandle handle, int location, const Vector3& value) override;
+    void SetShaderUniformVector4(ShaderHandle handle, int location, const Vector4& value) override;
+    void SetShaderUniformMatrix4(ShaderHandle handle, int location, const Matrix4& mat) override;
+    void SetShaderUniformColor(ShaderHandle handle, int location, const Color32& color) override;
+
     void Draw(Primitive primitive, BufferHandle vertexBuffer) override;
     void Draw(Primitive primitive, BufferHandle vertexBuffer, uint32_t vertexOffset, uint32_t vertexCount) override;
     void Draw(Primitive primitive, BufferHandle vertexBuffer, BufferHandle indexBuffer) override;
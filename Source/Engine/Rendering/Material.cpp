@@ -1,9 +1,29 @@
 #include "Material.h"
 
+#include "GAPI.h"
 #include "Matrix4.h"
 #include "Shader.h"
 #include "Texture.h"
 
+namespace
+{
+    // Built-in uniforms that are the same for everything drawn with the current camera.
+    // These are in a uniform block shared by all shaders, so they're only uploaded when they change, rather than set on each shader for each draw.
+    // This must match the "FrameUniforms" block in the shader source (using std140 layout rules).
+    struct FrameUniforms
+    {
+        Matrix4 viewMatrix;
+        Matrix4 projMatrix;
+        Matrix4 worldToProjMatrix;
+        float alphaTest = 0.0f;
+        float padding[3] = { 0.0f, 0.0f, 0.0f };
+    };
+    static_assert(sizeof(FrameUniforms) == 208, "FrameUniforms doesn't match std140 layout of shader uniform block");
+
+    // Uniform buffer holding the FrameUniforms. Created the first time it's needed.
+    BufferHandle frameUniformBuffer = nullptr;
+}
+
 // This is set to a default shader during Renderer init.
 Shader* Material::sDefaultShader = nullptr;
 
@@ -12,19 +32,38 @@ Matrix4 Material::sCurrentProjMatrix;
 
 float Material::sAlphaTestValue = 0.0f;
 
+bool Material::sFrameUniformsDirty = true;
+
+/*static*/ void Material::Shutdown()
+{
+    if(frameUniformBuffer != nullptr)
+    {
+        GAPI::Get()->DestroyUniformBuffer(frameUniformBuffer);
+        frameUniformBuffer = nullptr;
+    }
+    sFrameUniformsDirty = true;
+}
+
 /*static*/ void Material::SetViewMatrix(const Matrix4& viewMatrix)
 {
     sCurrentViewMatrix = viewMatrix;
+    sFrameUniformsDirty = true;
 }
 
 /*static*/ void Material::SetProjMatrix(const Matrix4& projMatrix)
 {
     sCurrentProjMatrix = projMatrix;
+    sFrameUniformsDirty = true;
 }
 
 /*static*/ void Material::UseAlphaTest(bool use)
 {
-    sAlphaTestValue = use ? 0.1f : 0.0f;
+    float alphaTestValue = use ? 0.1f : 0.0f;
+    if(sAlphaTestValue != alphaTestValue)
+    {
+        sAlphaTestValue = alphaTestValue;
+        sFrameUniformsDirty = true;
+    }
 }
 
 Material::Material() : mShader(sDefaultShader)
@@ -38,29 +77,53 @@ Material::Material(Shader* shader) : mShader(shader)
 }
 
 void Material::Activate(const Matrix4& objectToWorldMatrix)
+{
+    ActivateShader();
+    SetObjectToWorldMatrix(objectToWorldMatrix);
+    ActivateProperties();
+}
+
+void Material::ActivateShader()
 {
     // Must activate shader BEFORE setting uniforms to get correct results.
     // See https://stackoverflow.com/questions/42357380/why-must-i-use-a-shader-program-before-i-can-set-its-uniforms
     mShader->Activate();
 
-    // Set built-in transform matrices.
-    mShader->SetUniformMatrix4("gObjectToWorldMatrix", objectToWorldMatrix);
-    mShader->SetUniformMatrix4("gWorldToObjectMatrix", Matrix4::Inverse(objectToWorldMatrix));
-
-    mShader->SetUniformMatrix4("gViewMatrix", sCurrentViewMatrix);
-    mShader->SetUniformMatrix4("gProjMatrix", sCurrentProjMatrix);
-    mShader->SetUniformMatrix4("gWorldToProjMatrix", sCurrentProjMatrix * sCurrentViewMatrix);
+    // Built-in camera matrices and alpha test value are shared by all shaders - just make sure they're up-to-date.
+    if(sFrameUniformsDirty)
+    {
+        UpdateFrameUniforms();
+    }
+}
 
-    // Set built-in alpha test value.
-    mShader->SetUniformFloat("gAlphaTest", sAlphaTestValue);
+void Material::SetObjectToWorldMatrix(const Matrix4& objectToWorldMatrix)
+{
+    // Set built-in transform matrices.
+    mShader->SetUniformMatrix4(mShader->GetUniformLocation(Shader::BuiltInUniform::ObjectToWorldMatrix), objectToWorldMatrix);
 
-    // Always default to magenta as discard color.
-    mShader->SetUniformColor("gDiscardColor", Color32::Magenta);
+    // Calculating the inverse isn't cheap, and only some shaders use it.
+    if(mShader->HasUniform(Shader::BuiltInUniform::WorldToObjectMatrix))
+    {
+        mShader->SetUniformMatrix4(mShader->GetUniformLocation(Shader::BuiltInUniform::WorldToObjectMatrix), Matrix4::Inverse(objectToWorldMatrix));
+    }
+}
 
+void Material::ActivateProperties(bool bindTextures)
+{
     // Set user-defined color values.
+    int discardColorLocation = mShader->GetUniformLocation(Shader::BuiltInUniform::DiscardColor);
+    bool setDiscardColor = false;
     for(auto& entry : mColors)
     {
-        mShader->SetUniformColor(entry.first.c_str(), entry.second);
+        int location = mShader->GetUniformLocation(entry.first);
+        mShader->SetUniformColor(location, entry.second);
+        setDiscardColor |= (location >= 0 && location == discardColorLocation);
+    }
+
+    // If this material doesn't specify a discard color, always default to magenta.
+    if(!setDiscardColor)
+    {
+        mShader->SetUniformColor(discardColorLocation, Color32::Magenta);
     }
 
     // Set user-defined textures.
@@ -69,8 +132,12 @@ void Material::Activate(const Matrix4& objectToWorldMatrix)
     {
         if(entry.second != nullptr)
         {
-            mShader->SetUniformInt(entry.first.c_str(), textureUnit);
-            entry.second->Activate(textureUnit);
+            // The sampler uniform still needs to be set, even if the texture is already bound to this unit.
+            mShader->SetUniformInt(mShader->GetUniformLocation(entry.first), textureUnit);
+            if(bindTextures)
+            {
+                entry.second->Activate(textureUnit);
+            }
             ++textureUnit;
         }
     }
@@ -78,18 +145,34 @@ void Material::Activate(const Matrix4& objectToWorldMatrix)
     // Set user-defined float values.
     for(auto& entry : mFloats)
     {
-        mShader->SetUniformFloat(entry.first.c_str(), entry.second);
+        mShader->SetUniformFloat(mShader->GetUniformLocation(entry.first), entry.second);
     }
 
     // Set user-defined vector values.
     for(auto& entry : mVectors)
     {
-        mShader->SetUniformVector4(entry.first.c_str(), entry.second);
+        mShader->SetUniformVector4(mShader->GetUniformLocation(entry.first), entry.second);
     }
 
     //TODO: May need to "deactivate" texture units if no texture is defined in material, but a texture sampler exists in the shader.
 }
 
+/*static*/ void Material::UpdateFrameUniforms()
+{
+    if(frameUniformBuffer == nullptr)
+    {
+        frameUniformBuffer = GAPI::Get()->CreateUniformBuffer("FrameUniforms", sizeof(FrameUniforms));
+    }
+
+    FrameUniforms frameUniforms;
+    frameUniforms.viewMatrix = sCurrentViewMatrix;
+    frameUniforms.projMatrix = sCurrentProjMatrix;
+    frameUniforms.worldToProjMatrix = sCurrentProjMatrix * sCurrentViewMatrix;
+    frameUniforms.alphaTest = sAlphaTestValue;
+    GAPI::Get()->SetUniformBufferData(frameUniformBuffer, 0, sizeof(FrameUniforms), &frameUniforms);
+    sFrameUniformsDirty = false;
+}
+
 void Material::SetColor(const std::string& name, const Color32& color)
 {
     mColors[name] = color;
@@ -22,11 +22,23 @@ public:
     static void SetProjMatrix(const Matrix4& projMatrix);
     static void UseAlphaTest(bool use);
 
+    // Frees GPU resources shared by all materials. Must be called before the graphics API shuts down.
+    static void Shutdown();
+
     Material();
     Material(Shader* shader);
 
     void Activate(const Matrix4& objectToWorldMatrix);
 
+    // Activate is equivalent to calling each of these in order.
+    // They can be called separately to skip state that is already set (e.g. when drawing many things with the same shader).
+    void ActivateShader();
+    void SetObjectToWorldMatrix(const Matrix4& objectToWorldMatrix);
+    void ActivateProperties(bool bindTextures = true);
+
+    // True if the other material uses exactly the same textures in the same texture units.
+    bool HasSameTextures(const Material& other) const { return mTextures == other.mTextures; }
+
     void SetShader(Shader* shader) { mShader = shader; }
     Shader* GetShader() const { return mShader; }
 
@@ -53,6 +65,10 @@ private:
     static Matrix4 sCurrentProjMatrix;
     static float sAlphaTestValue;
 
+    // If true, the view/proj/alpha test values have changed since they were last uploaded to the frame uniform buffer.
+    static bool sFrameUniformsDirty;
+    static void UpdateFrameUniforms();
+
     // Shader to use.
     Shader* mShader = nullptr;
 
@@ -4,9 +4,11 @@
 #include "AssetManager.h"
 #include "Collisions.h"
 #include "Debug.h"
+#include "Frustum.h"
 #include "Model.h"
 #include "Ray.h"
 #include "Renderer.h"
+#include "RenderQueue.h"
 #include "Texture.h"
 
 TYPEINFO_INIT(MeshRenderer, Component, 13)
@@ -24,7 +26,7 @@ MeshRenderer::~MeshRenderer()
     gRenderer.RemoveMeshRenderer(this);
 }
 
-void MeshRenderer::Render(bool opaque, bool translucent)
+void MeshRenderer::AddToRenderQueue(RenderQueue& renderQueue, const Vector3& cameraPosition, const Frustum& frustum)
 {
     // Don't render if actor is inactive or component is disabled.
     if(!IsActiveAndEnabled()) { return; }
@@ -37,15 +39,30 @@ void MeshRenderer::Render(bool opaque, bool translucent)
     // If so, any additional submeshes just use the last material.
     int maxMaterialIndex = static_cast<int>(mMaterials.size()) - 1;
 
-    // Iterate meshes and render each in turn.
+    // Iterate meshes and add each visible submesh to the render queue.
     Matrix4 localToWorldMatrix = GetOwner()->GetTransform()->GetLocalToWorldMatrix();
     for(size_t i = 0; i < mMeshes.size(); i++)
     {
         // Mesh vertices are in "mesh space". Create matrix to convert to world space.
         Matrix4 meshToWorldMatrix = localToWorldMatrix * mMeshes[i]->GetMeshToLocalMatrix();
+        const std::vector<Submesh*>& submeshes = mMeshes[i]->GetSubmeshes();
+
+        // Skip meshes that are entirely outside the camera's view.
+        // Meshes created in code (rather than loaded from a model) don't have an AABB, and their bounds are unknown - never cull those.
+        const AABB& meshAABB = mMeshes[i]->GetAABB();
+        bool hasAABB = !(meshAABB.GetMin() == meshAABB.GetMax());
+        bool inView = !hasAABB || Intersect::TestFrustumAABB(frustum, GetWorldAABB(i, meshToWorldMatrix));
+        renderQueue.CountMesh(inView);
+        if(!inView)
+        {
+            submeshIndex += static_cast<int>(submeshes.size());
+            continue;
+        }
+
+        // Used to sort by distance to camera. Squared distance is fine, since it sorts the same.
+        float depth = (meshToWorldMatrix.GetTranslation() - cameraPosition).GetLengthSq();
 
         // Iterate each submesh.
-        const std::vector<Submesh*>& submeshes = mMeshes[i]->GetSubmeshes();
         for(size_t j = 0; j < submeshes.size(); j++)
         {
             // Some meshes can have quite a few submeshes, but it seems wasteful to store visible bits for ALL of them.
@@ -58,45 +75,37 @@ void MeshRenderer::Render(bool opaque, bool translucent)
                 int materialIndex = Math::Min(submeshIndex, maxMaterialIndex);
                 Material& material = mMaterials[materialIndex];
 
-                // If this is translucent, only render if want to render translucent stuff.
-                // Or if this is opaque, only render if want to render opaque.
-                if((opaque && !material.IsTranslucent()) ||
-                   (translucent && material.IsTranslucent()))
+                // Add to the appropriate pass - the renderer will activate the material and render the submesh.
+                RenderQueue::Pass pass = material.IsTranslucent() ? RenderQueue::Pass::Translucent : RenderQueue::Pass::Opaque;
+                renderQueue.Add(pass, material.GetShader(), material.GetDiffuseTexture(), &material, submeshes[j], meshToWorldMatrix, depth);
+
+                // Draw debug axes if desired.
+                if(Debug::RenderSubmeshLocalAxes())
                 {
-                    // Activate material.
-                    material.Activate(meshToWorldMatrix);
-
-                    // Render the submesh!
-                    submeshes[j]->Render();
-
-                    // Draw debug axes if desired.
-                    if(Debug::RenderSubmeshLocalAxes())
-                    {
-                        Debug::DrawAxes(meshToWorldMatrix);
-                    }
-
-                    /*
-                    // Uncomment to visualize normals.
-                    int vcount = submeshes[j]->GetVertexCount();
-                    for(int k = 0; k < vcount; ++k)
-                    {
-                        Matrix4 worldToMeshMatrix = Matrix4::Inverse(meshToWorldMatrix);
-                        Vector3 lightPos = worldToMeshMatrix.TransformPoint(gSceneManager.GetScene()->GetSceneData()->GetGlobalLightPosition());
-                        Vector3 lightDir = Vector3::Normalize(lightPos - submeshes[j]->GetVertexPosition(k));
-                        float dot = Vector3::Dot(submeshes[j]->GetVertexNormal(k), lightDir);
-                        Color32 color(static_cast<int>(dot * 255), 0, 0);
-
-                        Vector3 pos = submeshes[j]->GetVertexPosition(k);
-                        pos = meshToWorldMatrix.TransformPoint(pos);
-
-                        Vector3 normal = submeshes[j]->GetVertexNormal(k);
-                        normal = meshToWorldMatrix.TransformNormal(normal);
-
-                        Debug::DrawLine(pos, pos + normal, color);
-                        //Debug::DrawLine(pos, pos + lightDir, Color32::Yellow);
-                    }
-                    */
+                    Debug::DrawAxes(meshToWorldMatrix);
                 }
+
+                /*
+                // Uncomment to visualize normals.
+                int vcount = submeshes[j]->GetVertexCount();
+                for(int k = 0; k < vcount; ++k)
+                {
+                    Matrix4 worldToMeshMatrix = Matrix4::Inverse(meshToWorldMatrix);
+                    Vector3 lightPos = worldToMeshMatrix.TransformPoint(gSceneManager.GetScene()->GetSceneData()->GetGlobalLightPosition());
+                    Vector3 lightDir = Vector3::Normalize(lightPos - submeshes[j]->GetVertexPosition(k));
+                    float dot = Vector3::Dot(submeshes[j]->GetVertexNormal(k), lightDir);
+                    Color32 color(static_cast<int>(dot * 255), 0, 0);
+
+                    Vector3 pos = submeshes[j]->GetVertexPosition(k);
+                    pos = meshToWorldMatrix.TransformPoint(pos);
+
+                    Vector3 normal = submeshes[j]->GetVertexNormal(k);
+                    normal = meshToWorldMatrix.TransformNormal(normal);
+
+                    Debug::DrawLine(pos, pos + normal, color);
+                    //Debug::DrawLine(pos, pos + lightDir, Color32::Yellow);
+                }
+                */
             }
 
             // Increase submesh index.
@@ -118,6 +127,8 @@ void MeshRenderer::SetModel(Model* model)
     // Clear any existing.
     mMeshes.clear();
     mMaterials.clear();
+    mTextureHandles.clear();
+    mMeshBounds.clear();
 
     // Add each mesh.
     if(model != nullptr)
@@ -138,6 +149,8 @@ void MeshRenderer::SetMesh(Mesh* mesh)
 {
     mMeshes.clear();
     mMaterials.clear();
+    mTextureHandles.clear();
+    mMeshBounds.clear();
     AddMesh(mesh);
 }
 
@@ -151,6 +164,7 @@ void MeshRenderer::AddMesh(Mesh* mesh)
 
     // Add mesh to array.
     mMeshes.push_back(mesh);
+    mMeshBounds.emplace_back();
 
     // Create a material for each submesh.
     const std::vector<Submesh*>& submeshes = mesh->GetSubmeshes();
@@ -163,8 +177,9 @@ void MeshRenderer::AddMesh(Mesh* mesh)
         if(!submesh->GetTextureName().empty())
         {
             // The scope here would depend on whether this MeshRenderer is scene-specific or persists between scenes.
-            Texture* tex = gRenderer.LoadSceneTexture(submesh->GetTextureName(), GetOwner()->IsDestroyOnLoad() ? AssetScope::Scene : AssetScope::Global);
-            m.SetDiffuseTexture(tex);
+            AssetHandle<Texture> tex = gRenderer.LoadSceneTextureHandle(submesh->GetTextureName(), GetOwner()->IsDestroyOnLoad() ? AssetScope::Scene : AssetScope::Global);
+            m.SetDiffuseTexture(tex.Get());
+            mTextureHandles.push_back(std::move(tex));
         }
         else
         {
@@ -332,6 +347,22 @@ void MeshRenderer::DebugDrawAABBs(const Color32& color, const Color32& meshColor
     Debug::DrawAABB(GetAABB(), color);
 }
 
+const AABB& MeshRenderer::GetWorldAABB(size_t meshIndex, const Matrix4& meshToWorldMatrix)
+{
+    // Recalculate if the mesh has moved or its AABB has changed since last time.
+    MeshBounds& bounds = mMeshBounds[meshIndex];
+    const AABB& meshAABB = mMeshes[meshIndex]->GetAABB();
+    if(!bounds.valid || !(bounds.meshToWorldMatrix == meshToWorldMatrix) ||
+       !(bounds.meshAABB.GetMin() == meshAABB.GetMin()) || !(bounds.meshAABB.GetMax() == meshAABB.GetMax()))
+    {
+        bounds.meshToWorldMatrix = meshToWorldMatrix;
+        bounds.meshAABB = meshAABB;
+        bounds.worldAABB = AABB::FromTransformedAABB(meshAABB, meshToWorldMatrix);
+        bounds.valid = true;
+    }
+    return bounds.worldAABB;
+}
+
 int MeshRenderer::GetIndexFromMeshSubmeshIndexes(int meshIndex, int submeshIndex)
 {
     // Some submesh data is stored in a 1-dimensional array (e.g. materials, visibility)
@@ -10,12 +10,15 @@
 #include <vector>
 
 #include "AABB.h"
+#include "AssetCache.h"
 #include "Material.h"
 #include "Mesh.h" // Including MeshRenderer.h usually means you also need Mesh.h
 
+class Frustum;
 class Model;
 class Ray;
 struct RaycastHit;
+class RenderQueue;
 class Texture;
 
 class MeshRenderer : public Component
@@ -25,7 +28,8 @@ public:
     MeshRenderer(Actor* actor);
     ~MeshRenderer();
 
-    void Render(bool opaque = true, bool translucent = true);
+    // Adds visible submeshes to the render queue. Meshes entirely outside the frustum (in world space) are skipped.
+    void AddToRenderQueue(RenderQueue& renderQueue, const Vector3& cameraPosition, const Frustum& frustum);
 
     void SetShader(Shader* shader) { mShader = shader; }
 
@@ -68,10 +72,25 @@ private:
     // If a mesh has multiple submeshes, each submesh *must have* a material!
     std::vector<Material> mMaterials;
 
+    // Materials refer to textures by pointer. These handles keep the textures loaded while this renderer uses them.
+    std::vector<AssetHandle<Texture>> mTextureHandles;
+
     // Visibility toggles for individual submeshes. Since bitsets are false by default, a true value means the submesh is invisible.
     // Would we ever have more than 64 total submeshes? Guess we'll find out! Should take up 8 bytes per MeshRenderer.
     static const int kMaxSubmeshes = 64;
     std::bitset<kMaxSubmeshes> mSubmeshInvisible;
 
+    // World space AABB for each mesh, used for culling.
+    // Only recalculated when the mesh moves or its AABB changes (e.g. from a vertex animation), so static props rarely pay for it.
+    struct MeshBounds
+    {
+        Matrix4 meshToWorldMatrix;
+        AABB meshAABB;
+        AABB worldAABB;
+        bool valid = false;
+    };
+    std::vector<MeshBounds> mMeshBounds;
+
+    const AABB& GetWorldAABB(size_t meshIndex, const Matrix4& meshToWorldMatrix);
     int GetIndexFromMeshSubmeshIndexes(int meshIndex, int submeshIndex);
 };
@@ -338,13 +338,7 @@ void Model::ParseFromData(uint8_t* data, uint32_t dataLength)
             reader.ReadUInt();
 
             // Next we have vertex positions.
-            for(int k = 0; k < vertexCount; k++)
-            {
-                Vector3 vertex = reader.ReadVector3();
-                vertexPositions[k * 3] = vertex.x;
-                vertexPositions[k * 3 + 1] = vertex.y;
-                vertexPositions[k * 3 + 2] = vertex.z;
-            }
+            reader.ReadArray(vertexPositions, vertexCount * 3);
 
             // So here's an incredible HACK!
             // Lighting on humanoid character models looks correct if normals are transformed.
@@ -353,10 +347,9 @@ void Model::ParseFromData(uint8_t* data, uint32_t dataLength)
             bool isActor = GetNameNoExtension().size() == 3;
 
             // Then we have vertex normals.
-            for(int k = 0; k < vertexCount; k++)
+            reader.ReadArray(vertexNormals, vertexCount * 3);
+            if(isActor)
             {
-                Vector3 normal = reader.ReadVector3();
-
                 /*
                  For reasons I don't quite understand, normals seem to be in "local space"
                  (whereas vertex positions are in "mesh space"). Perhaps some optimization in the original game?
@@ -369,36 +362,31 @@ void Model::ParseFromData(uint8_t* data, uint32_t dataLength)
                  and treat the normal as a vector to achieve the desired transformation
                  without expensive inverse calculations.
                 */
-                if(isActor)
+                for(int k = 0; k < vertexCount; k++)
                 {
+                    Vector3 normal(vertexNormals[k * 3], vertexNormals[k * 3 + 1], vertexNormals[k * 3 + 2]);
                     normal = meshToLocalMatrix.TransformVector(normal);
+                    vertexNormals[k * 3] = normal.x;
+                    vertexNormals[k * 3 + 1] = normal.y;
+                    vertexNormals[k * 3 + 2] = normal.z;
                 }
-
-                vertexNormals[k * 3] = normal.x;
-                vertexNormals[k * 3 + 1] = normal.y;
-                vertexNormals[k * 3 + 2] = normal.z;
             }
 
             // Vertex UV coordinates.
-            for(int k = 0; k < vertexCount; k++)
-            {
-                Vector2 uv = reader.ReadVector2();
-                vertexUVs[k * 2] = uv.x;
-                vertexUVs[k * 2 + 1] = uv.y;
-            }
+            reader.ReadArray(vertexUVs, vertexCount * 2);
 
             // Next comes vertex indexes for drawing from an IBO.
             // Common sequence would be (2, 1, 0) or (5, 4, 3), referring to vertex indexes above.
+            // Each face has four values, but every 4th number seems out of place - not sure what they mean.
+            // Seen: 0xF100 (241), 0x0000 (0), 0x0701 (263), 0x7F3F (16255), 0x56B1 (45398),
+            // 0x9B3E (16027), 0x583F (16216), 0xCC0D (3532), 0xCD0D (3533)
+            std::vector<unsigned short> faceData(faceCount * 4);
+            reader.ReadArray(faceData.data(), faceCount * 4);
             for(int k = 0; k < faceCount; k++)
             {
-                vertexIndexes[k * 3] = reader.ReadUShort();
-                vertexIndexes[k * 3 + 1] = reader.ReadUShort();
-                vertexIndexes[k * 3 + 2] = reader.ReadUShort();
-
-                // Every 4th number seems out of place - not sure what they mean.
-                // Seen: 0xF100 (241), 0x0000 (0), 0x0701 (263), 0x7F3F (16255), 0x56B1 (45398),
-                // 0x9B3E (16027), 0x583F (16216), 0xCC0D (3532), 0xCD0D (3533)
-                reader.ReadUShort(); // WHAT IS IT!?
+                vertexIndexes[k * 3] = faceData[k * 4];
+                vertexIndexes[k * 3 + 1] = faceData[k * 4 + 1];
+                vertexIndexes[k * 3 + 2] = faceData[k * 4 + 2];
             }
 
             // Generate mesh.
@@ -0,0 +1,182 @@
+#include "PixelConvert.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PIXELCONVERT_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define PIXELCONVERT_NEON
+#endif
+
+namespace
+{
+    // 565 channels are scaled up to 0-255 with integer math.
+    // These give the same result as "value * 255 / max" (rounded down) for every possible channel value, but fit in 16-bit lanes.
+    inline uint8_t Expand5Bits(uint32_t value) { return static_cast<uint8_t>((value * 1053) >> 7); }
+    inline uint8_t Expand6Bits(uint32_t value) { return static_cast<uint8_t>((value * 259 + 3) >> 6); }
+
+    #if defined(PIXELCONVERT_SSE2)
+    // Stores four 32-bit pixels as 12 bytes, dropping the fourth byte of each pixel.
+    // This writes 16 bytes, so the caller must make sure there are at least 4 bytes of space past the 12 bytes of pixels.
+    void StorePixelsAs24Bit(__m128i pixels, uint8_t* dst)
+    {
+        // Each 64-bit half holds two pixels. Shift the second pixel down over the unused byte of the first.
+        const __m128i firstPixelMask = _mm_set1_epi64x(0x0000000000FFFFFFLL);
+        const __m128i secondPixelMask = _mm_set1_epi64x(0x0000FFFFFF000000LL);
+        __m128i packed = _mm_or_si128(_mm_and_si128(pixels, firstPixelMask),
+                                      _mm_and_si128(_mm_srli_epi64(pixels, 8), secondPixelMask));
+
+        // Each half now has 6 bytes of pixel data. Overlapping stores put them next to each other.
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), packed);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 6), _mm_srli_si128(packed, 8));
+    }
+    #endif
+}
+
+void PixelConvert::RGB565ToRGB(const uint16_t* src, uint8_t* dst, uint32_t pixelCount)
+{
+    uint32_t i = 0;
+    #if defined(PIXELCONVERT_SSE2)
+    // Eight pixels at a time. Stores write a few bytes past the converted pixels, so leave at least one pixel for the scalar loop.
+    const __m128i sixBitMask = _mm_set1_epi16(0x3F);
+    const __m128i fiveBitMask = _mm_set1_epi16(0x1F);
+    for(; i + 8 < pixelCount; i += 8)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i r = _mm_srli_epi16(pixels, 11);
+        __m128i g = _mm_and_si128(_mm_srli_epi16(pixels, 5), sixBitMask);
+        __m128i b = _mm_and_si128(pixels, fiveBitMask);
+
+        r = _mm_srli_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(1053)), 7);
+        g = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(g, _mm_set1_epi16(259)), _mm_set1_epi16(3)), 6);
+        b = _mm_srli_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(1053)), 7);
+
+        // Interleave to r/g/b/0 bytes, four pixels per register.
+        __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+        StorePixelsAs24Bit(_mm_unpacklo_epi16(rg, b), dst + i * 3);
+        StorePixelsAs24Bit(_mm_unpackhi_epi16(rg, b), dst + i * 3 + 12);
+    }
+    #elif defined(PIXELCONVERT_NEON)
+    for(; i + 8 <= pixelCount; i += 8)
+    {
+        uint16x8_t pixels = vld1q_u16(src + i);
+        uint16x8_t r = vshrq_n_u16(pixels, 11);
+        uint16x8_t g = vandq_u16(vshrq_n_u16(pixels, 5), vdupq_n_u16(0x3F));
+        uint16x8_t b = vandq_u16(pixels, vdupq_n_u16(0x1F));
+
+        uint8x8x3_t rgb;
+        rgb.val[0] = vmovn_u16(vshrq_n_u16(vmulq_n_u16(r, 1053), 7));
+        rgb.val[1] = vmovn_u16(vshrq_n_u16(vaddq_u16(vmulq_n_u16(g, 259), vdupq_n_u16(3)), 6));
+        rgb.val[2] = vmovn_u16(vshrq_n_u16(vmulq_n_u16(b, 1053), 7));
+        vst3_u8(dst + i * 3, rgb);
+    }
+    #endif
+
+    // Any remaining pixels (or all of them, without SIMD support).
+    for(; i < pixelCount; ++i)
+    {
+        uint16_t pixel = src[i];
+        dst[i * 3] = Expand5Bits(pixel >> 11);
+        dst[i * 3 + 1] = Expand6Bits((pixel >> 5) & 0x3F);
+        dst[i * 3 + 2] = Expand5Bits(pixel & 0x1F);
+    }
+}
+
+void PixelConvert::PaletteToRGB(const uint8_t* paletteIndexes, const uint8_t* palette, uint8_t* dst, uint32_t pixelCount)
+{
+    // Neither SSE2 nor NEON can look up table entries in parallel.
+    // But copying a whole 4-byte palette color per pixel (and letting the next pixel overwrite the extra byte) is still much cheaper than copying bytes one at a time.
+    if(pixelCount == 0) { return; }
+    uint32_t lastPixel = pixelCount - 1;
+    for(uint32_t i = 0; i < lastPixel; ++i)
+    {
+        memcpy(dst + i * 3, palette + paletteIndexes[i] * 4, 4);
+    }
+
+    // The last pixel has no room for an extra byte.
+    memcpy(dst + lastPixel * 3, palette + paletteIndexes[lastPixel] * 4, 3);
+}
+
+void PixelConvert::ApplyColorKey(uint8_t* pixels, uint32_t pixelCount, uint8_t key0, uint8_t key1, uint8_t key2)
+{
+    uint32_t i = 0;
+    #if defined(PIXELCONVERT_SSE2) || defined(PIXELCONVERT_NEON)
+    // Four pixels at a time, treating each pixel as a 32-bit value (with the first byte lowest, since these platforms are little-endian).
+    const uint32_t key = key0 | (key1 << 8) | (key2 << 16);
+    #endif
+    #if defined(PIXELCONVERT_SSE2)
+    const __m128i colorMask = _mm_set1_epi32(0x00FFFFFF);
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    const __m128i keys = _mm_set1_epi32(static_cast<int>(key));
+    for(; i + 4 <= pixelCount; i += 4)
+    {
+        __m128i* ptr = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i colors = _mm_and_si128(_mm_loadu_si128(ptr), colorMask);
+        __m128i isKey = _mm_cmpeq_epi32(colors, keys);
+        _mm_storeu_si128(ptr, _mm_or_si128(colors, _mm_andnot_si128(isKey, alphaMask)));
+    }
+    #elif defined(PIXELCONVERT_NEON)
+    const uint32x4_t colorMask = vdupq_n_u32(0x00FFFFFF);
+    const uint32x4_t alphaMask = vdupq_n_u32(0xFF000000);
+    const uint32x4_t keys = vdupq_n_u32(key);
+    for(; i + 4 <= pixelCount; i += 4)
+    {
+        uint8_t* ptr = pixels + i * 4;
+        uint32x4_t colors = vandq_u32(vreinterpretq_u32_u8(vld1q_u8(ptr)), colorMask);
+        uint32x4_t isKey = vceqq_u32(colors, keys);
+        vst1q_u8(ptr, vreinterpretq_u8_u32(vorrq_u32(colors, vbicq_u32(alphaMask, isKey))));
+    }
+    #endif
+
+    // Any remaining pixels (or all of them, without SIMD support).
+    for(; i < pixelCount; ++i)
+    {
+        uint8_t* pixel = pixels + i * 4;
+        bool isKey = pixel[0] == key0 && pixel[1] == key1 && pixel[2] == key2;
+        pixel[3] = isKey ? 0 : 255;
+    }
+}
+
+void PixelConvert::ApplyAlpha(const uint8_t* alpha, uint8_t* pixels, uint32_t pixelCount)
+{
+    uint32_t i = 0;
+    #if defined(PIXELCONVERT_SSE2)
+    // Sixteen pixels at a time. Alpha bytes are spread out to the top byte of each 32-bit pixel.
+    const __m128i colorMask = _mm_set1_epi32(0x00FFFFFF);
+    const __m128i zero = _mm_setzero_si128();
+    for(; i + 16 <= pixelCount; i += 16)
+    {
+        __m128i alphas = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alpha + i));
+        __m128i alphasLo = _mm_unpacklo_epi8(zero, alphas);
+        __m128i alphasHi = _mm_unpackhi_epi8(zero, alphas);
+        __m128i pixelAlphas[4] = {
+            _mm_unpacklo_epi16(zero, alphasLo),
+            _mm_unpackhi_epi16(zero, alphasLo),
+            _mm_unpacklo_epi16(zero, alphasHi),
+            _mm_unpackhi_epi16(zero, alphasHi)
+        };
+
+        __m128i* ptr = reinterpret_cast<__m128i*>(pixels + i * 4);
+        for(int j = 0; j < 4; ++j)
+        {
+            __m128i colors = _mm_and_si128(_mm_loadu_si128(ptr + j), colorMask);
+            _mm_storeu_si128(ptr + j, _mm_or_si128(colors, pixelAlphas[j]));
+        }
+    }
+    #elif defined(PIXELCONVERT_NEON)
+    for(; i + 16 <= pixelCount; i += 16)
+    {
+        uint8x16x4_t rgba = vld4q_u8(pixels + i * 4);
+        rgba.val[3] = vld1q_u8(alpha + i);
+        vst4q_u8(pixels + i * 4, rgba);
+    }
+    #endif
+
+    // Any remaining pixels (or all of them, without SIMD support).
+    for(; i < pixelCount; ++i)
+    {
+        pixels[i * 4 + 3] = alpha[i];
+    }
+}
\ No newline at end of file
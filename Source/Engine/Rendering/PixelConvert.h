@@ -0,0 +1,28 @@
+//
+// Clark Kromenaker
+//
+// Bulk pixel conversion functions, used when loading or modifying texture data.
+//
+// These work on whole rows (or whole images) at once, rather than a pixel at a time.
+// Where SSE2 or NEON is available, many pixels are converted per instruction; otherwise, a scalar loop is used.
+// Either way, the results are identical.
+//
+#pragma once
+#include <cstdint>
+
+namespace PixelConvert
+{
+    // Converts 16-bit 565 pixels (red in the high bits) to 24-bit RGB.
+    void RGB565ToRGB(const uint16_t* src, uint8_t* dst, uint32_t pixelCount);
+
+    // Converts 8-bit palette indexes to 24-bit pixels, using a palette with 4 bytes per color.
+    // The first three bytes of each palette color are copied, so the pixels end up in the same order as the palette (usually BGR).
+    void PaletteToRGB(const uint8_t* paletteIndexes, const uint8_t* palette, uint8_t* dst, uint32_t pixelCount);
+
+    // For 32-bit pixels, sets alpha to zero if the first three bytes match the key color, or 255 otherwise.
+    // The key color bytes must be in the same order as the pixels (e.g. b/g/r for BGRA pixels).
+    void ApplyColorKey(uint8_t* pixels, uint32_t pixelCount, uint8_t key0, uint8_t key1, uint8_t key2);
+
+    // For 32-bit pixels, replaces each pixel's alpha with a value from the alpha array.
+    void ApplyAlpha(const uint8_t* alpha, uint8_t* pixels, uint32_t pixelCount);
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // Converts a depth value to an integer that sorts in the same order.
+    // For non-negative floats, the bit pattern already sorts correctly as an integer - and the sign bit is always zero, so it fits in 31 bits.
+    uint64_t DepthToBits(float depth)
+    {
+        if(!(depth > 0.0f)) { return 0; }
+        uint32_t bits = 0;
+        memcpy(&bits, &depth, sizeof(float));
+        return bits & 0x7FFFFFFF;
+    }
+}
+
+void RenderQueue::Clear()
+{
+    mItems.clear();
+    mSortKeys.clear();
+    mIds.clear();
+    mStats = Stats();
+}
+
+void RenderQueue::Add(Pass pass, Shader* shader, Texture* texture, Material* material, Submesh* submesh, const Matrix4& objectToWorldMatrix, float depth)
+{
+    uint64_t shaderId = GetId(shader);
+    uint64_t textureId = GetId(texture);
+    uint64_t depthBits = DepthToBits(depth);
+
+    // Key layout (most significant bits first):
+    // Opaque:      [pass:1][shader:16][texture:16][depth:31]
+    // Translucent: [pass:1][inverted depth:31][shader:16][texture:16]
+    // Opaque items are grouped by state, and front-to-back within a group to reduce overdraw.
+    // Translucent items must be drawn back-to-front to blend correctly, so depth comes first.
+    SortKey sortKey;
+    if(pass == Pass::Opaque)
+    {
+        sortKey.key = (shaderId << 47) | (textureId << 31) | depthBits;
+    }
+    else
+    {
+        sortKey.key = (1ULL << 63) | ((0x7FFFFFFF - depthBits) << 32) | (shaderId << 16) | textureId;
+    }
+    sortKey.itemIndex = static_cast<uint32_t>(mItems.size());
+    mSortKeys.push_back(sortKey);
+
+    mItems.emplace_back();
+    Item& item = mItems.back();
+    item.shader = shader;
+    item.texture = texture;
+    item.material = material;
+    item.submesh = submesh;
+    item.objectToWorldMatrix = objectToWorldMatrix;
+}
+
+void RenderQueue::Sort()
+{
+    std::sort(mSortKeys.begin(), mSortKeys.end());
+}
+
+uint16_t RenderQueue::GetId(const void* ptr)
+{
+    auto it = mIds.find(ptr);
+    if(it != mIds.end())
+    {
+        return it->second;
+    }
+
+    // If we somehow run out of IDs, everything else shares the last one. Sorting is less effective, but still correct.
+    uint16_t id = static_cast<uint16_t>(std::min<size_t>(mIds.size(), UINT16_MAX));
+    mIds[ptr] = id;
+    return id;
+}
\ No newline at end of file
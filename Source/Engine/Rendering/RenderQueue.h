@@ -0,0 +1,146 @@
+//
+// Clark Kromenaker
+//
+// A list of things to draw this frame, sorted to minimize state changes.
+//
+// Rather than each renderer activating its material and drawing right away, renderers add "items" to the queue.
+// Once all items are added, the queue is sorted by a key made up of pass, shader, texture, and depth.
+// Submitting the queue then calls back for each item, along with which state actually changed since the previous item.
+// This lets the caller skip activating shaders, binding textures, or setting uniforms that are already set.
+//
+// The queue doesn't talk to the graphics API itself - it only decides order and tracks what changed.
+//
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Matrix4.h"
+
+class Material;
+class Shader;
+class Submesh;
+class Texture;
+
+class RenderQueue
+{
+public:
+    enum class Pass : uint8_t
+    {
+        Opaque,
+        Translucent
+    };
+
+    struct Item
+    {
+        Shader* shader = nullptr;
+        Texture* texture = nullptr;
+        Material* material = nullptr;
+        Submesh* submesh = nullptr;
+        Matrix4 objectToWorldMatrix;
+    };
+
+    // Which state differs from the previously submitted item.
+    // The first item in a submit always has everything changed.
+    struct StateChanges
+    {
+        bool shader = false;
+
+        // The item's texture is different from the last one bound.
+        bool texture = false;
+
+        // Material uniforms need to be set (either a different material, or the shader changed).
+        bool material = false;
+
+        // Object matrices need to be set (either a different matrix, or the shader changed).
+        bool matrix = false;
+    };
+
+    // Per-frame counters. Reset when the queue is cleared.
+    struct Stats
+    {
+        int drawCount = 0;
+        int shaderChanges = 0;
+        int textureChanges = 0;
+        int materialChanges = 0;
+        int matrixChanges = 0;
+
+        // Meshes that were (or weren't) added to the queue, based on whether they're in view of the camera.
+        int visibleMeshes = 0;
+        int culledMeshes = 0;
+    };
+
+    void Clear();
+
+    // Adds an item to draw. Depth is the distance (or squared distance) from the camera.
+    // Opaque items are drawn front-to-back (within the same shader/texture), translucent items back-to-front.
+    void Add(Pass pass, Shader* shader, Texture* texture, Material* material, Submesh* submesh, const Matrix4& objectToWorldMatrix, float depth);
+
+    // Counts a mesh that was checked against the camera's view. Only used for stats.
+    void CountMesh(bool visible) { ++(visible ? mStats.visibleMeshes : mStats.culledMeshes); }
+
+    // Sorts items that were added. Must be called after adding items and before submitting them.
+    void Sort();
+
+    // Calls "submitItem(item, stateChanges)" for each item in the pass, in sorted order.
+    template<typename SubmitItemFunc>
+    void Submit(Pass pass, SubmitItemFunc submitItem);
+
+    size_t GetItemCount() const { return mItems.size(); }
+    const Stats& GetStats() const { return mStats; }
+
+private:
+    // All items added this frame, in the order they were added.
+    std::vector<Item> mItems;
+
+    // Sort keys for items. Sorting these rather than the items themselves avoids copying around matrices.
+    // The index into the items list is included so items with equal keys keep the order they were added in.
+    struct SortKey
+    {
+        uint64_t key = 0;
+        uint32_t itemIndex = 0;
+
+        bool operator<(const SortKey& other) const
+        {
+            return key < other.key || (key == other.key && itemIndex < other.itemIndex);
+        }
+    };
+    std::vector<SortKey> mSortKeys;
+
+    // Shaders and textures are given small sequential IDs, so they fit in the sort key.
+    std::unordered_map<const void*, uint16_t> mIds;
+
+    // Counters for this frame.
+    Stats mStats;
+
+    uint16_t GetId(const void* ptr);
+    static Pass GetPass(uint64_t key) { return (key >> 63) != 0 ? Pass::Translucent : Pass::Opaque; }
+};
+
+template<typename SubmitItemFunc>
+void RenderQueue::Submit(Pass pass, SubmitItemFunc submitItem)
+{
+    // State is only tracked within a single submit - the caller may change state between submits (e.g. to render other things).
+    const Item* prevItem = nullptr;
+    for(const SortKey& sortKey : mSortKeys)
+    {
+        if(GetPass(sortKey.key) != pass) { continue; }
+        const Item& item = mItems[sortKey.itemIndex];
+
+        // Uniforms belong to the shader, so switching shaders means all uniforms need to be set again.
+        StateChanges changes;
+        changes.shader = prevItem == nullptr || item.shader != prevItem->shader;
+        changes.texture = prevItem == nullptr || item.texture != prevItem->texture;
+        changes.material = changes.shader || item.material != prevItem->material;
+        changes.matrix = changes.shader || !(item.objectToWorldMatrix == prevItem->objectToWorldMatrix);
+
+        ++mStats.drawCount;
+        if(changes.shader) { ++mStats.shaderChanges; }
+        if(changes.texture) { ++mStats.textureChanges; }
+        if(changes.material) { ++mStats.materialChanges; }
+        if(changes.matrix) { ++mStats.matrixChanges; }
+
+        submitItem(item, changes);
+        prevItem = &item;
+    }
+}
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "Camera.h"
 #include "Debug.h"
 #include "GAPI.h"
+#include "Material.h"
 #include "Matrix4.h"
 #include "MeshRenderer.h"
 #include "Paths.h"
@@ -137,6 +138,7 @@ bool Renderer::Initialize()
     ShaderCache::LoadShader("Skybox", "Uber", { "FEATURE_SKYBOX" });
     ShaderCache::LoadShader("TextColorReplace", "Uber", { "FEATURE_TEXTURING", "FEATURE_COLOR_REPLACE" });
     ShaderCache::LoadShader("PointsAsCircles", "Uber", { "FEATURE_TEXTURING", "FEATURE_DRAW_POINTS_AS_CIRCLES" });
+    ShaderCache::LoadShader("UIBatch", "Uber", { "FEATURE_TEXTURING", "FEATURE_VERTEX_COLOR" });
 
     // Create simple shapes (useful for debugging/visualization).
     // Line
@@ -209,6 +211,7 @@ void Renderer::Shutdown()
 {
     if(GAPI::Get() != nullptr)
     {
+        Material::Shutdown();
         GAPI::Get()->Shutdown();
     }
     Window::Destroy();
@@ -229,6 +232,33 @@ void Renderer::Clear()
     PROFILER_END_SAMPLE();
 }
 
+namespace
+{
+    void RenderQueuePass(RenderQueue& renderQueue, RenderQueue::Pass pass)
+    {
+        // Only set state that actually changed since the previous item.
+        const Material* prevMaterial = nullptr;
+        renderQueue.Submit(pass, [&prevMaterial](const RenderQueue::Item& item, const RenderQueue::StateChanges& changes){
+            if(changes.shader)
+            {
+                item.material->ActivateShader();
+            }
+            if(changes.matrix)
+            {
+                item.material->SetObjectToWorldMatrix(item.objectToWorldMatrix);
+            }
+            if(changes.material)
+            {
+                // The queue only tracks the main texture, so double-check any other textures before skipping texture binds.
+                bool bindTextures = changes.texture || prevMaterial == nullptr || !item.material->HasSameTextures(*prevMaterial);
+                item.material->ActivateProperties(bindTextures);
+            }
+            item.submesh->Render();
+            prevMaterial = item.material;
+        });
+    }
+}
+
 void Renderer::Render()
 {
     // Render camera-oriented stuff.
@@ -244,6 +274,23 @@ void Renderer::Render()
         }
         PROFILER_END_SAMPLE();
 
+        PROFILER_BEGIN_SAMPLE("Build Render Queue");
+        {
+            // Gather everything mesh renderers want to draw in one pass, then sort it to minimize state changes.
+            // Anything outside the camera's view is culled before it gets to the queue.
+            mRenderQueue.Clear();
+            Vector3 cameraPosition = mCamera->GetOwner()->GetPosition();
+            Frustum frustum(projectionMatrix * viewMatrix);
+            for(MeshRenderer* meshRenderer : mMeshRenderers)
+            {
+                meshRenderer->AddToRenderQueue(mRenderQueue, cameraPosition, frustum);
+            }
+            mRenderQueue.Sort();
+            PROFILER_COUNTER("Visible Meshes", mRenderQueue.GetStats().visibleMeshes);
+            PROFILER_COUNTER("Culled Meshes", mRenderQueue.GetStats().culledMeshes);
+        }
+        PROFILER_END_SAMPLE();
+
         PROFILER_BEGIN_SAMPLE("Render Skybox");
         {
             // SKYBOX RENDERING
@@ -282,13 +329,9 @@ void Renderer::Render()
             PROFILER_END_SAMPLE();
 
             PROFILER_BEGIN_SAMPLE("Render Opaque Meshes");
-            // Render opaque meshes (no particular order).
-            // Sorting is probably not worthwhile b/c BSP likely mostly filled the z-buffer at this point.
-            // And with the z-buffer, we can render opaque meshed correctly regardless of order.
-            for(MeshRenderer* meshRenderer : mMeshRenderers)
-            {
-                meshRenderer->Render(true, false);
-            }
+            // Render opaque meshes. These are sorted by shader & texture to reduce state changes.
+            // With the z-buffer, we can render opaque meshes correctly regardless of order.
+            RenderQueuePass(mRenderQueue, RenderQueue::Pass::Opaque);
             PROFILER_END_SAMPLE();
         }
         PROFILER_END_SAMPLE();
@@ -317,12 +360,8 @@ void Renderer::Render()
             PROFILER_END_SAMPLE();
 
             PROFILER_BEGIN_SAMPLE("Render Translucent Meshes");
-            // Render all translucent meshes.
-            //TODO: Probably about 99% of these meshes are opaque only; it seems a bit wasteful to iterate them again. But maybe it's OK?
-            for(MeshRenderer* meshRenderer : mMeshRenderers)
-            {
-                meshRenderer->Render(false, true);
-            }
+            // Render all translucent meshes, back-to-front.
+            RenderQueuePass(mRenderQueue, RenderQueue::Pass::Translucent);
             PROFILER_END_SAMPLE();
         }
         PROFILER_END_SAMPLE();
@@ -405,7 +444,19 @@ Texture* Renderer::LoadSceneTexture(const std::string& name, AssetScope scope)
 {
     // Load texture per usual.
     Texture* texture = gAssetManager.LoadAsset<Texture>(name, scope);
+    ApplySceneTextureSettings(texture);
+    return texture;
+}
+
+AssetHandle<Texture> Renderer::LoadSceneTextureHandle(const std::string& name, AssetScope scope)
+{
+    AssetHandle<Texture> texture = gAssetManager.LoadAssetHandle<Texture>(name, scope);
+    ApplySceneTextureSettings(texture.Get());
+    return texture;
+}
 
+void Renderer::ApplySceneTextureSettings(Texture* texture)
+{
     // A "scene" texture means it is rendered as part of the 3D game scene (as opposed to a 2D UI texture).
     // These textures look better if you apply mipmaps and filtering.
     if(texture != nullptr && texture->GetRenderType() != Texture::RenderType::AlphaTest)
@@ -425,7 +476,6 @@ Texture* Renderer::LoadSceneTexture(const std::string& name, AssetScope scope)
             texture->SetPixelColor(1, 0, Color32::Magenta);
         }
     }
-    return texture;
 }
 
 void Renderer::SetSkybox(Skybox* skybox)
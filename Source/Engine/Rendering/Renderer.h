@@ -8,6 +8,8 @@
 #include <vector>
 
 #include "Asset.h"
+#include "AssetCache.h"
+#include "RenderQueue.h"
 #include "Window.h"
 
 class BSP;
@@ -34,10 +36,16 @@ public:
     void AddMeshRenderer(MeshRenderer* mc);
     void RemoveMeshRenderer(MeshRenderer* mc);
 
+    // Draw/state change counts for mesh rendering in the last rendered frame.
+    const RenderQueue::Stats& GetRenderStats() const { return mRenderQueue.GetStats(); }
+
     void SetBSP(BSP* bsp) { mBSP = bsp; }
     BSP* GetBSP() const { return mBSP; }
 
+    // Loads a texture rendered as part of the 3D scene, with the appropriate settings for that (mipmaps, filtering, etc).
+    // Use the handle version for textures held by an owner that goes away, so the texture can be evicted after that.
     Texture* LoadSceneTexture(const std::string& name, AssetScope scope = AssetScope::Global);
+    AssetHandle<Texture> LoadSceneTextureHandle(const std::string& name, AssetScope scope = AssetScope::Global);
 
     void SetSkybox(Skybox* skybox);
 
@@ -58,6 +66,10 @@ private:
     // List of mesh components to render.
     std::vector<MeshRenderer*> mMeshRenderers;
 
+    // Mesh renderers add what they want to draw to this queue each frame.
+    // It's sorted to reduce state changes before anything is actually drawn.
+    RenderQueue mRenderQueue;
+
     // A BSP to render.
     BSP* mBSP = nullptr;
 
@@ -67,6 +79,8 @@ private:
     // Global texture settings.
     bool mUseMipmaps = true;
     bool mUseTrilinearFiltering = true;
+
+    void ApplySceneTextureSettings(Texture* texture);
 };
 
 extern Renderer gRenderer;
\ No newline at end of file
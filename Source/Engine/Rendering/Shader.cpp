@@ -10,6 +10,17 @@ TYPEINFO_INIT(Shader, Asset, GENERATE_TYPE_ID)
 
 }
 
+namespace
+{
+    // Names of built-in uniforms in shader source. Must match the order of the BuiltInUniform enum.
+    const char* kBuiltInUniformNames[] = {
+        "gObjectToWorldMatrix",
+        "gWorldToObjectMatrix",
+        "gDiscardColor"
+    };
+    static_assert(sizeof(kBuiltInUniformNames) / sizeof(kBuiltInUniformNames[0]) == static_cast<int>(Shader::BuiltInUniform::Count), "Built-in uniform names don't match enum");
+}
+
 Shader::Shader(const std::string& name, const std::string& vertexShaderFileNameNoExt, const std::string& fragmentShaderFileNameNoExt,
                const std::vector<std::string>& featureFlags) : Asset(name, AssetScope::Manual)
 {
@@ -89,6 +100,44 @@ void Shader::SetUniformColor(const char* name, const Color32& color)
     GAPI::Get()->SetShaderUniformColor(mShaderHandle, name, color);
 }
 
+void Shader::SetUniformInt(int location, int value)
+{
+    GAPI::Get()->SetShaderUniformInt(mShaderHandle, location, value);
+}
+
+void Shader::SetUniformFloat(int location, float value)
+{
+    GAPI::Get()->SetShaderUniformFloat(mShaderHandle, location, value);
+}
+
+void Shader::SetUniformVector4(int location, const Vector4& vector)
+{
+    GAPI::Get()->SetShaderUniformVector4(mShaderHandle, location, vector);
+}
+
+void Shader::SetUniformMatrix4(int location, const Matrix4& mat)
+{
+    GAPI::Get()->SetShaderUniformMatrix4(mShaderHandle, location, mat);
+}
+
+void Shader::SetUniformColor(int location, const Color32& color)
+{
+    GAPI::Get()->SetShaderUniformColor(mShaderHandle, location, color);
+}
+
+int Shader::GetUniformLocation(const std::string& name)
+{
+    // Only ask the graphics API the first time - after that, use the cached location (even if it is -1).
+    auto it = mUniformLocations.find(name);
+    if(it != mUniformLocations.end())
+    {
+        return it->second;
+    }
+    int location = GAPI::Get()->GetShaderUniformLocation(mShaderHandle, name.c_str());
+    mUniformLocations[name] = location;
+    return location;
+}
+
 void Shader::CreateShader(TextAsset* vertexShaderText, TextAsset* fragmentShaderText, const std::vector<std::string>& featureFlags)
 {
     GAPI::ShaderParams shaderParams;
@@ -96,4 +145,10 @@ void Shader::CreateShader(TextAsset* vertexShaderText, TextAsset* fragmentShader
     shaderParams.fragmentShaderSource = reinterpret_cast<char*>(fragmentShaderText->GetText());
     shaderParams.featureFlags = featureFlags;
     mShaderHandle = GAPI::Get()->CreateShader(shaderParams);
+
+    // Look up built-in uniform locations right away, since they are used every time the shader is used.
+    for(int i = 0; i < static_cast<int>(BuiltInUniform::Count); ++i)
+    {
+        mBuiltInUniformLocations[i] = GAPI::Get()->GetShaderUniformLocation(mShaderHandle, kBuiltInUniformNames[i]);
+    }
 }
\ No newline at end of file
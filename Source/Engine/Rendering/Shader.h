@@ -7,6 +7,7 @@
 #include "Asset.h"
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class Color32;
@@ -19,6 +20,16 @@ class Shader : public Asset
 {
     TYPEINFO_SUB(Shader, Asset);
 public:
+    // Uniforms that the engine sets on every shader, every time something is drawn.
+    // Their locations are looked up once when the shader is created, so they can be set without any lookup.
+    enum class BuiltInUniform
+    {
+        ObjectToWorldMatrix,
+        WorldToObjectMatrix,
+        DiscardColor,
+        Count
+    };
+
     Shader(const std::string& name, const std::string& vertexShaderFileNameNoExt, const std::string& fragmentShaderFileNameNoExt, const std::vector<std::string>& featureFlags);
     Shader(const std::string& name, const std::string& shaderFileNameNoExt, const std::vector<std::string>& featureFlags);
     ~Shader();
@@ -35,11 +46,29 @@ public:
 
     void SetUniformColor(const char* name, const Color32& color);
 
+    // Set uniforms by location. Locations can be obtained with GetUniformLocation.
+    void SetUniformInt(int location, int value);
+    void SetUniformFloat(int location, float value);
+    void SetUniformVector4(int location, const Vector4& vector);
+    void SetUniformMatrix4(int location, const Matrix4& mat);
+    void SetUniformColor(int location, const Color32& color);
+
+    // Returns -1 if the uniform doesn't exist in this shader.
+    int GetUniformLocation(const std::string& name);
+    int GetUniformLocation(BuiltInUniform uniform) const { return mBuiltInUniformLocations[static_cast<int>(uniform)]; }
+    bool HasUniform(BuiltInUniform uniform) const { return GetUniformLocation(uniform) >= 0; }
+
     bool IsValid() const { return mShaderHandle != nullptr; }
 
 private:
     // Handle to shader in underlying graphics system.
     void* mShaderHandle = nullptr;
 
+    // Locations of built-in uniforms, indexed by BuiltInUniform.
+    int mBuiltInUniformLocations[static_cast<int>(BuiltInUniform::Count)] = { -1, -1, -1 };
+
+    // Locations of other uniforms, by name. Looked up the first time each uniform is used.
+    std::unordered_map<std::string, int> mUniformLocations;
+
     void CreateShader(TextAsset* vertexShaderText, TextAsset* fragmentShaderText, const std::vector<std::string>& featureFlags);
 };
@@ -29,9 +29,9 @@ Shader* ShaderCache::LoadShader(const std::string& idToUse, const std::string& v
         return nullptr;
     }
 
-    // Cache and return.
-    AssetCache<Shader>::Get()->SetAsset(idToUse, shader);
-    return shader;
+    // Cache and return. Shaders are handed out as raw pointers, so they must never be evicted.
+    shader->Pin();
+    return AssetCache<Shader>::Get()->AddAsset(idToUse, shader).Get();
 }
 
 Shader* ShaderCache::LoadShader(const std::string& idToUse, const std::string& shaderFileNameNoExt, const std::vector<std::string>& featureFlags)
@@ -54,7 +54,7 @@ Shader* ShaderCache::LoadShader(const std::string& idToUse, const std::string& s
         return nullptr;
     }
 
-    // Cache and return.
-    AssetCache<Shader>::Get()->SetAsset(idToUse, shader);
-    return shader;
+    // Cache and return. Shaders are handed out as raw pointers, so they must never be evicted.
+    shader->Pin();
+    return AssetCache<Shader>::Get()->AddAsset(idToUse, shader).Get();
 }
\ No newline at end of file
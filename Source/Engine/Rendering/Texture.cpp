@@ -1,6 +1,8 @@
 #include "Texture.h"
 
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 #include <stb_image_resize.h>
 
@@ -8,6 +10,7 @@
 #include "BinaryWriter.h"
 #include "FileSystem.h"
 #include "GAPI.h"
+#include "PixelConvert.h"
 #include "PNGCodec.h"
 #include "ThreadUtil.h"
 
@@ -106,6 +109,27 @@ void Texture::Load(AssetData& data)
     LoadInternal(reader);
 }
 
+size_t Texture::CalculateMemorySize(uint32_t loadedDataLength) const
+{
+    // Compressed (565) textures are expanded to 24 or 32-bit pixels when loaded, so count the pixel data we actually hold.
+    // This only counts CPU-side memory; GPU memory isn't under the asset cache's control.
+    size_t pixelCount = static_cast<size_t>(mWidth) * mHeight;
+    size_t memorySize = 0;
+    if(mPixels != nullptr)
+    {
+        memorySize += pixelCount * mBytesPerPixel;
+    }
+    if(mPalette != nullptr)
+    {
+        memorySize += mPaletteSize;
+    }
+    if(mPaletteIndexes != nullptr)
+    {
+        memorySize += pixelCount;
+    }
+    return memorySize;
+}
+
 void Texture::Activate(uint8_t textureUnit)
 {
     // Make sure we're operating on the correct texture unit, first of all.
@@ -390,22 +414,14 @@ void Texture::SetTransparentColor(const Color32& color)
     }
 
     // Find instances of the desired transparent color and
-    // make sure the alpha value is zero.
-    int pixelByteCount = mWidth * mHeight * mBytesPerPixel;
-    for(int i = 0; i < pixelByteCount; i += mBytesPerPixel)
+    // make sure the alpha value is zero (and all other pixels are opaque).
+    if(mFormat == Format::BGRA)
     {
-        if(mFormat == Format::RGBA && mPixels[i] == color.r && mPixels[i + 1] == color.g && mPixels[i + 2] == color.b)
-        {
-            mPixels[i + 3] = 0;
-        }
-        else if(mFormat == Format::BGRA && mPixels[i] == color.b && mPixels[i + 1] == color.g && mPixels[i + 2] == color.r)
-        {
-            mPixels[i + 3] = 0;
-        }
-        else
-        {
-            mPixels[i + 3] = 255;
-        }
+        PixelConvert::ApplyColorKey(mPixels, mWidth * mHeight, color.b, color.g, color.r);
+    }
+    else
+    {
+        PixelConvert::ApplyColorKey(mPixels, mWidth * mHeight, color.r, color.g, color.b);
     }
 
     // Mark dirty so it uploads to GPU on next use.
@@ -492,14 +508,45 @@ void Texture::ApplyAlphaChannel(const Texture& alphaTexture)
     // At least, that's the case in GK3!
     bool useRgbForAlpha = alphaTexture.mPalette != nullptr;
 
-    // For each pixel, copy over the alpha value.
+    // Gather the alpha value for each pixel.
+    // If RGB is alpha value, just grab R val. Otherwise, grab A val.
     uint32_t pixelCount = mWidth * mHeight;
-    for(uint32_t i = 0; i < pixelCount; ++i)
+    std::vector<uint8_t> alpha(pixelCount);
+    if(alphaTexture.mPixels != nullptr)
     {
-        // If RGB is alpha value, just grab R val. Otherwise, +3 to get A val.
-        Color32 color = alphaTexture.GetPixelColor(i);
-        mPixels[(i * mBytesPerPixel) + 3] = useRgbForAlpha ? color.r : color.a;
+        bool isBGR = alphaTexture.mFormat == Format::BGR || alphaTexture.mFormat == Format::BGRA;
+        int channelOffset = useRgbForAlpha ? (isBGR ? 2 : 0) : 3;
+        if(channelOffset >= alphaTexture.mBytesPerPixel)
+        {
+            // No alpha channel means fully opaque.
+            std::fill(alpha.begin(), alpha.end(), 255);
+        }
+        else
+        {
+            const uint8_t* src = alphaTexture.mPixels + channelOffset;
+            for(uint32_t i = 0; i < pixelCount; ++i)
+            {
+                alpha[i] = src[i * alphaTexture.mBytesPerPixel];
+            }
+        }
     }
+    else if(alphaTexture.mPalette != nullptr && alphaTexture.mPaletteIndexes != nullptr)
+    {
+        // Palette colors are BGRA (with unused A), so R is the third byte.
+        uint8_t paletteAlpha[256] = { 0 };
+        uint32_t paletteColorCount = std::min(alphaTexture.mPaletteSize / 4, 256U);
+        for(uint32_t i = 0; i < paletteColorCount; ++i)
+        {
+            paletteAlpha[i] = alphaTexture.mPalette[i * 4 + 2];
+        }
+        for(uint32_t i = 0; i < pixelCount; ++i)
+        {
+            alpha[i] = paletteAlpha[alphaTexture.mPaletteIndexes[i]];
+        }
+    }
+
+    // Copy over the alpha values.
+    PixelConvert::ApplyAlpha(alpha.data(), mPixels, pixelCount);
 
     // Pixels are dirty.
     mDirtyFlags |= DirtyFlags::Pixels;
@@ -974,39 +1021,16 @@ void Texture::LoadCompressedFormat(BinaryReader& reader)
 
     // Read in pixel data.
     // This pixel data is stored top-left to bottom-right, so we don't flip (our pixel array starts at top-left corner).
+    // Each row is padded to an even number of pixels, so read whole rows (including padding) and convert them in one go.
+    uint32_t rowPixelCount = mWidth + (mWidth & 0x00000001);
+    std::vector<uint16_t> row(rowPixelCount);
     for(uint32_t y = 0; y < mHeight; ++y)
     {
-        for(uint32_t x = 0; x < mWidth; ++x)
-        {
-            int current = (y  * mWidth + x) * mBytesPerPixel;
-            uint16_t pixel = reader.ReadUShort();
-
-            float red = static_cast<float>((pixel & 0xF800) >> 11);
-            float green = static_cast<float>((pixel & 0x07E0) >> 5);
-            float blue = static_cast<float>((pixel & 0x001F));
-
-            mPixels[current] = (unsigned char)(red * 255 / 31);
-            mPixels[current + 1] = (unsigned char)(green * 255 / 63);
-            mPixels[current + 2] = (unsigned char)(blue * 255 / 31);
-
-            /*
-            // Causes all instances of magenta (R = 255, B = 255) to appear transparent.
-            if(mPixels[current] > 200 && mPixels[current + 1] < 100 && mPixels[current + 2] > 200)
-            {
-                mPixels[current + 3] = 0;
-            }
-            else
-            {
-                mPixels[current + 3] = 255;
-            }
-            */
-        }
+        // If data runs out, the rest of the image is black.
+        uint32_t pixelsRead = reader.ReadArray(row.data(), rowPixelCount);
+        std::fill(row.begin() + pixelsRead, row.end(), 0);
 
-        // Might need to skip some padding here.
-        if((mWidth & 0x00000001) != 0)
-        {
-            reader.ReadUShort();
-        }
+        PixelConvert::RGB565ToRGB(row.data(), mPixels + y * mWidth * mBytesPerPixel, mWidth);
     }
 }
 
@@ -1132,40 +1156,21 @@ void Texture::LoadBmpFormat(BinaryReader& reader)
     }
     else // there are padding bytes, or this is a palettized image
     {
-        // Because of padding bytes, we do the less efficient reading option.
+        // Because of padding bytes, we read one row at a time, skipping the padding after each.
         // BMP pixel data is stored bottom-left to top-right, so we do flip (our pixel array starts at top-left corner).
         int paddingByteCount = rowSize - (mBytesPerPixel * mWidth);
         for(int y = mHeight - 1; y >= 0; --y)
         {
-            for(uint32_t x = 0; x < mWidth; ++x)
+            // How we interpret pixel data will depend on the bpp.
+            if(bitsPerPixel == 8)
             {
-                // Calculate index into pixels array.
-                int index = (y * mWidth + x) * mBytesPerPixel;
-
-                // How we interpret pixel data will depend on the bpp.
-                if(bitsPerPixel == 8)
-                {
-                    // Read in the palette index and save it.
-                    uint8_t paletteIndex = reader.ReadByte();
-                    mPaletteIndexes[(y * mWidth + x)] = paletteIndex;
-                }
-                else if(bitsPerPixel == 24 || bitsPerPixel == 32)
-                {
-                    // Assuming BI_RGB format, alpha is not stored.
-                    // So regardless of bits per pixel of 24 or 32, the data layout and size is the same.
-
-                    // Pixel data in the BMP file is BGR.
-                    mPixels[index] = reader.ReadByte();     // Blue
-                    mPixels[index + 1] = reader.ReadByte(); // Green
-                    mPixels[index + 2] = reader.ReadByte(); // Red
-
-                    // BI_RGB format doesn't save any alpha, even if 32 bits per pixel.
-                    // We'll use a placeholder of 255 (fully opaque).
-                    if(bitsPerPixel == 32)
-                    {
-                        mPixels[index + 3] = 255; // Alpha
-                    }
-                }
+                // Read in the palette indexes for this row.
+                reader.Read(mPaletteIndexes + y * mWidth, mWidth);
+            }
+            else if(bitsPerPixel == 24 || bitsPerPixel == 32)
+            {
+                // Pixel data in the BMP file is BGR(A), which matches our format, so it can be read directly.
+                reader.Read(mPixels + y * mWidth * mBytesPerPixel, mWidth * mBytesPerPixel);
             }
 
             // Skip padding that may be present, to ensure 4-byte alignment.
@@ -1202,18 +1207,7 @@ void Texture::CreatePixelsFromPaletteData()
         int pixelCount = mWidth * mHeight;
         mPixels = new uint8_t[pixelCount * mBytesPerPixel];
 
-        // Go pixel-by-pixel and fill in the pixels array by converting the palette to pixels.
-        for(int pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex)
-        {
-            // Get the palette index this pixel uses and convert it to an offset within the palette index.
-            // Remember, palette data is BGRA (even if A is unused), so we must multiply by 4 (for 4 bytes per pixel).
-            int paletteByteIndex = mPaletteIndexes[pixelIndex] * 4;
-
-            // Copy color from palette to the pixels array.
-            int pixelsByteIndex = pixelIndex * mBytesPerPixel;
-            mPixels[pixelsByteIndex] = mPalette[paletteByteIndex];
-            mPixels[pixelsByteIndex + 1] = mPalette[paletteByteIndex + 1];
-            mPixels[pixelsByteIndex + 2] = mPalette[paletteByteIndex + 2];
-        }
+        // Fill in the pixels array by converting the palette to pixels.
+        PixelConvert::PaletteToRGB(mPaletteIndexes, mPalette, mPixels, pixelCount);
     }
 }
\ No newline at end of file
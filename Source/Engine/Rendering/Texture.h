@@ -71,6 +71,7 @@ public:
     ~Texture() override;
 
     void Load(AssetData& data);
+    size_t CalculateMemorySize(uint32_t loadedDataLength) const override;
 
     // Activates the texture in the graphics library.
     void Activate(uint8_t textureUnit);
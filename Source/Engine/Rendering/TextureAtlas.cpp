@@ -0,0 +1,146 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "GMath.h"
+#include "Texture.h"
+
+TextureAtlas::~TextureAtlas()
+{
+    Clear();
+}
+
+void TextureAtlas::Build(const std::vector<Texture*>& textures, uint32_t pageSize, uint32_t padding)
+{
+    Clear();
+    mEntries.resize(textures.size());
+
+    // Packing works best when placing the tallest textures first.
+    std::vector<uint32_t> order;
+    for(uint32_t i = 0; i < textures.size(); ++i)
+    {
+        if(textures[i] != nullptr && textures[i]->GetWidth() > 0 && textures[i]->GetHeight() > 0)
+        {
+            order.push_back(i);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&textures](uint32_t a, uint32_t b){
+        return textures[a]->GetHeight() > textures[b]->GetHeight();
+    });
+
+    // Pack textures into rows ("shelves") on each page.
+    // A row is as tall as its first (and tallest) texture. When a row is full, start a new row below it. When a page is full, start a new page.
+    struct Placement
+    {
+        uint32_t page = 0;
+        uint32_t x = 0;
+        uint32_t y = 0;
+    };
+    std::vector<Placement> placements(textures.size());
+    std::vector<uint32_t> pageWidths;
+    std::vector<uint32_t> pageHeights;
+    uint32_t rowX = 0;
+    uint32_t rowY = 0;
+    uint32_t rowHeight = 0;
+    for(uint32_t index : order)
+    {
+        uint32_t width = textures[index]->GetWidth() + padding * 2;
+        uint32_t height = textures[index]->GetHeight() + padding * 2;
+
+        // Move to a new row if this one is full.
+        if(!pageWidths.empty() && rowX + width > pageSize)
+        {
+            rowX = 0;
+            rowY += rowHeight;
+            rowHeight = 0;
+        }
+
+        // Move to a new page if this one is full (or there are no pages yet).
+        if(pageWidths.empty() || rowY + height > pageSize)
+        {
+            pageWidths.push_back(0);
+            pageHeights.push_back(0);
+            rowX = 0;
+            rowY = 0;
+            rowHeight = 0;
+        }
+
+        // Place the texture at the end of the current row.
+        Placement& placement = placements[index];
+        placement.page = static_cast<uint32_t>(pageWidths.size() - 1);
+        placement.x = rowX + padding;
+        placement.y = rowY + padding;
+        rowX += width;
+        rowHeight = Math::Max(rowHeight, height);
+
+        // Pages are only as big as needed. A texture bigger than the page size gets a bigger page.
+        pageWidths.back() = Math::Max(pageWidths.back(), rowX);
+        pageHeights.back() = Math::Max(pageHeights.back(), rowY + height);
+    }
+
+    // Create the pages.
+    for(size_t i = 0; i < pageWidths.size(); ++i)
+    {
+        Texture* page = new Texture(pageWidths[i], pageHeights[i], Color32::Black);
+        page->SetFilterMode(Texture::FilterMode::Bilinear);
+        page->SetWrapMode(Texture::WrapMode::Clamp);
+        mPages.push_back(page);
+    }
+
+    // Copy each texture to its spot, including padding (which repeats the texture's edge pixels, same as clamping).
+    for(uint32_t index : order)
+    {
+        Texture* texture = textures[index];
+        const Placement& placement = placements[index];
+        Texture* page = mPages[placement.page];
+
+        int width = static_cast<int>(texture->GetWidth());
+        int height = static_cast<int>(texture->GetHeight());
+        int pad = static_cast<int>(padding);
+
+        // If the texture's pixels are already in the page's format, whole rows can be copied directly.
+        // Otherwise (palettized or a different format), convert each pixel.
+        const uint8_t* sourcePixels = texture->GetPixelData();
+        bool copyRows = sourcePixels != nullptr && texture->GetFormat() == page->GetFormat();
+        uint32_t bytesPerPixel = page->GetBytesPerPixel();
+        for(int y = -pad; y < height + pad; ++y)
+        {
+            uint32_t sourceY = static_cast<uint32_t>(Math::Clamp(y, 0, height - 1));
+            if(copyRows)
+            {
+                const uint8_t* sourceRow = sourcePixels + sourceY * width * bytesPerPixel;
+                uint8_t* destRow = page->GetPixelData() + ((placement.y + y) * page->GetWidth() + placement.x) * bytesPerPixel;
+                memcpy(destRow, sourceRow, width * bytesPerPixel);
+                for(int i = 1; i <= pad; ++i)
+                {
+                    memcpy(destRow - i * bytesPerPixel, sourceRow, bytesPerPixel);
+                    memcpy(destRow + (width - 1 + i) * bytesPerPixel, sourceRow + (width - 1) * bytesPerPixel, bytesPerPixel);
+                }
+                continue;
+            }
+
+            for(int x = -pad; x < width + pad; ++x)
+            {
+                uint32_t sourceX = static_cast<uint32_t>(Math::Clamp(x, 0, width - 1));
+                page->SetPixelColor(placement.x + x, placement.y + y, texture->GetPixelColor(sourceX, sourceY));
+            }
+        }
+
+        // Save UV rect of the texture on the page.
+        Entry& entry = mEntries[index];
+        entry.page = page;
+        entry.uvOffset = Vector2(static_cast<float>(placement.x) / page->GetWidth(), static_cast<float>(placement.y) / page->GetHeight());
+        entry.uvScale = Vector2(static_cast<float>(width) / page->GetWidth(), static_cast<float>(height) / page->GetHeight());
+    }
+}
+
+void TextureAtlas::Clear()
+{
+    for(Texture* page : mPages)
+    {
+        delete page;
+    }
+    mPages.clear();
+    mEntries.clear();
+}
\ No newline at end of file
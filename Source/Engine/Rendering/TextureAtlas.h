@@ -0,0 +1,55 @@
+//
+// Clark Kromenaker
+//
+// Packs many small textures into a few large "page" textures.
+//
+// Rendering with many small textures means switching textures a lot, which is slow.
+// With an atlas, things that used different small textures can share a page - and each one's UVs are remapped to its spot on the page.
+//
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Vector2.h"
+
+class Texture;
+
+class TextureAtlas
+{
+public:
+    // Where a packed texture ended up in the atlas.
+    struct Entry
+    {
+        // The page the texture is on. Null if the texture couldn't be packed (e.g. it was null).
+        Texture* page = nullptr;
+
+        // The area of the page with the texture's pixels, in UV space (0-1).
+        // A UV (u, v) in the original texture is at (uvOffset + uv * uvScale) on the page.
+        Vector2 uvOffset;
+        Vector2 uvScale;
+    };
+
+    TextureAtlas() = default;
+    ~TextureAtlas();
+
+    // Not copyable - the atlas owns its pages.
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // Packs the textures into pages. Pages are at most "pageSize" wide and tall, unless a single texture is bigger than that.
+    // Each texture is surrounded by "padding" pixels copied from its edges, so bilinear filtering near edges doesn't pick up neighboring textures.
+    void Build(const std::vector<Texture*>& textures, uint32_t pageSize = 1024, uint32_t padding = 2);
+    void Clear();
+
+    const std::vector<Texture*>& GetPages() const { return mPages; }
+
+    // Entries are in the same order as the textures passed to Build.
+    const std::vector<Entry>& GetEntries() const { return mEntries; }
+
+private:
+    // Pages created when building the atlas. The atlas owns these.
+    std::vector<Texture*> mPages;
+
+    // Where each texture is in the atlas.
+    std::vector<Entry> mEntries;
+};
\ No newline at end of file
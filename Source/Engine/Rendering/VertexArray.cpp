@@ -133,9 +133,12 @@ void VertexArray::Draw(GAPI::Primitive mode, uint32_t offset, uint32_t count)
 
 void VertexArray::ChangeVertexData(void* data)
 {
-    // Save data locally.
+    // Save data locally (unless the caller modified the local data in-place).
     uint32_t size = mData.vertexCount * mData.vertexDefinition.CalculateSize();
-    memcpy(mData.vertexData[0], data, size);
+    if(mData.vertexData[0] != data)
+    {
+        memcpy(mData.vertexData[0], data, size);
+    }
 
     // Send to GPU if buffer already exists.
     // Otherwise, it'll get sent when the vertex buffer is created.
@@ -169,8 +172,11 @@ void VertexArray::ChangeVertexData(VertexAttribute::Semantic semantic, void* dat
         // Update sub-data, if semantic matches.
         if(attribute.semantic == semantic)
         {
-            // Save data locally.
-            memcpy(mData.vertexData[i], data, attributeSize);
+            // Save data locally (unless the caller modified the local data in-place).
+            if(mData.vertexData[i] != data)
+            {
+                memcpy(mData.vertexData[i], data, attributeSize);
+            }
 
             // Send to GPU if buffer already exists.
             // Otherwise, it'll get sent when the vertex buffer is created.
@@ -41,11 +41,11 @@ shpvoid ChangeScore(const std::string& scoreValue)
 }
 RegFunc1(ChangeScore, void, string, IMMEDIATE, REL_FUNC);
 
-int GetFlag(const std::string& flagName)
+int GetFlag(symbol flagName)
 {
-    return gGameProgress.GetFlag(flagName);
+    return gGameProgress.GetFlag(flagName.symbol);
 }
-RegFunc1(GetFlag, int, string, IMMEDIATE, REL_FUNC);
+RegFunc1(GetFlag, int, symbol, IMMEDIATE, REL_FUNC);
 
 /*
 int GetFlagInt(int flagEnum)
@@ -59,19 +59,19 @@ int GetFlagInt(int flagEnum)
 RegFunc1(GetFlagInt, int, int, IMMEDIATE, REL_FUNC);
 */
 
-shpvoid SetFlag(const std::string& flagName)
+shpvoid SetFlag(symbol flagName)
 {
-    gGameProgress.SetFlag(flagName);
+    gGameProgress.SetFlag(flagName.Intern());
     return 0;
 }
-RegFunc1(SetFlag, void, string, IMMEDIATE, REL_FUNC);
+RegFunc1(SetFlag, void, symbol, IMMEDIATE, REL_FUNC);
 
-shpvoid ClearFlag(const std::string& flagName)
+shpvoid ClearFlag(symbol flagName)
 {
-    gGameProgress.ClearFlag(flagName);
+    gGameProgress.ClearFlag(flagName.symbol);
     return 0;
 }
-RegFunc1(ClearFlag, void, string, IMMEDIATE, REL_FUNC);
+RegFunc1(ClearFlag, void, symbol, IMMEDIATE, REL_FUNC);
 
 shpvoid DumpFlags()
 {
@@ -80,72 +80,85 @@ shpvoid DumpFlags()
 }
 RegFunc0(DumpFlags, void, IMMEDIATE, DEV_FUNC);
 
-int GetGameVariableInt(const std::string& varName)
+int GetGameVariableInt(symbol varName)
 {
-    return gGameProgress.GetGameVariable(varName);
+    return gGameProgress.GetGameVariable(varName.symbol);
 }
-RegFunc1(GetGameVariableInt, int, string, IMMEDIATE, REL_FUNC);
+RegFunc1(GetGameVariableInt, int, symbol, IMMEDIATE, REL_FUNC);
 
-shpvoid IncGameVariableInt(const std::string& varName)
+shpvoid IncGameVariableInt(symbol varName)
 {
-    gGameProgress.IncGameVariable(varName);
+    gGameProgress.IncGameVariable(varName.Intern());
     return 0;
 }
-RegFunc1(IncGameVariableInt, void, string, IMMEDIATE, REL_FUNC);
+RegFunc1(IncGameVariableInt, void, symbol, IMMEDIATE, REL_FUNC);
 
-shpvoid SetGameVariableInt(const std::string& varName, int value)
+shpvoid SetGameVariableInt(symbol varName, int value)
 {
-    gGameProgress.SetGameVariable(varName, value);
+    gGameProgress.SetGameVariable(varName.Intern(), value);
     return 0;
 }
-RegFunc2(SetGameVariableInt, void, string, int, IMMEDIATE, REL_FUNC);
+RegFunc2(SetGameVariableInt, void, symbol, int, IMMEDIATE, REL_FUNC);
 
-int GetNounVerbCount(const std::string& noun, const std::string& verb)
+int GetNounVerbCount(symbol noun, symbol verb)
 {
-    return gGameProgress.GetNounVerbCount(noun, verb);
+    // Names that were never interned may still have counts from an older save file.
+    if(noun.symbol < 0 || verb.symbol < 0)
+    {
+        return gGameProgress.GetNounVerbCount(noun.name, verb.name);
+    }
+    return gGameProgress.GetNounVerbCount(noun.symbol, verb.symbol);
 }
-RegFunc2(GetNounVerbCount, int, string, string, IMMEDIATE, REL_FUNC);
+RegFunc2(GetNounVerbCount, int, symbol, symbol, IMMEDIATE, REL_FUNC);
 
 int GetNounVerbCountInt(int nounEnum, int verbEnum)
 {
-    return GetNounVerbCount(gActionManager.GetNoun(nounEnum),
-                            gActionManager.GetVerb(verbEnum));
+    return gGameProgress.GetNounVerbCount(gActionManager.GetNoun(nounEnum),
+                                          gActionManager.GetVerb(verbEnum));
 }
 RegFunc2(GetNounVerbCountInt, int, int, int, IMMEDIATE, REL_FUNC);
 
-shpvoid IncNounVerbCount(const string& noun, const string& verb)
+shpvoid IncNounVerbCount(symbol noun, symbol verb)
 {
     //TODO: Throw an error if the given noun corresponds to a "Topic".
-    gGameProgress.IncNounVerbCount(noun, verb);
+    gGameProgress.IncNounVerbCount(Scene::GetEgoSymbol(), noun.Intern(), verb.Intern());
     return 0;
 }
-RegFunc2(IncNounVerbCount, void, string, string, IMMEDIATE, REL_FUNC);
+RegFunc2(IncNounVerbCount, void, symbol, symbol, IMMEDIATE, REL_FUNC);
 
-shpvoid IncNounVerbCountBoth(const string& noun, const string& verb)
+shpvoid IncNounVerbCountBoth(symbol noun, symbol verb)
 {
     //TODO: Throw an error if the given noun corresponds to a "Topic".
-    gGameProgress.IncNounVerbCount("Gabriel", noun, verb);
-    gGameProgress.IncNounVerbCount("Grace", noun, verb);
+    static const int kGabriel = gSymbols.Intern("Gabriel");
+    static const int kGrace = gSymbols.Intern("Grace");
+    int nounSymbol = noun.Intern();
+    int verbSymbol = verb.Intern();
+    gGameProgress.IncNounVerbCount(kGabriel, nounSymbol, verbSymbol);
+    gGameProgress.IncNounVerbCount(kGrace, nounSymbol, verbSymbol);
     return 0;
 }
-RegFunc2(IncNounVerbCountBoth, void, string, string, IMMEDIATE, REL_FUNC);
+RegFunc2(IncNounVerbCountBoth, void, symbol, symbol, IMMEDIATE, REL_FUNC);
 
-shpvoid SetNounVerbCount(const std::string& noun, const std::string& verb, int count)
+shpvoid SetNounVerbCount(symbol noun, symbol verb, int count)
 {
     //TODO: Throw an error if the given noun corresponds to a "Topic".
-    gGameProgress.SetNounVerbCount(noun, verb, count);
+    gGameProgress.SetNounVerbCount(Scene::GetEgoSymbol(), noun.Intern(), verb.Intern(), count);
     return 0;
 }
-RegFunc3(SetNounVerbCount, void, string, string, int, IMMEDIATE, REL_FUNC);
+RegFunc3(SetNounVerbCount, void, symbol, symbol, int, IMMEDIATE, REL_FUNC);
 
-shpvoid SetNounVerbCountBoth(const std::string& noun, const std::string& verb, int count)
+shpvoid SetNounVerbCountBoth(symbol noun, symbol verb, int count)
 {
     //TODO: Throw an error if the given noun corresponds to a "Topic".
-    gGameProgress.SetNounVerbCount("Gabriel", noun, verb, count);
-    gGameProgress.SetNounVerbCount("Grace", noun, verb, count);
+    static const int kGabriel = gSymbols.Intern("Gabriel");
+    static const int kGrace = gSymbols.Intern("Grace");
+    int nounSymbol = noun.Intern();
+    int verbSymbol = verb.Intern();
+    gGameProgress.SetNounVerbCount(kGabriel, nounSymbol, verbSymbol, count);
+    gGameProgress.SetNounVerbCount(kGrace, nounSymbol, verbSymbol, count);
     return 0;
 }
-RegFunc3(SetNounVerbCountBoth, void, string, string, int, IMMEDIATE, REL_FUNC);
+RegFunc3(SetNounVerbCountBoth, void, symbol, symbol, int, IMMEDIATE, REL_FUNC);
 
 shpvoid TriggerNounVerb(const std::string& noun, const std::string& verb)
 {
@@ -160,23 +173,29 @@ shpvoid TriggerNounVerb(const std::string& noun, const std::string& verb)
 }
 RegFunc2(TriggerNounVerb, void, string, string, IMMEDIATE, DEV_FUNC);
 
-int GetTopicCount(const std::string& noun, const std::string& verb)
+int GetTopicCount(symbol noun, symbol verb)
 {
     //TODO: Validate noun. Must be a valid noun. Seems to include any scene nouns, inventory nouns, actor nouns.
-    if(!gVerbManager.IsTopic(verb))
+    if(!gVerbManager.IsTopic(verb.name))
     {
-        gReportManager.Log("Error", "Error: '" + verb + " is not a valid verb name.");
+        gReportManager.Log("Error", "Error: '" + std::string(verb.name) + " is not a valid verb name.");
         return 0;
     }
-    return gGameProgress.GetTopicCount(noun, verb);
+
+    // Names that were never interned may still have counts from an older save file.
+    if(noun.symbol < 0 || verb.symbol < 0)
+    {
+        return gGameProgress.GetTopicCount(noun.name, verb.name);
+    }
+    return gGameProgress.GetTopicCount(noun.symbol, verb.symbol);
 }
-RegFunc2(GetTopicCount, int, string, string, IMMEDIATE, REL_FUNC);
+RegFunc2(GetTopicCount, int, symbol, symbol, IMMEDIATE, REL_FUNC);
 
 int GetTopicCountInt(int nounEnum, int verbEnum)
 {
-    std::string noun = gActionManager.GetNoun(nounEnum);
-    std::string verb = gActionManager.GetVerb(verbEnum);
-    return GetTopicCount(noun, verb);
+    const std::string& noun = gActionManager.GetNoun(nounEnum);
+    const std::string& verb = gActionManager.GetVerb(verbEnum);
+    return GetTopicCount({ noun.c_str(), gSymbols.Find(noun) }, { verb.c_str(), gSymbols.Find(verb) });
 }
 RegFunc2(GetTopicCountInt, int, int, int, IMMEDIATE, REL_FUNC);
 
@@ -188,33 +207,33 @@ int HasTopicsLeft(const std::string& noun)
 }
 RegFunc1(HasTopicsLeft, int, string, IMMEDIATE, REL_FUNC);
 
-shpvoid SetTopicCount(std::string noun, std::string verb, int count)
+shpvoid SetTopicCount(symbol noun, symbol verb, int count)
 {
     //TODO: Validate noun or report error.
     //TODO: Validate verb or report error.
-    gGameProgress.SetTopicCount(noun, verb, count);
+    gGameProgress.SetTopicCount(Scene::GetEgoSymbol(), noun.Intern(), verb.Intern(), count);
     return 0;
 }
-RegFunc3(SetTopicCount, void, string, string, int, IMMEDIATE, DEV_FUNC);
+RegFunc3(SetTopicCount, void, symbol, symbol, int, IMMEDIATE, DEV_FUNC);
 
-int GetChatCount(const std::string& noun)
+int GetChatCount(symbol noun)
 {
-    return gGameProgress.GetChatCount(noun);
+    return gGameProgress.GetChatCount(noun.symbol);
 }
-RegFunc1(GetChatCount, int, string, IMMEDIATE, REL_FUNC);
+RegFunc1(GetChatCount, int, symbol, IMMEDIATE, REL_FUNC);
 
 int GetChatCountInt(int nounEnum)
 {
-    return GetChatCount(gActionManager.GetNoun(nounEnum));
+    return gGameProgress.GetChatCount(gActionManager.GetNoun(nounEnum));
 }
 RegFunc1(GetChatCountInt, int, int, IMMEDIATE, REL_FUNC);
 
-shpvoid SetChatCount(std::string noun, int count)
+shpvoid SetChatCount(symbol noun, int count)
 {
-    gGameProgress.SetChatCount(noun, count);
+    gGameProgress.SetChatCount(noun.Intern(), count);
     return 0;
 }
-RegFunc2(SetChatCount, void, string, int, IMMEDIATE, DEV_FUNC);
+RegFunc2(SetChatCount, void, symbol, int, IMMEDIATE, DEV_FUNC);
 
 shpvoid SetVerbModal(int modalState)
 {
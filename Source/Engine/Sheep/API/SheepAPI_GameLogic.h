@@ -14,34 +14,34 @@ shpvoid SetScore(int score); // DEV
 shpvoid ChangeScore(const std::string& scoreValue);
 
 // FLAGS
-int GetFlag(const std::string& flagName);
+int GetFlag(symbol flagName);
 int GetFlagInt(int flagEnum);
-shpvoid SetFlag(const std::string& flagName);
-shpvoid ClearFlag(const std::string& flagName);
+shpvoid SetFlag(symbol flagName);
+shpvoid ClearFlag(symbol flagName);
 shpvoid DumpFlags(); // DEV
 
 // VARIABLES
-int GetGameVariableInt(const std::string& varName);
-shpvoid IncGameVariableInt(const std::string& varName);
-shpvoid SetGameVariableInt(const std::string& varName, int value);
+int GetGameVariableInt(symbol varName);
+shpvoid IncGameVariableInt(symbol varName);
+shpvoid SetGameVariableInt(symbol varName, int value);
 
 // ACTION TRACKING
-int GetNounVerbCount(const std::string& noun, const std::string& verb);
+int GetNounVerbCount(symbol noun, symbol verb);
 int GetNounVerbCountInt(int nounEnum, int verbEnum);
-shpvoid IncNounVerbCount(const std::string& noun, const std::string& verb);
-shpvoid IncNounVerbCountBoth(const std::string& noun, const std::string& verb);
-shpvoid SetNounVerbCount(const std::string& noun, const std::string& verb, int count);
-shpvoid SetNounVerbCountBoth(const std::string& noun, const std::string& verb, int count);
+shpvoid IncNounVerbCount(symbol noun, symbol verb);
+shpvoid IncNounVerbCountBoth(symbol noun, symbol verb);
+shpvoid SetNounVerbCount(symbol noun, symbol verb, int count);
+shpvoid SetNounVerbCountBoth(symbol noun, symbol verb, int count);
 shpvoid TriggerNounVerb(const std::string& noun, const std::string& verb); // DEV
 
-int GetTopicCount(const std::string& noun, const std::string& verb);
+int GetTopicCount(symbol noun, symbol verb);
 int GetTopicCountInt(int nounEnum, int verbEnum);
 int HasTopicsLeft(const std::string& noun);
-shpvoid SetTopicCount(std::string noun, std::string verb, int count); // DEV
+shpvoid SetTopicCount(symbol noun, symbol verb, int count); // DEV
 
-int GetChatCount(const std::string& noun);
+int GetChatCount(symbol noun);
 int GetChatCountInt(int nounEnum);
-shpvoid SetChatCount(std::string noun, int count); // DEV
+shpvoid SetChatCount(symbol noun, int count); // DEV
 
 shpvoid FullReset(); // DEV
 shpvoid ResetGameData(); // DEV
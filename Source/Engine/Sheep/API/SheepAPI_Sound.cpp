@@ -143,10 +143,10 @@ RegFunc2(SetVolume, void, string, int, IMMEDIATE, DEV_FUNC);
 
 shpvoid PlaySound(const std::string& soundName)
 {
-    Audio* audio = gAssetManager.LoadAsset<Audio>(soundName, AssetScope::Scene);
-    if(audio != nullptr)
+    AssetHandle<Audio> audio = gAssetManager.LoadAssetHandle<Audio>(soundName, AssetScope::Scene);
+    if(audio.Get() != nullptr)
     {
-        gAudioManager.PlaySFX(audio, AddWait());
+        gAudioManager.PlaySFX(audio.Get(), AddWait());
     }
     return 0;
 }
@@ -154,9 +154,9 @@ RegFunc1(PlaySound, void, string, WAITABLE, REL_FUNC);
 
 shpvoid StopSound(const std::string& soundName)
 {
-    // For a sound to play, it must be loaded already anyway.
+    // For a sound to play, it must be loaded already anyway (the audio manager keeps playing sounds loaded).
     // And if it's null, the Stop function handles that.
-    gAudioManager.Stop(gAssetManager.LoadAsset<Audio>(soundName, AssetScope::Scene));
+    gAudioManager.Stop(gAssetManager.LoadAssetHandle<Audio>(soundName, AssetScope::Scene).Get());
     return 0;
 }
 RegFunc1(StopSound, void, string, IMMEDIATE, REL_FUNC);
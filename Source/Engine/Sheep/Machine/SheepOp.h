@@ -0,0 +1,105 @@
+//
+// Clark Kromenaker
+//
+// Sheep bytecode is compact, but slow to interpret: each instruction's operands must be decoded from the bytes every time it runs.
+//
+// So, when a SheepScript is loaded, its bytecode is decoded once into a list of "ops":
+// - Operands are already decoded (and resolved where possible, such as branch targets, string constants, and SysFuncs).
+// - Common sequences of instructions are "fused" into a single op, so they need only one dispatch.
+//
+// The VM runs these ops in place of the bytecode, but bytecode offsets are still used to save/restore a thread's position.
+//
+#pragma once
+#include <cstdint>
+
+struct SysFunc;
+
+enum class SheepOpCode : uint8_t
+{
+    // One op per bytecode instruction.
+    SitnSpin,
+    Yield,
+    CallSysFunctionV,
+    CallSysFunctionI,
+    CallSysFunctionF,
+    CallSysFunctionS,
+    Branch,
+    BranchIfZero,
+    BeginWait,
+    EndWait,
+    ReturnV,
+    StoreI,
+    StoreF,
+    StoreS,
+    LoadI,
+    LoadF,
+    LoadS,
+    PushI,
+    PushF,
+    PushS,
+    Pop,
+    AddI,
+    AddF,
+    SubtractI,
+    SubtractF,
+    MultiplyI,
+    MultiplyF,
+    DivideI,
+    DivideF,
+    NegateI,
+    NegateF,
+    IsEqualI,
+    IsEqualF,
+    IsNotEqualI,
+    IsNotEqualF,
+    IsGreaterI,
+    IsGreaterF,
+    IsLessI,
+    IsLessF,
+    IsGreaterEqualI,
+    IsGreaterEqualF,
+    IsLessEqualI,
+    IsLessEqualF,
+    IToF,
+    FToI,
+    Modulo,
+    And,
+    Or,
+    Not,
+    GetString,
+
+    // Fused ops.
+    PushString,             // PushS + GetString: push a string constant.
+    StoreConstI,            // PushI + StoreI: store a constant in an int variable.
+    IsEqualVarI,            // LoadI + PushI + IsEqualI: push whether an int variable equals a constant.
+    BranchIfZeroVarI,       // LoadI + BranchIfZero: branch if an int variable is zero.
+    BranchIfNotEqualVarI,   // LoadI + PushI + IsEqualI + BranchIfZero: branch if an int variable doesn't equal a constant.
+
+    // Reached the end of the bytecode.
+    End,
+
+    Count
+};
+
+struct SheepOp
+{
+    SheepOpCode code = SheepOpCode::SitnSpin;
+
+    // Offset in the bytecode of the (first) instruction this op was decoded from.
+    int bytecodeOffset = 0;
+
+    // A variable index, stack index (IToF/FToI), op index to branch to, or string symbol (PushString) - depending on the op.
+    int index = 0;
+
+    // For ops that use a variable AND branch, the op index to branch to.
+    int branchIndex = 0;
+
+    // A constant value or resolved pointer - depending on the op.
+    union
+    {
+        int intValue = 0;
+        float floatValue;
+        const char* stringValue;
+        SysFunc* sysFunc;
+    };
+};
\ No newline at end of file
@@ -13,6 +13,7 @@ void SheepStack::PushInt(int val)
 
     mStack[mStackSize - 1].type = SheepValueType::Int;
     mStack[mStackSize - 1].intValue = val;
+    mStack[mStackSize - 1].symbol = -1;
 
     #ifdef SHEEP_DEBUG
     std::cout << "SHEEP STACK: Push 1 (Stack Size = " << mStackSize << ")" << std::endl;
@@ -26,6 +27,7 @@ void SheepStack::PushFloat(float val)
 
     mStack[mStackSize - 1].type = SheepValueType::Float;
     mStack[mStackSize - 1].floatValue = val;
+    mStack[mStackSize - 1].symbol = -1;
 
     #ifdef SHEEP_DEBUG
     std::cout << "SHEEP STACK: Push 1 (Stack Size = " << mStackSize << ")" << std::endl;
@@ -39,19 +41,21 @@ void SheepStack::PushStringOffset(int val)
 
     mStack[mStackSize - 1].type = SheepValueType::String;
     mStack[mStackSize - 1].intValue = val;
+    mStack[mStackSize - 1].symbol = -1;
 
     #ifdef SHEEP_DEBUG
     std::cout << "SHEEP STACK: Push 1 (Stack Size = " << mStackSize << ")" << std::endl;
     #endif
 }
 
-void SheepStack::PushString(const char* str)
+void SheepStack::PushString(const char* str, int symbol)
 {
     mStackSize++;
     assert(mStackSize < kMaxStackSize);
 
     mStack[mStackSize - 1].type = SheepValueType::String;
     mStack[mStackSize - 1].stringValue = str;
+    mStack[mStackSize - 1].symbol = symbol;
 
     #ifdef SHEEP_DEBUG
     std::cout << "SHEEP STACK: Push 1 (Stack Size = " << mStackSize << ")" << std::endl;
@@ -121,6 +125,7 @@ void SheepStack::OnPersist(PersistState& ps)
                 {
                     strCache.push_back(str);
                     mStack[i].stringValue = strCache.back().c_str();
+                    mStack[i].symbol = -1;
                 }
                 break;
         }
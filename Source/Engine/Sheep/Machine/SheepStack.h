@@ -16,10 +16,11 @@ public:
     void PushInt(int val);
     void PushFloat(float val);
     void PushStringOffset(int val);
-    void PushString(const char* str);
+    void PushString(const char* str, int symbol = -1);
 
     SheepValue& Peek() { assert(mStackSize > 0); return mStack[mStackSize - 1]; }
     SheepValue& Peek(int index) { assert(mStackSize > 0 && index < mStackSize); return mStack[mStackSize - 1 - index]; }
+    SheepValue* PeekTop(int count) { assert(count >= 0 && count <= mStackSize); return &mStack[mStackSize - count]; }
     SheepValue& Pop();
     void Pop(int count);
 
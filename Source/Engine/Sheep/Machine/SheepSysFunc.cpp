@@ -1,6 +1,6 @@
 #include "SheepSysFunc.h"
 
-#include <iostream>
+#include <cassert>
 
 #include "SheepManager.h"
 #include "StringUtil.h"
@@ -29,7 +29,8 @@ size_t CalcHashForSysFunc(const SysFuncImport& sysImport)
     return res;
 }
 
-void AddSysFunc(const std::string& name, char retType, std::initializer_list<char> argTypes, bool waitable, bool dev)
+void AddSysFunc(const std::string& name, char retType, std::initializer_list<char> argTypes, std::initializer_list<bool> symbolArgs,
+                bool waitable, bool dev, SysFuncInvoker invoker)
 {
     SysFunc sysFunc;
     sysFunc.name = name;
@@ -38,8 +39,10 @@ void AddSysFunc(const std::string& name, char retType, std::initializer_list<cha
     {
         sysFunc.argumentTypes.push_back(argType);
     }
+    sysFunc.symbolArguments.assign(symbolArgs.begin(), symbolArgs.end());
     sysFunc.waitable = waitable;
     sysFunc.devOnly = dev;
+    sysFunc.invoker = invoker;
 
     SysFuncs& sysFuncs = GetSysFuncs();
     sysFuncs.sysFuncs.push_back(sysFunc);
@@ -71,112 +74,6 @@ SysFunc* GetSysFunc(const SysFuncImport* sysImport)
     return nullptr;
 }
 
-Value CallSysFunc(const std::string& name)
-{
-    auto& map0 = GetSysFuncs().map0;
-    auto it = map0.find(name);
-    if(it != map0.end())
-    {
-        return it->second(0);
-    }
-    else
-    {
-        std::cout << "Couldn't find SysFunc0 " << name << std::endl;
-        return Value(0);
-    }
-}
-
-Value CallSysFunc(const std::string& name, const Value& x1)
-{
-    auto& map1 = GetSysFuncs().map1;
-    auto it = map1.find(name);
-    if(it != map1.end())
-    {
-        return it->second(x1);
-    }
-    else
-    {
-        std::cout << "Couldn't find SysFunc1 " << name << std::endl;
-        return Value(0);
-    }
-}
-
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2)
-{
-    auto& map2 = GetSysFuncs().map2;
-    auto it = map2.find(name);
-    if(it != map2.end())
-    {
-        return it->second(x1, x2);
-    }
-    else
-    {
-        std::cout << "Couldn't find SysFunc2 " << name << std::endl;
-        return Value(0);
-    }
-}
-
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3)
-{
-    auto& map3 = GetSysFuncs().map3;
-    auto it = map3.find(name);
-    if(it != map3.end())
-    {
-        return it->second(x1, x2, x3);
-    }
-    else
-    {
-        std::cout << "Couldn't find SysFunc3 " << name << std::endl;
-        return Value(0);
-    }
-}
-
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3, const Value& x4)
-{
-    auto& map4 = GetSysFuncs().map4;
-    auto it = map4.find(name);
-    if(it != map4.end())
-    {
-        return it->second(x1, x2, x3, x4);
-    }
-    else
-    {
-        std::cout << "Couldn't find SysFunc4 " << name << std::endl;
-        return Value(0);
-    }
-}
-
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3, const Value& x4, const Value& x5)
-{
-    auto& map5 = GetSysFuncs().map5;
-    auto it = map5.find(name);
-    if(it != map5.end())
-    {
-        return it->second(x1, x2, x3, x4, x5);
-    }
-    else
-    {
-        std::cout << "Couldn't find SysFunc5 " << name << std::endl;
-        return Value(0);
-    }
-}
-
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3,
-                  const Value& x4, const Value& x5, const Value& x6)
-{
-    auto& map6 = GetSysFuncs().map6;
-    auto it = map6.find(name);
-    if(it != map6.end())
-    {
-        return it->second(x1, x2, x3, x4, x5, x6);
-    }
-    else
-    {
-        std::cout << "Couldn't find SysFunc6 " << name << std::endl;
-        return Value(0);
-    }
-}
-
 void ExecError()
 {
     gSheepManager.FlagExecutionError();
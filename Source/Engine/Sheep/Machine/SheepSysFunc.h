@@ -11,10 +11,12 @@
 #include <functional>
 #include <map>
 #include <string>
-#include <vector>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
-#include "Value.h"
+#include "SheepValue.h"
+#include "SymbolTable.h"
 
 // Bare minimum data to uniquely identify a SysFunc signature in a SheepScript.
 // Called an Import b/c we are sort of "importing" the function for use in a SheepScript.
@@ -30,6 +32,28 @@ struct SysFuncImport
     std::vector<char> argumentTypes;
 };
 
+// Holds the return value of a SysFunc call.
+struct SysFuncResult
+{
+    SysFuncResult() = default;
+
+    // Not copyable, since a string value points into the object itself.
+    SysFuncResult(const SysFuncResult&) = delete;
+    SysFuncResult& operator=(const SysFuncResult&) = delete;
+
+    // The returned value. For strings, this points to "stringValue" below.
+    SheepValue value;
+    std::string stringValue;
+
+    void Set(int i) { value = SheepValue(i); }
+    void Set(float f) { value = SheepValue(f); }
+    void Set(std::string s) { stringValue = std::move(s); value = SheepValue(stringValue.c_str()); }
+};
+
+// Calls a SysFunc. Arguments are read directly from "args" (which usually points into the Sheep stack), in declaration order.
+// The generic function converts each argument to the type the actual function expects, calls it, and stores the return value in "result".
+typedef void (*SysFuncInvoker)(const SheepValue* args, SysFuncResult& result);
+
 // "Full" info about a SysFunc.
 // Contains extra metadata that doesn't need to be stored in a compiled SheepScript, but is useful at runtime.
 struct SysFunc : public SysFuncImport
@@ -41,6 +65,13 @@ struct SysFunc : public SysFuncImport
     // If true, this function can only work in dev builds.
     bool devOnly = false;
 
+    // Calls the function.
+    SysFuncInvoker invoker = nullptr;
+
+    // For each argument, whether it's a string that's used as a symbol (see SymbolArg).
+    // Compiled scripts only know these as strings, so this isn't part of the import.
+    std::vector<bool> symbolArguments;
+
     // Text that's output to explain this function when using HelpCommand.
     //std::string helpText;
 
@@ -59,18 +90,6 @@ struct SysFunc : public SysFuncImport
 // Holds all SysFuncs created at runtime. There's only ever a single instance of this.
 struct SysFuncs
 {
-    // Maps of SysFunc names to function pointers. One map per argument count.
-    // This is how you actually call the functions.
-    std::map<std::string, Value(*)(const Value&)> map0;
-    std::map<std::string, Value(*)(const Value&)> map1;
-    std::map<std::string, Value(*)(const Value&, const Value&)> map2;
-    std::map<std::string, Value(*)(const Value&, const Value&, const Value&)> map3;
-    std::map<std::string, Value(*)(const Value&, const Value&, const Value&, const Value&)> map4;
-    std::map<std::string, Value(*)(const Value&, const Value&, const Value&, const Value&, const Value&)> map5;
-    std::map<std::string, Value(*)(const Value&, const Value&, const Value&, const Value&, const Value&, const Value&)> map6;
-    std::map<std::string, Value(*)(const Value&, const Value&, const Value&, const Value&, const Value&, const Value&, const Value&)> map7;
-    std::map<std::string, Value(*)(const Value&, const Value&, const Value&, const Value&, const Value&, const Value&, const Value&, const Value&)> map8;
-
     // A big array of all our defined system functions.
     // This is populated at program start and then never changed.
     std::vector<SysFunc> sysFuncs;
@@ -82,18 +101,61 @@ struct SysFuncs
 SysFuncs& GetSysFuncs();
 
 // Add/Retrieve SysFuncs.
-void AddSysFunc(const std::string& name, char retType, std::initializer_list<char> argTypes, bool waitable, bool dev);
+void AddSysFunc(const std::string& name, char retType, std::initializer_list<char> argTypes, std::initializer_list<bool> symbolArgs,
+                bool waitable, bool dev, SysFuncInvoker invoker);
 SysFunc* GetSysFunc(const std::string& name);
 SysFunc* GetSysFunc(const SysFuncImport* sysImport);
 
-// Call SysFuncs with various argument counts.
-Value CallSysFunc(const std::string& name);
-Value CallSysFunc(const std::string& name, const Value& x1);
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2);
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3);
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3, const Value& x4);
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3, const Value& x4, const Value& x5);
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3, const Value& x4, const Value& x5, const Value& x6);
+// Converts a Sheep value to the argument type a SysFunc expects.
+template<typename T> T GetSysFuncArg(const SheepValue& value);
+template<> inline int GetSysFuncArg<int>(const SheepValue& value) { return value.GetInt(); }
+template<> inline float GetSysFuncArg<float>(const SheepValue& value) { return value.GetFloat(); }
+template<> inline std::string GetSysFuncArg<std::string>(const SheepValue& value) { return value.GetString(); }
+
+// A string argument that names a symbol (see SymbolTable.h), such as a flag, noun, or verb.
+// String constants passed as symbol arguments are interned when a script is loaded, so usually no name lookup is needed to get the symbol.
+// Other strings are only looked up, not interned: a name that was never interned has no value to get.
+// Functions that set a value should use Intern() to get a valid symbol.
+struct SymbolArg
+{
+    const char* name = "";
+    int symbol = kInvalidSymbol;
+
+    // If a script passes an int or float, it's converted to a string (as string args are), and "name" points to this copy.
+    std::string convertedName;
+
+    SymbolArg() = default;
+    SymbolArg(const char* name, int symbol) : name(name), symbol(symbol) { }
+    SymbolArg(const SymbolArg& other) { *this = other; }
+    SymbolArg& operator=(const SymbolArg& other)
+    {
+        symbol = other.symbol;
+        convertedName = other.convertedName;
+        name = other.name == other.convertedName.c_str() ? convertedName.c_str() : other.name;
+        return *this;
+    }
+
+    int Intern() const { return symbol >= 0 ? symbol : gSymbols.Intern(name); }
+};
+template<> inline SymbolArg GetSysFuncArg<SymbolArg>(const SheepValue& value)
+{
+    SymbolArg arg;
+    if(value.type == SheepValueType::String)
+    {
+        if(value.stringValue != nullptr)
+        {
+            arg.name = value.stringValue;
+            arg.symbol = value.symbol >= 0 ? value.symbol : gSymbols.Find(value.stringValue);
+        }
+    }
+    else
+    {
+        arg.convertedName = value.GetString();
+        arg.name = arg.convertedName.c_str();
+        arg.symbol = gSymbols.Find(arg.convertedName);
+    }
+    return arg;
+}
 
 // Flags execution error in a SysFunc.
 void ExecError();
@@ -110,6 +172,16 @@ std::function<void()> AddWait();
 #define int_TYPE 1
 #define float_TYPE 2
 #define string_TYPE 3
+#define symbol_TYPE 3 // symbols are strings in Sheep
+
+#define void_SYMBOL false
+#define int_SYMBOL false
+#define float_SYMBOL false
+#define string_SYMBOL false
+#define symbol_SYMBOL true
+
+// Declares a SysFunc argument as a string that should be used as a symbol.
+typedef SymbolArg symbol;
 
 // When registering functions, use these for Waitable and Dev/Release options to improve readability.
 #define WAITABLE true
@@ -118,78 +190,73 @@ std::function<void()> AddWait();
 #define DEV_FUNC true
 #define REL_FUNC false
 
-// All Sheep functions must return a value (this is just b/c of C++ Value class usage).
+// All Sheep functions must return a value (this is just b/c the generic function always stores a return value).
 // So, just do a special/dummy define for any "void" Sheep function to return.
 #define shpvoid int
 
 // Macros that register functions of various argument lengths with the system.
-// Creates a function with same name as the actual function, but which uses generic "Value" args and return type.
+// Creates a function with same name as the actual function, but which takes generic Sheep values as args.
 // The generic function just calls the real function with correct argument types.
 
-// Also registers an entry in the function map with a pointer to the "generic function".
-// Flow is: Look Up in Map -> Calls Generic Function -> Calls Actual Function
-#define RegFunc0(name, ret, waitable, dev)          					\
-    Value name(const Value& x1) {                   					\
-        return name();                              					\
-    }                                               					\
-    struct name##_ {                                					\
-        name##_() {                                 					\
-            GetSysFuncs().map0[#name]=&name;                            \
-            AddSysFunc(#name, ret##_TYPE, { }, waitable, dev); 		    \
-        }                                           					\
+// Also registers the SysFunc with a pointer to the "generic function".
+// A SheepScript looks up each SysFunc it uses once, when loaded. After that, each call is direct.
+// Flow is: Generic Function (via pointer) -> Calls Actual Function
+#define RegFunc0(name, ret, waitable, dev)                              \
+    void name(const SheepValue*, SysFuncResult& result) {               \
+        result.Set(name());                                             \
+    }                                                                   \
+    struct name##_ {                                                    \
+        name##_() {                                                     \
+            AddSysFunc(#name, ret##_TYPE, { }, { }, waitable, dev, &name); \
+        }                                                               \
     } name##_instance
 
-#define RegFunc1(name, ret, t1, waitable, dev)                     		\
-    Value name(const Value& x1) {                   					\
-        return name(x1.To<t1>());                   					\
-    }                                               					\
-    struct name##_ {                                					\
-        name##_() {                                 					\
-            GetSysFuncs().map1[#name]=&name;                      		\
-            AddSysFunc(#name, ret##_TYPE, { t1##_TYPE }, waitable, dev);			\
-        }                                           					\
+#define RegFunc1(name, ret, t1, waitable, dev)                          \
+    void name(const SheepValue* args, SysFuncResult& result) {          \
+        result.Set(name(GetSysFuncArg<t1>(args[0])));                   \
+    }                                                                   \
+    struct name##_ {                                                    \
+        name##_() {                                                     \
+            AddSysFunc(#name, ret##_TYPE, { t1##_TYPE }, { t1##_SYMBOL }, waitable, dev, &name); \
+        }                                                               \
     } name##_instance
 
 #define RegFunc2(name, ret, t1, t2, waitable, dev)                      \
-    Value name(const Value& x1, const Value& x2) {          			\
-        return name(x1.To<t1>(), x2.To<t2>());              			\
-    }                                                       			\
-    struct name##_ {                                        			\
-        name##_() {                                         			\
-            GetSysFuncs().map2[#name]=&name;                            \
-            AddSysFunc(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE }, waitable, dev); \
-        }                                                   			\
+    void name(const SheepValue* args, SysFuncResult& result) {          \
+        result.Set(name(GetSysFuncArg<t1>(args[0]), GetSysFuncArg<t2>(args[1]))); \
+    }                                                                   \
+    struct name##_ {                                                    \
+        name##_() {                                                     \
+            AddSysFunc(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE }, { t1##_SYMBOL, t2##_SYMBOL }, waitable, dev, &name); \
+        }                                                               \
     } name##_instance
 
 #define RegFunc3(name, ret, t1, t2, t3, waitable, dev)                  \
-    Value name(const Value& x1, const Value& x2, const Value& x3) {     \
-        return name(x1.To<t1>(), x2.To<t2>(), x3.To<t3>());             \
-    }                                                       			\
-    struct name##_ {                                        			\
-        name##_() {                                         			\
-            GetSysFuncs().map3[#name]=&name;                            \
-            AddSysFunc(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE, t3##_TYPE }, waitable, dev); \
-        }                                                   			\
+    void name(const SheepValue* args, SysFuncResult& result) {          \
+        result.Set(name(GetSysFuncArg<t1>(args[0]), GetSysFuncArg<t2>(args[1]), GetSysFuncArg<t3>(args[2]))); \
+    }                                                                   \
+    struct name##_ {                                                    \
+        name##_() {                                                     \
+            AddSysFunc(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE, t3##_TYPE }, { t1##_SYMBOL, t2##_SYMBOL, t3##_SYMBOL }, waitable, dev, &name); \
+        }                                                               \
     } name##_instance
 
 #define RegFunc4(name, ret, t1, t2, t3, t4, waitable, dev)              \
-    Value name(const Value& x1, const Value& x2, const Value& x3, const Value& x4) { \
-        return name(x1.To<t1>(), x2.To<t2>(), x3.To<t3>(), x4.To<t4>()); \
-    }                                                       			\
-    struct name##_ {                                        			\
-        name##_() {                                         			\
-            GetSysFuncs().map4[#name]=&name;                            \
-            AddSysFunc(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE, t3##_TYPE, t4##_TYPE }, waitable, dev); \
-        }                                                   			\
+    void name(const SheepValue* args, SysFuncResult& result) {          \
+        result.Set(name(GetSysFuncArg<t1>(args[0]), GetSysFuncArg<t2>(args[1]), GetSysFuncArg<t3>(args[2]), GetSysFuncArg<t4>(args[3]))); \
+    }                                                                   \
+    struct name##_ {                                                    \
+        name##_() {                                                     \
+            AddSysFunc(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE, t3##_TYPE, t4##_TYPE }, { t1##_SYMBOL, t2##_SYMBOL, t3##_SYMBOL, t4##_SYMBOL }, waitable, dev, &name); \
+        }                                                               \
     } name##_instance
 
 #define RegFunc5(name, ret, t1, t2, t3, t4, t5, waitable, dev)          \
-    Value name(const Value& x1, const Value& x2, const Value& x3, const Value& x4, const Value& x5) { \
-        return name(x1.To<t1>(), x2.To<t2>(), x3.To<t3>(), x4.To<t4>(), x5.To<t5>()); \
-    }                                                       			\
-    struct name##_ {                                        			\
-        name##_() {                                         			\
-            GetSysFuncs().map5[#name]=&name;                            \
-            AddSysFunc(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE, t3##_TYPE, t4##_TYPE, t5##_TYPE }, waitable, dev); \
-        }                                                   			\
+    void name(const SheepValue* args, SysFuncResult& result) {          \
+        result.Set(name(GetSysFuncArg<t1>(args[0]), GetSysFuncArg<t2>(args[1]), GetSysFuncArg<t3>(args[2]), GetSysFuncArg<t4>(args[3]), GetSysFuncArg<t5>(args[4]))); \
+    }                                                                   \
+    struct name##_ {                                                    \
+        name##_() {                                                     \
+            AddSysFunc(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE, t3##_TYPE, t4##_TYPE, t5##_TYPE }, { t1##_SYMBOL, t2##_SYMBOL, t3##_SYMBOL, t4##_SYMBOL, t5##_SYMBOL }, waitable, dev, &name); \
+        }                                                               \
     } name##_instance
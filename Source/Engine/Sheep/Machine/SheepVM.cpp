@@ -13,6 +13,17 @@
 //#define SHEEP_DEBUG
 //#define SHEEP_DEBUG_SYS_CALLS
 
+// Interprets bytecode directly, rather than running decoded ops. Implied by SHEEP_DEBUG, since only the bytecode interpreter logs instructions.
+//#define SHEEP_INTERPRET_BYTECODE
+#if defined(SHEEP_DEBUG) && !defined(SHEEP_INTERPRET_BYTECODE)
+#define SHEEP_INTERPRET_BYTECODE
+#endif
+
+// Computed goto is a GCC/Clang extension.
+#if defined(__GNUC__) || defined(__clang__)
+#define SHEEP_COMPUTED_GOTO
+#endif
+
 std::string SheepInstance::GetName()
 {
     if(mSheepScript != nullptr)
@@ -336,6 +347,9 @@ SheepInstance* SheepVM::GetInstance(SheepScript* script)
     // Create NEW variables for assignment during execution.
     // This is VERY important so the SheepScript has correct vars with correct initial values.
     context->mVariables = script->GetVariables();
+
+    // Nothing refers to string results from the instance's previous use anymore.
+    context->mSysFuncStrings.clear();
     return context;
 }
 
@@ -389,65 +403,34 @@ NotifyLink* SheepVM::GetNotifyLink()
     return toUse;
 }
 
-Value SheepVM::CallSysFunc(SheepThread* thread, SysFuncImport* sysImport)
+void SheepVM::CallSysFunc(SheepThread* thread, SysFunc* sysFunc)
 {
-    // Retrieve system function declaration for the system function import.
-    // We need the full declaration to know whether this is a waitable function!
-    SysFunc* sysFunc = GetSysFunc(sysImport);
+    // Number on top of stack is argument count. The arguments are below it, in order.
+    int argCount = thread->mStack.Pop().intValue;
+    const SheepValue* args = thread->mStack.PeekTop(argCount);
+
+    // Pop the arguments before calling, in case the call does something to the stack (like stopping this thread).
+    // The values stay in place in the stack's memory, and they're converted to the expected types before the function body runs.
+    thread->mStack.Pop(argCount);
+
+    // The script may use a function that doesn't exist. The arguments are still popped, and the result defaults to zero ("0" as a string).
     if(sysFunc == nullptr)
     {
-        std::cout << "Sheep uses undeclared function " << sysImport->name << std::endl;
-        return Value(0);
+        mSysFuncResult.stringValue = "0";
+        mSysFuncResult.Set(0);
+        return;
     }
 
-    // Number on top of stack is argument count.
     // Make sure it matches the argument count from the system function declaration.
-    int argCount = thread->mStack.Pop().intValue;
     assert(argCount == sysFunc->argumentTypes.size());
 
-    // Retrieve the arguments, of the expected types, from the stack.
-    std::vector<Value> args;
-    for(int i = 0; i < argCount; i++)
-    {
-        SheepValue& sheepValue = thread->mStack.Peek(argCount - 1 - i);
-        int argType = sysFunc->argumentTypes[i];
-        switch(argType)
-        {
-        case 1:
-            args.push_back(sheepValue.GetInt());
-            break;
-        case 2:
-            args.push_back(sheepValue.GetFloat());
-            break;
-        case 3:
-            args.push_back(sheepValue.GetString());
-            break;
-        default:
-            std::cout << "Invalid arg type: " << argType << std::endl;
-            break;
-        }
-    }
-    thread->mStack.Pop(argCount);
-
     #if defined(SHEEP_DEBUG_SYS_CALLS)
     {
         // Pretty useful for seeing the function that was called output to the console.
         std::cout << "SysFunc " << sysFunc->name << "(";
         for(int i = 0; i < argCount; i++)
         {
-            switch(sysFunc->argumentTypes[i])
-            {
-            case 1:
-                std::cout << args[i].To<int>();
-                break;
-            case 2:
-                std::cout << args[i].To<float>();
-                break;
-            case 3:
-                std::cout << args[i].To<std::string>();
-                break;
-            }
-
+            std::cout << args[i].GetString();
             if(i < argCount - 1)
             {
                 std::cout << ", ";
@@ -457,35 +440,8 @@ Value SheepVM::CallSysFunc(SheepThread* thread, SysFuncImport* sysImport)
     }
     #endif
 
-    // Based on argument count, call the appropriate function variant.
-    Value v = Value(0);
-    switch(argCount)
-    {
-    case 0:
-        v = ::CallSysFunc(sysFunc->name);
-        break;
-    case 1:
-        v = ::CallSysFunc(sysFunc->name, args[0]);
-        break;
-    case 2:
-        v = ::CallSysFunc(sysFunc->name, args[0], args[1]);
-        break;
-    case 3:
-        v = ::CallSysFunc(sysFunc->name, args[0], args[1], args[2]);
-        break;
-    case 4:
-        v = ::CallSysFunc(sysFunc->name, args[0], args[1], args[2], args[3]);
-        break;
-    case 5:
-        v = ::CallSysFunc(sysFunc->name, args[0], args[1], args[2], args[3], args[4]);
-        break;
-    case 6:
-        v = ::CallSysFunc(sysFunc->name, args[0], args[1], args[2], args[3], args[4], args[5]);
-        break;
-    default:
-        std::cout << "SheepVM: Unimplemented arg count: " << argCount << std::endl;
-        break;
-    }
+    // Call the function directly, passing the arguments straight from the stack.
+    sysFunc->invoker(args, mSysFuncResult);
 
     // Output a general execution exception if we encountered a problem in the sys func call.
     if(mExecutionError)
@@ -493,9 +449,50 @@ Value SheepVM::CallSysFunc(SheepThread* thread, SysFuncImport* sysImport)
         gReportManager.Log("Error", StringUtil::Format("An error occurred while executing %s", thread->GetName().c_str()));
         mExecutionError = false;
     }
+}
 
-    // Return result of sys func call.
-    return v;
+const char* SheepVM::GetSysFuncStringResult(SheepThread* thread)
+{
+    // The result's own buffer is overwritten by the next SysFunc call, so copy the string somewhere that lasts.
+    return thread->mContext->mSysFuncStrings.insert(mSysFuncResult.stringValue).first->c_str();
+}
+
+void SheepVM::ReleaseSysFuncStrings(SheepThread* exitingThread)
+{
+    // While other threads are still using the instance, they (or the instance's variables) may refer to any of its strings.
+    SheepInstance* instance = exitingThread->mContext;
+    if(instance->mReferenceCount > 0 || instance->mSysFuncStrings.empty()) { return; }
+
+    // Otherwise, only the exiting thread's stack can still refer to them, since its result may be read after it exits (see Evaluate).
+    // Strings on that stack are kept until the instance is reused. Everything else is released.
+    SheepStack& stack = exitingThread->mStack;
+    for(auto it = instance->mSysFuncStrings.begin(); it != instance->mSysFuncStrings.end();)
+    {
+        bool onStack = false;
+        for(int i = 0; i < stack.Size() && !onStack; ++i)
+        {
+            const SheepValue& value = stack.Peek(i);
+            onStack = value.type == SheepValueType::String && value.stringValue == it->c_str();
+        }
+        if(onStack)
+        {
+            ++it;
+        }
+        else
+        {
+            it = instance->mSysFuncStrings.erase(it);
+        }
+    }
+}
+
+size_t SheepVM::GetSysFuncStringCount() const
+{
+    size_t count = 0;
+    for(SheepInstance* instance : mSheepInstances)
+    {
+        count += instance->mSysFuncStrings.size();
+    }
+    return count;
 }
 
 SheepThread* SheepVM::CreateThread(SheepInstance* instance, int bytecodeOffset, const std::string& functionName, std::function<void()> finishCallback, const std::string& tag)
@@ -561,6 +558,54 @@ void SheepVM::ContinueExecution(SheepThread* thread)
         gReportManager.Log("SheepMachine", "Sheep " + thread->GetName() + " released at line -1");
     }
 
+    // Run the script's decoded ops, if possible. Otherwise, interpret the bytecode directly.
+    // The bytecode interpreter is also useful for debugging, since it can log each instruction as it executes.
+    #if !defined(SHEEP_INTERPRET_BYTECODE)
+    int opIndex = mInterpretBytecode ? -1 : thread->mContext->mSheepScript->GetOpIndex(thread->mCodeOffset);
+    if(opIndex >= 0)
+    {
+        ExecuteOps(thread, opIndex);
+    }
+    else
+    #endif
+    if(!ExecuteBytecode(thread))
+    {
+        return;
+    }
+
+    // If thread is no longer running, notify anyone who was waiting for the thread to finish.
+    // If we get here and the thread IS running, it means the thread was blocked due to a wait!
+    if(!thread->mRunning)
+    {
+        gReportManager.Log("SheepMachine", "Sheep " + thread->GetName() + " is exiting");
+
+        // Thread is no longer using execution context.
+        thread->mContext->mReferenceCount--;
+
+        // SysFunc string results used by the thread may no longer be needed.
+        ReleaseSysFuncStrings(thread);
+
+        // Call my wait callback - someone might have been waiting for this thread to finish.
+        if(thread->mWaitCallback)
+        {
+            thread->mWaitCallback();
+        }
+    }
+    else if(thread->mInWaitBlock)
+    {
+        gReportManager.Log("SheepMachine", "Sheep " + thread->GetName() + " is blocked at line -1");
+    }
+    else
+    {
+        gReportManager.Log("SheepMachine", "Sheep " + thread->GetName() + " is in some weird unexpected state!");
+    }
+
+    // Restore previously executing thread.
+    mCurrentThread = prevThread;
+}
+
+bool SheepVM::ExecuteBytecode(SheepThread* thread)
+{
     // Get instance/script we'll be using.
     SheepInstance* instance = thread->mContext;
     SheepScript* script = instance->mSheepScript;
@@ -571,7 +616,7 @@ void SheepVM::ContinueExecution(SheepThread* thread)
 
     // Create reader for the bytecode.
     BinaryReader reader(bytecode, bytecodeLength);
-    if(!reader.CanRead()) { return; }
+    if(!reader.CanRead()) { return false; }
 
     // Skip ahead to desired offset.
     reader.Skip(thread->mCodeOffset);
@@ -610,87 +655,67 @@ void SheepVM::ContinueExecution(SheepThread* thread)
             case SheepInstruction::CallSysFunctionV:
             {
                 int functionIndex = reader.ReadInt();
-                SysFuncImport* sysFunc = script->GetSysImport(functionIndex);
-                if(sysFunc == nullptr)
-                {
-                    std::cout << "Invalid function index " << functionIndex << std::endl;
-                    break;
-                }
+                SysFunc* sysFunc = script->GetSysFunc(functionIndex);
 
                 #ifdef SHEEP_DEBUG
-                std::cout << "CallSysFuncV " << sysFunc->name << std::endl;
+                std::cout << "CallSysFuncV " << script->GetSysImport(functionIndex)->name << std::endl;
                 #endif
 
                 // Execute the system function.
-                Value value = CallSysFunc(thread, sysFunc);
+                CallSysFunc(thread, sysFunc);
 
                 // Though this is void return, we still push type of "shpvoid" onto stack.
                 // The compiler generates an extra "Pop" instruction after a CallSysFunctionV.
                 // This matches how the original game's compiler generated instructions!
-                thread->mStack.PushInt(value.To<shpvoid>());
+                thread->mStack.PushInt(mSysFuncResult.value.GetInt());
                 break;
             }
             case SheepInstruction::CallSysFunctionI:
             {
                 int functionIndex = reader.ReadInt();
-                SysFuncImport* sysFunc = script->GetSysImport(functionIndex);
-                if(sysFunc == nullptr)
-                {
-                    std::cout << "Invalid function index " << functionIndex << std::endl;
-                    break;
-                }
+                SysFunc* sysFunc = script->GetSysFunc(functionIndex);
 
                 #ifdef SHEEP_DEBUG
-                std::cout << "CallSysFuncI " << sysFunc->name << std::endl;
+                std::cout << "CallSysFuncI " << script->GetSysImport(functionIndex)->name << std::endl;
                 #endif
 
                 // Execute the system function.
-                Value value = CallSysFunc(thread, sysFunc);
+                CallSysFunc(thread, sysFunc);
 
                 // Push the int result onto the stack.
-                thread->mStack.PushInt(value.To<int>());
+                thread->mStack.PushInt(mSysFuncResult.value.GetInt());
                 break;
             }
             case SheepInstruction::CallSysFunctionF:
             {
                 int functionIndex = reader.ReadInt();
-                SysFuncImport* sysFunc = script->GetSysImport(functionIndex);
-                if(sysFunc == nullptr)
-                {
-                    std::cout << "Invalid function index " << functionIndex << std::endl;
-                    break;
-                }
+                SysFunc* sysFunc = script->GetSysFunc(functionIndex);
 
                 #ifdef SHEEP_DEBUG
-                std::cout << "CallSysFuncF " << sysFunc->name << std::endl;
+                std::cout << "CallSysFuncF " << script->GetSysImport(functionIndex)->name << std::endl;
                 #endif
 
                 // Execute the system function.
-                Value value = CallSysFunc(thread, sysFunc);
+                CallSysFunc(thread, sysFunc);
 
                 // Push the float result onto the stack.
-                thread->mStack.PushFloat(value.To<float>());
+                thread->mStack.PushFloat(mSysFuncResult.value.GetFloat());
                 break;
             }
             case SheepInstruction::CallSysFunctionS:
             {
                 int functionIndex = reader.ReadInt();
-                SysFuncImport* sysFunc = script->GetSysImport(functionIndex);
-                if(sysFunc == nullptr)
-                {
-                    std::cout << "Invalid function index " << functionIndex << std::endl;
-                    break;
-                }
+                SysFunc* sysFunc = script->GetSysFunc(functionIndex);
 
                 #ifdef SHEEP_DEBUG
-                std::cout << "CallSysFuncS " << sysFunc->name << std::endl;
+                std::cout << "CallSysFuncS " << script->GetSysImport(functionIndex)->name << std::endl;
                 #endif
 
                 // Execute the system function.
-                Value value = CallSysFunc(thread, sysFunc);
+                CallSysFunc(thread, sysFunc);
 
                 // Push the string result onto the stack.
-                thread->mStack.PushString(value.To<std::string>().c_str()); //TODO: Seems like this could cause problems? Where is value's string coming from? What if it is deallocated???
+                thread->mStack.PushString(GetSysFuncStringResult(thread));
                 break;
             }
             case SheepInstruction::Branch:
@@ -1305,31 +1330,378 @@ void SheepVM::ContinueExecution(SheepThread* thread)
     {
         thread->mRunning = false;
     }
+    return true;
+}
 
-    // If thread is no longer running, notify anyone who was waiting for the thread to finish.
-    // If we get here and the thread IS running, it means the thread was blocked due to a wait!
-    if(!thread->mRunning)
+void SheepVM::ExecuteOps(SheepThread* thread, int opIndex)
+{
+    SheepInstance* instance = thread->mContext;
+    SheepScript* script = instance->mSheepScript;
+    SheepStack& stack = thread->mStack;
+    std::vector<SheepValue>& variables = instance->mVariables;
+
+    // Ops were validated when decoded, so operands don't need to be checked again here.
+    // And the last op is always "End", so there's always a next op.
+    const SheepOp* ops = script->GetOps().data();
+    const SheepOp* op = ops + opIndex;
+
+    // Where supported, use "computed goto" to dispatch ops: each op jumps directly to the next op's code.
+    // This is faster than a switch statement, which must jump back to a single dispatch point (and do a range check) for each op.
+    #if defined(SHEEP_COMPUTED_GOTO)
+    static void* const kOpLabels[] = {
+        &&Op_SitnSpin, &&Op_Yield,
+        &&Op_CallSysFunctionV, &&Op_CallSysFunctionI, &&Op_CallSysFunctionF, &&Op_CallSysFunctionS,
+        &&Op_Branch, &&Op_BranchIfZero, &&Op_BeginWait, &&Op_EndWait, &&Op_ReturnV,
+        &&Op_StoreI, &&Op_StoreF, &&Op_StoreS, &&Op_LoadI, &&Op_LoadF, &&Op_LoadS,
+        &&Op_PushI, &&Op_PushF, &&Op_PushS, &&Op_Pop,
+        &&Op_AddI, &&Op_AddF, &&Op_SubtractI, &&Op_SubtractF, &&Op_MultiplyI, &&Op_MultiplyF, &&Op_DivideI, &&Op_DivideF,
+        &&Op_NegateI, &&Op_NegateF,
+        &&Op_IsEqualI, &&Op_IsEqualF, &&Op_IsNotEqualI, &&Op_IsNotEqualF, &&Op_IsGreaterI, &&Op_IsGreaterF,
+        &&Op_IsLessI, &&Op_IsLessF, &&Op_IsGreaterEqualI, &&Op_IsGreaterEqualF, &&Op_IsLessEqualI, &&Op_IsLessEqualF,
+        &&Op_IToF, &&Op_FToI, &&Op_Modulo, &&Op_And, &&Op_Or, &&Op_Not, &&Op_GetString,
+        &&Op_PushString, &&Op_StoreConstI, &&Op_IsEqualVarI, &&Op_BranchIfZeroVarI, &&Op_BranchIfNotEqualVarI,
+        &&Op_End
+    };
+    static_assert(sizeof(kOpLabels) / sizeof(kOpLabels[0]) == static_cast<size_t>(SheepOpCode::Count), "Missing label for a Sheep op!");
+    #define SHEEP_OP(name) Op_##name:
+    #define SHEEP_NEXT() ++op; goto *kOpLabels[static_cast<int>(op->code)]
+    #define SHEEP_JUMP(index) op = ops + (index); goto *kOpLabels[static_cast<int>(op->code)]
+    goto *kOpLabels[static_cast<int>(op->code)];
+    #else
+    #define SHEEP_OP(name) case SheepOpCode::name:
+    #define SHEEP_NEXT() ++op; continue
+    #define SHEEP_JUMP(index) op = ops + (index); continue
+    while(true)
     {
-        gReportManager.Log("SheepMachine", "Sheep " + thread->GetName() + " is exiting");
+    switch(op->code)
+    {
+    #endif
 
-        // Thread is no longer using execution context.
-        thread->mContext->mReferenceCount--;
+    SHEEP_OP(SitnSpin)
+    {
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(Yield)
+    {
+        thread->mCodeOffset = (op + 1)->bytecodeOffset;
+        goto Stop;
+    }
+    SHEEP_OP(CallSysFunctionV)
+    {
+        // Same as bytecode: even void functions push a result, which the compiler pops.
+        CallSysFunc(thread, op->sysFunc);
+        stack.PushInt(mSysFuncResult.value.GetInt());
+        if(!thread->mRunning)
+        {
+            thread->mCodeOffset = (op + 1)->bytecodeOffset;
+            goto Stop;
+        }
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(CallSysFunctionI)
+    {
+        CallSysFunc(thread, op->sysFunc);
+        stack.PushInt(mSysFuncResult.value.GetInt());
+        if(!thread->mRunning)
+        {
+            thread->mCodeOffset = (op + 1)->bytecodeOffset;
+            goto Stop;
+        }
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(CallSysFunctionF)
+    {
+        CallSysFunc(thread, op->sysFunc);
+        stack.PushFloat(mSysFuncResult.value.GetFloat());
+        if(!thread->mRunning)
+        {
+            thread->mCodeOffset = (op + 1)->bytecodeOffset;
+            goto Stop;
+        }
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(CallSysFunctionS)
+    {
+        CallSysFunc(thread, op->sysFunc);
+        stack.PushString(GetSysFuncStringResult(thread));
+        if(!thread->mRunning)
+        {
+            thread->mCodeOffset = (op + 1)->bytecodeOffset;
+            goto Stop;
+        }
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(Branch)
+    {
+        SHEEP_JUMP(op->index);
+    }
+    SHEEP_OP(BranchIfZero)
+    {
+        if(stack.Pop().intValue == 0)
+        {
+            SHEEP_JUMP(op->index);
+        }
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(BeginWait)
+    {
+        thread->mInWaitBlock = true;
+        thread->mWaitBlockCodeOffset = op->bytecodeOffset;
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(EndWait)
+    {
+        // If waiting on one or more WAIT-able functions, stop execution until enough wait callbacks are received.
+        if(thread->mWaitCounter > 0)
+        {
+            thread->mBlocked = true;
+            thread->mCodeOffset = (op + 1)->bytecodeOffset;
+            goto Stop;
+        }
+        thread->mInWaitBlock = false;
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(ReturnV)
+    {
+        thread->mRunning = false;
+        thread->mCodeOffset = (op + 1)->bytecodeOffset;
+        goto Stop;
+    }
+    SHEEP_OP(StoreI)
+    {
+        assert(variables[op->index].type == SheepValueType::Int);
+        variables[op->index].intValue = stack.Pop().intValue;
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(StoreF)
+    {
+        assert(variables[op->index].type == SheepValueType::Float);
+        variables[op->index].floatValue = stack.Pop().floatValue;
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(StoreS)
+    {
+        assert(variables[op->index].type == SheepValueType::String);
+        variables[op->index].stringValue = stack.Pop().stringValue;
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(LoadI)
+    {
+        assert(variables[op->index].type == SheepValueType::Int);
+        stack.PushInt(variables[op->index].intValue);
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(LoadF)
+    {
+        assert(variables[op->index].type == SheepValueType::Float);
+        stack.PushFloat(variables[op->index].floatValue);
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(LoadS)
+    {
+        assert(variables[op->index].type == SheepValueType::String);
+        stack.PushString(variables[op->index].stringValue);
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(PushI)
+    {
+        stack.PushInt(op->intValue);
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(PushF)
+    {
+        stack.PushFloat(op->floatValue);
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(PushS)
+    {
+        stack.PushStringOffset(op->intValue);
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(Pop)
+    {
+        stack.Pop(1);
+        SHEEP_NEXT();
+    }
 
-        // Call my wait callback - someone might have been waiting for this thread to finish.
-        if(thread->mWaitCallback)
+    // Binary operators: pop two values, push the result.
+    #define SHEEP_BINARY_OP_I(name, expression)             \
+    SHEEP_OP(name)                                          \
+    {                                                       \
+        assert(stack.Size() >= 2);                          \
+        int int1 = stack.Peek(1).intValue;                  \
+        int int2 = stack.Peek(0).intValue;                  \
+        stack.Pop(2);                                       \
+        stack.PushInt(expression);                          \
+        SHEEP_NEXT();                                       \
+    }
+    #define SHEEP_BINARY_OP_F(name, pushFunc, expression)   \
+    SHEEP_OP(name)                                          \
+    {                                                       \
+        assert(stack.Size() >= 2);                          \
+        float float1 = stack.Peek(1).floatValue;            \
+        float float2 = stack.Peek(0).floatValue;            \
+        stack.Pop(2);                                       \
+        stack.pushFunc(expression);                         \
+        SHEEP_NEXT();                                       \
+    }
+    SHEEP_BINARY_OP_I(AddI, int1 + int2)
+    SHEEP_BINARY_OP_F(AddF, PushFloat, float1 + float2)
+    SHEEP_BINARY_OP_I(SubtractI, int1 - int2)
+    SHEEP_BINARY_OP_F(SubtractF, PushFloat, float1 - float2)
+    SHEEP_BINARY_OP_I(MultiplyI, int1 * int2)
+    SHEEP_BINARY_OP_F(MultiplyF, PushFloat, float1 * float2)
+    SHEEP_BINARY_OP_I(IsEqualI, int1 == int2 ? 1 : 0)
+    SHEEP_BINARY_OP_F(IsEqualF, PushInt, Math::AreEqual(float1, float2) ? 1 : 0)
+    SHEEP_BINARY_OP_I(IsNotEqualI, int1 != int2 ? 1 : 0)
+    SHEEP_BINARY_OP_F(IsNotEqualF, PushInt, !Math::AreEqual(float1, float2) ? 1 : 0)
+    SHEEP_BINARY_OP_I(IsGreaterI, int1 > int2 ? 1 : 0)
+    SHEEP_BINARY_OP_F(IsGreaterF, PushInt, float1 > float2 ? 1 : 0)
+    SHEEP_BINARY_OP_I(IsLessI, int1 < int2 ? 1 : 0)
+    SHEEP_BINARY_OP_F(IsLessF, PushInt, float1 < float2 ? 1 : 0)
+    SHEEP_BINARY_OP_I(IsGreaterEqualI, int1 >= int2 ? 1 : 0)
+    SHEEP_BINARY_OP_F(IsGreaterEqualF, PushInt, float1 >= float2 ? 1 : 0)
+    SHEEP_BINARY_OP_I(IsLessEqualI, int1 <= int2 ? 1 : 0)
+    SHEEP_BINARY_OP_F(IsLessEqualF, PushInt, float1 <= float2 ? 1 : 0)
+    SHEEP_BINARY_OP_I(Modulo, int1 % int2)
+    SHEEP_BINARY_OP_I(And, int1 && int2 ? 1 : 0)
+    SHEEP_BINARY_OP_I(Or, int1 || int2 ? 1 : 0)
+    #undef SHEEP_BINARY_OP_I
+    #undef SHEEP_BINARY_OP_F
+
+    SHEEP_OP(DivideI)
+    {
+        assert(stack.Size() >= 2);
+        int int1 = stack.Peek(1).intValue;
+        int int2 = stack.Peek(0).intValue;
+        stack.Pop(2);
+
+        // If dividing by zero, we'll spit out an error and just put a zero on the stack.
+        if(int2 != 0)
         {
-            thread->mWaitCallback();
+            stack.PushInt(int1 / int2);
         }
+        else
+        {
+            std::cout << "Divide by zero!" << std::endl;
+            stack.PushInt(0);
+        }
+        SHEEP_NEXT();
     }
-    else if(thread->mInWaitBlock)
+    SHEEP_OP(DivideF)
     {
-        gReportManager.Log("SheepMachine", "Sheep " + thread->GetName() + " is blocked at line -1");
+        assert(stack.Size() >= 2);
+        float float1 = stack.Peek(1).floatValue;
+        float float2 = stack.Peek(0).floatValue;
+        stack.Pop(2);
+
+        // If dividing by zero, we'll spit out an error and just put a zero on the stack.
+        if(!Math::AreEqual(float2, 0.0f))
+        {
+            stack.PushFloat(float1 / float2);
+        }
+        else
+        {
+            std::cout << "Divide by zero!" << std::endl;
+            stack.PushFloat(0.0f);
+        }
+        SHEEP_NEXT();
     }
-    else
+    SHEEP_OP(NegateI)
     {
-        gReportManager.Log("SheepMachine", "Sheep " + thread->GetName() + " is in some weird unexpected state!");
+        stack.Peek(0).intValue *= -1;
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(NegateF)
+    {
+        stack.Peek(0).floatValue *= -1.0f;
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(IToF)
+    {
+        SheepValue& value = stack.Peek(op->index);
+        value.floatValue = value.intValue;
+        value.type = SheepValueType::Float;
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(FToI)
+    {
+        SheepValue& value = stack.Peek(op->index);
+        value.intValue = value.floatValue;
+        value.type = SheepValueType::Int;
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(Not)
+    {
+        stack.Peek(0).intValue = (stack.Peek(0).intValue == 0 ? 1 : 0);
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(GetString)
+    {
+        std::string* stringPtr = script->GetStringConst(stack.Pop().intValue);
+        if(stringPtr != nullptr)
+        {
+            stack.PushString(stringPtr->c_str());
+        }
+        SHEEP_NEXT();
     }
 
-    // Restore previously executing thread.
-    mCurrentThread = prevThread;
+    // Fused ops (see SheepOp.h).
+    SHEEP_OP(PushString)
+    {
+        stack.PushString(op->stringValue, op->index);
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(StoreConstI)
+    {
+        assert(variables[op->index].type == SheepValueType::Int);
+        variables[op->index].intValue = op->intValue;
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(IsEqualVarI)
+    {
+        stack.PushInt(variables[op->index].intValue == op->intValue ? 1 : 0);
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(BranchIfZeroVarI)
+    {
+        if(variables[op->index].intValue == 0)
+        {
+            SHEEP_JUMP(op->branchIndex);
+        }
+        SHEEP_NEXT();
+    }
+    SHEEP_OP(BranchIfNotEqualVarI)
+    {
+        if(variables[op->index].intValue != op->intValue)
+        {
+            SHEEP_JUMP(op->branchIndex);
+        }
+        SHEEP_NEXT();
+    }
+
+    SHEEP_OP(End)
+    {
+        // Reached the end of the bytecode, so the thread is done.
+        thread->mRunning = false;
+        thread->mCodeOffset = op->bytecodeOffset;
+        goto Stop;
+    }
+
+    #if !defined(SHEEP_COMPUTED_GOTO)
+    default:
+    {
+        assert(false);
+        thread->mRunning = false;
+        goto Stop;
+    }
+    }
+    }
+    #endif
+    #undef SHEEP_OP
+    #undef SHEEP_NEXT
+    #undef SHEEP_JUMP
+
+Stop:
+    return;
 }
@@ -6,17 +6,17 @@
 #pragma once
 #include <functional>
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include <iostream>
 
 #include "Profiler.h"
 #include "SheepThread.h"
+#include "SheepSysFunc.h"
 #include "SheepValue.h"
-#include "Value.h"
 
 class PersistState;
 class SheepScript;
-struct SysFuncImport;
 
 // GK3 calls these "Object Code" instances.
 // Basically, a loaded instance of a sheep script with variables and such.
@@ -36,6 +36,12 @@ struct SheepInstance
     // For example, if one function calls another in the same SheepScript.
     int mReferenceCount = 0;
 
+    // String results of SysFunc calls made by threads using this instance.
+    // Strings are pushed onto the stack (and stored in variables) as pointers, so each result needs stable storage.
+    // Each distinct string is stored once, and set nodes never move, so pointers stay valid until the strings are released.
+    // Only this instance's threads and variables can refer to these, so they're released once no thread is using the instance.
+    std::unordered_set<std::string> mSysFuncStrings;
+
     std::string GetName();
 };
 
@@ -133,10 +139,17 @@ public:
     void StopExecution(const std::string& tag);
     void FlagExecutionError() { mExecutionError = true; }
 
+    // If true, scripts are run by interpreting bytecode, rather than by running decoded ops.
+    // Both must give the same results; the decoded ops are just faster.
+    void SetInterpretBytecode(bool interpretBytecode) { mInterpretBytecode = interpretBytecode; }
+
     SheepThread* GetCurrentThread() const { return mCurrentThread; }
     bool IsAnyThreadRunning() const;
     bool IsThreadRunning(SheepThreadId id) const;
 
+    // Number of SysFunc string results being kept alive, for debugging.
+    size_t GetSysFuncStringCount() const;
+
     void OnPersist(PersistState& ps);
 
 private:
@@ -159,13 +172,23 @@ private:
     // If true, the current Sheep thread has encountered an execution error.
     bool mExecutionError = false;
 
+    // If true, decoded ops are not used, even if the script has them.
+    bool mInterpretBytecode = false;
+
     SheepInstance* GetInstance(SheepScript* script);
     SheepThread* GetIdleThread();
     NotifyLink* GetNotifyLink();
 
-    Value CallSysFunc(SheepThread* thread, SysFuncImport* sysImport);
+    // Holds the result of the last SysFunc call.
+    SysFuncResult mSysFuncResult;
+
+    void CallSysFunc(SheepThread* thread, SysFunc* sysFunc);
+    const char* GetSysFuncStringResult(SheepThread* thread);
+    void ReleaseSysFuncStrings(SheepThread* exitingThread);
 
     SheepThread* CreateThread(SheepInstance* instance, int bytecodeOffset, const std::string& functionName, std::function<void()> finishCallback, const std::string& tag);
     SheepThread* StartExecution(SheepInstance* instance, int bytecodeOffset, const std::string& functionName, std::function<void()> finishCallback, const std::string& tag);
     void ContinueExecution(SheepThread* thread);
+    void ExecuteOps(SheepThread* thread, int opIndex);
+    bool ExecuteBytecode(SheepThread* thread);
 };
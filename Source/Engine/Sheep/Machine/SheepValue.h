@@ -17,6 +17,11 @@ enum class SheepValueType
 struct SheepValue
 {
     SheepValueType type = SheepValueType::Int;
+
+    // For a string constant passed as a symbol argument, the string's symbol (see SymbolTable.h), interned when the script was loaded.
+    // -1 for any other value - a SysFunc that needs a symbol must look it up by name in that case.
+    int symbol = -1;
+
     union
     {
         int intValue;
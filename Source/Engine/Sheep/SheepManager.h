@@ -30,11 +30,13 @@ public:
     // VM Manipulation
     void StopExecution(const std::string& tag) { mVirtualMachine.StopExecution(tag); }
     void FlagExecutionError() { mVirtualMachine.FlagExecutionError(); }
+    void SetInterpretBytecode(bool interpretBytecode) { mVirtualMachine.SetInterpretBytecode(interpretBytecode); }
 
     // VM State Queries
     SheepThread* GetCurrentThread() const { return mVirtualMachine.GetCurrentThread(); }
     bool IsAnyThreadRunning() const { return mVirtualMachine.IsAnyThreadRunning(); }
     bool IsThreadRunning(SheepThreadId threadId) const { return mVirtualMachine.IsThreadRunning(threadId); }
+    size_t GetSysFuncStringCount() const { return mVirtualMachine.GetSysFuncStringCount(); }
 
     void OnPersist(PersistState& ps);
 
@@ -9,6 +9,7 @@
 #include "SheepManager.h"
 #include "SheepScriptBuilder.h"
 #include "StringUtil.h"
+#include "SymbolTable.h"
 
 TYPEINFO_INIT(SheepScript, Asset, GENERATE_TYPE_ID)
 {
@@ -62,6 +63,8 @@ void SheepScript::Load(const SheepScriptBuilder& builder)
     mBytecodeLength = builder.GetBytecode().size();
     mBytecode = new char[mBytecodeLength];
     std::copy(builder.GetBytecode().begin(), builder.GetBytecode().end(), mBytecode);
+    ResolveSysFuncs();
+    DecodeOps();
 }
 
 SysFuncImport* SheepScript::GetSysImport(int index)
@@ -70,6 +73,467 @@ SysFuncImport* SheepScript::GetSysImport(int index)
     return &mSysImports[index];
 }
 
+void SheepScript::ResolveSysFuncs()
+{
+    // Look up each SysFunc once now, so executing the script can call them directly.
+    mSysFuncs.resize(mSysImports.size());
+    for(size_t i = 0; i < mSysImports.size(); ++i)
+    {
+        mSysFuncs[i] = ::GetSysFunc(&mSysImports[i]);
+        if(mSysFuncs[i] == nullptr)
+        {
+            std::cout << "Sheep " << GetName() << " uses undeclared function " << mSysImports[i].name << std::endl;
+        }
+    }
+}
+
+int SheepScript::GetOpIndex(int bytecodeOffset) const
+{
+    if(bytecodeOffset < 0 || bytecodeOffset >= static_cast<int>(mOpIndexes.size())) { return -1; }
+    return mOpIndexes[bytecodeOffset];
+}
+
+void SheepScript::DecodeOps()
+{
+    mOps.clear();
+    mOpIndexes.clear();
+    if(mBytecode == nullptr) { return; }
+
+    // Track bytecode offsets that execution can start at: function starts, branch targets, and places a thread can be resumed.
+    // Instructions at these offsets can't be fused into the previous instruction's op.
+    std::vector<bool> isEntryPoint(mBytecodeLength + 1, false);
+    isEntryPoint[0] = true;
+    for(auto& entry : mFunctions)
+    {
+        if(entry.second >= 0 && entry.second <= mBytecodeLength)
+        {
+            isEntryPoint[entry.second] = true;
+        }
+    }
+
+    // First, decode each instruction into its own op.
+    // For now, branch ops store the bytecode offset to branch to.
+    std::vector<SheepOp> instructionOps;
+    BinaryReader reader(mBytecode, mBytecodeLength);
+    while(true)
+    {
+        SheepOp op;
+        op.bytecodeOffset = static_cast<int>(reader.GetPosition());
+        uint8_t instruction = reader.ReadByte();
+        if(!reader.CanRead()) { break; }
+
+        switch(static_cast<SheepInstruction>(instruction))
+        {
+        case SheepInstruction::SitnSpin:
+        case SheepInstruction::DebugBreakpoint:
+            op.code = SheepOpCode::SitnSpin;
+            break;
+        case SheepInstruction::Yield:
+            op.code = SheepOpCode::Yield;
+            break;
+        case SheepInstruction::CallSysFunctionV:
+            op.code = SheepOpCode::CallSysFunctionV;
+            op.sysFunc = GetSysFunc(reader.ReadInt());
+            break;
+        case SheepInstruction::CallSysFunctionI:
+            op.code = SheepOpCode::CallSysFunctionI;
+            op.sysFunc = GetSysFunc(reader.ReadInt());
+            break;
+        case SheepInstruction::CallSysFunctionF:
+            op.code = SheepOpCode::CallSysFunctionF;
+            op.sysFunc = GetSysFunc(reader.ReadInt());
+            break;
+        case SheepInstruction::CallSysFunctionS:
+            op.code = SheepOpCode::CallSysFunctionS;
+            op.sysFunc = GetSysFunc(reader.ReadInt());
+            break;
+        case SheepInstruction::Branch:
+        case SheepInstruction::BranchGoto:
+            op.code = SheepOpCode::Branch;
+            op.index = reader.ReadInt();
+            break;
+        case SheepInstruction::BranchIfZero:
+            op.code = SheepOpCode::BranchIfZero;
+            op.index = reader.ReadInt();
+            break;
+        case SheepInstruction::BeginWait:
+            // When loading a save, threads resume at the start of a wait block.
+            op.code = SheepOpCode::BeginWait;
+            isEntryPoint[op.bytecodeOffset] = true;
+            break;
+        case SheepInstruction::EndWait:
+            op.code = SheepOpCode::EndWait;
+            break;
+        case SheepInstruction::ReturnV:
+            op.code = SheepOpCode::ReturnV;
+            break;
+        case SheepInstruction::StoreI:
+            op.code = SheepOpCode::StoreI;
+            op.index = reader.ReadInt();
+            break;
+        case SheepInstruction::StoreF:
+            op.code = SheepOpCode::StoreF;
+            op.index = reader.ReadInt();
+            break;
+        case SheepInstruction::StoreS:
+            op.code = SheepOpCode::StoreS;
+            op.index = reader.ReadInt();
+            break;
+        case SheepInstruction::LoadI:
+            op.code = SheepOpCode::LoadI;
+            op.index = reader.ReadInt();
+            break;
+        case SheepInstruction::LoadF:
+            op.code = SheepOpCode::LoadF;
+            op.index = reader.ReadInt();
+            break;
+        case SheepInstruction::LoadS:
+            op.code = SheepOpCode::LoadS;
+            op.index = reader.ReadInt();
+            break;
+        case SheepInstruction::PushI:
+            op.code = SheepOpCode::PushI;
+            op.intValue = reader.ReadInt();
+            break;
+        case SheepInstruction::PushF:
+            op.code = SheepOpCode::PushF;
+            op.floatValue = reader.ReadFloat();
+            break;
+        case SheepInstruction::PushS:
+            op.code = SheepOpCode::PushS;
+            op.intValue = reader.ReadInt();
+            break;
+        case SheepInstruction::Pop:             op.code = SheepOpCode::Pop; break;
+        case SheepInstruction::AddI:            op.code = SheepOpCode::AddI; break;
+        case SheepInstruction::AddF:            op.code = SheepOpCode::AddF; break;
+        case SheepInstruction::SubtractI:       op.code = SheepOpCode::SubtractI; break;
+        case SheepInstruction::SubtractF:       op.code = SheepOpCode::SubtractF; break;
+        case SheepInstruction::MultiplyI:       op.code = SheepOpCode::MultiplyI; break;
+        case SheepInstruction::MultiplyF:       op.code = SheepOpCode::MultiplyF; break;
+        case SheepInstruction::DivideI:         op.code = SheepOpCode::DivideI; break;
+        case SheepInstruction::DivideF:         op.code = SheepOpCode::DivideF; break;
+        case SheepInstruction::NegateI:         op.code = SheepOpCode::NegateI; break;
+        case SheepInstruction::NegateF:         op.code = SheepOpCode::NegateF; break;
+        case SheepInstruction::IsEqualI:        op.code = SheepOpCode::IsEqualI; break;
+        case SheepInstruction::IsEqualF:        op.code = SheepOpCode::IsEqualF; break;
+        case SheepInstruction::IsNotEqualI:     op.code = SheepOpCode::IsNotEqualI; break;
+        case SheepInstruction::IsNotEqualF:     op.code = SheepOpCode::IsNotEqualF; break;
+        case SheepInstruction::IsGreaterI:      op.code = SheepOpCode::IsGreaterI; break;
+        case SheepInstruction::IsGreaterF:      op.code = SheepOpCode::IsGreaterF; break;
+        case SheepInstruction::IsLessI:         op.code = SheepOpCode::IsLessI; break;
+        case SheepInstruction::IsLessF:         op.code = SheepOpCode::IsLessF; break;
+        case SheepInstruction::IsGreaterEqualI: op.code = SheepOpCode::IsGreaterEqualI; break;
+        case SheepInstruction::IsGreaterEqualF: op.code = SheepOpCode::IsGreaterEqualF; break;
+        case SheepInstruction::IsLessEqualI:    op.code = SheepOpCode::IsLessEqualI; break;
+        case SheepInstruction::IsLessEqualF:    op.code = SheepOpCode::IsLessEqualF; break;
+        case SheepInstruction::IToF:
+            op.code = SheepOpCode::IToF;
+            op.index = reader.ReadInt();
+            break;
+        case SheepInstruction::FToI:
+            op.code = SheepOpCode::FToI;
+            op.index = reader.ReadInt();
+            break;
+        case SheepInstruction::Modulo:          op.code = SheepOpCode::Modulo; break;
+        case SheepInstruction::And:             op.code = SheepOpCode::And; break;
+        case SheepInstruction::Or:              op.code = SheepOpCode::Or; break;
+        case SheepInstruction::Not:             op.code = SheepOpCode::Not; break;
+        case SheepInstruction::GetString:       op.code = SheepOpCode::GetString; break;
+        default:
+            // The VM will interpret the bytecode directly, which handles unknown instructions.
+            std::cout << "Sheep " << GetName() << " has unknown instruction " << static_cast<int>(instruction) << " - it won't be decoded." << std::endl;
+            return;
+        }
+
+        // Make sure operands were fully read.
+        if(!reader.CanRead())
+        {
+            std::cout << "Sheep " << GetName() << " has a truncated instruction - it won't be decoded." << std::endl;
+            return;
+        }
+
+        // Variable indexes must be valid.
+        if(op.code >= SheepOpCode::StoreI && op.code <= SheepOpCode::LoadS &&
+           (op.index < 0 || op.index >= static_cast<int>(mVariables.size())))
+        {
+            std::cout << "Sheep " << GetName() << " uses invalid variable index " << op.index << " - it won't be decoded." << std::endl;
+            return;
+        }
+
+        // Branch targets must be in the bytecode.
+        if(op.code == SheepOpCode::Branch || op.code == SheepOpCode::BranchIfZero)
+        {
+            if(op.index < 0 || op.index > mBytecodeLength)
+            {
+                std::cout << "Sheep " << GetName() << " branches outside its bytecode - it won't be decoded." << std::endl;
+                return;
+            }
+            isEntryPoint[op.index] = true;
+        }
+
+        // After a thread yields or blocks, it is resumed at the next instruction.
+        if(op.code == SheepOpCode::Yield || op.code == SheepOpCode::EndWait)
+        {
+            isEntryPoint[reader.GetPosition()] = true;
+        }
+        instructionOps.push_back(op);
+    }
+
+    // Checks whether the next "count" instructions match a sequence of op codes, and can be fused into one op.
+    auto canFuse = [&instructionOps, &isEntryPoint](size_t index, std::initializer_list<SheepOpCode> codes) {
+        if(index + codes.size() > instructionOps.size()) { return false; }
+        size_t i = index;
+        for(SheepOpCode code : codes)
+        {
+            // Execution must not be able to start in the middle of a fused op.
+            if(instructionOps[i].code != code || (i != index && isEntryPoint[instructionOps[i].bytecodeOffset]))
+            {
+                return false;
+            }
+            ++i;
+        }
+        return true;
+    };
+
+    // Next, create the final list of ops, fusing common sequences of instructions.
+    mOpIndexes.resize(mBytecodeLength + 1, -1);
+    for(size_t i = 0; i < instructionOps.size();)
+    {
+        SheepOp op = instructionOps[i];
+        size_t instructionCount = 1;
+        if(canFuse(i, { SheepOpCode::LoadI, SheepOpCode::PushI, SheepOpCode::IsEqualI, SheepOpCode::BranchIfZero }))
+        {
+            // Very common in conditions: "if(var == value)"
+            op.code = SheepOpCode::BranchIfNotEqualVarI;
+            op.intValue = instructionOps[i + 1].intValue;
+            op.branchIndex = instructionOps[i + 3].index;
+            instructionCount = 4;
+        }
+        else if(canFuse(i, { SheepOpCode::LoadI, SheepOpCode::PushI, SheepOpCode::IsEqualI }))
+        {
+            op.code = SheepOpCode::IsEqualVarI;
+            op.intValue = instructionOps[i + 1].intValue;
+            instructionCount = 3;
+        }
+        else if(canFuse(i, { SheepOpCode::LoadI, SheepOpCode::BranchIfZero }))
+        {
+            op.code = SheepOpCode::BranchIfZeroVarI;
+            op.branchIndex = instructionOps[i + 1].index;
+            instructionCount = 2;
+        }
+        else if(canFuse(i, { SheepOpCode::PushI, SheepOpCode::StoreI }))
+        {
+            op.code = SheepOpCode::StoreConstI;
+            op.index = instructionOps[i + 1].index;
+            instructionCount = 2;
+        }
+        else if(canFuse(i, { SheepOpCode::PushS, SheepOpCode::GetString }))
+        {
+            // A missing string constant pushes nothing - leave those unfused, so they behave exactly the same.
+            std::string* stringConst = GetStringConst(op.intValue);
+            if(stringConst != nullptr)
+            {
+                op.code = SheepOpCode::PushString;
+                op.stringValue = stringConst->c_str();
+                op.index = kInvalidSymbol; // set by InternSymbolArguments, if this string is used as a symbol
+                instructionCount = 2;
+            }
+        }
+
+        mOpIndexes[op.bytecodeOffset] = static_cast<int>(mOps.size());
+        mOps.push_back(op);
+        i += instructionCount;
+    }
+
+    // Running off the end of the bytecode ends the thread.
+    SheepOp endOp;
+    endOp.code = SheepOpCode::End;
+    endOp.bytecodeOffset = mBytecodeLength;
+    mOpIndexes[mBytecodeLength] = static_cast<int>(mOps.size());
+    mOps.push_back(endOp);
+
+    // Finally, convert branch targets from bytecode offsets to op indexes.
+    for(SheepOp& op : mOps)
+    {
+        if(op.code == SheepOpCode::Branch || op.code == SheepOpCode::BranchIfZero)
+        {
+            op.index = mOpIndexes[op.index];
+        }
+        else if(op.code == SheepOpCode::BranchIfZeroVarI || op.code == SheepOpCode::BranchIfNotEqualVarI)
+        {
+            op.branchIndex = mOpIndexes[op.branchIndex];
+        }
+    }
+
+    // A branch into the middle of an instruction can't be decoded.
+    for(const SheepOp& op : mOps)
+    {
+        if(((op.code == SheepOpCode::Branch || op.code == SheepOpCode::BranchIfZero) && op.index < 0) ||
+           ((op.code == SheepOpCode::BranchIfZeroVarI || op.code == SheepOpCode::BranchIfNotEqualVarI) && op.branchIndex < 0))
+        {
+            std::cout << "Sheep " << GetName() << " branches into the middle of an instruction - it won't be decoded." << std::endl;
+            mOps.clear();
+            mOpIndexes.clear();
+            return;
+        }
+    }
+
+    InternSymbolArguments();
+}
+
+void SheepScript::InternSymbolArguments()
+{
+    // String constants passed as symbol arguments are usually names of flags, nouns, etc.
+    // Intern them now, so SysFuncs needn't look them up by name - but leave other strings alone, so the symbol table only holds real names.
+    // To find which op pushed each argument, track the op index that pushed each stack value (or -1 if unknown).
+    std::vector<bool> isBranchTarget(mOps.size(), false);
+    for(const SheepOp& op : mOps)
+    {
+        if(op.code == SheepOpCode::Branch || op.code == SheepOpCode::BranchIfZero)
+        {
+            isBranchTarget[op.index] = true;
+        }
+        else if(op.code == SheepOpCode::BranchIfZeroVarI || op.code == SheepOpCode::BranchIfNotEqualVarI)
+        {
+            isBranchTarget[op.branchIndex] = true;
+        }
+    }
+    for(auto& entry : mFunctions)
+    {
+        if(entry.second >= 0 && entry.second <= mBytecodeLength && mOpIndexes[entry.second] >= 0)
+        {
+            isBranchTarget[mOpIndexes[entry.second]] = true;
+        }
+    }
+
+    std::vector<int> pushedBy;
+    auto pop = [&pushedBy](int count) {
+        for(int i = 0; i < count && !pushedBy.empty(); ++i)
+        {
+            pushedBy.pop_back();
+        }
+    };
+    for(int i = 0; i < static_cast<int>(mOps.size()); ++i)
+    {
+        // The stack at a branch target depends on how it was reached - start over, treating everything below as unknown.
+        if(isBranchTarget[i])
+        {
+            pushedBy.clear();
+        }
+
+        SheepOp& op = mOps[i];
+        switch(op.code)
+        {
+        case SheepOpCode::CallSysFunctionV:
+        case SheepOpCode::CallSysFunctionI:
+        case SheepOpCode::CallSysFunctionF:
+        case SheepOpCode::CallSysFunctionS:
+        {
+            // The top of the stack is the argument count, pushed by a PushI, with the arguments below it.
+            int argCount = -1;
+            if(!pushedBy.empty() && pushedBy.back() >= 0 && mOps[pushedBy.back()].code == SheepOpCode::PushI)
+            {
+                argCount = mOps[pushedBy.back()].intValue;
+            }
+            pop(1);
+
+            if(op.sysFunc != nullptr && argCount == static_cast<int>(op.sysFunc->argumentTypes.size()) &&
+               argCount <= static_cast<int>(pushedBy.size()))
+            {
+                int firstArg = static_cast<int>(pushedBy.size()) - argCount;
+                for(int arg = 0; arg < argCount; ++arg)
+                {
+                    int argOpIndex = pushedBy[firstArg + arg];
+                    if(op.sysFunc->symbolArguments[arg] && argOpIndex >= 0 &&
+                       mOps[argOpIndex].code == SheepOpCode::PushString)
+                    {
+                        mOps[argOpIndex].index = gSymbols.Intern(mOps[argOpIndex].stringValue);
+                    }
+                }
+                pop(argCount);
+            }
+            else
+            {
+                pushedBy.clear();
+            }
+            pushedBy.push_back(i);
+            break;
+        }
+
+        case SheepOpCode::LoadI:
+        case SheepOpCode::LoadF:
+        case SheepOpCode::LoadS:
+        case SheepOpCode::PushI:
+        case SheepOpCode::PushF:
+        case SheepOpCode::PushS:
+        case SheepOpCode::PushString:
+        case SheepOpCode::IsEqualVarI:
+            pushedBy.push_back(i);
+            break;
+
+        case SheepOpCode::BranchIfZero:
+        case SheepOpCode::StoreI:
+        case SheepOpCode::StoreF:
+        case SheepOpCode::StoreS:
+        case SheepOpCode::Pop:
+            pop(1);
+            break;
+
+        case SheepOpCode::AddI:
+        case SheepOpCode::AddF:
+        case SheepOpCode::SubtractI:
+        case SheepOpCode::SubtractF:
+        case SheepOpCode::MultiplyI:
+        case SheepOpCode::MultiplyF:
+        case SheepOpCode::DivideI:
+        case SheepOpCode::DivideF:
+        case SheepOpCode::IsEqualI:
+        case SheepOpCode::IsEqualF:
+        case SheepOpCode::IsNotEqualI:
+        case SheepOpCode::IsNotEqualF:
+        case SheepOpCode::IsGreaterI:
+        case SheepOpCode::IsGreaterF:
+        case SheepOpCode::IsLessI:
+        case SheepOpCode::IsLessF:
+        case SheepOpCode::IsGreaterEqualI:
+        case SheepOpCode::IsGreaterEqualF:
+        case SheepOpCode::IsLessEqualI:
+        case SheepOpCode::IsLessEqualF:
+        case SheepOpCode::Modulo:
+        case SheepOpCode::And:
+        case SheepOpCode::Or:
+            pop(2);
+            pushedBy.push_back(i);
+            break;
+
+        case SheepOpCode::NegateI:
+        case SheepOpCode::NegateF:
+        case SheepOpCode::Not:
+            pop(1);
+            pushedBy.push_back(i);
+            break;
+
+        case SheepOpCode::GetString:
+            // Pushes nothing if the string constant is missing, so the stack depth is unknown after this.
+            pushedBy.clear();
+            break;
+
+        case SheepOpCode::IToF:
+        case SheepOpCode::FToI:
+            // Converts a value in place - it's no longer the value that was pushed.
+            if(op.index >= 0 && op.index < static_cast<int>(pushedBy.size()))
+            {
+                pushedBy[pushedBy.size() - 1 - op.index] = -1;
+            }
+            break;
+
+        default:
+            // SitnSpin, Yield, Branch, waits, returns, StoreConstI, and branches on variables don't touch the stack.
+            break;
+        }
+    }
+}
+
 std::string* SheepScript::GetStringConst(int offset)
 {
     auto it = mStringConsts.find(offset);
@@ -172,6 +636,9 @@ void SheepScript::ParseFromData(uint8_t* data, uint32_t dataLength)
             std::cout << "Unknown component: " << section << std::endl;
         }
     }
+
+    // With all sections parsed, the bytecode can be decoded for the VM.
+    DecodeOps();
 }
 
 void SheepScript::ParseSysImportsSection(BinaryReader& reader)
@@ -207,6 +674,7 @@ void SheepScript::ParseSysImportsSection(BinaryReader& reader)
 
         mSysImports.push_back(import);
     }
+    ResolveSysFuncs();
 }
 
 void SheepScript::ParseStringConstsSection(BinaryReader& reader)
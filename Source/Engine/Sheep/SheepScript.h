@@ -10,6 +10,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "SheepOp.h"
 #include "SheepSysFunc.h"
 #include "SheepVM.h"
 #include "StringUtil.h"
@@ -31,6 +32,7 @@ public:
     void Load(const SheepScriptBuilder& builder);
 
     SysFuncImport* GetSysImport(int index);
+    SysFunc* GetSysFunc(int index) const { return index >= 0 && index < static_cast<int>(mSysFuncs.size()) ? mSysFuncs[index] : nullptr; }
 
     std::string* GetStringConst(int offset);
 
@@ -42,6 +44,11 @@ public:
     char* GetBytecode() { return mBytecode; }
     int GetBytecodeLength() const { return mBytecodeLength; }
 
+    // Decoded ops, for the VM to run in place of the bytecode.
+    // Empty if the bytecode couldn't be decoded - in that case, the bytecode must be interpreted directly.
+    const std::vector<SheepOp>& GetOps() const { return mOps; }
+    int GetOpIndex(int bytecodeOffset) const;
+
     void Dump();
     void Decompile();
     void Decompile(const std::string& filePath);
@@ -50,6 +57,10 @@ private:
     // List of SysFuncs this script uses.
     std::vector<SysFuncImport> mSysImports;
 
+    // The SysFunc for each import (same order), looked up when the script is loaded.
+    // Null if the script uses a function that doesn't exist.
+    std::vector<SysFunc*> mSysFuncs;
+
     // String constants, keyed by data offset, since that's how bytecode identifies them.
     std::unordered_map<int, std::string> mStringConsts;
 
@@ -65,10 +76,20 @@ private:
     char* mBytecode = nullptr;
     int mBytecodeLength = 0;
 
+    // The bytecode, decoded into ops when the script is loaded (see SheepOp.h).
+    std::vector<SheepOp> mOps;
+
+    // Maps a bytecode offset to the index of the op decoded from the instruction at that offset (or -1 if none).
+    std::vector<int> mOpIndexes;
+
     void ParseFromData(uint8_t* data, uint32_t dataLength);
     void ParseSysImportsSection(BinaryReader& reader);
     void ParseStringConstsSection(BinaryReader& reader);
     void ParseVariablesSection(BinaryReader& reader);
     void ParseFunctionsSection(BinaryReader& reader);
     void ParseCodeSection(BinaryReader& reader);
+
+    void ResolveSysFuncs();
+    void DecodeOps();
+    void InternSymbolArguments();
 };
\ No newline at end of file
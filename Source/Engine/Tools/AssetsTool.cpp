@@ -129,15 +129,18 @@ void AssetsTool::AddAssetList(const std::string& id)
     // For all nodes, only expand the tree if you click on the arrow.
     ImGuiTreeNodeFlags assetTypeFlags = ImGuiTreeNodeFlags_OpenOnArrow;
 
+    // Also show how much memory these assets are using (in KB).
+    size_t memoryUsageKB = gAssetManager.GetMemoryUsage<T>(id) / 1024;
+
     // Draw the tree node.
     bool node_open;
     if(id.empty())
     {
-        node_open = ImGui::TreeNodeEx(assetId.c_str(), assetTypeFlags, "%s (%zu)", typeName, loadedAssets.size());
+        node_open = ImGui::TreeNodeEx(assetId.c_str(), assetTypeFlags, "%s (%zu, %zu KB)", typeName, loadedAssets.size(), memoryUsageKB);
     }
     else
     {
-        node_open = ImGui::TreeNodeEx(assetId.c_str(), assetTypeFlags, "%s %s (%zu)", id.c_str(), typeName, loadedAssets.size());
+        node_open = ImGui::TreeNodeEx(assetId.c_str(), assetTypeFlags, "%s %s (%zu, %zu KB)", id.c_str(), typeName, loadedAssets.size(), memoryUsageKB);
     }
 
     // If open, draw all the loaded assets of this type.
@@ -0,0 +1,94 @@
+#include "UIBatcher.h"
+
+#include "Matrix4.h"
+
+namespace
+{
+    // Vertices are uploaded as-is, so there must be no padding between attributes.
+    static_assert(sizeof(UIBatcher::Vertex) == sizeof(float) * 9, "UIBatcher::Vertex doesn't match the batch vertex definition");
+
+    // Corners of the unit quad, in the same order (and with the same UVs) as the UI quad mesh.
+    // Since the quad is drawn as two triangles (0, 1, 2) and (2, 3, 0), the order matters.
+    const Vector2 kQuadCorners[4] = {
+        Vector2(0.0f, 1.0f),    // upper-left
+        Vector2(1.0f, 1.0f),    // upper-right
+        Vector2(1.0f, 0.0f),    // lower-right
+        Vector2(0.0f, 0.0f)     // lower-left
+    };
+    const Vector2 kQuadUVs[4] = {
+        Vector2(0.0f, 0.0f),
+        Vector2(1.0f, 0.0f),
+        Vector2(1.0f, 1.0f),
+        Vector2(0.0f, 1.0f)
+    };
+}
+
+void UIBatcher::Clear()
+{
+    mVertices.clear();
+    mPendingBatches.clear();
+}
+
+void UIBatcher::AddQuad(const Matrix4& transform, Texture* texture, const Color32& color, const Color32& discardColor, const Vector2& uvRepeat)
+{
+    // A fully transparent quad doesn't change any pixels, so don't bother drawing it.
+    // Some widgets (e.g. invisible buttons) are only there to receive input.
+    if(color.a == 0) { return; }
+
+    // If the texture is on an atlas page, draw from the page instead. Otherwise, the texture is drawn as-is.
+    Texture* drawTexture = texture;
+    Vector2 uvOffset = Vector2::Zero;
+    Vector2 uvScale = uvRepeat;
+    if(uvRepeat == Vector2::One)
+    {
+        auto it = mAtlasEntries.find(texture);
+        if(it != mAtlasEntries.end())
+        {
+            drawTexture = it->second.page;
+            uvOffset = it->second.uvOffset;
+            uvScale = it->second.uvScale;
+        }
+    }
+
+    // Add the quad's vertices, transformed to world space.
+    uint32_t quadIndex = GetQuadCount();
+    Color vertexColor(color);
+    for(int i = 0; i < 4; ++i)
+    {
+        Vertex vertex;
+        vertex.position = transform.TransformPoint(Vector3(kQuadCorners[i].x, kQuadCorners[i].y, 0.0f));
+        vertex.color = vertexColor;
+        vertex.uv = Vector2(uvOffset.x + kQuadUVs[i].x * uvScale.x, uvOffset.y + kQuadUVs[i].y * uvScale.y);
+        mVertices.push_back(vertex);
+    }
+
+    // If this quad can be drawn with the same state as the previous one, just extend that batch.
+    if(!mPendingBatches.empty())
+    {
+        Batch& lastBatch = mPendingBatches.back();
+        if(lastBatch.texture == drawTexture && lastBatch.discardColor == discardColor && lastBatch.firstQuad + lastBatch.quadCount == quadIndex)
+        {
+            ++lastBatch.quadCount;
+            return;
+        }
+    }
+
+    // Otherwise, this quad starts a new batch.
+    Batch batch;
+    batch.texture = drawTexture;
+    batch.discardColor = discardColor;
+    batch.firstQuad = quadIndex;
+    batch.quadCount = 1;
+    mPendingBatches.push_back(batch);
+}
+
+void UIBatcher::SetAtlasEntry(Texture* texture, const TextureAtlas::Entry& entry)
+{
+    // Textures that couldn't be packed have no page, and are just drawn as-is.
+    if(entry.page == nullptr)
+    {
+        mAtlasEntries.erase(texture);
+        return;
+    }
+    mAtlasEntries[texture] = entry;
+}
\ No newline at end of file
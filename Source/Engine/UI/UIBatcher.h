@@ -0,0 +1,84 @@
+//
+// Clark Kromenaker
+//
+// Collects UI quads into a single vertex array, so many widgets can be drawn with few draw calls.
+//
+// Without batching, each UI image activates its material and draws the shared UI quad mesh.
+// With batching, widgets instead add a quad (already transformed to UI world space) to the batcher.
+// Consecutive quads that use the same texture and discard color are merged into one "batch," which is drawn with one draw call.
+// All UI quads use the same shader and blend mode, so those aren't part of a batch's state.
+//
+// Small textures can also be mapped to a spot on an atlas page.
+// Quads using different textures that are on the same page can then be merged as well.
+//
+// Like the render queue, the batcher doesn't talk to the graphics API itself - it only builds vertices and decides where draws are split.
+//
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Color.h"
+#include "Color32.h"
+#include "TextureAtlas.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+class Matrix4;
+class Texture;
+
+class UIBatcher
+{
+public:
+    // Each quad is four vertices, and vertex indexes must fit in 16 bits.
+    static const uint32_t kMaxQuads = 16384;
+
+    // Vertex data for a batched quad. Position, color, and UV1 - interleaved.
+    struct Vertex
+    {
+        Vector3 position;
+        Color color;
+        Vector2 uv;
+    };
+
+    // A run of consecutive quads that are drawn with the same state.
+    struct Batch
+    {
+        Texture* texture = nullptr;
+        Color32 discardColor;
+
+        // The range of quads in the vertex array.
+        uint32_t firstQuad = 0;
+        uint32_t quadCount = 0;
+    };
+
+    // Removes all quads and batches.
+    void Clear();
+
+    // Adds a unit quad transformed by the matrix. The quad matches the UI quad mesh, from (0, 0) in the bottom-left to (1, 1) in the top-right.
+    // UVs go from 0 to "uvRepeat." Repeating textures rely on the texture's wrap mode, so only quads with a repeat of one can use the atlas.
+    void AddQuad(const Matrix4& transform, Texture* texture, const Color32& color, const Color32& discardColor, const Vector2& uvRepeat = Vector2::One);
+
+    bool IsFull() const { return GetQuadCount() >= kMaxQuads; }
+    uint32_t GetQuadCount() const { return static_cast<uint32_t>(mVertices.size() / 4); }
+    const std::vector<Vertex>& GetVertices() const { return mVertices; }
+
+    // Batches added since the last call to ClearPendingBatches.
+    // Once pending batches are drawn, they should be cleared. Their quads stay in the vertex array until Clear is called.
+    const std::vector<Batch>& GetPendingBatches() const { return mPendingBatches; }
+    void ClearPendingBatches() { mPendingBatches.clear(); }
+
+    // Quads using the texture are instead drawn with the entry's page, with UVs remapped to the texture's spot on the page.
+    void SetAtlasEntry(Texture* texture, const TextureAtlas::Entry& entry);
+    void ClearAtlasEntries() { mAtlasEntries.clear(); }
+
+private:
+    // Vertices for all quads added since the last clear.
+    std::vector<Vertex> mVertices;
+
+    // Batches that haven't been drawn yet.
+    std::vector<Batch> mPendingBatches;
+
+    // Textures that are packed into an atlas, and where they are.
+    std::unordered_map<Texture*, TextureAtlas::Entry> mAtlasEntries;
+};
\ No newline at end of file
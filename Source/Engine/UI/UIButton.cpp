@@ -9,6 +9,7 @@
 #include "RectTransform.h"
 #include "Texture.h"
 #include "Tooltip.h"
+#include "UIBatcher.h"
 
 extern Mesh* uiQuad;
 
@@ -39,6 +40,17 @@ void UIButton::Render()
     uiQuad->Render();
 }
 
+bool UIButton::AddToBatch(UIBatcher& batcher)
+{
+    // Update the texture to use.
+    UpdateMaterial();
+
+    // Add the button quad.
+    const Color32* color = mMaterial.GetColor("uColor");
+    batcher.AddQuad(GetWorldTransformWithSizeForRendering(), mMaterial.GetDiffuseTexture(), color != nullptr ? *color : Color32::White, Color32::Magenta);
+    return true;
+}
+
 void UIButton::SetUpTexture(Texture* texture, const Color32& color)
 {
     mUpState.texture = texture;
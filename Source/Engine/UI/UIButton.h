@@ -21,6 +21,7 @@ public:
     UIButton(Actor* actor);
 
     void Render() override;
+    bool AddToBatch(UIBatcher& batcher) override;
 
     void SetUpTexture(Texture* texture, const Color32& color = Color32::White);
     void SetDownTexture(Texture* texture, const Color32& color = Color32::White);
@@ -1,14 +1,148 @@
 #include "UICanvas.h"
 
+#include <memory>
+
 #include "Actor.h"
+#include "AssetCache.h"
 #include "GAPI.h"
 #include "GKPrefs.h"
 #include "InputManager.h"
+#include "Material.h"
+#include "Profiler.h"
 #include "Rect.h"
+#include "ShaderCache.h"
+#include "Texture.h"
+#include "TextureAtlas.h"
+#include "UIBatcher.h"
 #include "UIUtil.h"
 #include "UIWidget.h"
+#include "VertexDefinition.h"
 #include "Window.h"
 
+namespace
+{
+    // Widgets add their quads here, so consecutive widgets with the same texture can be drawn with one draw call.
+    UIBatcher batcher;
+
+    // GPU buffers for batched quads, and the material used to draw them. Created the first time they're needed, and destroyed on shutdown.
+    // The vertex buffer is big enough for every quad the batcher can hold, so each frame's quads are uploaded to a different part of it.
+    BufferHandle batchVertexBuffer = nullptr;
+    BufferHandle batchIndexBuffer = nullptr;
+    std::unique_ptr<Material> batchMaterial;
+
+    // Textures to pack into the UI atlas, and the atlas itself.
+    // The atlas is rebuilt before rendering if textures were added or removed since it was last built.
+    // Each texture also records the pointer it had when the atlas was built. If the handle no longer returns that pointer, the texture was unloaded (or reloaded).
+    // In that case, the atlas must be rebuilt - it would otherwise map a stale (or reused) address to the old texture's spot.
+    struct AtlasTexture
+    {
+        AssetHandle<Texture> handle;
+        Texture* builtTexture = nullptr;
+    };
+    const uint32_t kMaxAtlasTextureSize = 256;
+    std::vector<AtlasTexture> atlasTextures;
+    std::unique_ptr<TextureAtlas> atlas;
+    bool atlasDirty = false;
+
+    // Counts for this frame, for profiling.
+    int batchedQuadCount = 0;
+    int batchDrawCount = 0;
+
+    void CreateBatchResources()
+    {
+        // Vertices are already in UI world space, and have the widget's color - so the material just provides the texture and discard color.
+        batchMaterial.reset(new Material(ShaderCache::GetShader("UIBatch")));
+
+        VertexDefinition vertexDefinition;
+        vertexDefinition.layout = VertexLayout::Interleaved;
+        vertexDefinition.attributes.push_back(VertexAttribute::Position);
+        vertexDefinition.attributes.push_back(VertexAttribute::Color);
+        vertexDefinition.attributes.push_back(VertexAttribute::UV1);
+        batchVertexBuffer = GAPI::Get()->CreateVertexBuffer(UIBatcher::kMaxQuads * 4, vertexDefinition, nullptr, MeshUsage::Dynamic);
+
+        // Every quad uses the same index pattern, so the index buffer never needs to change.
+        std::vector<uint16_t> indexes(UIBatcher::kMaxQuads * 6);
+        for(uint32_t i = 0; i < UIBatcher::kMaxQuads; ++i)
+        {
+            uint16_t firstVertex = static_cast<uint16_t>(i * 4);
+            indexes[i * 6 + 0] = firstVertex;
+            indexes[i * 6 + 1] = firstVertex + 1;
+            indexes[i * 6 + 2] = firstVertex + 2;
+            indexes[i * 6 + 3] = firstVertex + 2;
+            indexes[i * 6 + 4] = firstVertex + 3;
+            indexes[i * 6 + 5] = firstVertex;
+        }
+        batchIndexBuffer = GAPI::Get()->CreateIndexBuffer(static_cast<uint32_t>(indexes.size()), indexes.data(), MeshUsage::Static);
+    }
+
+    void FlushBatches()
+    {
+        const std::vector<UIBatcher::Batch>& batches = batcher.GetPendingBatches();
+        if(batches.empty()) { return; }
+        if(batchMaterial == nullptr)
+        {
+            CreateBatchResources();
+        }
+
+        // Upload only the quads that haven't been drawn yet.
+        uint32_t firstQuad = batches.front().firstQuad;
+        uint32_t quadCount = batcher.GetQuadCount() - firstQuad;
+        const UIBatcher::Vertex* vertices = batcher.GetVertices().data() + firstQuad * 4;
+        GAPI::Get()->SetVertexBufferData(batchVertexBuffer, firstQuad * 4 * sizeof(UIBatcher::Vertex), quadCount * 4 * sizeof(UIBatcher::Vertex),
+                                         const_cast<UIBatcher::Vertex*>(vertices));
+
+        // The shader and matrix are the same for all batches. Only the texture and discard color change between them.
+        batchMaterial->ActivateShader();
+        batchMaterial->SetObjectToWorldMatrix(Matrix4::Identity);
+        for(const UIBatcher::Batch& batch : batches)
+        {
+            batchMaterial->SetDiffuseTexture(batch.texture);
+            batchMaterial->SetColor("gDiscardColor", batch.discardColor);
+            batchMaterial->ActivateProperties();
+            GAPI::Get()->Draw(GAPI::Primitive::Triangles, batchVertexBuffer, batchIndexBuffer, batch.firstQuad * 6, batch.quadCount * 6);
+        }
+
+        batchedQuadCount += quadCount;
+        batchDrawCount += static_cast<int>(batches.size());
+        batcher.ClearPendingBatches();
+    }
+
+    void RebuildAtlas()
+    {
+        if(atlas == nullptr)
+        {
+            atlas.reset(new TextureAtlas());
+        }
+
+        // Only pack textures that are still loaded.
+        std::vector<Texture*> textures;
+        for(AtlasTexture& atlasTexture : atlasTextures)
+        {
+            atlasTexture.builtTexture = atlasTexture.handle.Get();
+            if(atlasTexture.builtTexture != nullptr)
+            {
+                textures.push_back(atlasTexture.builtTexture);
+            }
+        }
+        atlas->Build(textures);
+
+        // UI textures use point filtering. The pages should too, or atlas textures would look blurrier than the originals.
+        for(Texture* page : atlas->GetPages())
+        {
+            page->SetFilterMode(Texture::FilterMode::Point);
+        }
+
+        // Let the batcher know where each texture ended up.
+        batcher.ClearAtlasEntries();
+        const std::vector<TextureAtlas::Entry>& entries = atlas->GetEntries();
+        for(size_t i = 0; i < entries.size(); ++i)
+        {
+            batcher.SetAtlasEntry(textures[i], entries[i]);
+        }
+        atlasDirty = false;
+    }
+}
+
 std::vector<UICanvas*> UICanvas::sCanvases;
 UIWidget* UICanvas::sMouseOverWidget = nullptr;
 
@@ -96,10 +230,51 @@ UIWidget* UICanvas::sMouseOverWidget = nullptr;
     });
     #endif
 
+    // The atlas pages are recreated when rebuilding, so this must happen before any quads are added.
+    for(const AtlasTexture& atlasTexture : atlasTextures)
+    {
+        if(atlasTexture.handle.Get() != atlasTexture.builtTexture)
+        {
+            atlasDirty = true;
+            break;
+        }
+    }
+    if(atlasDirty)
+    {
+        RebuildAtlas();
+    }
+
+    // All canvases share one set of batched vertices per frame.
+    batcher.Clear();
+    batchedQuadCount = 0;
+    batchDrawCount = 0;
     for(UICanvas* canvas : sCanvases)
     {
         canvas->Render();
     }
+    PROFILER_COUNTER("UI Quads", batchedQuadCount);
+    PROFILER_COUNTER("UI Draw Calls", batchDrawCount);
+}
+
+/*static*/ void UICanvas::Shutdown()
+{
+    // The atlas pages and batch buffers are GPU resources, so they must be destroyed while the renderer is still around.
+    batcher.ClearAtlasEntries();
+    atlas.reset();
+    atlasTextures.clear();
+    atlasDirty = false;
+
+    batchMaterial.reset();
+    if(batchVertexBuffer != nullptr)
+    {
+        GAPI::Get()->DestroyVertexBuffer(batchVertexBuffer);
+        batchVertexBuffer = nullptr;
+    }
+    if(batchIndexBuffer != nullptr)
+    {
+        GAPI::Get()->DestroyIndexBuffer(batchIndexBuffer);
+        batchIndexBuffer = nullptr;
+    }
 }
 
 /*static*/ void UICanvas::NotifyWidgetDestruct(UIWidget* widget)
@@ -110,6 +285,41 @@ UIWidget* UICanvas::sMouseOverWidget = nullptr;
     }
 }
 
+/*static*/ void UICanvas::AddToAtlas(const AssetHandle<Texture>& texture)
+{
+    // Only small textures are worth packing. Big ones would fill up pages quickly, and are usually drawn alone anyway.
+    // Textures that aren't point filtered would look different on a page, so leave those alone too.
+    Texture* tex = texture.Get();
+    if(tex == nullptr || tex->GetWidth() > kMaxAtlasTextureSize || tex->GetHeight() > kMaxAtlasTextureSize ||
+       tex->GetFilterMode() != Texture::FilterMode::Point)
+    {
+        return;
+    }
+
+    // Handles to the same texture refer to the same cache entry, so compare names.
+    auto it = std::find_if(atlasTextures.begin(), atlasTextures.end(), [&texture](const AtlasTexture& atlasTexture) {
+        return atlasTexture.handle.GetName() == texture.GetName();
+    });
+    if(it == atlasTextures.end())
+    {
+        atlasTextures.push_back({ texture, nullptr });
+        atlasDirty = true;
+    }
+}
+
+/*static*/ void UICanvas::RemoveFromAtlas(const AssetHandle<Texture>& texture)
+{
+    if(!texture.IsValid()) { return; }
+    auto it = std::find_if(atlasTextures.begin(), atlasTextures.end(), [&texture](const AtlasTexture& atlasTexture) {
+        return atlasTexture.handle.GetName() == texture.GetName();
+    });
+    if(it != atlasTextures.end())
+    {
+        atlasTextures.erase(it);
+        atlasDirty = true;
+    }
+}
+
 TYPEINFO_INIT(UICanvas, Component, 14)
 {
     TYPEINFO_VAR(UICanvas, VariableType::Int, mDrawOrder);
@@ -177,14 +387,28 @@ void UICanvas::Render()
         }
 
         // Render all our widgets.
+        // Most widgets add a quad to the batch. Batched quads are drawn when a widget can't be batched, when the batch is full, or at the end of the canvas.
         for(auto& widget : mWidgets)
         {
             if(widget->IsActiveAndEnabled())
             {
-                widget->Render();
+                if(batcher.IsFull())
+                {
+                    FlushBatches();
+                    batcher.Clear();
+                }
+                if(!widget->AddToBatch(batcher))
+                {
+                    // Anything batched so far must be drawn first to keep the draw order correct.
+                    FlushBatches();
+                    widget->Render();
+                }
             }
         }
 
+        // The mask only applies to this canvas, so any batched quads must be drawn before it changes.
+        FlushBatches();
+
         // Unset mask if we are using one.
         if(mMasked)
         {
@@ -13,7 +13,9 @@
 #include <climits> // INT_MAX
 #include <vector>
 
+template<typename T> class AssetHandle;
 class RectTransform;
+class Texture;
 class UIWidget;
 
 class UICanvas : public Component
@@ -26,6 +28,15 @@ public:
     static bool DidWidgetEatInput() { return sMouseOverWidget != nullptr; }
     static void NotifyWidgetDestruct(UIWidget* widget);
 
+    // Frees the UI atlas and batching resources. Called on shutdown, before the assets and renderer they use are shut down.
+    static void Shutdown();
+
+    // Small UI textures can be packed into an atlas, so widgets using different textures can still be drawn together.
+    // The atlas holds a handle to each texture, so they aren't evicted. If a texture is unloaded or reloaded anyway, the atlas is rebuilt without it.
+    // A texture in the atlas must not be modified until it is removed from the atlas.
+    static void AddToAtlas(const AssetHandle<Texture>& texture);
+    static void RemoveFromAtlas(const AssetHandle<Texture>& texture);
+
     UICanvas(Actor* owner);
     UICanvas(Actor* owner, int order);
     ~UICanvas();
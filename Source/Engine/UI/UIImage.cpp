@@ -4,6 +4,7 @@
 #include "Debug.h"
 #include "Mesh.h"
 #include "Texture.h"
+#include "UIBatcher.h"
 
 extern Mesh* uiQuad;
 
@@ -72,6 +73,34 @@ void UIImage::Render()
     }
 }
 
+bool UIImage::AddToBatch(UIBatcher& batcher)
+{
+    // We need a texture to render (and calculate repeats for tiled rendering).
+    Texture* texture = mMaterial.GetDiffuseTexture();
+    if(texture == nullptr)
+    {
+        texture = &Texture::White;
+    }
+
+    // When tiled, UVs go past one so that the texture repeats at its normal size.
+    Vector2 uvRepeat = Vector2::One;
+    if(mRenderMode == RenderMode::Tiled)
+    {
+        Vector2 size = GetRectTransform()->GetSize();
+        uvRepeat.x = size.x / texture->GetWidth();
+        uvRepeat.y = size.y / texture->GetHeight();
+    }
+
+    // Color and discard color are the same as what the material would set.
+    const Color32* color = mMaterial.GetColor("uColor");
+    const Color32* discardColor = mMaterial.GetColor("gDiscardColor");
+    batcher.AddQuad(GetWorldTransformWithSizeForRendering(), texture,
+                    color != nullptr ? *color : Color32::White,
+                    discardColor != nullptr ? *discardColor : Color32::Magenta,
+                    uvRepeat);
+    return true;
+}
+
 void UIImage::SetColor(const Color32& color)
 {
     mMaterial.SetColor(color);
@@ -23,6 +23,7 @@ public:
     UIImage(Actor* actor);
 
     void Render() override;
+    bool AddToBatch(UIBatcher& batcher) override;
 
     void SetColor(const Color32& color);
     void SetTransparentColor(const Color32& color);
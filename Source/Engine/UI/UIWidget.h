@@ -8,6 +8,8 @@
 
 #include "RectTransform.h"
 
+class UIBatcher;
+
 class UIWidget : public Component
 {
     TYPEINFO_SUB(UIWidget, Component);
@@ -17,6 +19,10 @@ public:
 
     virtual void Render() { }
 
+    // Widgets that are drawn as a single textured quad can add that quad to a batch, rather than rendering on their own.
+    // Returns false if the widget can't be batched, in which case Render is called instead.
+    virtual bool AddToBatch(UIBatcher& batcher) { return false; }
+
     // Called when pointer enters/exits the bounds of this widget.
     virtual void OnPointerEnter() { }
     virtual void OnPointerExit() { }
@@ -0,0 +1,199 @@
+#include "CountTable.h"
+
+#include <cassert>
+#include <vector>
+
+#include "PersistState.h"
+#include "SymbolTable.h"
+
+namespace
+{
+    // One count, as stored in a save file.
+    struct SavedCount
+    {
+        std::string actor;
+        std::string noun;
+        std::string verb;
+        int count = 0;
+
+        void OnPersist(PersistState& ps)
+        {
+            ps.Xfer(PERSIST_VAR(actor));
+            ps.Xfer(PERSIST_VAR(noun));
+            ps.Xfer(PERSIST_VAR(verb));
+            ps.Xfer(PERSIST_VAR(count));
+        }
+    };
+}
+
+int CountTable::Get(const std::string& actor, const std::string& noun, const std::string& verb) const
+{
+    // If all names are interned, look up by symbol.
+    int actorSymbol = gSymbols.Find(actor);
+    int nounSymbol = gSymbols.Find(noun);
+    int verbSymbol = gSymbols.Find(verb);
+    if(actorSymbol >= 0 && nounSymbol >= 0 && verbSymbol >= 0)
+    {
+        return Get(actorSymbol, nounSymbol, verbSymbol);
+    }
+
+    // Otherwise, only an older save file could have a count for these names.
+    auto it = mLegacyCounts.find(actor + noun + verb);
+    return it != mLegacyCounts.end() ? it->second : 0;
+}
+
+int CountTable::Get(int actor, int noun, int verb) const
+{
+    auto it = mCounts.find(MakeKey(actor, noun, verb));
+    if(it != mCounts.end())
+    {
+        return it->second;
+    }
+    return GetLegacyCount(actor, noun, verb);
+}
+
+void CountTable::Set(int actor, int noun, int verb, int count)
+{
+    if(actor < 0 || noun < 0 || verb < 0) { return; }
+    GetCountRef(actor, noun, verb) = count;
+}
+
+void CountTable::Increment(int actor, int noun, int verb)
+{
+    if(actor < 0 || noun < 0 || verb < 0) { return; }
+    ++GetCountRef(actor, noun, verb);
+}
+
+void CountTable::OnPersist(PersistState& ps)
+{
+    // Older save files key each count by the concatenated names.
+    if(ps.GetFormatVersionNumber() < 5)
+    {
+        std::string_map_ci<int> namedCounts;
+        if(ps.IsSaving())
+        {
+            namedCounts = mLegacyCounts;
+            for(auto& entry : mCounts)
+            {
+                int actor, noun, verb;
+                SplitKey(entry.first, actor, noun, verb);
+                namedCounts[GetLegacyName(actor, noun, verb)] = entry.second;
+            }
+        }
+        ps.Xfer("mCounts", namedCounts);
+
+        if(ps.IsLoading())
+        {
+            mCounts.clear();
+            mLegacyCounts = namedCounts;
+            mLegacyCountCache.clear();
+        }
+        return;
+    }
+
+    // Newer save files store the names separately, so they can be interned on load.
+    std::vector<SavedCount> savedCounts;
+    if(ps.IsSaving())
+    {
+        savedCounts.reserve(mCounts.size());
+        for(auto& entry : mCounts)
+        {
+            int actor, noun, verb;
+            SplitKey(entry.first, actor, noun, verb);
+
+            SavedCount savedCount;
+            savedCount.actor = gSymbols.GetName(actor);
+            savedCount.noun = gSymbols.GetName(noun);
+            savedCount.verb = gSymbols.GetName(verb);
+            savedCount.count = entry.second;
+            savedCounts.push_back(savedCount);
+        }
+    }
+    ps.Xfer("mCounts", savedCounts);
+
+    // Counts from an older save file that were never changed are still only known by concatenated name.
+    ps.Xfer(PERSIST_VAR(mLegacyCounts));
+
+    if(ps.IsLoading())
+    {
+        mCounts.clear();
+        mLegacyCountCache.clear();
+        for(SavedCount& savedCount : savedCounts)
+        {
+            mCounts[MakeKey(gSymbols.Intern(savedCount.actor), gSymbols.Intern(savedCount.noun), gSymbols.Intern(savedCount.verb))] = savedCount.count;
+        }
+    }
+}
+
+/*static*/ uint64_t CountTable::MakeKey(int actor, int noun, int verb)
+{
+    // Each symbol gets 21 bits of the key. That's room for about two million symbols, which should be plenty.
+    // Invalid (negative) symbols map to a key that's never added to the map, since setters ignore invalid symbols.
+    if(actor < 0 || noun < 0 || verb < 0) { return UINT64_MAX; }
+    assert(actor < (1 << 21) && noun < (1 << 21) && verb < (1 << 21));
+    return (static_cast<uint64_t>(actor) << 42) | (static_cast<uint64_t>(noun) << 21) | static_cast<uint64_t>(verb);
+}
+
+/*static*/ void CountTable::SplitKey(uint64_t key, int& actor, int& noun, int& verb)
+{
+    actor = static_cast<int>(key >> 42);
+    noun = static_cast<int>((key >> 21) & 0x1FFFFF);
+    verb = static_cast<int>(key & 0x1FFFFF);
+}
+
+int CountTable::GetLegacyCount(int actor, int noun, int verb) const
+{
+    if(mLegacyCounts.empty() || actor < 0 || noun < 0 || verb < 0) { return 0; }
+
+    // Building the concatenated name is slow, and the same counts are checked over and over (e.g. each time a noun's verbs are shown).
+    // So, remember the result for each key - including that there's no legacy count, which is the usual case.
+    uint64_t key = MakeKey(actor, noun, verb);
+    auto cachedIt = mLegacyCountCache.find(key);
+    if(cachedIt != mLegacyCountCache.end())
+    {
+        return cachedIt->second;
+    }
+
+    auto it = mLegacyCounts.find(GetLegacyName(actor, noun, verb));
+    int count = it != mLegacyCounts.end() ? it->second : 0;
+    mLegacyCountCache[key] = count;
+    return count;
+}
+
+/*static*/ std::string CountTable::GetLegacyName(int actor, int noun, int verb)
+{
+    const std::string& actorName = gSymbols.GetName(actor);
+    const std::string& nounName = gSymbols.GetName(noun);
+    const std::string& verbName = gSymbols.GetName(verb);
+
+    std::string name;
+    name.reserve(actorName.size() + nounName.size() + verbName.size());
+    name.append(actorName).append(nounName).append(verbName);
+    return name;
+}
+
+int& CountTable::GetCountRef(int actor, int noun, int verb)
+{
+    uint64_t key = MakeKey(actor, noun, verb);
+    auto it = mCounts.find(key);
+    if(it != mCounts.end())
+    {
+        return it->second;
+    }
+
+    // The first time a count is changed, carry over its value from an older save file (if any).
+    int& count = mCounts[key];
+    if(!mLegacyCounts.empty())
+    {
+        auto legacyIt = mLegacyCounts.find(GetLegacyName(actor, noun, verb));
+        if(legacyIt != mLegacyCounts.end())
+        {
+            count = legacyIt->second;
+            mLegacyCounts.erase(legacyIt);
+
+            // The erased count may be cached for other keys whose names concatenate to the same thing.
+            mLegacyCountCache.clear();
+        }
+    }
+    return count;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+//
+// Clark Kromenaker
+//
+// Counts of how many times something has happened, keyed by actor, noun, and verb symbols (see SymbolTable.h).
+// For example, how many times Gabriel has used the "LOOK" verb on the "BUTHANE" noun.
+//
+// Save files store the actor, noun, and verb names of each count.
+// Older save files (before version 5) instead stored the three names concatenated together (e.g. "GabrielBUTHANELOOK").
+// Those can't reliably be split back into names, so they're kept as-is, and looked up by concatenated name when needed.
+//
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "StringUtil.h"
+
+class PersistState;
+
+class CountTable
+{
+public:
+    // Names that were never interned have a count of zero (unless loaded from an older save file).
+    int Get(const std::string& actor, const std::string& noun, const std::string& verb) const;
+    int Get(int actor, int noun, int verb) const;
+
+    // Invalid symbols are ignored.
+    void Set(int actor, int noun, int verb, int count);
+    void Increment(int actor, int noun, int verb);
+
+    void OnPersist(PersistState& ps);
+
+private:
+    // Maps actor/noun/verb symbols to a count (see MakeKey).
+    std::unordered_map<uint64_t, int> mCounts;
+
+    // Counts loaded from older save files, keyed by the concatenated actor, noun, and verb names.
+    // Once a count is changed, it moves to the map above.
+    std::string_map_ci<int> mLegacyCounts;
+
+    // Results of looking up legacy counts by symbols, keyed like mCounts.
+    mutable std::unordered_map<uint64_t, int> mLegacyCountCache;
+
+    static uint64_t MakeKey(int actor, int noun, int verb);
+    static void SplitKey(uint64_t key, int& actor, int& noun, int& verb);
+    static std::string GetLegacyName(int actor, int noun, int verb);
+    int GetLegacyCount(int actor, int noun, int verb) const;
+    int& GetCountRef(int actor, int noun, int verb);
+};
\ No newline at end of file
@@ -1,28 +1,42 @@
 #include "FlagSet.h"
 
+#include "PersistState.h"
 #include "ReportManager.h"
+#include "SymbolTable.h"
 
 bool FlagSet::Get(const std::string& flag) const
 {
-    // If the flag exists, it implies a "true" value.
-    // Absence of flag implies "false" value.
-    auto it = mFlags.find(flag);
-    return it != mFlags.end();
+    // A name that was never interned can't possibly be set.
+    return Get(gSymbols.Find(flag));
 }
 
 void FlagSet::Set(const std::string& flag)
 {
-    // Doesn't matter whether we are setting an already set flag.
-    mFlags.insert(flag);
+    Set(gSymbols.Intern(flag));
+}
+
+void FlagSet::Set(int flag)
+{
+    if(flag < 0) { return; }
+
+    // Grow to fit the flag. Doesn't matter whether we are setting an already set flag.
+    if(flag >= static_cast<int>(mFlags.size()))
+    {
+        mFlags.resize(flag + 1, false);
+    }
+    mFlags[flag] = true;
 }
 
 void FlagSet::Clear(const std::string& flag)
 {
-    // Erase the flag from the container to "clear" it.
-    auto it = mFlags.find(flag);
-    if(it != mFlags.end())
+    Clear(gSymbols.Find(flag));
+}
+
+void FlagSet::Clear(int flag)
+{
+    if(flag >= 0 && flag < static_cast<int>(mFlags.size()))
     {
-        mFlags.erase(it);
+        mFlags[flag] = false;
     }
 }
 
@@ -52,7 +66,8 @@ void FlagSet::Dump(const std::string& label) const
     }
 
     // Extra space if we actually have flags.
-    if(!mFlags.empty())
+    std::string_set_ci flags = GetFlags();
+    if(!flags.empty())
     {
         dump += "\n";
     }
@@ -61,9 +76,41 @@ void FlagSet::Dump(const std::string& label) const
     //TODO: Our output differs from the original game in two ways.
     //TODO: 1) We don't prepopulate (aka hard-code) every possible flag up-front.
     //TODO: 2) Flags aren't output if their values are false (since they won't be present in the set).
-    for(auto& entry : mFlags)
+    for(auto& entry : flags)
     {
         dump += StringUtil::Format("flag \"%s\" is true\n", entry.c_str());
     }
     gReportManager.Log("Dump", dump);
+}
+
+std::string_set_ci FlagSet::GetFlags() const
+{
+    std::string_set_ci flags;
+    for(int i = 0; i < static_cast<int>(mFlags.size()); ++i)
+    {
+        if(mFlags[i])
+        {
+            flags.insert(gSymbols.GetName(i));
+        }
+    }
+    return flags;
+}
+
+void FlagSet::SetFlags(const std::string_set_ci& flags)
+{
+    mFlags.clear();
+    for(auto& flag : flags)
+    {
+        Set(flag);
+    }
+}
+
+void FlagSet::OnPersist(PersistState& ps)
+{
+    std::string_set_ci flags = GetFlags();
+    ps.Xfer("mFlags", flags);
+    if(ps.IsLoading())
+    {
+        SetFlags(flags);
+    }
 }
\ No newline at end of file
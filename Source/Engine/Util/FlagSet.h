@@ -3,22 +3,41 @@
 //
 // A set of flags.
 //
+// Flags are identified by name, but stored as one bit per symbol (see SymbolTable.h).
+// So, code that checks the same flag often can look up its symbol once, and then check the flag with no string hashing.
+//
 #pragma once
+#include <vector>
+
 #include "StringUtil.h"
 
+class PersistState;
+
 class FlagSet
 {
 public:
     bool Get(const std::string& flag) const;
+    bool Get(int flag) const { return flag >= 0 && flag < static_cast<int>(mFlags.size()) && mFlags[flag]; }
+
     void Set(const std::string& flag);
+    void Set(int flag);
+
     void Clear(const std::string& flag);
+    void Clear(int flag);
+
     void Toggle(const std::string& flag);
 
     void Dump(const std::string& label = "") const;
 
-    std::string_set_ci& GetFlags() { return mFlags; }
+    // Converts to/from a set of flag names (e.g. for saving/loading).
+    std::string_set_ci GetFlags() const;
+    void SetFlags(const std::string_set_ci& flags);
+
+    // Set flags are saved by name, since symbols can differ between runs of the game.
+    void OnPersist(PersistState& ps);
 
 private:
-    // The flags.
-    std::string_set_ci mFlags;
+    // One entry per symbol. True if the flag for that symbol is set.
+    // Flags for symbols past the end of the array are not set.
+    std::vector<bool> mFlags;
 };
\ No newline at end of file
@@ -2,10 +2,11 @@
 
 #include "Loader.h"
 
-#include "ThreadPool.h"
+#include "ThreadUtil.h"
 
-// Loader uses a single background thread, for now.
-ThreadedTaskQueue Loader::sLoadingTasks(1);
+// Loader uses a single background thread, for now. Loads are done one at a time, in the order they were requested.
+// Since it's separate from the thread pool, a thread waiting on thread pool jobs never gets stuck helping with a long load.
+JobSystem Loader::sLoadingJobs(1);
 
 int Loader::sLoadingCount = 0;
 std::function<void()> Loader::sLoadingFinishedCallback;
@@ -13,7 +14,7 @@ Stopwatch Loader::sLoadingStopwatch;
 
 void Loader::Shutdown()
 {
-    sLoadingTasks.Shutdown();
+    sLoadingJobs.Shutdown();
 }
 
 void Loader::Load(const std::function<void()>& loadFunc)
@@ -21,8 +22,13 @@ void Loader::Load(const std::function<void()>& loadFunc)
     if(loadFunc != nullptr)
     {
         AddLoadingTask();
-        sLoadingTasks.AddTask(loadFunc, []() {
-            RemoveLoadingTask();
+        sLoadingJobs.AddJob([loadFunc]() {
+            loadFunc();
+
+            // Finishing a load can kick off whatever was waiting on it (e.g. the rest of a scene load), so don't let this wait behind other main thread functions.
+            ThreadUtil::RunOnMainThread([]() {
+                RemoveLoadingTask();
+            }, ThreadUtil::Priority::High);
         });
     }
 }
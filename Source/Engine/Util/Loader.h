@@ -10,7 +10,7 @@
 #pragma once
 #include <functional>
 
-#include "ThreadPool.h"
+#include "JobSystem.h"
 #include "Timers.h"
 
 class Loader
@@ -27,7 +27,7 @@ public:
 
 private:
     // Threads devoted to loading tasks.
-    static ThreadedTaskQueue sLoadingTasks;
+    static JobSystem sLoadingJobs;
 
     // Number of loading tasks.
     static int sLoadingCount;
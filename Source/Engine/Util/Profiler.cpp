@@ -51,4 +51,9 @@ Sample::~Sample()
 {
     // Pop the sample off the stack (prints sample info to log).
     sActiveSamples.pop_back();
+}
+
+/*static*/ void Profiler::Counter(const char* name, int value)
+{
+    printf("[%s] %d\n", name, value);
 }
\ No newline at end of file
@@ -15,12 +15,14 @@ class ScopedProfiler;
     #define PROFILER_BEGIN_SAMPLE(x) Profiler::BeginSample(x)
     #define PROFILER_END_SAMPLE() Profiler::EndSample()
     #define PROFILER_SCOPED(x) ScopedProfiler x(#x)
+    #define PROFILER_COUNTER(name, value) Profiler::Counter(name, value)
 #else
     #define PROFILER_BEGIN_FRAME()
     #define PROFILER_END_FRAME()
     #define PROFILER_BEGIN_SAMPLE(x)
     #define PROFILER_END_SAMPLE()
     #define PROFILER_SCOPED(x)
+    #define PROFILER_COUNTER(name, value)
 #endif
 
 // These defines are ALWAYS available.
@@ -56,6 +58,9 @@ public:
     static void BeginSample(const char* name);
     static void EndSample();
 
+    // Records a count of something for this frame (e.g. number of draw calls).
+    static void Counter(const char* name, int value);
+
 private:
     // Counts what frame we're on.
     static uint64_t sFrameNumber;
@@ -210,6 +210,25 @@ namespace StringUtil
         return std::equal(str1.begin(), str1.end(), str2.begin(), iequal());
     }
 
+    inline bool EqualsIgnoreCase(const char* str1, const char* str2)
+    {
+        // Compare C-strings without creating std::strings (and allocating) first.
+        // Passing a negative char (e.g. a non-ASCII byte) to toupper is undefined, so compare as unsigned chars.
+        const unsigned char* ustr1 = reinterpret_cast<const unsigned char*>(str1);
+        const unsigned char* ustr2 = reinterpret_cast<const unsigned char*>(str2);
+        while(*ustr1 != '\0' && std::toupper(*ustr1) == std::toupper(*ustr2))
+        {
+            ++ustr1;
+            ++ustr2;
+        }
+        return std::toupper(*ustr1) == std::toupper(*ustr2);
+    }
+
+    inline bool EqualsIgnoreCase(const std::string& str1, const char* str2)
+    {
+        return EqualsIgnoreCase(str1.c_str(), str2);
+    }
+
     inline bool StartsWith(const std::string& str, const std::string& startsWith)
     {
         if(str.size() < startsWith.size()) { return false; }
@@ -0,0 +1,59 @@
+#include "SymbolTable.h"
+
+#include <cassert>
+#include <mutex>
+
+SymbolTable gSymbols;
+
+int SymbolTable::Intern(const std::string& name)
+{
+    // Usually the name is already interned - check that with only a shared lock first.
+    int symbol = Find(name);
+    if(symbol != kInvalidSymbol)
+    {
+        return symbol;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mMutex);
+
+    // Another thread may have interned it in the meantime.
+    auto it = mSymbols.find(name);
+    if(it != mSymbols.end())
+    {
+        return it->second;
+    }
+
+    // Otherwise, the next symbol is just the next index in the names list.
+    symbol = mCount.load(std::memory_order_relaxed);
+    int chunk = symbol / kChunkSize;
+    assert(chunk < kMaxChunks);
+    if(mNameChunks[chunk] == nullptr)
+    {
+        mNameChunks[chunk].reset(new std::string[kChunkSize]);
+    }
+    mNameChunks[chunk][symbol % kChunkSize] = name;
+    mSymbols[name] = symbol;
+
+    // Publish the name to lock-free readers only after it's written.
+    mCount.store(symbol + 1, std::memory_order_release);
+    return symbol;
+}
+
+int SymbolTable::Find(const std::string& name) const
+{
+    std::shared_lock<std::shared_mutex> lock(mMutex);
+    auto it = mSymbols.find(name);
+    return it != mSymbols.end() ? it->second : kInvalidSymbol;
+}
+
+const std::string& SymbolTable::GetName(int symbol) const
+{
+    static const std::string kEmpty;
+    if(symbol < 0 || symbol >= mCount.load(std::memory_order_acquire)) { return kEmpty; }
+    return mNameChunks[symbol / kChunkSize][symbol % kChunkSize];
+}
+
+int SymbolTable::GetCount() const
+{
+    return mCount.load(std::memory_order_acquire);
+}
\ No newline at end of file
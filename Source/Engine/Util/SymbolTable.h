@@ -0,0 +1,61 @@
+//
+// Clark Kromenaker
+//
+// Interns names as "symbols": small integer IDs that uniquely identify a name.
+//
+// Game logic refers to many things by name (flags, game variables, nouns, verbs, etc).
+// Looking up a value by name requires hashing and case-folding the name every time.
+// Instead, a name can be interned once, and its symbol used to index directly into flat arrays.
+//
+// Symbols are case-insensitive: "Gabriel" and "GABRIEL" are the same symbol.
+// Symbols are dense (0, 1, 2, etc) and never removed, so they're suitable as array indexes.
+//
+// Interning and lookups are thread-safe, since assets that intern names may be loaded on background threads.
+// Lookups are much more common than interning new names, so they take a shared lock (Find) or no lock at all (GetName/GetCount).
+//
+#pragma once
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+
+#include "StringUtil.h"
+
+// Symbol value for a name that isn't interned.
+const int kInvalidSymbol = -1;
+
+class SymbolTable
+{
+public:
+    // Returns the symbol for a name, interning the name if needed.
+    int Intern(const std::string& name);
+
+    // Returns the symbol for a name, or kInvalidSymbol if the name has never been interned.
+    int Find(const std::string& name) const;
+
+    // Returns the name of a symbol (as it was first interned), or empty string for an invalid symbol.
+    // Names never move once interned, so the reference stays valid.
+    const std::string& GetName(int symbol) const;
+
+    // Number of interned symbols. All valid symbols are less than this.
+    int GetCount() const;
+
+private:
+    // Names are stored in fixed-size chunks, which are never moved or freed, so names can be read without a lock.
+    static const int kChunkSize = 1024;
+    static const int kMaxChunks = 2048;
+
+    // Maps each name to its symbol.
+    std::string_map_ci<int> mSymbols;
+
+    // The name for each symbol, in chunks of kChunkSize names.
+    std::unique_ptr<std::string[]> mNameChunks[kMaxChunks];
+
+    // Number of interned names. A name is fully written before this is incremented to include it.
+    std::atomic<int> mCount { 0 };
+
+    // Guards the map, and interning new names.
+    mutable std::shared_mutex mMutex;
+};
+
+extern SymbolTable gSymbols;
\ No newline at end of file
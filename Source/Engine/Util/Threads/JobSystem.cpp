@@ -0,0 +1,356 @@
+#include "JobSystem.h"
+
+namespace
+{
+    // The job system and worker index of the current thread, if it's a worker thread.
+    thread_local JobSystem* tJobSystem = nullptr;
+    thread_local int tWorkerIndex = -1;
+}
+
+JobSystem::JobSystem(int threadCount)
+{
+    Start(threadCount);
+}
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+void JobSystem::Start(int threadCount)
+{
+    // Workers steal from each other's queues, so the set of workers can't change once they're running.
+    if(!mWorkers.empty() || threadCount <= 0) { return; }
+
+    // Create all workers before starting any threads.
+    for(int i = 0; i < threadCount; ++i)
+    {
+        mWorkers.emplace_back(new Worker());
+    }
+    for(int i = 0; i < threadCount; ++i)
+    {
+        mWorkers[i]->thread = std::thread([this, i] { WorkerThread(i); });
+    }
+}
+
+void JobSystem::Shutdown()
+{
+    mSleepMutex.lock();
+    mShutdown = true;
+    mSleepMutex.unlock();
+    mSleepCondVar.notify_all();
+
+    // Workers run any jobs still queued before they exit.
+    for(auto& worker : mWorkers)
+    {
+        if(worker->thread.joinable())
+        {
+            worker->thread.join();
+        }
+    }
+
+    // A job may have been queued after the last worker exited (e.g. by a job that depended on a job finishing on another thread).
+    // Run those here, so that every job's counter is decremented, and nobody waiting on a counter waits forever.
+    while(RunOneJob()) { }
+}
+
+void JobSystem::AddJob(JobFunction function, JobCounter* counter)
+{
+    if(!function) { return; }
+
+    if(counter != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(counter->mMutex);
+        ++counter->mCount;
+    }
+
+    Job job;
+    job.function = std::move(function);
+    job.counter = counter;
+
+    // With no worker threads (or once they've shut down), there's nobody else to run the job - just run it now.
+    if(mWorkers.empty() || mShutdown)
+    {
+        RunJob(job);
+        return;
+    }
+    PushJob(std::move(job));
+}
+
+void JobSystem::AddJobAfter(JobCounter& dependency, JobFunction function, JobCounter* counter)
+{
+    if(!function) { return; }
+
+    // If the dependency is still running, save the job for when it finishes.
+    {
+        std::lock_guard<std::mutex> lock(dependency.mMutex);
+        if(dependency.mCount > 0)
+        {
+            // The job counts as part of its group as soon as it's added, even though it can't start yet.
+            if(counter != nullptr)
+            {
+                std::lock_guard<std::mutex> counterLock(counter->mMutex);
+                ++counter->mCount;
+            }
+
+            JobCounter::PendingJob pendingJob;
+            pendingJob.jobSystem = this;
+            pendingJob.function = std::move(function);
+            pendingJob.counter = counter;
+            dependency.mDependentJobs.push_back(std::move(pendingJob));
+            return;
+        }
+    }
+
+    // Dependency is already done, so the job can be added right away.
+    AddJob(std::move(function), counter);
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    while(true)
+    {
+        // Note the group's change count before looking for jobs, so a job queued while looking isn't missed.
+        uint32_t changeCount = 0;
+        {
+            std::lock_guard<std::mutex> lock(counter.mMutex);
+            if(counter.mCount == 0) { return; }
+            changeCount = counter.mChangeCount;
+        }
+
+        // Help out by running one of the group's jobs.
+        Job job;
+        if(PopJobInGroup(counter, job))
+        {
+            RunJob(job);
+            continue;
+        }
+
+        // Nothing to run - the remaining jobs must be running on other threads, or waiting on a dependency.
+        // Sleep until one of them finishes or is queued.
+        // Note: the lock is held when the group finishes, so the counter can't be destroyed until the finishing thread is done with it.
+        std::unique_lock<std::mutex> lock(counter.mMutex);
+        counter.mChangedCondVar.wait(lock, [&counter, changeCount]() {
+            return counter.mCount == 0 || counter.mChangeCount != changeCount;
+        });
+    }
+}
+
+void JobSystem::PushJob(Job&& job)
+{
+    // A thread waiting on the job's group may want to help run it, so the group is notified that a job was queued.
+    // The group's lock is held while queueing: once queued, another thread could run and finish the job (and the group) right away.
+    std::unique_lock<std::mutex> counterLock;
+    JobCounter* counter = job.counter;
+    if(counter != nullptr)
+    {
+        counterLock = std::unique_lock<std::mutex>(counter->mMutex);
+    }
+
+    // Workers add jobs to their own queue. Anyone else adds to the shared queue.
+    if(tJobSystem == this && tWorkerIndex >= 0)
+    {
+        Worker* worker = mWorkers[tWorkerIndex].get();
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->jobs.push_back(std::move(job));
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(mSharedJobsMutex);
+        mSharedJobs.push_back(std::move(job));
+    }
+    ++mQueuedJobCount;
+
+    if(counter != nullptr)
+    {
+        ++counter->mChangeCount;
+        counter->mChangedCondVar.notify_all();
+        counterLock.unlock();
+    }
+
+    // Wake a sleeping worker, if there are any.
+    // The lock ensures a worker that's about to sleep either sees the new job, or is already waiting (and gets notified).
+    if(mSleepingCount > 0)
+    {
+        mSleepMutex.lock();
+        mSleepMutex.unlock();
+        mSleepCondVar.notify_one();
+    }
+}
+
+bool JobSystem::PopJob(Job& outJob)
+{
+    bool isWorker = (tJobSystem == this && tWorkerIndex >= 0);
+
+    // First, a worker checks its own queue, taking the newest job.
+    if(isWorker)
+    {
+        Worker* worker = mWorkers[tWorkerIndex].get();
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        if(!worker->jobs.empty())
+        {
+            outJob = std::move(worker->jobs.back());
+            worker->jobs.pop_back();
+            --mQueuedJobCount;
+            return true;
+        }
+    }
+
+    // Next, check the shared queue, taking the oldest job.
+    {
+        std::lock_guard<std::mutex> lock(mSharedJobsMutex);
+        if(!mSharedJobs.empty())
+        {
+            outJob = std::move(mSharedJobs.front());
+            mSharedJobs.pop_front();
+            --mQueuedJobCount;
+            return true;
+        }
+    }
+
+    // Finally, try to steal the oldest job from another worker.
+    // Start at a different worker for each thread, so thieves don't all go after the same worker.
+    size_t workerCount = mWorkers.size();
+    size_t startIndex = isWorker ? static_cast<size_t>(tWorkerIndex) + 1 : 0;
+    for(size_t i = 0; i < workerCount; ++i)
+    {
+        Worker* worker = mWorkers[(startIndex + i) % workerCount].get();
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        if(!worker->jobs.empty())
+        {
+            outJob = std::move(worker->jobs.front());
+            worker->jobs.pop_front();
+            --mQueuedJobCount;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::PopJobInGroup(const JobCounter& counter, Job& outJob)
+{
+    // Looks for a job in the group, starting from one end of a queue.
+    auto takeJob = [&counter, &outJob, this](std::deque<Job>& jobs, bool newestFirst) {
+        for(size_t i = 0; i < jobs.size(); ++i)
+        {
+            size_t index = newestFirst ? jobs.size() - 1 - i : i;
+            if(jobs[index].counter == &counter)
+            {
+                outJob = std::move(jobs[index]);
+                jobs.erase(jobs.begin() + index);
+                --mQueuedJobCount;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Same order as PopJob: own queue (newest first), then the shared queue, then other workers' queues (oldest first).
+    bool isWorker = (tJobSystem == this && tWorkerIndex >= 0);
+    if(isWorker)
+    {
+        Worker* worker = mWorkers[tWorkerIndex].get();
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        if(takeJob(worker->jobs, true))
+        {
+            return true;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(mSharedJobsMutex);
+        if(takeJob(mSharedJobs, false))
+        {
+            return true;
+        }
+    }
+    for(size_t i = 0; i < mWorkers.size(); ++i)
+    {
+        if(isWorker && i == static_cast<size_t>(tWorkerIndex)) { continue; }
+        Worker* worker = mWorkers[i].get();
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        if(takeJob(worker->jobs, false))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::RunOneJob()
+{
+    Job job;
+    if(!PopJob(job))
+    {
+        return false;
+    }
+    RunJob(job);
+    return true;
+}
+
+void JobSystem::RunJob(Job& job)
+{
+    job.function();
+    FinishJob(job.counter);
+}
+
+void JobSystem::FinishJob(JobCounter* counter)
+{
+    if(counter == nullptr) { return; }
+
+    // Decrement the counter. If this was the last job in the group, any jobs that depend on it can start.
+    std::vector<JobCounter::PendingJob> dependentJobs;
+    {
+        std::lock_guard<std::mutex> lock(counter->mMutex);
+        --counter->mCount;
+        if(counter->mCount == 0)
+        {
+            dependentJobs.swap(counter->mDependentJobs);
+        }
+
+        // Wake any threads waiting on the group. This must happen before unlocking, since a waiter may destroy the counter once it's done.
+        ++counter->mChangeCount;
+        counter->mChangedCondVar.notify_all();
+    }
+
+    // Careful: the counter may be destroyed as soon as the lock above is released - don't touch it from here on.
+    for(auto& pendingJob : dependentJobs)
+    {
+        // The pending job was already counted in its group when it was added, so it's pushed directly (AddJob would count it again).
+        Job job;
+        job.function = std::move(pendingJob.function);
+        job.counter = pendingJob.counter;
+        if(pendingJob.jobSystem->mWorkers.empty() || pendingJob.jobSystem->mShutdown)
+        {
+            pendingJob.jobSystem->RunJob(job);
+        }
+        else
+        {
+            pendingJob.jobSystem->PushJob(std::move(job));
+        }
+    }
+}
+
+void JobSystem::WorkerThread(int workerIndex)
+{
+    tJobSystem = this;
+    tWorkerIndex = workerIndex;
+    while(true)
+    {
+        if(RunOneJob())
+        {
+            continue;
+        }
+
+        // On shutdown, only exit once there's nothing left to run.
+        if(mShutdown)
+        {
+            break;
+        }
+
+        // No jobs anywhere - sleep until one is added.
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        ++mSleepingCount;
+        mSleepCondVar.wait(lock, [this]() { return mQueuedJobCount > 0 || mShutdown; });
+        --mSleepingCount;
+    }
+}
\ No newline at end of file
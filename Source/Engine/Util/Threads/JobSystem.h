@@ -0,0 +1,263 @@
+//
+// Clark Kromenaker
+//
+// A work-stealing job system: a set of worker threads that run small units of work ("jobs").
+//
+// Each worker has its own queue of jobs, so workers rarely contend with each other:
+// - Jobs added from a worker thread go on that worker's own queue (and are run most-recent-first, while the data is still in cache).
+// - Jobs added from any other thread go on a shared queue, which is run in the order jobs were added.
+// - A worker with nothing to do steals jobs from other workers.
+//
+// Jobs can be grouped with a JobCounter, which can be waited on. While waiting, the waiting thread helps run jobs in that group, rather than sitting idle.
+// It never runs jobs from other groups, since those could take much longer than the group being waited on (e.g. an asset load).
+// A job can also depend on a counter - it won't be started until all jobs in that counter are done.
+//
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A callable "void()" object, similar to std::function.
+// But small callables (most lambdas) are stored inline, rather than in a separate heap allocation.
+class JobFunction
+{
+public:
+    // Big enough to hold a lambda that captures two std::functions and a pointer - the largest capture in ThreadPool::AddTask.
+    // std::function's size differs between standard libraries, so this is derived from it rather than hardcoded.
+    static const size_t kInlineSize = 2 * sizeof(std::function<void()>) + sizeof(void*);
+
+    JobFunction() = default;
+
+    template<typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, JobFunction>::value>>
+    JobFunction(F&& func)
+    {
+        using FuncType = std::decay_t<F>;
+
+        // Callables that can be empty (std::function, function pointers) leave this JobFunction empty too.
+        if constexpr(std::is_constructible<bool, const FuncType&>::value)
+        {
+            if(!static_cast<bool>(func)) { return; }
+        }
+
+        if constexpr(sizeof(FuncType) <= kInlineSize && alignof(FuncType) <= alignof(std::max_align_t))
+        {
+            new(mStorage) FuncType(std::forward<F>(func));
+            mOps = &InlineOps<FuncType>::kOps;
+        }
+        else
+        {
+            new(mStorage) FuncType*(new FuncType(std::forward<F>(func)));
+            mOps = &HeapOps<FuncType>::kOps;
+        }
+    }
+
+    JobFunction(JobFunction&& other) noexcept { MoveFrom(other); }
+    JobFunction& operator=(JobFunction&& other) noexcept
+    {
+        if(this != &other)
+        {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+    ~JobFunction() { Reset(); }
+
+    // Not copyable - the stored callable may not be.
+    JobFunction(const JobFunction&) = delete;
+    JobFunction& operator=(const JobFunction&) = delete;
+
+    void operator()() { mOps->invoke(mStorage); }
+    explicit operator bool() const { return mOps != nullptr; }
+
+private:
+    // Operations for the stored callable type.
+    struct Ops
+    {
+        void (*invoke)(void* storage);
+        void (*move)(void* dest, void* source);
+        void (*destroy)(void* storage);
+    };
+
+    template<typename FuncType>
+    struct InlineOps
+    {
+        static void Invoke(void* storage) { (*static_cast<FuncType*>(storage))(); }
+        static void Move(void* dest, void* source)
+        {
+            new(dest) FuncType(std::move(*static_cast<FuncType*>(source)));
+            static_cast<FuncType*>(source)->~FuncType();
+        }
+        static void Destroy(void* storage) { static_cast<FuncType*>(storage)->~FuncType(); }
+        static constexpr Ops kOps { &Invoke, &Move, &Destroy };
+    };
+
+    template<typename FuncType>
+    struct HeapOps
+    {
+        static void Invoke(void* storage) { (**static_cast<FuncType**>(storage))(); }
+        static void Move(void* dest, void* source) { new(dest) FuncType*(*static_cast<FuncType**>(source)); }
+        static void Destroy(void* storage) { delete *static_cast<FuncType**>(storage); }
+        static constexpr Ops kOps { &Invoke, &Move, &Destroy };
+    };
+
+    alignas(std::max_align_t) unsigned char mStorage[kInlineSize];
+    const Ops* mOps = nullptr;
+
+    void MoveFrom(JobFunction& other)
+    {
+        if(other.mOps != nullptr)
+        {
+            other.mOps->move(mStorage, other.mStorage);
+            mOps = other.mOps;
+            other.mOps = nullptr;
+        }
+    }
+
+    void Reset()
+    {
+        if(mOps != nullptr)
+        {
+            mOps->destroy(mStorage);
+            mOps = nullptr;
+        }
+    }
+};
+
+// Counts outstanding jobs in a group. Must outlive all jobs added with it (wait on it before it goes out of scope).
+class JobCounter
+{
+public:
+    JobCounter() = default;
+
+    // Not copyable - jobs hold a pointer to their counter.
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool IsDone() const
+    {
+        // Locking ensures that the job that finished the group is fully done with this counter.
+        // Otherwise, the counter might be destroyed while that job is still using it.
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mCount == 0;
+    }
+
+private:
+    friend class JobSystem;
+
+    // Number of jobs in the group that haven't finished.
+    int mCount = 0;
+
+    // Jobs waiting for this group to finish before they can start.
+    struct PendingJob
+    {
+        class JobSystem* jobSystem = nullptr;
+        JobFunction function;
+        JobCounter* counter = nullptr;
+    };
+    std::vector<PendingJob> mDependentJobs;
+
+    mutable std::mutex mMutex;
+
+    // Incremented each time a job in the group is queued or finishes. Threads waiting on the group sleep until this changes.
+    uint32_t mChangeCount = 0;
+    std::condition_variable mChangedCondVar;
+};
+
+class JobSystem
+{
+public:
+    explicit JobSystem(int threadCount = 0);
+    ~JobSystem();
+
+    // Worker threads can only be started once. If no threads are started, jobs are run immediately when added.
+    void Start(int threadCount);
+    void Shutdown();
+
+    int GetThreadCount() const { return static_cast<int>(mWorkers.size()); }
+
+    // Adds a job to be run on a worker thread. If a counter is provided, it's incremented now, and decremented when the job finishes.
+    void AddJob(JobFunction function, JobCounter* counter = nullptr);
+
+    // Like AddJob, but the job isn't started until all jobs in the "dependency" group are done.
+    void AddJobAfter(JobCounter& dependency, JobFunction function, JobCounter* counter = nullptr);
+
+    // Waits for all jobs in a group to finish. The calling thread helps run jobs in the group while it waits.
+    // If none of the group's jobs are queued (they're running on other threads, or waiting on a dependency), the calling thread sleeps.
+    void Wait(JobCounter& counter);
+
+    // Calls func(index) for every index in [begin, end), spread across all threads (including the calling thread).
+    // Indexes are handed out in chunks of "grainSize" indexes, so each job does a worthwhile amount of work.
+    template<typename F>
+    void ParallelFor(size_t begin, size_t end, size_t grainSize, const F& func);
+
+private:
+    struct Job
+    {
+        JobFunction function;
+        JobCounter* counter = nullptr;
+    };
+
+    struct Worker
+    {
+        // Jobs added by this worker. The owner takes jobs from the back; other workers steal from the front.
+        std::deque<Job> jobs;
+        std::mutex mutex;
+        std::thread thread;
+    };
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+
+    // Jobs added from threads that aren't workers (such as the main thread). Run in the order added.
+    std::deque<Job> mSharedJobs;
+    std::mutex mSharedJobsMutex;
+
+    // Jobs waiting to be run, across all queues. Used to decide whether idle workers should sleep.
+    std::atomic<int> mQueuedJobCount { 0 };
+
+    // Idle workers sleep until new jobs are added.
+    std::atomic<int> mSleepingCount { 0 };
+    std::mutex mSleepMutex;
+    std::condition_variable mSleepCondVar;
+
+    // If true, workers exit.
+    std::atomic<bool> mShutdown { false };
+
+    void PushJob(Job&& job);
+    bool PopJob(Job& outJob);
+    bool PopJobInGroup(const JobCounter& counter, Job& outJob);
+    bool RunOneJob();
+    void RunJob(Job& job);
+    void FinishJob(JobCounter* counter);
+    void WorkerThread(int workerIndex);
+};
+
+template<typename F>
+void JobSystem::ParallelFor(size_t begin, size_t end, size_t grainSize, const F& func)
+{
+    if(begin >= end) { return; }
+    if(grainSize == 0) { grainSize = 1; }
+
+    // Add a job per chunk. Any thread (including this one, while waiting) can pick them up.
+    JobCounter counter;
+    for(size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+    {
+        size_t chunkEnd = (end - chunkBegin > grainSize) ? chunkBegin + grainSize : end;
+        AddJob([&func, chunkBegin, chunkEnd]() {
+            for(size_t i = chunkBegin; i < chunkEnd; ++i)
+            {
+                func(i);
+            }
+        }, &counter);
+    }
+    Wait(counter);
+}
\ No newline at end of file
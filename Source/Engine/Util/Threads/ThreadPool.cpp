@@ -1,113 +1,49 @@
 #include "ThreadPool.h"
 
-#include <thread>
-
 #include "ThreadUtil.h"
 
-ThreadedTaskQueue::ThreadedTaskQueue(int threadCount)
-{
-    AddThreads(threadCount);
-}
-
-ThreadedTaskQueue::~ThreadedTaskQueue()
-{
-    Shutdown();
-}
-
-void ThreadedTaskQueue::AddThreads(int count)
-{
-    for(int i = 0; i < count; i++)
-    {
-        mThreads.emplace_back([this] { TaskThread(); });
-    }
-}
+JobSystem ThreadPool::sJobSystem;
 
-void ThreadedTaskQueue::Shutdown()
+void ThreadPool::Init(int threadCount)
 {
-    mMutex.lock();
-    mShutdown = true;
-    mMutex.unlock();
-
-    mCondVar.notify_all();
-
-    for(auto& thread : mThreads)
-    {
-        if(thread.joinable())
-        {
-            thread.join();
-        }
-    }
+    sJobSystem.Start(threadCount);
 }
 
-void ThreadedTaskQueue::AddTask(const std::function<void()>& task, const std::function<void()>& callback)
+void ThreadPool::Shutdown()
 {
-    // Wrap the task in a void(void*) lambda so it can be stored in the list successfully.
-    AddTask([task](void* arg) {
-        task();
-    }, nullptr, callback);
+    sJobSystem.Shutdown();
 }
 
-void ThreadedTaskQueue::AddTask(const std::function<void(void*)>& task, void* context, const std::function<void()>& callback)
+void ThreadPool::AddTask(const std::function<void()>& task, const std::function<void()>& callback)
 {
     if(task != nullptr)
     {
-        mMutex.lock();
-        mTasks.emplace(task, context, callback);
-        mMutex.unlock();
-
-        mCondVar.notify_one();
+        sJobSystem.AddJob([task, callback]() {
+            task();
+
+            // After the task is done, run callback on main thread.
+            // Whoever added the task is waiting on this callback, so it's high priority.
+            if(callback != nullptr)
+            {
+                ThreadUtil::RunOnMainThread(callback, ThreadUtil::Priority::High);
+            }
+        });
     }
 }
 
-void ThreadedTaskQueue::TaskThread()
+void ThreadPool::AddTask(const std::function<void(void*)>& task, void* context, const std::function<void()>& callback)
 {
-    while(true)
+    if(task != nullptr)
     {
-        // Lock mutex to check task list.
-        std::unique_lock<std::mutex> lock(mMutex);
-
-        // If task queue is empty (and not shutting down), wait.
-        while(mTasks.empty() && !mShutdown)
-        {
-            mCondVar.wait(lock);
-        }
-
-        // If shutting down, just return.
-        if(mShutdown) { return; }
-
-        // Grab a task off the list.
-        Task task = mTasks.front();
-        mTasks.pop();
-
-        // Done with task list for now.
-        lock.unlock();
-
-        // Do the task.
-        task.task(task.context);
-
-        // After the task is done, run callback on main thread.
-        ThreadUtil::RunOnMainThread(task.callback);
+        sJobSystem.AddJob([task, context, callback]() {
+            task(context);
+
+            // After the task is done, run callback on main thread.
+            // Whoever added the task is waiting on this callback, so it's high priority.
+            if(callback != nullptr)
+            {
+                ThreadUtil::RunOnMainThread(callback, ThreadUtil::Priority::High);
+            }
+        });
     }
-}
-
-ThreadedTaskQueue ThreadPool::sTaskQueue;
-
-void ThreadPool::Init(int threadCount)
-{
-    sTaskQueue.AddThreads(threadCount);
-}
-
-void ThreadPool::Shutdown()
-{
-    sTaskQueue.Shutdown();
-}
-
-void ThreadPool::AddTask(const std::function<void()>& task, const std::function<void()>& callback)
-{
-    sTaskQueue.AddTask(task, callback);
-}
-
-void ThreadPool::AddTask(const std::function<void(void*)>& task, void* context, const std::function<void()>& callback)
-{
-    sTaskQueue.AddTask(task, context, callback);
 }
\ No newline at end of file
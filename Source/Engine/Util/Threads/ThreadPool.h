@@ -4,61 +4,12 @@
 // A thread pool provides a generalized/simple way to run code on background threads.
 // Just add a task and the next available thread will do the work.
 //
+// The pool is a job system shared by the whole engine, so it also supports waiting on groups of jobs, dependencies, and parallel-for.
+//
 #pragma once
-#include <condition_variable>
 #include <functional>
-#include <mutex>
-#include <queue>
-#include <thread>
-#include <utility>
-#include <vector>
-
-class ThreadedTaskQueue
-{
-public:
-    ThreadedTaskQueue(int threadCount = 0);
-    ~ThreadedTaskQueue();
-
-    void AddThreads(int count);
-    void Shutdown();
-
-    void AddTask(const std::function<void()>& task, const std::function<void()>& callback = nullptr);
-    void AddTask(const std::function<void(void*)>& task, void* context = nullptr, const std::function<void()>& callback = nullptr);
-
-private:
-    struct Task
-    {
-        // The task and task context.
-        std::function<void(void*)> task;
-        void* context = nullptr;
-
-        // A callback for when the task completes.
-        std::function<void()> callback;
 
-        Task(std::function<void(void*)> task, void* context, std::function<void()> callback) :
-            task(std::move(task)),
-            context(context),
-            callback(std::move(callback))
-        {
-
-        }
-    };
-
-    // Tasks waiting to be completed.
-    std::queue<Task> mTasks;
-
-    // If true, task queue is shutting down. Worker threads will exit.
-    bool mShutdown = false;
-
-    // Mutex/condition variable to deal with multi-threaded access to shared data.
-    std::mutex mMutex;
-    std::condition_variable mCondVar;
-
-    // Threads spawned for this task queue.
-    std::vector<std::thread> mThreads;
-
-    void TaskThread();
-};
+#include "JobSystem.h"
 
 class ThreadPool
 {
@@ -66,11 +17,21 @@ public:
     static void Init(int threadCount);
     static void Shutdown();
 
+    static int GetThreadCount() { return sJobSystem.GetThreadCount(); }
+
+    // Adds a task. When the task is done, the callback (if any) is called on the main thread.
     static void AddTask(const std::function<void()>& task, const std::function<void()>& callback = nullptr);
     static void AddTask(const std::function<void(void*)>& task, void* context = nullptr, const std::function<void()>& callback = nullptr);
 
+    // Lower-level job functions - see JobSystem.
+    static void AddJob(JobFunction function, JobCounter* counter = nullptr) { sJobSystem.AddJob(std::move(function), counter); }
+    static void AddJobAfter(JobCounter& dependency, JobFunction function, JobCounter* counter = nullptr) { sJobSystem.AddJobAfter(dependency, std::move(function), counter); }
+    static void Wait(JobCounter& counter) { sJobSystem.Wait(counter); }
+
+    template<typename F>
+    static void ParallelFor(size_t begin, size_t end, size_t grainSize, const F& func) { sJobSystem.ParallelFor(begin, end, grainSize, func); }
+
 private:
-    // Just uses a threaded task queue internally.
-    // The thread pool is really just a static instance of a task queue!
-    static ThreadedTaskQueue sTaskQueue;
+    // The thread pool is really just a static instance of a job system!
+    static JobSystem sJobSystem;
 };
\ No newline at end of file
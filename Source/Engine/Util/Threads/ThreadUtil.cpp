@@ -1,9 +1,26 @@
 #include "ThreadUtil.h"
 
+#include <chrono>
+
 std::thread::id ThreadUtil::sMainThreadId;
 
-std::vector<std::function<void()>> ThreadUtil::sMainThreadFuncs;
-std::mutex ThreadUtil::sMutex;
+ConcurrentQueue<JobFunction, 1024> ThreadUtil::sMainThreadFuncs;
+
+std::deque<JobFunction> ThreadUtil::sOverflowFuncs;
+std::atomic<bool> ThreadUtil::sOverflowing(false);
+std::mutex ThreadUtil::sOverflowMutex;
+
+std::deque<JobFunction> ThreadUtil::sPendingOverflowFuncs;
+
+std::deque<JobFunction> ThreadUtil::sHighPriorityFuncs;
+std::atomic<uint32_t> ThreadUtil::sHighPriorityQueuedCount(0);
+std::mutex ThreadUtil::sHighPriorityMutex;
+
+std::atomic<uint32_t> ThreadUtil::sPeakQueuedCount(0);
+std::atomic<uint32_t> ThreadUtil::sOverflowCount(0);
+std::atomic<uint32_t> ThreadUtil::sOverflowQueuedCount(0);
+uint32_t ThreadUtil::sLastRunCount = 0;
+float ThreadUtil::sLastRunMilliseconds = 0.0f;
 
 void ThreadUtil::Init()
 {
@@ -16,30 +33,111 @@ bool ThreadUtil::OnMainThread()
     return sMainThreadId == std::this_thread::get_id();
 }
 
-void ThreadUtil::RunOnMainThread(const std::function<void()>& func)
+void ThreadUtil::RunOnMainThread(JobFunction func, Priority priority)
 {
-    if(func != nullptr)
+    if(func)
     {
         if(OnMainThread())
         {
             func();
         }
+        else if(priority == Priority::High)
+        {
+            std::lock_guard<std::mutex> lock(sHighPriorityMutex);
+            sHighPriorityFuncs.push_back(std::move(func));
+            ++sHighPriorityQueuedCount;
+        }
         else
         {
-            sMutex.lock();
-            sMainThreadFuncs.push_back(func);
-            sMutex.unlock();
+            // Usually, the function goes right in the queue.
+            if(sOverflowing || !sMainThreadFuncs.Push(std::move(func)))
+            {
+                // The queue is full (or was recently full) - use the overflow list.
+                std::lock_guard<std::mutex> lock(sOverflowMutex);
+                sOverflowFuncs.push_back(std::move(func));
+                sOverflowing = true;
+                ++sOverflowCount;
+                ++sOverflowQueuedCount;
+            }
+
+            // Track the largest the queue has been.
+            uint32_t queuedCount = sMainThreadFuncs.GetSize() + sOverflowQueuedCount;
+            uint32_t peakQueuedCount = sPeakQueuedCount.load(std::memory_order_relaxed);
+            while(queuedCount > peakQueuedCount && !sPeakQueuedCount.compare_exchange_weak(peakQueuedCount, queuedCount, std::memory_order_relaxed)) { }
         }
     }
 }
 
-void ThreadUtil::RunFunctionsOnMainThread()
+void ThreadUtil::RunFunctionsOnMainThread(float maxMilliseconds)
 {
-    sMutex.lock();
-    for(auto& func : sMainThreadFuncs)
+    // This uses the standard clock (rather than a Stopwatch) so threading code doesn't depend on SDL.
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    auto getMilliseconds = [](std::chrono::steady_clock::time_point since) {
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - since).count();
+    };
+
+    // High priority functions run first, all of them. They don't count against the time limit.
+    uint32_t runCount = 0;
+    JobFunction func;
+    if(sHighPriorityQueuedCount > 0)
+    {
+        std::deque<JobFunction> highPriorityFuncs;
+        {
+            std::lock_guard<std::mutex> lock(sHighPriorityMutex);
+            highPriorityFuncs.swap(sHighPriorityFuncs);
+            sHighPriorityQueuedCount = 0;
+        }
+        for(JobFunction& highPriorityFunc : highPriorityFuncs)
+        {
+            highPriorityFunc();
+            ++runCount;
+        }
+    }
+
+    // Returns true if there's still time to run another function.
+    std::chrono::steady_clock::time_point normalStartTime = std::chrono::steady_clock::now();
+    uint32_t normalRunCount = 0;
+    auto hasTime = [&getMilliseconds, &normalRunCount, normalStartTime, maxMilliseconds]() {
+        return normalRunCount == 0 || maxMilliseconds <= 0.0f || getMilliseconds(normalStartTime) < maxMilliseconds;
+    };
+
+    while(hasTime())
     {
+        // Functions taken from the overflow list were queued before anything now in the queue, so they go first.
+        if(!sPendingOverflowFuncs.empty())
+        {
+            func = std::move(sPendingOverflowFuncs.front());
+            sPendingOverflowFuncs.pop_front();
+        }
+        else if(!sMainThreadFuncs.Pop(func))
+        {
+            // The queue is empty. If any functions overflowed, they're next.
+            // Once they're taken, new functions can go in the queue again.
+            if(!sOverflowing) { break; }
+            {
+                std::lock_guard<std::mutex> lock(sOverflowMutex);
+                sPendingOverflowFuncs.swap(sOverflowFuncs);
+                sOverflowQueuedCount = 0;
+                sOverflowing = false;
+            }
+            continue;
+        }
+
         func();
+        ++normalRunCount;
     }
-    sMainThreadFuncs.clear();
-    sMutex.unlock();
+
+    sLastRunCount = runCount + normalRunCount;
+    sLastRunMilliseconds = getMilliseconds(startTime);
+}
+
+ThreadUtil::MainThreadQueueStats ThreadUtil::GetMainThreadQueueStats()
+{
+    MainThreadQueueStats stats;
+    stats.queuedCount = sMainThreadFuncs.GetSize() + sOverflowQueuedCount + static_cast<uint32_t>(sPendingOverflowFuncs.size()) + sHighPriorityQueuedCount;
+    stats.peakQueuedCount = sPeakQueuedCount;
+    stats.lastRunCount = sLastRunCount;
+    stats.lastRunMilliseconds = sLastRunMilliseconds;
+    stats.overflowCount = sOverflowCount;
+    return stats;
 }
\ No newline at end of file
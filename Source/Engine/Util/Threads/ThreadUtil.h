@@ -4,10 +4,14 @@
 // Misc thread utilities.
 //
 #pragma once
-#include <functional>
+#include <atomic>
+#include <cstdint>
+#include <deque>
 #include <mutex>
 #include <thread>
-#include <vector>
+
+#include "ConcurrentQueue.h"
+#include "JobSystem.h"
 
 class ThreadUtil
 {
@@ -18,15 +22,66 @@ public:
     // Are we currently on main thread?
     static bool OnMainThread();
 
+    // Most main thread functions can wait a frame if the main thread is busy.
+    // But some are engine-critical (e.g. load completion callbacks that the game is waiting on). Those should be high priority.
+    enum class Priority
+    {
+        Normal,
+        High
+    };
+
     // A centralized way to allow threads to call back to the main thread.
-    static void RunOnMainThread(const std::function<void()>& func);
-    static void RunFunctionsOnMainThread();
+    // If called on the main thread, the function runs immediately.
+    static void RunOnMainThread(JobFunction func, Priority priority = Priority::Normal);
+
+    // Runs functions queued for the main thread, in the order they were queued.
+    // High priority functions run first, and always run, regardless of any time limit.
+    // If a time limit is given, stops once it's used up, and the remaining functions run on the next call.
+    // At least one normal function always runs, so the queue keeps moving even if every function is slow.
+    static void RunFunctionsOnMainThread(float maxMilliseconds = 0.0f);
+
+    // Stats about the main thread function queue, for debugging/profiling. Call from the main thread.
+    struct MainThreadQueueStats
+    {
+        // Number of functions waiting to run, and the most that have ever been waiting at once.
+        uint32_t queuedCount = 0;
+        uint32_t peakQueuedCount = 0;
+
+        // Number of functions run, and how long they took, during the last RunFunctionsOnMainThread call.
+        uint32_t lastRunCount = 0;
+        float lastRunMilliseconds = 0.0f;
+
+        // Number of functions that didn't fit in the queue, and had to go in the (slower) overflow list.
+        uint32_t overflowCount = 0;
+    };
+    static MainThreadQueueStats GetMainThreadQueueStats();
 
 private:
     // The main thread's ID. Used to determine if functions are running on main thread.
     static std::thread::id sMainThreadId;
 
     // Functions that we want to run on main thread.
-    static std::vector<std::function<void()>> sMainThreadFuncs;
-    static std::mutex sMutex;
-};
+    // Most go in a lock-free queue, so worker threads don't fight over a lock (or with the main thread) to add them.
+    static ConcurrentQueue<JobFunction, 1024> sMainThreadFuncs;
+
+    // If the queue is full, functions go in an overflow list instead. Waiting for room could deadlock if the main thread is waiting on the worker!
+    // Once anything is in the overflow list, all functions go there until it's emptied, so functions still (mostly) run in order.
+    static std::deque<JobFunction> sOverflowFuncs;
+    static std::atomic<bool> sOverflowing;
+    static std::mutex sOverflowMutex;
+
+    // Functions taken from the overflow list that are waiting to run (main thread only). These run before anything in the queue.
+    static std::deque<JobFunction> sPendingOverflowFuncs;
+
+    // High priority functions. There are only ever a few of these, so a locked list is fine.
+    static std::deque<JobFunction> sHighPriorityFuncs;
+    static std::atomic<uint32_t> sHighPriorityQueuedCount;
+    static std::mutex sHighPriorityMutex;
+
+    // Stats.
+    static std::atomic<uint32_t> sPeakQueuedCount;
+    static std::atomic<uint32_t> sOverflowCount;
+    static std::atomic<uint32_t> sOverflowQueuedCount;
+    static uint32_t sLastRunCount;
+    static float sLastRunMilliseconds;
+};
\ No newline at end of file
@@ -27,13 +27,14 @@ namespace
         }
     }
 
-    int GetNounVerbCount(const std::string& noun, const std::string& verb, VerbType verbType)
+    int GetNounVerbCount(int noun, int verb, VerbType verbType)
     {
+        static const int kChatSymbol = gSymbols.Intern("Z_CHAT");
         if(verbType == VerbType::Topic)
         {
             return gGameProgress.GetTopicCount(noun, verb);
         }
-        else if(StringUtil::EqualsIgnoreCase(verb, "Z_CHAT"))
+        else if(verb == kChatSymbol)
         {
             return gGameProgress.GetChatCount(noun);
         }
@@ -592,6 +593,11 @@ bool ActionManager::IsActionSetForTimeblock(const std::string& assetName, const
 }
 
 bool ActionManager::IsCaseMet(const std::string& noun, const std::string& verb, const std::string& caseLabel, VerbType verbType) const
+{
+    return IsCaseMet(noun, verb, gSymbols.Find(noun), gSymbols.Find(verb), caseLabel, verbType);
+}
+
+bool ActionManager::IsCaseMet(const std::string& noun, const std::string& verb, int nounSymbol, int verbSymbol, const std::string& caseLabel, VerbType verbType) const
 {
     // Empty condition is automatically met.
     if(caseLabel.empty()) { return true; }
@@ -663,7 +669,7 @@ bool ActionManager::IsCaseMet(const std::string& noun, const std::string& verb,
                     topicCount = it3->second.size();
                 }
             }
-            return gGameProgress.GetTopicCount(noun, verb) == (topicCount - 1);
+            return gGameProgress.GetTopicCount(nounSymbol, verbSymbol) == (topicCount - 1);
         }
 
         // "ALL" is always met!
@@ -680,24 +686,24 @@ bool ActionManager::IsCaseMet(const std::string& noun, const std::string& verb,
     else if(StringUtil::EqualsIgnoreCase(caseLabel, "1ST_TIME"))
     {
         // Condition is met if this is the first time we've executed this action (noun/verb combo).
-        return GetNounVerbCount(noun, verb, verbType) == 0;
+        return GetNounVerbCount(nounSymbol, verbSymbol, verbType) == 0;
     }
     else if(StringUtil::EqualsIgnoreCase(caseLabel, "2CD_TIME") || StringUtil::EqualsIgnoreCase(caseLabel, "2ND_TIME"))
     {
         // A surprising way to abbreviate "2nd time"...
         // Condition is met if this is the 2nd time we did the action.
-        return GetNounVerbCount(noun, verb, verbType) == 1;
+        return GetNounVerbCount(nounSymbol, verbSymbol, verbType) == 1;
     }
     else if(StringUtil::EqualsIgnoreCase(caseLabel, "3RD_TIME"))
     {
         // And again for good measure. True if this is the 3rd time we did the action.
-        return GetNounVerbCount(noun, verb, verbType) == 2;
+        return GetNounVerbCount(nounSymbol, verbSymbol, verbType) == 2;
     }
     else if(StringUtil::EqualsIgnoreCase(caseLabel, "OTR_TIME"))
     {
         // Condition is met if this IS NOT the first time we've executed this action (noun/verb combo).
         // However, if 2nd/3rd time actions exist, they will have higher priority than this one.
-        return GetNounVerbCount(noun, verb, verbType) > 0;
+        return GetNounVerbCount(nounSymbol, verbSymbol, verbType) > 0;
     }
     else if(StringUtil::EqualsIgnoreCase(caseLabel, "DIALOGUE_TOPICS_LEFT"))
     {
@@ -751,7 +757,7 @@ Action* ActionManager::GetHighestPriorityAction(const std::string& noun, const s
             for(auto& entry : verbEntry->second)
             {
                 // The case must be met, for one.
-                bool caseMet = IsCaseMet(noun, verb, entry.first, verbType);
+                bool caseMet = IsCaseMet(noun, verb, entry.second->nounSymbol, entry.second->verbSymbol, entry.first, verbType);
                 if(!caseMet) { continue; }
 
                 // OK, this Action is totally valid!
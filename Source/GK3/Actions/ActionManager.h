@@ -190,6 +190,7 @@ private:
 
     // Returns true if the case for an action is met. A case can be a global condition, or some user-defined script to evaluate.
     bool IsCaseMet(const std::string& noun, const std::string& verb, const std::string& caseLabel, VerbType verbType = VerbType::Normal) const;
+    bool IsCaseMet(const std::string& noun, const std::string& verb, int nounSymbol, int verbSymbol, const std::string& caseLabel, VerbType verbType) const;
 
     // Populates provided map with actions that are valid for the given noun.
     Action* GetHighestPriorityAction(const std::string& noun, const std::string& verb, VerbType verbType) const;
@@ -114,6 +114,8 @@ void NVC::ParseFromData(uint8_t* data, uint32_t dataLength)
         // Second entry is the verb.
         IniKeyValue& second = line.entries[1];
         action.verb = second.key;
+        action.nounSymbol = gSymbols.Intern(action.noun);
+        action.verbSymbol = gSymbols.Intern(action.verb);
 
         // Third entry is always the case (requires a bit of trimming/conditioning sometimes).
         IniKeyValue& third = line.entries[2];
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "StringUtil.h"
+#include "SymbolTable.h"
 
 class GKActor;
 class SheepScript;
@@ -42,6 +43,10 @@ struct Action
     // The verb is what action we perform on the noun.
     std::string verb;
 
+    // Noun and verb as interned symbols - used to look up action counts quickly when evaluating cases.
+    int nounSymbol = kInvalidSymbol;
+    int verbSymbol = kInvalidSymbol;
+
     // The "case" for this action. A label that refers to a case under which this action is valid.
     // The label can refer to arbitrary SheepScript that evaluates to true/false in the NVC file.
     // Or, it can refer to a hard-coded global condition (e.g. ALL, GABE_ALL, GRACE_ALL).
@@ -45,6 +45,9 @@ Walker::~Walker()
 
 void Walker::SetWalkerBoundary(WalkerBoundary* walkerBoundary)
 {
+    // Any path being calculated by the old walker boundary is no longer wanted.
+    CancelPathRequest();
+
     // Remove from old walker boundary.
     if(mWalkerBoundary != nullptr)
     {
@@ -99,19 +102,21 @@ void Walker::WalkToGas(const Vector3& position, const Heading& heading, const st
 
 void Walker::WalkToSee(GKObject* target, const std::function<void()>& finishCallback)
 {
+    // A new walk replaces any walk still waiting on a path (and that walk's finish callback).
+    CancelPathRequest();
     mWalkToSeeTarget = target;
 
-    // Be sure to save finish callback in this case - it usually happens in walk to.
-    mFinishedPathCallback = finishCallback;
-
-    // Not from autoscript, for sure.
-    mFromAutoscript = false;
-
     // Check whether thing is already in view.
     // If so, we don't even need to walk (but may need to turn-to-face).
     Vector3 facingDir;
     if(IsWalkToSeeTargetInView(facingDir))
     {
+        // Be sure to save finish callback in this case - it usually happens when the walk starts.
+        mFinishedPathCallback = finishCallback;
+
+        // Not from autoscript, for sure.
+        mFromAutoscript = false;
+
         WalkOp currentWalkOp = GetCurrentWalkOp();
 
         // Time to create a new walk plan.
@@ -188,6 +193,9 @@ void Walker::SkipToEnd(bool alsoSkipWalkEndAnim)
 {
     if(!mAllowWalkSkip) { return; }
 
+    // If still waiting on a path, we need it now - we can't skip to the end of a path we don't have!
+    FinishPathRequestNow();
+
     // If not walking, or at the end of the walk, nothing to skip.
     WalkOp currentWalkOp = GetCurrentWalkOp();
     if(currentWalkOp == WalkOp::None)
@@ -267,6 +275,9 @@ void Walker::SkipToEnd(bool alsoSkipWalkEndAnim)
 void Walker::StopWalk()
 {
     // This function is used when the walk should stop IMMEDIATELY - only used in rare circumstances where anims interrupt the walk.
+    // If a path is being calculated, we don't want it anymore.
+    CancelPathRequest();
+
     // Clear the path - we're not using it anymore.
     mPath.clear();
 
@@ -281,6 +292,16 @@ void Walker::StopWalk()
     StopAllWalkAnimations();
 }
 
+Vector3 Walker::GetDestination() const
+{
+    // While waiting on a path, the destination is where we've been asked to walk to.
+    if(mPathRequestId != 0)
+    {
+        return mPendingWalk.position;
+    }
+    return !mPath.empty() ? mPath.front() : Vector3::Zero;
+}
+
 bool Walker::AtPosition(const Vector3& position, float maxDistance)
 {
     Vector3 myPosition = mGKOwner->GetPosition();
@@ -357,6 +378,12 @@ void Walker::OnUpdate(float deltaTime)
         }
     }
 
+    // If waiting on a path, and action manager is skipping, we can't wait for the path to arrive on a later frame.
+    if(mPathRequestId != 0 && gActionManager.IsSkippingCurrentAction())
+    {
+        FinishPathRequestNow();
+    }
+
     // Process outstanding walk actions.
     WalkOp currentWalkOp = GetCurrentWalkOp();
     if(currentWalkOp != WalkOp::None)
@@ -481,81 +508,120 @@ void Walker::OnUpdate(float deltaTime)
 }
 
 void Walker::WalkToInternal(const Vector3& position, const Heading& heading, const std::function<void()>& finishCallback, bool fromAutoscript, bool mustReachDestination)
+{
+    // A new walk replaces any walk still waiting on a path (and that walk's finish callback).
+    // This must happen first: once cancelled, the old request can't start its walk, or call back into this walker.
+    CancelPathRequest();
+
+    // The finish callback and autoscript flag are saved when the walk starts (see StartWalk), not here.
+    // Until the path arrives, the previous walk may still be in progress. If this request is cancelled before then (e.g. the walker boundary changes),
+    // the previous walk carries on with its own callback - it must not call this walk's callback.
+    WalkRequest walk;
+    walk.heading = heading;
+    walk.finishCallback = finishCallback;
+    walk.fromAutoscript = fromAutoscript;
+    walk.mustReachDestination = mustReachDestination;
+
+    // Make sure the passed in position is *actually* the position we will walk to.
+    // Sometimes the position given is under the floor or floating in the air - ground it.
+    walk.position = position;
+    walk.position.y = gSceneManager.GetScene()->GetFloorY(position);
+
+    // Do we need to walk?
+    walk.needsPath = !AtPosition(walk.position);
+    if(walk.needsPath)
+    {
+        // Attempt to find a path between current position and walk position.
+        walk.startPos = GetOwner()->GetPosition();
+        walk.endPos = walk.position;
+
+        // If we have a walk-to-see target, apply a slight bias towards walking to be "in front" of the thing.
+        // This helps in scenarios where the character should be looking at a surface, such as a painting or panel in the Museum.
+        if(mWalkToSeeTarget != nullptr)
+        {
+            walk.endPos = walk.position + mWalkToSeeTarget->GetForward() * 5.0f;
+        }
+    }
+
+    // If action skipping, we don't need a path - the walker is put directly at the desired position/heading.
+    bool skipping = gActionManager.IsSkippingCurrentAction() && mAllowWalkSkip;
+
+    // Actually do the pathfinding!
+    // This happens on a background thread - until the path arrives, we keep doing whatever we were doing (idling, turning, or walking a previous path).
+    if(walk.needsPath && !skipping && mWalkerBoundary != nullptr)
+    {
+        mPendingWalk = walk;
+
+        // Remove ourselves from the walker boundary temporarily so we don't try to path around ourselves.
+        // This seems like a HACK, but it might be a fine solution. Alternative is to pass "this" as an argument to FindPath.
+        mWalkerBoundary->RemoveWalker(this);
+
+        // Request the path. The request uses a snapshot of the walker boundary, so it's fine to add ourselves back right away.
+        mPathRequestId = mWalkerBoundary->FindPathAsync(walk.startPos, walk.endPos, [this](bool, std::vector<Vector3>& path){
+            mPathRequestId = 0;
+            WalkRequest pendingWalk = std::move(mPendingWalk);
+            mPendingWalk = WalkRequest();
+            StartWalk(pendingWalk, path);
+        });
+
+        // Add ourselves back to the walker boundary.
+        mWalkerBoundary->AddWalker(this);
+        return;
+    }
+
+    // No path to wait for, so the walk can start right away.
+    std::vector<Vector3> path;
+    StartWalk(walk, path);
+}
+
+void Walker::StartWalk(const WalkRequest& walk, std::vector<Vector3>& path)
 {
     // Save if from autoscript.
-    mFromAutoscript = fromAutoscript;
+    mFromAutoscript = walk.fromAutoscript;
 
     // Save finish callback.
-    mFinishedPathCallback = finishCallback;
+    mFinishedPathCallback = walk.finishCallback;
 
     // Time to create a new walk plan.
     WalkOp currentWalkOp = GetCurrentWalkOp();
     mWalkActions.clear();
 
-    // Make sure the passed in position is *actually* the position we will walk to.
-    // Sometimes the position given is under the floor or floating in the air - ground it.
-    Vector3 walkPosition = position;
-    walkPosition.y = gSceneManager.GetScene()->GetFloorY(position);
-
     // If action skipping, we don't need to find a path or do anything - just put the walker directly at the desired position/heading!
     if(gActionManager.IsSkippingCurrentAction() && mAllowWalkSkip)
     {
         StopAllWalkAnimations();
-        mGKOwner->SetPosition(walkPosition);
-        if(heading.IsValid())
+        mGKOwner->SetPosition(walk.position);
+        if(walk.heading.IsValid())
         {
-            mGKOwner->SetHeading(heading);
+            mGKOwner->SetHeading(walk.heading);
         }
-        if(finishCallback != nullptr)
+        if(walk.finishCallback != nullptr)
         {
-            finishCallback();
+            walk.finishCallback();
         }
         return;
     }
 
     // If heading is specified, save "turn to face" action.
-    if(heading.IsValid())
+    if(walk.heading.IsValid())
     {
-        mTurnToFaceDir = heading.ToDirection();
+        mTurnToFaceDir = walk.heading.ToDirection();
         mWalkActions.push_back(WalkOp::TurnToFace);
     }
 
     // Do we need to walk?
-    if(!AtPosition(walkPosition))
+    if(walk.needsPath)
     {
-        mPath.clear();
-
-        // Attempt to find a path between current position and walk position.
-        Vector3 startPos = GetOwner()->GetPosition();
-        Vector3 endPos = walkPosition;
-
-        // If we have a walk-to-see target, apply a slight bias towards walking to be "in front" of the thing.
-        // This helps in scenarios where the character should be looking at a surface, such as a painting or panel in the Museum.
-        if(mWalkToSeeTarget != nullptr)
-        {
-            endPos = walkPosition + mWalkToSeeTarget->GetForward() * 5.0f;
-        }
-
-        // Actually do the pathfinding!
-        if(mWalkerBoundary != nullptr)
-        {
-            // Remove ourselves from the walker boundary temporarily so we don't try to path around ourselves.
-            // This seems like a HACK, but it might be a fine solution. Alternative is to pass "this" as an argument to FindPath.
-            mWalkerBoundary->RemoveWalker(this);
-
-            // Find the path.
-            mWalkerBoundary->FindPath(startPos, endPos, mPath);
-
-            // Add ourselves back to the walker boundary.
-            mWalkerBoundary->AddWalker(this);
-        }
+        mPath = std::move(path);
+        const Vector3& startPos = walk.startPos;
+        const Vector3& endPos = walk.endPos;
 
         // Whether a path was found or not actually isn't that important here - even when a path isn't found, mPath contains a "best effort" to get close to the goal.
         // What IS important is whether we MUST reach the goal or if "best effort" is good enough.
         //
         // If it's not important to reach our destination exactly, then there's nothing more to do - we already have a "best effort" path.
         // If it is important though, we must ensure the path actually HAS the destination position present!
-        if(mustReachDestination)
+        if(walk.mustReachDestination)
         {
             // If the path is empty, and we must reach our destination, we've just gotta go straight there - that's the best we can do at this point.
             if(mPath.empty())
@@ -872,6 +938,12 @@ void Walker::OnWalkToFinished()
     // No more path.
     mPath.clear();
 
+    // If a new walk is waiting on a path, the walk that just finished was replaced by it - the new walk will start soon.
+    if(mPathRequestId != 0)
+    {
+        return;
+    }
+
     // No more target.
     mWalkToSeeTarget = nullptr;
 
@@ -891,6 +963,38 @@ void Walker::OnWalkToFinished()
     }
 }
 
+void Walker::CancelPathRequest()
+{
+    if(mPathRequestId != 0)
+    {
+        if(mWalkerBoundary != nullptr)
+        {
+            mWalkerBoundary->CancelPathRequest(mPathRequestId);
+        }
+        mPathRequestId = 0;
+        mPendingWalk = WalkRequest();
+    }
+}
+
+void Walker::FinishPathRequestNow()
+{
+    if(mPathRequestId == 0) { return; }
+
+    // Stop waiting on the background thread.
+    WalkRequest walk = std::move(mPendingWalk);
+    CancelPathRequest();
+
+    // Calculate the path right here instead (not needed if skipping - walker will be put at the end position anyway).
+    std::vector<Vector3> path;
+    if(mWalkerBoundary != nullptr && !(gActionManager.IsSkippingCurrentAction() && mAllowWalkSkip))
+    {
+        mWalkerBoundary->RemoveWalker(this);
+        mWalkerBoundary->FindPath(walk.startPos, walk.endPos, path);
+        mWalkerBoundary->AddWalker(this);
+    }
+    StartWalk(walk, path);
+}
+
 bool Walker::IsWalkToSeeTargetInView(Vector3& outTurnToFaceDir) const
 {
     return IsWalkToSeeTargetInView(mGKOwner->GetHeadPosition(), outTurnToFaceDir);
@@ -12,6 +12,7 @@
 #include <functional>
 #include <vector>
 
+#include "Heading.h"
 #include "Vector3.h"
 
 class Animation;
@@ -19,7 +20,6 @@ struct CharacterConfig;
 class GKActor;
 class GKObject;
 class GKProp;
-class Heading;
 class PersistState;
 class Texture;
 class VertexAnimation;
@@ -49,9 +49,9 @@ public:
     void StopWalk();
 
     bool AtPosition(const Vector3& position, float maxDistance = kAtNodeDist);
-    bool IsWalking() const { return !mWalkActions.empty(); }
-    bool IsWalkingExceptTurn() const { return IsWalking() && mWalkActions.back() != WalkOp::TurnToFace; }
-    Vector3 GetDestination() const { return !mPath.empty() ? mPath.front() : Vector3::Zero; }
+    bool IsWalking() const { return !mWalkActions.empty() || mPathRequestId != 0; }
+    bool IsWalkingExceptTurn() const { return mPathRequestId != 0 || (!mWalkActions.empty() && mWalkActions.back() != WalkOp::TurnToFace); }
+    Vector3 GetDestination() const;
 
     bool IsWalkAnimation(VertexAnimation* vertexAnim) const;
 
@@ -140,12 +140,41 @@ private:
     // Only use case is the demon in the final fight so far.
     bool mAllowWalkSkip = true;
 
+    // PATHFINDING
+    // Paths are calculated on a background thread, so that a slow path doesn't stall the game.
+    // While waiting for the path, the walker keeps doing whatever it was doing (idling, turning, or following a previous path).
+    struct WalkRequest
+    {
+        // Where to walk to (at floor height), and the heading to face when there (if valid).
+        Vector3 position;
+        Heading heading = Heading::None;
+
+        // The start and end of the path to find.
+        Vector3 startPos;
+        Vector3 endPos;
+
+        // If false, we're already at the position - a path isn't needed.
+        bool needsPath = false;
+
+        bool fromAutoscript = false;
+        bool mustReachDestination = false;
+        std::function<void()> finishCallback = nullptr;
+    };
+
+    // The walk waiting on a path, and the ID of the path request (zero if no path request is in progress).
+    WalkRequest mPendingWalk;
+    uint32_t mPathRequestId = 0;
+
     // REGION SUPPORT
     // A callback for exiting a region.
     int mExitRegionIndex = -1;
     std::function<void()> mExitRegionCallback = nullptr;
 
     void WalkToInternal(const Vector3& position, const Heading& heading, const std::function<void()>& finishCallback, bool fromAutoscript, bool mustReachDestination);
+    void StartWalk(const WalkRequest& walk, std::vector<Vector3>& path);
+
+    void CancelPathRequest();
+    void FinishPathRequestNow();
 
     void PopAndNextAction();
     void NextAction();
@@ -1,12 +1,17 @@
 #include "WalkerBoundary.h"
 
+#include <algorithm>
+#include <cmath>
 #include <queue>
 
-#include "Actor.h"
-#include "Debug.h"
 #include "GMath.h"
 #include "PersistState.h"
 #include "ResizableQueue.h"
+#include "StringUtil.h"
+#include "ThreadPool.h"
+
+#include "Actor.h"
+#include "Debug.h"
 #include "Texture.h"
 #include "Walker.h"
 
@@ -32,6 +37,46 @@ namespace
             current.y -= 1;
         }
     }
+
+    // Flags stored per pixel in the walkable map. A pixel is walkable if no flags are set.
+    const uint8_t kStaticBlocked = 1 << 0; // blocked by an unwalkable region or rect
+    const uint8_t kWalkerBlocked = 1 << 1; // blocked by a nearby walker
+
+    // Each walker's radius is about 10 units. There are outliers (like Chicken or Demon), but this mostly works.
+    // BUT we need to factor in the radius of this walker AND myself - so we actually use 20 here!
+    //TODO: If the radius differed per walker, we'd want to query the walkers and sum the radii.
+    const float kCombinedRadii = 20.0f;
+
+    // Max number of recently calculated paths to remember.
+    const size_t kMaxCachedPaths = 8;
+
+    Vector3 GetWalkerPosition(const Walker* walker)
+    {
+        return walker->GetOwner()->GetPosition();
+    }
+
+    bool AreWalkerPositionsEqual(const std::vector<Vector3>& a, const std::vector<Vector3>& b)
+    {
+        // Vector3 equality is approximate, but even a tiny move can change which pixels a walker blocks - so compare exactly.
+        if(a.size() != b.size()) { return false; }
+        for(size_t i = 0; i < a.size(); ++i)
+        {
+            if(a[i].x != b[i].x || a[i].y != b[i].y || a[i].z != b[i].z)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+WalkerBoundary::~WalkerBoundary()
+{
+    // Any path requests still in progress should not call back to this walker boundary.
+    for(auto& request : mPathRequests)
+    {
+        request->cancelled = true;
+    }
 }
 
 bool WalkerBoundary::FindPath(const Vector3& fromWorldPos, const Vector3& toWorldPos, std::vector<Vector3>& outPath)
@@ -39,6 +84,9 @@ bool WalkerBoundary::FindPath(const Vector3& fromWorldPos, const Vector3& toWorl
     // Make sure path vector is empty.
     outPath.clear();
 
+    // Make sure walkability info is up-to-date - walkers may have moved since the last path was calculated.
+    RefreshWalkableMap();
+
     // Pick goal position. If "to" is walkable, we can use it directly.
     // Otherwise, find the nearest walkable position to "to".
     Vector2 goal;
@@ -65,6 +113,19 @@ bool WalkerBoundary::FindPath(const Vector3& fromWorldPos, const Vector3& toWorl
         start = FindNearestWalkableTexturePosToWorldPos(fromWorldPos);
     }
 
+    // If we recently calculated this same path, and nothing has changed walkability since, just reuse it.
+    for(auto it = mPathCache.begin(); it != mPathCache.end(); ++it)
+    {
+        if(it->start == start && it->goal == goal && it->walkableVersion == mWalkableVersion && AreWalkerPositionsEqual(it->walkerPositions, mStampedWalkerPositions))
+        {
+            outPath = it->path;
+            bool foundCachedPath = it->foundPath;
+
+            // Move to front, so the least recently used path is the first to be evicted.
+            std::rotate(mPathCache.begin(), it, it + 1);
+            return foundCachedPath;
+        }
+    }
     // Use BFS to find a path.
     // I have implementations of both BFS and A* below - I've consistently found BFS to have better performance and results than A*.
     // In hindsight, I think this is because: a) the graph has a ton of nodes, and b) edges between nodes _aren't really_ weighted.
@@ -72,21 +133,26 @@ bool WalkerBoundary::FindPath(const Vector3& fromWorldPos, const Vector3& toWorl
     // The loop here is to try using sparser graphs (and save a lot of time) if we can.
     // In a complex scene with a large walker boundary texture, the number of grid nodes is very large (170k in one case).
     // Usually, the system can successfully find a path when skipping a lot of those nodes. But worst case, we can use all nodes.
+    // The higher fidelity is only used for this path - a full fidelity search is quite slow, and the next path will likely succeed with a sparser graph.
+    int nodeSkip = mPathfindingNodeSkip;
     bool foundPath = false;
     std::vector<Vector2> path;
     while(!foundPath)
     {
-        foundPath = FindPathBFS(start, goal, path, mPathfindingNodeSkip);
+        foundPath = FindPathBFS(start, goal, path, nodeSkip);
         if(!foundPath)
         {
-            if(mPathfindingNodeSkip > 1)
+            // If start and goal are in different walkable areas, the goal can't be reached - no matter the graph fidelity.
+            // In that case, don't bother retrying; the "best effort" path will do (unless there isn't one yet).
+            if(nodeSkip > 1 && (path.empty() || IsInSameWalkableArea(start, goal)))
             {
                 printf("Failed to find path - trying again with higher fidelity\n");
-                mPathfindingNodeSkip /= 2;
+                nodeSkip /= 2;
             }
             else
             {
                 // If skip interval is already 1, we can't get any higher fidelity - the path just doesn't exist.
+                // Same if the goal is in a different area from the start.
                 break;
             }
         }
@@ -113,51 +179,51 @@ bool WalkerBoundary::FindPath(const Vector3& fromWorldPos, const Vector3& toWorl
 
             // ANYWAY, here's the idea: if the current index is less than 128, see if a neighbor is a lower palette index.
             // If so, we will want to walk there instead. If no, this is a less than ideal place to walk, but at least it is walkable.
-            int index = mTexture->GetPixelPaletteIndex(path[i].x, path[i].y);
+            int index = GetPaletteIndex(path[i].x, path[i].y);
             if(index < 128)
             {
                 while(true)
                 {
                     // If any up/down/left/right has a lower palette index, go there!
-                    if(mTexture->GetPixelPaletteIndex(path[i].x + 1, path[i].y) < index &&
+                    if(GetPaletteIndex(path[i].x + 1, path[i].y) < index &&
                        IsTexturePosWalkable(Vector2(path[i].x + 1, path[i].y)))
                     {
                         path[i].x += 1;
                     }
-                    else if(mTexture->GetPixelPaletteIndex(path[i].x - 1, path[i].y) < index &&
+                    else if(GetPaletteIndex(path[i].x - 1, path[i].y) < index &&
                             IsTexturePosWalkable(Vector2(path[i].x - 1, path[i].y)))
                     {
                         path[i].x -= 1;
                     }
-                    else if(mTexture->GetPixelPaletteIndex(path[i].x, path[i].y + 1) < index &&
+                    else if(GetPaletteIndex(path[i].x, path[i].y + 1) < index &&
                             IsTexturePosWalkable(Vector2(path[i].x, path[i].y + 1)))
                     {
                         path[i].y += 1;
                     }
-                    else if(mTexture->GetPixelPaletteIndex(path[i].x, path[i].y - 1) < index &&
+                    else if(GetPaletteIndex(path[i].x, path[i].y - 1) < index &&
                             IsTexturePosWalkable(Vector2(path[i].x, path[i].y - 1)))
                     {
                         path[i].y -= 1;
                     }
-                    else if(mTexture->GetPixelPaletteIndex(path[i].x + 1, path[i].y + 1) < index &&
+                    else if(GetPaletteIndex(path[i].x + 1, path[i].y + 1) < index &&
                             IsTexturePosWalkable(Vector2(path[i].x + 1, path[i].y + 1)))
                     {
                         path[i].x += 1;
                         path[i].y += 1;
                     }
-                    else if(mTexture->GetPixelPaletteIndex(path[i].x + 1, path[i].y - 1) < index &&
+                    else if(GetPaletteIndex(path[i].x + 1, path[i].y - 1) < index &&
                             IsTexturePosWalkable(Vector2(path[i].x + 1, path[i].y - 1)))
                     {
                         path[i].x += 1;
                         path[i].y -= 1;
                     }
-                    else if(mTexture->GetPixelPaletteIndex(path[i].x - 1, path[i].y - 1) < index &&
+                    else if(GetPaletteIndex(path[i].x - 1, path[i].y - 1) < index &&
                             IsTexturePosWalkable(Vector2(path[i].x - 1, path[i].y - 1)))
                     {
                         path[i].x -= 1;
                         path[i].y -= 1;
                     }
-                    else if(mTexture->GetPixelPaletteIndex(path[i].x - 1, path[i].y + 1) < index &&
+                    else if(GetPaletteIndex(path[i].x - 1, path[i].y + 1) < index &&
                             IsTexturePosWalkable(Vector2(path[i].x - 1, path[i].y + 1)))
                     {
                         path[i].x -= 1;
@@ -170,7 +236,7 @@ bool WalkerBoundary::FindPath(const Vector3& fromWorldPos, const Vector3& toWorl
                     }
 
                     // Update index being considered for next run through loop.
-                    index = mTexture->GetPixelPaletteIndex(path[i].x, path[i].y);
+                    index = GetPaletteIndex(path[i].x, path[i].y);
 
                     // If the palette index is below some threshold, we're in an "acceptably walkable" zone, so we can stop iterating.
                     if(index < 4)
@@ -206,7 +272,7 @@ bool WalkerBoundary::FindPath(const Vector3& fromWorldPos, const Vector3& toWorl
                     }
                     else
                     {
-                        int paletteIndex = mTexture->GetPixelPaletteIndex(current.x, current.y);
+                        int paletteIndex = GetPaletteIndex(current.x, current.y);
                         if(paletteIndex > 6 && paletteIndex < 128)
                         {
                             canWalk = false;
@@ -246,13 +312,64 @@ bool WalkerBoundary::FindPath(const Vector3& fromWorldPos, const Vector3& toWorl
         }
     }
 
+    // Remember this path, in case it's requested again.
+    CachedPath cachedPath;
+    cachedPath.start = start;
+    cachedPath.goal = goal;
+    cachedPath.walkableVersion = mWalkableVersion;
+    cachedPath.walkerPositions = mStampedWalkerPositions;
+    cachedPath.path = outPath;
+    cachedPath.foundPath = foundPath;
+    AddToPathCache(cachedPath);
+
     // Whether a path was generated or not, return whether we found a path.
     // The caller can decide if the "best effort" path is worth using at all, or if the walk should just be abandoned.
     return foundPath;
 }
 
+uint32_t WalkerBoundary::FindPathAsync(const Vector3& fromWorldPos, const Vector3& toWorldPos, const PathCallback& callback)
+{
+    // The search happens on a copy of this walker boundary, so it isn't affected by anything that happens on the main thread in the meantime.
+    std::shared_ptr<PathRequest> request = std::make_shared<PathRequest>();
+    request->id = mNextPathRequestId++;
+    request->snapshot = CreateSnapshot();
+    request->fromWorldPos = fromWorldPos;
+    request->toWorldPos = toWorldPos;
+    request->callback = callback;
+    mPathRequests.push_back(request);
+
+    ThreadPool::AddTask([request]() {
+        if(!request->cancelled)
+        {
+            request->foundPath = request->snapshot->FindPath(request->fromWorldPos, request->toWorldPos, request->path);
+        }
+    }, [this, request]() {
+        if(!request->cancelled)
+        {
+            OnPathRequestDone(request);
+        }
+    });
+    return request->id;
+}
+
+void WalkerBoundary::CancelPathRequest(uint32_t requestId)
+{
+    for(auto it = mPathRequests.begin(); it != mPathRequests.end(); ++it)
+    {
+        if((*it)->id == requestId)
+        {
+            (*it)->cancelled = true;
+            mPathRequests.erase(it);
+            return;
+        }
+    }
+}
+
 Vector3 WalkerBoundary::FindNearestWalkablePosition(const Vector3& worldPos) const
 {
+    // Make sure walkability info is up-to-date.
+    RefreshWalkableMap();
+
     // Easy case: the position provided is already walkable.
     if(IsWorldPosWalkable(worldPos)) { return worldPos; }
 
@@ -261,6 +378,48 @@ Vector3 WalkerBoundary::FindNearestWalkablePosition(const Vector3& worldPos) con
     return TexturePosToWorldPos(walkableTexturePos);
 }
 
+void WalkerBoundary::SetTexture(Texture* texture)
+{
+    mTexture = texture;
+
+    // Copy the texture data needed for pathfinding.
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> paletteIndexes;
+    if(texture != nullptr)
+    {
+        width = texture->GetWidth();
+        height = texture->GetHeight();
+        paletteIndexes.resize(width * height);
+        for(uint32_t y = 0; y < height; ++y)
+        {
+            for(uint32_t x = 0; x < width; ++x)
+            {
+                paletteIndexes[y * width + x] = texture->GetPixelPaletteIndex(x, y);
+            }
+        }
+    }
+    SetPaletteIndexes(width, height, std::move(paletteIndexes));
+}
+
+void WalkerBoundary::SetPaletteIndexes(uint32_t width, uint32_t height, std::vector<uint8_t> paletteIndexes)
+{
+    // Without any palette indexes, there's nothing to pathfind on - same as having no texture.
+    if(width == 0 || height == 0 || paletteIndexes.size() != width * height)
+    {
+        mTextureWidth = 0;
+        mTextureHeight = 0;
+        mPaletteIndexes = nullptr;
+    }
+    else
+    {
+        mTextureWidth = width;
+        mTextureHeight = height;
+        mPaletteIndexes = std::make_shared<const std::vector<uint8_t>>(std::move(paletteIndexes));
+    }
+    mWalkableMapDirty = true;
+}
+
 void WalkerBoundary::SetRegionBlocked(int regionIndex, int regionBoundaryIndex, bool blocked)
 {
     if(blocked)
@@ -273,6 +432,27 @@ void WalkerBoundary::SetRegionBlocked(int regionIndex, int regionBoundaryIndex,
         mUnwalkableRegions.erase(regionIndex);
         mUnwalkableRegions.erase(regionBoundaryIndex);
     }
+
+    // Update only the pixels in the affected regions.
+    // If the walkable map hasn't been built yet, no need - it'll take this change into account when it is built.
+    if(!mWalkableMapDirty && mPaletteIndexes != nullptr && !mWalkableMap.empty())
+    {
+        uint32_t width = mTextureWidth;
+        uint32_t height = mTextureHeight;
+        for(uint32_t y = 0; y < height; ++y)
+        {
+            for(uint32_t x = 0; x < width; ++x)
+            {
+                int region = GetPaletteIndex(x, y);
+                if(region == regionIndex || region == regionBoundaryIndex)
+                {
+                    uint8_t& flags = mWalkableMap[y * width + x];
+                    flags = IsStaticallyWalkable(x, y) ? (flags & ~kStaticBlocked) : (flags | kStaticBlocked);
+                }
+            }
+        }
+    }
+    OnStaticWalkabilityChanged();
 }
 
 int WalkerBoundary::GetRegionIndex(const Vector3& worldPos)
@@ -301,14 +481,21 @@ void WalkerBoundary::SetUnwalkableRect(const std::string& name, const Rect& worl
     Vector2 textureMax = WorldPosToTexturePos(Vector3(worldMax.x, 0.0f, worldMax.y));
 
     // Add or replace unwalkable rect.
+    Rect textureRect(textureMin, textureMax);
     if(index == -1)
     {
-        mUnwalkableRects.emplace_back(std::make_pair(name, Rect(textureMin, textureMax)));
+        mUnwalkableRects.emplace_back(std::make_pair(name, textureRect));
+        UpdateWalkableMapRegion(textureRect.GetMin(), textureRect.GetMax());
     }
     else
     {
-        mUnwalkableRects[index].second = Rect(textureMin, textureMax);
+        // The previously covered area may now be walkable, so it needs updating as well.
+        Rect oldTextureRect = mUnwalkableRects[index].second;
+        mUnwalkableRects[index].second = textureRect;
+        UpdateWalkableMapRegion(oldTextureRect.GetMin(), oldTextureRect.GetMax());
+        UpdateWalkableMapRegion(textureRect.GetMin(), textureRect.GetMax());
     }
+    OnStaticWalkabilityChanged();
 }
 
 void WalkerBoundary::ClearUnwalkableRect(const std::string& name)
@@ -318,7 +505,10 @@ void WalkerBoundary::ClearUnwalkableRect(const std::string& name)
     {
         if(StringUtil::EqualsIgnoreCase(mUnwalkableRects[i].first, name))
         {
+            Rect textureRect = mUnwalkableRects[i].second;
             mUnwalkableRects.erase(mUnwalkableRects.begin() + i);
+            UpdateWalkableMapRegion(textureRect.GetMin(), textureRect.GetMax());
+            OnStaticWalkabilityChanged();
             return;
         }
     }
@@ -337,7 +527,7 @@ void WalkerBoundary::DrawUnwalkableAreas()
     // Draw visualizations of walkers who will be pathed around.
     for(Walker* walker : mWalkers)
     {
-        Debug::DrawSphere(walker->GetOwner()->GetPosition(), 10.0f, Color32::Orange);
+        Debug::DrawSphere(GetWalkerPosition(walker), 10.0f, Color32::Orange);
     }
 }
 
@@ -363,6 +553,12 @@ void WalkerBoundary::OnPersist(PersistState& ps)
 {
     ps.Xfer(PERSIST_VAR(mUnwalkableRegions));
     ps.Xfer(PERSIST_VAR(mUnwalkableRects));
+
+    // Loaded regions/rects may be entirely different - rebuild walkability from scratch.
+    if(ps.IsLoading())
+    {
+        mWalkableMapDirty = true;
+    }
 }
 
 bool WalkerBoundary::IsWorldPosWalkable(const Vector3& worldPos) const
@@ -373,6 +569,17 @@ bool WalkerBoundary::IsWorldPosWalkable(const Vector3& worldPos) const
 
 bool WalkerBoundary::IsTexturePosWalkable(const Vector2& texturePos) const
 {
+    // Most checks are for positions within the texture, which can use the walkable map.
+    if(!mWalkableMapDirty && !mWalkableMap.empty())
+    {
+        int width = mTextureWidth;
+        int height = mTextureHeight;
+        if(texturePos.x >= 0 && texturePos.x < width && texturePos.y >= 0 && texturePos.y < height)
+        {
+            return mWalkableMap[static_cast<int>(texturePos.y) * width + static_cast<int>(texturePos.x)] == 0;
+        }
+    }
+
     // Unwalkable if region associated with this texture pos is in the unwalkable regions set.
     if(mUnwalkableRegions.count(GetRegionForTexturePos(texturePos)) > 0)
     {
@@ -393,15 +600,10 @@ bool WalkerBoundary::IsTexturePosWalkable(const Vector2& texturePos) const
     for(Walker* walker : mWalkers)
     {
         // Make y-pos equal so that we only consider distance on the x/z plane.
-        Vector3 walkerPos = walker->GetOwner()->GetPosition();
+        Vector3 walkerPos = GetWalkerPosition(walker);
         walkerPos.y = worldPos.y;
         float distSq = (worldPos - walkerPos).GetLengthSq();
-
-        // Each walker's radius is about 10 units. There are outliers (like Chicken or Demon), but this mostly works.
-        // BUT we need to factor in the radius of this walker AND myself - so we actually use 20 here!
-        //TODO: If the radius differed per walker, we'd want to query the walkers and sum the radii.
-        const float kCombinedRadiiSq = 20.0f * 20.0f;
-        if(distSq <= kCombinedRadiiSq)
+        if(distSq <= kCombinedRadii * kCombinedRadii)
         {
             return false;
         }
@@ -414,7 +616,7 @@ bool WalkerBoundary::IsTexturePosWalkable(const Vector2& texturePos) const
 Vector2 WalkerBoundary::WorldPosToTexturePos(const Vector3& worldPos) const
 {
     // If no texture, the end result is going to be zero.
-    if(mTexture == nullptr) { return Vector2::Zero; }
+    if(mPaletteIndexes == nullptr) { return Vector2::Zero; }
 
     // Add walker boundary's world position offset.
     // This causes the position to be relative to the texture's origin (lower left) instead of the world origin.
@@ -430,13 +632,13 @@ Vector2 WalkerBoundary::WorldPosToTexturePos(const Vector3& worldPos) const
     //std::cout << "Normalized Pos: " << position << std::endl;
 
     // Multiply by texture width/height to determine the pixel within the texture.
-    texturePos.x = texturePos.x * mTexture->GetWidth();
-    texturePos.y = texturePos.y * mTexture->GetHeight();
+    texturePos.x = texturePos.x * mTextureWidth;
+    texturePos.y = texturePos.y * mTextureHeight;
     //std::cout << "Pixel Pos: " << position << std::endl;
 
     // Need to flip Y because the calculated value is from lower-left of the walkable area.
     // But texture sample X/Y are from upper-left.
-    texturePos.y = mTexture->GetHeight() - texturePos.y;
+    texturePos.y = mTextureHeight - texturePos.y;
 
     // Texture positions are integers.
     texturePos.x = (int)texturePos.x;
@@ -447,7 +649,7 @@ Vector2 WalkerBoundary::WorldPosToTexturePos(const Vector3& worldPos) const
 Vector3 WalkerBoundary::TexturePosToWorldPos(Vector2 texturePos) const
 {
     // If no texture, the end result is going to be zero.
-    if(mTexture == nullptr) { return Vector3::Zero; }
+    if(mPaletteIndexes == nullptr) { return Vector3::Zero; }
 
     // A texture pos actually correlates to the bottom-left corner of the pixel.
     // But we want center of pixel...so let's offset before the conversion!
@@ -455,12 +657,12 @@ Vector3 WalkerBoundary::TexturePosToWorldPos(Vector2 texturePos) const
     texturePos.y = texturePos.y + 0.5f;
 
     // Flip y because texture pos is from top-left, but we need lower-left for world pos conversion.
-    texturePos.y = mTexture->GetHeight() - texturePos.y;
+    texturePos.y = mTextureHeight - texturePos.y;
 
     // Divide by texture width/height to get normalized position within the texture (0-1).
     Vector3 worldPos;
-    worldPos.x = texturePos.x / mTexture->GetWidth();
-    worldPos.z = texturePos.y / mTexture->GetHeight();
+    worldPos.x = texturePos.x / mTextureWidth;
+    worldPos.z = texturePos.y / mTextureHeight;
 
     // Multiply by size to get unit in world space.
     worldPos.x = worldPos.x * mSize.x;
@@ -475,7 +677,7 @@ Vector3 WalkerBoundary::TexturePosToWorldPos(Vector2 texturePos) const
 Vector2 WalkerBoundary::FindNearestWalkableTexturePosToWorldPos(const Vector3& worldPos) const
 {
     // We need a texture.
-    if(mTexture == nullptr) { return Vector2::Zero; }
+    if(mPaletteIndexes == nullptr) { return Vector2::Zero; }
 
     // If the passed in position is already walkable, just return that position in texture space.
     if(IsWorldPosWalkable(worldPos))
@@ -486,23 +688,51 @@ Vector2 WalkerBoundary::FindNearestWalkableTexturePosToWorldPos(const Vector3& w
     // Convert target position to texture position.
     Vector2 targetTexturePos = WorldPosToTexturePos(worldPos);
 
-    // Let's just brute force this for now - search O(n^2) for the nearest walkable position.
-    // This can probably be more efficient based on whether target is to left/right/above/below/inside the texture.
-    // But these walker boundary textures are really small, and this doesn't get called often, so this might work fine.
+    // Only positions within this distance of the target are considered.
+    const int kMaxDistance = 100;
+    const float kMaxDistanceSq = 9999.0f;
     Vector2 nearestWalkableTexturePos;
-    float nearestDistanceSq = 9999.0f;
-    for(int x = 0; x < mTexture->GetWidth(); ++x)
+    int width = mTextureWidth;
+    int height = mTextureHeight;
+    if(targetTexturePos.x < -kMaxDistance || targetTexturePos.x >= width + kMaxDistance ||
+       targetTexturePos.y < -kMaxDistance || targetTexturePos.y >= height + kMaxDistance)
+    {
+        return nearestWalkableTexturePos;
+    }
+
+    // Search outward from the target, one square "ring" of pixels at a time.
+    // Every pixel in a ring is at least "ring" pixels away - so once that's farther than the nearest position found, we can stop.
+    // If several positions are equally near, prefer the lowest x, then lowest y.
+    int targetX = static_cast<int>(targetTexturePos.x);
+    int targetY = static_cast<int>(targetTexturePos.y);
+    bool foundWalkable = false;
+    float nearestDistanceSq = kMaxDistanceSq;
+    for(int ring = 0; ring <= kMaxDistance; ++ring)
     {
-        for(int y = 0; y < mTexture->GetHeight(); ++y)
+        if(ring * ring > nearestDistanceSq) { break; }
+
+        for(int x = Math::Max(targetX - ring, 0); x <= Math::Min(targetX + ring, width - 1); ++x)
         {
-            Vector2 pos(x, y);
-            if(IsTexturePosWalkable(pos))
+            // On the left/right edges of the ring, check the full column. Otherwise, just the top/bottom pixels.
+            bool fullColumn = Math::Abs(x - targetX) == ring;
+            int yStep = fullColumn ? 1 : Math::Max(ring * 2, 1);
+            for(int y = targetY - ring; y <= targetY + ring; y += yStep)
             {
-                float distSq = (pos - targetTexturePos).GetLengthSq();
-                if(distSq < nearestDistanceSq)
+                if(y < 0 || y >= height) { continue; }
+
+                Vector2 pos(x, y);
+                if(IsTexturePosWalkable(pos))
                 {
-                    nearestWalkableTexturePos = pos;
-                    nearestDistanceSq = distSq;
+                    float distSq = (pos - targetTexturePos).GetLengthSq();
+                    bool isNearer = distSq < nearestDistanceSq;
+                    bool isTiedButFirst = foundWalkable && distSq == nearestDistanceSq &&
+                                          (pos.x < nearestWalkableTexturePos.x || (pos.x == nearestWalkableTexturePos.x && pos.y < nearestWalkableTexturePos.y));
+                    if(isNearer || isTiedButFirst)
+                    {
+                        nearestWalkableTexturePos = pos;
+                        nearestDistanceSq = distSq;
+                        foundWalkable = true;
+                    }
                 }
             }
         }
@@ -513,17 +743,373 @@ Vector2 WalkerBoundary::FindNearestWalkableTexturePosToWorldPos(const Vector3& w
 int WalkerBoundary::GetRegionForTexturePos(const Vector2& texturePos) const
 {
     // If no walker texture, return zero, which is always a walkable region.
-    if(mTexture == nullptr) { return 0; }
+    if(mPaletteIndexes == nullptr) { return 0; }
 
     // It position is out of bounds, use unwalkable index 255.
-    if(texturePos.x < 0 || texturePos.x >= mTexture->GetWidth()) { return 255; }
-    if(texturePos.y < 0 || texturePos.y >= mTexture->GetHeight()) { return 255; }
+    if(texturePos.x < 0 || texturePos.x >= mTextureWidth) { return 255; }
+    if(texturePos.y < 0 || texturePos.y >= mTextureHeight) { return 255; }
 
     // The region is just the palette index.
     // Palette index 0 is walkable, with indexes 1-9 indicating less and less walkable areas.
     // Palette index 255 is "unwalkable" area.
     // Palette indexes 128-254 are for special regions.
-    return mTexture->GetPixelPaletteIndex(texturePos.x, texturePos.y);
+    return GetPaletteIndex(texturePos.x, texturePos.y);
+}
+
+void WalkerBoundary::RefreshWalkableMap() const
+{
+    // A snapshot's walkability is frozen - walkers are already stamped, and shouldn't be re-stamped.
+    if(mIsSnapshot) { return; }
+
+    if(mWalkableMapDirty)
+    {
+        RebuildWalkableMap();
+    }
+    if(mWalkableMap.empty()) { return; }
+
+    // If walkers have moved (or been added/removed) since they were stamped into the map, re-stamp them.
+    bool walkersChanged = mStampedWalkerPositions.size() != mWalkers.size();
+    for(size_t i = 0; i < mWalkers.size() && !walkersChanged; ++i)
+    {
+        Vector3 walkerPos = GetWalkerPosition(mWalkers[i]);
+        const Vector3& stampedPos = mStampedWalkerPositions[i];
+        walkersChanged = walkerPos.x != stampedPos.x || walkerPos.y != stampedPos.y || walkerPos.z != stampedPos.z;
+    }
+    if(walkersChanged)
+    {
+        for(const Vector3& stampedPos : mStampedWalkerPositions)
+        {
+            StampWalker(stampedPos, false);
+        }
+        mStampedWalkerPositions.clear();
+        for(Walker* walker : mWalkers)
+        {
+            mStampedWalkerPositions.push_back(GetWalkerPosition(walker));
+            StampWalker(mStampedWalkerPositions.back(), true);
+        }
+    }
+}
+
+void WalkerBoundary::RebuildWalkableMap() const
+{
+    mWalkableMapDirty = false;
+    mStampedWalkerPositions.clear();
+    mWalkableMap.clear();
+    mWalkableAreasDirty = true;
+    ++mWalkableVersion;
+    if(mPaletteIndexes == nullptr) { return; }
+
+    // Figure out which palette indexes are unwalkable up front - much quicker than a set lookup per pixel.
+    bool regionBlocked[256];
+    for(int i = 0; i < 256; ++i)
+    {
+        regionBlocked[i] = mUnwalkableRegions.count(i) > 0;
+    }
+
+    // Block pixels in unwalkable regions.
+    uint32_t width = mTextureWidth;
+    uint32_t height = mTextureHeight;
+    mWalkableMap.resize(width * height, 0);
+    for(uint32_t y = 0; y < height; ++y)
+    {
+        for(uint32_t x = 0; x < width; ++x)
+        {
+            if(regionBlocked[GetPaletteIndex(x, y)])
+            {
+                mWalkableMap[y * width + x] = kStaticBlocked;
+            }
+        }
+    }
+
+    // Block pixels in unwalkable rects.
+    for(auto& unwalkableRect : mUnwalkableRects)
+    {
+        Vector2 min = unwalkableRect.second.GetMin();
+        Vector2 max = unwalkableRect.second.GetMax();
+        int minX = Math::Clamp(static_cast<int>(std::floor(min.x)), 0, static_cast<int>(width) - 1);
+        int minY = Math::Clamp(static_cast<int>(std::floor(min.y)), 0, static_cast<int>(height) - 1);
+        int maxX = Math::Clamp(static_cast<int>(std::ceil(max.x)), 0, static_cast<int>(width) - 1);
+        int maxY = Math::Clamp(static_cast<int>(std::ceil(max.y)), 0, static_cast<int>(height) - 1);
+        for(int y = minY; y <= maxY; ++y)
+        {
+            for(int x = minX; x <= maxX; ++x)
+            {
+                if(unwalkableRect.second.Contains(Vector2(x, y)))
+                {
+                    mWalkableMap[y * width + x] = kStaticBlocked;
+                }
+            }
+        }
+    }
+}
+
+void WalkerBoundary::UpdateWalkableMapRegion(const Vector2& textureMin, const Vector2& textureMax)
+{
+    // If the walkable map hasn't been built yet, no need - it'll take this change into account when it is built.
+    if(mWalkableMapDirty || mWalkableMap.empty()) { return; }
+
+    // Recalculate static walkability of each pixel in the area.
+    int width = mTextureWidth;
+    int height = mTextureHeight;
+    int minX = Math::Clamp(static_cast<int>(std::floor(textureMin.x)), 0, width - 1);
+    int minY = Math::Clamp(static_cast<int>(std::floor(textureMin.y)), 0, height - 1);
+    int maxX = Math::Clamp(static_cast<int>(std::ceil(textureMax.x)), 0, width - 1);
+    int maxY = Math::Clamp(static_cast<int>(std::ceil(textureMax.y)), 0, height - 1);
+    for(int y = minY; y <= maxY; ++y)
+    {
+        for(int x = minX; x <= maxX; ++x)
+        {
+            uint8_t& flags = mWalkableMap[y * width + x];
+            flags = IsStaticallyWalkable(x, y) ? (flags & ~kStaticBlocked) : (flags | kStaticBlocked);
+        }
+    }
+}
+
+void WalkerBoundary::StampWalker(const Vector3& walkerPos, bool blocked) const
+{
+    // Figure out the area of the texture the walker could possibly block.
+    int width = mTextureWidth;
+    int height = mTextureHeight;
+    Vector2 walkerTexturePos = WorldPosToTexturePos(walkerPos);
+    float radiusX = kCombinedRadii / mSize.x * width;
+    float radiusY = kCombinedRadii / mSize.y * height;
+    int minX = 0;
+    int minY = 0;
+    int maxX = width - 1;
+    int maxY = height - 1;
+    if(std::isfinite(radiusX) && std::isfinite(radiusY))
+    {
+        radiusX = Math::Abs(radiusX) + 2.0f;
+        radiusY = Math::Abs(radiusY) + 2.0f;
+        minX = static_cast<int>(Math::Clamp(walkerTexturePos.x - radiusX, 0.0f, static_cast<float>(maxX)));
+        minY = static_cast<int>(Math::Clamp(walkerTexturePos.y - radiusY, 0.0f, static_cast<float>(maxY)));
+        maxX = static_cast<int>(Math::Clamp(walkerTexturePos.x + radiusX, 0.0f, static_cast<float>(maxX)));
+        maxY = static_cast<int>(Math::Clamp(walkerTexturePos.y + radiusY, 0.0f, static_cast<float>(maxY)));
+    }
+
+    for(int y = minY; y <= maxY; ++y)
+    {
+        for(int x = minX; x <= maxX; ++x)
+        {
+            uint8_t& flags = mWalkableMap[y * width + x];
+            if(!blocked)
+            {
+                flags &= ~kWalkerBlocked;
+                continue;
+            }
+
+            // Make y-pos equal so that we only consider distance on the x/z plane.
+            Vector3 worldPos = TexturePosToWorldPos(Vector2(x, y));
+            Vector3 walkerPosXZ = walkerPos;
+            walkerPosXZ.y = worldPos.y;
+            if((worldPos - walkerPosXZ).GetLengthSq() <= kCombinedRadii * kCombinedRadii)
+            {
+                flags |= kWalkerBlocked;
+            }
+        }
+    }
+}
+
+bool WalkerBoundary::IsStaticallyWalkable(int x, int y) const
+{
+    // Same as IsTexturePosWalkable, but ignores walkers and doesn't use the walkable map.
+    if(mUnwalkableRegions.count(GetPaletteIndex(x, y)) > 0)
+    {
+        return false;
+    }
+    Vector2 texturePos(x, y);
+    for(auto& unwalkableRect : mUnwalkableRects)
+    {
+        if(unwalkableRect.second.Contains(texturePos))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void WalkerBoundary::RefreshWalkableAreas() const
+{
+    if(!mWalkableAreasDirty) { return; }
+    mWalkableAreasDirty = false;
+
+    // Flood fill each group of connected, statically walkable pixels with a unique area number.
+    // Diagonal neighbors are connected, same as in the pathfinding graph.
+    std::shared_ptr<std::vector<uint32_t>> walkableAreas = std::make_shared<std::vector<uint32_t>>(mWalkableMap.size(), 0);
+    mWalkableAreas = walkableAreas;
+    if(mWalkableMap.empty()) { return; }
+    std::vector<uint32_t>& areas = *walkableAreas;
+    int width = mTextureWidth;
+    int height = mTextureHeight;
+
+    uint32_t areaCount = 0;
+    std::vector<int> openSet;
+    for(size_t i = 0; i < mWalkableMap.size(); ++i)
+    {
+        if((mWalkableMap[i] & kStaticBlocked) != 0 || areas[i] != 0) { continue; }
+
+        ++areaCount;
+        areas[i] = areaCount;
+        openSet.push_back(static_cast<int>(i));
+        while(!openSet.empty())
+        {
+            int current = openSet.back();
+            openSet.pop_back();
+
+            int currentX = current % width;
+            int currentY = current / width;
+            for(int y = Math::Max(currentY - 1, 0); y <= Math::Min(currentY + 1, height - 1); ++y)
+            {
+                for(int x = Math::Max(currentX - 1, 0); x <= Math::Min(currentX + 1, width - 1); ++x)
+                {
+                    int neighbor = y * width + x;
+                    if((mWalkableMap[neighbor] & kStaticBlocked) == 0 && areas[neighbor] == 0)
+                    {
+                        areas[neighbor] = areaCount;
+                        openSet.push_back(neighbor);
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool WalkerBoundary::IsInSameWalkableArea(const Vector2& texturePos1, const Vector2& texturePos2) const
+{
+    RefreshWalkableAreas();
+    if(mWalkableAreas == nullptr || mWalkableAreas->empty()) { return true; }
+
+    // If either position is out of bounds or unwalkable, we can't say for sure - assume they might be in the same area.
+    int width = mTextureWidth;
+    int height = mTextureHeight;
+    if(texturePos1.x < 0 || texturePos1.x >= width || texturePos1.y < 0 || texturePos1.y >= height ||
+       texturePos2.x < 0 || texturePos2.x >= width || texturePos2.y < 0 || texturePos2.y >= height)
+    {
+        return true;
+    }
+    const std::vector<uint32_t>& areas = *mWalkableAreas;
+    uint32_t area1 = areas[static_cast<int>(texturePos1.y) * width + static_cast<int>(texturePos1.x)];
+    uint32_t area2 = areas[static_cast<int>(texturePos2.y) * width + static_cast<int>(texturePos2.x)];
+    return area1 == 0 || area2 == 0 || area1 == area2;
+}
+
+std::unique_ptr<WalkerBoundary> WalkerBoundary::CreateSnapshot() const
+{
+    // Make sure walkability is up-to-date before copying it.
+    RefreshWalkableMap();
+
+    // Copy everything needed to find a path. The walkers themselves aren't copied, since they're already stamped into the walkable map.
+    std::unique_ptr<WalkerBoundary> snapshot(new WalkerBoundary());
+    snapshot->mIsSnapshot = true;
+    snapshot->mTexture = mTexture;
+    snapshot->mTextureWidth = mTextureWidth;
+    snapshot->mTextureHeight = mTextureHeight;
+    snapshot->mPaletteIndexes = mPaletteIndexes;
+    snapshot->mSize = mSize;
+    snapshot->mOffset = mOffset;
+    snapshot->mUnwalkableRegions = mUnwalkableRegions;
+    snapshot->mUnwalkableRects = mUnwalkableRects;
+    snapshot->mPathfindingNodeSkip = mPathfindingNodeSkip;
+    snapshot->mWalkableMap = mWalkableMap;
+    snapshot->mWalkableMapDirty = mWalkableMapDirty;
+    snapshot->mStampedWalkerPositions = mStampedWalkerPositions;
+    snapshot->mWalkableAreas = mWalkableAreas;
+    snapshot->mWalkableAreasDirty = mWalkableAreasDirty;
+    snapshot->mWalkableVersion = mWalkableVersion;
+    snapshot->mPathCache = mPathCache;
+    return snapshot;
+}
+
+void WalkerBoundary::OnPathRequestDone(const std::shared_ptr<PathRequest>& request)
+{
+    // No longer in progress.
+    auto it = std::find(mPathRequests.begin(), mPathRequests.end(), request);
+    if(it != mPathRequests.end())
+    {
+        mPathRequests.erase(it);
+    }
+
+    // The snapshot's most recently used path is the one just found. If walkability hasn't changed since, it's worth remembering.
+    const WalkerBoundary& snapshot = *request->snapshot;
+    if(!snapshot.mPathCache.empty() && snapshot.mWalkableVersion == mWalkableVersion)
+    {
+        AddToPathCache(snapshot.mPathCache.front());
+    }
+
+    // Let the requester know.
+    if(request->callback != nullptr)
+    {
+        request->callback(request->foundPath, request->path);
+    }
+}
+
+void WalkerBoundary::AddToPathCache(const CachedPath& cachedPath)
+{
+    // If this path is already cached, remove the old entry.
+    for(auto it = mPathCache.begin(); it != mPathCache.end(); ++it)
+    {
+        if(it->start == cachedPath.start && it->goal == cachedPath.goal && it->walkableVersion == cachedPath.walkableVersion &&
+           AreWalkerPositionsEqual(it->walkerPositions, cachedPath.walkerPositions))
+        {
+            mPathCache.erase(it);
+            break;
+        }
+    }
+
+    // Most recently used paths are at the front. The least recently used is evicted if there are too many.
+    mPathCache.insert(mPathCache.begin(), cachedPath);
+    if(mPathCache.size() > kMaxCachedPaths)
+    {
+        mPathCache.pop_back();
+    }
+}
+
+uint8_t WalkerBoundary::GetPaletteIndex(uint32_t x, uint32_t y) const
+{
+    // Same as getting the pixel palette index from the texture: if index isn't valid, return zero.
+    uint32_t index = y * mTextureWidth + x;
+    if(mPaletteIndexes == nullptr || index >= mPaletteIndexes->size()) { return 0; }
+    return (*mPaletteIndexes)[index];
+}
+
+void WalkerBoundary::OnStaticWalkabilityChanged()
+{
+    // Areas may have been split or joined, and cached paths may go through newly blocked areas (or around newly unblocked ones).
+    mWalkableAreasDirty = true;
+    ++mWalkableVersion;
+}
+
+bool WalkerBoundary::SnapToGraph(const Vector2& texturePos, int nodeSkipInterval, Vector2& outNode) const
+{
+    // Use one of the graph nodes at the corners of the grid cell containing this position.
+    // The node must be walkable, and it must be possible to walk straight between it and the position.
+    // Otherwise, a path could go through a wall (say, if the position is right beside a wall) or never reach the node at all.
+    uint32_t x = static_cast<uint32_t>(texturePos.x) / nodeSkipInterval * nodeSkipInterval;
+    uint32_t y = static_cast<uint32_t>(texturePos.y) / nodeSkipInterval * nodeSkipInterval;
+    for(int i = 0; i < 4; ++i)
+    {
+        Vector2 node(x + (i % 2) * nodeSkipInterval, y + (i / 2) * nodeSkipInterval);
+        if(node.x < mTextureWidth && node.y < mTextureHeight && IsTexturePosWalkable(node) &&
+           IsStraightLineWalkable(node, texturePos) && IsStraightLineWalkable(texturePos, node))
+        {
+            outNode = node;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WalkerBoundary::IsStraightLineWalkable(Vector2 from, const Vector2& to) const
+{
+    while(from != to)
+    {
+        MoveToward(from, to);
+        if(!IsTexturePosWalkable(from))
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 namespace
@@ -532,16 +1118,22 @@ namespace
     struct Node
     {
         // Index (in nodes list) of parent of this node.
-        size_t parentIndex = 0;
+        uint32_t parentIndex = 0;
 
-        // Is this node closed/explored in the current search?
-        bool closed = false;
+        // The search in which this node was closed/explored.
+        // If it doesn't match the current search, the node hasn't been explored in the current search.
+        uint32_t searchId = 0;
     };
-    std::vector<Node> nodes;
+
+    // These are per-thread, since paths may be calculated on several threads at once.
+    thread_local std::vector<Node> tNodes;
+
+    // Incremented for each search. This avoids needing to reset every node before each search.
+    thread_local uint32_t tCurrentSearchId = 0;
 
     // The open set when doing a pathfinding search.
     // Each element is an index into the nodes array.
-    ResizableQueue<size_t> openSet;
+    thread_local ResizableQueue<size_t> tOpenSet;
 }
 
 bool WalkerBoundary::FindPathBFS(const Vector2& start, const Vector2& goal, std::vector<Vector2>& outPath, int nodeSkipInterval) const
@@ -549,24 +1141,32 @@ bool WalkerBoundary::FindPathBFS(const Vector2& start, const Vector2& goal, std:
     //TIMER_SCOPED("BFS");
 
     // Figure out how many nodes we need for the current walker boundary texture.
-    if(mTexture == nullptr) { return false; }
-    uint32_t width = mTexture->GetWidth();
-    uint32_t height = mTexture->GetHeight();
+    if(mPaletteIndexes == nullptr) { return false; }
+    uint32_t width = mTextureWidth;
+    uint32_t height = mTextureHeight;
     uint32_t nodeCount = width * height;
     if(nodeCount == 0) { return false; }
 
     // Make sure node set is the right size. When entering a new scene, a resize up or down will likely be needed.
     // Note that resizing doesn't ever reduce capacity, so this will eventually be the size of the largest texture in the current play session.
-    if(nodes.size() != nodeCount)
+    if(tNodes.size() != nodeCount)
     {
-        nodes.resize(nodeCount);
+        tNodes.resize(nodeCount);
     }
 
-    // Regardless of whether a resize occurred, we need to reset the working variables in each node.
-    memset(reinterpret_cast<void*>(nodes.data()), 0, sizeof(nodes[0]) * nodes.size());
+    // Start a new search. Only if the search ID wraps around do we need to reset the working variables in each node.
+    ++tCurrentSearchId;
+    if(tCurrentSearchId == 0)
+    {
+        for(Node& node : tNodes)
+        {
+            node.searchId = 0;
+        }
+        tCurrentSearchId = 1;
+    }
 
     // Make sure open set is empty.
-    openSet.Clear();
+    tOpenSet.Clear();
 
     // Make sure out path is clear.
     outPath.clear();
@@ -575,123 +1175,130 @@ bool WalkerBoundary::FindPathBFS(const Vector2& start, const Vector2& goal, std:
     // These walker graphs are very dense (1 pixel equals one node). By skipping some pixels, we get a simpler graph, and a faster algorithm.
     // A fidelity of 2 only uses every other pixel, 3 only uses every third pixel, and so on.
 
-    // Calculate start point index, ensuring it aligns with the desired graph fidelity.
-    uint32_t startX = static_cast<uint32_t>(start.x);
-    uint32_t startY = static_cast<uint32_t>(start.y);
-    if(startX % nodeSkipInterval != 0)
+    // Find the graph nodes to use for the start and goal, ensuring they align with the desired graph fidelity.
+    // If there aren't any suitable nodes, a path can only be found with a higher fidelity graph.
+    Vector2 startValue;
+    Vector2 goalValue;
+    if(!SnapToGraph(start, nodeSkipInterval, startValue) || !SnapToGraph(goal, nodeSkipInterval, goalValue))
     {
-        startX = startX / nodeSkipInterval * nodeSkipInterval;
-    }
-    if(startY % nodeSkipInterval != 0)
-    {
-        startY = startY / nodeSkipInterval * nodeSkipInterval;
+        return false;
     }
+
+    // Calculate start point index.
+    uint32_t startX = static_cast<uint32_t>(startValue.x);
+    uint32_t startY = static_cast<uint32_t>(startValue.y);
     size_t startIndex = static_cast<size_t>(startY * width + startX);
 
     // Close start node, put it on the open set.
-    nodes[startIndex].closed = true;
-    openSet.Push(startIndex);
+    tNodes[startIndex].searchId = tCurrentSearchId;
+    tOpenSet.Push(startIndex);
 
-    // Cache goal index to quickly check if we reached the goal. Same idea with the fidelity here.
-    uint32_t goalX = static_cast<uint32_t>(goal.x);
-    uint32_t goalY = static_cast<uint32_t>(goal.y);
-    if(goalX % nodeSkipInterval != 0)
-    {
-        goalX = goalX / nodeSkipInterval * nodeSkipInterval;
-    }
-    if(goalY % nodeSkipInterval != 0)
-    {
-        goalY = goalY / nodeSkipInterval * nodeSkipInterval;
-    }
+    // Cache goal index to quickly check if we reached the goal.
+    uint32_t goalX = static_cast<uint32_t>(goalValue.x);
+    uint32_t goalY = static_cast<uint32_t>(goalValue.y);
     size_t goalIndex = static_cast<size_t>(goalY * width + goalX);
-    Vector2 goalValue(goalX, goalY);
 
     // If start and goal are the same point, we technically found a path.
+    // If they're different points that use the same node, walk through that node.
     if(startIndex == goalIndex)
     {
+        if(start != goal)
+        {
+            outPath.push_back(goal);
+            if(goalValue != goal && goalValue != start)
+            {
+                outPath.push_back(goalValue);
+            }
+            outPath.push_back(start);
+        }
         return true;
     }
 
     // As we do the BFS, keep track of which node from the open set comes closest to the goal node.
     // We'll use this as a backup for generating a path if the goal node is unreachable.
-    size_t closestToGoalNodeIndex = nodes.size();
+    size_t closestToGoalNodeIndex = tNodes.size();
     float closestToGoalDistSq = 0.0f;
 
+    // Neighbor directions - including diagonals!
+    const int kNeighborDirections[8][2] = {
+        { 0, 1 }, { 0, -1 }, { 1, 0 }, { -1, 0 },
+        { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 }
+    };
+
+    // Walkability checks are the bulk of the work here, so go straight to the walkable map if it's available.
+    bool useWalkableMap = !mWalkableMapDirty && !mWalkableMap.empty();
+
     // Iterate until we either find the goal, or the open set is empty.
-    Vector2 neighbors[8];
-    while(!openSet.Empty())
+    while(!tOpenSet.Empty())
     {
         // If we find the goal, we purposely don't pop the node off the open set.
         // This is used after the while-loop to check success/failure of the search.
-        size_t currentIndex = openSet.Front();
+        size_t currentIndex = tOpenSet.Front();
         if(currentIndex == goalIndex) { break; }
 
-        // Create neighbors array - including diagonals!
-        Vector2 currentValue(currentIndex % width, currentIndex / width);
-        neighbors[0] = currentValue + Vector2(0, nodeSkipInterval);
-        neighbors[1] = currentValue + Vector2(0, -nodeSkipInterval);
-        neighbors[2] = currentValue + Vector2(nodeSkipInterval, 0);
-        neighbors[3] = currentValue + Vector2(-nodeSkipInterval, 0);
-
-        neighbors[4] = currentValue + Vector2(nodeSkipInterval, nodeSkipInterval);
-        neighbors[5] = currentValue + Vector2(nodeSkipInterval, -nodeSkipInterval);
-        neighbors[6] = currentValue + Vector2(-nodeSkipInterval, nodeSkipInterval);
-        neighbors[7] = currentValue + Vector2(-nodeSkipInterval, -nodeSkipInterval);
+        int currentX = static_cast<int>(currentIndex % width);
+        int currentY = static_cast<int>(currentIndex / width);
+        Vector2 currentValue(currentX, currentY);
 
         // If this node is closer to the goal than any node we've yet seen, save it as the closest.
         float distToGoalSq = (goalValue - currentValue).GetLengthSq();
-        if(closestToGoalNodeIndex >= nodes.size() || distToGoalSq < closestToGoalDistSq)
+        if(closestToGoalNodeIndex >= tNodes.size() || distToGoalSq < closestToGoalDistSq)
         {
             closestToGoalDistSq = distToGoalSq;
             closestToGoalNodeIndex = currentIndex;
         }
 
         // See if we should add neighbors to open set.
-        for(Vector2& neighbor : neighbors)
+        for(const int* direction : kNeighborDirections)
         {
             // Ignore any x/y that appears to be out of bounds.
-            if(neighbor.x < 0 || neighbor.x >= width || neighbor.y < 0 || neighbor.y >= height)
+            int neighborX = currentX + direction[0] * nodeSkipInterval;
+            int neighborY = currentY + direction[1] * nodeSkipInterval;
+            if(neighborX < 0 || neighborX >= static_cast<int>(width) || neighborY < 0 || neighborY >= static_cast<int>(height))
             {
                 continue;
             }
 
             // Ignore closed/explored neighbors.
-            int neighborNodeIndex = static_cast<int>(neighbor.y * width + neighbor.x);
-            Node& neighborNode = nodes[neighborNodeIndex];
-            if(neighborNode.closed) { continue; }
+            int neighborNodeIndex = neighborY * width + neighborX;
+            Node& neighborNode = tNodes[neighborNodeIndex];
+            if(neighborNode.searchId == tCurrentSearchId) { continue; }
 
             // Ignore any neighbor that is not walkable.
             // When pathing at higher skip intervals, we still need to check in-between nodes, in case they are unwalkable.
             bool walkable = true;
-            Vector2 checkWalkableValue = currentValue;
-            while(checkWalkableValue != neighbor)
+            for(int i = 1; i <= nodeSkipInterval && walkable; ++i)
             {
-                MoveToward(checkWalkableValue, neighbor);
-                if(!IsTexturePosWalkable(checkWalkableValue))
+                int checkX = currentX + direction[0] * i;
+                int checkY = currentY + direction[1] * i;
+                if(useWalkableMap)
+                {
+                    walkable = mWalkableMap[checkY * width + checkX] == 0;
+                }
+                else
                 {
-                    walkable = false;
-                    break;
+                    walkable = IsTexturePosWalkable(Vector2(checkX, checkY));
                 }
             }
             if(!walkable) { continue; }
 
             // Add to open set.
-            neighborNode.parentIndex = currentIndex;
-            neighborNode.closed = true;
-            openSet.Push(neighborNodeIndex);
+            neighborNode.parentIndex = static_cast<uint32_t>(currentIndex);
+            neighborNode.searchId = tCurrentSearchId;
+            tOpenSet.Push(neighborNodeIndex);
         }
 
         // Done with this node - remove from open set.
-        openSet.Pop();
+        tOpenSet.Pop();
     }
 
     // If the open set is empty, it means we didn't find a path to the goal.
     // However, we can still provide an "as close as possible" path that attempts to get as close to the goal as possible.
-    if(openSet.Empty())
+    if(tOpenSet.Empty())
     {
         // If no closest to goal node was identified (unlikely), then we really did find no path.
         // Return false with an empty path.
-        if(closestToGoalNodeIndex >= nodes.size())
+        if(closestToGoalNodeIndex >= tNodes.size())
         {
             return false;
         }
@@ -701,7 +1308,11 @@ bool WalkerBoundary::FindPathBFS(const Vector2& start, const Vector2& goal, std:
         while(current != startIndex)
         {
             outPath.push_back(Vector2(current % width, current / width));
-            current = nodes[current].parentIndex;
+            current = tNodes[current].parentIndex;
+        }
+        if(Vector2(startX, startY) != start)
+        {
+            outPath.push_back(Vector2(startX, startY));
         }
         outPath.push_back(start);
 
@@ -714,13 +1325,27 @@ bool WalkerBoundary::FindPathBFS(const Vector2& start, const Vector2& goal, std:
         // Make sure the actual goal is the first point on the path.
         outPath.push_back(goal);
 
+        // If the goal was snapped to a nearby node, that node is next.
+        // The goal can be walked to in a straight line from that node, but not necessarily from the node before it.
+        size_t current = tOpenSet.Front();
+        if(Vector2(goalX, goalY) != goal)
+        {
+            outPath.push_back(goalValue);
+        }
+
         // Iterate back to start, pushing world position of each node onto our path.
         // This leaves the path with start node at back, goal node at front - caller can traverse back-to-front.
-        size_t current = nodes[openSet.Front()].parentIndex;
+        current = tNodes[current].parentIndex;
         while(current != startIndex)
         {
             outPath.push_back(Vector2(current % width, current / width));
-            current = nodes[current].parentIndex;
+            current = tNodes[current].parentIndex;
+        }
+
+        // Same for the start: the node it was snapped to comes just before it.
+        if(Vector2(startX, startY) != start)
+        {
+            outPath.push_back(Vector2(startX, startY));
         }
 
         // Make sure the actual start is the last point on the path.
@@ -758,8 +1383,8 @@ bool WalkerBoundary::FindPathAStar(const Vector2& start, const Vector2& goal, st
     //TIMER_SCOPED("A*");
 
     // Figure out how many nodes we need for the current walker boundary texture.
-    uint32_t width = mTexture->GetWidth();
-    uint32_t height = mTexture->GetHeight();
+    uint32_t width = mTextureWidth;
+    uint32_t height = mTextureHeight;
     uint32_t nodeCount = width * height;
     if(nodeCount == 0) { return false; }
 
@@ -5,6 +5,10 @@
 // the path it should take, and any debug/rendering helpers.
 //
 #pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <unordered_set>
 
@@ -19,16 +23,27 @@ class Walker;
 class WalkerBoundary
 {
 public:
+    ~WalkerBoundary();
+
     bool FindPath(const Vector3& fromWorldPos, const Vector3& toWorldPos, std::vector<Vector3>& outPath);
     Vector3 FindNearestWalkablePosition(const Vector3& worldPos) const;
 
-    void SetTexture(Texture* texture) { mTexture = texture; }
+    // Finds a path on a background thread, using a snapshot of walkable areas and walker positions as they are right now.
+    // The callback is called on the main thread when done, unless the request is cancelled first.
+    typedef std::function<void(bool foundPath, std::vector<Vector3>& path)> PathCallback;
+    uint32_t FindPathAsync(const Vector3& fromWorldPos, const Vector3& toWorldPos, const PathCallback& callback);
+    void CancelPathRequest(uint32_t requestId);
+
+    void SetTexture(Texture* texture);
     Texture* GetTexture() const { return mTexture; }
 
-    void SetSize(const Vector2& size) { mSize = size; }
+    // Sets the palette indexes used for pathfinding directly, rather than copying them from a texture.
+    void SetPaletteIndexes(uint32_t width, uint32_t height, std::vector<uint8_t> paletteIndexes);
+
+    void SetSize(const Vector2& size) { mSize = size; mWalkableMapDirty = true; }
     Vector2 GetSize() const { return mSize; }
 
-    void SetOffset(const Vector2& offset) { mOffset = offset; }
+    void SetOffset(const Vector2& offset) { mOffset = offset; mWalkableMapDirty = true; }
     Vector2 GetOffset() const { return mOffset; }
 
     void SetRegionBlocked(int regionIndex, int regionBoundaryIndex, bool blocked);
@@ -49,6 +64,12 @@ private:
     // The pixel color indicates whether a spot is walkable and how walkable.
     Texture* mTexture = nullptr;
 
+    // The texture data needed for pathfinding is copied from the texture.
+    // This allows paths to be calculated on a background thread, without worrying about the texture being unloaded.
+    uint32_t mTextureWidth = 0;
+    uint32_t mTextureHeight = 0;
+    std::shared_ptr<const std::vector<uint8_t>> mPaletteIndexes;
+
     // Size specifies scale of the walker bounds relative to the 3D scene.
     Vector2 mSize;
 
@@ -67,9 +88,81 @@ private:
     std::vector<Walker*> mWalkers;
 
     // The pathfinding grids are quite dense, and we can save some time by skipping over some nodes in the grid.
-    // This value starts higher, but is cut in half when we can't find a path.
+    // Each path starts with this value, but it's cut in half when we can't find a path.
     int mPathfindingNodeSkip = 4;
 
+    // Checking walkability of a texture pos (regions, rects, walkers) is done A LOT during pathfinding, so the result is cached per pixel.
+    // Each byte holds flags (see cpp): whether the pixel is statically unwalkable (region/rect), and whether it is blocked by a nearby walker.
+    // Region/rect changes update the affected pixels in place. Walkers are re-stamped when their positions change.
+    mutable std::vector<uint8_t> mWalkableMap;
+    mutable bool mWalkableMapDirty = true;
+
+    // Walker positions currently stamped into the walkable map.
+    mutable std::vector<Vector3> mStampedWalkerPositions;
+
+    // Each statically walkable pixel is labeled with the connected "area" it belongs to (0 means unwalkable).
+    // If start and goal are in different areas, no path exists at any graph fidelity - so we don't waste time retrying.
+    // These are only calculated when needed (after a failed search), since it requires visiting every pixel.
+    // Once calculated, areas don't change (they're recalculated from scratch), so snapshots can share them.
+    mutable std::shared_ptr<const std::vector<uint32_t>> mWalkableAreas;
+    mutable bool mWalkableAreasDirty = true;
+
+    // Incremented whenever static walkability changes. Used to invalidate cached paths.
+    mutable uint32_t mWalkableVersion = 0;
+
+    // Recently calculated paths. Walkers often path to the same spots (or retry the same walk), so this avoids redundant searches.
+    struct CachedPath
+    {
+        Vector2 start;
+        Vector2 goal;
+        uint32_t walkableVersion = 0;
+        std::vector<Vector3> walkerPositions;
+
+        std::vector<Vector3> path;
+        bool foundPath = false;
+    };
+    std::vector<CachedPath> mPathCache;
+
+    // A path being calculated on a background thread.
+    struct PathRequest
+    {
+        uint32_t id = 0;
+
+        // A copy of this walker boundary to do the search with. Changes on the main thread don't affect it.
+        std::unique_ptr<WalkerBoundary> snapshot;
+
+        Vector3 fromWorldPos;
+        Vector3 toWorldPos;
+        PathCallback callback;
+
+        // Set by the background thread when the search is done.
+        std::vector<Vector3> path;
+        bool foundPath = false;
+
+        // If cancelled, the search is skipped (if not already started), and the callback is not called.
+        std::atomic<bool> cancelled { false };
+    };
+    std::vector<std::shared_ptr<PathRequest>> mPathRequests;
+    uint32_t mNextPathRequestId = 1;
+
+    // If true, this is a snapshot used for a background path request - walkability is frozen as it was when the snapshot was taken.
+    bool mIsSnapshot = false;
+
+    std::unique_ptr<WalkerBoundary> CreateSnapshot() const;
+    void OnPathRequestDone(const std::shared_ptr<PathRequest>& request);
+    void AddToPathCache(const CachedPath& cachedPath);
+
+    uint8_t GetPaletteIndex(uint32_t x, uint32_t y) const;
+
+    void RefreshWalkableMap() const;
+    void RebuildWalkableMap() const;
+    void UpdateWalkableMapRegion(const Vector2& textureMin, const Vector2& textureMax);
+    void StampWalker(const Vector3& walkerPos, bool blocked) const;
+    bool IsStaticallyWalkable(int x, int y) const;
+    void RefreshWalkableAreas() const;
+    bool IsInSameWalkableArea(const Vector2& texturePos1, const Vector2& texturePos2) const;
+    void OnStaticWalkabilityChanged();
+
     bool IsWorldPosWalkable(const Vector3& worldPos) const;
     bool IsTexturePosWalkable(const Vector2& texturePos) const;
 
@@ -80,6 +173,8 @@ private:
 
     Vector2 FindNearestWalkableTexturePosToWorldPos(const Vector3& worldPos) const;
 
+    bool SnapToGraph(const Vector2& texturePos, int nodeSkipInterval, Vector2& outNode) const;
+    bool IsStraightLineWalkable(Vector2 from, const Vector2& to) const;
     bool FindPathBFS(const Vector2& start, const Vector2& goal, std::vector<Vector2>& outPath, int nodeSkipInterval = 1) const;
     bool FindPathAStar(const Vector2& start, const Vector2& goal, std::vector<Vector2>& outPath) const;
 };
@@ -118,12 +118,14 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                 int frameNumber = line.entries[0].GetValueAsInt();
 
                 // Vertex animation must be specified.
-                VertexAnimation* vertexAnim = gAssetManager.LoadAsset<VertexAnimation>(line.entries[1].key, GetScope());
+                AssetHandle<VertexAnimation> vertexAnimHandle = gAssetManager.LoadAssetHandle<VertexAnimation>(line.entries[1].key, GetScope());
+                VertexAnimation* vertexAnim = vertexAnimHandle.Get();
                 if(vertexAnim == nullptr)
                 {
                     printf("Failed to load vertex animation %s!\n", line.entries[1].key.c_str());
                     continue;
                 }
+                mVertexAnimationHandles.push_back(std::move(vertexAnimHandle));
 
                 // Create and push back the animation node. Remaining fields are optional.
                 VertexAnimNode* node = new VertexAnimNode();
@@ -334,7 +336,12 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                 // Create node.
                 SoundAnimNode* node = new SoundAnimNode();
                 node->frameNumber = frameNumber;
-                node->audio = gAssetManager.LoadAsset<Audio>(soundName, GetScope());
+                AssetHandle<Audio> audioHandle = gAssetManager.LoadAssetHandle<Audio>(soundName, GetScope());
+                node->audio = audioHandle.Get();
+                if(audioHandle.IsValid())
+                {
+                    mAudioHandles.push_back(std::move(audioHandle));
+                }
                 node->volume = volume;
 
                 // Remaining arguments are optional.
@@ -12,7 +12,10 @@
 #include <unordered_map>
 #include <vector>
 
+#include "AssetCache.h"
+
 struct AnimNode;
+class Audio;
 class VertexAnimation;
 struct VertexAnimNode;
 
@@ -64,5 +67,9 @@ private:
     // Kept separately because we sometimes need to iterate only over these.
     std::vector<VertexAnimNode*> mVertexAnimNodes;
 
+    // Anim nodes refer to vertex animations and sounds by pointer. These handles keep those assets loaded for as long as this animation is.
+    std::vector<AssetHandle<VertexAnimation>> mVertexAnimationHandles;
+    std::vector<AssetHandle<Audio>> mAudioHandles;
+
     void ParseFromData(uint8_t* data, uint32_t dataLength);
 };
\ No newline at end of file
@@ -3,134 +3,59 @@
 #include <cassert>
 #include <iostream>
 #include <vector>
-#include <unordered_map>
 
 #include "BinaryReader.h"
 #include "GMath.h"
 
 //#define DEBUG_OUTPUT
 
-VertexAnimationPose* VertexAnimationPose::GetForFrame(int frame)
-{
-    VertexAnimationPose* pose = this;
-    while(pose != nullptr)
-    {
-        // We found an exact frame match - done!
-        if(pose->frameNumber == frame)
-        {
-            break;
-        }
-
-        // If there's no next pose, use this one.
-        // Also if no pose exists for the exact frame, the rule is to use the closest previous pose instead.
-        if(pose->next == nullptr || pose->next->frameNumber > frame)
-        {
-            break;
-        }
-
-        // This pose is no good - move to next one.
-        pose = pose->next;
-    }
-    return pose;
-}
-
-void VertexAnimationPose::GetForTime(float time, int framesPerSecond, VertexAnimationPose*& outCurrent, VertexAnimationPose*& outNext, float& outT)
-{
-    // Set out vars to defaults.
-    outCurrent = this;
-    outNext = nullptr;
-    outT = 0.0f;
-
-    // NOTE: we're assuming the time passed in is "local" - within the duration of the full animation.
-    // Calculate how many seconds should be used for a single frame.
-    float secondsPerFrame = 1.0f / framesPerSecond;
-
-    // Determine between which two transform poses the desired local time is located.
-    // E.g. if local time is 50% between frames 5 and 6, we want to interpolate 50% between the poses for those frames.
-    float currentPoseTime = 0.0f;
-    float nextPoseTime = 0.0f;
-    while(outCurrent != nullptr && outCurrent->next != nullptr)
-    {
-        currentPoseTime = secondsPerFrame * outCurrent->frameNumber;
-        nextPoseTime = secondsPerFrame * outCurrent->next->frameNumber;
-        if(nextPoseTime > time) { break; }
-
-        // Move on to next one.
-        outCurrent = outCurrent->next;
-    }
-
-    // Make sure we found a valid current pose.
-    if(outCurrent != nullptr)
-    {
-        // GK3 does a somewhat wasteful thing: poses are expected to be defined for all frames. If NOT, use the closes previous frame.
-        // SO: if the next pose IS NOT for the next frame, we just use the current pose with no interpolation.
-        outNext = outCurrent->next;
-        if(outNext == nullptr || outNext->frameNumber != (outCurrent->frameNumber + 1))
-        {
-            outNext = nullptr;
-            return;
-        }
-
-        // Calculate a "t" value for interpolating between the two poses.
-        if(!Math::IsZero(nextPoseTime - currentPoseTime))
-        {
-            outT = (time - currentPoseTime) / (nextPoseTime - currentPoseTime);
-        }
-        assert(outT >= 0.0f && outT <= 1.0f);
-    }
-}
-
-
 TYPEINFO_INIT(VertexAnimation, Asset, GENERATE_TYPE_ID)
 {
     TYPEINFO_VAR(VertexAnimation, VariableType::Int, mFrameCount);
     TYPEINFO_VAR(VertexAnimation, VariableType::String, mModelName);
 }
 
-VertexAnimation::~VertexAnimation()
+void VertexAnimation::Load(AssetData& data)
 {
-    for(auto& outerEntry : mVertexPoses)
+    ParseFromData(data.bytes.get(), data.length);
+}
+
+size_t VertexAnimation::CalculateMemorySize(uint32_t loadedDataLength) const
+{
+    // The compressed data is rebuilt into flat per-mesh tracks when loaded, so count the tracks.
+    size_t memorySize = 0;
+    for(const std::vector<VertexAnimationTrack<Vector3>>& meshTracks : mVertexTracks)
     {
-        for(auto& innerEntry : outerEntry.second)
+        memorySize += meshTracks.capacity() * sizeof(VertexAnimationTrack<Vector3>);
+        for(const VertexAnimationTrack<Vector3>& track : meshTracks)
         {
-            VertexAnimationPose* pose = innerEntry.second;
-            while(pose != nullptr)
-            {
-                VertexAnimationPose* temp = pose;
-                pose = pose->next;
-                delete temp;
-            }
+            memorySize += track.GetMemorySize();
         }
     }
-
-    for(auto& poseElement : mTransformPoses)
+    for(const VertexAnimationTrack<Matrix4>& track : mTransformTracks)
     {
-        VertexAnimationPose* pose = poseElement;
-        while(pose != nullptr)
-        {
-            VertexAnimationPose* temp = pose;
-            pose = pose->next;
-            delete temp;
-        }
+        memorySize += sizeof(track) + track.GetMemorySize();
     }
+    for(const VertexAnimationTrack<AABB>& track : mAABBTracks)
+    {
+        memorySize += sizeof(track) + track.GetMemorySize();
+    }
+    return memorySize;
 }
 
-void VertexAnimation::Load(AssetData& data)
-{
-    ParseFromData(data.bytes.get(), data.length);
-}
-
-VertexAnimationTransformPose VertexAnimation::SampleTransformPose(int frame, int meshIndex)
+VertexAnimationTransformPose VertexAnimation::SampleTransformPose(int frame, int meshIndex) const
 {
     // Make sure we're in bounds.
-    if(meshIndex >= 0 && meshIndex < mTransformPoses.size() && mTransformPoses[meshIndex] != nullptr)
+    if(meshIndex >= 0 && meshIndex < mTransformTracks.size() && !mTransformTracks[meshIndex].IsEmpty())
     {
         // Retrieve pose corresponding to the desired frame.
-        VertexAnimationPose* pose = mTransformPoses[meshIndex]->GetForFrame(frame);
-        if(pose != nullptr)
-        {
-            return *static_cast<VertexAnimationTransformPose*>(pose);
-        }
+        const VertexAnimationTrack<Matrix4>& track = mTransformTracks[meshIndex];
+        int keyframe = track.GetKeyframeForFrame(frame);
+
+        VertexAnimationTransformPose pose;
+        pose.frameNumber = track.keyframeFrames[keyframe];
+        pose.meshToLocalMatrix = *track.GetValues(keyframe);
+        return pose;
     }
 
     // Error case: just return something invalid.
@@ -139,41 +64,30 @@ VertexAnimationTransformPose VertexAnimation::SampleTransformPose(int frame, int
     return invalidPose;
 }
 
-VertexAnimationTransformPose VertexAnimation::SampleTransformPose(float time, int framesPerSecond, int meshIndex)
+VertexAnimationTransformPose VertexAnimation::SampleTransformPose(float time, int framesPerSecond, int meshIndex) const
 {
     // Make sure we're in bounds.
-    if(meshIndex >= 0 && meshIndex < mTransformPoses.size() && mTransformPoses[meshIndex] != nullptr)
+    if(meshIndex >= 0 && meshIndex < mTransformTracks.size() && !mTransformTracks[meshIndex].IsEmpty())
     {
-        // Caller may pass in a global time that extends beyond the local time of this particular animation.
-        // Desire here is for the animation to "loop", so we calculate how many seconds in we are.
-        float duration = GetDuration(framesPerSecond);
-        float localTime = time;
-        if(localTime > duration)
-        {
-            localTime = Math::Mod(time, duration);
-        }
-
         // Retrieve current/next poses based on the desired time.
-        VertexAnimationPose* current;
-        VertexAnimationPose* next;
+        const VertexAnimationTrack<Matrix4>& track = mTransformTracks[meshIndex];
+        int current;
+        int next;
         float t;
-        mTransformPoses[meshIndex]->GetForTime(localTime, framesPerSecond, current, next, t);
+        track.GetKeyframesForTime(GetLocalTime(time, framesPerSecond), framesPerSecond, current, next, t);
 
-        // We at least need a valid current pose.
-        if(current != nullptr)
+        // If no next pose, we can just use the current pose directly.
+        VertexAnimationTransformPose pose;
+        pose.frameNumber = track.keyframeFrames[current];
+        if(next < 0)
         {
-            // If no next pose, we can just use the current pose directly.
-            if(next == nullptr)
-            {
-                return *static_cast<VertexAnimationTransformPose*>(current);
-            }
-
-            // Finally, create a pose with lerp/slerp that is interpolated between the two poses.
-            VertexAnimationTransformPose pose;
-            pose.meshToLocalMatrix = Matrix4::Lerp(static_cast<VertexAnimationTransformPose*>(current)->meshToLocalMatrix,
-                                                    static_cast<VertexAnimationTransformPose*>(next)->meshToLocalMatrix, t);
+            pose.meshToLocalMatrix = *track.GetValues(current);
             return pose;
         }
+
+        // Finally, create a pose with lerp/slerp that is interpolated between the two poses.
+        pose.meshToLocalMatrix = Matrix4::Lerp(*track.GetValues(current), *track.GetValues(next), t);
+        return pose;
     }
 
     // Error case: just return something invalid.
@@ -182,17 +96,19 @@ VertexAnimationTransformPose VertexAnimation::SampleTransformPose(float time, in
     return invalidPose;
 }
 
-VertexAnimationAABBPose VertexAnimation::SampleAABBPose(int frame, int meshIndex)
+VertexAnimationAABBPose VertexAnimation::SampleAABBPose(int frame, int meshIndex) const
 {
     // Make sure we're in bounds.
-    if(meshIndex >= 0 && meshIndex < mAABBPoses.size() && mAABBPoses[meshIndex] != nullptr)
+    if(meshIndex >= 0 && meshIndex < mAABBTracks.size() && !mAABBTracks[meshIndex].IsEmpty())
     {
         // Retrieve pose corresponding to the desired frame.
-        VertexAnimationPose* pose = mAABBPoses[meshIndex]->GetForFrame(frame);
-        if(pose != nullptr)
-        {
-            return *static_cast<VertexAnimationAABBPose*>(pose);
-        }
+        const VertexAnimationTrack<AABB>& track = mAABBTracks[meshIndex];
+        int keyframe = track.GetKeyframeForFrame(frame);
+
+        VertexAnimationAABBPose pose;
+        pose.frameNumber = track.keyframeFrames[keyframe];
+        pose.aabb = *track.GetValues(keyframe);
+        return pose;
     }
 
     // Error case: just return something invalid.
@@ -201,45 +117,23 @@ VertexAnimationAABBPose VertexAnimation::SampleAABBPose(int frame, int meshIndex
     return invalidPose;
 }
 
-VertexAnimationAABBPose VertexAnimation::SampleAABBPose(float time, int framesPerSecond, int meshIndex)
+VertexAnimationAABBPose VertexAnimation::SampleAABBPose(float time, int framesPerSecond, int meshIndex) const
 {
     // Make sure we're in bounds.
-    if(meshIndex >= 0 && meshIndex < mAABBPoses.size() && mAABBPoses[meshIndex] != nullptr)
+    if(meshIndex >= 0 && meshIndex < mAABBTracks.size() && !mAABBTracks[meshIndex].IsEmpty())
     {
-        // Caller may pass in a global time that extends beyond the local time of this particular animation.
-        // Desire here is for the animation to "loop", so we calculate how many seconds in we are.
-        float duration = GetDuration(framesPerSecond);
-        float localTime = time;
-        if(localTime > duration)
-        {
-            localTime = Math::Mod(time, duration);
-        }
-
         // Retrieve current/next poses based on the desired time.
-        VertexAnimationPose* current;
-        VertexAnimationPose* next;
+        const VertexAnimationTrack<AABB>& track = mAABBTracks[meshIndex];
+        int current;
+        int next;
         float t;
-        mAABBPoses[meshIndex]->GetForTime(localTime, framesPerSecond, current, next, t);
-
-        // We at least need a valid current pose.
-        if(current != nullptr)
-        {
-            return *static_cast<VertexAnimationAABBPose*>(current);
+        track.GetKeyframesForTime(GetLocalTime(time, framesPerSecond), framesPerSecond, current, next, t);
 
-            /*
-            // If no next pose, we can just use the current pose directly.
-            if(next == nullptr)
-            {
-                return *static_cast<VertexAnimationAABBPose*>(current);
-            }
-
-            // Finally, create a pose with lerp/slerp that is interpolated between the two poses.
-            VertexAnimationAABBPose pose;
-            pose.meshToLocalMatrix = Matrix4::Lerp(static_cast<VertexAnimationTransformPose*>(current)->meshToLocalMatrix,
-                                                   static_cast<VertexAnimationTransformPose*>(next)->meshToLocalMatrix, t);
-            return pose;
-            */
-        }
+        // Bounds aren't interpolated - just use the current pose.
+        VertexAnimationAABBPose pose;
+        pose.frameNumber = track.keyframeFrames[current];
+        pose.aabb = *track.GetValues(current);
+        return pose;
     }
 
     // Error case: just return something invalid.
@@ -248,169 +142,75 @@ VertexAnimationAABBPose VertexAnimation::SampleAABBPose(float time, int framesPe
     return invalidPose;
 }
 
-VertexAnimationVertexPose VertexAnimation::SampleVertexPose(int frame, int meshIndex, int submeshIndex)
+bool VertexAnimation::SampleVertexPose(int frame, int meshIndex, int submeshIndex, Vector3* outPositions, int vertexCount) const
 {
-    // Find the first vertex pose defined for this mesh/submesh.
-    VertexAnimationVertexPose* firstVertexPose = nullptr;
-    auto it = mVertexPoses.find(meshIndex);
-    if(it != mVertexPoses.end())
-    {
-        auto it2 = it->second.find(submeshIndex);
-        if(it2 != it->second.end())
-        {
-            firstVertexPose = it2->second;
-        }
-    }
-
-    // Make sure we found a valid pose.
-    if(firstVertexPose != nullptr)
-    {
-        VertexAnimationPose* pose = firstVertexPose->GetForFrame(frame);
-        if(pose != nullptr)
-        {
-            return *static_cast<VertexAnimationVertexPose*>(pose);
-        }
-    }
-
-    // Error case: return something invalid.
-    VertexAnimationVertexPose invalidPose;
-    invalidPose.frameNumber = -1;
-    return invalidPose;
+    // Find the vertex track for this mesh/submesh.
+    const VertexAnimationTrack<Vector3>* track = GetVertexTrack(meshIndex, submeshIndex);
+    if(track == nullptr) { return false; }
+
+    // Copy positions from the keyframe for this frame.
+    const Vector3* positions = track->GetValues(track->GetKeyframeForFrame(frame));
+    std::copy(positions, positions + std::min(vertexCount, track->valuesPerKeyframe), outPositions);
+    return true;
 }
 
-VertexAnimationVertexPose VertexAnimation::SampleVertexPose(float time, int framesPerSecond, int meshIndex, int submeshIndex)
+bool VertexAnimation::SampleVertexPose(float time, int framesPerSecond, int meshIndex, int submeshIndex, Vector3* outPositions, int vertexCount) const
 {
-    // Find the first vertex pose defined for this mesh/submesh.
-    VertexAnimationVertexPose* firstVertexPose = nullptr;
-    auto it = mVertexPoses.find(meshIndex);
-    if(it != mVertexPoses.end())
-    {
-        auto it2 = it->second.find(submeshIndex);
-        if(it2 != it->second.end())
-        {
-            firstVertexPose = it2->second;
-        }
-    }
-
-    // Make sure we found a pose.
-    if(firstVertexPose != nullptr)
+    // Find the vertex track for this mesh/submesh.
+    const VertexAnimationTrack<Vector3>* track = GetVertexTrack(meshIndex, submeshIndex);
+    if(track == nullptr) { return false; }
+
+    // Retrieve current/next poses based on the desired time.
+    int current;
+    int next;
+    float t;
+    track->GetKeyframesForTime(GetLocalTime(time, framesPerSecond), framesPerSecond, current, next, t);
+
+    // If no next pose, we can just use the current pose directly.
+    int count = std::min(vertexCount, track->valuesPerKeyframe);
+    const Vector3* currentPositions = track->GetValues(current);
+    if(next < 0)
     {
-        // Caller may pass in a global time that extends beyond the local time of this particular animation.
-        // Desire here is for the animation to "loop", so we calculate how many seconds in we are.
-        float duration = GetDuration(framesPerSecond);
-        float localTime = time;
-        if(localTime > duration)
-        {
-            localTime = Math::Mod(time, duration);
-        }
-
-        // Retrieve current/next poses based on the desired time.
-        VertexAnimationPose* current;
-        VertexAnimationPose* next;
-        float t;
-        firstVertexPose->GetForTime(localTime, framesPerSecond, current, next, t);
-
-        // We at least need a valid current pose.
-        if(current != nullptr)
-        {
-            // If no next pose, we can just use the current pose directly.
-            if(next == nullptr)
-            {
-                return *static_cast<VertexAnimationVertexPose*>(current);
-            }
-
-            // Now calculate interpolated positions between current and next poses for this time t.
-            VertexAnimationVertexPose* currentVertPose = static_cast<VertexAnimationVertexPose*>(current);
-            VertexAnimationVertexPose* nextVertPose = static_cast<VertexAnimationVertexPose*>(next);
-            VertexAnimationVertexPose pose;
-            for(int i = 0; i < currentVertPose->vertexPositions.size(); i++)
-            {
-                pose.vertexPositions.push_back(Vector3::Lerp(currentVertPose->vertexPositions[i], nextVertPose->vertexPositions[i], t));
-            }
-            return pose;
-        }
+        std::copy(currentPositions, currentPositions + count, outPositions);
+        return true;
     }
 
-    // Error case: return something invalid.
-    VertexAnimationVertexPose invalidPose;
-    invalidPose.frameNumber = -1;
-    return invalidPose;
+    // Now calculate interpolated positions between current and next poses for this time t.
+    Vector3::Lerp(currentPositions, track->GetValues(next), t, outPositions, count);
+    return true;
 }
 
-Vector3 VertexAnimation::SampleVertexPosition(int frame, int meshIndex, int submeshIndex, int vertexIndex)
+Vector3 VertexAnimation::SampleVertexPosition(int frame, int meshIndex, int submeshIndex, int vertexIndex) const
 {
-    // Find the first vertex pose defined for this mesh/submesh.
-    VertexAnimationVertexPose* firstVertexPose = nullptr;
-    auto it = mVertexPoses.find(meshIndex);
-    if(it != mVertexPoses.end())
+    // Find the vertex track for this mesh/submesh.
+    const VertexAnimationTrack<Vector3>* track = GetVertexTrack(meshIndex, submeshIndex);
+    if(track != nullptr && vertexIndex >= 0 && vertexIndex < track->valuesPerKeyframe)
     {
-        auto it2 = it->second.find(submeshIndex);
-        if(it2 != it->second.end())
-        {
-            firstVertexPose = it2->second;
-        }
-    }
-
-    // Make sure we found a pose.
-    if(firstVertexPose != nullptr)
-    {
-        VertexAnimationPose* pose = firstVertexPose->GetForFrame(frame);
-        if(pose != nullptr)
-        {
-            VertexAnimationVertexPose* vertexPose = static_cast<VertexAnimationVertexPose*>(pose);
-            if(vertexIndex >= 0 && vertexIndex < vertexPose->vertexPositions.size())
-            {
-                return vertexPose->vertexPositions[vertexIndex];
-            }
-        }
+        return track->GetValues(track->GetKeyframeForFrame(frame))[vertexIndex];
     }
     return Vector3::Zero;
 }
 
-Vector3 VertexAnimation::SampleVertexPosition(float time, int framesPerSecond, int meshIndex, int submeshIndex, int vertexIndex)
+Vector3 VertexAnimation::SampleVertexPosition(float time, int framesPerSecond, int meshIndex, int submeshIndex, int vertexIndex) const
 {
-    // Find the first vertex pose defined for this mesh/submesh.
-    VertexAnimationVertexPose* firstVertexPose = nullptr;
-    auto it = mVertexPoses.find(meshIndex);
-    if(it != mVertexPoses.end())
-    {
-        auto it2 = it->second.find(submeshIndex);
-        if(it2 != it->second.end())
-        {
-            firstVertexPose = it2->second;
-        }
-    }
-
-    // Make sure we found a valid first pose.
-    if(firstVertexPose != nullptr)
+    // Find the vertex track for this mesh/submesh.
+    const VertexAnimationTrack<Vector3>* track = GetVertexTrack(meshIndex, submeshIndex);
+    if(track != nullptr && vertexIndex >= 0 && vertexIndex < track->valuesPerKeyframe)
     {
-        float duration = GetDuration(framesPerSecond);
-        float localTime = time;
-        if(localTime > duration)
-        {
-            localTime = Math::Mod(time, duration);
-        }
-
         // Retrieve current/next poses based on the desired time.
-        VertexAnimationPose* current;
-        VertexAnimationPose* next;
+        int current;
+        int next;
         float t;
-        firstVertexPose->GetForTime(localTime, framesPerSecond, current, next, t);
+        track->GetKeyframesForTime(GetLocalTime(time, framesPerSecond), framesPerSecond, current, next, t);
 
-        // We at least need a valid current pose.
-        if(current != nullptr)
+        // If no next pose, we can just use the current pose directly.
+        if(next < 0)
         {
-            // If no next pose, we can just use the current pose directly.
-            if(next == nullptr)
-            {
-                return static_cast<VertexAnimationVertexPose*>(current)->vertexPositions[vertexIndex];
-            }
-
-            // Now calculate interpolated positions between current and next poses for this time t.
-            VertexAnimationVertexPose* currentVertPose = static_cast<VertexAnimationVertexPose*>(current);
-            VertexAnimationVertexPose* nextVertPose = static_cast<VertexAnimationVertexPose*>(next);
-            return Vector3::Lerp(currentVertPose->vertexPositions[vertexIndex], nextVertPose->vertexPositions[vertexIndex], t);
+            return track->GetValues(current)[vertexIndex];
         }
+
+        // Now calculate interpolated position between current and next poses for this time t.
+        return Vector3::Lerp(track->GetValues(current)[vertexIndex], track->GetValues(next)[vertexIndex], t);
     }
     return Vector3::Zero;
 }
@@ -455,16 +255,15 @@ void VertexAnimation::ParseFromData(uint8_t* data, uint32_t dataLength)
 
     // Next is a byte offset within the data for each keyframe.
     // We will just read the data in order below, but this is useful to assert that we are aligned for each keyframe.
-    std::vector<unsigned int> offsets;
-    for(int i = 0; i < mFrameCount; i++)
-    {
-        offsets.push_back(reader.ReadUInt());
-    }
+    std::vector<unsigned int> offsets(mFrameCount);
+    reader.ReadArray(offsets.data(), mFrameCount);
+
+    // Each mesh gets a track for each type of data. Vertex tracks are created as submeshes are encountered.
+    mVertexTracks.resize(meshCount);
+    mTransformTracks.resize(meshCount);
+    mAABBTracks.resize(meshCount);
 
     // Read in data for each keyframe.
-    std::unordered_map<int, VertexAnimationVertexPose*> lastVertexPoseLookup;
-    std::unordered_map<int, VertexAnimationTransformPose*> lastTransformPoseLookup;
-    std::unordered_map<int, VertexAnimationAABBPose*> lastAABBPoseLookup;
     for(int i = 0; i < mFrameCount; i++)
     {
         #ifdef DEBUG_OUTPUT
@@ -514,38 +313,17 @@ void VertexAnimation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     std::cout << "        Submesh Index: " << submeshIndex << std::endl;
                     #endif
 
-                    // This is a pretty sorry hash...but assuming we'll never
-                    // have more than 1000 submeshes (pretty likely for GK3), this'll do OK.
-                    int hash = meshIndex * 1000 + submeshIndex;
-
-                    // Create a vertex pose for this frame and stick it in our dictionary and linked list.
-                    VertexAnimationVertexPose* vertexPose = new VertexAnimationVertexPose();
-                    vertexPose->frameNumber = i;
-                    if(i == 0)
-                    {
-                        mVertexPoses[meshIndex][submeshIndex] = vertexPose;
-                        lastVertexPoseLookup[hash] = vertexPose;
-                    }
-                    else
-                    {
-                        lastVertexPoseLookup[hash]->next = vertexPose;
-                        lastVertexPoseLookup[hash] = vertexPose;
-                    }
-
                     // 2 bytes: Vertex count.
                     unsigned short vertexCount = reader.ReadUShort();
                     #ifdef DEBUG_OUTPUT
                     std::cout << "        Vertex Count: " << vertexCount << std::endl;
                     #endif
 
+                    // Add a keyframe for this frame to the submesh's track.
+                    Vector3* positions = AddVertexKeyframe(meshIndex, submeshIndex, i, vertexCount);
+
                     // Next, three floats per vertex (X, Y, Z).
-                    for(int k = 0; k < vertexCount; k++)
-                    {
-                        float x = reader.ReadFloat();
-                        float y = reader.ReadFloat();
-                        float z = reader.ReadFloat();
-                        vertexPose->vertexPositions.push_back(Vector3(x, y, z));
-                    }
+                    reader.ReadVector3Array(positions, vertexCount);
                 }
                 // Identifier 1 also is vertex data, but in a compressed format.
                 else if(dataId == 1)
@@ -564,30 +342,16 @@ void VertexAnimation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     std::cout << "        Submesh Index: " << submeshIndex << std::endl;
                     #endif
 
-                    // Find position data from last recorded frame.
-                    int hash = meshIndex * 1000 + submeshIndex;
-                    std::vector<Vector3>& prevPositions = lastVertexPoseLookup[hash]->vertexPositions;
-
-                    // Create a vertex pose to hold this new data and insert it into the vertex pose chain.
-                    VertexAnimationVertexPose* vertexPose = new VertexAnimationVertexPose();
-                    vertexPose->frameNumber = i;
-                    if(i == 0)
-                    {
-                        mVertexPoses[meshIndex][submeshIndex] = vertexPose;
-                        lastVertexPoseLookup[hash] = vertexPose;
-                    }
-                    else
-                    {
-                        lastVertexPoseLookup[hash]->next = vertexPose;
-                        lastVertexPoseLookup[hash] = vertexPose;
-                    }
-
                     // 2 bytes: Vertex count.
                     unsigned short vertexCount = reader.ReadUShort();
                     #ifdef DEBUG_OUTPUT
                     std::cout << "        Vertex Count: " << vertexCount << std::endl;
                     #endif
 
+                    // Add a keyframe for this frame to the submesh's track.
+                    // Compressed data is stored as deltas from the previous keyframe, so it starts as a copy of the previous keyframe.
+                    Vector3* positions = AddVertexKeyframe(meshIndex, submeshIndex, i, vertexCount);
+
                     // Next ((VertexCount/4) + 1) bytes: Compression info for vertex data.
                     // Every 2 bits indicates how the vertex at that index is compressed.
                     unsigned short compressionInfoSize = (vertexCount / 4) + 1;
@@ -627,7 +391,7 @@ void VertexAnimation::ParseFromData(uint8_t* data, uint32_t dataLength)
                         // If the vertex data hasn't changed since last frame, it isn't stored, to save space.
                         if(vertexDataFormat[k] == 0)
                         {
-                            vertexPose->vertexPositions.push_back(prevPositions[k]);
+                            // Nothing to do - position is already copied from previous keyframe.
                         }
                         // 1 means (X, Y, Z) are compressed in next 3 bytes.
                         // This tends to be used for storing vertex position delta for internal vertices in a mesh.
@@ -636,7 +400,7 @@ void VertexAnimation::ParseFromData(uint8_t* data, uint32_t dataLength)
                             float x = DecompressFloatFromByte(reader.ReadSByte());
                             float y = DecompressFloatFromByte(reader.ReadSByte());
                             float z = DecompressFloatFromByte(reader.ReadSByte());
-                            vertexPose->vertexPositions.push_back(prevPositions[k] + Vector3(x, y, z));
+                            positions[k] += Vector3(x, y, z);
                         }
                         // 2 means (X, Y, Z) are compressed in next 3 ushorts.
                         // This tends to be used for storing vertex position deltas where meshes meet (like a knee or elbow).
@@ -645,7 +409,7 @@ void VertexAnimation::ParseFromData(uint8_t* data, uint32_t dataLength)
                             float x = DecompressFloatFromUShort(reader.ReadUShort());
                             float y = DecompressFloatFromUShort(reader.ReadUShort());
                             float z = DecompressFloatFromUShort(reader.ReadUShort());
-                            vertexPose->vertexPositions.push_back(prevPositions[k] + Vector3(x, y, z));
+                            positions[k] += Vector3(x, y, z);
                         }
                         // 3 means (X, Y, Z) are not compressed - just floats.
                         else if(vertexDataFormat[k] == 3)
@@ -653,7 +417,7 @@ void VertexAnimation::ParseFromData(uint8_t* data, uint32_t dataLength)
                             float x = reader.ReadFloat();
                             float y = reader.ReadFloat();
                             float z = reader.ReadFloat();
-                            vertexPose->vertexPositions.push_back(prevPositions[k] + Vector3(x, y, z));
+                            positions[k] += Vector3(x, y, z);
                         }
                     }
 
@@ -695,19 +459,9 @@ void VertexAnimation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     Matrix4 meshToLocalMatrix;
                     meshToLocalMatrix.SetColumns(Vector4(iBasis), Vector4(jBasis), Vector4(kBasis), Vector4(meshPos, 1.0f));
 
-                    VertexAnimationTransformPose* transformPose = new VertexAnimationTransformPose();
-                    transformPose->frameNumber = i;
-                    transformPose->meshToLocalMatrix = meshToLocalMatrix;
-                    if(i == 0)
-                    {
-                        mTransformPoses.push_back(transformPose);
-                        lastTransformPoseLookup[meshIndex] = transformPose;
-                    }
-                    else
-                    {
-                        lastTransformPoseLookup[meshIndex]->next = transformPose;
-                        lastTransformPoseLookup[meshIndex] = transformPose;
-                    }
+                    VertexAnimationTrack<Matrix4>& transformTrack = mTransformTracks[meshIndex];
+                    transformTrack.keyframeFrames.push_back(i);
+                    transformTrack.values.push_back(meshToLocalMatrix);
                 }
                 // Identifier 3 is min/max data.
                 else if(dataId == 3)
@@ -722,23 +476,13 @@ void VertexAnimation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     assert(blockByteCount == 24);
                     byteCount -= blockByteCount + 4;
 
-                    VertexAnimationAABBPose* aabbPose = new VertexAnimationAABBPose();
-                    aabbPose->frameNumber = i;
-                    if(i == 0)
-                    {
-                        mAABBPoses.push_back(aabbPose);
-                        lastAABBPoseLookup[meshIndex] = aabbPose;
-                    }
-                    else
-                    {
-                        lastAABBPoseLookup[meshIndex]->next = aabbPose;
-                        lastAABBPoseLookup[meshIndex] = aabbPose;
-                    }
-
                     // Assign min/max data.
                     Vector3 min = reader.ReadVector3();
                     Vector3 max = reader.ReadVector3();
-                    aabbPose->aabb = AABB(min, max);
+
+                    VertexAnimationTrack<AABB>& aabbTrack = mAABBTracks[meshIndex];
+                    aabbTrack.keyframeFrames.push_back(i);
+                    aabbTrack.values.push_back(AABB(min, max));
 
                     #ifdef DEBUG_OUTPUT
                     std::cout << "        Min: " << min << std::endl;
@@ -754,6 +498,67 @@ void VertexAnimation::ParseFromData(uint8_t* data, uint32_t dataLength)
     } // iterate keyframes
 }
 
+Vector3* VertexAnimation::AddVertexKeyframe(int meshIndex, int submeshIndex, int frame, int vertexCount)
+{
+    std::vector<VertexAnimationTrack<Vector3>>& meshTracks = mVertexTracks[meshIndex];
+    if(submeshIndex >= meshTracks.size())
+    {
+        meshTracks.resize(submeshIndex + 1);
+    }
+
+    // The vertex count for a submesh shouldn't change from keyframe to keyframe.
+    // But if it somehow does, the track's keyframes are the max size, and any extra vertices are zero.
+    VertexAnimationTrack<Vector3>& track = meshTracks[submeshIndex];
+    if(vertexCount > track.valuesPerKeyframe || track.IsEmpty())
+    {
+        if(!track.IsEmpty())
+        {
+            std::cout << "Vertex count for submesh " << submeshIndex << " of mesh " << meshIndex << " changed on frame " << frame << std::endl;
+            std::vector<Vector3> oldValues = std::move(track.values);
+            track.values.assign(track.keyframeFrames.size() * vertexCount, Vector3::Zero);
+            for(size_t k = 0; k < track.keyframeFrames.size(); ++k)
+            {
+                std::copy(oldValues.begin() + k * track.valuesPerKeyframe, oldValues.begin() + (k + 1) * track.valuesPerKeyframe, track.values.begin() + k * vertexCount);
+            }
+        }
+        track.valuesPerKeyframe = vertexCount;
+    }
+
+    // Add the keyframe. Values start as a copy of the previous keyframe (or zero, if this is the first).
+    size_t prevStart = track.values.size() - (track.IsEmpty() ? 0 : track.valuesPerKeyframe);
+    track.keyframeFrames.push_back(frame);
+    track.values.resize(track.values.size() + track.valuesPerKeyframe, Vector3::Zero);
+    if(track.keyframeFrames.size() > 1)
+    {
+        std::copy(track.values.begin() + prevStart, track.values.begin() + prevStart + track.valuesPerKeyframe, track.values.end() - track.valuesPerKeyframe);
+    }
+    return &track.values[track.values.size() - track.valuesPerKeyframe];
+}
+
+const VertexAnimationTrack<Vector3>* VertexAnimation::GetVertexTrack(int meshIndex, int submeshIndex) const
+{
+    if(meshIndex >= 0 && meshIndex < mVertexTracks.size() &&
+       submeshIndex >= 0 && submeshIndex < mVertexTracks[meshIndex].size() &&
+       !mVertexTracks[meshIndex][submeshIndex].IsEmpty())
+    {
+        return &mVertexTracks[meshIndex][submeshIndex];
+    }
+    return nullptr;
+}
+
+float VertexAnimation::GetLocalTime(float time, int framesPerSecond) const
+{
+    // Caller may pass in a global time that extends beyond the local time of this particular animation.
+    // Desire here is for the animation to "loop", so we calculate how many seconds in we are.
+    float duration = GetDuration(framesPerSecond);
+    float localTime = time;
+    if(localTime > duration)
+    {
+        localTime = Math::Mod(time, duration);
+    }
+    return localTime;
+}
+
 float VertexAnimation::DecompressFloatFromByte(unsigned char val)
 {
     // Sign flag is 1 bit - masked by 1000 0000.
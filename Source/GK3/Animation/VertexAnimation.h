@@ -9,36 +9,95 @@
 #pragma once
 #include "Asset.h"
 
+#include <algorithm>
 #include <vector>
-#include <unordered_map>
 
 #include "AABB.h"
 #include "Matrix4.h"
 #include "Vector3.h"
 
-struct VertexAnimationPose
+struct VertexAnimationTransformPose
 {
+    // Frame the pose was sampled from, or -1 if the sample is invalid.
     int frameNumber = 0;
-    VertexAnimationPose* next = nullptr;
-
-    virtual ~VertexAnimationPose() = default;
-    VertexAnimationPose* GetForFrame(int frame);
-    void GetForTime(float time, int framesPerSecond, VertexAnimationPose*& outCurrent, VertexAnimationPose*& outNext, float& outT);
-};
-
-struct VertexAnimationVertexPose : public VertexAnimationPose
-{
-    std::vector<Vector3> vertexPositions;
+    Matrix4 meshToLocalMatrix;
 };
 
-struct VertexAnimationTransformPose : public VertexAnimationPose
+struct VertexAnimationAABBPose
 {
-    Matrix4 meshToLocalMatrix;
+    // Frame the pose was sampled from, or -1 if the sample is invalid.
+    int frameNumber = 0;
+    AABB aabb;
 };
 
-struct VertexAnimationAABBPose : public VertexAnimationPose
+// All keyframes of one type of data (vertex positions, transforms, or bounds) for a single mesh or submesh.
+// Keyframe values are stored contiguously, so sampling doesn't need to chase pointers or allocate.
+template<typename T>
+struct VertexAnimationTrack
 {
-    AABB aabb;
+    // Number of values per keyframe (vertex count for vertex data, one for everything else).
+    int valuesPerKeyframe = 1;
+
+    // Frame number of each keyframe, in ascending order.
+    std::vector<int> keyframeFrames;
+
+    // Values for all keyframes. Values for keyframe N start at index (N * valuesPerKeyframe).
+    std::vector<T> values;
+
+    bool IsEmpty() const { return keyframeFrames.empty(); }
+    size_t GetMemorySize() const { return keyframeFrames.capacity() * sizeof(int) + values.capacity() * sizeof(T); }
+    const T* GetValues(int keyframe) const { return &values[keyframe * valuesPerKeyframe]; }
+
+    // Gets the keyframe for a frame. If no keyframe is on that exact frame, the closest previous keyframe is used.
+    int GetKeyframeForFrame(int frame) const
+    {
+        // Most tracks have a keyframe on every frame, so the keyframe index is usually the frame number.
+        int keyframeCount = static_cast<int>(keyframeFrames.size());
+        if(frame >= 0 && frame < keyframeCount && keyframeFrames[frame] == frame)
+        {
+            return frame;
+        }
+
+        // Otherwise, binary search for the last keyframe at or before the frame.
+        // If the frame is before the first keyframe, the first keyframe is used.
+        auto it = std::upper_bound(keyframeFrames.begin(), keyframeFrames.end(), frame);
+        return it == keyframeFrames.begin() ? 0 : static_cast<int>(it - keyframeFrames.begin()) - 1;
+    }
+
+    // Gets the current and next keyframes for a time, and how far between them the time is.
+    // Next keyframe is -1 if there's nothing to interpolate with.
+    void GetKeyframesForTime(float time, int framesPerSecond, int& outCurrent, int& outNext, float& outT) const
+    {
+        // NOTE: we're assuming the time passed in is "local" - within the duration of the full animation.
+        // Calculate how many seconds should be used for a single frame.
+        float secondsPerFrame = 1.0f / framesPerSecond;
+
+        // Find the keyframe for the frame this time is on.
+        // Then nudge it, so float rounding on frame boundaries gives the same result as comparing times.
+        int keyframeCount = static_cast<int>(keyframeFrames.size());
+        outCurrent = GetKeyframeForFrame(static_cast<int>(time * framesPerSecond));
+        while(outCurrent + 1 < keyframeCount && secondsPerFrame * keyframeFrames[outCurrent + 1] <= time)
+        {
+            ++outCurrent;
+        }
+        while(outCurrent > 0 && secondsPerFrame * keyframeFrames[outCurrent] > time)
+        {
+            --outCurrent;
+        }
+
+        // GK3 does a somewhat wasteful thing: poses are expected to be defined for all frames. If NOT, use the closes previous frame.
+        // SO: if the next pose IS NOT for the next frame, we just use the current pose with no interpolation.
+        outNext = -1;
+        outT = 0.0f;
+        if(outCurrent + 1 < keyframeCount && keyframeFrames[outCurrent + 1] == keyframeFrames[outCurrent] + 1)
+        {
+            // Calculate a "t" value for interpolating between the two poses.
+            outNext = outCurrent + 1;
+            float currentPoseTime = secondsPerFrame * keyframeFrames[outCurrent];
+            outT = (time - currentPoseTime) / secondsPerFrame;
+            outT = outT < 0.0f ? 0.0f : (outT > 1.0f ? 1.0f : outT);
+        }
+    }
 };
 
 class VertexAnimation : public Asset
@@ -46,24 +105,26 @@ class VertexAnimation : public Asset
     TYPEINFO_SUB(VertexAnimation, Asset);
 public:
     VertexAnimation(const std::string& name, AssetScope scope) : Asset(name, scope) { }
-    ~VertexAnimation();
 
     void Load(AssetData& data);
+    size_t CalculateMemorySize(uint32_t loadedDataLength) const override;
 
     // Queries transform (position, rotation, scale) for a mesh at a frame/time.
-    VertexAnimationTransformPose SampleTransformPose(int frame, int meshIndex);
-    VertexAnimationTransformPose SampleTransformPose(float time, int framesPerSecond, int meshIndex);
+    VertexAnimationTransformPose SampleTransformPose(int frame, int meshIndex) const;
+    VertexAnimationTransformPose SampleTransformPose(float time, int framesPerSecond, int meshIndex) const;
 
-    VertexAnimationAABBPose SampleAABBPose(int frame, int meshIndex);
-    VertexAnimationAABBPose SampleAABBPose(float time, int framesPerSecond, int meshIndex);
+    VertexAnimationAABBPose SampleAABBPose(int frame, int meshIndex) const;
+    VertexAnimationAABBPose SampleAABBPose(float time, int framesPerSecond, int meshIndex) const;
 
-    // Queries ALL vertices for a submesh at a frame/time.
-    VertexAnimationVertexPose SampleVertexPose(int frame, int meshIndex, int submeshIndex);
-    VertexAnimationVertexPose SampleVertexPose(float time, int framesPerSecond, int meshIndex, int submeshIndex);
+    // Queries ALL vertices for a submesh at a frame/time, writing them to the provided buffer.
+    // The buffer must have room for vertexCount positions, which should match the submesh's vertex count.
+    // Returns false (and leaves the buffer alone) if the animation has no vertex data for this submesh.
+    bool SampleVertexPose(int frame, int meshIndex, int submeshIndex, Vector3* outPositions, int vertexCount) const;
+    bool SampleVertexPose(float time, int framesPerSecond, int meshIndex, int submeshIndex, Vector3* outPositions, int vertexCount) const;
 
     // Queries single vertex for a submesh at a frame/time.
-    Vector3 SampleVertexPosition(int frame, int meshIndex, int submeshIndex, int vertexIndex);
-    Vector3 SampleVertexPosition(float time, int framesPerSecond, int meshIndex, int submeshIndex, int vertexIndex);
+    Vector3 SampleVertexPosition(int frame, int meshIndex, int submeshIndex, int vertexIndex) const;
+    Vector3 SampleVertexPosition(float time, int framesPerSecond, int meshIndex, int submeshIndex, int vertexIndex) const;
 
     // Length and duration.
     int GetFrameCount() const { return mFrameCount; }
@@ -79,18 +140,20 @@ private:
     // If we ever play the animation on a mismatched model, the graphics will probably glitch out.
     std::string mModelName;
 
-    // Each array element is the FIRST vertex pose for each mesh/submesh index.
-    // Subsequent poses for the mesh are stored in the "next" of the first pose.
-    std::unordered_map<int, std::unordered_map<int, VertexAnimationVertexPose*>> mVertexPoses;
+    // Vertex positions, indexed by mesh index and then submesh index.
+    // A submesh with no vertex animation has an empty track.
+    std::vector<std::vector<VertexAnimationTrack<Vector3>>> mVertexTracks;
 
-    // Each element of array is the FIRST transform poses for each mesh index.
-    // Subsequent poses for the mesh are stored in the "next" of the first pose.
-    std::vector<VertexAnimationTransformPose*> mTransformPoses;
-
-    std::vector<VertexAnimationAABBPose*> mAABBPoses;
+    // Transforms and bounds, indexed by mesh index.
+    std::vector<VertexAnimationTrack<Matrix4>> mTransformTracks;
+    std::vector<VertexAnimationTrack<AABB>> mAABBTracks;
 
     void ParseFromData(uint8_t* data, uint32_t dataLength);
 
+    Vector3* AddVertexKeyframe(int meshIndex, int submeshIndex, int frame, int vertexCount);
+    const VertexAnimationTrack<Vector3>* GetVertexTrack(int meshIndex, int submeshIndex) const;
+    float GetLocalTime(float time, int framesPerSecond) const;
+
     float DecompressFloatFromByte(unsigned char val);
     float DecompressFloatFromUShort(unsigned short val);
 };
\ No newline at end of file
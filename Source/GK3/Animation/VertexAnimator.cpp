@@ -1,10 +1,13 @@
 #include "VertexAnimator.h"
 
+#include <algorithm>
+#include <cassert>
 #include <vector>
 
 #include "Actor.h"
 #include "Mesh.h"
 #include "MeshRenderer.h"
+#include "ThreadPool.h"
 #include "VertexAnimation.h"
 
 TYPEINFO_INIT(VertexAnimator, Component, 10)
@@ -12,11 +15,112 @@ TYPEINFO_INIT(VertexAnimator, Component, 10)
 
 }
 
+VertexAnimatorSampleBatch* VertexAnimatorSampleBatch::sOpenBatch = nullptr;
+
+VertexAnimatorSampleBatch::VertexAnimatorSampleBatch()
+{
+    assert(sOpenBatch == nullptr);
+    sOpenBatch = this;
+}
+
+VertexAnimatorSampleBatch::~VertexAnimatorSampleBatch()
+{
+    End();
+}
+
+void VertexAnimatorSampleBatch::End()
+{
+    if(sOpenBatch != this) { return; }
+    PROFILER_SCOPED(VertexAnimatorSampleBatch);
+    sOpenBatch = nullptr;
+    if(mAnimators.empty()) { return; }
+
+    // Animators that play on the same model share the same meshes. If they were sampled on different threads at once, they'd stomp on each other.
+    // So, group animators by the meshes they use (keeping update order within a group), and sample each group on a single thread.
+    auto getMeshesKey = [](VertexAnimator* animator) {
+        const std::vector<Mesh*>& meshes = animator->mMeshRenderer->GetMeshes();
+        return meshes.empty() ? nullptr : meshes.front();
+    };
+    std::stable_sort(mAnimators.begin(), mAnimators.end(), [&getMeshesKey](VertexAnimator* a, VertexAnimator* b) {
+        return std::less<Mesh*>()(getMeshesKey(a), getMeshesKey(b));
+    });
+
+    // Find where each group starts. The last entry marks the end of the last group.
+    mGroupStarts.clear();
+    for(size_t i = 0; i < mAnimators.size(); ++i)
+    {
+        if(i == 0 || getMeshesKey(mAnimators[i]) != getMeshesKey(mAnimators[i - 1]))
+        {
+            mGroupStarts.push_back(i);
+        }
+    }
+    mGroupStarts.push_back(mAnimators.size());
+
+    // Sample each group on worker threads. This only touches CPU-side data, so it's safe to do off the main thread.
+    // While waiting, the main thread only helps with this batch's groups - it never picks up unrelated (possibly long) jobs, like asset loads.
+    // With a single group, there's nothing to spread out, so it's just sampled here.
+    auto sampleGroup = [this](size_t group) {
+        for(size_t i = mGroupStarts[group]; i < mGroupStarts[group + 1]; ++i)
+        {
+            VertexAnimator* animator = mAnimators[i];
+            if(animator->mBatchedAnimation != nullptr)
+            {
+                animator->SampleMeshes(animator->mBatchedAnimation, animator->mBatchedTime);
+            }
+        }
+    };
+    size_t groupCount = mGroupStarts.size() - 1;
+    if(groupCount == 1)
+    {
+        sampleGroup(0);
+    }
+    else
+    {
+        ThreadPool::ParallelFor(0, groupCount, 1, sampleGroup);
+    }
+
+    // Uploading to the GPU must be done on the main thread.
+    for(VertexAnimator* animator : mAnimators)
+    {
+        animator->UploadSampledMeshes();
+        animator->mSampleBatch = nullptr;
+        animator->mBatchedAnimation = nullptr;
+    }
+    mAnimators.clear();
+}
+
+void VertexAnimatorSampleBatch::Add(VertexAnimator* animator)
+{
+    if(animator->mSampleBatch == nullptr)
+    {
+        mAnimators.push_back(animator);
+        animator->mSampleBatch = this;
+    }
+}
+
+void VertexAnimatorSampleBatch::Remove(VertexAnimator* animator)
+{
+    if(animator->mSampleBatch == this)
+    {
+        mAnimators.erase(std::find(mAnimators.begin(), mAnimators.end(), animator));
+        animator->mSampleBatch = nullptr;
+    }
+}
+
 VertexAnimator::VertexAnimator(Actor* owner) : Component(owner)
 {
     mMeshRenderer = owner->GetComponent<MeshRenderer>();
 }
 
+VertexAnimator::~VertexAnimator()
+{
+    // Don't leave a dangling pointer in the batch.
+    if(mSampleBatch != nullptr)
+    {
+        mSampleBatch->Remove(this);
+    }
+}
+
 void VertexAnimator::Start(const VertexAnimParams& params)
 {
     // If we're interrupting some other anim, stop it (fires stop callback).
@@ -82,7 +186,21 @@ void VertexAnimator::OnUpdate(float deltaTime)
 
         // Sample animation at current timer value, clamping to anim duration.
         float animDuration = mCurrentParams.vertexAnimation->GetDuration(mCurrentParams.framesPerSecond);
-        TakeSample(mCurrentParams.vertexAnimation, Math::Clamp(mAnimationTimer, 0.0f, animDuration));
+        float sampleTime = Math::Clamp(mAnimationTimer, 0.0f, animDuration);
+
+        // If a batch is open, sample along with everything else in the batch.
+        // But if the animation is ending, the stop callback may depend on the final pose, so sample right away in that case.
+        VertexAnimatorSampleBatch* sampleBatch = VertexAnimatorSampleBatch::sOpenBatch;
+        if(sampleBatch != nullptr && mAnimationTimer < animDuration)
+        {
+            sampleBatch->Add(this);
+            mBatchedAnimation = mCurrentParams.vertexAnimation;
+            mBatchedTime = sampleTime;
+        }
+        else
+        {
+            TakeSample(mCurrentParams.vertexAnimation, sampleTime);
+        }
 
         // If at the end of the animation, clear animation.
         // GK3 doesn't really have the concept of a "looping" animation. Looping is handled by higher-level control scripts.
@@ -104,19 +222,36 @@ void VertexAnimator::OnLateUpdate(float deltaTime)
 }
 
 void VertexAnimator::TakeSample(VertexAnimation* animation, int frame)
+{
+    // This sample replaces any sample waiting in the batch.
+    mBatchedAnimation = nullptr;
+    SampleMeshes(animation, frame);
+    UploadSampledMeshes();
+}
+
+void VertexAnimator::TakeSample(VertexAnimation* animation, float time)
+{
+    // This sample replaces any sample waiting in the batch.
+    mBatchedAnimation = nullptr;
+    SampleMeshes(animation, time);
+    UploadSampledMeshes();
+}
+
+void VertexAnimator::SampleMeshes(VertexAnimation* animation, int frame)
 {
     // Iterate through each mesh and sample it in the vertex animation.
     // We need to sample both vertex poses and transform poses to get the right result.
-    const std::vector<Mesh*> meshes = mMeshRenderer->GetMeshes();
+    const std::vector<Mesh*>& meshes = mMeshRenderer->GetMeshes();
     for(size_t i = 0; i < meshes.size(); i++)
     {
+        // Sample directly into each submesh's vertex data. Uploading the new positions is done separately.
         const std::vector<Submesh*>& submeshes = meshes[i]->GetSubmeshes();
         for(size_t j = 0; j < submeshes.size(); j++)
         {
-            VertexAnimationVertexPose sample = animation->SampleVertexPose(frame, i, j);
-            if(sample.frameNumber >= 0)
+            float* positions = submeshes[j]->GetPositions();
+            if(positions != nullptr && animation->SampleVertexPose(frame, i, j, reinterpret_cast<Vector3*>(positions), submeshes[j]->GetVertexCount()))
             {
-                submeshes[j]->SetPositions(reinterpret_cast<float*>(sample.vertexPositions.data()));
+                mSubmeshesToUpload.push_back(submeshes[j]);
             }
         }
 
@@ -134,20 +269,21 @@ void VertexAnimator::TakeSample(VertexAnimation* animation, int frame)
     }
 }
 
-void VertexAnimator::TakeSample(VertexAnimation* animation, float time)
+void VertexAnimator::SampleMeshes(VertexAnimation* animation, float time)
 {
     // Iterate through each mesh and sample it in the vertex animation.
     // We need to sample both vertex poses and transform poses to get the right result.
-    const std::vector<Mesh*> meshes = mMeshRenderer->GetMeshes();
+    const std::vector<Mesh*>& meshes = mMeshRenderer->GetMeshes();
     for(size_t i = 0; i < meshes.size(); i++)
     {
+        // Sample directly into each submesh's vertex data. Uploading the new positions is done separately.
         const std::vector<Submesh*>& submeshes = meshes[i]->GetSubmeshes();
         for(size_t j = 0; j < submeshes.size(); j++)
         {
-            VertexAnimationVertexPose sample = animation->SampleVertexPose(time, mCurrentParams.framesPerSecond, i, j);
-            if(sample.frameNumber >= 0)
+            float* positions = submeshes[j]->GetPositions();
+            if(positions != nullptr && animation->SampleVertexPose(time, mCurrentParams.framesPerSecond, i, j, reinterpret_cast<Vector3*>(positions), submeshes[j]->GetVertexCount()))
             {
-                submeshes[j]->SetPositions(reinterpret_cast<float*>(sample.vertexPositions.data()));
+                mSubmeshesToUpload.push_back(submeshes[j]);
             }
         }
 
@@ -164,3 +300,13 @@ void VertexAnimator::TakeSample(VertexAnimation* animation, float time)
         }
     }
 }
+
+void VertexAnimator::UploadSampledMeshes()
+{
+    // Positions were already written to each submesh's vertex data - just let the submesh know they changed, so they're sent to the GPU.
+    for(Submesh* submesh : mSubmeshesToUpload)
+    {
+        submesh->SetPositions(submesh->GetPositions());
+    }
+    mSubmeshesToUpload.clear();
+}
@@ -7,13 +7,16 @@
 #include "Component.h"
 
 #include <functional>
+#include <vector>
 
 #include "Heading.h"
 #include "Profiler.h" // For Stopwatch
 #include "Vector3.h"
 
 class MeshRenderer;
+class Submesh;
 class VertexAnimation;
+class VertexAnimator;
 
 struct VertexAnimParams
 {
@@ -46,11 +49,44 @@ struct VertexAnimParams
     std::function<void()> stopCallback = nullptr;
 };
 
+// While a sample batch is open, animators that update don't sample right away. Instead, all of them are sampled together when the batch ends.
+// Sampling is spread across worker threads, and only uploading the new vertex data is done on the main thread.
+//
+// The batch is owned by whoever opens it (e.g. the scene manager, around the actor update loop), and only one batch is open at a time.
+// Note: until the batch ends, batched animators' meshes still have the previous frame's pose.
+// So code that reads mesh data during the update (e.g. another actor's update) sees a pose one frame behind.
+// Poses that callers depend on (starting an animation, sampling a specific frame, the final pose of an animation) are still sampled right away.
+class VertexAnimatorSampleBatch
+{
+public:
+    VertexAnimatorSampleBatch();
+    ~VertexAnimatorSampleBatch();
+
+    // Samples all animators added to the batch, and closes the batch.
+    void End();
+
+private:
+    friend class VertexAnimator;
+
+    // The open batch, if any. Animators that update while it's open add themselves to it.
+    static VertexAnimatorSampleBatch* sOpenBatch;
+
+    // Animators waiting to be sampled when the batch ends.
+    std::vector<VertexAnimator*> mAnimators;
+
+    // Where each group of animators sharing the same meshes starts in the animators list.
+    std::vector<size_t> mGroupStarts;
+
+    void Add(VertexAnimator* animator);
+    void Remove(VertexAnimator* animator);
+};
+
 class VertexAnimator : public Component
 {
     TYPEINFO_SUB(VertexAnimator, Component);
 public:
     VertexAnimator(Actor* owner);
+    ~VertexAnimator();
 
     void Start(const VertexAnimParams& params);
     void Stop(VertexAnimation* anim = nullptr);
@@ -67,6 +103,8 @@ protected:
     void OnLateUpdate(float deltaTime) override;
 
 private:
+    friend class VertexAnimatorSampleBatch;
+
     // The mesh renderer that will be animated.
     MeshRenderer* mMeshRenderer = nullptr;
 
@@ -81,6 +119,19 @@ private:
     // To work around that, we'll use this timer to track how long a VertexAnimator is disabled.
     Stopwatch mDisabledTimer;
 
+    // The batch this animator is waiting in (if any), and the sample it should take when the batch ends.
+    // Animation is null if there's no pending sample.
+    VertexAnimatorSampleBatch* mSampleBatch = nullptr;
+    VertexAnimation* mBatchedAnimation = nullptr;
+    float mBatchedTime = 0.0f;
+
+    // Submeshes whose vertex positions were sampled, but haven't been uploaded yet.
+    std::vector<Submesh*> mSubmeshesToUpload;
+
     void TakeSample(VertexAnimation* animation, int frame);
     void TakeSample(VertexAnimation* animation, float time);
+
+    void SampleMeshes(VertexAnimation* animation, int frame);
+    void SampleMeshes(VertexAnimation* animation, float time);
+    void UploadSampledMeshes();
 };
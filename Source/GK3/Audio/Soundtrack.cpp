@@ -37,7 +37,9 @@ int SoundNode::Execute(Soundtrack* soundtrack, SoundtrackNodeResults& outResults
     if(randomCheck > random) { return 0; }
 
     // Definitely want to play the sound, if it exists.
-    Audio* audio = gAssetManager.LoadAsset<Audio>(soundName, soundtrack->GetScope());
+    // The audio manager keeps the audio loaded while it plays, so only a temporary handle is needed here.
+    AssetHandle<Audio> audioHandle = gAssetManager.LoadAssetHandle<Audio>(soundName, soundtrack->GetScope());
+    Audio* audio = audioHandle.Get();
     if(audio == nullptr) { return 0; }
 
     // Create audio play params struct.
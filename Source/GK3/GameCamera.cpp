@@ -4,7 +4,6 @@
 #include "ActionManager.h"
 #include "AudioListener.h"
 #include "Camera.h"
-#include "Collisions.h"
 #include "CursorManager.h"
 #include "Debug.h"
 #include "GK3UI.h"
@@ -65,12 +64,19 @@ GameCamera::~GameCamera()
     gGK3UI.GetVideoPlayer()->AllowSkip(true);
 }
 
+void GameCamera::AddBounds(Model* model)
+{
+    mBoundsModels.push_back(model);
+    mBoundsCollisionDirty = true;
+}
+
 void GameCamera::RemoveBounds(Model* model)
 {
     auto it = std::find(mBoundsModels.begin(), mBoundsModels.end(), model);
     if(it != mBoundsModels.end())
     {
         mBoundsModels.erase(it);
+        mBoundsCollisionDirty = true;
     }
 }
 
@@ -718,6 +724,13 @@ Vector3 GameCamera::ResolveCollisions(const Vector3& startPosition, const Vector
         return startPosition;
     }
 
+    // Make sure bounds collision is up-to-date with the bounds models.
+    if(mBoundsCollisionDirty)
+    {
+        BuildBoundsCollision();
+        mBoundsCollisionDirty = false;
+    }
+
     // Ok, we begin at the start position.
     Vector3 currentPosition = startPosition;
     Vector3 currentMoveOffset = moveOffset;
@@ -732,10 +745,8 @@ Vector3 GameCamera::ResolveCollisions(const Vector3& startPosition, const Vector
 
         // Assume, by default, we haven't collided with anything.
         // "t" represents % of velocity we will move, so a default of 1 means "didn't collide with anything => move full amount".
-        bool collided = false;
         float smallestT = 1.0f;
         Vector3 collisionNormal;
-        Triangle collideTriangle;
 
         // Create sphere at current position.
         Sphere sphere(currentPosition, kCameraColliderRadius);
@@ -774,57 +785,9 @@ Vector3 GameCamera::ResolveCollisions(const Vector3& startPosition, const Vector
         }
         */
 
-        // Check collision against each individual triangle of each bounds model.
-        for(auto& model : mBoundsModels)
-        {
-            auto& meshes = model->GetMeshes();
-            for(auto& mesh : meshes)
-            {
-                // Bounds model is positioned at (0,0,0) in world space (so no need to multiply local to world...it's identity).
-                Matrix4 meshToWorld = mesh->GetMeshToLocalMatrix();
-
-                auto submeshes = mesh->GetSubmeshes();
-                for(auto& submesh : submeshes)
-                {
-                    int triangleCount = submesh->GetTriangleCount();
-                    for(int i = 0; i < triangleCount; ++i)
-                    {
-                        Vector3 p0, p1, p2;
-                        if(submesh->GetTriangle(i, p0, p1, p2))
-                        {
-                            // Transform triangle to world space.
-                            p0 = meshToWorld.TransformPoint(p0);
-                            p1 = meshToWorld.TransformPoint(p1);
-                            p2 = meshToWorld.TransformPoint(p2);
-                            Triangle triangle(p0, p1, p2);
-
-                            // Check collision and record the t/normal if it's smaller than any previously discovered one.
-                            float sphereT = 0.0f;
-                            Vector3 normal;
-                            if(Collide::SphereTriangle(sphere, triangle, currentMoveOffset, sphereT, normal))
-                            {
-                                // If a triangle reports a negative-t collision, it means we are already intersecting it.
-                                // We better be actively intersecting in this case.
-                                //TODO: Probably Collide::SphereTriangle should handle this internally?
-                                Vector3 intersectPoint;
-                                if(sphereT < 0.0f && !Intersect::TestSphereTriangle(sphere, triangle, intersectPoint))
-                                {
-                                    continue;
-                                }
-
-                                if(sphereT < smallestT)
-                                {
-                                    collided = true;
-                                    smallestT = sphereT;
-                                    collisionNormal = normal;
-                                    collideTriangle = triangle;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        // Check collision against the bounds triangles near our path.
+        int collideTriangleIndex = mBoundsCollision.SphereCast(sphere, currentMoveOffset, smallestT, collisionNormal);
+        bool collided = collideTriangleIndex >= 0;
 
         // Move sphere.
         Vector3 moveFrom = currentPosition;
@@ -838,6 +801,7 @@ Vector3 GameCamera::ResolveCollisions(const Vector3& startPosition, const Vector
             break;
         }
 
+        //const Triangle& collideTriangle = mBoundsCollision.GetTriangle(collideTriangleIndex);
         //Debug::DrawTriangle(collideTriangle, Color32::Yellow);
         //Debug::DrawLine(collideTriangle.GetCenter(), collideTriangle.GetCenter() + collideTriangle.GetNormal() * 5.0f, Color32::Yellow);
 
@@ -865,3 +829,30 @@ Vector3 GameCamera::ResolveCollisions(const Vector3& startPosition, const Vector
     // Return whatever our final position was!
     return currentPosition;
 }
+
+void GameCamera::BuildBoundsCollision()
+{
+    // Transform every triangle of every bounds model to world space once, up front.
+    mBoundsCollision.Clear();
+    for(Model* model : mBoundsModels)
+    {
+        for(Mesh* mesh : model->GetMeshes())
+        {
+            // Bounds model is positioned at (0,0,0) in world space (so no need to multiply local to world...it's identity).
+            const Matrix4& meshToWorld = mesh->GetMeshToLocalMatrix();
+            for(Submesh* submesh : mesh->GetSubmeshes())
+            {
+                int triangleCount = submesh->GetTriangleCount();
+                for(int i = 0; i < triangleCount; ++i)
+                {
+                    Vector3 p0, p1, p2;
+                    if(submesh->GetTriangle(i, p0, p1, p2))
+                    {
+                        mBoundsCollision.AddTriangle(meshToWorld.TransformPoint(p0), meshToWorld.TransformPoint(p1), meshToWorld.TransformPoint(p2));
+                    }
+                }
+            }
+        }
+    }
+    mBoundsCollision.Build();
+}
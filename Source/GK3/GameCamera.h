@@ -12,6 +12,7 @@
 #include <functional>
 #include <vector>
 
+#include "CollisionMesh.h"
 #include "Ray.h"
 
 class Camera;
@@ -32,7 +33,7 @@ public:
     GameCamera();
     ~GameCamera();
 
-    void AddBounds(Model* model) { mBoundsModels.push_back(model); }
+    void AddBounds(Model* model);
     void RemoveBounds(Model* model);
     void SetBoundsEnabled(bool enabled) { mBoundsEnabled = enabled; }
 
@@ -147,6 +148,11 @@ private:
     // A model whose triangles are used as collision for the camera.
     std::vector<Model*> mBoundsModels;
 
+    // World space triangles of all bounds models, for fast collision checks.
+    // Rebuilt when bounds models are added or removed (bounds models never move).
+    CollisionMesh mBoundsCollision;
+    bool mBoundsCollisionDirty = false;
+
     // If true, camera bounds are turned on. If false, they are disabled.
     bool mBoundsEnabled = true;
 
@@ -189,4 +195,5 @@ private:
     GKObject* RaycastIntoScene(const Ray& ray, bool interactiveOnly);
 
     Vector3 ResolveCollisions(const Vector3& startPosition, const Vector3& moveOffset);
+    void BuildBoundsCollision();
 };
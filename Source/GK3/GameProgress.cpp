@@ -12,11 +12,57 @@
 #include "Sidney.h"
 #include "StatusOverlay.h"
 #include "StringUtil.h"
+#include "SymbolTable.h"
 #include "TextAsset.h"
 #include "VideoHelper.h"
 
 GameProgress gGameProgress;
 
+namespace
+{
+    // Gets a value from an array indexed by symbol. Values past the end of the array are zero.
+    int GetValue(const std::vector<int>& values, int symbol)
+    {
+        return symbol >= 0 && symbol < static_cast<int>(values.size()) ? values[symbol] : 0;
+    }
+
+    // Gets a reference to a value in an array indexed by symbol, growing the array if needed.
+    int& GetValueRef(std::vector<int>& values, int symbol)
+    {
+        if(symbol >= static_cast<int>(values.size()))
+        {
+            values.resize(symbol + 1, 0);
+        }
+        return values[symbol];
+    }
+
+    // Transfers an array of values indexed by symbol, as a map of names to values.
+    void XferValues(PersistState& ps, const char* name, std::vector<int>& values)
+    {
+        std::string_map_ci<int> namedValues;
+        if(ps.IsSaving())
+        {
+            for(int i = 0; i < static_cast<int>(values.size()); ++i)
+            {
+                if(values[i] != 0)
+                {
+                    namedValues[gSymbols.GetName(i)] = values[i];
+                }
+            }
+        }
+        ps.Xfer(name, namedValues);
+
+        if(ps.IsLoading())
+        {
+            values.clear();
+            for(auto& entry : namedValues)
+            {
+                GetValueRef(values, gSymbols.Intern(entry.first)) = entry.second;
+            }
+        }
+    }
+}
+
 void GameProgress::Init()
 {
     // Parse valid score events (and score amount) into map of score events.
@@ -164,114 +210,168 @@ void GameProgress::StartTimeblock(const Timeblock& timeblock, bool loadingSave,
 
 int GameProgress::GetGameVariable(const std::string& varName) const
 {
-    auto it = mGameVariables.find(varName);
-    if(it != mGameVariables.end())
-    {
-        return it->second;
-    }
-    return 0;
+    return GetGameVariable(gSymbols.Find(varName));
+}
+
+int GameProgress::GetGameVariable(int var) const
+{
+    return GetValue(mGameVariables, var);
 }
 
 void GameProgress::SetGameVariable(const std::string& varName, int value)
 {
-    mGameVariables[varName] = value;
+    SetGameVariable(gSymbols.Intern(varName), value);
+}
+
+void GameProgress::SetGameVariable(int var, int value)
+{
+    if(var < 0) { return; }
+    GetValueRef(mGameVariables, var) = value;
 }
 
 void GameProgress::IncGameVariable(const std::string& varName)
 {
-    ++mGameVariables[varName];
+    IncGameVariable(gSymbols.Intern(varName));
+}
+
+void GameProgress::IncGameVariable(int var)
+{
+    if(var < 0) { return; }
+    ++GetValueRef(mGameVariables, var);
 }
 
 int GameProgress::GetChatCount(const std::string& noun) const
 {
-    auto it = mChatCounts.find(noun);
-    if(it != mChatCounts.end())
-    {
-        return it->second;
-    }
-    return 0;
+    return GetChatCount(gSymbols.Find(noun));
+}
+
+int GameProgress::GetChatCount(int noun) const
+{
+    return GetValue(mChatCounts, noun);
 }
 
 void GameProgress::SetChatCount(const std::string& noun, int count)
 {
-    mChatCounts[noun] = count;
+    SetChatCount(gSymbols.Intern(noun), count);
+}
+
+void GameProgress::SetChatCount(int noun, int count)
+{
+    if(noun < 0) { return; }
+    GetValueRef(mChatCounts, noun) = count;
 }
 
 void GameProgress::IncChatCount(const std::string& noun)
 {
-    ++mChatCounts[noun];
+    IncChatCount(gSymbols.Intern(noun));
+}
+
+void GameProgress::IncChatCount(int noun)
+{
+    if(noun < 0) { return; }
+    ++GetValueRef(mChatCounts, noun);
 }
 
 int GameProgress::GetTopicCount(const std::string& noun, const std::string& topic) const
 {
+    // Look up by name, not symbol: a count loaded from an older save file may use names that were never interned.
     return GetTopicCount(Scene::GetEgoName(), noun, topic);
 }
 
 int GameProgress::GetTopicCount(const std::string& actor, const std::string& noun, const std::string& topic) const
 {
-    // Find and return, or return default.
-    auto it = mTopicCounts.find(actor + noun + topic);
-    if(it != mTopicCounts.end())
-    {
-        return it->second;
-    }
-    return 0;
+    return mTopicCounts.Get(actor, noun, topic);
+}
+
+int GameProgress::GetTopicCount(int noun, int topic) const
+{
+    return GetTopicCount(Scene::GetEgoSymbol(), noun, topic);
+}
+
+int GameProgress::GetTopicCount(int actor, int noun, int topic) const
+{
+    return mTopicCounts.Get(actor, noun, topic);
 }
 
 void GameProgress::SetTopicCount(const std::string& noun, const std::string& topic, int count)
 {
-    SetTopicCount(Scene::GetEgoName(), noun, topic, count);
+    SetTopicCount(Scene::GetEgoSymbol(), gSymbols.Intern(noun), gSymbols.Intern(topic), count);
 }
 
 void GameProgress::SetTopicCount(const std::string& actor, const std::string& noun, const std::string& topic, int count)
 {
-    mTopicCounts[actor + noun + topic] = count;
+    SetTopicCount(gSymbols.Intern(actor), gSymbols.Intern(noun), gSymbols.Intern(topic), count);
+}
+
+void GameProgress::SetTopicCount(int actor, int noun, int topic, int count)
+{
+    mTopicCounts.Set(actor, noun, topic, count);
 }
 
 void GameProgress::IncTopicCount(const std::string& noun, const std::string& topic)
 {
-    IncTopicCount(Scene::GetEgoName(), noun, topic);
+    IncTopicCount(Scene::GetEgoSymbol(), gSymbols.Intern(noun), gSymbols.Intern(topic));
 }
 
 void GameProgress::IncTopicCount(const std::string& actor, const std::string& noun, const std::string& topic)
 {
-    ++mTopicCounts[actor + noun + topic];
+    IncTopicCount(gSymbols.Intern(actor), gSymbols.Intern(noun), gSymbols.Intern(topic));
+}
+
+void GameProgress::IncTopicCount(int actor, int noun, int topic)
+{
+    mTopicCounts.Increment(actor, noun, topic);
 }
 
 int GameProgress::GetNounVerbCount(const std::string& noun, const std::string& verb) const
 {
+    // Same as topic counts - look up by name.
     return GetNounVerbCount(Scene::GetEgoName(), noun, verb);
 }
 
 int GameProgress::GetNounVerbCount(const std::string& actor, const std::string& noun, const std::string& verb) const
 {
-    // Find and return, or return default.
-    auto it = mNounVerbCounts.find(actor + noun + verb);
-    if(it != mNounVerbCounts.end())
-    {
-        return it->second;
-    }
-    return 0;
+    return mNounVerbCounts.Get(actor, noun, verb);
+}
+
+int GameProgress::GetNounVerbCount(int noun, int verb) const
+{
+    return GetNounVerbCount(Scene::GetEgoSymbol(), noun, verb);
+}
+
+int GameProgress::GetNounVerbCount(int actor, int noun, int verb) const
+{
+    return mNounVerbCounts.Get(actor, noun, verb);
 }
 
 void GameProgress::SetNounVerbCount(const std::string& noun, const std::string& verb, int count)
 {
-    SetNounVerbCount(Scene::GetEgoName(), noun, verb, count);
+    SetNounVerbCount(Scene::GetEgoSymbol(), gSymbols.Intern(noun), gSymbols.Intern(verb), count);
 }
 
 void GameProgress::SetNounVerbCount(const std::string& actor, const std::string& noun, const std::string& verb, int count)
 {
-    mNounVerbCounts[actor + noun + verb] = count;
+    SetNounVerbCount(gSymbols.Intern(actor), gSymbols.Intern(noun), gSymbols.Intern(verb), count);
+}
+
+void GameProgress::SetNounVerbCount(int actor, int noun, int verb, int count)
+{
+    mNounVerbCounts.Set(actor, noun, verb, count);
 }
 
 void GameProgress::IncNounVerbCount(const std::string& noun, const std::string& verb)
 {
-    IncNounVerbCount(Scene::GetEgoName(), noun, verb);
+    IncNounVerbCount(Scene::GetEgoSymbol(), gSymbols.Intern(noun), gSymbols.Intern(verb));
 }
 
 void GameProgress::IncNounVerbCount(const std::string& actor, const std::string& noun, const std::string& verb)
 {
-    ++mNounVerbCounts[actor + noun + verb];
+    IncNounVerbCount(gSymbols.Intern(actor), gSymbols.Intern(noun), gSymbols.Intern(verb));
+}
+
+void GameProgress::IncNounVerbCount(int actor, int noun, int verb)
+{
+    mNounVerbCounts.Increment(actor, noun, verb);
 }
 
 void GameProgress::OnPersist(PersistState& ps)
@@ -286,12 +386,12 @@ void GameProgress::OnPersist(PersistState& ps)
 
     ps.Xfer(PERSIST_VAR(mChangingTimeblock));
 
-    // Because I'm grabbing the flags from inside the FlagSet, auto-generating the variable name doesn't look right...
-    // Maybe should just put OnPersist in FlagSet?
-    ps.Xfer("mGameFlags", mGameFlags.GetFlags());
+    // Flags, variables, and counts are stored by symbol in memory, but by name in save files.
+    // Symbols can differ between runs of the game (they depend on the order names are interned in).
+    mGameFlags.OnPersist(ps);
 
-    ps.Xfer(PERSIST_VAR(mChatCounts));
-    ps.Xfer(PERSIST_VAR(mTopicCounts));
-    ps.Xfer(PERSIST_VAR(mNounVerbCounts));
-    ps.Xfer(PERSIST_VAR(mGameVariables));
+    XferValues(ps, "mChatCounts", mChatCounts);
+    mTopicCounts.OnPersist(ps);
+    mNounVerbCounts.OnPersist(ps);
+    XferValues(ps, "mGameVariables", mGameVariables);
 }
\ No newline at end of file
@@ -8,7 +8,9 @@
 #pragma once
 #include <functional>
 #include <string>
+#include <vector>
 
+#include "CountTable.h"
 #include "FlagSet.h"
 #include "PersistState.h"
 #include "StringUtil.h"
@@ -39,36 +41,54 @@ public:
     bool IsChangingTimeblock() const { return mChangingTimeblock; }
 
     // Flags
+    // Names are interned as symbols (see SymbolTable.h). Callers that use the same names often can look up symbols once, and use the symbol versions.
     bool GetFlag(const std::string& flagName) const { return mGameFlags.Get(flagName); }
+    bool GetFlag(int flag) const { return mGameFlags.Get(flag); }
     void SetFlag(const std::string& flagName) { mGameFlags.Set(flagName); }
+    void SetFlag(int flag) { mGameFlags.Set(flag); }
     void ClearFlag(const std::string& flagName) { mGameFlags.Clear(flagName); }
+    void ClearFlag(int flag) { mGameFlags.Clear(flag); }
     void DumpFlags() const { mGameFlags.Dump("game"); }
 
     // Game Variables
     int GetGameVariable(const std::string& varName) const;
+    int GetGameVariable(int var) const;
     void SetGameVariable(const std::string& varName, int value);
+    void SetGameVariable(int var, int value);
     void IncGameVariable(const std::string& varName);
+    void IncGameVariable(int var);
 
     // Chat Counts
     int GetChatCount(const std::string& noun) const;
+    int GetChatCount(int noun) const;
     void SetChatCount(const std::string&, int count);
+    void SetChatCount(int noun, int count);
     void IncChatCount(const std::string& noun);
+    void IncChatCount(int noun);
 
     // Topic Counts
     int GetTopicCount(const std::string& noun, const std::string& topic) const;
     int GetTopicCount(const std::string& actor, const std::string& noun, const std::string& topic) const;
+    int GetTopicCount(int noun, int topic) const;
+    int GetTopicCount(int actor, int noun, int topic) const;
     void SetTopicCount(const std::string& noun, const std::string& topic, int count);
     void SetTopicCount(const std::string& actor, const std::string& noun, const std::string& topic, int count);
+    void SetTopicCount(int actor, int noun, int topic, int count);
     void IncTopicCount(const std::string& noun, const std::string& topic);
     void IncTopicCount(const std::string& actor, const std::string& noun, const std::string& topic);
+    void IncTopicCount(int actor, int noun, int topic);
 
     // Noun/Verb Counts
     int GetNounVerbCount(const std::string& noun, const std::string& verb) const;
     int GetNounVerbCount(const std::string& actor, const std::string& noun, const std::string& verb) const;
+    int GetNounVerbCount(int noun, int verb) const;
+    int GetNounVerbCount(int actor, int noun, int verb) const;
     void SetNounVerbCount(const std::string& noun, const std::string& verb, int count);
     void SetNounVerbCount(const std::string& actor, const std::string& noun, const std::string& verb, int count);
+    void SetNounVerbCount(int actor, int noun, int verb, int count);
     void IncNounVerbCount(const std::string& noun, const std::string& verb);
     void IncNounVerbCount(const std::string& actor, const std::string& noun, const std::string& verb);
+    void IncNounVerbCount(int actor, int noun, int verb);
 
     void OnPersist(PersistState& ps);
 
@@ -93,20 +113,17 @@ private:
     // General-use true/false flags for game logic.
     FlagSet mGameFlags;
 
-    // Tracks the number of times the player has chatted with a noun.
-    std::string_map_ci<int> mChatCounts;
+    // Tracks the number of times the player has chatted with a noun, indexed by noun symbol.
+    std::vector<int> mChatCounts;
 
-    // Maps noun/topic combos to a count value.
     // Tracks the number of times we've talked to a noun about a topic.
-    std::string_map_ci<int> mTopicCounts;
+    CountTable mTopicCounts;
 
-    // Maps noun/verb to a count value.
     // Tracks the number of times we've triggered a verb on a noun.
-    std::string_map_ci<int> mNounVerbCounts;
+    CountTable mNounVerbCounts;
 
-    // Maps a variable name to an integer value.
-    // For general game logic variables.
-    std::string_map_ci<int> mGameVariables;
+    // General game logic variables, indexed by variable name symbol.
+    std::vector<int> mGameVariables;
 };
 
 extern GameProgress gGameProgress;
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "StringUtil.h"
 #include "TextAsset.h"
 #include "Texture.h"
+#include "UICanvas.h"
 
 InventoryManager gInventoryManager;
 
@@ -225,15 +226,18 @@ Texture* InventoryManager::GetInventoryItemIconTexture(const std::string& itemNa
     }
 
     // Return cached texture if already loaded.
-    if(it->second.iconTexture != nullptr) { return it->second.iconTexture; }
+    if(it->second.iconTexture.IsValid()) { return it->second.iconTexture.Get(); }
 
     // Load the texture fresh.
-    it->second.iconTexture = gAssetManager.LoadAsset<Texture>(it->second.textureNamePrefix + "3.BMP");
-    if(it->second.iconTexture == nullptr)
+    it->second.iconTexture = gAssetManager.LoadAssetHandle<Texture>(it->second.textureNamePrefix + "3.BMP");
+    if(!it->second.iconTexture.IsValid())
     {
-        it->second.iconTexture = gAssetManager.LoadAsset<Texture>(it->second.textureNamePrefix + "_3.BMP");
+        it->second.iconTexture = gAssetManager.LoadAssetHandle<Texture>(it->second.textureNamePrefix + "_3.BMP");
     }
-    return it->second.iconTexture;
+
+    // Item textures are small and stay loaded, so they're good candidates for the UI atlas.
+    UICanvas::AddToAtlas(it->second.iconTexture);
+    return it->second.iconTexture.Get();
 }
 
 Texture* InventoryManager::GetInventoryItemListTexture(const std::string& itemName)
@@ -246,33 +250,38 @@ Texture* InventoryManager::GetInventoryItemListTexture(const std::string& itemNa
     }
 
     // Return cached texture if already loaded.
-    if(it->second.listTexture != nullptr) { return it->second.listTexture; }
+    if(it->second.listTexture.IsValid()) { return it->second.listTexture.Get(); }
 
     // Otherwise, load the texture!
     // List texture has a "9" suffix. Also, optionally, an alpha texture (since these show against a see-through background).
-    it->second.listTexture = gAssetManager.LoadAsset<Texture>(it->second.textureNamePrefix + "9.BMP");
-    if(it->second.listTexture == nullptr)
+    it->second.listTexture = gAssetManager.LoadAssetHandle<Texture>(it->second.textureNamePrefix + "9.BMP");
+    if(!it->second.listTexture.IsValid())
     {
-        it->second.listTexture = gAssetManager.LoadAsset<Texture>(it->second.textureNamePrefix + "_9.BMP");
+        it->second.listTexture = gAssetManager.LoadAssetHandle<Texture>(it->second.textureNamePrefix + "_9.BMP");
     }
 
     // If we have a list texture, attempt to find and apply alpha channel.
-    if(it->second.listTexture != nullptr)
+    // The alpha texture is only needed for this, so it's fine for it to be evicted afterwards.
+    if(it->second.listTexture.IsValid())
     {
-        Texture* listTextureAlpha = gAssetManager.LoadAsset<Texture>(it->second.textureNamePrefix + "9_OP.BMP");
-        if(listTextureAlpha == nullptr)
+        AssetHandle<Texture> listTextureAlpha = gAssetManager.LoadAssetHandle<Texture>(it->second.textureNamePrefix + "9_OP.BMP");
+        if(!listTextureAlpha.IsValid())
         {
-            listTextureAlpha = gAssetManager.LoadAsset<Texture>(it->second.textureNamePrefix + "_9_OP.BMP");
+            listTextureAlpha = gAssetManager.LoadAssetHandle<Texture>(it->second.textureNamePrefix + "_9_OP.BMP");
         }
-        if(listTextureAlpha != nullptr)
+        if(listTextureAlpha.IsValid())
         {
-            it->second.listTexture->ApplyAlphaChannel(*listTextureAlpha);
+            it->second.listTexture.Get()->ApplyAlphaChannel(*listTextureAlpha.Get());
         }
     }
-    return it->second.listTexture;
+
+    // The inventory screen shows many of these at once, so packing them in the UI atlas lets them draw together.
+    // This must come after applying the alpha channel, since the atlas copies the texture's pixels.
+    UICanvas::AddToAtlas(it->second.listTexture);
+    return it->second.listTexture.Get();
 }
 
-Texture* InventoryManager::GetInventoryItemCloseupTexture(const std::string& itemName)
+AssetHandle<Texture> InventoryManager::GetInventoryItemCloseupTexture(const std::string& itemName)
 {
     // Find the item. If doesn't exist, return null.
     auto it = mInventoryItems.find(itemName);
@@ -281,21 +290,19 @@ Texture* InventoryManager::GetInventoryItemCloseupTexture(const std::string& ite
         it = mInventoryItems.find("UNDEFINED");
     }
 
-    // Return cached texture if already loaded.
-    if(it->second.closeupTexture != nullptr) { return it->second.closeupTexture; }
-
     // Closeup texture has suffix "6" or "6_ALPHA".
     // One asset (MOSELYPRINT_6_ALPHA.BMP) did not follow the naming convention - yuck.
-    it->second.closeupTexture = gAssetManager.LoadAsset<Texture>(it->second.textureNamePrefix + "6.BMP");
-    if(it->second.closeupTexture == nullptr)
+    // If the closeup is still in the texture cache, this is just a cache hit.
+    AssetHandle<Texture> closeupTexture = gAssetManager.LoadAssetHandle<Texture>(it->second.textureNamePrefix + "6.BMP");
+    if(!closeupTexture.IsValid())
     {
-        it->second.closeupTexture = gAssetManager.LoadAsset<Texture>(it->second.textureNamePrefix + "6_ALPHA.BMP");
-        if(it->second.closeupTexture == nullptr)
+        closeupTexture = gAssetManager.LoadAssetHandle<Texture>(it->second.textureNamePrefix + "6_ALPHA.BMP");
+        if(!closeupTexture.IsValid())
         {
-            it->second.closeupTexture = gAssetManager.LoadAsset<Texture>(it->second.textureNamePrefix + "_6_ALPHA.BMP");
+            closeupTexture = gAssetManager.LoadAssetHandle<Texture>(it->second.textureNamePrefix + "_6_ALPHA.BMP");
         }
     }
-    return it->second.closeupTexture;
+    return closeupTexture;
 }
 
 void InventoryManager::OnPersist(PersistState& ps)
@@ -14,6 +14,7 @@
 #include <set>
 #include <string>
 
+#include "AssetCache.h"
 #include "PersistState.h"
 #include "StringUtil.h"
 
@@ -57,7 +58,9 @@ public:
 
     Texture* GetInventoryItemIconTexture(const std::string& itemName);
     Texture* GetInventoryItemListTexture(const std::string& itemName);
-    Texture* GetInventoryItemCloseupTexture(const std::string& itemName);
+
+    // Closeups are large and only shown one at a time, so they aren't kept loaded. Hold on to the handle while the closeup is shown.
+    AssetHandle<Texture> GetInventoryItemCloseupTexture(const std::string& itemName);
 
     void OnPersist(PersistState& ps);
 
@@ -71,15 +74,14 @@ private:
 
         // Icon texture: appears on the option bar as the active inventory item.
         // Smallest image, not a lot of detail.
-        Texture* iconTexture = nullptr;
+        AssetHandle<Texture> iconTexture;
 
         // List texture: appears on the inventory screen, in the list.
         // Medium-size image, with alpha layer usually.
-        Texture* listTexture = nullptr;
+        // Once loaded, this handle is kept, so the alpha layer applied to the texture is never lost to eviction.
+        AssetHandle<Texture> listTexture;
 
-        // Closeup texture: appears in the inventory item closeup screen.
-        // Largest image, most detail.
-        Texture* closeupTexture = nullptr;
+        // The closeup texture (largest image, most detail) isn't kept here - see GetInventoryItemCloseupTexture.
 
         InventoryItemTextures() = default;
         InventoryItemTextures(const std::string& prefix) : textureNamePrefix(prefix) { }
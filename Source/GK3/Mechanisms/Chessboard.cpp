@@ -111,7 +111,7 @@ void Chessboard::Landed()
     if(mLandedCounts[row][col] == 1 && SetSwordGlow(row, col, false))
     {
         // Play "sword off" SFX.
-        gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("TE1SWORDOFF.WAV", AssetScope::Scene));
+        gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("TE1SWORDOFF.WAV", AssetScope::Scene).Get());
 
         // Increment swords landed on.
         // Once we land on 16, we've got all the swords, which may finish the puzzle.
@@ -443,7 +443,7 @@ void Chessboard::OpenTrapdoor(int row, int col)
 {
     // Disable the graphic and play a sound effect.
     SetTileVisible(row, col, false);
-    gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("TE1TRAPDOOROPEN.WAV", AssetScope::Scene));
+    gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("TE1TRAPDOOROPEN.WAV", AssetScope::Scene).Get());
 }
 
 const std::string& Chessboard::GetTileModelName(int row, int col)
@@ -0,0 +1,47 @@
+//
+// Clark Kromenaker
+//
+// The ambient light color last calculated for an actor.
+// Calculating ambient color isn't free, so it's only recalculated when the actor moves a bit, or the BSP's ambient lights change.
+//
+#pragma once
+#include <cstdint>
+
+#include "Color32.h"
+#include "Vector3.h"
+
+class BSP;
+
+class ActorAmbientLight
+{
+public:
+    // If an actor moves less than this, the change in ambient color is too small to notice - the last calculated color is used.
+    static constexpr float kRecalculateDistance = 1.0f;
+
+    // Gets the ambient color for an actor at a position, lit by a BSP's ambient lights (with the given ambient light version).
+    // "calculateColor" is only called if there's no color yet, the actor moved far enough, or the BSP or its ambient lights changed.
+    template<typename F>
+    const Color32& GetColor(const BSP* bsp, uint32_t ambientLightVersion, const Vector3& position, const F& calculateColor)
+    {
+        if(!mCalculated || mBSP != bsp || mAmbientLightVersion != ambientLightVersion ||
+           (position - mPosition).GetLengthSq() > kRecalculateDistance * kRecalculateDistance)
+        {
+            mCalculated = true;
+            mBSP = bsp;
+            mAmbientLightVersion = ambientLightVersion;
+            mPosition = position;
+            mColor = calculateColor(position);
+        }
+        return mColor;
+    }
+
+private:
+    // The inputs the color was last calculated for.
+    bool mCalculated = false;
+    const BSP* mBSP = nullptr;
+    uint32_t mAmbientLightVersion = 0;
+    Vector3 mPosition;
+
+    // The last calculated color.
+    Color32 mColor;
+};
@@ -36,16 +36,28 @@
 #include "SoundtrackPlayer.h"
 #include "StatusOverlay.h"
 #include "StringUtil.h"
+#include "SymbolTable.h"
 #include "Walker.h"
 #include "WalkerBoundary.h"
 
 std::string Scene::mEgoName;
+int Scene::mEgoSymbol = kInvalidSymbol;
 
 /*static*/ const char* Scene::GetEgoName()
 {
     return mEgoName.c_str();
 }
 
+/*static*/ int Scene::GetEgoSymbol()
+{
+    // Before any Ego has been set, the (empty) name still needs a symbol, so counts work the same as with the name.
+    if(mEgoSymbol == kInvalidSymbol)
+    {
+        mEgoSymbol = gSymbols.Intern(mEgoName);
+    }
+    return mEgoSymbol;
+}
+
 /*static*/ Animator* Scene::GetGlobalAnimator()
 {
     // Create and return a global animator that persists between scenes.
@@ -131,6 +143,7 @@ void Scene::Load()
     if(mEgoSceneActor != nullptr)
     {
         mEgoName = mEgoSceneActor->noun;
+        mEgoSymbol = gSymbols.Intern(mEgoName);
     }
 
     // Based on location, timeblock, and game progress, resolve what data we will load into the current scene.
@@ -1362,11 +1375,17 @@ GKActor* Scene::CreateSceneActor(const SceneActor* sceneActor)
 void Scene::ApplyAmbientLightColorToActors()
 {
     // Apply ambient light to actors.
-    for(GKActor* actor : mActors)
+    BSP* bsp = GetBSP();
+    mActorAmbientLights.resize(mActors.size());
+    for(size_t i = 0; i < mActors.size(); ++i)
     {
         // Use the "model position" rather than the "actor position" for more accurate lighting.
         // For example, in RC1, Buthane's actor position is way outside the map (dark color), but her model is near the van.
-        Color32 ambientColor = GetBSP()->CalculateAmbientLightColor(actor->GetFloorPosition());
+        // The color is only recalculated if the actor moved far enough, or if the lights have changed since the last calculation.
+        GKActor* actor = mActors[i];
+        const Color32& ambientColor = mActorAmbientLights[i].GetColor(bsp, bsp->GetAmbientLightVersion(), actor->GetFloorPosition(), [bsp](const Vector3& position) {
+            return bsp->CalculateAmbientLightColor(position);
+        });
         for(Material& material : actor->GetMeshRenderer()->GetMaterials())
         {
             material.SetColor("uAmbientColor", ambientColor);
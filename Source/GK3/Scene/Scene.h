@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 
+#include "ActorAmbientLight.h"
 #include "Collisions.h"
 #include "SceneConstruction.h"
 #include "SceneData.h"
@@ -48,6 +49,7 @@ class Scene
 {
 public:
     static const char* GetEgoName();
+    static int GetEgoSymbol();
 
     static Animator* GetGlobalAnimator();
     static Animator* GetActiveAnimator();
@@ -156,6 +158,9 @@ private:
     // All the GKActors spawned into the scene - basically all human or animal objects.
     std::vector<GKActor*> mActors;
 
+    // The ambient light color last calculated for each actor (same order as the actors list).
+    std::vector<ActorAmbientLight> mActorAmbientLights;
+
     // All the GKProps spawned into the scene - usually simple objects that can animate or move.
     std::vector<GKProp*> mProps;
 
@@ -177,6 +182,9 @@ private:
     // This is static so we can query who was the last Ego even if a scene is not loaded (e.g. on the Map).
     static std::string mEgoName;
 
+    // The Ego name as a symbol, for fast noun/verb and topic count lookups.
+    static int mEgoSymbol;
+
     // The most recently "active" object.
     // In other words, the last object the action bar was shown for.
     GKObject* mActiveObject = nullptr;
@@ -9,6 +9,15 @@ void SceneGeometryData::Load(const std::string& sceneAssetName)
     // Load the desired scene asset - chosen based on settings block.
     mSceneAsset = gAssetManager.LoadAsset<SceneAsset>(sceneAssetName, AssetScope::Scene);
 
+    // The BSP and its lightmap don't depend on one another, so load them in parallel.
+    AssetLoadBatch batch;
+    if(mSceneAsset != nullptr)
+    {
+        batch.Add<BSP>(mSceneAsset->GetBSPName(), AssetScope::Scene);
+    }
+    batch.Add<BSPLightmap>(sceneAssetName, AssetScope::Scene);
+    gAssetManager.LoadAssets(batch);
+
     // Load the BSP data, which is specified by the scene model.
     // If this is null, the game will still work...but there's no BSP geometry!
     if(mSceneAsset != nullptr)
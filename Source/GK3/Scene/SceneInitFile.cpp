@@ -569,6 +569,11 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         }
     }
 
+    // Actor and prop models are the heaviest assets a SIF refers to.
+    // While reading actors and models, just note which models are needed. They're all loaded in parallel afterwards.
+    AssetLoadBatch modelBatch;
+    std::vector<std::string> actorModelNames;
+
     // Read in actors.
     std::vector<IniSection> actorSections = parser.GetSections("ACTORS");
     for(auto& section : actorSections)
@@ -588,12 +593,14 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         {
             actorBlock.items.emplace_back();
             SceneActor& actor = actorBlock.items.back();
+            actorModelNames.emplace_back();
 
             for(auto& keyValue : line.entries)
             {
                 if(StringUtil::EqualsIgnoreCase(keyValue.key, "model"))
                 {
-                    actor.model = gAssetManager.LoadAsset<Model>(keyValue.value, GetScope());
+                    actorModelNames.back() = keyValue.value;
+                    modelBatch.Add<Model>(keyValue.value, GetScope());
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "noun"))
                 {
@@ -715,8 +722,35 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
                 }
             }
 
-            // After parsing all the data, if this is a prop, load the model.
+            // After parsing all the data, if this is a prop, we need the model.
             // For non-props, we don't load a model - the model is baked into the BSP.
+            if(!model.name.empty() &&
+               (model.type == SceneModel::Type::Prop ||
+                model.type == SceneModel::Type::GasProp))
+            {
+                modelBatch.Add<Model>(model.name, GetScope());
+            }
+        }
+    }
+
+    // Load all the models at once. After that, getting each model is just a cache hit.
+    gAssetManager.LoadAssets(modelBatch);
+    size_t actorIndex = 0;
+    for(auto& actorBlock : mActors)
+    {
+        for(auto& actor : actorBlock.items)
+        {
+            const std::string& modelName = actorModelNames[actorIndex++];
+            if(!modelName.empty())
+            {
+                actor.model = gAssetManager.LoadAsset<Model>(modelName, GetScope());
+            }
+        }
+    }
+    for(auto& modelBlock : mModels)
+    {
+        for(auto& model : modelBlock.items)
+        {
             if(!model.name.empty() &&
                (model.type == SceneModel::Type::Prop ||
                 model.type == SceneModel::Type::GasProp))
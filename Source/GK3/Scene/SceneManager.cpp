@@ -4,6 +4,7 @@
 #include "AssetManager.h"
 #include "Loader.h"
 #include "Profiler.h"
+#include "VertexAnimator.h"
 
 SceneManager gSceneManager;
 
@@ -32,11 +33,15 @@ void SceneManager::Update(float deltaTime)
 
     // Update actors, but *don't* update actors that are added when updating other actors!
     // To guard against this, get size first and only update to that point.
+    // Vertex animations are sampled all together after the update, so they can be sampled in parallel.
+    // During the update, meshes with a batched animation still have last frame's pose (see VertexAnimatorSampleBatch).
     size_t size = mActors.size();
+    VertexAnimatorSampleBatch sampleBatch;
     for(size_t i = 0; i < size; ++i)
     {
         mActors[i]->Update(deltaTime);
     }
+    sampleBatch.End();
 
     // Do a late update step on all actors.
     // Why is this needed? In some cases, an Actor must update after some other actor has updated.
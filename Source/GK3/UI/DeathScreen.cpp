@@ -80,8 +80,9 @@ void DeathScreen::Show()
     RefreshUIScaling();
 
     // Play death stinger sound effect.
+    AssetHandle<Audio> audio = gAssetManager.LoadAssetHandle<Audio>("TEMPLEDEATHTAG.WAV", AssetScope::Scene);
     PlayAudioParams params;
-    params.audio = gAssetManager.LoadAsset<Audio>("TEMPLEDEATHTAG.WAV", AssetScope::Scene);
+    params.audio = audio.Get();
     params.audioType = AudioType::Music;
     gAudioManager.Play(params);
 }
@@ -851,7 +851,7 @@ void DrivingScreen::OnLocationButtonPressed(const std::string& locationCode)
     }
 
     // Play button sound effect.
-    gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("MAPBUTTON.WAV"));
+    gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("MAPBUTTON.WAV").Get());
 
     // Check conditions under which we would NOT allow going to this location.
     // Don't allow going to Larry's place during timeblock 106P and 202A.
@@ -99,7 +99,8 @@ void InventoryInspectScreen::Show(const std::string& itemName)
     else
     {
         // Set closeup image.
-        mCloseupImage->SetUpTexture(gInventoryManager.GetInventoryItemCloseupTexture(itemName));
+        mCloseupTexture = gInventoryManager.GetInventoryItemCloseupTexture(itemName);
+        mCloseupImage->SetUpTexture(mCloseupTexture.Get());
 
         // Set press callback.
         mCloseupImage->SetPressCallback([this](UIButton* button){
@@ -122,6 +123,10 @@ void InventoryInspectScreen::Hide()
     if(!IsActive()) { return; }
     SetActive(false);
     gLayerManager.PopLayer(&mLayer);
+
+    // Let go of the closeup texture, so it can be evicted if the texture cache is over budget.
+    mCloseupImage->SetUpTexture(nullptr);
+    mCloseupTexture.Reset();
 }
 
 bool InventoryInspectScreen::IsShowing() const
@@ -6,8 +6,10 @@
 #pragma once
 #include "Actor.h"
 
+#include "AssetCache.h"
 #include "LayerManager.h"
 
+class Texture;
 class UIButton;
 
 class InventoryInspectScreen : public Actor
@@ -36,6 +38,9 @@ private:
     // Needs to be a button b/c we can click to show action bar.
     UIButton* mCloseupImage = nullptr;
 
+    // The closeup texture being shown. Held only while the screen is showing, so the texture can be evicted afterwards.
+    AssetHandle<Texture> mCloseupTexture;
+
     // The name of the item currently being inspected.
     std::string mInspectItemName;
 
@@ -44,7 +44,7 @@ QuitPopup::QuitPopup() : Actor("QuitPopup", TransformType::RectTransform),
     mNoButton->SetDownTexture(gAssetManager.LoadAsset<Texture>("QG_NO_D.BMP"));
     mNoButton->SetPressCallback([this](UIButton* button){
         Hide();
-        gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDBUTN-1.WAV"));
+        gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDBUTN-1.WAV").Get());
     });
 
     // Hide by default.
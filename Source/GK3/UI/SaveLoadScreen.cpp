@@ -536,7 +536,7 @@ void SaveLoadScreen::OnListEntryButtonPressed(int listEntryIndex)
 
 void SaveLoadScreen::OnSaveButtonPressed()
 {
-    gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDBUTN-1.WAV"));
+    gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDBUTN-1.WAV").Get());
     if(mSaveIndex < gSaveManager.GetSaves().size())
     {
         if(!mTextInput->IsEnabled())
@@ -566,7 +566,7 @@ void SaveLoadScreen::OnSaveButtonPressed()
 
 void SaveLoadScreen::OnLoadButtonPressed()
 {
-    gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDBUTN-1.WAV"));
+    gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDBUTN-1.WAV").Get());
 
     // Hide this screen. Also, make sure title screen is hidden (in case loading from title screen).
     Hide();
@@ -577,7 +577,7 @@ void SaveLoadScreen::OnLoadButtonPressed()
 
 void SaveLoadScreen::OnExitButtonPressed()
 {
-    gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDBUTN-1.WAV"));
+    gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDBUTN-1.WAV").Get());
     Hide();
 }
 
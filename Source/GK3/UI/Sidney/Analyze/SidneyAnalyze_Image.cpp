@@ -234,7 +234,7 @@ void SidneyAnalyze::AnalyzeImage_OnAnalyzeTextPressed()
         gActionManager.StartManualAction();
 
         // Play a modem SFX, so it seems like we're reaching out to the internet...
-        gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDMODEM.WAV", AssetScope::Scene));
+        gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDMODEM.WAV", AssetScope::Scene).Get());
 
         // Show a series of messages that make it seem like we're analyzing the text and downloading stuff from the internet.
         ShowAnalyzeMessage("Text1Parch2", Vector2(), HorizontalAlignment::Center, true);
@@ -385,7 +385,7 @@ void SidneyAnalyze::AnalyzeImage_OnViewGeometryButtonPressed()
                         // Show tilted square.
                         mAnalyzeVideoImages[0]->SetTexture(gAssetManager.LoadAsset<Texture>("TENIERGEOC.BMP", AssetScope::Scene));
                         mAnalyzeVideoImages[0]->GetTexture()->SetTransparentColor(Color32(0, 255, 0));
-                        gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDBUTTON4.WAV"));
+                        gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDBUTTON4.WAV").Get());
                         ShowAnalyzeMessage("GeometryTenier4", Vector2(190.0f, -160.0f), HorizontalAlignment::Center, true);
 
                         // Wait a bit more.
@@ -516,7 +516,7 @@ void SidneyAnalyze::AnalyzeImage_OnZoomClarifyButtonPressed()
 
                 // Play a modem SFX, so it seems like we're reaching out to the internet...
                 gActionManager.StartManualAction();
-                gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDMODEM.WAV", AssetScope::Scene));
+                gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDMODEM.WAV", AssetScope::Scene).Get());
                 ShowAnalyzeMessage("RetrieveVerse", Vector2(), HorizontalAlignment::Center, true);
 
                 // The audio file is about six seconds long.
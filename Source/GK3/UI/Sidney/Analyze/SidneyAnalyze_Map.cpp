@@ -624,7 +624,7 @@ void SidneyAnalyze::AnalyzeMap_CheckPiscesCompletion()
 
                 // Grace is excited that we figured it out.
                 gActionManager.ExecuteSheepAction("wait StartDialogue(\"02OAG2ZJU2\", 2)", [](const Action* action){
-                    gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("CLOCKTIMEBLOCK.WAV"));
+                    gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("CLOCKTIMEBLOCK.WAV").Get());
                 });
 
                 // Show confirmation message.
@@ -775,7 +775,7 @@ void SidneyAnalyze::AnalyzeMap_CheckTaurusCompletion()
 
             // Grace is excited that we figured it out. And time moves forward a bit!
             gActionManager.ExecuteSheepAction("wait StartDialogue(\"02O7E2ZQB1\", 1)", [](const Action* action){
-                gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("CLOCKTIMEBLOCK.WAV"));
+                gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("CLOCKTIMEBLOCK.WAV").Get());
             });
 
             // Taurus is done.
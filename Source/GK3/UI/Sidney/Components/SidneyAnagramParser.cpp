@@ -617,8 +617,9 @@ void SidneyAnagramParser::RefreshAvailableWordsScrollList()
 void SidneyAnagramParser::StartScramble()
 {
     // Play a "we're scrambling the letters" sound.
+    AssetHandle<Audio> audio = gAssetManager.LoadAssetHandle<Audio>("SIDANAGRAMSCRAMBLE.WAV", AssetScope::Scene);
     PlayAudioParams audioParams;
-    audioParams.audio = gAssetManager.LoadAsset<Audio>("SIDANAGRAMSCRAMBLE.WAV", AssetScope::Scene);
+    audioParams.audio = audio.Get();
     audioParams.audioType = AudioType::SFX;
     audioParams.loopCount = -1;
     mScrambleSoundHandle = gAudioManager.Play(audioParams);
@@ -137,8 +137,8 @@ void SidneyFakeInputPopup::OnUpdate(float deltaTime)
 
                 // Play random "key press" SFX from set of sounds.
                 int index = Random::Range(1, 5);
-                Audio* audio = gAssetManager.LoadAsset<Audio>("COMPKEYSIN" + std::to_string(index), AssetScope::Scene);
-                gAudioManager.PlaySFX(audio);
+                AssetHandle<Audio> audio = gAssetManager.LoadAssetHandle<Audio>("COMPKEYSIN" + std::to_string(index), AssetScope::Scene);
+                gAudioManager.PlaySFX(audio.Get());
             }
             else
             {
@@ -156,7 +156,7 @@ void SidneyFakeInputPopup::OnUpdate(float deltaTime)
                 mOKButton->Press();
 
                 // The game also plays like an "enter key press" sound at this point.
-                gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("COMPKEYSPACE.WAV", AssetScope::Scene));
+                gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("COMPKEYSPACE.WAV", AssetScope::Scene).Get());
             }
         }
     }
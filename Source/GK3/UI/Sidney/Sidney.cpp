@@ -66,7 +66,7 @@ Sidney::Sidney() : Actor("Sidney", TransformType::RectTransform)
         float buttonPos = kButtonStart;
         UIButton* searchButton = CreateMainButton(desktopBackground, "SEARCH", buttonPos);
         searchButton->SetPressCallback([this](UIButton* button){
-            gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDENTER.WAV"));
+            gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDENTER.WAV").Get());
 
             // Gabe refuses to use the search system.
             if(StringUtil::EqualsIgnoreCase(Scene::GetEgoName(), "Gabriel"))
@@ -83,7 +83,7 @@ Sidney::Sidney() : Actor("Sidney", TransformType::RectTransform)
         buttonPos += kButtonSpacing;
         UIButton* emailButton = CreateMainButton(desktopBackground, "EMAIL", buttonPos);
         emailButton->SetPressCallback([this](UIButton* button){
-            gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDENTER.WAV"));
+            gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDENTER.WAV").Get());
 
             // Gabe also doesn't want to use email.
             if(StringUtil::EqualsIgnoreCase(Scene::GetEgoName(), "Gabriel"))
@@ -102,7 +102,7 @@ Sidney::Sidney() : Actor("Sidney", TransformType::RectTransform)
         filesButton->SetPressCallback([this](UIButton* button){
 
             // Show file selector, along with button SFX.
-            gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDENTER.WAV"));
+            gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDENTER.WAV").Get());
             mFiles.Show([this](SidneyFile* selectedFile){
 
                 // When a file is clicked, try to direct to the most relevant area of Sidney, with that file opened.
@@ -133,14 +133,14 @@ Sidney::Sidney() : Actor("Sidney", TransformType::RectTransform)
                 }
 
                 // Plays another button SFX upon selecting a file.
-                gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDENTER.WAV"));
+                gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDENTER.WAV").Get());
             });
         });
 
         buttonPos += kButtonSpacing;
         UIButton* analyzeButton = CreateMainButton(desktopBackground, "ANALYZE", buttonPos);
         analyzeButton->SetPressCallback([this](UIButton* button){
-            gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDENTER.WAV"));
+            gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDENTER.WAV").Get());
 
             // Gabe also doesn't want to analyze stuff.
             if(StringUtil::EqualsIgnoreCase(Scene::GetEgoName(), "Gabriel"))
@@ -157,7 +157,7 @@ Sidney::Sidney() : Actor("Sidney", TransformType::RectTransform)
         buttonPos += kButtonSpacing;
         UIButton* translateButton = CreateMainButton(desktopBackground, "TRANSL", buttonPos);
         translateButton->SetPressCallback([this](UIButton* button){
-            gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDENTER.WAV"));
+            gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDENTER.WAV").Get());
             mFiles.HideAllFileWindows();
             mTranslate.Show();
         });
@@ -165,7 +165,7 @@ Sidney::Sidney() : Actor("Sidney", TransformType::RectTransform)
         buttonPos += kButtonSpacing;
         UIButton* dataButton = CreateMainButton(desktopBackground, "ADDATA", buttonPos);
         dataButton->SetPressCallback([this](UIButton* button){
-            gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDENTER.WAV"));
+            gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDENTER.WAV").Get());
             mFiles.HideAllFileWindows();
             mAddData.Start();
         });
@@ -173,7 +173,7 @@ Sidney::Sidney() : Actor("Sidney", TransformType::RectTransform)
         buttonPos += kButtonSpacing;
         UIButton* idButton = CreateMainButton(desktopBackground, "MAKEID", buttonPos);
         idButton->SetPressCallback([this](UIButton* button){
-            gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDENTER.WAV"));
+            gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDENTER.WAV").Get());
             mFiles.HideAllFileWindows();
             mMakeId.Show();
         });
@@ -181,7 +181,7 @@ Sidney::Sidney() : Actor("Sidney", TransformType::RectTransform)
         buttonPos += kButtonSpacing;
         UIButton* suspectsButton = CreateMainButton(desktopBackground, "SUSPT", buttonPos);
         suspectsButton->SetPressCallback([this](UIButton* button){
-            gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDENTER.WAV"));
+            gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDENTER.WAV").Get());
             mFiles.HideAllFileWindows();
             mSuspects.Show();
         });
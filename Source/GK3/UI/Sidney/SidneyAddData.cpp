@@ -128,7 +128,7 @@ void SidneyAddData::OnUpdate(float deltaTime)
                 // CASE 3: Valid object selected, not scanned yet.
                 // Show box (and SFX) indicating we are scanning an item.
                 mAddDataBox->SetActive(true);
-                gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDSCAN.WAV"));
+                gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDSCAN.WAV").Get());
 
                 // Start with green text, but it will blink on an interval.
                 mAddDataLabel->SetText(SidneyUtil::GetAddDataLocalizer().GetText("ScanningItem"));
@@ -58,7 +58,7 @@ void SidneyEmail::Init(Actor* parent, Actor* newEmailParent)
 
         // Add close button.
         SidneyUtil::CreateCloseWindowButton(emailListWindow->GetOwner(), [this](){
-            gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDEXIT.WAV"));
+            gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDEXIT.WAV").Get());
             Hide();
         });
     }
@@ -416,7 +416,7 @@ void SidneyEmail::UpdateNewEmail(float deltaTime)
         // If we do this during an action skip, the action skip logic will stomp this audio. So, wait until no skip is happening.
         if(mPlayNewEmailSfx && !gActionManager.IsSkippingCurrentAction())
         {
-            gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("NEWEMAIL.WAV"));
+            gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("NEWEMAIL.WAV").Get());
             mPlayNewEmailSfx = false;
         }
 
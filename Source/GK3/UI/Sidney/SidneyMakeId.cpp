@@ -307,7 +307,7 @@ void SidneyMakeId::PrintId()
                     gActionManager.ExecuteSheepAction(vo);
 
                     // Play a print SFX.
-                    gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDPRINTID.WAV", AssetScope::Scene));
+                    gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDPRINTID.WAV", AssetScope::Scene).Get());
 
                     // Grant the inventory item.
                     gInventoryManager.AddInventoryItem(invItemName);
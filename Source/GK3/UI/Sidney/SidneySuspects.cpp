@@ -830,7 +830,7 @@ void SidneySuspects::OnMatchAnalysisPressed()
     gActionManager.StartManualAction();
 
     // Ok, we're going to put on a big show of analyzing the fingerprint and comparing it to all the suspects!
-    gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("WORKING3.WAV", AssetScope::Scene), [this, videoName, compareTexture, matchSuspectIndex](){
+    gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("WORKING3.WAV", AssetScope::Scene).Get(), [this, videoName, compareTexture, matchSuspectIndex](){
 
         // Play video file of the match analysis occurring.
         mMAFingerprintVideoImage->SetEnabled(true);
@@ -128,7 +128,7 @@ void TimeblockScreen::Show(const Timeblock& timeblock, float timer, bool loading
     // Play "tick tock" sound effect (when not loading a save).
     if(!loadingSave)
     {
-        gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("CLOCKTIMEBLOCK.WAV"));
+        gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("CLOCKTIMEBLOCK.WAV").Get());
     }
 
     // Hide buttons if this screen is on a timer.
@@ -53,7 +53,7 @@ TitleScreen::TitleScreen() : Actor("TitleScreen", TransformType::RectTransform)
     restoreButton->SetTooltipText("titlerestore");
     restoreButton->SetPressCallback([](UIButton* button){
         gGK3UI.ShowLoadScreen();
-        gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDBUTN-1.WAV"));
+        gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDBUTN-1.WAV").Get());
     });
     if(GEngine::Instance()->IsDemoMode())
     {
@@ -67,7 +67,7 @@ TitleScreen::TitleScreen() : Actor("TitleScreen", TransformType::RectTransform)
     playButton->SetPressCallback([this](UIButton* button){
         Hide();
         GEngine::Instance()->StartGame();
-        gAudioManager.PlaySFX(gAssetManager.LoadAsset<Audio>("SIDBUTN-1.WAV"));
+        gAudioManager.PlaySFX(gAssetManager.LoadAssetHandle<Audio>("SIDBUTN-1.WAV").Get());
     });
     mPlayButton = playButton;
 
@@ -5,6 +5,7 @@
 //
 #include "catch.hh"
 #include "AABB.h"
+#include "Matrix4.h"
 
 TEST_CASE("AABB creation works")
 {
@@ -62,3 +63,24 @@ TEST_CASE("AABB get closest point works")
     REQUIRE(aabb.GetClosestPoint(Vector3(0.0f, -90.0f, 5.0f)) == min);
     REQUIRE(aabb.GetClosestPoint(Vector3(76.0f, 0.0f, 5.0f)) == Vector3(76.0f, -10.0f, 8.5f));
 }
+
+
+TEST_CASE("AABB from transformed AABB works")
+{
+    AABB aabb(Vector3(-1.0f, -2.0f, -3.0f), Vector3(1.0f, 2.0f, 3.0f));
+
+    // Translation and scale just move and resize the box.
+    AABB moved = AABB::FromTransformedAABB(aabb, Matrix4::MakeTranslate(Vector3(10.0f, 0.0f, 0.0f)) * Matrix4::MakeScale(2.0f));
+    REQUIRE(moved.GetMin() == Vector3(8.0f, -4.0f, -6.0f));
+    REQUIRE(moved.GetMax() == Vector3(12.0f, 4.0f, 6.0f));
+
+    // A 90 degree rotation about Y swaps the X and Z extents.
+    AABB rotated = AABB::FromTransformedAABB(aabb, Matrix4::MakeRotateY(Math::kPiOver2));
+    REQUIRE(rotated.GetMin() == Vector3(-3.0f, -2.0f, -1.0f));
+    REQUIRE(rotated.GetMax() == Vector3(3.0f, 2.0f, 1.0f));
+
+    // A 45 degree rotation grows the box so all the rotated corners still fit.
+    AABB rotated45 = AABB::FromTransformedAABB(aabb, Matrix4::MakeRotateY(Math::kPiOver4));
+    float expectedExtent = (1.0f + 3.0f) * Math::Sqrt(0.5f);
+    REQUIRE(rotated45.GetExtents() == Vector3(expectedExtent, 2.0f, expectedExtent));
+}
\ No newline at end of file
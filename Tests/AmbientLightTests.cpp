@@ -0,0 +1,138 @@
+//
+// Clark Kromenaker
+//
+// Tests for BSP ambient light lookups, and the per-actor ambient color cache.
+// Grid results are compared against a reference search of every light, which is how ambient colors were calculated before the grid.
+//
+#include "catch.hh"
+#include "ActorAmbientLight.h"
+#include "BSPAmbientLights.h"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    std::vector<BSPAmbientLight> CreateRandomLights(std::mt19937& rng, int count)
+    {
+        std::uniform_real_distribution<float> posDist(-300.0f, 300.0f);
+        std::uniform_real_distribution<float> radiusDist(5.0f, 80.0f);
+        std::uniform_int_distribution<int> colorDist(0, 255);
+        std::vector<BSPAmbientLight> lights(count);
+        for(BSPAmbientLight& light : lights)
+        {
+            light.position = Vector3(posDist(rng), posDist(rng) * 0.25f, posDist(rng));
+            light.radius = radiusDist(rng);
+            light.color = Color32(colorDist(rng), colorDist(rng), colorDist(rng));
+        }
+        return lights;
+    }
+
+    // Checks every light, in list order.
+    Color32 ReferenceAmbientColor(const std::vector<BSPAmbientLight>& lights, const Vector3& position)
+    {
+        Color32 color = Color32::Black;
+        for(const BSPAmbientLight& light : lights)
+        {
+            float distSq = (position - light.position).GetLengthSq();
+            float radiusSq = light.radius * light.radius;
+            if(distSq <= radiusSq)
+            {
+                color += Color32::Lerp(light.color, Color32::Black, distSq / radiusSq);
+            }
+        }
+        return color;
+    }
+}
+
+TEST_CASE("Ambient light grid gives the same colors as checking every light")
+{
+    std::mt19937 rng(4321);
+    std::vector<BSPAmbientLight> lights = CreateRandomLights(rng, 200);
+    BSPAmbientLightGrid grid;
+    grid.Build(lights);
+
+    // Sample positions inside and around the lights, including outside the grid entirely.
+    std::uniform_real_distribution<float> posDist(-450.0f, 450.0f);
+    int litCount = 0;
+    for(int i = 0; i < 2000; ++i)
+    {
+        Vector3 position(posDist(rng), posDist(rng) * 0.25f, posDist(rng));
+        Color32 expected = ReferenceAmbientColor(lights, position);
+        REQUIRE(grid.CalculateColor(lights, position) == expected);
+        if(!(expected == Color32::Black)) { ++litCount; }
+    }
+
+    // Positions at each light's center, and just inside its sphere, along each axis.
+    for(const BSPAmbientLight& light : lights)
+    {
+        REQUIRE(grid.CalculateColor(lights, light.position) == ReferenceAmbientColor(lights, light.position));
+        for(int axis = 0; axis < 3; ++axis)
+        {
+            Vector3 offset;
+            offset[axis] = light.radius * 0.999f;
+            REQUIRE(grid.CalculateColor(lights, light.position + offset) == ReferenceAmbientColor(lights, light.position + offset));
+            REQUIRE(grid.CalculateColor(lights, light.position - offset) == ReferenceAmbientColor(lights, light.position - offset));
+        }
+    }
+
+    // Make sure the random positions actually tested some lit areas.
+    REQUIRE(litCount > 100);
+}
+
+TEST_CASE("Ambient light grid handles no lights and a single light")
+{
+    BSPAmbientLightGrid grid;
+    std::vector<BSPAmbientLight> lights;
+    grid.Build(lights);
+    REQUIRE(grid.CalculateColor(lights, Vector3::Zero) == Color32::Black);
+
+    BSPAmbientLight light;
+    light.position = Vector3(10.0f, 0.0f, 10.0f);
+    light.radius = 4.0f;
+    light.color = Color32(200, 100, 50);
+    lights.push_back(light);
+    grid.Build(lights);
+    REQUIRE(grid.CalculateColor(lights, light.position) == light.color);
+    REQUIRE(grid.CalculateColor(lights, Vector3(12.0f, 0.0f, 10.0f)) == ReferenceAmbientColor(lights, Vector3(12.0f, 0.0f, 10.0f)));
+    REQUIRE(grid.CalculateColor(lights, Vector3(20.0f, 0.0f, 10.0f)) == Color32::Black);
+
+    // The grid only stores light indexes, so light colors can change without a rebuild.
+    lights[0].color = Color32(10, 20, 30);
+    REQUIRE(grid.CalculateColor(lights, light.position) == lights[0].color);
+}
+
+TEST_CASE("Actor ambient color is only recalculated after moving far enough or when lights change")
+{
+    int calculateCount = 0;
+    auto calculateColor = [&calculateCount](const Vector3& position) {
+        ++calculateCount;
+        return Color32(static_cast<int>(position.x), 0, 0);
+    };
+
+    ActorAmbientLight ambientLight;
+    const BSP* bsp = nullptr;
+    uint32_t version = 0;
+
+    // The first request always calculates.
+    REQUIRE(ambientLight.GetColor(bsp, version, Vector3(10.0f, 0.0f, 0.0f), calculateColor) == Color32(10, 0, 0));
+    REQUIRE(calculateCount == 1);
+
+    // Small moves (up to the threshold) reuse the last color.
+    REQUIRE(ambientLight.GetColor(bsp, version, Vector3(10.5f, 0.0f, 0.5f), calculateColor) == Color32(10, 0, 0));
+    REQUIRE(ambientLight.GetColor(bsp, version, Vector3(11.0f, 0.0f, 0.0f), calculateColor) == Color32(10, 0, 0));
+    REQUIRE(calculateCount == 1);
+
+    // Moving past the threshold recalculates. Distance is measured from where the color was last calculated.
+    REQUIRE(ambientLight.GetColor(bsp, version, Vector3(11.1f, 0.0f, 0.0f), calculateColor) == Color32(11, 0, 0));
+    REQUIRE(calculateCount == 2);
+    REQUIRE(ambientLight.GetColor(bsp, version, Vector3(11.1f, 0.9f, 0.0f), calculateColor) == Color32(11, 0, 0));
+    REQUIRE(calculateCount == 2);
+
+    // A change in the lights (e.g. a new lightmap) recalculates, even without moving.
+    ++version;
+    REQUIRE(ambientLight.GetColor(bsp, version, Vector3(11.1f, 0.9f, 0.0f), calculateColor) == Color32(11, 0, 0));
+    REQUIRE(calculateCount == 3);
+    REQUIRE(ambientLight.GetColor(bsp, version, Vector3(11.1f, 0.9f, 0.0f), calculateColor) == Color32(11, 0, 0));
+    REQUIRE(calculateCount == 3);
+}
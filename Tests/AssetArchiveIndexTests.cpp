@@ -0,0 +1,114 @@
+//
+// Clark Kromenaker
+//
+// Tests for AssetArchiveIndex class.
+//
+#include "catch.hh"
+#include "AssetArchiveIndex.h"
+
+#include "IAssetArchive.h"
+#include "StringUtil.h"
+
+namespace
+{
+    // An archive that only has asset names - enough for indexing.
+    class FakeArchive : public IAssetArchive
+    {
+    public:
+        FakeArchive(const std::string& name, std::initializer_list<std::string> assetNames) : mName(name), mAssetNames(assetNames)
+        {
+            for(const std::string& assetName : mAssetNames)
+            {
+                mAssetNameHashes.push_back(static_cast<uint32_t>(StringUtil::HashCaseInsensitive(assetName)));
+            }
+        }
+
+        const std::string& GetName() const override { return mName; }
+        uint8_t* CreateAssetBuffer(const std::string& assetName, uint32_t& outBufferSize) const override { return nullptr; }
+        void ForEachAsset(const std::function<void(const std::string&)>& callback) const override { }
+
+        uint32_t GetAssetCount() const override { return static_cast<uint32_t>(mAssetNames.size()); }
+        const char* GetAssetName(uint32_t index) const override { return mAssetNames[index].c_str(); }
+        uint32_t GetAssetNameHash(uint32_t index) const override { return mAssetNameHashes[index]; }
+        bool LoadAssetData(uint32_t index, AssetData& outAssetData) const override { return false; }
+        bool IsAssetCompressed(uint32_t index) const override { return false; }
+
+        // Pretends an asset's name has a different hash, to simulate hash collisions.
+        void SetAssetNameHash(uint32_t index, uint32_t hash) { mAssetNameHashes[index] = hash; }
+
+    private:
+        std::string mName;
+        std::vector<std::string> mAssetNames;
+        std::vector<uint32_t> mAssetNameHashes;
+    };
+}
+
+TEST_CASE("Asset archive index finds assets in any archive")
+{
+    FakeArchive archiveA("A.BRN", { "ONE.BMP", "TWO.BMP" });
+    FakeArchive archiveB("B.BRN", { "THREE.BMP" });
+
+    AssetArchiveIndex index;
+    index.InsertArchive(0, &archiveA);
+    index.InsertArchive(1, &archiveB);
+    REQUIRE(index.GetAssetCount() == 3);
+
+    // Lookups are case-insensitive.
+    const AssetArchiveIndex::Entry* entry = index.Find("two.bmp");
+    REQUIRE(entry != nullptr);
+    REQUIRE(entry->archiveIndex == 0);
+    REQUIRE(entry->assetIndex == 1);
+
+    entry = index.Find("THREE.BMP");
+    REQUIRE(entry != nullptr);
+    REQUIRE(entry->archiveIndex == 1);
+    REQUIRE(entry->assetIndex == 0);
+
+    REQUIRE(index.Find("FOUR.BMP") == nullptr);
+
+    index.Clear();
+    REQUIRE(index.GetAssetCount() == 0);
+    REQUIRE(index.Find("ONE.BMP") == nullptr);
+}
+
+TEST_CASE("Asset archive index uses the highest priority archive for duplicate assets")
+{
+    FakeArchive core("CORE.BRN", { "SHARED.BMP", "CORE.BMP" });
+    FakeArchive day1("DAY1.BRN", { "SHARED.BMP", "DAY1.BMP" });
+    FakeArchive overrideArchive("OVERRIDE.BRN", { "shared.bmp" });
+
+    // A lower priority archive added later doesn't replace the existing asset.
+    AssetArchiveIndex index;
+    index.InsertArchive(0, &core);
+    index.InsertArchive(1, &day1);
+    REQUIRE(index.GetAssetCount() == 3);
+    REQUIRE(index.Find("SHARED.BMP")->archiveIndex == 0);
+
+    // A higher priority archive added later does, and existing archives move down.
+    index.InsertArchive(0, &overrideArchive);
+    REQUIRE(index.GetAssetCount() == 3);
+    const AssetArchiveIndex::Entry* entry = index.Find("SHARED.BMP");
+    REQUIRE(entry->archiveIndex == 0);
+    REQUIRE(entry->assetIndex == 0);
+    REQUIRE(index.Find("CORE.BMP")->archiveIndex == 1);
+    REQUIRE(index.Find("DAY1.BMP")->archiveIndex == 2);
+}
+
+TEST_CASE("Asset archive index tells apart assets with the same hash")
+{
+    // Two different names with the same hash, in different archives. Neither is a duplicate of the other.
+    FakeArchive archiveA("A.BRN", { "FIRST.BMP" });
+    FakeArchive archiveB("B.BRN", { "SECOND.BMP" });
+    uint32_t hash = static_cast<uint32_t>(StringUtil::HashCaseInsensitive("SECOND.BMP"));
+    archiveA.SetAssetNameHash(0, hash);
+
+    AssetArchiveIndex index;
+    index.InsertArchive(0, &archiveA);
+    index.InsertArchive(1, &archiveB);
+    REQUIRE(index.GetAssetCount() == 2);
+
+    // Looking up the name finds the right asset, even though a higher priority archive has an asset with the same hash.
+    const AssetArchiveIndex::Entry* entry = index.Find("SECOND.BMP");
+    REQUIRE(entry != nullptr);
+    REQUIRE(entry->archiveIndex == 1);
+}
\ No newline at end of file
@@ -0,0 +1,228 @@
+//
+// Clark Kromenaker
+//
+// Tests for AssetCache memory budgets and asset handles.
+//
+#include "catch.hh"
+#include "AssetCache.h"
+
+#include <thread>
+
+namespace
+{
+    class TestAsset : public Asset
+    {
+        TYPEINFO_SUB(TestAsset, Asset);
+    public:
+        TestAsset(const std::string& name, size_t memorySize) : Asset(name, AssetScope::Global)
+        {
+            SetMemorySize(memorySize);
+            MarkUsed();
+        }
+    };
+
+    TYPEINFO_INIT(TestAsset, Asset, 3)
+    {
+
+    }
+
+    // Counts how many of these assets have been deleted.
+    class DeleteCountingAsset : public TestAsset
+    {
+    public:
+        static int sDeleteCount;
+        using TestAsset::TestAsset;
+        ~DeleteCountingAsset() override { ++sDeleteCount; }
+    };
+    int DeleteCountingAsset::sDeleteCount = 0;
+}
+
+TEST_CASE("Asset cache evicts least recently used unreferenced assets")
+{
+    AssetCache<TestAsset>* cache = AssetCache<TestAsset>::Get("EvictionTest");
+    cache->SetMemoryBudget(300);
+
+    // Assets are used on different ticks, from A (oldest) to D (newest).
+    cache->AddAsset("A", new TestAsset("A", 100));
+    Asset::AdvanceUseTick();
+    cache->AddAsset("B", new TestAsset("B", 100));
+    Asset::AdvanceUseTick();
+    cache->AddAsset("C", new TestAsset("C", 100));
+    Asset::AdvanceUseTick();
+    TestAsset* assetD = new TestAsset("D", 100);
+    assetD->Pin();
+    cache->AddAsset("D", assetD);
+    Asset::AdvanceUseTick();
+    REQUIRE(cache->GetMemoryUsage() == 400);
+
+    // A is the oldest, but a handle refers to it. B is the oldest unreferenced asset, so it is evicted.
+    AssetHandle<TestAsset> handleA = cache->GetHandle("A");
+    REQUIRE(cache->GetReferenceCount("A") == 1);
+    cache->EvictAssets();
+    REQUIRE(cache->GetMemoryUsage() == 300);
+    REQUIRE(handleA.Get() != nullptr);
+    REQUIRE(cache->GetAsset("B") == nullptr);
+    REQUIRE(cache->GetAsset("C") != nullptr);
+    REQUIRE(cache->GetAsset("D") != nullptr);
+
+    // Copying or moving a handle keeps the reference. Only when all handles are gone can the asset be evicted.
+    AssetHandle<TestAsset> handleCopy = handleA;
+    REQUIRE(cache->GetReferenceCount("A") == 2);
+    AssetHandle<TestAsset> handleMoved = std::move(handleCopy);
+    REQUIRE(cache->GetReferenceCount("A") == 2);
+    handleA.Reset();
+    handleMoved.Reset();
+    REQUIRE(cache->GetReferenceCount("A") == 0);
+
+    // Now over budget again. A goes first, since it's older than C. The pinned asset is never evicted.
+    cache->AddAsset("E", new TestAsset("E", 100));
+    Asset::AdvanceUseTick();
+    cache->EvictAssets();
+    REQUIRE(cache->GetAsset("A") == nullptr);
+    REQUIRE(cache->GetAsset("C") != nullptr);
+    REQUIRE(cache->GetAsset("D") != nullptr);
+
+    // Assets used this tick are never evicted - they may be about to get a handle.
+    cache->SetMemoryBudget(100);
+    cache->AddAsset("F", new TestAsset("F", 100));
+    cache->EvictAssets();
+    REQUIRE(cache->GetAsset("C") == nullptr);
+    REQUIRE(cache->GetAsset("E") == nullptr);
+    REQUIRE(cache->GetAsset("D") != nullptr);
+    REQUIRE(cache->GetAsset("F") != nullptr);
+
+    // A handle to an evicted asset returns null, but starts working again if the asset is reloaded.
+    AssetHandle<TestAsset> handleC = cache->GetHandle("C");
+    REQUIRE(handleC.IsValid());
+    REQUIRE(handleC.GetName() == "C");
+    REQUIRE(handleC.Get() == nullptr);
+    cache->AddAsset("C", new TestAsset("C", 100));
+    REQUIRE(handleC.Get() == cache->GetAsset("C"));
+
+    // Handles to assets that were never in the cache are invalid, as are default handles.
+    REQUIRE(!cache->GetHandle("Z").IsValid());
+    AssetHandle<TestAsset> defaultHandle;
+    REQUIRE(defaultHandle.Get() == nullptr);
+    REQUIRE(defaultHandle.GetName().empty());
+    cache->UnloadAssets(AssetScope::Global);
+}
+
+TEST_CASE("Asset cache stays within budget over a long session")
+{
+    AssetCache<TestAsset>* cache = AssetCache<TestAsset>::Get("SessionTest");
+    cache->SetMemoryBudget(1000);
+
+    // Simulate owners (such as animations) that hold handles to a few assets each, some shared with other owners.
+    // Each owner only lives for a few frames. Over the session, far more assets are loaded than fit in the budget.
+    std::vector<std::vector<AssetHandle<TestAsset>>> owners;
+    int loadCount = 0;
+    for(int frame = 0; frame < 500; ++frame)
+    {
+        std::vector<AssetHandle<TestAsset>> handles;
+        for(int i = 0; i < 3; ++i)
+        {
+            // Load the asset, unless it's still in the cache.
+            std::string name = std::to_string((frame * 3 + i) % 200);
+            AssetHandle<TestAsset> handle = cache->GetHandle(name);
+            if(handle.Get() == nullptr)
+            {
+                handle = cache->AddAsset(name, new TestAsset(name, 50));
+                ++loadCount;
+            }
+            handle.Get()->MarkUsed();
+            handles.push_back(std::move(handle));
+        }
+        owners.push_back(std::move(handles));
+        if(owners.size() > 4)
+        {
+            owners.erase(owners.begin());
+        }
+
+        // Once a frame, the cache evicts whatever no owner refers to anymore, as needed to get back within budget.
+        Asset::AdvanceUseTick();
+        cache->EvictAssets();
+        REQUIRE(cache->GetMemoryUsage() <= cache->GetMemoryBudget());
+        for(auto& ownerHandles : owners)
+        {
+            for(auto& handle : ownerHandles)
+            {
+                REQUIRE(handle.Get() != nullptr);
+            }
+        }
+    }
+    REQUIRE(loadCount * 50 > 1000);
+
+    owners.clear();
+    cache->UnloadAssets(AssetScope::Global);
+}
+
+TEST_CASE("Asset cache keeps the first asset added with a name")
+{
+    AssetCache<TestAsset>* cache = AssetCache<TestAsset>::Get("AddTest");
+    DeleteCountingAsset::sDeleteCount = 0;
+
+    // Two threads loading the same asset both try to add it. The first one added is kept, and the other is deleted.
+    TestAsset* first = new DeleteCountingAsset("A", 100);
+    TestAsset* second = new DeleteCountingAsset("A", 100);
+    REQUIRE(cache->AddAsset("A", first).Get() == first);
+    REQUIRE(cache->AddAsset("a", second).Get() == first);
+    REQUIRE(DeleteCountingAsset::sDeleteCount == 1);
+    REQUIRE(cache->GetAsset("A") == first);
+    REQUIRE(cache->GetAssets().size() == 1);
+    REQUIRE(cache->GetMemoryUsage() == 100);
+
+    cache->UnloadAssets(AssetScope::Global);
+    REQUIRE(DeleteCountingAsset::sDeleteCount == 2);
+    REQUIRE(cache->GetMemoryUsage() == 0);
+}
+
+TEST_CASE("Asset cache makes a second loader wait for an asset already being loaded")
+{
+    AssetCache<TestAsset>* cache = AssetCache<TestAsset>::Get("LoadTest");
+
+    // The first loader claims the load.
+    cache->BeginLoad("A");
+
+    // A second loader of the same asset waits until the first is done, and then finds its asset in the cache.
+    TestAsset* waiterAsset = nullptr;
+    std::thread waiter([cache, &waiterAsset]() {
+        cache->BeginLoad("a");
+        waiterAsset = cache->GetAsset("A");
+        cache->EndLoad("a");
+    });
+
+    // Loading other assets isn't held up.
+    cache->BeginLoad("B");
+    cache->EndLoad("B");
+
+    TestAsset* asset = new TestAsset("A", 100);
+    cache->AddAsset("A", asset);
+    cache->EndLoad("A");
+    waiter.join();
+    REQUIRE(waiterAsset == asset);
+
+    cache->UnloadAssets(AssetScope::Global);
+}
+
+TEST_CASE("Asset cache doesn't unload assets that handles refer to")
+{
+    AssetCache<TestAsset>* cache = AssetCache<TestAsset>::Get("UnloadTest");
+    DeleteCountingAsset::sDeleteCount = 0;
+
+    TestAsset* referencedAsset = new DeleteCountingAsset("A", 100);
+    AssetHandle<TestAsset> handle = cache->AddAsset("A", referencedAsset);
+    cache->AddAsset("B", new DeleteCountingAsset("B", 100));
+
+    // Only the unreferenced asset is unloaded. The referenced one stays loaded, and still counts against the budget.
+    REQUIRE(cache->UnloadAssets(AssetScope::Global) == 1);
+    REQUIRE(DeleteCountingAsset::sDeleteCount == 1);
+    REQUIRE(handle.Get() == referencedAsset);
+    REQUIRE(cache->GetMemoryUsage() == 100);
+
+    // Once the handle is released, the asset can be unloaded.
+    handle.Reset();
+    REQUIRE(cache->UnloadAssets(AssetScope::Global) == 1);
+    REQUIRE(DeleteCountingAsset::sDeleteCount == 2);
+    REQUIRE(cache->GetAsset("A") == nullptr);
+    REQUIRE(cache->GetMemoryUsage() == 0);
+}
@@ -0,0 +1,180 @@
+//
+// Clark Kromenaker
+//
+// Tests for the on-disk cache of decompressed archive assets.
+//
+#include "catch.hh"
+#include "AssetDiskCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "FileSystem.h"
+
+namespace
+{
+    const uint64_t kMaxCacheSize = 1024 * 1024;
+
+    // Writes a fake archive file. The cache only cares about the archive's path, size, and write time.
+    void WriteArchive(const std::string& archivePath, const std::string& contents)
+    {
+        std::ofstream stream(archivePath, std::ios::out | std::ios::binary | std::ios::trunc);
+        stream << contents;
+    }
+
+    void StoreAsset(AssetDiskCache& cache, const std::string& assetName, const std::string& contents)
+    {
+        AssetData assetData;
+        uint8_t* buffer = new uint8_t[contents.size()];
+        memcpy(buffer, contents.data(), contents.size());
+        assetData.SetBytes(buffer, static_cast<uint32_t>(contents.size()));
+        cache.Store(assetName, assetData);
+    }
+
+    std::string LoadAsset(const AssetDiskCache& cache, const std::string& assetName)
+    {
+        AssetData assetData;
+        if(!cache.LoadAssetData(assetName, assetData))
+        {
+            return std::string();
+        }
+        return std::string(reinterpret_cast<const char*>(assetData.bytes.get()), assetData.length);
+    }
+}
+
+TEST_CASE("Disk cached assets can be loaded by a later cache for the same archive")
+{
+    const std::string archivePath = "DiskCacheTests.brn";
+    const std::string cachePath = "DiskCacheTests.cache";
+    WriteArchive(archivePath, "archive");
+    {
+        AssetDiskCache cache(cachePath, archivePath, kMaxCacheSize);
+        REQUIRE(cache.GetCachedAssetCount() == 0);
+        StoreAsset(cache, "First.txt", "first asset");
+        StoreAsset(cache, "Second.txt", "second asset");
+
+        // Stored assets aren't loadable from the cache until it's reopened.
+        REQUIRE(LoadAsset(cache, "First.txt").empty());
+    }
+    {
+        AssetDiskCache cache(cachePath, archivePath, kMaxCacheSize);
+        REQUIRE(cache.GetCachedAssetCount() == 2);
+        REQUIRE(LoadAsset(cache, "First.txt") == "first asset");
+        REQUIRE(LoadAsset(cache, "SECOND.TXT") == "second asset");
+        REQUIRE(LoadAsset(cache, "Third.txt").empty());
+
+        // Loaded assets are views of the mapped cache file.
+        AssetData assetData;
+        REQUIRE(cache.LoadAssetData("First.txt", assetData));
+        REQUIRE(assetData.IsView());
+    }
+    std::remove(cachePath.c_str());
+    std::remove(archivePath.c_str());
+}
+
+TEST_CASE("Disk cache is discarded when its archive changes")
+{
+    const std::string archivePath = "DiskCacheInvalidateTests.brn";
+    const std::string cachePath = "DiskCacheInvalidateTests.cache";
+    WriteArchive(archivePath, "archive");
+    {
+        AssetDiskCache cache(cachePath, archivePath, kMaxCacheSize);
+        StoreAsset(cache, "Asset.txt", "old contents");
+    }
+
+    // A different archive size means the archive changed, so the cached assets can't be trusted.
+    WriteArchive(archivePath, "changed archive");
+    {
+        AssetDiskCache cache(cachePath, archivePath, kMaxCacheSize);
+        REQUIRE(cache.GetCachedAssetCount() == 0);
+        REQUIRE(LoadAsset(cache, "Asset.txt").empty());
+        StoreAsset(cache, "Asset.txt", "new contents");
+    }
+    {
+        AssetDiskCache cache(cachePath, archivePath, kMaxCacheSize);
+        REQUIRE(cache.GetCachedAssetCount() == 1);
+        REQUIRE(LoadAsset(cache, "Asset.txt") == "new contents");
+    }
+    std::remove(cachePath.c_str());
+    std::remove(archivePath.c_str());
+}
+
+TEST_CASE("Disk caches for archives with the same name in different directories don't collide")
+{
+    REQUIRE(Directory::CreateAll("DiskCacheTestsA"));
+    REQUIRE(Directory::CreateAll("DiskCacheTestsB"));
+    const std::string archivePathA = Path::Combine({ "DiskCacheTestsA", "Same.brn" });
+    const std::string archivePathB = Path::Combine({ "DiskCacheTestsB", "Same.brn" });
+    WriteArchive(archivePathA, "archive");
+    WriteArchive(archivePathB, "archive");
+
+    // Each archive gets its own cache file.
+    const std::string cachePathA = AssetDiskCache::GetCacheFilePathNoExtension(".", archivePathA) + ".cache";
+    const std::string cachePathB = AssetDiskCache::GetCacheFilePathNoExtension(".", archivePathB) + ".cache";
+    REQUIRE(cachePathA != cachePathB);
+    {
+        AssetDiskCache cache(cachePathA, archivePathA, kMaxCacheSize);
+        StoreAsset(cache, "Asset.txt", "from A");
+    }
+
+    // Even if two archives did map to the same cache file, a cache created for one archive is never used for the other.
+    {
+        AssetDiskCache cache(cachePathA, archivePathB, kMaxCacheSize);
+        REQUIRE(cache.GetCachedAssetCount() == 0);
+    }
+    std::remove(cachePathA.c_str());
+    std::remove(cachePathB.c_str());
+    std::remove(archivePathA.c_str());
+    std::remove(archivePathB.c_str());
+    std::remove("DiskCacheTestsA");
+    std::remove("DiskCacheTestsB");
+}
+
+TEST_CASE("Disk cache stops growing at its maximum size and evicts the oldest assets")
+{
+    const std::string archivePath = "DiskCacheEvictionTests.brn";
+    const std::string cachePath = "DiskCacheEvictionTests.cache";
+    WriteArchive(archivePath, "archive");
+
+    // Each record is 8 bytes of sizes, a 5 byte name, and 87 bytes of data - 100 bytes total.
+    // The header is 28 bytes plus the archive path.
+    const uint64_t headerSize = 28 + archivePath.size();
+    const std::string assetContents(87, 'x');
+    {
+        AssetDiskCache cache(cachePath, archivePath, headerSize + 1000);
+        for(int i = 0; i < 20; ++i)
+        {
+            StoreAsset(cache, "A" + std::to_string(i + 1000).substr(1) + "_", assetContents);
+        }
+
+        // Only ten assets fit.
+        REQUIRE(cache.GetCacheFileSize() == headerSize + 1000);
+    }
+    {
+        AssetDiskCache cache(cachePath, archivePath, headerSize + 1000);
+        REQUIRE(cache.GetCachedAssetCount() == 10);
+    }
+
+    // Lowering the maximum size evicts the oldest assets, down to half the maximum size (here, the header plus 400 bytes of records).
+    const uint64_t lowerMaxSize = (headerSize + 400) * 2;
+    {
+        AssetDiskCache cache(cachePath, archivePath, lowerMaxSize);
+        REQUIRE(cache.GetCachedAssetCount() == 4);
+        REQUIRE(cache.GetCacheFileSize() == headerSize + 400);
+        REQUIRE(LoadAsset(cache, "A005_").empty());
+        REQUIRE(LoadAsset(cache, "A006_") == assetContents);
+        REQUIRE(LoadAsset(cache, "A009_") == assetContents);
+
+        // There's room to add more assets again.
+        StoreAsset(cache, "A010_", assetContents);
+        REQUIRE(cache.GetCacheFileSize() == headerSize + 500);
+    }
+    {
+        AssetDiskCache cache(cachePath, archivePath, lowerMaxSize);
+        REQUIRE(cache.GetCachedAssetCount() == 5);
+        REQUIRE(LoadAsset(cache, "A010_") == assetContents);
+    }
+    std::remove(cachePath.c_str());
+    std::remove(archivePath.c_str());
+}
@@ -0,0 +1,175 @@
+//
+// Clark Kromenaker
+//
+// Tests for BVH class.
+//
+#include "catch.hh"
+#include "BVH.h"
+
+#include <cfloat>
+#include <random>
+
+#include "Collisions.h"
+
+namespace
+{
+    // Brute force nearest hit against a list of boxes, to compare BVH results against.
+    int RaycastBruteForce(const Ray& ray, const std::vector<AABB>& boxes, float& outT)
+    {
+        int nearestIndex = -1;
+        outT = FLT_MAX;
+        for(size_t i = 0; i < boxes.size(); ++i)
+        {
+            float t = 0.0f;
+            if(Intersect::TestRayAABB(ray, boxes[i], t) && t < outT)
+            {
+                outT = t;
+                nearestIndex = static_cast<int>(i);
+            }
+        }
+        return nearestIndex;
+    }
+
+    std::vector<AABB> CreateRandomBoxes(std::mt19937& rng, int count)
+    {
+        std::uniform_real_distribution<float> posDist(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> sizeDist(0.5f, 5.0f);
+        std::vector<AABB> boxes;
+        for(int i = 0; i < count; ++i)
+        {
+            Vector3 center(posDist(rng), posDist(rng), posDist(rng));
+            boxes.push_back(AABB::FromCenterAndSize(center, Vector3(sizeDist(rng), sizeDist(rng), sizeDist(rng))));
+        }
+        return boxes;
+    }
+
+    Ray CreateRandomRay(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> posDist(-120.0f, 120.0f);
+        std::uniform_real_distribution<float> dirDist(-1.0f, 1.0f);
+        Vector3 dir(dirDist(rng), dirDist(rng), dirDist(rng));
+        if(dir == Vector3::Zero) { dir = Vector3::UnitX; }
+        return Ray(Vector3(posDist(rng), posDist(rng), posDist(rng)), Vector3::Normalize(dir));
+    }
+}
+
+TEST_CASE("Empty BVH doesn't hit anything")
+{
+    BVH bvh;
+    REQUIRE(bvh.IsEmpty());
+
+    bool calledBack = false;
+    float nearestT = FLT_MAX;
+    bvh.Raycast(Ray(Vector3::Zero, Vector3::UnitX), nearestT, [&calledBack](uint32_t, float&){
+        calledBack = true;
+    });
+    REQUIRE(!calledBack);
+
+    // Building from no items is also empty.
+    bvh.Build(std::vector<AABB>());
+    REQUIRE(bvh.IsEmpty());
+}
+
+TEST_CASE("BVH raycast finds same nearest hit as brute force")
+{
+    std::mt19937 rng(1234);
+    std::vector<AABB> boxes = CreateRandomBoxes(rng, 500);
+
+    BVH bvh;
+    bvh.Build(boxes);
+    REQUIRE(!bvh.IsEmpty());
+
+    for(int i = 0; i < 500; ++i)
+    {
+        Ray ray = CreateRandomRay(rng);
+
+        float expectedT = 0.0f;
+        int expectedIndex = RaycastBruteForce(ray, boxes, expectedT);
+
+        float nearestT = FLT_MAX;
+        int nearestIndex = -1;
+        bvh.Raycast(ray, nearestT, [&ray, &boxes, &nearestIndex](uint32_t itemIndex, float& inOutNearestT){
+            float t = 0.0f;
+            if(Intersect::TestRayAABB(ray, boxes[itemIndex], t) && t < inOutNearestT)
+            {
+                inOutNearestT = t;
+                nearestIndex = static_cast<int>(itemIndex);
+            }
+        });
+        REQUIRE(nearestIndex == expectedIndex);
+        REQUIRE(nearestT == expectedT);
+    }
+}
+
+TEST_CASE("BVH packet raycast matches single raycasts")
+{
+    std::mt19937 rng(5678);
+    std::vector<AABB> boxes = CreateRandomBoxes(rng, 300);
+
+    BVH bvh;
+    bvh.Build(boxes);
+
+    // Use a ray count that isn't a multiple of the packet size.
+    std::vector<Ray> rays;
+    for(int i = 0; i < 150; ++i)
+    {
+        rays.push_back(CreateRandomRay(rng));
+    }
+
+    std::vector<float> nearestTs(rays.size(), FLT_MAX);
+    std::vector<int> nearestIndexes(rays.size(), -1);
+    bvh.RaycastPacket(rays.data(), nearestTs.data(), static_cast<int>(rays.size()), [&rays, &boxes, &nearestIndexes](uint32_t itemIndex, int rayIndex, float& inOutNearestT){
+        float t = 0.0f;
+        if(Intersect::TestRayAABB(rays[rayIndex], boxes[itemIndex], t) && t < inOutNearestT)
+        {
+            inOutNearestT = t;
+            nearestIndexes[rayIndex] = static_cast<int>(itemIndex);
+        }
+    });
+
+    for(size_t i = 0; i < rays.size(); ++i)
+    {
+        float expectedT = 0.0f;
+        int expectedIndex = RaycastBruteForce(rays[i], boxes, expectedT);
+        REQUIRE(nearestIndexes[i] == expectedIndex);
+        REQUIRE(nearestTs[i] == expectedT);
+    }
+}
+
+TEST_CASE("BVH handles axis-aligned rays")
+{
+    // A flat "floor" of boxes with zero height, like floor polygons. Rays point straight down, like floor height checks.
+    std::vector<AABB> boxes;
+    for(int x = 0; x < 10; ++x)
+    {
+        for(int z = 0; z < 10; ++z)
+        {
+            boxes.push_back(AABB(Vector3(x * 10.0f, 0.0f, z * 10.0f), Vector3(x * 10.0f + 10.0f, 0.0f, z * 10.0f + 10.0f)));
+        }
+    }
+    BVH bvh;
+    bvh.Build(boxes);
+
+    // Cast rays, including ones exactly on box edges.
+    for(float x = 0.0f; x <= 100.0f; x += 2.5f)
+    {
+        for(float z = 0.0f; z <= 100.0f; z += 2.5f)
+        {
+            Ray ray(Vector3(x, 1000.0f, z), -Vector3::UnitY);
+            bool hit = false;
+            float nearestT = FLT_MAX;
+            bvh.Raycast(ray, nearestT, [&hit](uint32_t, float&){
+                hit = true;
+            });
+            REQUIRE(hit);
+        }
+    }
+
+    // Off the edge of the floor doesn't hit.
+    bool hit = false;
+    float nearestT = FLT_MAX;
+    bvh.Raycast(Ray(Vector3(-5.0f, 1000.0f, 50.0f), -Vector3::UnitY), nearestT, [&hit](uint32_t, float&){
+        hit = true;
+    });
+    REQUIRE(!hit);
+}
\ No newline at end of file
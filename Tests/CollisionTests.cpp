@@ -4,10 +4,17 @@
 // Tests for collision/intersection logic between geometric primitives.
 //
 #include "catch.hh"
+#include "AABB.h"
+#include "CollisionMesh.h"
 #include "Collisions.h"
+#include "Frustum.h"
+#include "Matrix4.h"
 #include "Sphere.h"
 #include "Triangle.h"
 
+#include <random>
+#include <vector>
+
 TEST_CASE("Sphere intersect triangle works")
 {
     // Create a sphere at the origin.
@@ -26,3 +33,73 @@ TEST_CASE("Sphere intersect triangle works")
     Sphere s2(Vector3::Zero + intersect, 10.0f);
     REQUIRE(!Intersect::TestSphereTriangle(s2, t, intersect));
 }
+
+
+TEST_CASE("Frustum intersect AABB works")
+{
+    // A frustum made from an identity matrix is just a cube from -1 to 1 on all axes.
+    Frustum frustum(Matrix4::Identity);
+
+    // Boxes inside, overlapping, or containing the frustum intersect it.
+    REQUIRE(Intersect::TestFrustumAABB(frustum, AABB(Vector3(-0.5f, -0.5f, -0.5f), Vector3(0.5f, 0.5f, 0.5f))));
+    REQUIRE(Intersect::TestFrustumAABB(frustum, AABB(Vector3(0.5f, 0.5f, 0.5f), Vector3(5.0f, 5.0f, 5.0f))));
+    REQUIRE(Intersect::TestFrustumAABB(frustum, AABB(Vector3(-10.0f, -10.0f, -10.0f), Vector3(10.0f, 10.0f, 10.0f))));
+
+    // Boxes entirely on the other side of any plane don't intersect.
+    REQUIRE(!Intersect::TestFrustumAABB(frustum, AABB(Vector3(2.0f, -0.5f, -0.5f), Vector3(3.0f, 0.5f, 0.5f))));
+    REQUIRE(!Intersect::TestFrustumAABB(frustum, AABB(Vector3(-0.5f, -3.0f, -0.5f), Vector3(0.5f, -1.5f, 0.5f))));
+    REQUIRE(!Intersect::TestFrustumAABB(frustum, AABB(Vector3(-0.5f, -0.5f, 1.01f), Vector3(0.5f, 0.5f, 2.0f))));
+}
+
+TEST_CASE("Collision mesh sphere cast matches testing every triangle")
+{
+    // A bunch of random triangles, and a bunch of random sphere moves through them.
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> posDist(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> offsetDist(-20.0f, 20.0f);
+    CollisionMesh mesh;
+    std::vector<Triangle> triangles;
+    for(int i = 0; i < 300; ++i)
+    {
+        Vector3 p0(posDist(rng), posDist(rng), posDist(rng));
+        Vector3 p1 = p0 + Vector3(offsetDist(rng), offsetDist(rng), offsetDist(rng));
+        Vector3 p2 = p0 + Vector3(offsetDist(rng), offsetDist(rng), offsetDist(rng));
+        mesh.AddTriangle(p0, p1, p2);
+        triangles.emplace_back(p0, p1, p2);
+    }
+    mesh.Build();
+
+    int hitCount = 0;
+    for(int i = 0; i < 500; ++i)
+    {
+        Sphere sphere(Vector3(posDist(rng), posDist(rng), posDist(rng)), 8.0f);
+        Vector3 moveOffset(offsetDist(rng), offsetDist(rng), offsetDist(rng));
+
+        // Brute force: every triangle, keeping the earliest valid collision.
+        float expectedT = 1.0f;
+        int expectedIndex = -1;
+        for(size_t j = 0; j < triangles.size(); ++j)
+        {
+            float t = 0.0f;
+            Vector3 normal;
+            Vector3 intersectPoint;
+            if(Collide::SphereTriangle(sphere, triangles[j], moveOffset, t, normal) &&
+               (t >= 0.0f || Intersect::TestSphereTriangle(sphere, triangles[j], intersectPoint)) &&
+               t < expectedT)
+            {
+                expectedT = t;
+                expectedIndex = static_cast<int>(j);
+            }
+        }
+
+        float t = 1.0f;
+        Vector3 normal;
+        int index = mesh.SphereCast(sphere, moveOffset, t, normal);
+        REQUIRE(index == expectedIndex);
+        REQUIRE(t == expectedT);
+        if(index >= 0) { ++hitCount; }
+    }
+
+    // Make sure the test actually exercised some collisions.
+    REQUIRE(hitCount > 0);
+}
\ No newline at end of file
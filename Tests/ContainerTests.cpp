@@ -5,6 +5,11 @@
 //
 #include "catch.hh"
 
+#include <thread>
+#include <vector>
+
+#include "ConcurrentQueue.h"
+#include "ConcurrentStringMap.h"
 #include "Queue.h"
 #include "ResizableQueue.h"
 #include "Stack.h"
@@ -185,4 +190,153 @@ TEST_CASE("Queue (resizable) works")
 TEST_CASE("Stack (fixed size) works")
 {
     Stack<TestObject, 10> stack;
+}
+
+TEST_CASE("ConcurrentStringMap works")
+{
+    ConcurrentStringMap<TestObject> map;
+    std::vector<TestObject> objects;
+    for(int i = 0; i < 200; ++i)
+    {
+        objects.emplace_back(i);
+    }
+
+    // Test missing keys.
+    REQUIRE(map.Get("Missing") == nullptr);
+    REQUIRE(map.Find("Missing") == nullptr);
+
+    // Test adding and case-insensitive lookup.
+    const ConcurrentStringMap<TestObject>::Entry* entry = map.Set("Object0", &objects[0]);
+    REQUIRE(entry != nullptr);
+    REQUIRE(entry->key == "OBJECT0");
+    REQUIRE(map.Get("object0") == &objects[0]);
+    REQUIRE(map.Find("OBJECT0") == entry);
+
+    // Test adding enough keys to force the table to grow. Entries should remain stable.
+    for(int i = 1; i < 200; ++i)
+    {
+        map.Set("Object" + std::to_string(i), &objects[i]);
+    }
+    REQUIRE(map.GetEntryCount() == 200);
+    REQUIRE(map.Find("Object0") == entry);
+    for(int i = 0; i < 200; ++i)
+    {
+        REQUIRE(map.Get("OBJECT" + std::to_string(i))->value == i);
+    }
+
+    // Test "removing" (setting null) and re-adding. The same entry should be reused.
+    map.Set("Object0", nullptr);
+    REQUIRE(map.Get("Object0") == nullptr);
+    REQUIRE(entry->value.load() == nullptr);
+    REQUIRE(map.Set("Object0", &objects[1]) == entry);
+    REQUIRE(entry->value.load() == &objects[1]);
+    REQUIRE(map.GetEntryCount() == 200);
+}
+
+TEST_CASE("ConcurrentStringMap can be read while written")
+{
+    ConcurrentStringMap<TestObject> map;
+    TestObject object(1);
+    map.Set("Reader", &object);
+
+    // Keep adding keys on another thread, forcing the table to grow several times.
+    std::thread writer([&map, &object]() {
+        for(int i = 0; i < 5000; ++i)
+        {
+            map.Set("Key" + std::to_string(i), &object);
+        }
+    });
+
+    // Meanwhile, the existing key should always be found.
+    bool alwaysFound = true;
+    for(int i = 0; i < 20000; ++i)
+    {
+        alwaysFound &= (map.Get("READER") == &object);
+    }
+    writer.join();
+    REQUIRE(alwaysFound);
+    REQUIRE(map.GetEntryCount() == 5001);
+}
+
+TEST_CASE("ConcurrentQueue works")
+{
+    ConcurrentQueue<int, 4> queue;
+    REQUIRE(queue.GetSize() == 0);
+
+    // Pop from empty queue fails.
+    int value = 0;
+    REQUIRE(!queue.Pop(value));
+
+    // Push until full.
+    for(int i = 0; i < 4; ++i)
+    {
+        REQUIRE(queue.Push(std::move(i)));
+    }
+    REQUIRE(queue.GetSize() == 4);
+    REQUIRE(!queue.Push(5));
+
+    // Values come out in the order they went in.
+    REQUIRE(queue.Pop(value));
+    REQUIRE(value == 0);
+    REQUIRE(queue.Pop(value));
+    REQUIRE(value == 1);
+
+    // Wrap around the end of the buffer.
+    REQUIRE(queue.Push(10));
+    REQUIRE(queue.Push(11));
+    REQUIRE(!queue.Push(12));
+    for(int expected : { 2, 3, 10, 11 })
+    {
+        REQUIRE(queue.Pop(value));
+        REQUIRE(value == expected);
+    }
+    REQUIRE(queue.GetSize() == 0);
+}
+
+TEST_CASE("ConcurrentQueue handles multiple producers")
+{
+    ConcurrentQueue<int, 64> queue;
+
+    // Several threads push increasing values, retrying when the queue is full.
+    const int kProducerCount = 4;
+    const int kValuesPerProducer = 5000;
+    std::vector<std::thread> producers;
+    for(int p = 0; p < kProducerCount; ++p)
+    {
+        producers.emplace_back([&queue, p]() {
+            for(int i = 0; i < kValuesPerProducer; ++i)
+            {
+                while(!queue.Push(p * kValuesPerProducer + i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Meanwhile, pop everything. Each producer's values should arrive in order, with none lost.
+    std::vector<int> nextValues;
+    for(int p = 0; p < kProducerCount; ++p)
+    {
+        nextValues.push_back(p * kValuesPerProducer);
+    }
+    bool inOrder = true;
+    int popCount = 0;
+    while(popCount < kProducerCount * kValuesPerProducer)
+    {
+        int value = 0;
+        if(queue.Pop(value))
+        {
+            int producer = value / kValuesPerProducer;
+            inOrder &= (value == nextValues[producer]);
+            ++nextValues[producer];
+            ++popCount;
+        }
+    }
+    for(auto& producer : producers)
+    {
+        producer.join();
+    }
+    REQUIRE(inOrder);
+    REQUIRE(queue.GetSize() == 0);
 }
\ No newline at end of file
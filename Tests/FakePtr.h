@@ -0,0 +1,14 @@
+//
+// Clark Kromenaker
+//
+// Helper for tests of code that stores and compares pointers, but never dereferences them (e.g. render queue, UI batcher).
+// Such tests can use made-up addresses instead of creating real objects, which may need a graphics API.
+//
+#pragma once
+#include <cstdint>
+
+template<typename T>
+T* FakePtr(uintptr_t value)
+{
+    return reinterpret_cast<T*>(value);
+}
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 #include "BinaryReader.h"
 #include "BinaryWriter.h"
+#include "mstream.h"
 
 TEST_CASE("Read/Write binary memory works")
 {
@@ -121,4 +122,118 @@ TEST_CASE("Read/Write binary memory works")
 
     reader.Skip(100);
     REQUIRE(reader.GetPosition() == 100);
+}
+
+TEST_CASE("Binary reader array reads work")
+{
+    float floatsIn[6] = { 1.0f, -2.5f, 3.25f, 100.0f, 0.0f, -0.125f };
+    uint8_t memory[64] = { 0 };
+    BinaryWriter writer(memory, 64);
+    for(float f : floatsIn)
+    {
+        writer.WriteFloat(f);
+    }
+    writer.WriteUShort(1);
+    writer.WriteUShort(2);
+    writer.WriteUShort(3);
+
+    // Read floats in bulk, both as plain floats and as vectors.
+    BinaryReader reader(memory, 64);
+    float floatsOut[6] = { 0.0f };
+    REQUIRE(reader.ReadArray(floatsOut, 6) == 6);
+    REQUIRE(memcmp(floatsIn, floatsOut, sizeof(floatsIn)) == 0);
+    REQUIRE(reader.GetPosition() == 24);
+
+    reader.Seek(0);
+    Vector3 vectors[2];
+    REQUIRE(reader.ReadVector3Array(vectors, 2) == 2);
+    REQUIRE(vectors[0] == Vector3(1.0f, -2.5f, 3.25f));
+    REQUIRE(vectors[1] == Vector3(100.0f, 0.0f, -0.125f));
+
+    Vector2 vector2s[1];
+    reader.Seek(8);
+    REQUIRE(reader.ReadVector2Array(vector2s, 1) == 1);
+    REQUIRE(vector2s[0] == Vector2(3.25f, 100.0f));
+
+    reader.Seek(24);
+    uint16_t shorts[3] = { 0 };
+    REQUIRE(reader.ReadArray(shorts, 3) == 3);
+    REQUIRE(shorts[0] == 1);
+    REQUIRE(shorts[1] == 2);
+    REQUIRE(shorts[2] == 3);
+    REQUIRE(reader.CanRead());
+}
+
+TEST_CASE("Binary reader from memory behaves like a stream at end of data")
+{
+    uint8_t memory[6] = { 1, 0, 0, 0, 2, 0 };
+    BinaryReader reader(memory, 6);
+
+    // Reading exactly up to the end is fine.
+    REQUIRE(reader.ReadUInt() == 1);
+    REQUIRE(reader.ReadUShort() == 2);
+    REQUIRE(reader.CanRead());
+    REQUIRE(!reader.EndOfFile());
+
+    // Reading past the end fails.
+    reader.ReadByte();
+    REQUIRE(!reader.CanRead());
+    REQUIRE(reader.EndOfFile());
+
+    // Seeking clears the failure.
+    reader.Seek(4);
+    REQUIRE(reader.CanRead());
+    REQUIRE(reader.GetPosition() == 4);
+
+    // A partial array read returns how many values were actually read.
+    uint16_t shorts[4] = { 0 };
+    REQUIRE(reader.ReadArray(shorts, 4) == 1);
+    REQUIRE(shorts[0] == 2);
+    REQUIRE(reader.EndOfFile());
+
+    // Seeking past the end clamps to the end. This doesn't fail - only the next read does.
+    reader.Seek(100);
+    REQUIRE(reader.GetPosition() == 6);
+    REQUIRE(reader.CanRead());
+    reader.ReadByte();
+    REQUIRE(!reader.CanRead());
+    REQUIRE(reader.EndOfFile());
+}
+
+TEST_CASE("Binary reader from memory matches a reader on an imstream when seeking or skipping past the end")
+{
+    uint8_t memory[6] = { 1, 0, 0, 0, 2, 0 };
+    BinaryReader memoryReader(memory, 6);
+    imstream stream(reinterpret_cast<const char*>(memory), 6);
+    BinaryReader streamReader(&stream);
+
+    auto requireSameState = [&memoryReader, &streamReader]() {
+        REQUIRE(memoryReader.CanRead() == streamReader.CanRead());
+        REQUIRE(memoryReader.EndOfFile() == streamReader.EndOfFile());
+        REQUIRE(memoryReader.GetPosition() == streamReader.GetPosition());
+    };
+
+    // Seek past the end, then read.
+    memoryReader.Seek(100);
+    streamReader.Seek(100);
+    requireSameState();
+    REQUIRE(memoryReader.ReadByte() == streamReader.ReadByte());
+    requireSameState();
+
+    // Seeking recovers from the failed read.
+    memoryReader.Seek(2);
+    streamReader.Seek(2);
+    requireSameState();
+
+    // Skip past the end, then read.
+    memoryReader.Skip(100);
+    streamReader.Skip(100);
+    requireSameState();
+    REQUIRE(memoryReader.ReadUShort() == streamReader.ReadUShort());
+    requireSameState();
+
+    // Skipping doesn't recover from a failed read.
+    memoryReader.Skip(1);
+    streamReader.Skip(1);
+    requireSameState();
 }
\ No newline at end of file
@@ -0,0 +1,208 @@
+//
+// Clark Kromenaker
+//
+// Tests for the job system.
+//
+#include "catch.hh"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "JobSystem.h"
+#include "ThreadUtil.h"
+
+TEST_CASE("JobFunction stores small and large callables")
+{
+    // A small lambda is stored inline.
+    int value = 0;
+    JobFunction small([&value]() { value += 1; });
+    REQUIRE(small);
+    small();
+    REQUIRE(value == 1);
+
+    // A large lambda needs a heap allocation, but should work just the same.
+    char bigData[256] = { 0 };
+    bigData[255] = 5;
+    JobFunction large([&value, bigData]() { value += bigData[255]; });
+    large();
+    REQUIRE(value == 6);
+
+    // Moving transfers the callable, and captured values are destroyed with the function.
+    std::shared_ptr<int> shared = std::make_shared<int>(10);
+    {
+        JobFunction first([shared, &value]() { value += *shared; });
+        REQUIRE(shared.use_count() == 2);
+        JobFunction second(std::move(first));
+        REQUIRE(!first);
+        second();
+        REQUIRE(value == 16);
+    }
+    REQUIRE(shared.use_count() == 1);
+
+    // Wrapping an empty callable results in an empty JobFunction.
+    JobFunction fromEmptyFunction(std::function<void()>{});
+    REQUIRE(!fromEmptyFunction);
+    void (*nullFunctionPointer)() = nullptr;
+    JobFunction fromNullPointer(nullFunctionPointer);
+    REQUIRE(!fromNullPointer);
+    JobFunction fromFunction(std::function<void()>([&value]() { ++value; }));
+    REQUIRE(fromFunction);
+}
+
+TEST_CASE("JobSystem runs and waits on jobs")
+{
+    JobSystem jobSystem(4);
+    REQUIRE(jobSystem.GetThreadCount() == 4);
+
+    // Add a bunch of jobs, some of which add more jobs (to their worker's own queue).
+    std::atomic<int> count(0);
+    JobCounter counter;
+    for(int i = 0; i < 100; ++i)
+    {
+        jobSystem.AddJob([&jobSystem, &count, &counter]() {
+            ++count;
+            jobSystem.AddJob([&count]() { ++count; }, &counter);
+        }, &counter);
+    }
+    jobSystem.Wait(counter);
+    REQUIRE(counter.IsDone());
+    REQUIRE(count == 200);
+}
+
+TEST_CASE("JobSystem runs dependent jobs after their dependencies")
+{
+    JobSystem jobSystem(2);
+
+    std::atomic<int> firstCount(0);
+    bool secondSawAllFirst = false;
+    JobCounter first;
+    JobCounter second;
+    for(int i = 0; i < 50; ++i)
+    {
+        jobSystem.AddJob([&firstCount]() { ++firstCount; }, &first);
+    }
+    jobSystem.AddJobAfter(first, [&firstCount, &secondSawAllFirst]() {
+        secondSawAllFirst = (firstCount == 50);
+    }, &second);
+
+    // Waiting on the second group must include the dependent job, even if it hasn't started yet.
+    jobSystem.Wait(second);
+    REQUIRE(secondSawAllFirst);
+}
+
+TEST_CASE("JobSystem waits only help with jobs in the waited-on group")
+{
+    JobSystem jobSystem(1);
+
+    // Keep the only worker busy until released.
+    std::atomic<bool> releaseWorker(false);
+    JobCounter blocker;
+    jobSystem.AddJob([&releaseWorker]() {
+        while(!releaseWorker) { std::this_thread::yield(); }
+    }, &blocker);
+
+    // An unrelated job is queued before the group being waited on.
+    std::atomic<bool> unrelatedRan(false);
+    JobCounter unrelated;
+    jobSystem.AddJob([&unrelatedRan]() { unrelatedRan = true; }, &unrelated);
+
+    // Waiting on the group runs the group's jobs on this thread, but leaves the unrelated job alone.
+    int groupCount = 0;
+    JobCounter group;
+    for(int i = 0; i < 10; ++i)
+    {
+        jobSystem.AddJob([&groupCount]() { ++groupCount; }, &group);
+    }
+    jobSystem.Wait(group);
+    REQUIRE(groupCount == 10);
+    REQUIRE(!unrelatedRan);
+
+    // Once the worker is free, waiting on a group whose jobs are all running elsewhere sleeps until they finish.
+    releaseWorker = true;
+    jobSystem.Wait(blocker);
+    jobSystem.Wait(unrelated);
+    REQUIRE(unrelatedRan);
+}
+
+TEST_CASE("JobSystem parallel-for visits each index once")
+{
+    JobSystem jobSystem(3);
+    std::vector<int> visits(1000, 0);
+    jobSystem.ParallelFor(0, visits.size(), 16, [&visits](size_t index) {
+        ++visits[index];
+    });
+    for(int visitCount : visits)
+    {
+        REQUIRE(visitCount == 1);
+    }
+
+    // With no worker threads, jobs just run on the calling thread.
+    JobSystem noThreads;
+    int sum = 0;
+    noThreads.ParallelFor(0, 10, 3, [&sum](size_t index) { sum += static_cast<int>(index); });
+    REQUIRE(sum == 45);
+}
+
+TEST_CASE("JobSystem shutdown runs jobs that are still queued")
+{
+    JobSystem jobSystem(1);
+
+    // Keep the only worker busy, so jobs pile up in the queue.
+    std::atomic<bool> releaseWorker(false);
+    jobSystem.AddJob([&releaseWorker]() {
+        while(!releaseWorker) { std::this_thread::yield(); }
+    });
+    std::atomic<int> count(0);
+    JobCounter group;
+    for(int i = 0; i < 20; ++i)
+    {
+        jobSystem.AddJob([&count]() { ++count; }, &group);
+    }
+
+    // Shut down while the jobs are still queued. They must all still run, or anyone waiting on the group would wait forever.
+    std::thread shutdownThread([&jobSystem]() { jobSystem.Shutdown(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    releaseWorker = true;
+    shutdownThread.join();
+    jobSystem.Wait(group);
+    REQUIRE(count == 20);
+
+    // Jobs added after shutdown are run right away.
+    jobSystem.AddJob([&count]() { ++count; }, &group);
+    REQUIRE(count == 21);
+    jobSystem.Wait(group);
+}
+
+TEST_CASE("High priority main thread functions aren't time-sliced")
+{
+    // This thread acts as the main thread.
+    ThreadUtil::Init();
+
+    // Queue some slow functions, then a high priority function, from another thread.
+    int normalRunCount = 0;
+    bool highPriorityRan = false;
+    std::thread queueThread([&normalRunCount, &highPriorityRan]() {
+        for(int i = 0; i < 5; ++i)
+        {
+            ThreadUtil::RunOnMainThread([&normalRunCount]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                ++normalRunCount;
+            });
+        }
+        ThreadUtil::RunOnMainThread([&highPriorityRan]() { highPriorityRan = true; }, ThreadUtil::Priority::High);
+    });
+    queueThread.join();
+
+    // With a tiny time limit, only one normal function runs. But the high priority function runs anyway, even though it was queued last.
+    ThreadUtil::RunFunctionsOnMainThread(0.001f);
+    REQUIRE(highPriorityRan);
+    REQUIRE(normalRunCount == 1);
+
+    // The rest run later.
+    ThreadUtil::RunFunctionsOnMainThread();
+    REQUIRE(normalRunCount == 5);
+}
\ No newline at end of file
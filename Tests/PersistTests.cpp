@@ -0,0 +1,124 @@
+//
+// Clark Kromenaker
+//
+// Tests for saving and loading game state that's stored by symbol (FlagSet and CountTable).
+//
+#include "catch.hh"
+#include "PersistState.h"
+
+#include <cstdio>
+
+#include "CountTable.h"
+#include "FlagSet.h"
+#include "SymbolTable.h"
+
+namespace
+{
+    const char* kSavePath = "PersistTests.sav";
+
+    // Saves an object with the given save version, then loads it into another object.
+    template<typename T>
+    void SaveAndLoad(T& saveObj, T& loadObj, int saveVersion)
+    {
+        {
+            PersistState ps(kSavePath, PersistFormat::Binary, PersistMode::Save);
+            ps.SetFormatVersionNumber(saveVersion);
+            saveObj.OnPersist(ps);
+        }
+        {
+            PersistState ps(kSavePath, PersistFormat::Binary, PersistMode::Load);
+            ps.SetFormatVersionNumber(saveVersion);
+            loadObj.OnPersist(ps);
+        }
+        std::remove(kSavePath);
+    }
+}
+
+TEST_CASE("Flag sets save and load flags by name")
+{
+    FlagSet saved;
+    saved.Set("PersistFlagA");
+    saved.Set("PersistFlagB");
+    saved.Set("PersistFlagC");
+    saved.Clear("PersistFlagB");
+
+    // Pre-existing flags in the loaded set are replaced.
+    FlagSet loaded;
+    loaded.Set("PersistFlagD");
+    SaveAndLoad(saved, loaded, 5);
+
+    REQUIRE(loaded.Get("PersistFlagA"));
+    REQUIRE(!loaded.Get("PersistFlagB"));
+    REQUIRE(loaded.Get(gSymbols.Find("persistflagc")));
+    REQUIRE(!loaded.Get("PersistFlagD"));
+    REQUIRE(loaded.GetFlags() == saved.GetFlags());
+}
+
+TEST_CASE("Count tables save and load counts by name")
+{
+    int gabriel = gSymbols.Intern("Gabriel");
+    int grace = gSymbols.Intern("Grace");
+    int noun = gSymbols.Intern("PERSIST_NOUN");
+    int look = gSymbols.Intern("LOOK");
+    int pickup = gSymbols.Intern("PICKUP");
+
+    CountTable saved;
+    saved.Increment(gabriel, noun, look);
+    saved.Increment(gabriel, noun, look);
+    saved.Set(grace, noun, pickup, 5);
+
+    // Invalid symbols are ignored.
+    saved.Increment(kInvalidSymbol, noun, look);
+    REQUIRE(saved.Get(kInvalidSymbol, noun, look) == 0);
+
+    CountTable loaded;
+    SaveAndLoad(saved, loaded, 5);
+    REQUIRE(loaded.Get(gabriel, noun, look) == 2);
+    REQUIRE(loaded.Get(grace, noun, pickup) == 5);
+    REQUIRE(loaded.Get(grace, noun, look) == 0);
+    REQUIRE(loaded.Get("gabriel", "persist_noun", "look") == 2);
+}
+
+TEST_CASE("Count tables load counts from older save files")
+{
+    // Older save files key counts by concatenated names. Some of these names are never interned.
+    {
+        PersistState ps(kSavePath, PersistFormat::Binary, PersistMode::Save);
+        ps.SetFormatVersionNumber(4);
+        std::string_map_ci<int> namedCounts;
+        namedCounts["GabrielLEGACY_NOUNLOOK"] = 3;
+        namedCounts["GraceLEGACY_NOUNLOOK"] = 1;
+        namedCounts["GabrielLEGACY_UNKNOWN_NOUNLEGACY_UNKNOWN_VERB"] = 7;
+        ps.Xfer("mCounts", namedCounts);
+    }
+    CountTable loaded;
+    {
+        PersistState ps(kSavePath, PersistFormat::Binary, PersistMode::Load);
+        ps.SetFormatVersionNumber(4);
+        loaded.OnPersist(ps);
+    }
+    std::remove(kSavePath);
+
+    // Counts can be found by symbol or by name, even if the names were never interned.
+    int gabriel = gSymbols.Intern("Gabriel");
+    int grace = gSymbols.Intern("Grace");
+    int noun = gSymbols.Intern("LEGACY_NOUN");
+    int look = gSymbols.Intern("LOOK");
+    REQUIRE(loaded.Get(gabriel, noun, look) == 3);
+    REQUIRE(loaded.Get(grace, noun, look) == 1);
+    REQUIRE(loaded.Get("Gabriel", "LEGACY_UNKNOWN_NOUN", "LEGACY_UNKNOWN_VERB") == 7);
+    REQUIRE(gSymbols.Find("LEGACY_UNKNOWN_NOUN") == kInvalidSymbol);
+
+    // Changing a count continues from the loaded value.
+    loaded.Increment(gabriel, noun, look);
+    REQUIRE(loaded.Get(gabriel, noun, look) == 4);
+    loaded.Set(grace, noun, look, 0);
+    REQUIRE(loaded.Get(grace, noun, look) == 0);
+
+    // Saving in the newer format keeps every count, including those still only known by concatenated name.
+    CountTable reloaded;
+    SaveAndLoad(loaded, reloaded, 5);
+    REQUIRE(reloaded.Get(gabriel, noun, look) == 4);
+    REQUIRE(reloaded.Get(grace, noun, look) == 0);
+    REQUIRE(reloaded.Get("Gabriel", "LEGACY_UNKNOWN_NOUN", "LEGACY_UNKNOWN_VERB") == 7);
+}
\ No newline at end of file
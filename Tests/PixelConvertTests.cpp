@@ -0,0 +1,110 @@
+//
+// Clark Kromenaker
+//
+// Tests for PixelConvert functions.
+//
+#include "catch.hh"
+#include "PixelConvert.h"
+
+#include <vector>
+
+TEST_CASE("RGB565 conversion matches per-pixel conversion")
+{
+    // Every possible 565 value, so all SIMD lanes and the scalar remainder see every channel value.
+    // An odd count makes sure the leftover pixels are handled too.
+    const uint32_t pixelCount = 65536 + 5;
+    std::vector<uint16_t> src(pixelCount);
+    for(uint32_t i = 0; i < pixelCount; ++i)
+    {
+        src[i] = static_cast<uint16_t>(i);
+    }
+
+    std::vector<uint8_t> dst(pixelCount * 3);
+    PixelConvert::RGB565ToRGB(src.data(), dst.data(), pixelCount);
+
+    // Compare against the original float conversion used when loading GK3 compressed textures.
+    bool allMatch = true;
+    for(uint32_t i = 0; i < pixelCount && allMatch; ++i)
+    {
+        float red = static_cast<float>((src[i] & 0xF800) >> 11);
+        float green = static_cast<float>((src[i] & 0x07E0) >> 5);
+        float blue = static_cast<float>((src[i] & 0x001F));
+        allMatch = dst[i * 3] == (unsigned char)(red * 255 / 31) &&
+                   dst[i * 3 + 1] == (unsigned char)(green * 255 / 63) &&
+                   dst[i * 3 + 2] == (unsigned char)(blue * 255 / 31);
+    }
+    REQUIRE(allMatch);
+
+    // White and black are exact.
+    uint16_t extremes[2] = { 0xFFFF, 0x0000 };
+    uint8_t extremesRGB[6];
+    PixelConvert::RGB565ToRGB(extremes, extremesRGB, 2);
+    REQUIRE(extremesRGB[0] == 255);
+    REQUIRE(extremesRGB[1] == 255);
+    REQUIRE(extremesRGB[2] == 255);
+    REQUIRE(extremesRGB[3] == 0);
+    REQUIRE(extremesRGB[4] == 0);
+    REQUIRE(extremesRGB[5] == 0);
+}
+
+TEST_CASE("Palette conversion copies palette colors")
+{
+    // Palette is 4 bytes per color, with an unused fourth byte.
+    std::vector<uint8_t> palette(256 * 4);
+    for(int i = 0; i < 256; ++i)
+    {
+        palette[i * 4] = static_cast<uint8_t>(i);
+        palette[i * 4 + 1] = static_cast<uint8_t>(255 - i);
+        palette[i * 4 + 2] = static_cast<uint8_t>(i * 3);
+        palette[i * 4 + 3] = 99;
+    }
+
+    std::vector<uint8_t> indexes = { 0, 255, 17, 17, 200, 3, 128 };
+    std::vector<uint8_t> dst(indexes.size() * 3);
+    PixelConvert::PaletteToRGB(indexes.data(), palette.data(), dst.data(), static_cast<uint32_t>(indexes.size()));
+    for(size_t i = 0; i < indexes.size(); ++i)
+    {
+        REQUIRE(dst[i * 3] == palette[indexes[i] * 4]);
+        REQUIRE(dst[i * 3 + 1] == palette[indexes[i] * 4 + 1]);
+        REQUIRE(dst[i * 3 + 2] == palette[indexes[i] * 4 + 2]);
+    }
+}
+
+TEST_CASE("Color key and alpha are applied to 32-bit pixels")
+{
+    // Enough pixels for a full SIMD batch plus a few leftovers. Every third pixel is magenta.
+    const uint32_t pixelCount = 37;
+    std::vector<uint8_t> pixels(pixelCount * 4);
+    for(uint32_t i = 0; i < pixelCount; ++i)
+    {
+        bool isMagenta = (i % 3) == 0;
+        pixels[i * 4] = isMagenta ? 255 : static_cast<uint8_t>(i);
+        pixels[i * 4 + 1] = 0;
+        pixels[i * 4 + 2] = 255;
+        pixels[i * 4 + 3] = 128;
+    }
+
+    PixelConvert::ApplyColorKey(pixels.data(), pixelCount, 255, 0, 255);
+    for(uint32_t i = 0; i < pixelCount; ++i)
+    {
+        bool isMagenta = (i % 3) == 0;
+        REQUIRE(pixels[i * 4] == (isMagenta ? 255 : i));
+        REQUIRE(pixels[i * 4 + 3] == (isMagenta ? 0 : 255));
+    }
+
+    // Applying alpha only changes the alpha byte.
+    std::vector<uint8_t> alpha(pixelCount);
+    for(uint32_t i = 0; i < pixelCount; ++i)
+    {
+        alpha[i] = static_cast<uint8_t>(i * 7);
+    }
+    PixelConvert::ApplyAlpha(alpha.data(), pixels.data(), pixelCount);
+    for(uint32_t i = 0; i < pixelCount; ++i)
+    {
+        bool isMagenta = (i % 3) == 0;
+        REQUIRE(pixels[i * 4] == (isMagenta ? 255 : i));
+        REQUIRE(pixels[i * 4 + 1] == 0);
+        REQUIRE(pixels[i * 4 + 2] == 255);
+        REQUIRE(pixels[i * 4 + 3] == alpha[i]);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+//
+// Clark Kromenaker
+//
+// Tests for RenderQueue class.
+//
+#include "catch.hh"
+#include "RenderQueue.h"
+
+#include <vector>
+
+#include "FakePtr.h"
+
+namespace
+{
+    // Submits a pass and returns the submeshes in the order they were submitted.
+    std::vector<Submesh*> SubmitPass(RenderQueue& queue, RenderQueue::Pass pass)
+    {
+        std::vector<Submesh*> submitted;
+        queue.Submit(pass, [&submitted](const RenderQueue::Item& item, const RenderQueue::StateChanges&){
+            submitted.push_back(item.submesh);
+        });
+        return submitted;
+    }
+}
+
+TEST_CASE("Render queue groups opaque items by shader and texture")
+{
+    Shader* shaderA = FakePtr<Shader>(0x10);
+    Shader* shaderB = FakePtr<Shader>(0x20);
+    Texture* texA = FakePtr<Texture>(0x100);
+    Texture* texB = FakePtr<Texture>(0x200);
+
+    // Add items with alternating shaders and textures - worst case for state changes if drawn in this order.
+    RenderQueue queue;
+    for(int i = 0; i < 8; ++i)
+    {
+        Shader* shader = (i % 2 == 0) ? shaderA : shaderB;
+        Texture* texture = (i % 4 < 2) ? texA : texB;
+        queue.Add(RenderQueue::Pass::Opaque, shader, texture, FakePtr<Material>(0x1000 + i), FakePtr<Submesh>(1 + i), Matrix4::Identity, 10.0f);
+    }
+    queue.Sort();
+    REQUIRE(queue.GetItemCount() == 8);
+
+    Shader* prevShader = nullptr;
+    std::vector<Shader*> shaderOrder;
+    queue.Submit(RenderQueue::Pass::Opaque, [&prevShader, &shaderOrder](const RenderQueue::Item& item, const RenderQueue::StateChanges& changes){
+        REQUIRE(changes.shader == (item.shader != prevShader));
+        if(changes.shader)
+        {
+            shaderOrder.push_back(item.shader);
+        }
+        prevShader = item.shader;
+    });
+
+    // Each shader is only activated once, and each texture only once per shader.
+    REQUIRE(shaderOrder.size() == 2);
+    const RenderQueue::Stats& stats = queue.GetStats();
+    REQUIRE(stats.drawCount == 8);
+    REQUIRE(stats.shaderChanges == 2);
+    REQUIRE(stats.textureChanges == 4);
+    REQUIRE(stats.materialChanges == 8);
+
+    // All items share a matrix, so it only needs setting when the shader changes.
+    REQUIRE(stats.matrixChanges == 2);
+}
+
+TEST_CASE("Render queue skips redundant material and matrix changes")
+{
+    Shader* shader = FakePtr<Shader>(0x10);
+    Texture* texture = FakePtr<Texture>(0x100);
+    Material* material = FakePtr<Material>(0x1000);
+
+    // Several submeshes of one mesh, all using the same material.
+    RenderQueue queue;
+    for(int i = 0; i < 5; ++i)
+    {
+        queue.Add(RenderQueue::Pass::Opaque, shader, texture, material, FakePtr<Submesh>(1 + i), Matrix4::Identity, 5.0f);
+    }
+    queue.Sort();
+
+    // Equal keys keep the order they were added in.
+    std::vector<Submesh*> submitted = SubmitPass(queue, RenderQueue::Pass::Opaque);
+    REQUIRE(submitted.size() == 5);
+    for(int i = 0; i < 5; ++i)
+    {
+        REQUIRE(submitted[i] == FakePtr<Submesh>(1 + i));
+    }
+
+    const RenderQueue::Stats& stats = queue.GetStats();
+    REQUIRE(stats.drawCount == 5);
+    REQUIRE(stats.shaderChanges == 1);
+    REQUIRE(stats.textureChanges == 1);
+    REQUIRE(stats.materialChanges == 1);
+    REQUIRE(stats.matrixChanges == 1);
+}
+
+TEST_CASE("Render queue sorts by depth within a pass")
+{
+    Shader* shader = FakePtr<Shader>(0x10);
+    Texture* texture = FakePtr<Texture>(0x100);
+    Material* material = FakePtr<Material>(0x1000);
+
+    RenderQueue queue;
+    float depths[] = { 50.0f, 10.0f, 0.0f, 1000.0f, 25.0f };
+    for(int i = 0; i < 5; ++i)
+    {
+        queue.Add(RenderQueue::Pass::Opaque, shader, texture, material, FakePtr<Submesh>(1 + i), Matrix4::Identity, depths[i]);
+        queue.Add(RenderQueue::Pass::Translucent, shader, texture, material, FakePtr<Submesh>(100 + i), Matrix4::Identity, depths[i]);
+    }
+    queue.Sort();
+
+    // Opaque is front-to-back.
+    std::vector<Submesh*> opaque = SubmitPass(queue, RenderQueue::Pass::Opaque);
+    std::vector<Submesh*> expectedOpaque = { FakePtr<Submesh>(3), FakePtr<Submesh>(2), FakePtr<Submesh>(5), FakePtr<Submesh>(1), FakePtr<Submesh>(4) };
+    REQUIRE(opaque == expectedOpaque);
+
+    // Translucent is back-to-front.
+    std::vector<Submesh*> translucent = SubmitPass(queue, RenderQueue::Pass::Translucent);
+    std::vector<Submesh*> expectedTranslucent = { FakePtr<Submesh>(103), FakePtr<Submesh>(100), FakePtr<Submesh>(104), FakePtr<Submesh>(101), FakePtr<Submesh>(102) };
+    REQUIRE(translucent == expectedTranslucent);
+
+    // Counters accumulate across passes, but state tracking restarts for each pass.
+    REQUIRE(queue.GetStats().drawCount == 10);
+    REQUIRE(queue.GetStats().shaderChanges == 2);
+
+    // Clearing resets everything.
+    queue.Clear();
+    REQUIRE(queue.GetItemCount() == 0);
+    REQUIRE(queue.GetStats().drawCount == 0);
+    REQUIRE(SubmitPass(queue, RenderQueue::Pass::Opaque).empty());
+}
\ No newline at end of file
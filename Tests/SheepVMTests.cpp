@@ -0,0 +1,346 @@
+//
+// Clark Kromenaker
+//
+// Tests for SheepVM, comparing decoded op execution with the bytecode interpreter.
+//
+#include "catch.hh"
+#include "SheepManager.h"
+
+#include <algorithm>
+
+// SysFunc registration uses "string" as a type name.
+using namespace std;
+
+namespace
+{
+    // Each SysFunc call made by a test script is recorded here, in order.
+    std::vector<std::string> sRecorded;
+
+    shpvoid TestRecordI(int value)
+    {
+        sRecorded.push_back("I:" + std::to_string(value));
+        return 0;
+    }
+    RegFunc1(TestRecordI, void, int, IMMEDIATE, DEV_FUNC);
+
+    shpvoid TestRecordF(float value)
+    {
+        sRecorded.push_back("F:" + std::to_string(value));
+        return 0;
+    }
+    RegFunc1(TestRecordF, void, float, IMMEDIATE, DEV_FUNC);
+
+    shpvoid TestRecordS(const std::string& value)
+    {
+        sRecorded.push_back("S:" + value);
+        return 0;
+    }
+    RegFunc1(TestRecordS, void, string, IMMEDIATE, DEV_FUNC);
+
+    shpvoid TestRecordSS(const std::string& value1, const std::string& value2)
+    {
+        sRecorded.push_back("SS:" + value1 + "," + value2);
+        return 0;
+    }
+    RegFunc2(TestRecordSS, void, string, string, IMMEDIATE, DEV_FUNC);
+
+    shpvoid TestRecordSym(symbol value)
+    {
+        sRecorded.push_back("Sym:" + std::string(value.name) + (value.symbol >= 0 ? "=" + std::to_string(value.symbol) : ""));
+        return 0;
+    }
+    RegFunc1(TestRecordSym, void, symbol, IMMEDIATE, DEV_FUNC);
+
+    std::string TestEchoS(const std::string& value)
+    {
+        return value + "!";
+    }
+    RegFunc1(TestEchoS, string, string, IMMEDIATE, DEV_FUNC);
+
+    float TestHalfF(float value)
+    {
+        return value * 0.5f;
+    }
+    RegFunc1(TestHalfF, float, float, IMMEDIATE, DEV_FUNC);
+
+    std::vector<std::string> Run(SheepScript* script, bool interpretBytecode)
+    {
+        sRecorded.clear();
+        gSheepManager.SetInterpretBytecode(interpretBytecode);
+
+        bool finished = false;
+        gSheepManager.Execute(script, "Main$", [&finished](){ finished = true; }, "Test");
+        gSheepManager.SetInterpretBytecode(false);
+
+        // None of the test scripts wait, so they always finish right away.
+        REQUIRE(finished);
+        return sRecorded;
+    }
+
+    bool HasOp(SheepScript* script, SheepOpCode code)
+    {
+        const std::vector<SheepOp>& ops = script->GetOps();
+        return std::any_of(ops.begin(), ops.end(), [code](const SheepOp& op) { return op.code == code; });
+    }
+
+    // Runs the script with decoded ops, then with the bytecode interpreter, and checks both give the expected calls.
+    void RequireSameExecution(SheepScript* script, const std::vector<std::string>& expected)
+    {
+        REQUIRE(script != nullptr);
+        REQUIRE(!script->GetOps().empty());
+
+        std::vector<std::string> decoded = Run(script, false);
+        std::vector<std::string> bytecode = Run(script, true);
+        REQUIRE(decoded == expected);
+        REQUIRE(bytecode == expected);
+    }
+}
+
+TEST_CASE("Sheep decoded ops match bytecode for int branches and loops")
+{
+    SheepScript* script = gSheepManager.Compile("TestBranches", R"(
+        symbols
+        {
+            int i$ = 0;
+            int total$ = 0;
+        }
+        code
+        {
+            Main$()
+            {
+                i$ = 0;
+                total$ = 0;
+            loop$:
+                if(i$ == 2)
+                {
+                    TestRecordS("two");
+                }
+                else if(i$ == 4 || i$ > 6)
+                {
+                    TestRecordS("four or more than six");
+                }
+                else
+                {
+                    TestRecordI(i$);
+                }
+                if(i$)
+                {
+                    total$ = total$ + i$ * 3 - 1;
+                }
+                i$ = i$ + 1;
+                if(i$ < 8 && !(i$ >= 8))
+                {
+                    goto loop$;
+                }
+                TestRecordI(total$);
+                TestRecordI(i$ == 8);
+                TestRecordI(0 - i$ / 3);
+                TestRecordI(i$ != 8);
+                TestRecordI(i$ <= 7);
+            }
+        }
+    )");
+
+    // The script should exercise the fused compare-and-branch ops.
+    REQUIRE(script != nullptr);
+    REQUIRE(HasOp(script, SheepOpCode::StoreConstI));
+    REQUIRE(HasOp(script, SheepOpCode::BranchIfNotEqualVarI));
+    REQUIRE(HasOp(script, SheepOpCode::BranchIfZeroVarI));
+    REQUIRE(HasOp(script, SheepOpCode::IsEqualVarI));
+
+    RequireSameExecution(script, {
+        "I:0", "I:1", "S:two", "I:3", "S:four or more than six", "I:5", "I:6", "S:four or more than six",
+        "I:77", "I:1", "I:-2", "I:0", "I:0"
+    });
+    delete script;
+}
+
+TEST_CASE("Sheep decoded ops match bytecode for float math")
+{
+    SheepScript* script = gSheepManager.Compile("TestFloats", R"(
+        symbols
+        {
+            float f$ = 1.5;
+            float g$ = 0.0;
+        }
+        code
+        {
+            Main$()
+            {
+                f$ = f$ * 2.0 + 3.0;
+                TestRecordF(f$);
+                TestRecordF(TestHalfF(f$) - 0.25);
+                g$ = 0.0 - f$ / 4.0;
+                TestRecordF(g$);
+                if(f$ > 5.5)
+                {
+                    if(f$ == 6.0)
+                    {
+                        TestRecordS("six");
+                    }
+                }
+                if(g$ >= 0.0)
+                {
+                    TestRecordS("wrong");
+                }
+                else if(f$ != 6.0)
+                {
+                    TestRecordS("wrong");
+                }
+                else if(g$ <= -1.5)
+                {
+                    TestRecordS("negative");
+                }
+            }
+        }
+    )");
+
+    RequireSameExecution(script, {
+        "F:6.000000", "F:2.750000", "F:-1.500000", "S:six", "S:negative"
+    });
+    delete script;
+}
+
+TEST_CASE("Sheep decoded ops match bytecode for strings")
+{
+    SheepScript* script = gSheepManager.Compile("TestStrings", R"(
+        symbols
+        {
+            string s$;
+            string t$;
+            int i$ = 0;
+        }
+        code
+        {
+            Main$()
+            {
+                s$ = "start";
+                TestRecordS(s$);
+                s$ = "changed";
+                TestRecordS(s$);
+                s$ = TestEchoS(s$);
+                TestRecordS(s$);
+                t$ = TestEchoS("a");
+                TestRecordSS(t$, s$);
+                TestRecordSS("const", s$);
+                if(i$ == 0)
+                {
+                    TestRecordS(TestEchoS(TestEchoS("nested")));
+                }
+            }
+        }
+    )");
+
+    REQUIRE(script != nullptr);
+    REQUIRE(HasOp(script, SheepOpCode::PushString));
+
+    RequireSameExecution(script, {
+        "S:start", "S:changed", "S:changed!", "SS:a!,changed!", "SS:const,changed!", "S:nested!!"
+    });
+    delete script;
+}
+
+TEST_CASE("Sheep interns only string constants passed as symbol args")
+{
+    SheepScript* script = gSheepManager.Compile("TestSymbolInterning", R"(
+        symbols
+        {
+            int i$ = 0;
+        }
+        code
+        {
+            Main$()
+            {
+                TestRecordS("TestNotInternedString");
+                TestRecordI(i$ + 2);
+                if(i$ == 0)
+                {
+                    TestRecordSym("TestInternedSymbolArg");
+                }
+            }
+        }
+    )");
+    REQUIRE(script != nullptr);
+
+    // Interned when the script is decoded, before it ever runs.
+    int symbol = gSymbols.Find("TestInternedSymbolArg");
+    REQUIRE(symbol != kInvalidSymbol);
+    REQUIRE(gSymbols.Find("TestNotInternedString") == kInvalidSymbol);
+
+    RequireSameExecution(script, {
+        "S:TestNotInternedString", "I:2", "Sym:TestInternedSymbolArg=" + std::to_string(symbol)
+    });
+    REQUIRE(gSymbols.Find("TestNotInternedString") == kInvalidSymbol);
+    delete script;
+}
+
+TEST_CASE("Sheep releases SysFunc string results once no longer referenced")
+{
+    SheepScript* script = gSheepManager.Compile("TestStringRelease", R"(
+        symbols
+        {
+            string s$ = "x";
+            int i$ = 0;
+        }
+        code
+        {
+            Main$()
+            {
+                s$ = "x";
+                i$ = 0;
+            loop$:
+                s$ = TestEchoS(s$);
+                i$ = i$ + 1;
+                if(i$ < 20)
+                {
+                    goto loop$;
+                }
+                TestRecordS(s$);
+            }
+        }
+    )");
+    REQUIRE(script != nullptr);
+
+    // Each loop iteration creates a new string result, but only the last one is still stored in a variable when the thread exits.
+    for(bool interpretBytecode : { false, true })
+    {
+        size_t stringCountBefore = gSheepManager.GetSysFuncStringCount();
+        std::vector<std::string> recorded = Run(script, interpretBytecode);
+        REQUIRE(recorded == std::vector<std::string>{ "S:x" + std::string(20, '!') });
+        REQUIRE(gSheepManager.GetSysFuncStringCount() <= stringCountBefore + 1);
+    }
+    delete script;
+}
+
+TEST_CASE("Sheep symbol args convert ints and floats to strings")
+{
+    // The compiler doesn't allow passing numbers for string args, but compiled scripts may still do it.
+    // So, call the SysFunc's generic function with the same args the VM would pass.
+
+    // Converted names are looked up like any other string, so they only have a symbol if they were interned.
+    int nameSymbol = gSymbols.Intern("TestSymbolArgName");
+    int intSymbol = gSymbols.Intern("12");
+    SheepValue name("TestSymbolArgName");
+    SheepValue args[] = { name, SheepValue(12), SheepValue(2.5f), SheepValue(34) };
+
+    sRecorded.clear();
+    SysFuncResult result;
+    for(const SheepValue& arg : args)
+    {
+        TestRecordSym(&arg, result);
+    }
+    REQUIRE(sRecorded == std::vector<std::string>{
+        "Sym:TestSymbolArgName=" + std::to_string(nameSymbol),
+        "Sym:12=" + std::to_string(intSymbol),
+        "Sym:" + std::to_string(2.5f),
+        "Sym:34"
+    });
+
+    // A copied arg points to its own converted name.
+    SymbolArg converted = GetSysFuncArg<SymbolArg>(SheepValue(56));
+    SymbolArg copy = converted;
+    converted = GetSysFuncArg<SymbolArg>(SheepValue(78));
+    REQUIRE(std::string(copy.name) == "56");
+    REQUIRE(copy.name == copy.convertedName.c_str());
+    REQUIRE(std::string(converted.name) == "78");
+}
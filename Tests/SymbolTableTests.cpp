@@ -0,0 +1,39 @@
+//
+// Clark Kromenaker
+//
+// Tests for SymbolTable class.
+//
+#include "catch.hh"
+#include "SymbolTable.h"
+
+TEST_CASE("SymbolTable interns names as dense symbols")
+{
+    SymbolTable symbols;
+    REQUIRE(symbols.GetCount() == 0);
+
+    // Each new name gets the next symbol.
+    REQUIRE(symbols.Intern("Gabriel") == 0);
+    REQUIRE(symbols.Intern("Grace") == 1);
+    REQUIRE(symbols.GetCount() == 2);
+
+    // Interning an existing name returns the same symbol - regardless of case.
+    REQUIRE(symbols.Intern("Gabriel") == 0);
+    REQUIRE(symbols.Intern("GRACE") == 1);
+    REQUIRE(symbols.GetCount() == 2);
+
+    // Names are stored as they were first interned.
+    REQUIRE(symbols.GetName(0) == "Gabriel");
+    REQUIRE(symbols.GetName(1) == "Grace");
+    REQUIRE(symbols.GetName(2).empty());
+    REQUIRE(symbols.GetName(kInvalidSymbol).empty());
+}
+
+TEST_CASE("SymbolTable find doesn't intern")
+{
+    SymbolTable symbols;
+    symbols.Intern("Z_CHAT");
+
+    REQUIRE(symbols.Find("z_chat") == 0);
+    REQUIRE(symbols.Find("T_HANDSHAKE_A") == kInvalidSymbol);
+    REQUIRE(symbols.GetCount() == 1);
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+//
+// Clark Kromenaker
+//
+// Stand-ins for engine systems that tested sources reference, but that the test executable doesn't include.
+// For example, ReportStream can log to the console, and SheepVM can save threads that reference script assets.
+// None of these are expected to be used by the tests - they just need to exist so the tests can link.
+//
+#include "AssetManager.h"
+#include "Console.h"
+#include "Debug.h"
+#include "GameProgress.h"
+#include "GEngine.h"
+#include "LayerManager.h"
+#include "LocationManager.h"
+#include "Material.h"
+#include "Mesh.h"
+#include "OSDialog.h"
+#include "PNGCodec.h"
+#include "Transform.h"
+#include "UIWidget.h"
+
+// Assets
+AssetManager gAssetManager;
+
+bool AssetManager::LoadAssetData(const std::string& assetName, AssetData& outAssetData) const
+{
+    return false;
+}
+
+bool AssetNameResolver::HasValidExtension(const std::string& assetName) const
+{
+    return true;
+}
+
+const std::vector<std::string>& AssetNameResolver::GetTypeExtensions(TypeId typeId, const std::string& assetCacheId)
+{
+    static const std::vector<std::string> kNoExtensions;
+    return kNoExtensions;
+}
+
+// Debug
+Console gConsole;
+
+void Console::AddToScrollback(const std::string& str)
+{
+
+}
+
+void Debug::DrawRectXZ(const Rect& rect, float height, const Color32& color, float duration, const Matrix4* transformMatrix)
+{
+
+}
+
+void Debug::DrawSphere(const Vector3& position, float radius, const Color32& color, float duration, const Matrix4* transformMatrix)
+{
+
+}
+
+// Engine
+GEngine* GEngine::sInstance = nullptr;
+
+void GEngine::Quit()
+{
+
+}
+
+// Game
+GameProgress gGameProgress;
+LocationManager gLocationManager;
+
+LayerManager gLayerManager;
+
+Layer::Layer(const std::string& name) :
+    mName(name)
+{
+
+}
+
+LayerManager::LayerManager() :
+    mGlobalLayer("GlobalLayer")
+{
+
+}
+
+// Platform
+namespace OSDialog
+{
+    void Ok(OSDialogType type, const std::string& message)
+    {
+
+    }
+
+    bool YesNo(OSDialogType type, const std::string& title, const std::string& message)
+    {
+        return false;
+    }
+}
+
+// Rendering
+namespace PNG
+{
+    CodecResult Encode(const ImageData& input, const char* filePath)
+    {
+        return CodecResult::Error;
+    }
+
+    CodecResult Decode(BinaryReader& reader, ImageData& result)
+    {
+        return CodecResult::Error;
+    }
+}
+
+Material::Material()
+{
+
+}
+
+void Material::Activate(const Matrix4& objectToWorldMatrix)
+{
+
+}
+
+Mesh::~Mesh()
+{
+
+}
+
+void Mesh::Render()
+{
+
+}
+
+const Matrix4& Transform::GetLocalToWorldMatrix()
+{
+    return Matrix4::Identity;
+}
+
+// UI
+TYPEINFO_INIT(Component, NoBaseClass, GENERATE_TYPE_ID)
+{
+
+}
+
+bool Component::IsActiveAndEnabled() const
+{
+    return false;
+}
+
+TYPEINFO_INIT(UIWidget, Component, GENERATE_TYPE_ID)
+{
+
+}
+
+UIWidget::~UIWidget()
+{
+
+}
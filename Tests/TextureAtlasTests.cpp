@@ -0,0 +1,224 @@
+//
+// Clark Kromenaker
+//
+// Tests for TextureAtlas class.
+//
+#include "catch.hh"
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "Texture.h"
+
+namespace
+{
+    // Creates a texture where every pixel has a different color, so it's easy to tell where each pixel ended up.
+    std::unique_ptr<Texture> CreateTestTexture(uint32_t width, uint32_t height, uint8_t id, Texture::Format format = Texture::Format::RGBA)
+    {
+        std::unique_ptr<Texture> texture(new Texture(width, height, format));
+        for(uint32_t y = 0; y < height; ++y)
+        {
+            for(uint32_t x = 0; x < width; ++x)
+            {
+                texture->SetPixelColor(x, y, Color32(static_cast<int>(x), static_cast<int>(y), static_cast<int>(id), 255));
+            }
+        }
+        return texture;
+    }
+
+    // The area of a page used by an entry (including padding), in pixels.
+    struct PixelRect
+    {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+
+        bool Overlaps(const PixelRect& other) const
+        {
+            return x < other.x + other.width && other.x < x + width &&
+                   y < other.y + other.height && other.y < y + height;
+        }
+    };
+
+    PixelRect GetPixelRect(const TextureAtlas::Entry& entry, const Texture& texture, uint32_t padding)
+    {
+        PixelRect rect;
+        rect.x = static_cast<int>(entry.uvOffset.x * entry.page->GetWidth() + 0.5f) - static_cast<int>(padding);
+        rect.y = static_cast<int>(entry.uvOffset.y * entry.page->GetHeight() + 0.5f) - static_cast<int>(padding);
+        rect.width = static_cast<int>(texture.GetWidth() + padding * 2);
+        rect.height = static_cast<int>(texture.GetHeight() + padding * 2);
+        return rect;
+    }
+
+    // Checks every entry is on a page, within the page's bounds, and doesn't overlap any other entry (padding included).
+    void RequireValidPacking(const TextureAtlas& atlas, const std::vector<Texture*>& textures, uint32_t padding)
+    {
+        const std::vector<TextureAtlas::Entry>& entries = atlas.GetEntries();
+        REQUIRE(entries.size() == textures.size());
+        for(size_t i = 0; i < entries.size(); ++i)
+        {
+            REQUIRE(entries[i].page != nullptr);
+            PixelRect rect = GetPixelRect(entries[i], *textures[i], padding);
+            REQUIRE(rect.x >= 0);
+            REQUIRE(rect.y >= 0);
+            REQUIRE(rect.x + rect.width <= static_cast<int>(entries[i].page->GetWidth()));
+            REQUIRE(rect.y + rect.height <= static_cast<int>(entries[i].page->GetHeight()));
+
+            for(size_t j = 0; j < i; ++j)
+            {
+                if(entries[j].page == entries[i].page)
+                {
+                    REQUIRE(!rect.Overlaps(GetPixelRect(entries[j], *textures[j], padding)));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Texture atlas packs textures onto a page")
+{
+    std::vector<std::unique_ptr<Texture>> ownedTextures;
+    ownedTextures.push_back(CreateTestTexture(8, 4, 1));
+    ownedTextures.push_back(CreateTestTexture(4, 8, 2));
+    ownedTextures.push_back(CreateTestTexture(16, 2, 3));
+    ownedTextures.push_back(CreateTestTexture(3, 3, 4));
+    ownedTextures.push_back(CreateTestTexture(1, 1, 5));
+    std::vector<Texture*> textures;
+    for(auto& texture : ownedTextures)
+    {
+        textures.push_back(texture.get());
+    }
+
+    // Everything fits on one page, which is only as big as needed.
+    TextureAtlas atlas;
+    atlas.Build(textures, 64, 2);
+    REQUIRE(atlas.GetPages().size() == 1);
+    REQUIRE(atlas.GetPages()[0]->GetWidth() <= 64);
+    REQUIRE(atlas.GetPages()[0]->GetHeight() <= 64);
+    RequireValidPacking(atlas, textures, 2);
+
+    // Null textures can't be packed, but still get an entry, so entries line up with the textures passed in.
+    textures.insert(textures.begin() + 1, nullptr);
+    atlas.Build(textures, 64, 2);
+    REQUIRE(atlas.GetEntries().size() == textures.size());
+    REQUIRE(atlas.GetEntries()[1].page == nullptr);
+    REQUIRE(atlas.GetEntries()[2].page != nullptr);
+
+    // Clearing removes pages and entries.
+    atlas.Clear();
+    REQUIRE(atlas.GetPages().empty());
+    REQUIRE(atlas.GetEntries().empty());
+}
+
+TEST_CASE("Texture atlas starts new pages when a page is full")
+{
+    // Each padded texture is 12x12, so only four fit on a 24x24 page.
+    std::vector<std::unique_ptr<Texture>> ownedTextures;
+    std::vector<Texture*> textures;
+    for(int i = 0; i < 10; ++i)
+    {
+        ownedTextures.push_back(CreateTestTexture(10, 10, i));
+        textures.push_back(ownedTextures.back().get());
+    }
+
+    TextureAtlas atlas;
+    atlas.Build(textures, 24, 1);
+    REQUIRE(atlas.GetPages().size() == 3);
+    for(Texture* page : atlas.GetPages())
+    {
+        REQUIRE(page->GetWidth() <= 24);
+        REQUIRE(page->GetHeight() <= 24);
+    }
+    RequireValidPacking(atlas, textures, 1);
+
+    // A texture bigger than the page size gets a page big enough for it.
+    std::unique_ptr<Texture> bigTexture = CreateTestTexture(30, 5, 100);
+    textures.push_back(bigTexture.get());
+    atlas.Build(textures, 24, 1);
+    const TextureAtlas::Entry& bigEntry = atlas.GetEntries().back();
+    REQUIRE(bigEntry.page != nullptr);
+    REQUIRE(bigEntry.page->GetWidth() == 32);
+    RequireValidPacking(atlas, textures, 1);
+}
+
+TEST_CASE("Texture atlas pads textures by repeating their edge pixels")
+{
+    std::unique_ptr<Texture> texture = CreateTestTexture(3, 2, 7);
+    const uint32_t padding = 2;
+    TextureAtlas atlas;
+
+    // Textures in the page's format are copied by row, and others are converted per pixel - both should give the same result.
+    std::unique_ptr<Texture> rgbTexture = CreateTestTexture(3, 2, 7, Texture::Format::RGB);
+    for(Texture* source : { texture.get(), rgbTexture.get() })
+    {
+        atlas.Build({ source }, 64, padding);
+
+        // With a single texture, the page is exactly the padded texture.
+        const TextureAtlas::Entry& entry = atlas.GetEntries()[0];
+        REQUIRE(entry.page->GetWidth() == 3 + padding * 2);
+        REQUIRE(entry.page->GetHeight() == 2 + padding * 2);
+
+        // Every page pixel is the nearest texture pixel - padding repeats the edges, and corners repeat the corner pixels.
+        for(int y = -static_cast<int>(padding); y < 2 + static_cast<int>(padding); ++y)
+        {
+            for(int x = -static_cast<int>(padding); x < 3 + static_cast<int>(padding); ++x)
+            {
+                uint32_t sourceX = static_cast<uint32_t>(std::min(std::max(x, 0), 2));
+                uint32_t sourceY = static_cast<uint32_t>(std::min(std::max(y, 0), 1));
+                REQUIRE(entry.page->GetPixelColor(x + padding, y + padding) == texture->GetPixelColor(sourceX, sourceY));
+            }
+        }
+    }
+
+    // Without padding, there's no border at all.
+    atlas.Build({ texture.get() }, 64, 0);
+    REQUIRE(atlas.GetPages()[0]->GetWidth() == 3);
+    REQUIRE(atlas.GetPages()[0]->GetHeight() == 2);
+    REQUIRE(atlas.GetPages()[0]->GetPixelColor(0, 0) == texture->GetPixelColor(0, 0));
+}
+
+TEST_CASE("Texture atlas UV offset and scale map texture UVs to the page")
+{
+    std::vector<std::unique_ptr<Texture>> ownedTextures;
+    ownedTextures.push_back(CreateTestTexture(8, 4, 1));
+    ownedTextures.push_back(CreateTestTexture(5, 7, 2));
+    ownedTextures.push_back(CreateTestTexture(2, 2, 3));
+    std::vector<Texture*> textures;
+    for(auto& texture : ownedTextures)
+    {
+        textures.push_back(texture.get());
+    }
+
+    TextureAtlas atlas;
+    atlas.Build(textures, 16, 2);
+    for(size_t i = 0; i < textures.size(); ++i)
+    {
+        const TextureAtlas::Entry& entry = atlas.GetEntries()[i];
+        const Texture* texture = textures[i];
+        float pageWidth = static_cast<float>(entry.page->GetWidth());
+        float pageHeight = static_cast<float>(entry.page->GetHeight());
+
+        // The scale covers exactly the texture's pixels on the page.
+        REQUIRE(entry.uvScale.x * pageWidth == Approx(static_cast<float>(texture->GetWidth())));
+        REQUIRE(entry.uvScale.y * pageHeight == Approx(static_cast<float>(texture->GetHeight())));
+
+        // Sampling the center of each texture pixel, mapped to the page, gets that same pixel.
+        for(uint32_t y = 0; y < texture->GetHeight(); ++y)
+        {
+            for(uint32_t x = 0; x < texture->GetWidth(); ++x)
+            {
+                Vector2 uv((x + 0.5f) / texture->GetWidth(), (y + 0.5f) / texture->GetHeight());
+                Vector2 pageUV = entry.uvOffset + Vector2(uv.x * entry.uvScale.x, uv.y * entry.uvScale.y);
+                uint32_t pageX = static_cast<uint32_t>(pageUV.x * pageWidth);
+                uint32_t pageY = static_cast<uint32_t>(pageUV.y * pageHeight);
+                REQUIRE(entry.page->GetPixelColor(pageX, pageY) == texture->GetPixelColor(x, y));
+            }
+        }
+
+        // UVs 0 and 1 land on the texture's edges, not in the padding.
+        REQUIRE(entry.uvOffset.x * pageWidth == Approx(GetPixelRect(entry, *texture, 2).x + 2));
+        REQUIRE((entry.uvOffset.x + entry.uvScale.x) * pageWidth == Approx(GetPixelRect(entry, *texture, 2).x + 2 + texture->GetWidth()));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+//
+// Clark Kromenaker
+//
+// Tests for UIBatcher class.
+//
+#include "catch.hh"
+#include "UIBatcher.h"
+
+#include "FakePtr.h"
+#include "Matrix4.h"
+
+TEST_CASE("UI batcher merges consecutive quads with the same state")
+{
+    Texture* texA = FakePtr<Texture>(0x100);
+    Texture* texB = FakePtr<Texture>(0x200);
+
+    UIBatcher batcher;
+    batcher.AddQuad(Matrix4::Identity, texA, Color32::White, Color32::Magenta);
+    batcher.AddQuad(Matrix4::Identity, texA, Color32::Red, Color32::Magenta);
+    batcher.AddQuad(Matrix4::Identity, texB, Color32::White, Color32::Magenta);
+    batcher.AddQuad(Matrix4::Identity, texA, Color32::White, Color32::Magenta);
+    batcher.AddQuad(Matrix4::Identity, texA, Color32::White, Color32::Black);
+    REQUIRE(batcher.GetQuadCount() == 5);
+    REQUIRE(batcher.GetVertices().size() == 20);
+
+    // Color is per-vertex, so it doesn't split batches. Texture and discard color do.
+    // Going back to a texture used earlier must start a new batch, or draw order would change.
+    const std::vector<UIBatcher::Batch>& batches = batcher.GetPendingBatches();
+    REQUIRE(batches.size() == 4);
+    REQUIRE(batches[0].texture == texA);
+    REQUIRE(batches[0].firstQuad == 0);
+    REQUIRE(batches[0].quadCount == 2);
+    REQUIRE(batches[1].texture == texB);
+    REQUIRE(batches[1].firstQuad == 2);
+    REQUIRE(batches[1].quadCount == 1);
+    REQUIRE(batches[2].texture == texA);
+    REQUIRE(batches[2].firstQuad == 3);
+    REQUIRE(batches[3].discardColor == Color32::Black);
+    REQUIRE(batches[3].firstQuad == 4);
+
+    // Vertex colors come from the quad's color.
+    REQUIRE(batcher.GetVertices()[4].color == Color::Red);
+
+    // Once drawn, pending batches are cleared. New quads don't merge with drawn ones, but vertices are kept until the batcher is cleared.
+    batcher.ClearPendingBatches();
+    batcher.AddQuad(Matrix4::Identity, texA, Color32::White, Color32::Black);
+    REQUIRE(batcher.GetPendingBatches().size() == 1);
+    REQUIRE(batcher.GetPendingBatches()[0].firstQuad == 5);
+    REQUIRE(batcher.GetQuadCount() == 6);
+
+    batcher.Clear();
+    REQUIRE(batcher.GetQuadCount() == 0);
+    REQUIRE(batcher.GetPendingBatches().empty());
+}
+
+TEST_CASE("UI batcher transforms quads and skips transparent ones")
+{
+    // Same transform a 20x10 widget at (100, 50) would have.
+    Matrix4 transform = Matrix4::MakeTranslate(Vector3(100.0f, 50.0f, 0.0f)) * Matrix4::MakeScale(Vector3(20.0f, 10.0f, 1.0f));
+
+    UIBatcher batcher;
+    batcher.AddQuad(transform, FakePtr<Texture>(0x100), Color32::Clear, Color32::Magenta);
+    REQUIRE(batcher.GetQuadCount() == 0);
+
+    batcher.AddQuad(transform, FakePtr<Texture>(0x100), Color32::White, Color32::Magenta, Vector2(2.0f, 3.0f));
+    REQUIRE(batcher.GetQuadCount() == 1);
+
+    // Corners are in the same order as the UI quad mesh: upper-left, upper-right, lower-right, lower-left.
+    const std::vector<UIBatcher::Vertex>& vertices = batcher.GetVertices();
+    REQUIRE(vertices[0].position == Vector3(100.0f, 60.0f, 0.0f));
+    REQUIRE(vertices[1].position == Vector3(120.0f, 60.0f, 0.0f));
+    REQUIRE(vertices[2].position == Vector3(120.0f, 50.0f, 0.0f));
+    REQUIRE(vertices[3].position == Vector3(100.0f, 50.0f, 0.0f));
+
+    // UVs are scaled by the repeat amount.
+    REQUIRE(vertices[0].uv == Vector2(0.0f, 0.0f));
+    REQUIRE(vertices[2].uv == Vector2(2.0f, 3.0f));
+}
+
+TEST_CASE("UI batcher draws atlas textures from their page")
+{
+    Texture* texA = FakePtr<Texture>(0x100);
+    Texture* texB = FakePtr<Texture>(0x200);
+    Texture* page = FakePtr<Texture>(0x1000);
+
+    UIBatcher batcher;
+    TextureAtlas::Entry entryA;
+    entryA.page = page;
+    entryA.uvOffset = Vector2(0.0f, 0.0f);
+    entryA.uvScale = Vector2(0.25f, 0.5f);
+    batcher.SetAtlasEntry(texA, entryA);
+
+    TextureAtlas::Entry entryB;
+    entryB.page = page;
+    entryB.uvOffset = Vector2(0.5f, 0.5f);
+    entryB.uvScale = Vector2(0.25f, 0.25f);
+    batcher.SetAtlasEntry(texB, entryB);
+
+    // Different textures on the same page can be drawn together.
+    batcher.AddQuad(Matrix4::Identity, texA, Color32::White, Color32::Magenta);
+    batcher.AddQuad(Matrix4::Identity, texB, Color32::White, Color32::Magenta);
+    REQUIRE(batcher.GetPendingBatches().size() == 1);
+    REQUIRE(batcher.GetPendingBatches()[0].texture == page);
+    REQUIRE(batcher.GetPendingBatches()[0].quadCount == 2);
+
+    // UVs are remapped to each texture's spot on the page.
+    const std::vector<UIBatcher::Vertex>& vertices = batcher.GetVertices();
+    REQUIRE(vertices[0].uv == Vector2(0.0f, 0.0f));
+    REQUIRE(vertices[2].uv == Vector2(0.25f, 0.5f));
+    REQUIRE(vertices[4].uv == Vector2(0.5f, 0.5f));
+    REQUIRE(vertices[6].uv == Vector2(0.75f, 0.75f));
+
+    // Repeating UVs would run into other textures on the page, so tiled quads use the original texture.
+    batcher.AddQuad(Matrix4::Identity, texA, Color32::White, Color32::Magenta, Vector2(2.0f, 2.0f));
+    REQUIRE(batcher.GetPendingBatches().size() == 2);
+    REQUIRE(batcher.GetPendingBatches()[1].texture == texA);
+
+    // Once entries are cleared, textures are drawn as-is again.
+    batcher.ClearAtlasEntries();
+    batcher.AddQuad(Matrix4::Identity, texB, Color32::White, Color32::Magenta);
+    REQUIRE(batcher.GetPendingBatches().back().texture == texB);
+}
\ No newline at end of file
@@ -182,4 +182,21 @@ TEST_CASE("Vector3 LERP works correctly")
 
     Vector3 middle = Vector3::Lerp(vec1, vec2, 0.5f);
     REQUIRE(middle == Vector3(5.0f, 5.0f, 5.0f));
+
+    // Array lerp should match single vector lerp - including any vectors past the last multiple of four floats.
+    Vector3 from[5] = { Vector3(0.0f, 1.0f, 2.0f), Vector3(3.0f, 4.0f, 5.0f), Vector3(-6.0f, 7.0f, -8.0f), Vector3::One, Vector3(9.5f, -1.25f, 100.0f) };
+    Vector3 to[5] = { Vector3(10.0f, 10.0f, 10.0f), Vector3::Zero, Vector3(6.0f, -7.0f, 8.0f), Vector3(-3.0f, 0.5f, 2.0f), Vector3(0.0f, 1.0f, -100.0f) };
+    Vector3 out[5];
+    Vector3::Lerp(from, to, 0.3f, out, 5);
+    for(int i = 0; i < 5; ++i)
+    {
+        REQUIRE(out[i] == Vector3::Lerp(from[i], to[i], 0.3f));
+    }
+
+    // Output can be the same as an input.
+    Vector3::Lerp(from, to, 1.0f, from, 5);
+    for(int i = 0; i < 5; ++i)
+    {
+        REQUIRE(from[i] == to[i]);
+    }
 }
@@ -0,0 +1,142 @@
+//
+// Clark Kromenaker
+//
+// Tests for finding keyframes in vertex animation tracks.
+// Results are compared against a reference linear scan, which is how keyframes were found when poses were stored as linked lists.
+//
+#include "catch.hh"
+#include "VertexAnimation.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    const int kFramesPerSecond = 15;
+
+    VertexAnimationTrack<float> CreateTrack(const std::vector<int>& keyframeFrames)
+    {
+        VertexAnimationTrack<float> track;
+        track.keyframeFrames = keyframeFrames;
+        track.values.resize(keyframeFrames.size());
+        return track;
+    }
+
+    // Walks keyframes from the first one, using the closest previous keyframe if no keyframe is on the frame.
+    int ReferenceKeyframeForFrame(const std::vector<int>& keyframeFrames, int frame)
+    {
+        int keyframe = 0;
+        while(keyframeFrames[keyframe] != frame &&
+              keyframe + 1 < static_cast<int>(keyframeFrames.size()) && keyframeFrames[keyframe + 1] <= frame)
+        {
+            ++keyframe;
+        }
+        return keyframe;
+    }
+
+    // Walks keyframes from the first one, until the next keyframe's time is after the desired time.
+    void ReferenceKeyframesForTime(const std::vector<int>& keyframeFrames, float time, int framesPerSecond, int& outCurrent, int& outNext, float& outT)
+    {
+        float secondsPerFrame = 1.0f / framesPerSecond;
+        int keyframeCount = static_cast<int>(keyframeFrames.size());
+
+        outCurrent = 0;
+        outNext = -1;
+        outT = 0.0f;
+        float currentPoseTime = 0.0f;
+        float nextPoseTime = 0.0f;
+        while(outCurrent + 1 < keyframeCount)
+        {
+            currentPoseTime = secondsPerFrame * keyframeFrames[outCurrent];
+            nextPoseTime = secondsPerFrame * keyframeFrames[outCurrent + 1];
+            if(nextPoseTime > time) { break; }
+            ++outCurrent;
+        }
+
+        // Only interpolate with a keyframe on the very next frame.
+        if(outCurrent + 1 >= keyframeCount || keyframeFrames[outCurrent + 1] != keyframeFrames[outCurrent] + 1)
+        {
+            return;
+        }
+        outNext = outCurrent + 1;
+
+        // The linked list version asserted on times before the first keyframe; the track clamps instead.
+        outT = (time - currentPoseTime) / (nextPoseTime - currentPoseTime);
+        outT = std::clamp(outT, 0.0f, 1.0f);
+    }
+
+    void RequireSameKeyframesForTime(const VertexAnimationTrack<float>& track, float time)
+    {
+        int current = 0;
+        int next = 0;
+        float t = 0.0f;
+        track.GetKeyframesForTime(time, kFramesPerSecond, current, next, t);
+
+        int expectedCurrent = 0;
+        int expectedNext = 0;
+        float expectedT = 0.0f;
+        ReferenceKeyframesForTime(track.keyframeFrames, time, kFramesPerSecond, expectedCurrent, expectedNext, expectedT);
+
+        INFO("Time " << time);
+        REQUIRE(current == expectedCurrent);
+        REQUIRE(next == expectedNext);
+        REQUIRE(t == Approx(expectedT).margin(0.0001f));
+    }
+
+    void RequireSameKeyframes(const std::vector<int>& keyframeFrames)
+    {
+        VertexAnimationTrack<float> track = CreateTrack(keyframeFrames);
+        int lastFrame = keyframeFrames.back();
+
+        // Frames before the first keyframe, on and between keyframes, and after the last keyframe.
+        for(int frame = -3; frame <= lastFrame + 3; ++frame)
+        {
+            INFO("Frame " << frame);
+            REQUIRE(track.GetKeyframeForFrame(frame) == ReferenceKeyframeForFrame(keyframeFrames, frame));
+        }
+
+        // Times exactly on each keyframe.
+        float secondsPerFrame = 1.0f / kFramesPerSecond;
+        for(int frame : keyframeFrames)
+        {
+            RequireSameKeyframesForTime(track, secondsPerFrame * frame);
+        }
+
+        // Times before the first keyframe, between keyframes, and after the last keyframe.
+        for(float time = -0.1f; time < secondsPerFrame * (lastFrame + 3); time += secondsPerFrame * 0.37f)
+        {
+            RequireSameKeyframesForTime(track, time);
+        }
+    }
+}
+
+TEST_CASE("Vertex animation tracks with a keyframe on every frame match a linear scan")
+{
+    RequireSameKeyframes({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+}
+
+TEST_CASE("Vertex animation tracks with gaps between keyframes match a linear scan")
+{
+    RequireSameKeyframes({ 0, 1, 2, 5, 6, 10, 14, 15 });
+
+    // First keyframe isn't on frame zero, so earlier frames use the first keyframe.
+    RequireSameKeyframes({ 3, 4, 8, 9, 10 });
+
+    // Keyframe indexes that line up with frame numbers early on, but not later.
+    RequireSameKeyframes({ 0, 1, 2, 3, 20, 21 });
+}
+
+TEST_CASE("Vertex animation tracks with one keyframe always use it")
+{
+    RequireSameKeyframes({ 0 });
+    RequireSameKeyframes({ 4 });
+
+    VertexAnimationTrack<float> track = CreateTrack({ 4 });
+    int current = -1;
+    int next = 0;
+    float t = 1.0f;
+    track.GetKeyframesForTime(10.0f, kFramesPerSecond, current, next, t);
+    REQUIRE(current == 0);
+    REQUIRE(next == -1);
+    REQUIRE(t == 0.0f);
+}
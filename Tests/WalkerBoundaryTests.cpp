@@ -0,0 +1,519 @@
+//
+// Clark Kromenaker
+//
+// Tests for WalkerBoundary pathfinding, using small synthetic boundaries.
+// Results are compared against a reference full-fidelity search, which is how paths were found before the walkable map and path cache.
+//
+#include "catch.hh"
+#include "WalkerBoundary.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <unordered_set>
+
+#include "Rect.h"
+#include "ThreadPool.h"
+#include "ThreadUtil.h"
+
+namespace
+{
+    // A 40x30 boundary (1 world unit per pixel):
+    // - A wall (255) splits it into left and right halves, with a door (region 130, boundary 131) in the middle.
+    // - An enclosed room (walls of 255) on the right side can't be reached from anywhere else.
+    // - A block of region 8 (unwalkable by default) on the left side.
+    const uint32_t kWidth = 40;
+    const uint32_t kHeight = 30;
+    const int kDoorRegion = 130;
+    const int kDoorBoundaryRegion = 131;
+
+    std::vector<uint8_t> CreateTestPaletteIndexes()
+    {
+        std::vector<uint8_t> indexes(kWidth * kHeight, 0);
+        for(uint32_t y = 0; y < kHeight; ++y)
+        {
+            bool isDoor = y >= 12 && y <= 15;
+            indexes[y * kWidth + 20] = isDoor ? kDoorRegion : 255;
+            if(isDoor)
+            {
+                indexes[y * kWidth + 19] = kDoorBoundaryRegion;
+                indexes[y * kWidth + 21] = kDoorBoundaryRegion;
+            }
+        }
+        for(uint32_t y = 3; y <= 9; ++y)
+        {
+            for(uint32_t x = 28; x <= 36; ++x)
+            {
+                if(y == 3 || y == 9 || x == 28 || x == 36)
+                {
+                    indexes[y * kWidth + x] = 255;
+                }
+            }
+        }
+        for(uint32_t y = 20; y <= 25; ++y)
+        {
+            for(uint32_t x = 5; x <= 8; ++x)
+            {
+                indexes[y * kWidth + x] = 8;
+            }
+        }
+        return indexes;
+    }
+
+    // The center of a pixel in world space. Texture y is flipped relative to world z.
+    Vector3 ToWorldPos(int x, int y, uint32_t height = kHeight)
+    {
+        return Vector3(x + 0.5f, 0.0f, height - (y + 0.5f));
+    }
+
+    Vector2 ToTexturePos(const Vector3& worldPos, uint32_t height = kHeight)
+    {
+        return Vector2(static_cast<int>(worldPos.x), static_cast<int>(height - worldPos.z));
+    }
+
+    // Walkability and search as done before the walkable map: check each pixel's region directly, and search every pixel.
+    struct ReferenceBoundary
+    {
+        uint32_t width = kWidth;
+        uint32_t height = kHeight;
+        std::vector<uint8_t> paletteIndexes;
+        std::unordered_set<int> unwalkableRegions = { 255, 9, 8 };
+
+        bool IsWalkable(int x, int y) const
+        {
+            if(x < 0 || x >= static_cast<int>(width) || y < 0 || y >= static_cast<int>(height)) { return false; }
+            return unwalkableRegions.count(paletteIndexes[y * width + x]) == 0;
+        }
+
+        bool IsReachable(const Vector2& start, const Vector2& goal) const
+        {
+            std::vector<bool> visited(width * height, false);
+            std::queue<Vector2> openSet;
+            openSet.push(start);
+            visited[static_cast<int>(start.y) * width + static_cast<int>(start.x)] = true;
+            while(!openSet.empty())
+            {
+                Vector2 current = openSet.front();
+                openSet.pop();
+                if(current == goal) { return true; }
+                for(int dy = -1; dy <= 1; ++dy)
+                {
+                    for(int dx = -1; dx <= 1; ++dx)
+                    {
+                        int x = static_cast<int>(current.x) + dx;
+                        int y = static_cast<int>(current.y) + dy;
+                        if(IsWalkable(x, y) && !visited[y * width + x])
+                        {
+                            visited[y * width + x] = true;
+                            openSet.push(Vector2(x, y));
+                        }
+                    }
+                }
+            }
+            return false;
+        }
+
+        Vector2 FindNearestWalkable(const Vector2& target) const
+        {
+            // Brute force, in the same order as before: the first nearest position by x, then y.
+            Vector2 nearest;
+            float nearestDistanceSq = 9999.0f;
+            for(uint32_t x = 0; x < width; ++x)
+            {
+                for(uint32_t y = 0; y < height; ++y)
+                {
+                    Vector2 pos(x, y);
+                    float distSq = (pos - target).GetLengthSq();
+                    if(IsWalkable(x, y) && distSq < nearestDistanceSq)
+                    {
+                        nearest = pos;
+                        nearestDistanceSq = distSq;
+                    }
+                }
+            }
+            return nearest;
+        }
+    };
+
+    // Checks that a found path goes from start to goal, and each straight line between path nodes is walkable.
+    void RequireValidPath(const ReferenceBoundary& reference, const std::vector<Vector3>& path, const Vector2& start, const Vector2& goal)
+    {
+        // An empty path means the start is the goal. Otherwise, paths are ordered goal to start.
+        if(path.empty())
+        {
+            REQUIRE(start == goal);
+            return;
+        }
+        REQUIRE(ToTexturePos(path.front(), reference.height) == goal);
+        REQUIRE(ToTexturePos(path.back(), reference.height) == start);
+
+        for(size_t i = 0; i + 1 < path.size(); ++i)
+        {
+            Vector2 current = ToTexturePos(path[i], reference.height);
+            Vector2 end = ToTexturePos(path[i + 1], reference.height);
+            while(current != end)
+            {
+                current.x += (current.x < end.x) ? 1 : (current.x > end.x ? -1 : 0);
+                current.y += (current.y < end.y) ? 1 : (current.y > end.y ? -1 : 0);
+                REQUIRE(reference.IsWalkable(current.x, current.y));
+            }
+        }
+    }
+
+    // Simple deterministic random numbers, so failures are reproducible.
+    uint32_t NextRandom(uint32_t& state)
+    {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+
+    Vector2 RandomWalkablePos(const ReferenceBoundary& reference, uint32_t& state)
+    {
+        while(true)
+        {
+            int x = NextRandom(state) % reference.width;
+            int y = NextRandom(state) % reference.height;
+            if(reference.IsWalkable(x, y)) { return Vector2(x, y); }
+        }
+    }
+
+    // Finds paths between many random walkable positions, and checks they agree with the reference search.
+    void RequireSameAsReference(WalkerBoundary& boundary, const ReferenceBoundary& reference, uint32_t seed)
+    {
+        uint32_t state = seed;
+        for(int i = 0; i < 200; ++i)
+        {
+            Vector2 start = RandomWalkablePos(reference, state);
+            Vector2 goal = RandomWalkablePos(reference, state);
+
+            std::vector<Vector3> path;
+            bool foundPath = boundary.FindPath(ToWorldPos(start.x, start.y), ToWorldPos(goal.x, goal.y), path);
+            REQUIRE(foundPath == reference.IsReachable(start, goal));
+            if(foundPath)
+            {
+                RequireValidPath(reference, path, start, goal);
+            }
+        }
+    }
+
+    void InitTestBoundary(WalkerBoundary& boundary, ReferenceBoundary& reference)
+    {
+        reference.paletteIndexes = CreateTestPaletteIndexes();
+        boundary.SetPaletteIndexes(kWidth, kHeight, reference.paletteIndexes);
+        boundary.SetSize(Vector2(kWidth, kHeight));
+        boundary.SetOffset(Vector2::Zero);
+    }
+
+    // Async paths are found on the thread pool, and their callbacks run when the test (acting as main thread) runs main thread functions.
+    void InitThreads()
+    {
+        ThreadUtil::Init();
+        ThreadPool::Init(2);
+    }
+
+    // Runs main thread functions until the condition is met. Returns false if it takes too long.
+    template<typename Condition>
+    bool RunMainThreadUntil(const Condition& condition, int maxMilliseconds = 5000)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        while(!condition())
+        {
+            if(std::chrono::steady_clock::now() - startTime > std::chrono::milliseconds(maxMilliseconds))
+            {
+                return false;
+            }
+            ThreadUtil::RunFunctionsOnMainThread();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    // Result of an async path request.
+    struct AsyncPathResult
+    {
+        bool done = false;
+        bool foundPath = false;
+        std::vector<Vector3> path;
+    };
+
+    WalkerBoundary::PathCallback RecordResult(AsyncPathResult& result)
+    {
+        return [&result](bool foundPath, std::vector<Vector3>& path) {
+            result.done = true;
+            result.foundPath = foundPath;
+            result.path = path;
+        };
+    }
+}
+
+TEST_CASE("Walker boundary paths match the reference search")
+{
+    WalkerBoundary boundary;
+    ReferenceBoundary reference;
+    InitTestBoundary(boundary, reference);
+    RequireSameAsReference(boundary, reference, 1);
+
+    // Closing the door splits the boundary in two.
+    boundary.SetRegionBlocked(kDoorRegion, kDoorBoundaryRegion, true);
+    reference.unwalkableRegions.insert(kDoorRegion);
+    reference.unwalkableRegions.insert(kDoorBoundaryRegion);
+    RequireSameAsReference(boundary, reference, 2);
+
+    // Opening it again joins them.
+    boundary.SetRegionBlocked(kDoorRegion, kDoorBoundaryRegion, false);
+    reference.unwalkableRegions.erase(kDoorRegion);
+    reference.unwalkableRegions.erase(kDoorBoundaryRegion);
+    RequireSameAsReference(boundary, reference, 3);
+
+    // Default unwalkable regions can be made walkable too.
+    boundary.SetRegionBlocked(8, 9, false);
+    reference.unwalkableRegions.erase(8);
+    reference.unwalkableRegions.erase(9);
+    RequireSameAsReference(boundary, reference, 4);
+}
+
+TEST_CASE("Walker boundary doesn't find paths to unreachable targets")
+{
+    WalkerBoundary boundary;
+    ReferenceBoundary reference;
+    InitTestBoundary(boundary, reference);
+
+    // The enclosed room can't be reached - but a "best effort" path is still given, ending at the start.
+    std::vector<Vector3> path;
+    Vector2 start(4, 4);
+    REQUIRE(!boundary.FindPath(ToWorldPos(start.x, start.y), ToWorldPos(32, 6), path));
+    REQUIRE(!path.empty());
+    REQUIRE(ToTexturePos(path.back()) == start);
+
+    // Same going out of the room.
+    REQUIRE(!boundary.FindPath(ToWorldPos(32, 6), ToWorldPos(4, 4), path));
+
+    // An unwalkable target is replaced by the nearest walkable position.
+    REQUIRE(boundary.FindPath(ToWorldPos(start.x, start.y), ToWorldPos(6, 22), path));
+    REQUIRE(ToTexturePos(path.front()) == reference.FindNearestWalkable(Vector2(6, 22)));
+}
+
+TEST_CASE("Walker boundary finds the same nearest walkable positions as a full scan")
+{
+    WalkerBoundary boundary;
+    ReferenceBoundary reference;
+    InitTestBoundary(boundary, reference);
+
+    // Positions inside walls and unwalkable regions, and some outside the boundary altogether.
+    const std::vector<Vector3> worldPositions = {
+        Vector3(20.5f, 0.0f, 25.5f), Vector3(6.0f, 0.0f, 7.0f), Vector3(7.5f, 0.0f, 4.5f),
+        Vector3(28.5f, 0.0f, 23.5f), Vector3(-5.0f, 0.0f, 10.0f), Vector3(45.0f, 0.0f, 40.0f)
+    };
+    for(const Vector3& worldPos : worldPositions)
+    {
+        Vector2 expected = reference.FindNearestWalkable(ToTexturePos(worldPos));
+        Vector3 nearest = boundary.FindNearestWalkablePosition(worldPos);
+        REQUIRE(ToTexturePos(nearest) == expected);
+    }
+
+    // Walkable positions are returned as-is.
+    Vector3 walkable(3.25f, 0.0f, 3.75f);
+    REQUIRE(boundary.FindNearestWalkablePosition(walkable) == walkable);
+}
+
+TEST_CASE("Walker boundary cached paths are invalidated by walkability changes")
+{
+    WalkerBoundary boundary;
+    ReferenceBoundary reference;
+    InitTestBoundary(boundary, reference);
+
+    // Same path twice - the second comes from the cache, and should be the same.
+    Vector3 from = ToWorldPos(4, 14);
+    Vector3 to = ToWorldPos(35, 14);
+    std::vector<Vector3> path;
+    REQUIRE(boundary.FindPath(from, to, path));
+    std::vector<Vector3> cachedPath;
+    REQUIRE(boundary.FindPath(from, to, cachedPath));
+    REQUIRE(cachedPath == path);
+
+    // Blocking or unblocking regions changes the result.
+    boundary.SetRegionBlocked(kDoorRegion, kDoorBoundaryRegion, true);
+    REQUIRE(!boundary.FindPath(from, to, path));
+    boundary.SetRegionBlocked(kDoorRegion, kDoorBoundaryRegion, false);
+    REQUIRE(boundary.FindPath(from, to, path));
+    REQUIRE(path == cachedPath);
+
+    // So do unwalkable rects. This one covers the door (world rect x/y is world x/z).
+    boundary.SetUnwalkableRect("door", Rect(18.0f, 13.0f, 5.0f, 6.0f));
+    REQUIRE(!boundary.FindPath(from, to, path));
+
+    // Moving the rect elsewhere opens the door again.
+    boundary.SetUnwalkableRect("door", Rect(1.0f, 1.0f, 2.0f, 2.0f));
+    REQUIRE(boundary.FindPath(from, to, path));
+    boundary.SetUnwalkableRect("door", Rect(18.0f, 13.0f, 5.0f, 6.0f));
+    REQUIRE(!boundary.FindPath(from, to, path));
+    boundary.ClearUnwalkableRect("door");
+    REQUIRE(boundary.FindPath(from, to, path));
+
+    // Replacing the texture data entirely does too. Without the walls, the enclosed room can be reached.
+    Vector3 roomPos = ToWorldPos(32, 6);
+    REQUIRE(!boundary.FindPath(from, roomPos, path));
+    boundary.SetPaletteIndexes(kWidth, kHeight, std::vector<uint8_t>(kWidth * kHeight, 0));
+    REQUIRE(boundary.FindPath(from, roomPos, path));
+}
+
+TEST_CASE("Walker boundary pathfinding performance", "[.benchmark]")
+{
+    // A boundary about the size of the largest in the game, with several walls to path around.
+    const uint32_t width = 400;
+    const uint32_t height = 300;
+    ReferenceBoundary reference;
+    reference.width = width;
+    reference.height = height;
+    reference.paletteIndexes.resize(width * height, 0);
+    for(uint32_t wall = 1; wall <= 4; ++wall)
+    {
+        // Walls alternate having a gap at the top or bottom.
+        uint32_t wallX = wall * 80;
+        for(uint32_t y = 0; y < height; ++y)
+        {
+            bool isGap = (wall % 2 == 0) ? y < 30 : y >= height - 30;
+            if(!isGap)
+            {
+                reference.paletteIndexes[y * width + wallX] = 255;
+                reference.paletteIndexes[y * width + wallX + 1] = 255;
+            }
+        }
+    }
+
+    WalkerBoundary boundary;
+    boundary.SetPaletteIndexes(width, height, reference.paletteIndexes);
+    boundary.SetSize(Vector2(width, height));
+
+    // Time different random paths (so none come from the cache), and the reference search for the same paths.
+    uint32_t state = 1;
+    const int kPathCount = 200;
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+    double referenceTotalMs = 0.0;
+    for(int i = 0; i < kPathCount; ++i)
+    {
+        Vector2 start = RandomWalkablePos(reference, state);
+        Vector2 goal = RandomWalkablePos(reference, state);
+
+        std::vector<Vector3> path;
+        auto startTime = std::chrono::steady_clock::now();
+        bool foundPath = boundary.FindPath(ToWorldPos(start.x, start.y, height), ToWorldPos(goal.x, goal.y, height), path);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+        totalMs += ms;
+        maxMs = std::max(maxMs, ms);
+
+        startTime = std::chrono::steady_clock::now();
+        bool referenceFoundPath = reference.IsReachable(start, goal);
+        referenceTotalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+        REQUIRE(foundPath == referenceFoundPath);
+    }
+    printf("Walker boundary %ux%u: %d paths, avg %.3fms, max %.3fms (reference full-fidelity search avg %.3fms)\n",
+           width, height, kPathCount, totalMs / kPathCount, maxMs, referenceTotalMs / kPathCount);
+}
+
+TEST_CASE("Walker boundary async paths match synchronous paths")
+{
+    InitThreads();
+    WalkerBoundary boundary;
+    ReferenceBoundary reference;
+    InitTestBoundary(boundary, reference);
+
+    // Request several paths at once, some unreachable.
+    const std::vector<std::pair<Vector2, Vector2>> startsAndGoals = {
+        { Vector2(4, 14), Vector2(35, 14) }, { Vector2(4, 4), Vector2(32, 6) },
+        { Vector2(35, 25), Vector2(2, 2) }, { Vector2(30, 5), Vector2(34, 8) }
+    };
+    std::vector<AsyncPathResult> results(startsAndGoals.size());
+    for(size_t i = 0; i < startsAndGoals.size(); ++i)
+    {
+        const Vector2& start = startsAndGoals[i].first;
+        const Vector2& goal = startsAndGoals[i].second;
+        boundary.FindPathAsync(ToWorldPos(start.x, start.y), ToWorldPos(goal.x, goal.y), RecordResult(results[i]));
+    }
+    REQUIRE(RunMainThreadUntil([&results]() {
+        return std::all_of(results.begin(), results.end(), [](const AsyncPathResult& result) { return result.done; });
+    }));
+
+    // Each gives the same result as finding the path synchronously on another boundary.
+    WalkerBoundary syncBoundary;
+    InitTestBoundary(syncBoundary, reference);
+    for(size_t i = 0; i < startsAndGoals.size(); ++i)
+    {
+        const Vector2& start = startsAndGoals[i].first;
+        const Vector2& goal = startsAndGoals[i].second;
+        std::vector<Vector3> path;
+        bool foundPath = syncBoundary.FindPath(ToWorldPos(start.x, start.y), ToWorldPos(goal.x, goal.y), path);
+        REQUIRE(results[i].foundPath == foundPath);
+        REQUIRE(results[i].foundPath == reference.IsReachable(start, goal));
+        REQUIRE(results[i].path == path);
+    }
+}
+
+TEST_CASE("Walker boundary async paths use walkability from when they were requested")
+{
+    InitThreads();
+    WalkerBoundary boundary;
+    ReferenceBoundary reference;
+    InitTestBoundary(boundary, reference);
+
+    // Request a path through the door, then close the door before the result arrives.
+    Vector3 from = ToWorldPos(4, 14);
+    Vector3 to = ToWorldPos(35, 14);
+    AsyncPathResult result;
+    boundary.FindPathAsync(from, to, RecordResult(result));
+    boundary.SetRegionBlocked(kDoorRegion, kDoorBoundaryRegion, true);
+
+    // The search used a snapshot from when it was requested, so the door was still open.
+    REQUIRE(RunMainThreadUntil([&result]() { return result.done; }));
+    REQUIRE(result.foundPath);
+
+    // But the door is closed now - the path found by the snapshot must not be reused.
+    std::vector<Vector3> path;
+    REQUIRE(!boundary.FindPath(from, to, path));
+
+    // A path requested after the change uses the new walkability.
+    AsyncPathResult closedResult;
+    boundary.FindPathAsync(from, to, RecordResult(closedResult));
+    REQUIRE(RunMainThreadUntil([&closedResult]() { return closedResult.done; }));
+    REQUIRE(!closedResult.foundPath);
+}
+
+TEST_CASE("Walker boundary cancelled path requests don't call back")
+{
+    InitThreads();
+    std::unique_ptr<WalkerBoundary> boundary(new WalkerBoundary());
+    ReferenceBoundary reference;
+    InitTestBoundary(*boundary, reference);
+
+    // Cancel one request right away.
+    Vector3 from = ToWorldPos(4, 14);
+    Vector3 to = ToWorldPos(35, 14);
+    bool cancelledCalledBack = false;
+    uint32_t cancelledId = boundary->FindPathAsync(from, to, [&cancelledCalledBack](bool, std::vector<Vector3>&) { cancelledCalledBack = true; });
+    boundary->CancelPathRequest(cancelledId);
+
+    // Another request (made after) still completes.
+    AsyncPathResult result;
+    uint32_t otherId = boundary->FindPathAsync(to, from, RecordResult(result));
+    REQUIRE(otherId != cancelledId);
+    REQUIRE(RunMainThreadUntil([&result]() { return result.done; }));
+    REQUIRE(result.foundPath);
+
+    // Cancelling a request that's already done, or doesn't exist, does nothing.
+    boundary->CancelPathRequest(otherId);
+    boundary->CancelPathRequest(12345);
+
+    // Requests still in progress when the boundary is destroyed don't call back either.
+    bool destroyedCalledBack = false;
+    boundary->FindPathAsync(from, to, [&destroyedCalledBack](bool, std::vector<Vector3>&) { destroyedCalledBack = true; });
+    boundary.reset();
+
+    // Give the searches plenty of time to finish, and run any callbacks they queued.
+    RunMainThreadUntil([]() { return false; }, 200);
+    REQUIRE(!cancelledCalledBack);
+    REQUIRE(!destroyedCalledBack);
+}
\ No newline at end of file